@@ -315,6 +315,8 @@ Rectangle {
                 text = "Upload..."
                 enabled = false
                 
+                // Avec ConfigSyncManager, le preset renvoyé part en patchs MCFG depuis la console
+                var viaSync = !!(presetManager && presetManager.configSyncManager)
                 var xhr = new XMLHttpRequest()
                 var apiUrl = networkUtils.getApiBaseUrl()
                 xhr.open("POST", apiUrl + "/api/presets/current/upload")
@@ -326,13 +328,15 @@ Rectangle {
                         enabled = true
                         if (xhr.status === 200) {
                             var res = JSON.parse(xhr.responseText)
+                            if (viaSync && res.preset && res.preset.config)
+                                presetManager.applyToDesks(res.preset.name, res.preset.config.pupitres || [])
                             console.log("✅ Upload réussi:", res)
                         } else {
                             console.error("❌ Erreur upload:", xhr.status, xhr.responseText)
                         }
                     }
                 }
-                xhr.send()
+                xhr.send(JSON.stringify({ relay: !viaSync }))
             }
         }
         
@@ -12,16 +12,22 @@ Item {
     }
     
     property var pupitre: null
+    property var consoleController: null
     // Snapshot et rafraîchissement local (comme Outputs/Sirens)
     property var currentPresetSnapshot: null
     property int updateTrigger: 0
     function forceRefresh() { updateTrigger++ }
     function patchAndApply(url, body, applyFn) {
+        var updates = consoleController ? consoleController.pupitreEditUpdates(url, body) : null
+        if (updates)
+            body.relay = false
         var xhr = new XMLHttpRequest()
         xhr.open("PATCH", url)
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.onreadystatechange = function() {
             if (xhr.readyState === XMLHttpRequest.DONE && xhr.status === 200) {
+                if (updates)
+                    consoleController.pushPupitreUpdates(body.pupitreId, updates)
                 if (applyFn) applyFn()
                 forceRefresh()
             }
@@ -46,11 +52,7 @@ Item {
         var payload = { pupitreId: pupitre.id, controller: ctrlKey }
         if (cc !== undefined) payload.cc = cc
         if (curve !== undefined) payload.curve = curve
-        var xhr = new XMLHttpRequest()
-        var apiUrl = networkUtils.getApiBaseUrl()
-        xhr.open("PATCH", apiUrl + "/api/presets/current/controller-mapping")
-        xhr.setRequestHeader("Content-Type", "application/json")
-        xhr.send(JSON.stringify(payload))
+        patchAndApply(networkUtils.getApiBaseUrl() + "/api/presets/current/controller-mapping", payload, null)
     }
     
     // Fond gris pour l'ensemble du tab
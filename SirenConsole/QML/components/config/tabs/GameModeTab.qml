@@ -27,11 +27,16 @@ Item {
     }
     
     function patchAndApply(url, body, applyFn) {
+        var updates = consoleController ? consoleController.pupitreEditUpdates(url, body) : null
+        if (updates)
+            body.relay = false
         var xhr = new XMLHttpRequest()
         xhr.open("PATCH", url)
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.onreadystatechange = function() {
             if (xhr.readyState === XMLHttpRequest.DONE && xhr.status === 200) {
+                if (updates)
+                    consoleController.pushPupitreUpdates(body.pupitreId, updates)
                 if (applyFn) applyFn()
                 forceRefresh()
             }
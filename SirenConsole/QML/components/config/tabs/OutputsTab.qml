@@ -12,6 +12,7 @@ Item {
     }
     
     property var pupitre: null
+    property var consoleController: null
     // Snapshot du preset courant, injecté par ConfigPage si présent
     property var currentPresetSnapshot: null
     // Pour forcer la mise à jour visuelle
@@ -20,11 +21,16 @@ Item {
     function forceRefresh() { updateTrigger++ }
     
     function patchAndApply(url, body, applyFn) {
+        var updates = consoleController ? consoleController.pupitreEditUpdates(url, body) : null
+        if (updates)
+            body.relay = false
         var xhr = new XMLHttpRequest()
         xhr.open("PATCH", url)
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.onreadystatechange = function() {
             if (xhr.readyState === XMLHttpRequest.DONE && xhr.status === 200) {
+                if (updates)
+                    consoleController.pushPupitreUpdates(body.pupitreId, updates)
                 if (applyFn) applyFn()
                 forceRefresh()
             }
@@ -18,6 +18,10 @@ Rectangle {
     property int ambitusMax: parent && parent.ambitusMax !== undefined ? parent.ambitusMax : 72
     // État de synchronisation
     property bool pupitreSynced: parent ? (parent.pupitreSynced || false) : false
+    // Horloge de spectacle (décalage et aller-retour estimés par le pupitre)
+    property bool clockSynced: parent ? (parent.clockSynced || false) : false
+    property real clockOffsetMs: parent && parent.clockOffsetMs !== undefined ? parent.clockOffsetMs : 0
+    property real clockRttMs: parent && parent.clockRttMs !== undefined ? parent.clockRttMs : 0
     property var consoleController: parent ? parent.consoleController : null
     
     // Trigger pour forcer la mise à jour des propriétés d'autonomie
@@ -125,6 +129,28 @@ Rectangle {
                             cursorShape: Qt.PointingHandCursor
                         }
                     }
+                    
+                    // Horloge de spectacle : aller-retour mesuré (décalage en infobulle)
+                    Text {
+                        anchors.horizontalCenter: parent.horizontalCenter
+                        text: overviewRow.clockSynced ? "⏱ " + overviewRow.clockRttMs.toFixed(1) + " ms" : "⏱ —"
+                        color: overviewRow.clockSynced ? "#88ccff" : "#666666"
+                        font.pixelSize: 9
+                        
+                        ToolTip {
+                            visible: clockMouseArea.containsMouse
+                            text: overviewRow.clockSynced
+                                  ? "Horloge : décalage " + overviewRow.clockOffsetMs.toFixed(1) + " ms, aller-retour " + overviewRow.clockRttMs.toFixed(1) + " ms"
+                                  : "Horloge non synchronisée"
+                            delay: 500
+                        }
+                        
+                        MouseArea {
+                            id: clockMouseArea
+                            anchors.fill: parent
+                            hoverEnabled: true
+                        }
+                    }
                 }
                 
             }
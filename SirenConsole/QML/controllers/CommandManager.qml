@@ -18,6 +18,9 @@ QtObject {
     // Propriétés
     property var pupitreManager: null
     property var webSocketManager: null
+    property var configSyncManager: null
+    // Exécuteur C++ (CommandClient) ; sans lui, les lots passent par executeCommand en HTTP
+    property var commandClient: null
     
     // Signaux
     signal commandExecuted(string command, var result)
@@ -110,28 +113,36 @@ QtObject {
         })
     }
     
-    // Exécuter une commande sur un pupitre
-    function executeCommand(pupitreId, command, parameters) {
+    // Message d'erreur si la commande ne peut pas partir vers ce pupitre, "" sinon
+    function checkPupitreForCommand(pupitreId, command) {
         // Pour les commandes qui passent par PureData, on ne vérifie pas la connexion
         // car PureData gère le routage même si le pupitre n'est pas encore marqué comme connecté
         var skipConnectionCheck = (command === "set_ui_controls_enabled" || command === "autonomy_mode")
+        if (skipConnectionCheck) {
+            return ""
+        }
         
-        if (!pupitreManager && !skipConnectionCheck) {
-            commandError(command, "PupitreManager non disponible")
-            return false
+        if (!pupitreManager) {
+            return "PupitreManager non disponible"
         }
         
-        if (!skipConnectionCheck) {
-            var pupitre = pupitreManager.getPupitreById(pupitreId)
-            if (!pupitre) {
-                commandError(command, "Pupitre non trouvé: " + pupitreId)
-                return false
-            }
-            
-            if (!pupitre.connected) {
-                commandError(command, "Pupitre non connecté: " + pupitreId)
-                return false
-            }
+        var pupitre = pupitreManager.getPupitreById(pupitreId)
+        if (!pupitre) {
+            return "Pupitre non trouvé: " + pupitreId
+        }
+        
+        if (!pupitre.connected) {
+            return "Pupitre non connecté: " + pupitreId
+        }
+        return ""
+    }
+    
+    // Exécuter une commande sur un pupitre
+    function executeCommand(pupitreId, command, parameters) {
+        var checkError = checkPupitreForCommand(pupitreId, command)
+        if (checkError) {
+            commandError(command, checkError)
+            return false
         }
         
         var commandData = { pupitreId: pupitreId }
@@ -247,6 +258,27 @@ QtObject {
     
     // Commandes de mapping des contrôleurs
     function setControllerMapping(pupitreId, controllerType, cc, curve) {
+        // Patch de quelques octets vers le pupitre au lieu d'un CONFIG_FULL complet. Le relais
+        // MCFG dépend de PureData : tant que le pupitre n'a jamais acquitté de trame MCFG, la
+        // commande legacy part aussi (ack manquant = pupitre ou relais sans MCFG)
+        if (configSyncManager) {
+            var checkError = checkPupitreForCommand(pupitreId, "set_controller_mapping")
+            if (checkError) {
+                commandError("set_controller_mapping", checkError)
+                return false
+            }
+            configSyncManager.setValue(pupitreId, ["controllerMapping", controllerType], {
+                cc: cc,
+                curve: curve
+            })
+            if (configSyncManager.hasAck(pupitreId)) {
+                commandExecuted("set_controller_mapping", {
+                    pupitreId: pupitreId,
+                    parameters: { controller: controllerType, cc: cc, curve: curve }
+                })
+                return true
+            }
+        }
         return executeCommand(pupitreId, "set_controller_mapping", {
             controller: controllerType,
             cc: cc,
@@ -312,46 +344,126 @@ QtObject {
             return false
         }
         
-        // Exécution en lot
+        if (!commandClient) {
+            return executeBulkCommandsSequential(commands)
+        }
+        
         bulkOperationStarted(commands.length)
         
-        var successCount = 0
-        var errorCount = 0
-        var completed = 0
+        // Les commandes refusées localement comptent comme erreurs, les autres partent
+        // ensemble vers le serveur (un seul message COMMAND_BATCH, ordre conservé)
+        var valid = []
+        var rejected = 0
+        for (var i = 0; i < commands.length; i++) {
+            var checkError = checkPupitreForCommand(commands[i].pupitreId, commands[i].command)
+            if (checkError) {
+                commandError(commands[i].command, checkError)
+                rejected++
+            } else {
+                valid.push({
+                    pupitreId: commands[i].pupitreId,
+                    command: commands[i].command,
+                    parameters: commands[i].parameters || {}
+                })
+            }
+        }
         
-        function executeNext(index) {
-            if (index >= commands.length) {
-                bulkOperationCompleted(successCount, errorCount)
-                // Opération en lot terminée
+        if (valid.length === 0) {
+            bulkOperationProgress(commands.length, commands.length)
+            bulkOperationCompleted(0, rejected)
+            return true
+        }
+        
+        // Filtre par lot : plusieurs opérations en lot peuvent être en cours en même temps.
+        // L'id est connu avant la soumission car des commandes fusionnées dans le lot
+        // sont signalées pendant submitBatch.
+        var groupId = commandClient.nextGroupId()
+        function onFinished(id, group, pupitreId, command, success, message) {
+            if (group !== groupId) {
                 return
             }
-            
-            var command = commands[index]
-            var success = executeCommand(
-                command.pupitreId,
-                command.command,
-                command.parameters
-            )
-            
             if (success) {
-                successCount++
+                commandExecuted(command, { pupitreId: pupitreId })
             } else {
-                errorCount++
+                commandError(command, message)
+            }
+        }
+        function onProgress(group, completed, total) {
+            if (group === groupId) {
+                bulkOperationProgress(rejected + completed, commands.length)
+            }
+        }
+        function onBatchFinished(group, successCount, errorCount) {
+            if (group !== groupId) {
+                return
             }
-            
-            completed++
-            bulkOperationProgress(completed, commands.length)
-            
-            // Exécuter la commande suivante après un court délai
-            setTimeout(function() {
-                executeNext(index + 1)
-            }, 50)
+            commandClient.commandFinished.disconnect(onFinished)
+            commandClient.batchProgress.disconnect(onProgress)
+            commandClient.batchFinished.disconnect(onBatchFinished)
+            bulkOperationCompleted(successCount, errorCount + rejected)
+        }
+        commandClient.commandFinished.connect(onFinished)
+        commandClient.batchProgress.connect(onProgress)
+        commandClient.batchFinished.connect(onBatchFinished)
+        commandClient.submitBatch(valid)
+        return true
+    }
+    
+    // Ancien chemin : une requête HTTP par commande, espacées de 50 ms
+    property var sequentialQueue: []
+    property int sequentialTotal: 0
+    property int sequentialSuccess: 0
+    property int sequentialErrors: 0
+    property Timer sequentialTimer: Timer {
+        interval: 50
+        repeat: false
+        onTriggered: commandManager.executeNextSequential()
+    }
+    
+    function executeBulkCommandsSequential(commands) {
+        // Un lot déjà en cours : les nouvelles commandes passent à sa suite
+        if (sequentialQueue.length > 0 || sequentialTimer.running) {
+            sequentialQueue = sequentialQueue.concat(commands)
+            sequentialTotal += commands.length
+            bulkOperationStarted(sequentialTotal)
+            return true
         }
         
-        executeNext(0)
+        bulkOperationStarted(commands.length)
+        sequentialQueue = commands.slice()
+        sequentialTotal = commands.length
+        sequentialSuccess = 0
+        sequentialErrors = 0
+        executeNextSequential()
         return true
     }
     
+    function executeNextSequential() {
+        if (sequentialQueue.length === 0) {
+            bulkOperationCompleted(sequentialSuccess, sequentialErrors)
+            return
+        }
+        
+        var queue = sequentialQueue.slice()
+        var command = queue.shift()
+        sequentialQueue = queue
+        
+        var success = executeCommand(
+            command.pupitreId,
+            command.command,
+            command.parameters
+        )
+        if (success) {
+            sequentialSuccess++
+        } else {
+            sequentialErrors++
+        }
+        bulkOperationProgress(sequentialSuccess + sequentialErrors, sequentialTotal)
+        
+        // Exécuter la commande suivante après un court délai
+        sequentialTimer.start()
+    }
+    
     // Commandes de contrôle global
     function enableAllSirenes(pupitreId) {
         var commands = []
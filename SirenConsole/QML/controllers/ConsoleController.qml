@@ -1,5 +1,7 @@
 import QtQuick 2.15
+import SirenConsole 1.0
 import "../utils" as Utils
+import "../utils/PresetDiff.js" as PresetDiff
 
 Item {
     id: consoleController
@@ -105,6 +107,7 @@ Item {
     PresetManager {
         id: presetManager
         configManager: configManager
+        configSyncManager: configSyncManager
     }
     
     PupitreManager {
@@ -117,6 +120,36 @@ Item {
         id: commandManager
         pupitreManager: pupitreManager
         webSocketManager: webSocketManager
+        configSyncManager: configSyncManager
+        commandClient: commandClient
+    }
+    
+    // Commandes en lot : une connexion WebSocket, lots COMMAND_BATCH, fenêtre d'envoi bornée
+    CommandClient {
+        id: commandClient
+        serverUrl: webSocketManager.serverUrl
+    }
+    
+    // Sync de config incrémentale (patchs CBOR versionnés par pupitre)
+    ConfigSyncManager {
+        id: configSyncManager
+        onFrameReady: function(pupitreId, frame) {
+            webSocketManager.sendBinaryMessage(frame)
+        }
+        // Décalage ou ack manquant sans config complète connue : on la redemande au pupitre,
+        // le snapshot part à la réception (PUPITRE_CONFIG_FULL)
+        onResyncRequired: function(pupitreId) {
+            webSocketManager.sendMessage({ type: "REQUEST_PUPITRE_CONFIG", pupitreId: pupitreId })
+        }
+    }
+    
+    // Config complète d'un pupitre (CONFIG_FULL relayé par le serveur, à chaque connexion du
+    // pupitre et sur demande) : devient la base de sa sync et part en snapshot
+    function pushFullConfig(pupitreId, config) {
+        if (!configSyncManager || !pupitreId || !config)
+            return
+        configSyncManager.pushConfig(pupitreId, config)
+        configSyncManager.resync(pupitreId)
     }
     
     SireneManager {
@@ -130,10 +163,31 @@ Item {
     WebSocketManager {
         id: webSocketManager
         consoleController: consoleController
+        pureDataConnected: pupitreStatusModel.pureDataConnected
+    }
+    
+    // Statut agrégé P1-P7 poussé par le serveur (une connexion WebSocket dédiée, pas de polling)
+    PupitreStatusModel {
+        id: pupitreStatusModel
+        serverUrl: webSocketManager.serverUrl
+    }
+    
+    // Nom, host et ambitus viennent de la config : recopiés dans le modèle (dataChanged seulement si différent)
+    onPupitresChanged: {
+        for (var i = 0; i < pupitres.length; i++) {
+            var p = pupitres[i]
+            pupitreStatusModel.setPupitreInfo(p.id, {
+                ambitusMin: p.ambitusMin,
+                ambitusMax: p.ambitusMax
+            })
+        }
     }
     
     // Exposer les managers publiquement
     property var sireneManager: sireneManager
+    property var configSyncManager: configSyncManager
+    property alias pupitreStatusModel: pupitreStatusModel
+    property alias commandClient: commandClient
     property var sirenRouterManager: sirenRouterManager
     
     // Propriétés calculées réactives pour l'UI (P1-P7)
@@ -516,6 +570,21 @@ Item {
         return false
     }
     
+    // Édition d'un onglet de config (PATCH /api/presets/current/...) : valeurs à pousser par
+    // ConfigSyncManager, ou null si le serveur doit relayer en PARAM_UPDATE. Toute écriture
+    // vers un pupitre passe ainsi par l'état poussé que compare l'application des presets.
+    function pupitreEditUpdates(url, body) {
+        if (!configSyncManager)
+            return null
+        var partial = PresetDiff.editToPupitre(url, body)
+        return partial ? PresetDiff.pupitreUpdates(partial) : null
+    }
+    
+    function pushPupitreUpdates(pupitreId, updates) {
+        for (var i = 0; i < updates.length; i++)
+            configSyncManager.setValue(pupitreId, updates[i].path, updates[i].value)
+    }
+    
     // Gestion des pupitres
     function getCurrentPupitre() {
         if (pupitreManager) {
@@ -22,6 +22,8 @@ QtObject {
     property string selectedFile: ""
     property bool loading: false
     property string error: ""
+    // Filtres appliqués par le serveur (siren, minSuitability, maxDuration, maxDensity, q)
+    property var filters: ({})
     
     // Référence au WebSocketManager (sera injecté)
     property var websocketManager: null
@@ -64,6 +66,13 @@ QtObject {
         }
         
         var url = apiUrl + "/api/midi/files"
+        var query = []
+        for (var key in filters) {
+            if (filters[key] !== undefined && filters[key] !== "")
+                query.push(encodeURIComponent(key) + "=" + encodeURIComponent(filters[key]))
+        }
+        if (query.length > 0)
+            url += "?" + query.join("&")
         // Loading MIDI files
         xhr.open("GET", url)
         xhr.send()
@@ -164,6 +173,29 @@ QtObject {
         return []
     }
     
+    // Résumé des métadonnées `info` de l'analyse serveur : "3:24 · 120 BPM · 4/4 · 1520 notes"
+    function formatInfo(info) {
+        if (!info)
+            return ""
+        if (info.error)
+            return "⚠️ " + info.error
+        var seconds = Math.round((info.duration || 0) / 1000)
+        var parts = [Math.floor(seconds / 60) + ":" + ("0" + seconds % 60).slice(-2),
+                     info.tempo + " BPM"]
+        if (info.timeSignature)
+            parts.push(info.timeSignature.numerator + "/" + info.timeSignature.denominator)
+        parts.push(info.noteCount + " notes")
+        // Sirènes qui jouent toutes les notes (hors percussions)
+        var playable = []
+        for (var siren in info.suitability) {
+            if (info.suitability[siren] >= 1)
+                playable.push("S" + siren)
+        }
+        if (playable.length > 0)
+            parts.push(playable.join(" "))
+        return parts.join(" · ")
+    }
+    
     // Formater le nom de fichier pour affichage
     function formatFileName(fileName) {
         // Retirer l'extension .midi/.mid
@@ -1,5 +1,7 @@
 import QtQuick 2.15
+import SirenConsole 1.0
 import "../utils" as Utils
+import "../utils/PresetDiff.js" as PresetDiff
 
 QtObject {
     id: presetManager
@@ -19,6 +21,33 @@ QtObject {
     property var presets: []
     property string currentPreset: ""
     property var configManager: null
+    // Envoi différentiel vers les pupitres (patchs "MCFG", un par pupitre)
+    property var configSyncManager: null
+    
+    // Application en cours : pupitres en attente d'ack, changements envoyés, latence max
+    property var _applying: ({})
+    property string _applyingName: ""
+    property int _applyingChanges: 0
+    property int _applyingDesks: 0
+    property real _applyingLatencyMs: 0
+    
+    property Connections _syncConnections: Connections {
+        target: presetManager.configSyncManager
+        function onPatchApplied(pupitreId, version, operations, latencyMs) {
+            if (!presetManager._applying[pupitreId])
+                return
+            delete presetManager._applying[pupitreId]
+            presetManager._applyingLatencyMs = Math.max(presetManager._applyingLatencyMs, latencyMs)
+            if (Object.keys(presetManager._applying).length === 0)
+                presetManager.finishApply()
+        }
+    }
+    
+    // Pupitre déconnecté : on rapporte sans lui
+    property Timer _applyTimeout: Timer {
+        interval: 2000
+        onTriggered: presetManager.finishApply()
+    }
     
     // Signaux
     signal presetsListChanged(var presetsList)
@@ -26,6 +55,8 @@ QtObject {
     signal presetSaved(string presetName)
     signal presetDeleted(string presetName)
     signal presetError(string error)
+    // Preset appliqué aux pupitres : changements envoyés, pupitres concernés, latence jusqu'au dernier ack
+    signal presetApplied(string presetName, int changes, int desks, real latencyMs, var missingDesks)
     
     // Initialisation
     Component.onCompleted: {
@@ -273,6 +304,8 @@ QtObject {
             // Appliquer la configuration du preset
             if (presetToLoad.config && presetToLoad.config.pupitres) {
                 var presetPupitres = presetToLoad.config.pupitres
+                // Envoi aux pupitres avant la mise à jour locale : seuls les paramètres modifiés partent
+                applyToDesks(presetName, presetPupitres)
                 var allPupitres = configManager.getAllPupitres()
                 
                 for (var i = 0; i < allPupitres.length; i++) {
@@ -296,6 +329,8 @@ QtObject {
                         if (presetPupitre.udpEnabled !== undefined) pupitre.udpEnabled = presetPupitre.udpEnabled
                         if (presetPupitre.rtpMidiEnabled !== undefined) pupitre.rtpMidiEnabled = presetPupitre.rtpMidiEnabled
                         if (presetPupitre.controllerMapping) pupitre.controllerMapping = presetPupitre.controllerMapping
+                        if (presetPupitre.sirenes) pupitre.sirenes = presetPupitre.sirenes
+                        if (presetPupitre.gameMode !== undefined) pupitre.gameMode = presetPupitre.gameMode
                         
                         // Configuration appliquée au pupitre
                     }
@@ -314,6 +349,52 @@ QtObject {
         }
     }
     
+    // Diff par pupitre entre l'état déjà poussé et le preset ; les setValue d'un même tour
+    // de boucle partent en un seul patch par pupitre, dans l'ordre de PresetDiff
+    function applyToDesks(presetName, presetPupitres) {
+        if (!configSyncManager)
+            return
+        if (_applyTimeout.running)
+            finishApply()
+        
+        var applying = {}
+        var changes = 0
+        for (var i = 0; i < presetPupitres.length; i++) {
+            var pupitreId = presetPupitres[i].id
+            if (!pupitreId)
+                continue
+            var changed = PresetDiff.changedUpdates(PresetDiff.pupitreUpdates(presetPupitres[i]), function(path) {
+                return configSyncManager.valueAt(pupitreId, path)
+            })
+            for (var j = 0; j < changed.length; j++)
+                configSyncManager.setValue(pupitreId, changed[j].path, changed[j].value)
+            if (changed.length > 0) {
+                applying[pupitreId] = true
+                changes += changed.length
+            }
+        }
+        
+        _applying = applying
+        _applyingName = presetName
+        _applyingChanges = changes
+        _applyingDesks = Object.keys(applying).length
+        _applyingLatencyMs = 0
+        if (_applyingDesks === 0)
+            finishApply()
+        else
+            _applyTimeout.restart()
+    }
+    
+    function finishApply() {
+        _applyTimeout.stop()
+        var missing = Object.keys(_applying)
+        _applying = {}
+        Log.debug("PRESET", () => ["Preset", _applyingName, "appliqué:", _applyingChanges, "changements,",
+                                   _applyingDesks, "pupitres,", Math.round(_applyingLatencyMs), "ms"
+                                   + (missing.length > 0 ? " (sans ack: " + missing.join(", ") + ")" : "")])
+        presetApplied(_applyingName, _applyingChanges, _applyingDesks, _applyingLatencyMs, missing)
+    }
+    
     // Obtenir un preset par nom
     function getPresetByName(presetName) {
         for (var i = 0; i < presets.length; i++) {
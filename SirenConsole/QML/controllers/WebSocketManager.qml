@@ -103,16 +103,14 @@ Item {
         }
     }
     
-    // === TIMER DE VÉRIFICATION (statut pupitres + ping) ===
+    // === TIMER DE PING ===
     Timer {
         id: statusTimer
         interval: 2000 // Vérifier toutes les 2 secondes
         running: true
         repeat: true
         onTriggered: {
-            // Poll HTTP en secours
-            webSocketManager.checkPureDataStatus()
-            webSocketManager.checkPupitresStatus()
+            // Plus de poll HTTP : les statuts arrivent en push (PUPITRE_STATUS_DELTA, PupitreStatusModel)
             
             // Ping pour maintenir la connexion WS
             if (webSocketManager.connected) {
@@ -157,6 +155,10 @@ Item {
                 onTextMessageReceived: function(message) {
                     webSocketManager.handleWebSocketMessage(message)
                 }
+                
+                onBinaryMessageReceived: function(message) {
+                    webSocketManager.handleBinaryMessage(message)
+                }
             }
         ', webSocketManager)
     }
@@ -240,6 +242,12 @@ Item {
                     }
                     break
                     
+                case "PUPITRE_CONFIG_FULL":
+                    if (data.pupitreId && data.config && consoleController && consoleController.pushFullConfig) {
+                        consoleController.pushFullConfig(data.pupitreId, data.config)
+                    }
+                    break
+                    
                 case "PUPITRE_DISCONNECTED":
                     // Mettre à jour immédiatement le statut de déconnexion
                     if (data.pupitreId && consoleController) {
@@ -253,38 +261,19 @@ Item {
                     }
                     break
                     
-                case "PUPITRE_STATUS_UPDATE":
-                    // Mettre à jour les statuts des pupitres dans l'interface
-                    if (data.data && data.data.connections && consoleController) {
-                        // console.log("🎛️ consoleController trouvé, mise à jour des statuts")
-                        for (var i = 0; i < data.data.connections.length; i++) {
-                            try {
-                                var pupitreStatus = data.data.connections[i]
-                                // console.log("🎛️ Pupitre", pupitreStatus.pupitreId, "connected:", pupitreStatus.connected)
-                                var statusText = pupitreStatus.connected ? "connected" : "disconnected"
-                                // console.log("🎛️ Appel updatePupitreStatus pour", pupitreStatus.pupitreId, "avec status:", statusText)
-                                if (consoleController.updatePupitreStatus) {
-                                    consoleController.updatePupitreStatus(pupitreStatus.pupitreId, statusText)
-                                }
-                                
-                                // Mettre à jour aussi l'état de synchronisation si présent
-                                if (pupitreStatus.isSynced !== undefined) {
-                                    var propName = "pupitre" + pupitreStatus.pupitreId.substring(1) + "Synced" // P1 -> pupitre1Synced
-                                    try {
-                                        consoleController[propName] = pupitreStatus.isSynced || false
-                                    } catch (e) {
-                                        // Propriété n'existe pas, ignorer
-                                    }
-                                }
-                            } catch (e) {
-                                // Ignorer les erreurs pour éviter le spam
+                case "PUPITRE_STATUS_DELTA":
+                    // Seuls les champs modifiés sont présents dans data.fields
+                    if (data.pupitreId && data.fields && consoleController) {
+                        try {
+                            if (data.fields.connected !== undefined && consoleController.updatePupitreStatus) {
+                                consoleController.updatePupitreStatus(data.pupitreId, data.fields.connected ? "connected" : "disconnected")
+                            }
+                            if (data.fields.isSynced !== undefined) {
+                                consoleController["pupitre" + data.pupitreId.substring(1) + "Synced"] = data.fields.isSynced || false
                             }
+                        } catch (e) {
+                            // Ignorer les erreurs
                         }
-                    } else {
-                        // console.log("❌ consoleController non trouvé ou données manquantes")
-                        // console.log("❌ consoleController:", consoleController)
-                        // console.log("❌ data.data:", data.data)
-                        // console.log("❌ data.data.connections:", data.data ? data.data.connections : "undefined")
                     }
                     break
                 case "VOLANT_DATA":
@@ -318,55 +307,6 @@ Item {
         messageReceived(serverUrl, message)
     }
     
-    // Vérifier le statut de la connexion PureData (via HTTP)
-    function checkPureDataStatus() {
-        var xhr = new XMLHttpRequest()
-        var self = webSocketManager
-        xhr.onreadystatechange = function() {
-            if (xhr.readyState === XMLHttpRequest.DONE && xhr.status === 200) {
-                try {
-                    var status = JSON.parse(xhr.responseText)
-                    self.pureDataConnected = status.connected
-                } catch (e) {
-                    // Ignorer erreur silencieusement
-                }
-            }
-        }
-        var apiUrl = networkUtils.getApiBaseUrl()
-        xhr.open("GET", apiUrl + "/api/puredata/status")
-        xhr.send()
-    }
-    
-    // Vérifier le statut des pupitres (pour les LEDs)
-    function checkPupitresStatus() {
-        var xhr = new XMLHttpRequest()
-        var self = webSocketManager
-        xhr.onreadystatechange = function() {
-            if (xhr.readyState === XMLHttpRequest.DONE && xhr.status === 200) {
-                try {
-                    var status = JSON.parse(xhr.responseText)
-                    // Statut pupitres mis à jour
-                    
-                    // Mettre à jour le statut de chaque pupitre
-                    for (var i = 0; i < status.connections.length; i++) {
-                        var pupitreStatus = status.connections[i]
-                        var statusText = pupitreStatus.connected ? "connected" : "disconnected"
-                        
-                        // Notifier le ConsoleController du changement de statut
-                        if (self.consoleController) {
-                            self.consoleController.pupitreStatusChanged(pupitreStatus.pupitreId, statusText)
-                        }
-                    }
-                } catch (e) {
-                    // Erreur parsing statut pupitres
-                }
-            }
-        }
-        var apiUrl = networkUtils.getApiBaseUrl()
-        xhr.open("GET", apiUrl + "/api/pupitres/status")
-        xhr.send()
-    }
-    
     // === MÉTHODES PUBLIQUES ===
     
     // Se connecter au serveur Node.js
@@ -400,6 +340,22 @@ Item {
         return true
     }
     
+    // Envoyer une trame binaire brute au serveur Node.js (ex. trames de sync de config "MCFG")
+    function sendBinaryMessage(buffer) {
+        if (!connected || !webSocket) {
+            return false
+        }
+        webSocket.sendBinaryMessage(buffer)
+        return true
+    }
+    
+    // Trames binaires reçues du serveur (acks / demandes de resync des pupitres)
+    function handleBinaryMessage(message) {
+        if (consoleController && consoleController.configSyncManager) {
+            consoleController.configSyncManager.handleFrame(message)
+        }
+    }
+    
     // Envoyer une commande à PureData (via HTTP POST au proxy) - MÉTHODE LEGACY
     function sendPureDataCommand(message) {
         // Envoi commande via proxy HTTP (legacy)
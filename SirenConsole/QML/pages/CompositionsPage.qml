@@ -228,6 +228,17 @@ Rectangle {
                                 }
                                 
                                 Item { Layout.fillWidth: true }
+                                
+                                // Filtre serveur : compositions entièrement jouables par une sirène
+                                ComboBox {
+                                    implicitHeight: 30
+                                    model: ["Toutes sirènes", "S1", "S2", "S3", "S4", "S5", "S6", "S7"]
+                                    enabled: !midiFileManager.loading
+                                    onActivated: function(index) {
+                                        midiFileManager.filters = index > 0 ? { siren: String(index) } : {}
+                                        midiFileManager.loadMidiFiles()
+                                    }
+                                }
                             }
                         }
                         
@@ -261,7 +272,7 @@ Rectangle {
                             
                             delegate: Rectangle {
                                 width: fileListView.width - 10
-                                height: 70
+                                height: 86
                                 color: midiFileManager.selectedFile === modelData.path ? "#3a3a3a" : "#1a1a1a"
                                 radius: 4
                                 
@@ -314,6 +325,15 @@ Rectangle {
                                             elide: Text.ElideRight
                                             Layout.fillWidth: true
                                         }
+                                        
+                                        Text {
+                                            text: midiFileManager.formatInfo(modelData.info)
+                                            visible: text !== ""
+                                            color: modelData.info && modelData.info.error ? "#ff8844" : "#88aacc"
+                                            font.pixelSize: 11
+                                            elide: Text.ElideRight
+                                            Layout.fillWidth: true
+                                        }
                                     }
                                     
                                     // Bouton charger
@@ -13,13 +13,17 @@ Rectangle {
        // Page initialisée
     }
     
-    // Timer de refresh désactivé (polling manuel via WebSocketManager si besoin)
-    Timer {
-        id: refreshTimer
-        interval: 2000
-        running: false
-        repeat: false
-        onTriggered: {}
+    // Écart maximal possible entre pupitres sur l'horloge de spectacle
+    Text {
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 4
+        z: 1
+        property var statusModel: overviewPage.consoleController ? overviewPage.consoleController.pupitreStatusModel : null
+        visible: statusModel !== null && statusModel.clockSkewMs > 0
+        text: statusModel ? "⏱ écart inter-pupitres ≤ " + statusModel.clockSkewMs.toFixed(1) + " ms" : ""
+        color: statusModel && statusModel.clockSkewMs > 5 ? "#ffaa44" : "#88ccff"
+        font.pixelSize: 10
     }
     
     ScrollView {
@@ -37,124 +41,29 @@ Rectangle {
             width: parent.width
             spacing: 8
             
-            // Rangées des pupitres - P1
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P1"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre1Status
-                property string pupitreName: "Pupitre 1"
-                property string pupitreHost: "192.168.1.41"
-                property real currentNote: overviewPage.consoleController.pupitre1CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre1CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre1CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre1AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre1AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre1Synced : false
+            // Rangées des pupitres P1-P7 : le modèle C++ pousse les changements rôle par rôle
+            Repeater {
+                model: overviewPage.consoleController ? overviewPage.consoleController.pupitreStatusModel : null
                 
-                width: parent.width
-            }
-            
-            // P2
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P2"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre2Status
-                property string pupitreName: "Pupitre 2"
-                property string pupitreHost: "192.168.1.42"
-                property real currentNote: overviewPage.consoleController.pupitre2CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre2CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre2CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre2AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre2AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre2Synced : false
-                width: parent.width
-            }
-            
-            // P3
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P3"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre3Status
-                property string pupitreName: "Pupitre 3"
-                property string pupitreHost: "192.168.1.43"
-                property real currentNote: overviewPage.consoleController.pupitre3CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre3CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre3CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre3AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre3AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre3Synced : false
-                width: parent.width
-            }
-            
-            // P4
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P4"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre4Status
-                property string pupitreName: "Pupitre 4"
-                property string pupitreHost: "192.168.1.44"
-                property real currentNote: overviewPage.consoleController.pupitre4CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre4CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre4CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre4AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre4AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre4Synced : false
-                width: parent.width
-            }
-            
-            // P5
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P5"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre5Status
-                property string pupitreName: "Pupitre 5"
-                property string pupitreHost: "192.168.1.45"
-                property real currentNote: overviewPage.consoleController.pupitre5CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre5CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre5CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre5AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre5AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre5Synced : false
-                width: parent.width
-            }
-            
-            // P6
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P6"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre6Status
-                property string pupitreName: "Pupitre 6"
-                property string pupitreHost: "192.168.1.46"
-                property real currentNote: overviewPage.consoleController.pupitre6CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre6CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre6CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre6AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre6AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre6Synced : false
-                width: parent.width
-            }
-            
-            // P7
-            Loader {
-                source: "../components/overview/OverviewRow.qml"
-                property string pupitreId: "P7"
-                property var consoleController: overviewPage.consoleController
-                property string pupitreStatus: overviewPage.consoleController.pupitre7Status
-                property string pupitreName: "Pupitre 7"
-                property string pupitreHost: "192.168.1.47"
-                property real currentNote: overviewPage.consoleController.pupitre7CurrentNote
-                property real currentHz: overviewPage.consoleController.pupitre7CurrentHz
-                property real currentRpm: overviewPage.consoleController.pupitre7CurrentRpm
-                property int ambitusMin: overviewPage.consoleController.pupitre7AmbitusMin
-                property int ambitusMax: overviewPage.consoleController.pupitre7AmbitusMax
-                property bool pupitreSynced: overviewPage.consoleController ? overviewPage.consoleController.pupitre7Synced : false
-                width: parent.width
+                delegate: Loader {
+                    source: "../components/overview/OverviewRow.qml"
+                    property string pupitreId: model.pupitreId
+                    property var consoleController: overviewPage.consoleController
+                    property string pupitreStatus: model.pupitreStatus
+                    property string pupitreName: model.pupitreName
+                    property string pupitreHost: model.pupitreHost !== "" ? model.pupitreHost : "192.168.1.4" + (index + 1)
+                    property real currentNote: model.currentNote
+                    property real currentHz: model.currentHz
+                    property real currentRpm: model.currentRpm
+                    property int ambitusMin: model.ambitusMin
+                    property int ambitusMax: model.ambitusMax
+                    property bool pupitreSynced: model.pupitreSynced
+                    property bool clockSynced: model.clockSynced
+                    property real clockOffsetMs: model.clockOffsetMs
+                    property real clockRttMs: model.clockRttMs
+                    
+                    width: parent.width
+                }
             }
         }
     }
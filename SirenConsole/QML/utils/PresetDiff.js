@@ -0,0 +1,128 @@
+// Application différentielle des presets
+// Valeurs d'un pupitre au format preset → chemins de la config du pupitre, dans l'ordre
+// de dépendance. Partagé avec le serveur Node (PARAM_UPDATE de webfiles/server.js) :
+// pas de .pragma library, export module.exports en fin de fichier comme config.js
+
+// Ordre d'application : sirènes assignées avant leurs réglages, mode jeu en dernier
+// (il relit les sirènes et les contrôleurs à son activation)
+function pupitreUpdates(presetPupitre) {
+    var updates = []
+    if (!presetPupitre)
+        return updates
+
+    if (Array.isArray(presetPupitre.assignedSirenes)) {
+        updates.push({
+            path: ["sirenConfig", "currentSirens"],
+            value: presetPupitre.assignedSirenes.map(function(n) { return String(n) })
+        })
+    }
+
+    if (presetPupitre.sirenes) {
+        var keys = Object.keys(presetPupitre.sirenes).sort(function(a, b) {
+            return parseInt(a.replace("sirene", ""), 10) - parseInt(b.replace("sirene", ""), 10)
+        })
+        for (var i = 0; i < keys.length; i++) {
+            var sireneNum = parseInt(keys[i].replace("sirene", ""), 10)
+            if (isNaN(sireneNum) || sireneNum < 1)
+                continue
+            var sirene = presetPupitre.sirenes[keys[i]]
+            if (sirene.ambitusRestricted !== undefined)
+                updates.push({ path: ["sirenConfig", "sirens", sireneNum - 1, "ambitus", "restricted"],
+                               value: sirene.ambitusRestricted ? 1 : 0 })
+            if (sirene.frettedMode !== undefined)
+                updates.push({ path: ["sirenConfig", "sirens", sireneNum - 1, "frettedMode", "enabled"],
+                               value: sirene.frettedMode ? 1 : 0 })
+        }
+    }
+
+    var outputs = ["vstEnabled", "udpEnabled", "rtpMidiEnabled"]
+    for (var o = 0; o < outputs.length; o++) {
+        if (presetPupitre[outputs[o]] !== undefined)
+            updates.push({ path: ["outputConfig", outputs[o]], value: presetPupitre[outputs[o]] ? 1 : 0 })
+    }
+
+    if (presetPupitre.controllerMapping) {
+        for (var ctrl in presetPupitre.controllerMapping) {
+            var mapping = presetPupitre.controllerMapping[ctrl]
+            if (!mapping)
+                continue
+            var cc = parseInt(mapping.cc, 10)
+            if (!isNaN(cc))
+                updates.push({ path: ["controllerMapping", ctrl, "cc"], value: cc })
+            if (mapping.curve)
+                updates.push({ path: ["controllerMapping", ctrl, "curve"], value: String(mapping.curve) })
+        }
+    }
+
+    if (presetPupitre.gameMode !== undefined)
+        updates.push({ path: ["gameMode", "enabled"], value: presetPupitre.gameMode ? 1 : 0 })
+
+    return updates
+}
+
+// Édition ponctuelle (corps d'un PATCH /api/presets/current/...) → entrée pupitre partielle
+// au format preset, null si la route ne touche pas la config du pupitre
+function editToPupitre(url, body) {
+    if (!body || !body.pupitreId)
+        return null
+
+    if (url.indexOf("/assigned-sirenes") >= 0)
+        return { assignedSirenes: Array.isArray(body.assignedSirenes) ? body.assignedSirenes : [] }
+
+    if (url.indexOf("/sirene-config") >= 0) {
+        var sireneNum = parseInt(body.sireneId, 10)
+        if (isNaN(sireneNum))
+            return null
+        var sirenes = {}
+        sirenes["sirene" + sireneNum] = body.changes || {}
+        return { sirenes: sirenes }
+    }
+
+    if (url.indexOf("/outputs") >= 0) {
+        var outputs = {}
+        var changes = body.changes || {}
+        var keys = ["vstEnabled", "udpEnabled", "rtpMidiEnabled"]
+        for (var i = 0; i < keys.length; i++) {
+            if (changes[keys[i]] !== undefined)
+                outputs[keys[i]] = !!changes[keys[i]]
+        }
+        return outputs
+    }
+
+    if (url.indexOf("/controller-mapping") >= 0) {
+        if (!body.controller)
+            return null
+        var mapping = {}
+        mapping[body.controller] = { cc: body.cc, curve: body.curve }
+        return { controllerMapping: mapping }
+    }
+
+    if (url.indexOf("/game-mode") >= 0)
+        return { gameMode: !!body.gameMode }
+
+    return null
+}
+
+function sameValue(a, b) {
+    if (a === b)
+        return true
+    if (a === undefined || a === null || b === undefined || b === null)
+        return false
+    return JSON.stringify(a) === JSON.stringify(b)
+}
+
+// Seules les valeurs qui diffèrent de l'état courant (currentValue(path)) sont gardées, ordre conservé
+function changedUpdates(updates, currentValue) {
+    return updates.filter(function(update) {
+        return !sameValue(currentValue(update.path), update.value)
+    })
+}
+
+// Export pour Node.js
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = {
+        pupitreUpdates: pupitreUpdates,
+        editToPupitre: editToPupitre,
+        changedUpdates: changedUpdates
+    };
+}
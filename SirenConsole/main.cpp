@@ -3,6 +3,12 @@
 #include <QQmlContext>
 #include <QDir>
 #include <QStandardPaths>
+#include <QtQml>
+#include "src/ConfigSyncManager.h"
+#include "src/CommandClient.h"
+#include "src/Models/PupitreStatusModel.h"
+#include "src/Models/CommandResultModel.h"
+#include "LogQml.h"
 
 int main(int argc, char *argv[])
 {
@@ -14,6 +20,16 @@ int main(int argc, char *argv[])
     app.setOrganizationName("Mecaviv");
     app.setOrganizationDomain("mecaviv.com");
 
+    // Niveaux MecavivLog : MECAVIV_LOG="*=info", MECAVIV_LOG_FILE=...
+    MecavivLog::configureFromEnvironment();
+
+    // Enregistrer les types QML
+    qmlRegisterType<ConfigSyncManager>("SirenConsole", 1, 0, "ConfigSyncManager");
+    qmlRegisterType<PupitreStatusModel>("SirenConsole", 1, 0, "PupitreStatusModel");
+    qmlRegisterType<CommandClient>("SirenConsole", 1, 0, "CommandClient");
+    qmlRegisterUncreatableType<CommandResultModel>("SirenConsole", 1, 0, "CommandResultModel", "Fourni par CommandClient.results");
+    LogQml::registerQmlType("SirenConsole", 1, 0);
+
     // Créer le moteur QML
     QQmlApplicationEngine engine;
 
@@ -0,0 +1,381 @@
+#include "CommandClient.h"
+#include <QDateTime>
+#include <algorithm>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace {
+constexpr int kMinReconnectDelay = 500;
+constexpr int kMaxReconnectDelay = 10000;
+constexpr int kDefaultInFlightWindow = 64;
+constexpr int kDefaultTimeout = 5000;
+constexpr int kTimeoutCheckInterval = 500;
+
+// Commandes dont seul le dernier envoi compte (une valeur plus récente rend la précédente inutile).
+// Les actions (ping, reset, save_config, ...) ne sont jamais fusionnées.
+bool isMergeable(const QString &command)
+{
+    return command.startsWith(QLatin1String("set_"))
+        || command.startsWith(QLatin1String("enable_"))
+        || command.startsWith(QLatin1String("disable_"))
+        || command.startsWith(QLatin1String("sirene_"))
+        || command.endsWith(QLatin1String("_value"))
+        || command == QLatin1String("joystick_position")
+        || command == QLatin1String("autonomy_mode");
+}
+}
+
+CommandClient::CommandClient(QObject *parent)
+    : QObject(parent)
+    , m_reconnectDelay(kMinReconnectDelay)
+    , m_inFlightWindow(kDefaultInFlightWindow)
+    , m_timeoutMs(kDefaultTimeout)
+    , m_nextId(1)
+    , m_nextGroupId(1)
+    , m_nextBatchId(1)
+{
+    connect(&m_socket, &QWebSocket::connected, this, &CommandClient::onConnected);
+    connect(&m_socket, &QWebSocket::disconnected, this, &CommandClient::onDisconnected);
+    connect(&m_socket, &QWebSocket::textMessageReceived, this, &CommandClient::onTextMessageReceived);
+    connect(&m_socket, &QWebSocket::binaryMessageReceived, this, &CommandClient::onBinaryMessageReceived);
+
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &CommandClient::openSocket);
+
+    // Regroupement : tout ce qui est soumis pendant le tour de boucle courant part ensemble
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(0);
+    connect(&m_flushTimer, &QTimer::timeout, this, &CommandClient::flush);
+
+    m_timeoutTimer.setInterval(kTimeoutCheckInterval);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &CommandClient::checkTimeouts);
+}
+
+void CommandClient::setServerUrl(const QUrl &url)
+{
+    if (m_serverUrl == url)
+        return;
+    m_serverUrl = url;
+    emit serverUrlChanged();
+
+    m_reconnectTimer.stop();
+    m_reconnectDelay = kMinReconnectDelay;
+    if (m_socket.state() != QAbstractSocket::UnconnectedState)
+        m_socket.close();   // onDisconnected relancera openSocket
+    else
+        openSocket();
+}
+
+void CommandClient::setInFlightWindow(int window)
+{
+    window = qMax(1, window);
+    if (m_inFlightWindow == window)
+        return;
+    m_inFlightWindow = window;
+    emit inFlightWindowChanged();
+    scheduleFlush();
+}
+
+void CommandClient::setTimeoutMs(int timeoutMs)
+{
+    timeoutMs = qMax(100, timeoutMs);
+    if (m_timeoutMs == timeoutMs)
+        return;
+    m_timeoutMs = timeoutMs;
+    emit timeoutMsChanged();
+}
+
+int CommandClient::submit(const QString &pupitreId, const QString &command, const QVariantMap &parameters)
+{
+    return enqueue(0, pupitreId, command, parameters);
+}
+
+int CommandClient::submitBatch(const QVariantList &commands)
+{
+    const int groupId = m_nextGroupId++;
+    Group group;
+    group.total = commands.size();
+    m_groups.insert(groupId, group);
+
+    for (const QVariant &entry : commands) {
+        const QVariantMap map = entry.toMap();
+        enqueue(groupId,
+                map.value(QStringLiteral("pupitreId")).toString(),
+                map.value(QStringLiteral("command")).toString(),
+                map.value(QStringLiteral("parameters")).toMap());
+    }
+
+    if (commands.isEmpty()) {
+        m_groups.remove(groupId);
+        emit batchFinished(groupId, 0, 0);
+    }
+    return groupId;
+}
+
+int CommandClient::enqueue(int groupId, const QString &pupitreId, const QString &command, const QVariantMap &parameters)
+{
+    PendingCommand pending;
+    pending.id = m_nextId++;
+    pending.groupId = groupId;
+    pending.pupitreId = pupitreId;
+    pending.command = command;
+    pending.payload = buildPayload(pupitreId, command, parameters);
+    pending.submittedAt = QDateTime::currentMSecsSinceEpoch();
+    if (isMergeable(command))
+        pending.mergeKey = mergeKey(pupitreId, command, parameters);
+
+    CommandResult entry;
+    entry.id = pending.id;
+    entry.batchId = groupId;
+    entry.pupitreId = pupitreId;
+    entry.command = command;
+    entry.status = QStringLiteral("queued");
+    entry.submittedAt = pending.submittedAt;
+    entry.latencyMs = -1;
+    m_results.addEntry(entry);
+
+    m_commands.insert(pending.id, pending);
+
+    // Une commande plus récente sur la même cible remplace celle encore en file,
+    // sauf si d'autres commandes du pupitre ont été soumises entre les deux : elles
+    // pourraient dépendre de l'ancienne valeur.
+    if (!pending.mergeKey.isEmpty()) {
+        const auto it = m_queuedByKey.constFind(pending.mergeKey);
+        if (it != m_queuedByKey.constEnd() && canMerge(it.value(), pupitreId)) {
+            const int supersededId = it.value();
+            m_queue.removeOne(supersededId);
+            finish(supersededId, QStringLiteral("merged"), true,
+                   QStringLiteral("Remplacée par la commande %1").arg(pending.id));
+        }
+        m_queuedByKey.insert(pending.mergeKey, pending.id);
+    }
+
+    m_queue.append(pending.id);
+    emit queueChanged();
+    scheduleFlush();
+    return pending.id;
+}
+
+bool CommandClient::canMerge(int supersededId, const QString &pupitreId) const
+{
+    for (qsizetype i = m_queue.size() - 1; i >= 0; --i) {
+        const int id = m_queue.at(i);
+        if (id == supersededId)
+            return true;
+        if (m_commands.value(id).pupitreId == pupitreId)
+            return false;
+    }
+    return false;
+}
+
+void CommandClient::scheduleFlush()
+{
+    if (!m_queue.isEmpty() && !m_flushTimer.isActive())
+        m_flushTimer.start();
+}
+
+void CommandClient::flush()
+{
+    if (!isConnected()) {
+        openSocket();
+        return;     // onConnected relancera l'envoi
+    }
+
+    QJsonArray batch;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    while (!m_queue.isEmpty() && m_inFlight.size() < m_inFlightWindow) {
+        const int id = m_queue.takeFirst();
+        const PendingCommand &pending = m_commands[id];
+        if (!pending.mergeKey.isEmpty() && m_queuedByKey.value(pending.mergeKey) == id)
+            m_queuedByKey.remove(pending.mergeKey);
+        // L'id reste dans l'enveloppe : le serveur transmet la commande telle quelle
+        QJsonObject entry;
+        entry.insert(QStringLiteral("id"), id);
+        entry.insert(QStringLiteral("command"), pending.payload);
+        batch.append(entry);
+        m_inFlight.insert(id, now);
+        m_results.updateStatus(id, QStringLiteral("inflight"), QString());
+    }
+
+    if (batch.isEmpty())
+        return;
+
+    QJsonObject message;
+    message.insert(QStringLiteral("type"), QStringLiteral("COMMAND_BATCH"));
+    message.insert(QStringLiteral("batchId"), m_nextBatchId++);
+    message.insert(QStringLiteral("source"), QStringLiteral("SIRENCONSOLE_COMMAND_CLIENT"));
+    message.insert(QStringLiteral("commands"), batch);
+    // JSON en binaire comme le reste des messages console (branche Buffer du serveur)
+    m_socket.sendBinaryMessage(QJsonDocument(message).toJson(QJsonDocument::Compact));
+
+    if (!m_timeoutTimer.isActive())
+        m_timeoutTimer.start();
+    emit queueChanged();
+}
+
+void CommandClient::finish(int id, const QString &status, bool success, const QString &message)
+{
+    const auto it = m_commands.constFind(id);
+    if (it == m_commands.constEnd())
+        return;
+    const PendingCommand pending = it.value();
+    m_commands.erase(it);
+    m_inFlight.remove(id);
+
+    const qint64 latency = QDateTime::currentMSecsSinceEpoch() - pending.submittedAt;
+    m_results.updateStatus(id, status, message, latency);
+    emit commandFinished(id, pending.groupId, pending.pupitreId, pending.command, success, message);
+
+    if (pending.groupId == 0)
+        return;
+    const auto groupIt = m_groups.find(pending.groupId);
+    if (groupIt == m_groups.end())
+        return;
+    Group &group = groupIt.value();
+    ++group.completed;
+    if (success)
+        ++group.successCount;
+    else
+        ++group.errorCount;
+    emit batchProgress(pending.groupId, group.completed, group.total);
+    if (group.completed >= group.total) {
+        const Group done = group;
+        m_groups.erase(groupIt);
+        emit batchFinished(pending.groupId, done.successCount, done.errorCount);
+    }
+}
+
+void CommandClient::checkTimeouts()
+{
+    if (m_inFlight.isEmpty()) {
+        m_timeoutTimer.stop();
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QList<int> expired;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        if (now - it.value() >= m_timeoutMs)
+            expired.append(it.key());
+    }
+    if (expired.isEmpty())
+        return;
+
+    std::sort(expired.begin(), expired.end());
+    for (int id : expired)
+        finish(id, QStringLiteral("error"), false, QStringLiteral("Pas de réponse du serveur"));
+    emit queueChanged();
+    scheduleFlush();
+}
+
+void CommandClient::onConnected()
+{
+    m_reconnectDelay = kMinReconnectDelay;
+    emit connectedChanged();
+    scheduleFlush();
+}
+
+void CommandClient::onDisconnected()
+{
+    emit connectedChanged();
+
+    // Les commandes en vol ont peut-être été exécutées : on ne les rejoue pas
+    QList<int> lost = m_inFlight.keys();
+    std::sort(lost.begin(), lost.end());
+    for (int id : lost)
+        finish(id, QStringLiteral("error"), false, QStringLiteral("Connexion au serveur perdue"));
+    m_timeoutTimer.stop();
+    if (!lost.isEmpty())
+        emit queueChanged();
+
+    if (!m_serverUrl.isValid() || m_serverUrl.isEmpty())
+        return;
+    // Reconnexion avec backoff exponentiel borné ; la file est envoyée à la reconnexion
+    m_reconnectTimer.start(m_reconnectDelay);
+    m_reconnectDelay = qMin(m_reconnectDelay * 2, kMaxReconnectDelay);
+}
+
+void CommandClient::onTextMessageReceived(const QString &message)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    if (doc.isObject())
+        handleMessage(doc.object());
+}
+
+void CommandClient::onBinaryMessageReceived(const QByteArray &message)
+{
+    if (message.isEmpty() || message.at(0) != '{')
+        return;
+    const QJsonDocument doc = QJsonDocument::fromJson(message);
+    if (doc.isObject())
+        handleMessage(doc.object());
+}
+
+void CommandClient::openSocket()
+{
+    if (!m_serverUrl.isValid() || m_serverUrl.isEmpty())
+        return;
+    if (m_socket.state() != QAbstractSocket::UnconnectedState)
+        return;
+    m_socket.open(m_serverUrl);
+}
+
+void CommandClient::handleMessage(const QJsonObject &message)
+{
+    if (message.value(QStringLiteral("type")).toString() != QLatin1String("COMMAND_RESULTS"))
+        return;
+
+    const QJsonArray results = message.value(QStringLiteral("results")).toArray();
+    for (const QJsonValue &value : results) {
+        const QJsonObject result = value.toObject();
+        const int id = result.value(QStringLiteral("id")).toInt();
+        if (!m_inFlight.contains(id))
+            continue;   // déjà expirée
+        const bool success = result.value(QStringLiteral("success")).toBool();
+        finish(id, success ? QStringLiteral("ok") : QStringLiteral("error"), success,
+               result.value(QStringLiteral("message")).toString());
+    }
+    emit queueChanged();
+    scheduleFlush();
+}
+
+QJsonObject CommandClient::buildPayload(const QString &pupitreId, const QString &command, const QVariantMap &parameters)
+{
+    // Même traduction que CommandManager.executeCommand (QML)
+    QJsonObject payload;
+    payload.insert(QStringLiteral("pupitreId"), pupitreId);
+    if (command == QLatin1String("set_ui_controls_enabled")) {
+        payload.insert(QStringLiteral("type"), QStringLiteral("UI_CONTROLS"));
+        payload.insert(QStringLiteral("enabled"), parameters.value(QStringLiteral("enabled"), true).toBool());
+    } else if (command == QLatin1String("autonomy_mode")) {
+        payload.insert(QStringLiteral("type"), QStringLiteral("AUTONOMY_MODE"));
+        payload.insert(QStringLiteral("device"), parameters.value(QStringLiteral("device")).toString());
+        payload.insert(QStringLiteral("enabled"), parameters.value(QStringLiteral("enabled")).toBool());
+    } else {
+        payload.insert(QStringLiteral("type"), command.toUpper());
+        payload.insert(QStringLiteral("parameters"), QJsonObject::fromVariantMap(parameters));
+    }
+    return payload;
+}
+
+QString CommandClient::mergeKey(const QString &pupitreId, const QString &command, const QVariantMap &parameters)
+{
+    // enable_X / disable_X visent le même réglage
+    QString setting = command;
+    if (setting.startsWith(QLatin1String("enable_")))
+        setting = setting.mid(7);
+    else if (setting.startsWith(QLatin1String("disable_")))
+        setting = setting.mid(8);
+
+    // Cible à l'intérieur du pupitre : sirène, périphérique, contrôleur ou canal
+    static const char *const targetKeys[] = { "sirene", "device", "controller", "controllerType", "channel" };
+    QString target;
+    for (const char *key : targetKeys) {
+        const QString name = QLatin1String(key);
+        if (parameters.contains(name)) {
+            target = name + QLatin1Char('=') + parameters.value(name).toString();
+            break;
+        }
+    }
+    return pupitreId + QLatin1Char('|') + setting + QLatin1Char('|') + target;
+}
@@ -0,0 +1,126 @@
+#ifndef COMMANDCLIENT_H
+#define COMMANDCLIENT_H
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QTimer>
+#include <QUrl>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QWebSocket>
+#include "Models/CommandResultModel.h"
+
+// Exécuteur de commandes console → pupitres.
+// Les commandes passent par une seule connexion WebSocket persistante vers le
+// serveur Node (au lieu d'une requête HTTP par commande). Celles soumises pendant
+// un même tour de boucle d'événements partent dans un seul message COMMAND_BATCH,
+// dans la limite de inFlightWindow commandes sans réponse. Le serveur exécute un
+// lot dans l'ordre, ce qui préserve l'ordre par pupitre. Une commande encore en
+// file remplacée par une commande plus récente sur la même cible (même pupitre,
+// même réglage, même sirène) n'est pas envoyée : elle passe au statut "merged".
+// La fusion n'a lieu que si aucune autre commande du pupitre n'a été soumise entre
+// les deux, l'ordre de soumission est donc conservé.
+class CommandClient : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QUrl serverUrl READ serverUrl WRITE setServerUrl NOTIFY serverUrlChanged)
+    Q_PROPERTY(bool connected READ isConnected NOTIFY connectedChanged)
+    Q_PROPERTY(int inFlightWindow READ inFlightWindow WRITE setInFlightWindow NOTIFY inFlightWindowChanged)
+    Q_PROPERTY(int inFlight READ inFlight NOTIFY queueChanged)
+    Q_PROPERTY(int queued READ queued NOTIFY queueChanged)
+    Q_PROPERTY(int timeoutMs READ timeoutMs WRITE setTimeoutMs NOTIFY timeoutMsChanged)
+    Q_PROPERTY(CommandResultModel *results READ results CONSTANT)
+
+public:
+    explicit CommandClient(QObject *parent = nullptr);
+
+    QUrl serverUrl() const { return m_serverUrl; }
+    void setServerUrl(const QUrl &url);
+    bool isConnected() const { return m_socket.state() == QAbstractSocket::ConnectedState; }
+    int inFlightWindow() const { return m_inFlightWindow; }
+    void setInFlightWindow(int window);
+    int inFlight() const { return m_inFlight.size(); }
+    int queued() const { return m_queue.size(); }
+    int timeoutMs() const { return m_timeoutMs; }
+    void setTimeoutMs(int timeoutMs);
+    CommandResultModel *results() { return &m_results; }
+
+    // Une commande au format CommandManager ("enable_sirene", { sirene: 3 }) ; retourne son id
+    Q_INVOKABLE int submit(const QString &pupitreId, const QString &command, const QVariantMap &parameters = QVariantMap());
+    // [{ pupitreId, command, parameters }, ...] ; retourne l'id du lot (batchProgress / batchFinished)
+    Q_INVOKABLE int submitBatch(const QVariantList &commands);
+    // Id que recevra le prochain submitBatch : permet de filtrer les signaux émis
+    // pendant la soumission (commandes fusionnées dans le même lot)
+    Q_INVOKABLE int nextGroupId() const { return m_nextGroupId; }
+
+signals:
+    void serverUrlChanged();
+    void connectedChanged();
+    void inFlightWindowChanged();
+    void timeoutMsChanged();
+    void queueChanged();
+    // groupId vaut 0 pour une commande soumise seule (submit)
+    void commandFinished(int id, int groupId, const QString &pupitreId, const QString &command, bool success, const QString &message);
+    void batchProgress(int groupId, int completed, int total);
+    void batchFinished(int groupId, int successCount, int errorCount);
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onTextMessageReceived(const QString &message);
+    void onBinaryMessageReceived(const QByteArray &message);
+    void openSocket();
+    void flush();
+    void checkTimeouts();
+
+private:
+    struct PendingCommand {
+        int id = 0;
+        int groupId = 0;
+        QString pupitreId;
+        QString command;
+        QString mergeKey;
+        QJsonObject payload;
+        qint64 submittedAt = 0;
+    };
+
+    struct Group {
+        int total = 0;
+        int completed = 0;
+        int successCount = 0;
+        int errorCount = 0;
+    };
+
+    int enqueue(int groupId, const QString &pupitreId, const QString &command, const QVariantMap &parameters);
+    void scheduleFlush();
+    bool canMerge(int supersededId, const QString &pupitreId) const;
+    void finish(int id, const QString &status, bool success, const QString &message);
+    void handleMessage(const QJsonObject &message);
+
+    static QJsonObject buildPayload(const QString &pupitreId, const QString &command, const QVariantMap &parameters);
+    static QString mergeKey(const QString &pupitreId, const QString &command, const QVariantMap &parameters);
+
+    QUrl m_serverUrl;
+    QWebSocket m_socket;
+    QTimer m_reconnectTimer;
+    QTimer m_flushTimer;
+    QTimer m_timeoutTimer;
+    int m_reconnectDelay;
+    int m_inFlightWindow;
+    int m_timeoutMs;
+    int m_nextId;
+    int m_nextGroupId;
+    int m_nextBatchId;
+
+    QList<int> m_queue;                     // ids en attente d'envoi, dans l'ordre de soumission
+    QHash<int, PendingCommand> m_commands;  // commandes en file ou en vol
+    QHash<int, qint64> m_inFlight;          // id → instant d'envoi
+    QHash<QString, int> m_queuedByKey;      // clé de fusion → id encore en file
+    QHash<int, Group> m_groups;
+
+    CommandResultModel m_results;
+};
+
+#endif // COMMANDCLIENT_H
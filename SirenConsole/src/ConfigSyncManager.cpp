@@ -0,0 +1,308 @@
+#include "ConfigSyncManager.h"
+#include <QCborArray>
+
+ConfigSyncManager::ConfigSyncManager(QObject *parent)
+    : QObject(parent)
+    , m_bytesSent(0)
+{
+    // Un seul patch par pupitre et par tour de boucle (ex. preset appliqué à 7 pupitres)
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(0);
+    connect(&m_flushTimer, &QTimer::timeout, this, &ConfigSyncManager::flushPending);
+    m_ackTimer.setInterval(500);
+    connect(&m_ackTimer, &QTimer::timeout, this, &ConfigSyncManager::checkAcks);
+    m_clock.start();
+}
+
+QVariantMap ConfigSyncManager::syncStatus() const
+{
+    QVariantMap status;
+    for (auto it = m_pupitres.constBegin(); it != m_pupitres.constEnd(); ++it) {
+        QVariantMap entry;
+        entry.insert(QStringLiteral("version"), int(it->version));
+        entry.insert(QStringLiteral("ackedVersion"), int(it->ackedVersion));
+        entry.insert(QStringLiteral("pending"), int(it->pending.size()));
+        entry.insert(QStringLiteral("synced"), it->ackedVersion == it->version && it->pending.isEmpty());
+        status.insert(it.key(), entry);
+    }
+    return status;
+}
+
+void ConfigSyncManager::pushConfig(const QString &pupitreId, const QVariantMap &config)
+{
+    if (ConfigSync::pupitreIndex(pupitreId) == 0)
+        return;
+
+    PupitreState &state = stateFor(pupitreId);
+    QCborMap target = QCborMap::fromVariantMap(config);
+    // Première config complète : les valeurs déjà poussées une à une restent par-dessus
+    if (!state.hasConfig) {
+        for (const ConfigSync::PatchOp &op : ConfigSync::leafOps(QCborValue(state.config)))
+            ConfigSync::applyOp(target, op, true);
+    }
+
+    if (!state.snapshotSent) {
+        state.config = target;
+        state.hasConfig = true;
+        state.pending.clear();
+        sendSnapshot(pupitreId, state);
+        return;
+    }
+
+    // Diff contre ce qui a réellement été envoyé : une op en attente égale à la cible
+    // doit partir quand même, le pupitre a encore l'ancienne valeur
+    state.pending.clear();
+    const QVector<ConfigSync::PatchOp> ops = ConfigSync::diff(QCborValue(state.sent), QCborValue(target));
+    state.config = target;
+    state.hasConfig = true;
+    if (ops.isEmpty()) {
+        emit syncStatusChanged();
+        return;
+    }
+    state.pending = ops;
+    state.queuedAtMs = m_clock.elapsed();
+    m_flushTimer.start();
+    emit syncStatusChanged();
+}
+
+void ConfigSyncManager::setValue(const QString &pupitreId, const QVariantList &path, const QVariant &value)
+{
+    if (ConfigSync::pupitreIndex(pupitreId) == 0 || path.isEmpty())
+        return;
+    queueOp(pupitreId, { ConfigSync::pathFromVariantList(path), QCborValue::fromVariant(value), false });
+}
+
+void ConfigSyncManager::setValueForAll(const QVariantList &path, const QVariant &value)
+{
+    for (auto it = m_pupitres.constBegin(); it != m_pupitres.constEnd(); ++it)
+        setValue(it.key(), path, value);
+}
+
+void ConfigSyncManager::resync(const QString &pupitreId)
+{
+    auto it = m_pupitres.find(pupitreId);
+    if (it == m_pupitres.end())
+        return;
+    if (!it->hasConfig) {
+        emit resyncRequired(pupitreId);
+        return;
+    }
+    it->pending.clear();
+    sendSnapshot(pupitreId, *it);
+}
+
+void ConfigSyncManager::forget(const QString &pupitreId)
+{
+    if (m_pupitres.remove(pupitreId))
+        emit syncStatusChanged();
+}
+
+int ConfigSyncManager::version(const QString &pupitreId) const
+{
+    return int(m_pupitres.value(pupitreId).version);
+}
+
+int ConfigSyncManager::ackedVersion(const QString &pupitreId) const
+{
+    return int(m_pupitres.value(pupitreId).ackedVersion);
+}
+
+bool ConfigSyncManager::hasAck(const QString &pupitreId) const
+{
+    return m_pupitres.value(pupitreId).everAcked;
+}
+
+bool ConfigSyncManager::isSynced(const QString &pupitreId) const
+{
+    auto it = m_pupitres.constFind(pupitreId);
+    return it != m_pupitres.constEnd() && it->ackedVersion == it->version && it->pending.isEmpty();
+}
+
+QVariant ConfigSyncManager::valueAt(const QString &pupitreId, const QVariantList &path) const
+{
+    auto it = m_pupitres.constFind(pupitreId);
+    if (it == m_pupitres.constEnd())
+        return QVariant();
+    return ConfigSync::valueAt(QCborValue(it->config), ConfigSync::pathFromVariantList(path)).toVariant();
+}
+
+bool ConfigSyncManager::handleFrame(const QByteArray &data)
+{
+    if (!ConfigSync::isConfigFrame(data))
+        return false;
+
+    ConfigSync::Frame frame;
+    if (!ConfigSync::decode(data, &frame) || frame.pupitre == 0)
+        return true;
+
+    const QString pupitreId = ConfigSync::pupitreName(frame.pupitre);
+    auto it = m_pupitres.find(pupitreId);
+    if (it == m_pupitres.end())
+        return true;
+
+    switch (frame.kind) {
+    case ConfigSync::FrameKind::Ack:
+        // Les acks peuvent arriver dans le désordre : on ne recule jamais
+        if (frame.version > it->ackedVersion && frame.version <= it->version) {
+            it->ackedVersion = frame.version;
+            it->everAcked = true;
+            // Progrès : le délai repart de cet ack pour les trames suivantes
+            it->awaitingAckSinceMs = it->ackedVersion == it->version ? -1 : m_clock.elapsed();
+            // Un ack couvre aussi les patchs antérieurs dont l'ack s'est perdu ou croisé
+            const qint64 now = m_clock.elapsed();
+            QVector<InFlightPatch> acked;
+            for (qsizetype i = it->inFlight.size() - 1; i >= 0; --i) {
+                if (it->inFlight.at(i).version <= frame.version)
+                    acked.prepend(it->inFlight.takeAt(i));
+            }
+            for (const InFlightPatch &patch : std::as_const(acked))
+                emit patchApplied(pupitreId, int(patch.version), patch.operations, double(now - patch.queuedAtMs));
+            emit syncStatusChanged();
+            if (it->ackedVersion == it->version)
+                emit pupitreSynced(pupitreId, int(it->version));
+        }
+        break;
+
+    case ConfigSync::FrameKind::ResyncRequest:
+        if (it->hasConfig) {
+            it->pending.clear();
+            sendSnapshot(pupitreId, *it);
+        } else {
+            // Seules quelques valeurs ont été poussées : on les rejoue depuis la version du pupitre
+            replayOverlay(pupitreId, *it, frame.version);
+            emit resyncRequired(pupitreId);
+        }
+        break;
+
+    case ConfigSync::FrameKind::Snapshot:
+    case ConfigSync::FrameKind::Patch:
+        // Émises par la console elle-même (écho éventuel du serveur)
+        break;
+    }
+    return true;
+}
+
+void ConfigSyncManager::flushPending()
+{
+    for (auto it = m_pupitres.begin(); it != m_pupitres.end(); ++it) {
+        PupitreState &state = it.value();
+        if (state.pending.isEmpty())
+            continue;
+
+        if (!state.snapshotSent && state.hasConfig) {
+            sendSnapshot(it.key(), state);
+            continue;
+        }
+
+        const quint32 base = state.version;
+        ++state.version;
+        const QByteArray frame = ConfigSync::encodePatch(ConfigSync::pupitreIndex(it.key()), base, state.version, state.pending);
+        state.inFlight.append({ state.version, state.queuedAtMs, int(state.pending.size()) });
+        state.pending.clear();
+        state.sent = state.config;
+        send(it.key(), state, frame);
+    }
+    emit syncStatusChanged();
+}
+
+void ConfigSyncManager::checkAcks()
+{
+    const qint64 now = m_clock.elapsed();
+    bool waiting = false;
+    for (auto it = m_pupitres.begin(); it != m_pupitres.end(); ++it) {
+        PupitreState &state = it.value();
+        if (state.awaitingAckSinceMs < 0)
+            continue;
+        if (now - state.awaitingAckSinceMs < AckTimeoutMs) {
+            waiting = true;
+            continue;
+        }
+        state.awaitingAckSinceMs = -1;
+        emit ackTimedOut(it.key());
+        // Jamais acquitté : pas de resync en boucle vers un pupitre qui ne répond pas en MCFG
+        if (!state.everAcked) {
+            state.inFlight.clear();
+            continue;
+        }
+        // Ack perdu ou trame perdue : on repart d'un état complet
+        if (state.hasConfig) {
+            state.pending.clear();
+            sendSnapshot(it.key(), state);
+        } else {
+            replayOverlay(it.key(), state, state.ackedVersion);
+            emit resyncRequired(it.key());
+        }
+        waiting = waiting || state.awaitingAckSinceMs >= 0;
+    }
+    if (!waiting)
+        m_ackTimer.stop();
+}
+
+ConfigSyncManager::PupitreState &ConfigSyncManager::stateFor(const QString &pupitreId)
+{
+    return m_pupitres[pupitreId];
+}
+
+void ConfigSyncManager::queueOp(const QString &pupitreId, const ConfigSync::PatchOp &op)
+{
+    PupitreState &state = stateFor(pupitreId);
+
+    // Valeur inchangée : aucun octet à envoyer
+    if (!op.remove && ConfigSync::valueAt(QCborValue(state.config), op.path) == op.value)
+        return;
+    // État partiel : un index de sirène isolé complète le tableau localement
+    if (!ConfigSync::applyOp(state.config, op, true))
+        return;
+
+    if (state.pending.isEmpty())
+        state.queuedAtMs = m_clock.elapsed();
+
+    // Une écriture plus récente sur le même chemin remplace la précédente
+    for (int i = 0; i < state.pending.size(); ++i) {
+        if (state.pending.at(i).path == op.path) {
+            state.pending.removeAt(i);
+            break;
+        }
+    }
+    state.pending.append(op);
+    m_flushTimer.start();
+}
+
+void ConfigSyncManager::replayOverlay(const QString &pupitreId, PupitreState &state, quint32 pupitreVersion)
+{
+    state.pending.clear();
+    state.inFlight.clear();
+    state.version = pupitreVersion;
+    state.ackedVersion = qMin(state.ackedVersion, pupitreVersion);
+    // Feuille par feuille : l'état partiel ne doit pas remplacer des sous-arbres du pupitre
+    const QVector<ConfigSync::PatchOp> ops = ConfigSync::leafOps(QCborValue(state.config));
+    if (ops.isEmpty()) {
+        emit syncStatusChanged();
+        return;
+    }
+    ++state.version;
+    state.sent = state.config;
+    send(pupitreId, state, ConfigSync::encodePatch(ConfigSync::pupitreIndex(pupitreId), pupitreVersion, state.version, ops));
+    emit syncStatusChanged();
+}
+
+void ConfigSyncManager::sendSnapshot(const QString &pupitreId, PupitreState &state)
+{
+    ++state.version;
+    state.snapshotSent = true;
+    state.sent = state.config;
+    // Les patchs non acquittés sont remplacés par le snapshot
+    state.inFlight.clear();
+    send(pupitreId, state, ConfigSync::encodeSnapshot(ConfigSync::pupitreIndex(pupitreId), state.version, state.config));
+    emit syncStatusChanged();
+}
+
+void ConfigSyncManager::send(const QString &pupitreId, PupitreState &state, const QByteArray &frame)
+{
+    if (state.awaitingAckSinceMs < 0)
+        state.awaitingAckSinceMs = m_clock.elapsed();
+    if (!m_ackTimer.isActive())
+        m_ackTimer.start();
+    m_bytesSent += frame.size();
+    emit frameReady(pupitreId, frame);
+}
@@ -0,0 +1,109 @@
+#ifndef CONFIGSYNCMANAGER_H
+#define CONFIGSYNCMANAGER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QCborMap>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include "ConfigDelta.h"
+
+// Côté console de la synchronisation de configuration (trames "MCFG").
+// Garde pour chaque pupitre la config que la console lui a poussée, la version
+// courante et la dernière version acquittée. Les modifications faites pendant un
+// même tour de boucle d'événements sont regroupées en un seul patch par pupitre ;
+// un pupitre qui signale un décalage de version reçoit un snapshot complet.
+// Chaque patch acquitté est rapporté avec sa latence (première modification → ack).
+// Sans ack au bout de AckTimeoutMs, un pupitre qui a déjà acquitté est resynchronisé ;
+// un pupitre qui n'a jamais acquitté ne parle sans doute pas MCFG (ackTimedOut).
+class ConfigSyncManager : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QVariantMap syncStatus READ syncStatus NOTIFY syncStatusChanged)
+    Q_PROPERTY(int bytesSent READ bytesSent NOTIFY syncStatusChanged)
+
+public:
+    static constexpr qint64 AckTimeoutMs = 3000;
+
+    explicit ConfigSyncManager(QObject *parent = nullptr);
+
+    // { "P1": { version, ackedVersion, pending, synced }, ... }
+    QVariantMap syncStatus() const;
+    int bytesSent() const { return int(m_bytesSent); }
+
+    // Config complète connue pour un pupitre : diff avec la dernière config poussée
+    // (ou snapshot si le pupitre n'en a jamais reçu)
+    Q_INVOKABLE void pushConfig(const QString &pupitreId, const QVariantMap &config);
+    // Modification d'une seule valeur, ex. ["controllerMapping", "joystickX", "cc"]
+    Q_INVOKABLE void setValue(const QString &pupitreId, const QVariantList &path, const QVariant &value);
+    Q_INVOKABLE void setValueForAll(const QVariantList &path, const QVariant &value);
+    // Forcer un snapshot complet
+    Q_INVOKABLE void resync(const QString &pupitreId);
+    Q_INVOKABLE void forget(const QString &pupitreId);
+
+    Q_INVOKABLE int version(const QString &pupitreId) const;
+    Q_INVOKABLE int ackedVersion(const QString &pupitreId) const;
+    Q_INVOKABLE bool isSynced(const QString &pupitreId) const;
+    // Au moins un ack MCFG reçu de ce pupitre : la sync incrémentale lui parvient
+    Q_INVOKABLE bool hasAck(const QString &pupitreId) const;
+    Q_INVOKABLE QVariant valueAt(const QString &pupitreId, const QVariantList &path) const;
+
+    // Trame reçue d'un pupitre (ack / demande de resync) ; false si ce n'est pas une trame MCFG
+    Q_INVOKABLE bool handleFrame(const QByteArray &data);
+
+signals:
+    void syncStatusChanged();
+    // Trame à envoyer au pupitre (via le serveur Node qui relaie sur l'octet pupitre)
+    void frameReady(const QString &pupitreId, const QByteArray &frame);
+    void pupitreSynced(const QString &pupitreId, int version);
+    // Patch acquitté : nombre d'opérations et latence depuis la première modification regroupée
+    void patchApplied(const QString &pupitreId, int version, int operations, double latencyMs);
+    // Resync demandé alors que la console ne connaît pas la config complète du pupitre :
+    // seules les valeurs déjà poussées ont été rejouées, pushConfig() permet un vrai snapshot
+    void resyncRequired(const QString &pupitreId);
+    // Trame restée sans ack AckTimeoutMs (jamais acquitté : pupitre sans MCFG ou relais absent)
+    void ackTimedOut(const QString &pupitreId);
+
+private slots:
+    void flushPending();
+    void checkAcks();
+
+private:
+    struct InFlightPatch {
+        quint32 version = 0;
+        qint64 queuedAtMs = 0;
+        int operations = 0;
+    };
+
+    struct PupitreState {
+        QCborMap config;            // dernière valeur voulue, ops en attente comprises
+        QCborMap sent;              // config telle que le pupitre l'aura après les trames déjà envoyées
+        quint32 version = 0;
+        quint32 ackedVersion = 0;
+        bool hasConfig = false;     // config complète connue (pushConfig), sinon simple surcouche de valeurs
+        bool snapshotSent = false;
+        bool everAcked = false;
+        qint64 awaitingAckSinceMs = -1;         // plus ancienne trame non acquittée, -1 : aucune
+        QVector<ConfigSync::PatchOp> pending;
+        qint64 queuedAtMs = 0;                  // première op de pending
+        QVector<InFlightPatch> inFlight;        // patchs envoyés, en attente d'ack
+    };
+
+    PupitreState &stateFor(const QString &pupitreId);
+    void queueOp(const QString &pupitreId, const ConfigSync::PatchOp &op);
+    void sendSnapshot(const QString &pupitreId, PupitreState &state);
+    void replayOverlay(const QString &pupitreId, PupitreState &state, quint32 pupitreVersion);
+    void send(const QString &pupitreId, PupitreState &state, const QByteArray &frame);
+
+    QHash<QString, PupitreState> m_pupitres;
+    QTimer m_flushTimer;
+    QTimer m_ackTimer;
+    QElapsedTimer m_clock;
+    qint64 m_bytesSent;
+};
+
+#endif // CONFIGSYNCMANAGER_H
@@ -0,0 +1,157 @@
+#include "CommandResultModel.h"
+
+CommandResultModel::CommandResultModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_firstId(0)
+    , m_maxEntries(500)
+{
+}
+
+int CommandResultModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return m_entries.size();
+}
+
+QVariant CommandResultModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_entries.size()) {
+        return QVariant();
+    }
+
+    const CommandResult &entry = m_entries[index.row()];
+
+    switch (role) {
+        case IdRole:
+            return entry.id;
+        case BatchIdRole:
+            return entry.batchId;
+        case PupitreIdRole:
+            return entry.pupitreId;
+        case CommandRole:
+            return entry.command;
+        case StatusRole:
+            return entry.status;
+        case MessageRole:
+            return entry.message;
+        case LatencyRole:
+            return entry.latencyMs;
+        default:
+            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> CommandResultModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[IdRole] = "commandId";
+    roles[BatchIdRole] = "batchId";
+    roles[PupitreIdRole] = "pupitreId";
+    roles[CommandRole] = "command";
+    roles[StatusRole] = "status";
+    roles[MessageRole] = "message";
+    roles[LatencyRole] = "latencyMs";
+    return roles;
+}
+
+void CommandResultModel::setMaxEntries(int maxEntries)
+{
+    maxEntries = qMax(1, maxEntries);
+    if (m_maxEntries == maxEntries)
+        return;
+    m_maxEntries = maxEntries;
+    emit maxEntriesChanged();
+    trim();
+}
+
+void CommandResultModel::addEntry(const CommandResult &entry)
+{
+    if (m_entries.isEmpty())
+        m_firstId = entry.id;
+    beginInsertRows(QModelIndex(), m_entries.size(), m_entries.size());
+    m_entries.append(entry);
+    endInsertRows();
+    emit countChanged();
+    trim();
+}
+
+void CommandResultModel::updateStatus(int id, const QString &status, const QString &message, qint64 latencyMs)
+{
+    const int row = rowOf(id);
+    if (row < 0)
+        return;
+
+    CommandResult &entry = m_entries[row];
+    QList<int> roles;
+    if (entry.status != status) {
+        entry.status = status;
+        roles.append(StatusRole);
+    }
+    if (entry.message != message) {
+        entry.message = message;
+        roles.append(MessageRole);
+    }
+    if (latencyMs >= 0 && entry.latencyMs != latencyMs) {
+        entry.latencyMs = latencyMs;
+        roles.append(LatencyRole);
+    }
+    if (!roles.isEmpty())
+        emit dataChanged(index(row), index(row), roles);
+}
+
+const CommandResult *CommandResultModel::entry(int id) const
+{
+    const int row = rowOf(id);
+    return row < 0 ? nullptr : &m_entries[row];
+}
+
+QVariantMap CommandResultModel::get(int row) const
+{
+    QVariantMap map;
+    if (row < 0 || row >= m_entries.size())
+        return map;
+    const QHash<int, QByteArray> roles = roleNames();
+    for (auto it = roles.constBegin(); it != roles.constEnd(); ++it)
+        map.insert(QString::fromLatin1(it.value()), data(index(row), it.key()));
+    return map;
+}
+
+void CommandResultModel::clear()
+{
+    beginResetModel();
+    m_entries.clear();
+    endResetModel();
+    emit countChanged();
+}
+
+int CommandResultModel::rowOf(int id) const
+{
+    const int row = id - m_firstId;
+    if (row >= 0 && row < m_entries.size() && m_entries[row].id == id)
+        return row;
+    // Ids non contigus (après clear) : recherche linéaire
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].id == id)
+            return i;
+    }
+    return -1;
+}
+
+void CommandResultModel::trim()
+{
+    // Ne retirer que des lignes terminées en tête de liste
+    int removable = 0;
+    while (m_entries.size() - removable > m_maxEntries && removable < m_entries.size()) {
+        const QString &status = m_entries[removable].status;
+        if (status == QLatin1String("queued") || status == QLatin1String("inflight"))
+            break;
+        ++removable;
+    }
+    if (removable == 0)
+        return;
+    beginRemoveRows(QModelIndex(), 0, removable - 1);
+    m_entries.erase(m_entries.begin(), m_entries.begin() + removable);
+    endRemoveRows();
+    m_firstId = m_entries.isEmpty() ? 0 : m_entries.first().id;
+    emit countChanged();
+}
@@ -0,0 +1,69 @@
+#ifndef COMMANDRESULTMODEL_H
+#define COMMANDRESULTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+struct CommandResult {
+    int id;
+    int batchId;
+    QString pupitreId;
+    QString command;
+    QString status;     // queued, inflight, ok, error, merged
+    QString message;
+    qint64 submittedAt;
+    qint64 latencyMs;
+};
+
+// Résultats des commandes envoyées par CommandClient, une ligne par commande.
+// Les lignes terminées les plus anciennes sont supprimées au-delà de maxEntries.
+class CommandResultModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int maxEntries READ maxEntries WRITE setMaxEntries NOTIFY maxEntriesChanged)
+
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        BatchIdRole,
+        PupitreIdRole,
+        CommandRole,
+        StatusRole,
+        MessageRole,
+        LatencyRole
+    };
+
+    explicit CommandResultModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_entries.size(); }
+    int maxEntries() const { return m_maxEntries; }
+    void setMaxEntries(int maxEntries);
+
+    void addEntry(const CommandResult &entry);
+    void updateStatus(int id, const QString &status, const QString &message, qint64 latencyMs = -1);
+    const CommandResult *entry(int id) const;
+
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE void clear();
+
+signals:
+    void countChanged();
+    void maxEntriesChanged();
+
+private:
+    int rowOf(int id) const;
+    void trim();
+
+    QList<CommandResult> m_entries;
+    int m_firstId;      // id de la première ligne (les ids sont croissants et contigus)
+    int m_maxEntries;
+};
+
+#endif // COMMANDRESULTMODEL_H
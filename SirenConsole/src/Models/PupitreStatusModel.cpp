@@ -0,0 +1,352 @@
+#include "PupitreStatusModel.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace {
+constexpr int kMinReconnectDelay = 500;
+constexpr int kMaxReconnectDelay = 10000;
+constexpr int kKeepAliveInterval = 15000;
+}
+
+PupitreStatusModel::PupitreStatusModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_connectedCount(0)
+    , m_clockSkewMs(0.0)
+    , m_reconnectDelay(kMinReconnectDelay)
+{
+    m_rows.resize(PupitreCount);
+    for (int i = 0; i < PupitreCount; ++i) {
+        QVector<QVariant> &row = m_rows[i];
+        row.resize(RoleEnd - PupitreIdRole);
+        row[PupitreIdRole - PupitreIdRole] = QStringLiteral("P%1").arg(i + 1);
+        row[NameRole - PupitreIdRole] = QStringLiteral("Pupitre %1").arg(i + 1);
+        row[HostRole - PupitreIdRole] = QString();
+        row[StatusRole - PupitreIdRole] = QStringLiteral("disconnected");
+        row[ConnectedRole - PupitreIdRole] = false;
+        row[SyncedRole - PupitreIdRole] = false;
+        row[CurrentNoteRole - PupitreIdRole] = 60.0;
+        row[CurrentHzRole - PupitreIdRole] = 440.0;
+        row[CurrentRpmRole - PupitreIdRole] = 0.0;
+        row[VelocityRole - PupitreIdRole] = 0;
+        row[AmbitusMinRole - PupitreIdRole] = 48;
+        row[AmbitusMaxRole - PupitreIdRole] = 72;
+        row[LastUpdateRole - PupitreIdRole] = qint64(0);
+        row[ClockSyncedRole - PupitreIdRole] = false;
+        row[ClockOffsetRole - PupitreIdRole] = 0.0;
+        row[ClockRttRole - PupitreIdRole] = 0.0;
+        row[ClockJitterRole - PupitreIdRole] = 0.0;
+    }
+
+    // Noms de champs des messages serveur → rôles
+    m_roleForField.insert(QStringLiteral("pupitreName"), NameRole);
+    m_roleForField.insert(QStringLiteral("name"), NameRole);
+    m_roleForField.insert(QStringLiteral("host"), HostRole);
+    m_roleForField.insert(QStringLiteral("status"), StatusRole);
+    m_roleForField.insert(QStringLiteral("connected"), ConnectedRole);
+    m_roleForField.insert(QStringLiteral("isSynced"), SyncedRole);
+    m_roleForField.insert(QStringLiteral("noteFloat"), CurrentNoteRole);
+    m_roleForField.insert(QStringLiteral("currentNote"), CurrentNoteRole);
+    m_roleForField.insert(QStringLiteral("frequency"), CurrentHzRole);
+    m_roleForField.insert(QStringLiteral("currentHz"), CurrentHzRole);
+    m_roleForField.insert(QStringLiteral("rpm"), CurrentRpmRole);
+    m_roleForField.insert(QStringLiteral("currentRpm"), CurrentRpmRole);
+    m_roleForField.insert(QStringLiteral("velocity"), VelocityRole);
+    m_roleForField.insert(QStringLiteral("ambitusMin"), AmbitusMinRole);
+    m_roleForField.insert(QStringLiteral("ambitusMax"), AmbitusMaxRole);
+    m_roleForField.insert(QStringLiteral("clockSynced"), ClockSyncedRole);
+    m_roleForField.insert(QStringLiteral("clockOffsetMs"), ClockOffsetRole);
+    m_roleForField.insert(QStringLiteral("clockRttMs"), ClockRttRole);
+    m_roleForField.insert(QStringLiteral("clockJitterMs"), ClockJitterRole);
+
+    connect(&m_socket, &QWebSocket::connected, this, &PupitreStatusModel::onConnected);
+    connect(&m_socket, &QWebSocket::disconnected, this, &PupitreStatusModel::onDisconnected);
+    connect(&m_socket, &QWebSocket::textMessageReceived, this, &PupitreStatusModel::onTextMessageReceived);
+    connect(&m_socket, &QWebSocket::binaryMessageReceived, this, &PupitreStatusModel::onBinaryMessageReceived);
+
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &PupitreStatusModel::openSocket);
+
+    // Ping WebSocket natif (pas de message applicatif) pour garder la connexion ouverte
+    m_keepAliveTimer.setInterval(kKeepAliveInterval);
+    connect(&m_keepAliveTimer, &QTimer::timeout, this, [this]() { m_socket.ping(); });
+}
+
+int PupitreStatusModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_rows.size();
+}
+
+QVariant PupitreStatusModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size() || role < PupitreIdRole || role >= RoleEnd) {
+        return QVariant();
+    }
+    return m_rows[index.row()][role - PupitreIdRole];
+}
+
+QHash<int, QByteArray> PupitreStatusModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[PupitreIdRole] = "pupitreId";
+    roles[NameRole] = "pupitreName";
+    roles[HostRole] = "pupitreHost";
+    roles[StatusRole] = "pupitreStatus";
+    roles[ConnectedRole] = "pupitreConnected";
+    roles[SyncedRole] = "pupitreSynced";
+    roles[CurrentNoteRole] = "currentNote";
+    roles[CurrentHzRole] = "currentHz";
+    roles[CurrentRpmRole] = "currentRpm";
+    roles[VelocityRole] = "velocity";
+    roles[AmbitusMinRole] = "ambitusMin";
+    roles[AmbitusMaxRole] = "ambitusMax";
+    roles[LastUpdateRole] = "lastUpdate";
+    roles[ClockSyncedRole] = "clockSynced";
+    roles[ClockOffsetRole] = "clockOffsetMs";
+    roles[ClockRttRole] = "clockRttMs";
+    roles[ClockJitterRole] = "clockJitterMs";
+    return roles;
+}
+
+void PupitreStatusModel::setServerUrl(const QUrl &url)
+{
+    if (m_serverUrl == url)
+        return;
+    m_serverUrl = url;
+    emit serverUrlChanged();
+
+    m_reconnectDelay = kMinReconnectDelay;
+    if (m_socket.state() != QAbstractSocket::UnconnectedState)
+        m_socket.close();  // onDisconnected relance sur la nouvelle URL
+    else
+        openSocket();
+}
+
+int PupitreStatusModel::indexOf(const QString &pupitreId) const
+{
+    for (int i = 0; i < m_rows.size(); ++i) {
+        if (m_rows[i][0].toString() == pupitreId)
+            return i;
+    }
+    return -1;
+}
+
+QVariantMap PupitreStatusModel::get(int row) const
+{
+    QVariantMap map;
+    if (row < 0 || row >= m_rows.size())
+        return map;
+    const QHash<int, QByteArray> roles = roleNames();
+    for (auto it = roles.constBegin(); it != roles.constEnd(); ++it)
+        map.insert(QString::fromLatin1(it.value()), m_rows[row][it.key() - PupitreIdRole]);
+    return map;
+}
+
+void PupitreStatusModel::setPupitreInfo(const QString &pupitreId, const QVariantMap &info)
+{
+    const int row = indexOf(pupitreId);
+    if (row < 0)
+        return;
+
+    QVector<int> changed;
+    for (auto it = info.constBegin(); it != info.constEnd(); ++it) {
+        const int role = m_roleForField.value(it.key(), -1);
+        if (role == NameRole || role == HostRole || role == AmbitusMinRole || role == AmbitusMaxRole)
+            setField(row, role, it.value(), changed);
+    }
+    if (!changed.isEmpty())
+        emit dataChanged(index(row), index(row), changed);
+}
+
+void PupitreStatusModel::applyDelta(const QString &pupitreId, const QVariantMap &fields)
+{
+    const int row = indexOf(pupitreId);
+    if (row < 0)
+        return;
+
+    QVector<int> changed;
+    for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
+        const int role = m_roleForField.value(it.key(), -1);
+        if (role < 0)
+            continue;
+        if (role == ConnectedRole) {
+            const bool connected = it.value().toBool();
+            setField(row, ConnectedRole, connected, changed);
+            setField(row, StatusRole, connected ? QStringLiteral("connected") : QStringLiteral("disconnected"), changed);
+        } else if (role == StatusRole) {
+            const QString status = it.value().toString();
+            setField(row, StatusRole, status, changed);
+            setField(row, ConnectedRole, status == QLatin1String("connected"), changed);
+        } else {
+            setField(row, role, it.value(), changed);
+        }
+    }
+    if (changed.isEmpty())
+        return;
+
+    setField(row, LastUpdateRole, QDateTime::currentMSecsSinceEpoch(), changed);
+    emit dataChanged(index(row), index(row), changed);
+
+    if (changed.contains(StatusRole)) {
+        recountConnected();
+        emit pupitreStatusChanged(pupitreId, m_rows[row][StatusRole - PupitreIdRole].toString());
+    }
+    if (changed.contains(ClockSyncedRole) || changed.contains(ClockRttRole)
+        || changed.contains(ClockJitterRole) || changed.contains(StatusRole))
+        updateClockSkew();
+}
+
+void PupitreStatusModel::onConnected()
+{
+    m_reconnectDelay = kMinReconnectDelay;
+    m_keepAliveTimer.start();
+    emit connectedChanged();
+
+    // Même identification que le WebSocketManager QML : le serveur répond par INITIAL_STATUS
+    // puis pousse les changements (PUPITRE_STATUS_DELTA, VOLANT_DATA, ...)
+    QJsonObject identification;
+    identification.insert(QStringLiteral("type"), QStringLiteral("SIRENCONSOLE_IDENTIFICATION"));
+    identification.insert(QStringLiteral("source"), QStringLiteral("SIRENCONSOLE_STATUS_MODEL"));
+    identification.insert(QStringLiteral("timestamp"), QDateTime::currentMSecsSinceEpoch());
+    m_socket.sendBinaryMessage(QJsonDocument(identification).toJson(QJsonDocument::Compact));
+}
+
+void PupitreStatusModel::onDisconnected()
+{
+    m_keepAliveTimer.stop();
+    emit connectedChanged();
+
+    if (!m_serverUrl.isValid() || m_serverUrl.isEmpty())
+        return;
+    // Reconnexion avec backoff exponentiel borné
+    m_reconnectTimer.start(m_reconnectDelay);
+    m_reconnectDelay = qMin(m_reconnectDelay * 2, kMaxReconnectDelay);
+}
+
+void PupitreStatusModel::onTextMessageReceived(const QString &message)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    if (doc.isObject())
+        handleMessage(doc.object());
+}
+
+void PupitreStatusModel::onBinaryMessageReceived(const QByteArray &message)
+{
+    // Seuls les messages JSON nous intéressent (les trames binaires sont pour d'autres clients)
+    if (message.isEmpty() || message.at(0) != '{')
+        return;
+    const QJsonDocument doc = QJsonDocument::fromJson(message);
+    if (doc.isObject())
+        handleMessage(doc.object());
+}
+
+void PupitreStatusModel::openSocket()
+{
+    if (!m_serverUrl.isValid() || m_serverUrl.isEmpty())
+        return;
+    if (m_socket.state() != QAbstractSocket::UnconnectedState)
+        return;
+    m_socket.open(m_serverUrl);
+}
+
+void PupitreStatusModel::handleMessage(const QJsonObject &message)
+{
+    const QString type = message.value(QStringLiteral("type")).toString();
+    const QString pupitreId = message.value(QStringLiteral("pupitreId")).toString();
+
+    if (type == QLatin1String("PUPITRE_STATUS_DELTA")) {
+        applyDelta(pupitreId, message.value(QStringLiteral("fields")).toObject().toVariantMap());
+    } else if (type == QLatin1String("INITIAL_STATUS") || type == QLatin1String("PUPITRE_STATUS_UPDATE")) {
+        applyConnections(message.value(QStringLiteral("data")).toObject());
+    } else if (type == QLatin1String("PUPITRE_CONNECTED") || type == QLatin1String("PUPITRE_DISCONNECTED")) {
+        QVariantMap fields;
+        fields.insert(QStringLiteral("connected"), type == QLatin1String("PUPITRE_CONNECTED"));
+        if (message.contains(QStringLiteral("isSynced")))
+            fields.insert(QStringLiteral("isSynced"), message.value(QStringLiteral("isSynced")).toBool());
+        applyDelta(pupitreId, fields);
+    } else if (type == QLatin1String("SYNC_STATUS_CHANGED")) {
+        QVariantMap fields;
+        fields.insert(QStringLiteral("isSynced"), message.value(QStringLiteral("isSynced")).toBool());
+        applyDelta(pupitreId, fields);
+    } else if (type == QLatin1String("VOLANT_DATA")) {
+        QVariantMap fields;
+        fields.insert(QStringLiteral("noteFloat"), message.value(QStringLiteral("noteFloat")).toDouble());
+        fields.insert(QStringLiteral("frequency"), message.value(QStringLiteral("frequency")).toDouble());
+        fields.insert(QStringLiteral("rpm"), message.value(QStringLiteral("rpm")).toDouble());
+        fields.insert(QStringLiteral("velocity"), message.value(QStringLiteral("velocity")).toInt());
+        applyDelta(pupitreId.isEmpty() ? QStringLiteral("P1") : pupitreId, fields);
+    }
+}
+
+void PupitreStatusModel::applyConnections(const QJsonObject &status)
+{
+    const QJsonArray connections = status.value(QStringLiteral("connections")).toArray();
+    for (const QJsonValue &value : connections) {
+        const QJsonObject connection = value.toObject();
+        QVariantMap fields;
+        fields.insert(QStringLiteral("connected"), connection.value(QStringLiteral("connected")).toBool());
+        if (connection.contains(QStringLiteral("isSynced")))
+            fields.insert(QStringLiteral("isSynced"), connection.value(QStringLiteral("isSynced")).toBool());
+        if (connection.contains(QStringLiteral("pupitreName")))
+            fields.insert(QStringLiteral("pupitreName"), connection.value(QStringLiteral("pupitreName")).toString());
+        for (const QString &key : { QStringLiteral("clockSynced"), QStringLiteral("clockOffsetMs"),
+                                    QStringLiteral("clockRttMs"), QStringLiteral("clockJitterMs") }) {
+            if (connection.contains(key))
+                fields.insert(key, connection.value(key).toVariant());
+        }
+        applyDelta(connection.value(QStringLiteral("pupitreId")).toString(), fields);
+    }
+}
+
+bool PupitreStatusModel::setField(int row, int role, const QVariant &value, QVector<int> &changedRoles)
+{
+    QVariant &field = m_rows[row][role - PupitreIdRole];
+    if (field == value)
+        return false;
+    field = value;
+    if (!changedRoles.contains(role))
+        changedRoles.append(role);
+    return true;
+}
+
+void PupitreStatusModel::recountConnected()
+{
+    int count = 0;
+    for (const QVector<QVariant> &row : m_rows)
+        count += row[ConnectedRole - PupitreIdRole].toBool() ? 1 : 0;
+    if (count == m_connectedCount)
+        return;
+    const bool wasPureDataConnected = isPureDataConnected();
+    m_connectedCount = count;
+    emit connectedCountChanged();
+    if (wasPureDataConnected != isPureDataConnected())
+        emit pureDataConnectedChanged();
+}
+
+void PupitreStatusModel::updateClockSkew()
+{
+    // Erreur possible d'un pupitre : moitié de l'aller-retour (asymétrie) + gigue
+    double largest = 0.0;
+    double second = 0.0;
+    int synced = 0;
+    for (const QVector<QVariant> &row : m_rows) {
+        if (!row[ConnectedRole - PupitreIdRole].toBool() || !row[ClockSyncedRole - PupitreIdRole].toBool())
+            continue;
+        ++synced;
+        const double bound = row[ClockRttRole - PupitreIdRole].toDouble() / 2.0
+                             + row[ClockJitterRole - PupitreIdRole].toDouble();
+        if (bound > largest) {
+            second = largest;
+            largest = bound;
+        } else if (bound > second) {
+            second = bound;
+        }
+    }
+    const double skew = synced >= 2 ? largest + second : 0.0;
+    if (qFuzzyCompare(skew + 1.0, m_clockSkewMs + 1.0))
+        return;
+    m_clockSkewMs = skew;
+    emit clockSkewChanged();
+}
@@ -0,0 +1,109 @@
+#ifndef PUPITRESTATUSMODEL_H
+#define PUPITRESTATUSMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QTimer>
+#include <QUrl>
+#include <QVariantMap>
+#include <QVector>
+#include <QWebSocket>
+
+// Statut agrégé des pupitres P1..P7 pour la vue d'ensemble.
+// Une seule connexion WebSocket persistante vers le serveur Node : le modèle
+// s'identifie, reçoit INITIAL_STATUS puis applique les deltas poussés par le
+// serveur (par pupitre et par champ). dataChanged n'est émis que pour les rôles
+// dont la valeur a réellement changé ; aucun polling HTTP.
+class PupitreStatusModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QUrl serverUrl READ serverUrl WRITE setServerUrl NOTIFY serverUrlChanged)
+    Q_PROPERTY(bool connected READ isConnected NOTIFY connectedChanged)
+    Q_PROPERTY(bool pureDataConnected READ isPureDataConnected NOTIFY pureDataConnectedChanged)
+    Q_PROPERTY(int connectedCount READ connectedCount NOTIFY connectedCountChanged)
+    Q_PROPERTY(int count READ rowCount CONSTANT)
+    // Écart maximal possible entre deux pupitres sur l'horloge de spectacle (ms) :
+    // somme des deux plus grandes incertitudes (aller-retour / 2 + gigue)
+    Q_PROPERTY(double clockSkewMs READ clockSkewMs NOTIFY clockSkewChanged)
+
+public:
+    enum Roles {
+        PupitreIdRole = Qt::UserRole + 1,
+        NameRole,
+        HostRole,
+        StatusRole,
+        ConnectedRole,
+        SyncedRole,
+        CurrentNoteRole,
+        CurrentHzRole,
+        CurrentRpmRole,
+        VelocityRole,
+        AmbitusMinRole,
+        AmbitusMaxRole,
+        LastUpdateRole,
+        ClockSyncedRole,
+        ClockOffsetRole,
+        ClockRttRole,
+        ClockJitterRole,
+        RoleEnd
+    };
+
+    static constexpr int PupitreCount = 7;
+
+    explicit PupitreStatusModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QUrl serverUrl() const { return m_serverUrl; }
+    void setServerUrl(const QUrl &url);
+    bool isConnected() const { return m_socket.state() == QAbstractSocket::ConnectedState; }
+    bool isPureDataConnected() const { return m_connectedCount > 0; }
+    int connectedCount() const { return m_connectedCount; }
+    double clockSkewMs() const { return m_clockSkewMs; }
+
+    Q_INVOKABLE int indexOf(const QString &pupitreId) const;
+    Q_INVOKABLE QVariantMap get(int row) const;
+    // Champs statiques (nom, host, ambitus) depuis la config / le preset
+    Q_INVOKABLE void setPupitreInfo(const QString &pupitreId, const QVariantMap &info);
+    // Delta au format serveur : { connected, isSynced, noteFloat, frequency, rpm, ... }
+    Q_INVOKABLE void applyDelta(const QString &pupitreId, const QVariantMap &fields);
+
+signals:
+    void serverUrlChanged();
+    void connectedChanged();
+    void pureDataConnectedChanged();
+    void connectedCountChanged();
+    void clockSkewChanged();
+    // Compatibilité avec ConsoleController.pupitreStatusChanged
+    void pupitreStatusChanged(const QString &pupitreId, const QString &status);
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onTextMessageReceived(const QString &message);
+    void onBinaryMessageReceived(const QByteArray &message);
+    void openSocket();
+
+private:
+    void handleMessage(const QJsonObject &message);
+    void applyConnections(const QJsonObject &status);
+    bool setField(int row, int role, const QVariant &value, QVector<int> &changedRoles);
+    void recountConnected();
+    void updateClockSkew();
+
+    QVector<QVector<QVariant>> m_rows;
+    QHash<QString, int> m_roleForField;
+    QWebSocket m_socket;
+    QTimer m_reconnectTimer;
+    QTimer m_keepAliveTimer;
+    QUrl m_serverUrl;
+    int m_connectedCount;
+    double m_clockSkewMs;
+    int m_reconnectDelay;
+};
+
+#endif // PUPITRESTATUSMODEL_H
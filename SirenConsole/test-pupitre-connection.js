@@ -53,8 +53,8 @@ ws.on('message', (message) => {
         const data = JSON.parse(message.toString());
         if (data.type === 'INITIAL_STATUS') {
             console.log('📥 INITIAL_STATUS reçu');
-        } else if (data.type === 'PUPITRE_STATUS_UPDATE') {
-            console.log('📥 PUPITRE_STATUS_UPDATE reçu');
+        } else if (data.type === 'PUPITRE_STATUS_DELTA') {
+            console.log('📥 PUPITRE_STATUS_DELTA reçu:', data.pupitreId, JSON.stringify(data.fields));
         } else {
             console.log('📥 Message reçu:', data.type);
         }
@@ -1,5 +1,6 @@
 const fs = require('fs').promises;
 const path = require('path');
+const { MidiLibrary, filterFiles } = require('./midi-library.js');
 
 // Charger la config pour obtenir le chemin MIDI
 const { loadConfig } = require('../../config-loader.js');
@@ -8,6 +9,11 @@ const MIDI_REPO_PATH = process.env.MECAVIV_COMPOSITIONS_PATH || config.paths.mid
 
 console.log('📁 MIDI Repository Path:', MIDI_REPO_PATH);
 
+// Métadonnées des compositions (analyse parallèle, cache persistant)
+const MIDI_CACHE_PATH = process.env.MECAVIV_MIDI_CACHE || path.join(__dirname, 'midi-library-cache.json');
+const library = new MidiLibrary(MIDI_CACHE_PATH);
+const SIRENS = (config.sirenConfig && config.sirenConfig.sirens) || [];
+
 /**
  * Scanner un répertoire récursivement pour trouver les fichiers MIDI
  */
@@ -46,21 +52,25 @@ async function scanDirectory(dir, category = '', baseDir = dir) {
 }
 
 /**
- * GET /api/midi/files
- * Retourne la liste de tous les fichiers MIDI disponibles
+ * GET /api/midi/files[?siren=3&minSuitability=0.9&maxDuration=240000&q=texte]
+ * Retourne la liste des fichiers MIDI avec leurs métadonnées (`info`), filtrée si demandé
  */
 async function getMidiFiles(req, res) {
     try {
-        console.log('📂 Scanning MIDI files...');
+        const query = new URL(req.url, 'http://localhost').searchParams;
         const files = await scanDirectory(MIDI_REPO_PATH);
+        const analysis = await library.annotate(files, SIRENS);
+        const selected = filterFiles(files, query);
         
-        console.log(`✅ Found ${files.length} MIDI files`);
+        console.log(`✅ ${files.length} MIDI files (${analysis.analyzed} analysés, ${analysis.cached} en cache, ${analysis.ms} ms)`);
         
         res.writeHead(200, { 'Content-Type': 'application/json' });
         res.end(JSON.stringify({
             success: true,
-            count: files.length,
-            files: files,
+            count: selected.length,
+            total: files.length,
+            files: selected,
+            analysis: analysis,
             repositoryPath: MIDI_REPO_PATH
         }));
     } catch (error) {
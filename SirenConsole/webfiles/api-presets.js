@@ -1,12 +1,16 @@
 // API REST pour la gestion des presets
-// Serveur Node.js simple pour les presets
+// Serveur Node.js simple pour les presets, stockés dans un journal en ajout seul (preset-store.js)
 
 const express = require('express');
 const fs = require('fs').promises;
 const path = require('path');
+const PresetStore = require('./preset-store.js');
 
 const app = express();
+// presets.json : import initial seulement ; la bibliothèque vit dans presets.log
 const PRESETS_FILE = path.join(__dirname, 'presets.json');
+const PRESETS_LOG = path.join(__dirname, 'presets.log');
+const store = new PresetStore(PRESETS_LOG);
 
 // Middleware
 app.use(express.json());
@@ -66,88 +70,75 @@ function createDefaultPresets() {
     };
 }
 
-// Initialiser le fichier presets s'il n'existe pas
+// Ouvrir le journal ; au premier lancement, importer presets.json (laissé en place) ou les presets par défaut
 async function initializePresetsFile() {
+    let existed = true;
     try {
-        await fs.access(PRESETS_FILE);
+        await fs.access(PRESETS_LOG);
     } catch (error) {
-        // Fichier n'existe pas, le créer avec des presets par défaut
-        const defaultPresets = createDefaultPresets();
-        await writePresets(defaultPresets);
-        console.log("📁 Fichier presets.json créé avec les presets par défaut");
+        existed = false;
     }
-}
-
-async function healPresetsFile(originalError) {
-    console.warn("⚠️ Fichier presets corrompu, tentative d'auto-réparation:", originalError.message);
-    const timestamp = new Date().toISOString().replace(/[:.]/g, '-');
-    const backupPath = `${PRESETS_FILE}.corrupted-${timestamp}`;
-    
+    const count = await store.open();
+    // Journal endommagé : pas d'import par-dessus, la copie .corrupted-* sert à la réparation
+    if ((existed && count > 0) || store.readOnly) {
+        return;
+    }
+    let initial = null;
     try {
-        // Essayer de sauvegarder le fichier corrompu
-        try {
-            await fs.rename(PRESETS_FILE, backupPath);
-            console.warn(`📦 Copie du fichier corrompu vers ${backupPath}`);
-        } catch (renameError) {
-            // Si le fichier n'existe pas ou est déjà renommé, continuer
-            console.warn("⚠️ Impossible de sauvegarder le fichier corrompu:", renameError.message);
+        const parsed = JSON.parse(await fs.readFile(PRESETS_FILE, 'utf8'));
+        if (parsed && Array.isArray(parsed.presets) && parsed.presets.length > 0) {
+            initial = parsed;
+            console.log(`📁 ${parsed.presets.length} presets importés depuis presets.json`);
         }
     } catch (error) {
-        // Ignorer les erreurs de sauvegarde
+        if (error.code !== 'ENOENT') {
+            console.warn("⚠️ presets.json illisible, presets par défaut:", error.message);
+        }
     }
-    
-    // Régénérer avec les valeurs par défaut (utilise l'écriture atomique)
-    const defaultPresets = createDefaultPresets();
-    await writePresets(defaultPresets);
-    console.warn("✅ Fichier presets régénéré avec les valeurs par défaut");
-    return defaultPresets;
+    if (!initial) {
+        initial = createDefaultPresets();
+        console.log("📁 Journal de presets créé avec les presets par défaut");
+    }
+    await store.replaceAll(initial.presets);
 }
 
 // Lire tous les presets
 async function readPresets() {
+    return { presets: await store.all() };
+}
+
+// Lire un preset par id (lecture directe, sans relire la bibliothèque)
+async function getPreset(id) {
+    return await store.get(id);
+}
+
+// Sauvegarder un preset (ajout au journal, durable au retour)
+async function putPreset(preset) {
     try {
-        const data = await fs.readFile(PRESETS_FILE, 'utf8');
-        const parsed = JSON.parse(data);
-        
-        // Valider la structure
-        if (!parsed || typeof parsed !== 'object') {
-            throw new Error('Structure invalide: pas un objet');
-        }
-        if (!Array.isArray(parsed.presets)) {
-            throw new Error('Structure invalide: presets n\'est pas un tableau');
-        }
-        
-        return parsed;
+        await store.put(preset);
+        return true;
+    } catch (error) {
+        console.error("❌ Erreur écriture preset:", error);
+        return false;
+    }
+}
+
+async function deletePreset(id) {
+    try {
+        return await store.remove(id);
     } catch (error) {
-        console.error("❌ Erreur lecture presets:", error);
-        return await healPresetsFile(error);
+        console.error("❌ Erreur suppression preset:", error);
+        return false;
     }
 }
 
-// Écrire les presets (écriture atomique)
+// Remplacer la bibliothèque : seuls les presets modifiés sont réécrits
 async function writePresets(data) {
-    const tempFile = `${PRESETS_FILE}.tmp`;
-    
     try {
-        // Valider que le JSON est valide avant l'écriture
-        const jsonString = JSON.stringify(data, null, 2);
-        JSON.parse(jsonString); // Vérifier que c'est du JSON valide
-        
-        // Écriture atomique : écrire dans un fichier temporaire puis renommer
-        await fs.writeFile(tempFile, jsonString, 'utf8');
-        await fs.rename(tempFile, PRESETS_FILE);
-        
+        await store.replaceAll(data.presets || []);
         return true;
     } catch (error) {
         console.error("❌ Erreur écriture presets:", error);
-        
-        // Nettoyer le fichier temporaire s'il existe
-        try {
-            await fs.unlink(tempFile);
-        } catch (unlinkError) {
-            // Ignorer l'erreur de suppression du fichier temporaire
-        }
-        
         return false;
     }
 }
@@ -175,8 +166,7 @@ app.get('/api/presets/:id', async (req, res) => {
         const presetId = req.params.id;
         console.log("📥 GET /api/presets/" + presetId);
         
-        const data = await readPresets();
-        const preset = data.presets.find(p => p.id === presetId);
+        const preset = await getPreset(presetId);
         
         if (preset) {
             res.json(preset);
@@ -201,8 +191,6 @@ app.post('/api/presets', async (req, res) => {
             return res.status(400).json({ error: "Le nom du preset est requis" });
         }
         
-        const data = await readPresets();
-        
         // Générer un ID unique
         presetData.id = generateId();
         presetData.created = new Date().toISOString();
@@ -210,9 +198,7 @@ app.post('/api/presets', async (req, res) => {
         presetData.version = presetData.version || "1.0";
         
         // Ajouter le preset
-        data.presets.push(presetData);
-        
-        if (await writePresets(data)) {
+        if (await putPreset(presetData)) {
             console.log("✅ Preset créé:", presetData.id);
             res.status(201).json(presetData);
         } else {
@@ -232,10 +218,9 @@ app.put('/api/presets/:id', async (req, res) => {
         
         const presetData = req.body;
         
-        const data = await readPresets();
-        const presetIndex = data.presets.findIndex(p => p.id === presetId);
+        const existing = await getPreset(presetId);
         
-        if (presetIndex === -1) {
+        if (!existing) {
             return res.status(404).json({ error: "Preset non trouvé" });
         }
         
@@ -244,13 +229,11 @@ app.put('/api/presets/:id', async (req, res) => {
         presetData.modified = new Date().toISOString();
         
         // Conserver la date de création
-        if (data.presets[presetIndex].created) {
-            presetData.created = data.presets[presetIndex].created;
+        if (existing.created) {
+            presetData.created = existing.created;
         }
         
-        data.presets[presetIndex] = presetData;
-        
-        if (await writePresets(data)) {
+        if (await putPreset(presetData)) {
             console.log("✅ Preset mis à jour:", presetId);
             res.json(presetData);
         } else {
@@ -268,17 +251,12 @@ app.delete('/api/presets/:id', async (req, res) => {
         const presetId = req.params.id;
         console.log("🗑️ DELETE /api/presets/" + presetId);
         
-        const data = await readPresets();
-        const presetIndex = data.presets.findIndex(p => p.id === presetId);
-        
-        if (presetIndex === -1) {
+        if (!store.has(presetId)) {
             return res.status(404).json({ error: "Preset non trouvé" });
         }
         
         // Supprimer le preset
-        data.presets.splice(presetIndex, 1);
-        
-        if (await writePresets(data)) {
+        if (await deletePreset(presetId)) {
             console.log("✅ Preset supprimé:", presetId);
             res.status(204).send();
         } else {
@@ -295,7 +273,7 @@ async function cleanupTempFiles() {
     try {
         const dir = path.dirname(PRESETS_FILE);
         const files = await fs.readdir(dir);
-        const tempFiles = files.filter(f => f === 'presets.json.tmp');
+        const tempFiles = files.filter(f => f === 'presets.json.tmp' || f === 'presets.log.tmp');
         
         for (const file of tempFiles) {
             try {
@@ -316,7 +294,8 @@ async function initializePresetAPI() {
     await cleanupTempFiles();
     
     await initializePresetsFile();
-    console.log(`📁 Fichier presets initialisé: ${PRESETS_FILE}`);
+    const stats = store.stats();
+    console.log(`📁 Journal de presets: ${PRESETS_LOG} (${stats.presets} presets, ${stats.fileBytes} octets)`);
 }
 
 // Export pour utilisation dans server.js
@@ -325,5 +304,8 @@ module.exports = {
     app,
     readPresets,
     writePresets,
+    getPreset,
+    putPreset,
+    deletePreset,
     createDefaultPresets
 };
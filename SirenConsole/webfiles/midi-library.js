@@ -0,0 +1,423 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+
+/**
+ * Bibliothèque de compositions : métadonnées MIDI analysées en parallèle (worker_threads)
+ * et gardées dans un cache persistant clé = chemin relatif, mtime et taille.
+ * Lister ou filtrer la bibliothèque ne relit que les fichiers modifiés depuis la dernière fois.
+ *
+ * Analyse (indépendante de la config des sirènes, donc cachée telle quelle) :
+ *   durée réelle (carte de tempo), tempo initial, signature, nombre de notes, densité (notes/s),
+ *   ambitus par piste et histogramme des hauteurs (canal 10 / percussions exclu).
+ * L'adéquation par sirène (part des notes dans son ambitus) est calculée à la lecture
+ * à partir de l'histogramme : changer d'ambitus n'invalide pas le cache.
+ *
+ * L'analyse est le seul travail lourd ; les worker_threads l'étalent sur les cœurs sans
+ * module natif à compiler au déploiement (npm install seul), et le parcours direct des
+ * octets SMF, sans objet par événement, garde le coût proche de celui d'un analyseur natif.
+ */
+
+const CACHE_VERSION = 1;
+const MAX_TEMPO_CHANGES = 256;
+const PERCUSSION_CHANNEL = 9;
+
+// --- Analyse (exécutée dans les workers) ---
+
+function readVarLen(buffer, state) {
+    let value = 0;
+    for (let i = 0; i < 4; i++) {
+        if (state.pos >= state.end)
+            throw new Error('Longueur variable tronquée');
+        const byte = buffer[state.pos++];
+        value = (value << 7) | (byte & 0x7F);
+        if ((byte & 0x80) === 0)
+            return value;
+    }
+    throw new Error('Longueur variable invalide');
+}
+
+/**
+ * Parcours direct du SMF, sans objets par événement : seuls tempo, signature,
+ * nom de piste et notes jouées sont relevés.
+ */
+function analyzeMidiBuffer(buffer) {
+    if (buffer.length < 14 || buffer.toString('ascii', 0, 4) !== 'MThd')
+        throw new Error('En-tête MThd absent');
+    const headerLength = buffer.readUInt32BE(4);
+    const format = buffer.readUInt16BE(8);
+    const trackCount = buffer.readUInt16BE(10);
+    const division = buffer.readUInt16BE(12);
+    // Division SMPTE (bit 15) : ticks par seconde fixes, pas de tempo
+    const smpte = (division & 0x8000) !== 0;
+    const ppq = smpte ? 0 : division;
+    const ticksPerSecond = smpte ? (256 - (division >> 8)) * (division & 0xFF) : 0;
+
+    const tempoChanges = [];
+    let timeSignature = null;
+    const histogram = new Array(128).fill(0);
+    const tracks = [];
+    let totalTicks = 0;
+    let noteCount = 0;
+
+    let offset = 8 + headerLength;
+    for (let t = 0; t < trackCount && offset + 8 <= buffer.length; t++) {
+        const chunkType = buffer.toString('ascii', offset, offset + 4);
+        const chunkLength = buffer.readUInt32BE(offset + 4);
+        const state = { pos: offset + 8, end: Math.min(buffer.length, offset + 8 + chunkLength) };
+        offset = state.end;
+        if (chunkType !== 'MTrk')
+            continue;
+
+        const track = { index: t, name: '', notes: 0, min: 127, max: 0, channels: 0, percussion: false };
+        let tick = 0;
+        let status = 0;
+        while (state.pos < state.end) {
+            tick += readVarLen(buffer, state);
+            let byte = buffer[state.pos];
+            if (byte & 0x80) {
+                status = byte;
+                state.pos++;
+            } else if (status === 0 || status >= 0xF0) {
+                throw new Error('Running status sans statut');
+            }
+
+            if (status === 0xFF) {
+                const type = buffer[state.pos++];
+                const length = readVarLen(buffer, state);
+                const data = state.pos;
+                state.pos += length;
+                status = 0;
+                if (type === 0x51 && length >= 3) {
+                    if (tempoChanges.length < MAX_TEMPO_CHANGES)
+                        tempoChanges.push({ tick, usPerBeat: buffer.readUIntBE(data, 3) });
+                } else if (type === 0x58 && length >= 2 && !timeSignature) {
+                    timeSignature = { numerator: buffer[data], denominator: 1 << buffer[data + 1] };
+                } else if (type === 0x03 && !track.name) {
+                    track.name = buffer.toString('utf8', data, Math.min(data + length, state.end)).trim();
+                } else if (type === 0x2F) {
+                    break;
+                }
+                continue;
+            }
+            if (status === 0xF0 || status === 0xF7) {
+                state.pos += readVarLen(buffer, state);
+                status = 0;
+                continue;
+            }
+
+            const kind = status & 0xF0;
+            const channel = status & 0x0F;
+            const dataBytes = (kind === 0xC0 || kind === 0xD0) ? 1 : 2;
+            const note = buffer[state.pos];
+            const velocity = buffer[state.pos + 1];
+            state.pos += dataBytes;
+            if (kind === 0x90 && velocity > 0) {
+                noteCount++;
+                track.notes++;
+                track.channels |= 1 << channel;
+                if (channel === PERCUSSION_CHANNEL) {
+                    track.percussion = true;
+                    continue;
+                }
+                histogram[note]++;
+                if (note < track.min) track.min = note;
+                if (note > track.max) track.max = note;
+            }
+        }
+        if (tick > totalTicks)
+            totalTicks = tick;
+        if (track.notes > 0) {
+            if (track.min > track.max) {
+                track.min = null;
+                track.max = null;
+            }
+            tracks.push(track);
+        }
+    }
+
+    // Durée réelle : intégration de la carte de tempo (120 BPM avant le premier changement)
+    tempoChanges.sort((a, b) => a.tick - b.tick);
+    const tempoMap = [];
+    let durationMs = 0;
+    if (smpte) {
+        durationMs = ticksPerSecond > 0 ? totalTicks * 1000 / ticksPerSecond : 0;
+    } else if (ppq > 0) {
+        let lastTick = 0;
+        let usPerBeat = 500000;
+        for (const change of tempoChanges) {
+            const at = Math.min(change.tick, totalTicks);
+            durationMs += (at - lastTick) * usPerBeat / ppq / 1000;
+            lastTick = at;
+            usPerBeat = change.usPerBeat;
+            tempoMap.push({ tick: change.tick, ms: Math.round(durationMs), bpm: Math.round(60000000 / usPerBeat * 100) / 100 });
+        }
+        durationMs += (totalTicks - lastTick) * usPerBeat / ppq / 1000;
+    }
+
+    return {
+        format,
+        ppq,
+        totalTicks,
+        totalBeats: ppq > 0 ? Math.floor(totalTicks / ppq) : 0,
+        duration: Math.round(durationMs),
+        tempo: tempoMap.length > 0 && tempoMap[0].tick === 0 ? Math.round(tempoMap[0].bpm) : 120,
+        tempoMap,
+        timeSignature: timeSignature || { numerator: 4, denominator: 4 },
+        noteCount,
+        density: durationMs > 0 ? Math.round(noteCount / (durationMs / 1000) * 100) / 100 : 0,
+        tracks,
+        histogram
+    };
+}
+
+if (!isMainThread) {
+    parentPort.on('message', ({ id, fullPath }) => {
+        try {
+            parentPort.postMessage({ id, analysis: analyzeMidiBuffer(fs.readFileSync(fullPath)) });
+        } catch (error) {
+            parentPort.postMessage({ id, error: error.message });
+        }
+    });
+    return;
+}
+
+// --- Bibliothèque (thread principal) ---
+
+// Part des notes jouables par chaque sirène (0..1), ambitus lus dans la config des sirènes
+function sirenSuitability(histogram, sirens) {
+    const suitability = {};
+    const total = histogram.reduce((sum, count) => sum + count, 0);
+    for (const siren of sirens || []) {
+        if (!siren || !siren.ambitus)
+            continue;
+        let inRange = 0;
+        for (let note = Math.max(0, siren.ambitus.min); note <= Math.min(127, siren.ambitus.max); note++)
+            inRange += histogram[note];
+        suitability[siren.id] = total > 0 ? Math.round(inRange / total * 1000) / 1000 : 0;
+    }
+    return suitability;
+}
+
+class WorkerPool {
+    constructor(size) {
+        this.size = size;
+        this.workers = [];
+        this.idle = [];
+        this.queue = [];
+        this.tasks = new Map();
+        this.nextId = 1;
+        this.idleTimer = null;
+    }
+
+    run(fullPath) {
+        return new Promise((resolve, reject) => {
+            this.queue.push({ id: this.nextId++, fullPath, resolve, reject });
+            this.dispatch();
+        });
+    }
+
+    dispatch() {
+        clearTimeout(this.idleTimer);
+        while (this.queue.length > 0) {
+            let worker = this.idle.pop();
+            if (!worker) {
+                if (this.workers.length >= this.size)
+                    return;
+                worker = this.spawn();
+            }
+            const task = this.queue.shift();
+            this.tasks.set(task.id, { task, worker });
+            worker.postMessage({ id: task.id, fullPath: task.fullPath });
+        }
+        // Workers arrêtés après 30 s d'inactivité
+        if (this.tasks.size === 0) {
+            this.idleTimer = setTimeout(() => this.shutdown(), 30000);
+            this.idleTimer.unref();
+        }
+    }
+
+    spawn() {
+        const worker = new Worker(__filename);
+        worker.unref();
+        worker.on('message', ({ id, analysis, error }) => {
+            const entry = this.tasks.get(id);
+            if (!entry)
+                return;
+            this.tasks.delete(id);
+            this.idle.push(worker);
+            if (error)
+                entry.task.reject(new Error(error));
+            else
+                entry.task.resolve(analysis);
+            this.dispatch();
+        });
+        worker.on('error', (error) => this.retire(worker, error));
+        worker.on('exit', () => this.retire(worker, new Error('Worker MIDI arrêté')));
+        this.workers.push(worker);
+        return worker;
+    }
+
+    retire(worker, error) {
+        this.workers = this.workers.filter(w => w !== worker);
+        this.idle = this.idle.filter(w => w !== worker);
+        for (const [id, entry] of this.tasks) {
+            if (entry.worker === worker) {
+                this.tasks.delete(id);
+                entry.task.reject(error);
+            }
+        }
+        this.dispatch();
+    }
+
+    shutdown() {
+        for (const worker of this.idle)
+            worker.terminate();
+    }
+}
+
+class MidiLibrary {
+    /**
+     * @param {string} cachePath - Fichier JSON du cache
+     * @param {Object} options - { workers: taille du pool (défaut : cœurs - 1, max 8) }
+     */
+    constructor(cachePath, options = {}) {
+        this.cachePath = cachePath;
+        this.pool = new WorkerPool(options.workers || Math.max(1, Math.min(8, os.cpus().length - 1)));
+        this.entries = null;
+        // Analyses en cours (deux listages simultanés ne relisent pas le même fichier)
+        this.inFlight = new Map();
+        this.saveTimer = null;
+        this.dirty = false;
+    }
+
+    loadCache() {
+        if (this.entries)
+            return;
+        this.entries = {};
+        try {
+            const cache = JSON.parse(fs.readFileSync(this.cachePath, 'utf8'));
+            if (cache && cache.version === CACHE_VERSION && cache.entries)
+                this.entries = cache.entries;
+        } catch (error) {
+            if (error.code !== 'ENOENT')
+                console.warn('⚠️ Cache MIDI illisible, reconstruction:', error.message);
+        }
+    }
+
+    // Écriture atomique, regroupée (une écriture pour tout un balayage)
+    scheduleSave() {
+        this.dirty = true;
+        if (this.saveTimer)
+            return;
+        this.saveTimer = setTimeout(() => {
+            this.saveTimer = null;
+            if (!this.dirty)
+                return;
+            this.dirty = false;
+            const temp = `${this.cachePath}.tmp`;
+            fs.promises.writeFile(temp, JSON.stringify({ version: CACHE_VERSION, entries: this.entries }))
+                .then(() => fs.promises.rename(temp, this.cachePath))
+                .catch(error => console.error('❌ Écriture cache MIDI:', error.message));
+        }, 500);
+    }
+
+    async analysisFor(file) {
+        const stat = await fs.promises.stat(file.fullPath);
+        const cached = this.entries[file.path];
+        if (cached && cached.mtimeMs === stat.mtimeMs && cached.size === stat.size)
+            return { analysis: cached.analysis, cached: true };
+
+        const key = `${file.path}:${stat.mtimeMs}:${stat.size}`;
+        let pending = this.inFlight.get(key);
+        if (!pending) {
+            pending = this.pool.run(file.fullPath)
+                .then(analysis => {
+                    this.entries[file.path] = { mtimeMs: stat.mtimeMs, size: stat.size, analysis };
+                    this.scheduleSave();
+                    return analysis;
+                })
+                .catch(error => {
+                    // Fichier illisible : mémorisé aussi, pour ne pas le réanalyser à chaque listage
+                    const analysis = { error: error.message };
+                    this.entries[file.path] = { mtimeMs: stat.mtimeMs, size: stat.size, analysis };
+                    this.scheduleSave();
+                    return analysis;
+                })
+                .finally(() => this.inFlight.delete(key));
+            this.inFlight.set(key, pending);
+        }
+        return { analysis: await pending, cached: false };
+    }
+
+    /**
+     * Ajoute `info` à chaque fichier ({ name, path, category, fullPath } de scanDirectory).
+     * Retourne { analyzed, cached, failed, ms }.
+     */
+    async annotate(files, sirens) {
+        const started = Date.now();
+        this.loadCache();
+        const stats = { analyzed: 0, cached: 0, failed: 0, ms: 0 };
+        await Promise.all(files.map(async (file) => {
+            try {
+                const { analysis, cached } = await this.analysisFor(file);
+                stats[cached ? 'cached' : 'analyzed']++;
+                if (analysis.error) {
+                    stats.failed++;
+                    file.info = { error: analysis.error };
+                    return;
+                }
+                const { histogram, ...info } = analysis;
+                info.suitability = sirenSuitability(histogram, sirens);
+                file.info = info;
+            } catch (error) {
+                stats.failed++;
+                file.info = { error: error.message };
+            }
+        }));
+
+        // Entrées des fichiers disparus
+        const present = new Set(files.map(file => file.path));
+        for (const key of Object.keys(this.entries)) {
+            if (!present.has(key)) {
+                delete this.entries[key];
+                this.dirty = true;
+            }
+        }
+        if (this.dirty)
+            this.scheduleSave();
+        stats.ms = Date.now() - started;
+        return stats;
+    }
+}
+
+/**
+ * Filtres de listage (paramètres de requête) :
+ *   siren=<id>&minSuitability=<0..1>, minDuration / maxDuration (ms), maxDensity (notes/s), q=<texte>
+ */
+function filterFiles(files, query) {
+    const siren = query.get('siren');
+    const minSuitability = parseFloat(query.get('minSuitability') || (siren ? '1' : '0'));
+    const minDuration = parseFloat(query.get('minDuration') || '0');
+    const maxDuration = parseFloat(query.get('maxDuration') || 'Infinity');
+    const maxDensity = parseFloat(query.get('maxDensity') || 'Infinity');
+    const text = (query.get('q') || '').toLowerCase();
+    return files.filter(file => {
+        if (text && !file.path.toLowerCase().includes(text))
+            return false;
+        const info = file.info;
+        if (!info || info.error)
+            return !siren && minDuration === 0 && maxDuration === Infinity && maxDensity === Infinity;
+        if (siren && !((info.suitability[siren] || 0) >= minSuitability))
+            return false;
+        return info.duration >= minDuration && info.duration <= maxDuration && info.density <= maxDensity;
+    });
+}
+
+module.exports = {
+    MidiLibrary,
+    analyzeMidiBuffer,
+    filterFiles,
+    sirenSuitability
+};
@@ -1,6 +1,7 @@
 const fs = require('fs');
 const midiFile = require('midi-file');
 const { performance } = require('perf_hooks');
+const showClock = require('./show-clock');
 
 /**
  * Séquenceur MIDI pour Node.js
@@ -33,7 +34,11 @@ class MidiSequencer {
         // Timer et timing
         this.timer = null;
         this.timerInterval = 50;         // Broadcast toutes les 50ms
-        this.lastTickTime = 0;           // Pour calcul delta temps
+        // Ancre : position (tick, fractionnaire) atteinte à l'instant anchorTime (performance.now()).
+        // La position courante en découle ; les pupitres reçoivent la même ancre
+        // en heure de spectacle et calculent la même position.
+        this.anchorTick = 0;
+        this.anchorTime = 0;
         this.startTime = 0;              // Timestamp démarrage
         // Plus d'horloge MIDI ni d'envoi binaire côté pupitres
         
@@ -45,6 +50,29 @@ class MidiSequencer {
 
     // Plus d'horloge MIDI ni seek/tick binaire
     
+    /**
+     * Position (ticks, fractionnaire) à un instant performance.now()
+     */
+    tickAtTime(perfMs) {
+        if (!this.playing || !Number.isFinite(this.tempo) || this.tempo <= 0) {
+            return this.anchorTick;
+        }
+        const elapsedMs = Math.max(0, perfMs - this.anchorTime);
+        return this.anchorTick + (elapsedMs * 1000 / this.tempo) * this.ppq;
+    }
+    
+    /**
+     * Réancrer la position et diffuser l'ancre aux pupitres (trame "MCLK")
+     */
+    setAnchor(tick, perfMs) {
+        this.anchorTick = Math.max(0, tick);
+        this.anchorTime = perfMs;
+        if (this.pureDataProxy && this.pureDataProxy.broadcastClockAnchor) {
+            this.pureDataProxy.broadcastClockAnchor(
+                showClock.performanceToUs(perfMs), this.anchorTick, this.tempo, this.ppq, this.playing);
+        }
+    }
+    
     /**
      * Charger un fichier MIDI
      */
@@ -232,8 +260,8 @@ class MidiSequencer {
         
         console.log('   Elapsed:', elapsedMs.toFixed(0), 'ms - StartTime:', this.startTime);
         
-        // Démarrer le timer
-        this.lastTickTime = performance.now();
+        // Démarrer le timer (position dérivée de l'ancre, sans cumul d'arrondis)
+        this.setAnchor(this.currentTick, performance.now());
         if (this.timer) {
             clearInterval(this.timer);
             this.timer = null;
@@ -254,6 +282,7 @@ class MidiSequencer {
         
         console.log('⏸ Pause - Position:', this.currentBeat.toFixed(1));
         this.playing = false;
+        this.setAnchor(this.currentTick, performance.now());
         
         if (this.timer) {
             clearInterval(this.timer);
@@ -276,6 +305,7 @@ class MidiSequencer {
         this.currentBar = 1;
         this.currentBeatInBar = 1;
         this.eventIndex = 0;
+        this.setAnchor(0, performance.now());
         
         if (this.timer) {
             clearInterval(this.timer);
@@ -313,10 +343,8 @@ class MidiSequencer {
             this.eventIndex++;
         }
         
-        if (this.playing) {
-            // Recalibrer l'horloge incrémentale
-            this.lastTickTime = performance.now();
-        }
+        // Nouvelle ancre (en lecture ou non)
+        this.setAnchor(tickTarget, performance.now());
         
         // Broadcaster position (UI) uniquement
         this.broadcastPosition();
@@ -328,7 +356,11 @@ class MidiSequencer {
      */
     setTempo(bpm) {
         const safeBpm = Math.max(1, Math.floor(bpm));
+        // Position exacte au changement, puis nouvelle pente
+        const now = performance.now();
+        const tick = this.tickAtTime(now);
         this.tempo = Math.floor(60000000 / safeBpm);
+        this.setAnchor(tick, now);
         console.log('🎼 Tempo changé:', bpm, 'BPM');
         
         // Pas d'envoi binaire; le tempo est relayé en JSON par server.js
@@ -342,22 +374,16 @@ class MidiSequencer {
     tick() {
         if (!this.playing || !this.midiData) return;
         
-        // Intégration incrémentale basée sur delta temps (horloge monotone)
-        const now = performance.now();
-        const deltaMs = now - this.lastTickTime;
-        this.lastTickTime = now;
-
+        // Position dérivée de l'ancre (horloge monotone) : la partie fractionnaire
+        // n'est plus perdue à chaque tick
         // this.tempo est en microsecondes par noire (uspb)
         if (!Number.isFinite(this.tempo) || this.tempo <= 0) {
             // Tempo invalide, ignorer ce tick
             return;
         }
-        const beatIncrement = Math.max(0, deltaMs) / (this.tempo / 1000); // ms / (uspb_ms)
-        const tickIncrementFloat = beatIncrement * this.ppq;
-        const tickIncrement = tickIncrementFloat >= 1 ? Math.floor(tickIncrementFloat) : 0;
+        const targetTick = Math.floor(this.tickAtTime(performance.now()));
 
-        if (tickIncrement > 0) {
-            const targetTick = this.currentTick + tickIncrement;
+        if (targetTick > this.currentTick) {
             // Jouer tous les événements entre currentTick et targetTick
             while (this.eventIndex < this.events.length && this.events[this.eventIndex].tick <= targetTick) {
                 const event = this.events[this.eventIndex];
@@ -392,6 +418,8 @@ class MidiSequencer {
         if (event.tempo) {
             const newBpm = Math.floor(60000000 / event.tempo);
             console.log('🎼 Changement tempo au beat', this.currentBeat.toFixed(1), ':', newBpm, 'BPM');
+            // Instant exact de l'événement selon l'ancre courante, puis nouvelle pente
+            const eventTime = this.anchorTime + (event.tick - this.anchorTick) * (this.tempo / 1000) / this.ppq;
             this.tempo = event.tempo;
             
             // Broadcaster le changement de tempo (0x03)
@@ -400,8 +428,8 @@ class MidiSequencer {
             buffer.writeUInt16LE(newBpm, 1);
             this.pureDataProxy.broadcastBinaryToClients(buffer);
             
-            // Recalibrer la référence de temps pour l'intégration
-            this.lastTickTime = performance.now();
+            // Réancrer sur le tick de l'événement
+            this.setAnchor(event.tick, eventTime);
         }
         
         if (event.timeSignature) {
@@ -0,0 +1,416 @@
+const fs = require('fs').promises;
+const path = require('path');
+
+/**
+ * Bibliothèque de presets : journal binaire en ajout seul + index en mémoire (id → position).
+ *
+ * Chaque sauvegarde ajoute un enregistrement en fin de journal puis fsync ; la bibliothèque
+ * n'est jamais réécrite en place. Une coupure pendant un ajout laisse au pire un
+ * enregistrement incomplet en fin de fichier, écarté (CRC) à la réouverture.
+ * Le compactage écrit un nouveau journal à côté, fsync, puis rename + fsync du dossier.
+ *
+ * Le serveur Node est le seul écrivain du journal (routes /api/presets, presets courants) :
+ * l'ordre des ajouts et le compactage ne demandent donc aucun verrou de fichier. Un store
+ * C++ ajouterait un second processus (ou un module natif) sur le même fichier.
+ *
+ * Fichier : "MPST" u8 version, puis enregistrements :
+ *   [0..3] longueur u32 (id + données), [4..7] CRC32 u32 (type, id, données),
+ *   [8] type (1 = preset, 2 = suppression), [9..10] longueur id u16, id UTF-8, JSON UTF-8
+ * Entiers little-endian.
+ */
+
+const MAGIC = 'MPST';
+const VERSION = 1;
+const FILE_HEADER_SIZE = 5;
+const RECORD_HEADER_SIZE = 11;
+const Kind = {
+    PUT: 1,
+    DELETE: 2
+};
+// Au-delà, la longueur lue est tenue pour corrompue
+const MAX_RECORD_SIZE = 64 * 1024 * 1024;
+// Compactage quand les enregistrements périmés dépassent les vivants (et 64 Kio)
+const COMPACT_MIN_DEAD_BYTES = 64 * 1024;
+
+const CRC_TABLE = (() => {
+    const table = new Uint32Array(256);
+    for (let n = 0; n < 256; n++) {
+        let c = n;
+        for (let k = 0; k < 8; k++)
+            c = (c & 1) ? (0xEDB88320 ^ (c >>> 1)) : (c >>> 1);
+        table[n] = c >>> 0;
+    }
+    return table;
+})();
+
+function crc32(buffer, start = 0, end = buffer.length) {
+    let c = 0xFFFFFFFF;
+    for (let i = start; i < end; i++)
+        c = CRC_TABLE[(c ^ buffer[i]) & 0xFF] ^ (c >>> 8);
+    return (c ^ 0xFFFFFFFF) >>> 0;
+}
+
+function encodeRecord(kind, id, payload) {
+    const idBytes = Buffer.from(String(id), 'utf8');
+    const data = payload ? Buffer.from(payload, 'utf8') : Buffer.alloc(0);
+    const record = Buffer.allocUnsafe(RECORD_HEADER_SIZE + idBytes.length + data.length);
+    record.writeUInt32LE(idBytes.length + data.length, 0);
+    record.writeUInt8(kind, 8);
+    record.writeUInt16LE(idBytes.length, 9);
+    idBytes.copy(record, RECORD_HEADER_SIZE);
+    data.copy(record, RECORD_HEADER_SIZE + idBytes.length);
+    record.writeUInt32LE(crc32(record, 8), 4);
+    return record;
+}
+
+// Enregistrement complet et intègre à cette position du tampon
+function isValidRecord(buffer, offset) {
+    const length = buffer.readUInt32LE(offset);
+    const kind = buffer.readUInt8(offset + 8);
+    const idLength = buffer.readUInt16LE(offset + 9);
+    const recordEnd = offset + RECORD_HEADER_SIZE + length;
+    return recordEnd <= buffer.length && idLength <= length
+        && (kind === Kind.PUT || kind === Kind.DELETE)
+        && crc32(buffer, offset + 8, recordEnd) === buffer.readUInt32LE(offset + 4);
+}
+
+function fileHeader() {
+    const header = Buffer.alloc(FILE_HEADER_SIZE);
+    header.write(MAGIC, 0, 'ascii');
+    header.writeUInt8(VERSION, 4);
+    return header;
+}
+
+// fsync du dossier : rend le rename durable (sans effet sur les systèmes qui le refusent)
+async function syncDirectory(dir) {
+    let handle = null;
+    try {
+        handle = await fs.open(dir, 'r');
+        await handle.sync();
+    } catch (error) {
+        // Windows : ouverture d'un dossier impossible, le rename y est déjà journalisé
+    } finally {
+        if (handle)
+            await handle.close();
+    }
+}
+
+// Écrit un fichier complet à côté de la cible, fsync, puis le substitue
+async function writeFileAtomic(target, buffers) {
+    const temp = `${target}.tmp`;
+    const handle = await fs.open(temp, 'w');
+    try {
+        for (const buffer of buffers)
+            await handle.write(buffer);
+        await handle.sync();
+    } finally {
+        await handle.close();
+    }
+    await fs.rename(temp, target);
+    await syncDirectory(path.dirname(target));
+}
+
+class PresetStore {
+    constructor(logPath) {
+        this.logPath = logPath;
+        this.handle = null;
+        this.size = 0;
+        // id → { offset, length, crc } des données JSON ; ordre d'insertion = ordre de la liste
+        this.index = new Map();
+        this.liveBytes = 0;
+        this.deadBytes = 0;
+        // Écritures et compactage sérialisés
+        this.queue = Promise.resolve();
+        this.compactionScheduled = false;
+        // Lectures en cours sur le descripteur courant (attendues avant de le fermer au compactage)
+        this.pendingReads = new Set();
+        // Motif si le journal est endommagé : lectures seules, aucune écriture ni compactage
+        this.readOnly = null;
+    }
+
+    /**
+     * Ouvre (ou crée) le journal et reconstruit l'index. Avant toute troncature, le fichier
+     * d'origine est copié en .corrupted-<horodatage>. Seul un dernier enregistrement
+     * incomplet (écriture interrompue) est écarté ; un enregistrement endommagé ailleurs
+     * laisse le journal intact et ouvert en lecture seule (presets antérieurs lisibles,
+     * écritures refusées) jusqu'à réparation manuelle.
+     * Retourne le nombre de presets.
+     */
+    async open() {
+        try {
+            this.handle = await fs.open(this.logPath, 'r+');
+        } catch (error) {
+            if (error.code !== 'ENOENT')
+                throw error;
+            await writeFileAtomic(this.logPath, [fileHeader()]);
+            this.handle = await fs.open(this.logPath, 'r+');
+        }
+        const { size } = await this.handle.stat();
+        const header = Buffer.alloc(FILE_HEADER_SIZE);
+        await this.handle.read(header, 0, FILE_HEADER_SIZE, 0);
+        if (size < FILE_HEADER_SIZE || header.toString('ascii', 0, 4) !== MAGIC || header.readUInt8(4) !== VERSION)
+            throw new Error(`${this.logPath} n'est pas un journal de presets`);
+
+        const end = await this.scan(size);
+        this.size = end;
+        if (end < size) {
+            const timestamp = new Date().toISOString().replace(/[:.]/g, '-');
+            const backup = `${this.logPath}.corrupted-${timestamp}`;
+            await fs.copyFile(this.logPath, backup);
+            if (await this.isTornTail(end, size)) {
+                // Coupure pendant un ajout : seul le dernier enregistrement, jamais confirmé, est perdu
+                console.warn(`⚠️ Journal de presets : ${size - end} octets incomplets en fin de fichier écartés (copie dans ${backup})`);
+                await this.handle.truncate(end);
+                await this.handle.sync();
+            } else {
+                this.readOnly = `Journal de presets endommagé à l'octet ${end} (copie dans ${backup})`;
+                console.error(`❌ ${this.readOnly} : ouvert en lecture seule, ${size - end} octets non lus`);
+            }
+        }
+        return this.index.size;
+    }
+
+    /**
+     * Écriture interrompue en fin de fichier, par opposition à une corruption : la longueur
+     * annoncée est plausible, dépasse le reste du fichier, et aucun enregistrement valide
+     * ne suit dans ce reste.
+     */
+    async isTornTail(end, size) {
+        const remaining = size - end;
+        if (remaining < RECORD_HEADER_SIZE)
+            return true;
+        const tail = Buffer.alloc(remaining);
+        await this.handle.read(tail, 0, remaining, end);
+        const length = tail.readUInt32LE(0);
+        if (length > MAX_RECORD_SIZE || remaining >= RECORD_HEADER_SIZE + length)
+            return false;
+        for (let offset = 1; offset + RECORD_HEADER_SIZE <= remaining; offset++) {
+            if (isValidRecord(tail, offset))
+                return false;
+        }
+        return true;
+    }
+
+    // Parcours séquentiel des enregistrements (contrôle CRC, aucun JSON.parse) ; retourne la fin valide
+    async scan(size) {
+        const chunkSize = 256 * 1024;
+        let buffer = Buffer.alloc(0);
+        let bufferOffset = FILE_HEADER_SIZE;
+        let readOffset = FILE_HEADER_SIZE;
+        let offset = FILE_HEADER_SIZE;
+        for (;;) {
+            const local = offset - bufferOffset;
+            if (buffer.length - local >= 4 && buffer.readUInt32LE(local) > MAX_RECORD_SIZE)
+                return offset;
+            if (buffer.length - local < RECORD_HEADER_SIZE
+                || buffer.length - local < RECORD_HEADER_SIZE + buffer.readUInt32LE(local)) {
+                if (readOffset >= size)
+                    return offset;
+                const chunk = Buffer.alloc(Math.min(chunkSize, size - readOffset));
+                const { bytesRead } = await this.handle.read(chunk, 0, chunk.length, readOffset);
+                if (bytesRead === 0)
+                    return offset;
+                buffer = Buffer.concat([buffer.subarray(local), chunk.subarray(0, bytesRead)]);
+                bufferOffset = offset;
+                readOffset += bytesRead;
+                continue;
+            }
+            const length = buffer.readUInt32LE(local);
+            const crc = buffer.readUInt32LE(local + 4);
+            const kind = buffer.readUInt8(local + 8);
+            const idLength = buffer.readUInt16LE(local + 9);
+            const recordEnd = local + RECORD_HEADER_SIZE + length;
+            if (idLength > length || (kind !== Kind.PUT && kind !== Kind.DELETE)
+                || crc32(buffer, local + 8, recordEnd) !== crc)
+                return offset;
+            const id = buffer.toString('utf8', local + RECORD_HEADER_SIZE, local + RECORD_HEADER_SIZE + idLength);
+            const dataOffset = offset + RECORD_HEADER_SIZE + idLength;
+            const dataLength = length - idLength;
+            this.apply(kind, id, dataOffset, dataLength, crc32(buffer, recordEnd - dataLength, recordEnd));
+            offset += RECORD_HEADER_SIZE + length;
+        }
+    }
+
+    apply(kind, id, offset, length, crc) {
+        const previous = this.index.get(id);
+        if (previous) {
+            this.liveBytes -= previous.length;
+            this.deadBytes += previous.length;
+        }
+        if (kind === Kind.PUT) {
+            this.index.set(id, { offset, length, crc });
+            this.liveBytes += length;
+        } else {
+            this.index.delete(id);
+        }
+    }
+
+    has(id) {
+        return this.index.has(id);
+    }
+
+    ids() {
+        return Array.from(this.index.keys());
+    }
+
+    // Lecture d'un preset : une lecture positionnée, un JSON.parse
+    async get(id) {
+        const entry = this.index.get(id);
+        if (!entry)
+            return null;
+        const data = Buffer.alloc(entry.length);
+        const read = this.handle.read(data, 0, entry.length, entry.offset);
+        this.pendingReads.add(read);
+        try {
+            await read;
+        } finally {
+            this.pendingReads.delete(read);
+        }
+        return JSON.parse(data.toString('utf8'));
+    }
+
+    async all() {
+        const presets = [];
+        for (const id of this.ids()) {
+            const preset = await this.get(id);
+            if (preset)
+                presets.push(preset);
+        }
+        return presets;
+    }
+
+    // Sauvegarde d'un preset (rendue durable avant résolution)
+    put(preset) {
+        const id = preset && (preset.id || preset.name);
+        if (!id)
+            return Promise.reject(new Error('Preset sans id'));
+        const payload = JSON.stringify(preset);
+        return this.enqueue(() => this.append([{ kind: Kind.PUT, id, payload }]));
+    }
+
+    remove(id) {
+        return this.enqueue(() => this.has(id) ? this.append([{ kind: Kind.DELETE, id }]) : false);
+    }
+
+    /**
+     * Remplace la bibliothèque entière : seuls les presets modifiés, nouveaux ou supprimés
+     * sont ajoutés au journal, en un seul fsync.
+     */
+    replaceAll(presets) {
+        return this.enqueue(() => {
+            const records = [];
+            const kept = new Set();
+            for (const preset of presets) {
+                const id = preset && (preset.id || preset.name);
+                if (!id)
+                    continue;
+                kept.add(id);
+                const payload = JSON.stringify(preset);
+                const entry = this.index.get(id);
+                const bytes = Buffer.from(payload, 'utf8');
+                if (entry && entry.length === bytes.length && entry.crc === crc32(bytes))
+                    continue;
+                records.push({ kind: Kind.PUT, id, payload });
+            }
+            for (const id of this.index.keys()) {
+                if (!kept.has(id))
+                    records.push({ kind: Kind.DELETE, id });
+            }
+            return records.length > 0 ? this.append(records) : false;
+        });
+    }
+
+    enqueue(task) {
+        const result = this.queue.then(task);
+        this.queue = result.catch(() => {});
+        return result;
+    }
+
+    async append(records) {
+        if (this.readOnly)
+            throw new Error(this.readOnly);
+        const buffers = records.map(record => encodeRecord(record.kind, record.id, record.payload));
+        const batch = Buffer.concat(buffers);
+        const { bytesWritten } = await this.handle.write(batch, 0, batch.length, this.size);
+        if (bytesWritten !== batch.length) {
+            // Fin de journal incohérente : retour à la dernière position valide
+            await this.handle.truncate(this.size);
+            throw new Error('Écriture incomplète du journal de presets');
+        }
+        await this.handle.datasync();
+        // Index mis à jour seulement une fois les données sur disque
+        let offset = this.size;
+        records.forEach((record, i) => {
+            const idLength = buffers[i].readUInt16LE(9);
+            const dataLength = buffers[i].length - RECORD_HEADER_SIZE - idLength;
+            const dataOffset = offset + RECORD_HEADER_SIZE + idLength;
+            this.apply(record.kind, record.id, dataOffset, dataLength,
+                       crc32(buffers[i], buffers[i].length - dataLength));
+            offset += buffers[i].length;
+        });
+        this.size = offset;
+        this.scheduleCompaction();
+        return true;
+    }
+
+    scheduleCompaction() {
+        if (this.readOnly || this.compactionScheduled || this.deadBytes < COMPACT_MIN_DEAD_BYTES || this.deadBytes < this.liveBytes)
+            return;
+        this.compactionScheduled = true;
+        setImmediate(() => {
+            this.compact()
+                .catch(error => console.error('❌ Compactage du journal de presets:', error))
+                .finally(() => { this.compactionScheduled = false; });
+        });
+    }
+
+    // Réécrit le journal avec les seuls presets vivants (copie binaire, sans JSON.parse)
+    compact() {
+        return this.enqueue(async () => {
+            const buffers = [fileHeader()];
+            const index = new Map();
+            let offset = FILE_HEADER_SIZE;
+            for (const [id, entry] of this.index) {
+                const data = Buffer.alloc(entry.length);
+                await this.handle.read(data, 0, entry.length, entry.offset);
+                const record = encodeRecord(Kind.PUT, id, null);
+                const full = Buffer.concat([record, data]);
+                full.writeUInt32LE(full.length - RECORD_HEADER_SIZE, 0);
+                full.writeUInt32LE(crc32(full, 8), 4);
+                buffers.push(full);
+                index.set(id, { offset: offset + record.length, length: entry.length, crc: entry.crc });
+                offset += full.length;
+            }
+            const before = this.size;
+            await writeFileAtomic(this.logPath, buffers);
+            const previous = this.handle;
+            this.handle = await fs.open(this.logPath, 'r+');
+            this.index = index;
+            await Promise.allSettled(Array.from(this.pendingReads));
+            await previous.close();
+            this.size = offset;
+            this.deadBytes = 0;
+            console.log(`🧹 Journal de presets compacté: ${before} → ${offset} octets`);
+        });
+    }
+
+    async close() {
+        await this.queue;
+        if (this.handle) {
+            await this.handle.close();
+            this.handle = null;
+        }
+    }
+
+    stats() {
+        return {
+            presets: this.index.size,
+            fileBytes: this.size,
+            liveBytes: this.liveBytes,
+            deadBytes: this.deadBytes,
+            readOnly: this.readOnly
+        };
+    }
+}
+
+module.exports = PresetStore;
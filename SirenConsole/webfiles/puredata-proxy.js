@@ -1,4 +1,5 @@
 const WebSocket = require('ws');
+const showClock = require('./show-clock');
 
 // Proxy WebSocket vers PureData - Gestion des connexions multiples
 class PureDataProxy {
@@ -19,6 +20,7 @@ class PureDataProxy {
         this.binaryChunkStates = new Map(); // Accumulation binaire (format SirenePupitre) par pupitre
         this.errorThrottle = new Map(); // Throttling des erreurs par pupitre: { lastError: timestamp, count: number }
         this.messageQueues = new Map(); // File d'attente de messages par pupitre (pour messages critiques)
+        this.onStatusChanged = null; // Callback (pupitreId) à chaque changement de connexion ou d'horloge
         
         // console.log('🎛️ PureDataProxy initialisé pour connexions multiples');
         
@@ -166,6 +168,7 @@ class PureDataProxy {
                 if (connection) {
                     connection.connected = true;
                     connection.lastSeen = new Date();
+                    this.notifyStatusChanged(pupitreId);
                     
                     console.log(`✅ Pupitre ${pupitreId} (${pupitre.name}) connecté sur ${url}`);
                     
@@ -203,6 +206,7 @@ class PureDataProxy {
                 if (connection) {
                     connection.connected = false;
                     connection.lastSeen = null;
+                    this.notifyStatusChanged(pupitreId);
                     
                     // console.log(`❌ Pupitre ${pupitreId} (${pupitre.name}) déconnecté (code: ${code})`);
                     
@@ -227,6 +231,7 @@ class PureDataProxy {
                 if (connection) {
                     connection.connected = false;
                     connection.lastSeen = null;
+                    this.notifyStatusChanged(pupitreId);
                 }
             });
             
@@ -242,9 +247,17 @@ class PureDataProxy {
     
     // Gérer les messages d'un pupitre spécifique
     handleMessage(pupitreId, message) {
+        // Heure de réception relevée avant tout traitement (pings d'horloge)
+        const rxUs = showClock.nowUs();
         const connection = this.connections.get(pupitreId);
         if (!connection) return;
         
+        // Ping d'horloge "MCLK" : réponse immédiate sur la même connexion
+        if (showClock.isClockFrame(message)) {
+            this.handleClockFrame(pupitreId, message, rxUs);
+            return;
+        }
+        
         // Détecter si binaire (Buffer) ou texte (string)
         if (Buffer.isBuffer(message)) {
             this.handleBinaryMessage(pupitreId, message);
@@ -259,6 +272,15 @@ class PureDataProxy {
                 
                 // Traiter CONFIG_FULL depuis PureData (réponse à REQUEST_PUPITRE_CONFIG)
                 if (data.type === 'CONFIG_FULL') {
+                    // Config complète du pupitre telle quelle : base des snapshots MCFG de la console
+                    if (data.config && this.broadcastToClients) {
+                        this.broadcastToClients({
+                            type: 'PUPITRE_CONFIG_FULL',
+                            pupitreId: data.pupitreId || pupitreId,
+                            config: data.config,
+                            timestamp: Date.now()
+                        });
+                    }
                     if (data.config && this.handlePupitreConfig) {
                         const configData = this.convertPureDataConfigToPupitreConfig(data.config, data.pupitreId || pupitreId);
                         this.handlePupitreConfig(data.pupitreId || pupitreId, configData, true);
@@ -304,6 +326,56 @@ class PureDataProxy {
         }
     }
     
+    // Répondre à un ping d'horloge et garder l'estimation rapportée par le pupitre
+    handleClockFrame(pupitreId, buffer, rxUs) {
+        const connection = this.connections.get(pupitreId);
+        const result = showClock.handlePing(buffer, rxUs);
+        if (!connection || !result) return;
+        if (connection.websocket && connection.websocket.readyState === WebSocket.OPEN) {
+            try {
+                connection.websocket.send(result.reply);
+            } catch (error) {
+                return;
+            }
+        }
+        this.recordClockStats(pupitreId, result.stats);
+    }
+    
+    // Estimation d'horloge rapportée par un pupitre (connexion PureData ou client WebAssembly)
+    recordClockStats(pupitreId, stats) {
+        const connection = this.connections.get(pupitreId);
+        if (!connection || !stats) return;
+        connection.clock = stats;
+        this.notifyStatusChanged(pupitreId);
+    }
+    
+    // Prévenir le serveur qu'un champ de getPupitreStatus() a pu changer
+    notifyStatusChanged(pupitreId) {
+        if (this.onStatusChanged) {
+            this.onStatusChanged(pupitreId);
+        }
+    }
+    
+    // Ancre du séquenceur (tick atteint à une heure de spectacle) vers tous les pupitres
+    broadcastClockAnchor(showTimeUs, tick, tempo, ppq, playing) {
+        for (const [pupitreId, connection] of this.connections) {
+            if (!connection.connected || !connection.websocket
+                || connection.websocket.readyState !== WebSocket.OPEN) {
+                continue;
+            }
+            const index = parseInt(String(pupitreId).replace(/^P/, ''), 10) || 0;
+            try {
+                connection.websocket.send(showClock.encodeAnchor(index, showTimeUs, tick, tempo, ppq, playing));
+            } catch (error) {
+                console.error(`❌ Envoi ancre d'horloge échoué pour ${pupitreId}:`, error.message);
+            }
+        }
+        // Pupitres WebAssembly connectés comme clients UI
+        if (this.broadcastBinaryToUIClients) {
+            this.broadcastBinaryToUIClients(showClock.encodeAnchor(0, showTimeUs, tick, tempo, ppq, playing));
+        }
+    }
+    
     // Décoder messages binaires pour un pupitre spécifique
     handleBinaryMessage(pupitreId, buffer) {
         const connection = this.connections.get(pupitreId);
@@ -314,12 +386,20 @@ class PureDataProxy {
             return;
         }
         
+        // Trames de sync de config "MCFG" (ack / demande de resync) : relais brut vers les consoles
+        if (buffer.length >= 6 && buffer.toString('ascii', 0, 4) === 'MCFG') {
+            if (this.broadcastBinaryToUIClients) {
+                this.broadcastBinaryToUIClients(buffer);
+            }
+            return;
+        }
+        
         // Ignorer les messages de 2 bytes qui sont juste des zéros (probablement des heartbeats)
         if (buffer.length === 2 && buffer[0] === 0x00 && buffer[1] === 0x00) {
             return;
         }
         
-        // Vérifier si c'est un message VOLANT_STATE (7 bytes avec magic "SS")
+        // Vérifier si c'est un message VOLANT_STATE (7 bytes avec magic "SS", format: common/protocol/MecavivMessages.h)
         if (buffer.length === 7) {
             const magic1 = buffer.readUInt8(0);
             const magic2 = buffer.readUInt8(1);
@@ -364,7 +444,7 @@ class PureDataProxy {
             }
         }
 
-        // Protocole strict SirenePupitre: header 8 octets (LE) + payload JSON chunk
+        // Protocole strict SirenePupitre: header 8 octets (LE) + payload JSON chunk (ChunkHeader, MecavivMessages.h)
         if (buffer.length >= 8) {
             const totalSize = buffer.readUInt32LE(0);
             const position  = buffer.readUInt32LE(4);
@@ -737,6 +817,22 @@ class PureDataProxy {
         return successCount > 0;
     }
     
+    // Envoi binaire brut (trames de sync de config déjà encodées côté console)
+    sendRawToPupitre(pupitreId, buffer) {
+        const connection = this.connections.get(pupitreId);
+        if (!connection || !connection.connected || !connection.websocket
+            || connection.websocket.readyState !== WebSocket.OPEN) {
+            return false;
+        }
+        try {
+            connection.websocket.send(buffer);
+            return true;
+        } catch (error) {
+            console.error(`❌ sendRawToPupitre échoué pour ${pupitreId}:`, error.message);
+            return false;
+        }
+    }
+    
     // Envoyer une commande à un pupitre spécifique
     sendToPupitre(pupitreId, command) {
         const connection = this.connections.get(pupitreId);
@@ -914,15 +1010,7 @@ class PureDataProxy {
         };
         
         for (const [pupitreId, connection] of this.connections) {
-            const pupitreStatus = {
-                pupitreId: pupitreId,
-                pupitreName: connection.pupitre.name,
-                connected: connection.connected,
-                url: connection.url,
-                lastSeen: connection.lastSeen
-            };
-            
-            status.connections.push(pupitreStatus);
+            status.connections.push(this.getPupitreStatus(pupitreId));
             
             if (connection.connected) {
                 status.connectedCount++;
@@ -932,6 +1020,25 @@ class PureDataProxy {
         return status;
     }
     
+    // Statut d'une seule connexion (même format que getStatus().connections)
+    getPupitreStatus(pupitreId) {
+        const connection = this.connections.get(pupitreId);
+        if (!connection) return null;
+        const clock = connection.connected ? connection.clock : null;
+        return {
+            pupitreId: pupitreId,
+            pupitreName: connection.pupitre.name,
+            connected: connection.connected,
+            url: connection.url,
+            lastSeen: connection.lastSeen,
+            // Horloge de spectacle telle qu'estimée par le pupitre
+            clockSynced: !!(clock && clock.synced),
+            clockOffsetMs: clock ? Math.round(clock.offsetMs * 10) / 10 : 0,
+            clockRttMs: clock ? Math.round(clock.rttMs * 10) / 10 : 0,
+            clockJitterMs: clock ? Math.round(clock.jitterMs * 10) / 10 : 0
+        };
+    }
+    
     // Afficher l'état des connexions dans les logs
     logConnectionStatus() {
         const status = this.getStatus();
@@ -1114,6 +1221,7 @@ class PureDataProxy {
             connected: true,
             lastSeen: new Date()
         });
+        this.notifyStatusChanged(pupitreId);
         
         // Gestionnaires d'événements
         ws.on('close', () => {
@@ -1122,6 +1230,7 @@ class PureDataProxy {
             if (connection) {
                 connection.connected = false;
                 connection.lastSeen = null;
+                this.notifyStatusChanged(pupitreId);
             }
         });
         
@@ -1131,6 +1240,7 @@ class PureDataProxy {
             if (connection) {
                 connection.connected = false;
                 connection.lastSeen = null;
+                this.notifyStatusChanged(pupitreId);
             }
         });
         
@@ -1149,6 +1259,7 @@ class PureDataProxy {
                     // console.log(`❌ Connexion ${pupitreId} fermée détectée`);
                     connection.connected = false;
                     connection.lastSeen = null;
+                    this.notifyStatusChanged(pupitreId);
                     
                     // Programmer une reconnexion
                     this.scheduleReconnect(pupitreId);
@@ -1161,6 +1272,7 @@ class PureDataProxy {
                         // console.log(`❌ Erreur ping ${pupitreId}:`, error.message);
                         connection.connected = false;
                         connection.lastSeen = null;
+                        this.notifyStatusChanged(pupitreId);
                         this.scheduleReconnect(pupitreId);
                     }
                 } else {
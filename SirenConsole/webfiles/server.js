@@ -18,11 +18,17 @@ const midiAPI = require('./api-midi.js');
 const PureDataProxy = require('./puredata-proxy.js');
 
 // Importer l'analyseur MIDI
-const { analyzeMidiFile, createFileInfoBuffer, createTempoBuffer, createTimeSigBuffer } = require('./midi-analyzer.js');
+const { createFileInfoBuffer, createTempoBuffer, createTimeSigBuffer } = require('./midi-analyzer.js');
 
 // Importer le séquenceur MIDI
 const MidiSequencer = require('./midi-sequencer.js');
 
+// Horloge de spectacle partagée avec les pupitres (trames "MCLK")
+const showClock = require('./show-clock.js');
+
+// Mapping preset → chemins de config pupitre, partagé avec la console QML
+const PresetDiff = require('../QML/utils/PresetDiff.js');
+
 // Variables globales
 let lastVolantData = null; // Stocker les dernières données du volant
 
@@ -32,6 +38,49 @@ const syncState = new Map(); // pupitreId -> { isSynced: bool, lastSync: timesta
 // Suivi des demandes de download en cours
 const pendingConfigRequests = new Map(); // pupitreId -> { timestamp, timeout }
 
+// Dernier statut diffusé par pupitre (base des PUPITRE_STATUS_DELTA)
+const lastPupitreStatus = new Map();
+
+// Écart minimal (ms) avant de rediffuser une mesure d'horloge : le bruit du RTT ne génère pas de trafic
+const CLOCK_DELTA_THRESHOLD_MS = 0.5;
+const CLOCK_STATUS_FIELDS = new Set(['clockOffsetMs', 'clockRttMs', 'clockJitterMs']);
+
+function pushPupitreStatusDelta(pupitreId) {
+    const conn = pureDataProxy ? pureDataProxy.getPupitreStatus(pupitreId) : null;
+    if (!conn) return;
+    const syncInfo = syncState.get(pupitreId);
+    const current = {
+        pupitreName: conn.pupitreName,
+        connected: !!conn.connected,
+        isSynced: syncInfo?.isSynced || false,
+        clockSynced: conn.clockSynced,
+        clockOffsetMs: conn.clockOffsetMs,
+        clockRttMs: conn.clockRttMs,
+        clockJitterMs: conn.clockJitterMs
+    };
+    const previous = lastPupitreStatus.get(pupitreId) || {};
+    const fields = {};
+    let changed = false;
+    for (const key of Object.keys(current)) {
+        if (previous[key] === current[key]) continue;
+        if (CLOCK_STATUS_FIELDS.has(key) && previous[key] !== undefined
+            && Math.abs(previous[key] - current[key]) < CLOCK_DELTA_THRESHOLD_MS) {
+            continue;
+        }
+        fields[key] = current[key];
+        changed = true;
+    }
+    if (!changed) return;
+    // Seuls les champs diffusés avancent : une dérive lente finit par dépasser le seuil
+    lastPupitreStatus.set(pupitreId, { ...previous, ...fields });
+    broadcastToClients({
+        type: 'PUPITRE_STATUS_DELTA',
+        pupitreId: pupitreId,
+        fields: fields,
+        timestamp: Date.now()
+    });
+}
+
 function setSyncEnabled(pupitreId, enabled) {
     const current = syncState.get(pupitreId) || { isSynced: false, lastSync: null };
     syncState.set(pupitreId, { isSynced: enabled, lastSync: enabled ? Date.now() : current.lastSync });
@@ -43,6 +92,7 @@ function setSyncEnabled(pupitreId, enabled) {
         isSynced: enabled,
         timestamp: Date.now()
     });
+    pushPupitreStatusDelta(pupitreId);
 }
 
 function isSynced(pupitreId) {
@@ -59,111 +109,20 @@ function getAllSyncedPupitres() {
     return synced;
 }
 
-// Fonctions de mapping Preset ↔ PureData Path
+// Fonctions de mapping Preset ↔ PureData Path : mêmes chemins et même ordre que l'application
+// différentielle de la console (QML/utils/PresetDiff.js)
 function convertPresetToParamUpdates(preset, pupitreId) {
-    const updates = [];
-    if (!preset || !preset.config || !preset.config.pupitres) return updates;
+    if (!preset || !preset.config || !preset.config.pupitres) return [];
     
     const pupitreConfig = preset.config.pupitres.find(p => p.id === pupitreId);
-    if (!pupitreConfig) return updates;
-    
-    // assignedSirenes → ["sirenConfig", "currentSirens"] (convertir en strings pour compatibilité SirenePupitre)
-    if (Array.isArray(pupitreConfig.assignedSirenes)) {
-        updates.push({
-            type: "PARAM_UPDATE",
-            path: ["sirenConfig", "currentSirens"],
-            value: pupitreConfig.assignedSirenes.map(n => String(n)),
-            source: "console"
-        });
-    }
-    
-    // sirenes[sireneN].ambitusRestricted → ["sirenConfig", "sirens", N, "ambitus", "restricted"]
-    // sirenes[sireneN].frettedMode → ["sirenConfig", "sirens", N, "frettedMode", "enabled"]
-    if (pupitreConfig.sirenes) {
-        for (const [key, sireneConfig] of Object.entries(pupitreConfig.sirenes)) {
-            const sireneNum = parseInt(key.replace('sirene', ''), 10);
-            if (isNaN(sireneNum)) continue;
-            const sireneIndex = sireneNum - 1; // 0-based index
-            
-            if (sireneConfig.ambitusRestricted !== undefined) {
-                updates.push({
-                    type: "PARAM_UPDATE",
-                    path: ["sirenConfig", "sirens", sireneIndex, "ambitus", "restricted"],
-                    value: sireneConfig.ambitusRestricted ? 1 : 0,
-                    source: "console"
-                });
-            }
-            
-            if (sireneConfig.frettedMode !== undefined) {
-                updates.push({
-                    type: "PARAM_UPDATE",
-                    path: ["sirenConfig", "sirens", sireneIndex, "frettedMode", "enabled"],
-                    value: sireneConfig.frettedMode ? 1 : 0,
-                    source: "console"
-                });
-            }
-        }
-    }
+    if (!pupitreConfig) return [];
     
-    // vstEnabled/udpEnabled/rtpMidiEnabled → ["outputConfig", "..."]
-    if (pupitreConfig.vstEnabled !== undefined) {
-        updates.push({
-            type: "PARAM_UPDATE",
-            path: ["outputConfig", "vstEnabled"],
-            value: pupitreConfig.vstEnabled ? 1 : 0,
-            source: "console"
-        });
-    }
-    if (pupitreConfig.udpEnabled !== undefined) {
-        updates.push({
-            type: "PARAM_UPDATE",
-            path: ["outputConfig", "udpEnabled"],
-            value: pupitreConfig.udpEnabled ? 1 : 0,
-            source: "console"
-        });
-    }
-    if (pupitreConfig.rtpMidiEnabled !== undefined) {
-        updates.push({
-            type: "PARAM_UPDATE",
-            path: ["outputConfig", "rtpMidiEnabled"],
-            value: pupitreConfig.rtpMidiEnabled ? 1 : 0,
-            source: "console"
-        });
-    }
-    
-    // controllerMapping[ctrl].cc/curve → ["controllerMapping", ctrl, "cc/curve"]
-    if (pupitreConfig.controllerMapping) {
-        for (const [ctrl, mapping] of Object.entries(pupitreConfig.controllerMapping)) {
-            if (mapping.cc !== undefined) {
-                updates.push({
-                    type: "PARAM_UPDATE",
-                    path: ["controllerMapping", ctrl, "cc"],
-                    value: mapping.cc,
-                    source: "console"
-                });
-            }
-            if (mapping.curve) {
-                updates.push({
-                    type: "PARAM_UPDATE",
-                    path: ["controllerMapping", ctrl, "curve"],
-                    value: mapping.curve,
-                    source: "console"
-                });
-            }
-        }
-    }
-    
-    // gameMode → ["gameMode", "enabled"]
-    if (pupitreConfig.gameMode !== undefined) {
-        updates.push({
-            type: "PARAM_UPDATE",
-            path: ["gameMode", "enabled"],
-            value: pupitreConfig.gameMode ? 1 : 0,
-            source: "console"
-        });
-    }
-    
-    return updates;
+    return PresetDiff.pupitreUpdates(pupitreConfig).map(update => ({
+        type: "PARAM_UPDATE",
+        path: update.path,
+        value: update.value,
+        source: "console"
+    }));
 }
 
 function ensureCurrentPreset(data) {
@@ -191,6 +150,11 @@ function ensureCurrentPreset(data) {
 // Fonction helper pour obtenir ou créer un preset courant (async)
 async function getOrCreateCurrentPreset() {
     try {
+        // Lecture directe du preset courant, sans relire toute la bibliothèque
+        if (currentPresetId) {
+            const current = await presetAPI.getPreset(currentPresetId);
+            if (current) return current;
+        }
         const data = await presetAPI.readPresets();
         let preset = ensureCurrentPreset(data);
         
@@ -409,6 +373,170 @@ function frequencyToRpm(frequency, outputs) {
     return frequency * 60 / outputs
 }
 
+// Exécuter une commande console (HTTP /api/puredata/command ou lot WebSocket COMMAND_BATCH)
+function executePureDataCommand(command) {
+    // Traiter les commandes MIDI
+    let success = false;
+    let message = '';
+    
+    if (command.type === 'MIDI_FILE_LOAD' && command.path) {
+        // console.log('📁 MIDI_FILE_LOAD:', command.path);
+        
+        // Construire le chemin complet
+        const fullPath = path.resolve(MIDI_REPO_PATH, command.path);
+        
+        // Charger dans le séquenceur
+        success = midiSequencer.loadFile(fullPath);
+        
+        if (success) {
+            // Mettre à jour le playbackState
+            pureDataProxy.updatePlaybackFile(command.path);
+            
+            // Envoyer le message MIDI_FILE_LOAD à PureData
+            pureDataProxy.sendCommand(command);
+            // console.log('📤 MIDI_FILE_LOAD envoyé à PureData:', command.path);
+            
+            // Pas d'envoi binaire: PureData lit localement; la Console n'envoie que JSON
+            
+            // console.log('✅ Fichier MIDI chargé et métadonnées envoyées');
+            message = 'Fichier chargé';
+        } else {
+            message = 'Erreur chargement fichier';
+        }
+        
+    } else if (command.type === 'MIDI_TRANSPORT') {
+        // console.log('🎵 MIDI_TRANSPORT reçu:', command.action, 'de', command.source || 'unknown');
+        
+        switch (command.action) {
+            case 'play':
+                success = midiSequencer.play();
+                message = success ? 'Lecture démarrée' : 'Impossible de démarrer';
+                break;
+            case 'pause':
+                success = midiSequencer.pause();
+                message = 'Pause';
+                break;
+            case 'stop':
+                // console.log('⏹ Appel midiSequencer.stop()...');
+                success = midiSequencer.stop();
+                message = 'Stop';
+                // console.log('⏹ Stop terminé, success:', success);
+                break;
+            default:
+                message = 'Action inconnue: ' + command.action;
+        }
+        
+        // Relayer aussi à PureData en JSON pour synchronisation
+        if (success) {
+            const state = midiSequencer.getState();
+            command.position = Math.floor(state.beat * midiSequencer.ppq);
+            pureDataProxy.sendCommand(command);
+        }
+        
+    } else if (command.type === 'GAME_MODE') {
+        // console.log('🎮 GAME_MODE reçu:', command.enabled ? 'ACTIVÉ' : 'DÉSACTIVÉ', 'de', command.source || 'unknown');
+        
+        // Relayer à PureData pour qu'il adapte son comportement
+        pureDataProxy.sendCommand(command);
+        
+        success = true;
+        message = command.enabled ? 'Mode jeu activé' : 'Mode jeu désactivé';
+        
+    } else if (command.type === 'MIDI_SEEK' && command.position !== undefined) {
+        // console.log('⏩ MIDI_SEEK:', command.position, 'ms');
+        success = midiSequencer.seek(command.position);
+        
+        // Envoyer aussi à PureData
+        if (success) {
+            pureDataProxy.sendCommand(command);
+            // console.log('📤 Seek envoyé à PureData:', command.position, 'ms');
+        }
+        
+        message = 'Position mise à jour';
+        
+    } else if (command.type === 'TEMPO_CHANGE' && command.tempo) {
+        // console.log('🎼 TEMPO_CHANGE:', command.tempo, 'BPM');
+        success = midiSequencer.setTempo(command.tempo);
+        
+        // Envoyer aussi à PureData pour qu'il soit au courant
+        pureDataProxy.sendCommand(command);
+        // console.log('📤 Tempo envoyé à PureData:', command.tempo, 'BPM');
+        
+        message = 'Tempo changé';
+        
+    } else if (command.type === 'UI_CONTROLS') {
+        // Commande pour contrôler l'affichage UI d'un pupitre
+        const pupitreId = command.pupitreId;
+        const enabled = command.enabled !== undefined ? command.enabled : true;
+        
+        // Format PARAM_UPDATE - comme les autres paramètres
+        const relayCommand = {
+            type: "PARAM_UPDATE",
+            path: ["uiControls", "enabled"],
+            value: enabled ? 1 : 0,
+            source: "console"
+        };
+        
+        // Log dans un fichier séparé pour éviter le spam
+        const fs = require('fs');
+        const logMsg = `[${new Date().toISOString()}] UI_CONTROLS -> PARAM_UPDATE: ${JSON.stringify(relayCommand)}, pupitreId: ${pupitreId || 'all'}\n`;
+        fs.appendFileSync('/tmp/ui-controls.log', logMsg);
+        
+        // Utiliser sendToPupitre() avec pupitreId comme les autres PARAM_UPDATE
+        if (pupitreId) {
+            const sendResult = pureDataProxy.sendToPupitre(pupitreId, relayCommand);
+            fs.appendFileSync('/tmp/ui-controls.log', `[${new Date().toISOString()}] UI_CONTROLS sendToPupitre result: ${sendResult} pour ${pupitreId}\n`);
+            success = sendResult;
+        } else {
+            // Si pas de pupitreId, envoyer à tous via sendCommand()
+            const sendResult = pureDataProxy.sendCommand(relayCommand);
+            fs.appendFileSync('/tmp/ui-controls.log', `[${new Date().toISOString()}] UI_CONTROLS sendCommand result: ${sendResult}\n`);
+            success = sendResult;
+        }
+        message = 'Commande UI envoyée';
+    } else if (command.type === 'AUTONOMY_MODE') {
+        const pupitreId = command.pupitreId;
+        let sent = false;
+        if (pupitreId) {
+            sent = pureDataProxy.sendToPupitre(pupitreId, command);
+        } else {
+            sent = pureDataProxy.sendCommand(command);
+        }
+        // Toujours retourner success=true pour permettre la mise à jour de l'état local
+        // même si le pupitre n'est pas connecté (la commande sera envoyée quand il se connectera)
+        success = true;
+        message = sent ? 'Commande autonomie envoyée' : 'État mis à jour (pupitre non connecté)';
+    } else {
+        // Commande inconnue, envoyer à PureData
+        success = pureDataProxy.sendCommand(command);
+        message = success ? 'Commande envoyée à PureData' : 'PureData non connecté';
+    }
+    
+    return { success, message };
+}
+
+// Lot de commandes reçu sur le WebSocket : exécution dans l'ordre du lot (ordre par pupitre garanti),
+// une seule réponse COMMAND_RESULTS pour tout le lot
+function handleCommandBatch(ws, data) {
+    const commands = Array.isArray(data.commands) ? data.commands : [];
+    // { id, command } : l'id sert à la réponse, seule la commande part vers PureData
+    const results = commands.map(entry => {
+        try {
+            const { success, message } = executePureDataCommand(entry.command || {});
+            return { id: entry.id, success: !!success, message };
+        } catch (e) {
+            return { id: entry.id, success: false, message: e.message };
+        }
+    });
+    if (ws.readyState === WebSocket.OPEN) {
+        ws.send(JSON.stringify({
+            type: 'COMMAND_RESULTS',
+            batchId: data.batchId,
+            results: results
+        }));
+    }
+}
+
 function handleWebSocketConnection(ws, request) {
     // console.log('🔌 Nouvelle connexion WebSocket'); // Désactivé pour éviter le spam
     
@@ -416,6 +544,33 @@ function handleWebSocketConnection(ws, request) {
     ws.on('message', (message) => {
         // Vérifier si c'est un message binaire
         if (Buffer.isBuffer(message)) {
+            // Ping d'horloge "MCLK" (pupitre WebAssembly) : réponse immédiate, puis
+            // estimation rapportée gardée comme pour les pupitres natifs (octet 5 = pupitre)
+            if (showClock.isClockFrame(message)) {
+                const result = showClock.handlePing(message, showClock.nowUs());
+                if (result && ws.readyState === WebSocket.OPEN) {
+                    ws.send(result.reply);
+                }
+                if (result && pureDataProxy) {
+                    const pupitreIndex = message.readUInt8(5);
+                    if (pupitreIndex > 0) {
+                        pureDataProxy.recordClockStats(`P${pupitreIndex}`, result.stats);
+                    }
+                }
+                return;
+            }
+            
+            // Trame de sync de config "MCFG" (snapshot/patch CBOR) : relais brut vers le pupitre ciblé (octet 5)
+            if (message.length >= 6 && message.toString('ascii', 0, 4) === 'MCFG') {
+                if (pureDataProxy) {
+                    const pupitreIndex = message.readUInt8(5);
+                    if (pupitreIndex > 0) {
+                        pureDataProxy.sendRawToPupitre(`P${pupitreIndex}`, message);
+                    }
+                }
+                return
+            }
+            
             // Essayer de convertir en string pour voir si c'est du JSON
             try {
                 const text = message.toString('utf8')
@@ -429,6 +584,13 @@ function handleWebSocketConnection(ws, request) {
                         source: 'SERVER_NODEJS',
                         timestamp: Date.now() 
                     }))
+                } else if (data.type === 'COMMAND_BATCH') {
+                    handleCommandBatch(ws, data)
+                } else if (data.type === 'REQUEST_PUPITRE_CONFIG') {
+                    // Resync MCFG : la console a besoin de la config complète (réponse PUPITRE_CONFIG_FULL)
+                    if (pureDataProxy && data.pupitreId) {
+                        pureDataProxy.requestPupitreConfig(data.pupitreId)
+                    }
                 } else if (data.type === 'SIRENCONSOLE_IDENTIFICATION') {
                     // Ajouter le client à la liste des clients connectés
                     connectedClients.add(ws);
@@ -540,6 +702,9 @@ function handleWebSocketConnection(ws, request) {
                         // console.log('📥 Message SirenConsole reçu:', data.type); // Désactivé pour éviter le spam
                         
                         switch (data.type) {
+                            case 'COMMAND_BATCH':
+                                handleCommandBatch(ws, data);
+                                break;
                             case 'PING':
                                 // PING reçu, renvoyer PONG (sans log pour éviter le spam)
                                 ws.send(JSON.stringify({ 
@@ -641,11 +806,9 @@ function requestHandler(request, response) {
         request.on('end', async () => {
             try {
                 const updatedPreset = JSON.parse(body);
-                const data = await presetAPI.readPresets();
-                const idx = data.presets.findIndex(p => p.id === updatedPreset.id);
-                if (idx === -1) data.presets.push(updatedPreset); else data.presets[idx] = updatedPreset;
+                if (!updatedPreset || !updatedPreset.id) throw new Error('Missing preset id');
                 currentPresetId = updatedPreset.id;
-                await presetAPI.writePresets(data);
+                await presetAPI.putPreset(updatedPreset);
                 response.writeHead(200, { 'Content-Type': 'application/json' });
                 response.end(JSON.stringify({ preset: updatedPreset, currentId: currentPresetId }));
             } catch (e) {
@@ -660,17 +823,17 @@ function requestHandler(request, response) {
         request.on('data', chunk => body += chunk);
         request.on('end', async () => {
             try {
-                const { pupitreId, assignedSirenes } = JSON.parse(body);
+                const { pupitreId, assignedSirenes, relay } = JSON.parse(body);
                 if (!pupitreId) throw new Error('Missing pupitreId');
                 const preset = await getOrCreateCurrentPreset();
                 if (!preset) throw new Error('Impossible de créer un preset par défaut');
-                const data = await presetAPI.readPresets();
                 const p = getOrCreatePupitreEntry(preset, pupitreId);
                 p.assignedSirenes = Array.isArray(assignedSirenes) ? assignedSirenes : [];
-                await presetAPI.writePresets(data);
+                await presetAPI.putPreset(preset);
                 
                 // Envoyer PARAM_UPDATE si synchronisé (utiliser currentSirens en strings pour compatibilité SirenePupitre)
-                if (isSynced(pupitreId) && pureDataProxy) {
+                // relay === false : la console pousse elle-même la valeur en patch MCFG
+                if (relay !== false && isSynced(pupitreId) && pureDataProxy) {
                     const update = {
                         type: "PARAM_UPDATE",
                         path: ["sirenConfig", "currentSirens"],
@@ -694,22 +857,21 @@ function requestHandler(request, response) {
         request.on('data', chunk => body += chunk);
         request.on('end', async () => {
             try {
-                const { pupitreId, sireneId, changes } = JSON.parse(body);
+                const { pupitreId, sireneId, changes, relay } = JSON.parse(body);
                 if (!pupitreId) throw new Error('Missing pupitreId');
                 if (!sireneId) throw new Error('Missing sireneId');
                 const preset = await getOrCreateCurrentPreset();
                 if (!preset) throw new Error('Impossible de créer un preset par défaut');
-                const data = await presetAPI.readPresets();
                 const p = getOrCreatePupitreEntry(preset, pupitreId);
                 if (!p.sirenes) p.sirenes = {};
                 const key = 'sirene' + (typeof sireneId === 'number' ? sireneId : parseInt(sireneId, 10));
                 if (!p.sirenes[key]) p.sirenes[key] = { ambitusRestricted: false, frettedMode: false };
                 const ch = changes || {};
                 Object.keys(ch).forEach(k => { p.sirenes[key][k] = ch[k]; });
-                await presetAPI.writePresets(data);
+                await presetAPI.putPreset(preset);
                 
                 // Envoyer PARAM_UPDATE si synchronisé
-                if (isSynced(pupitreId) && pureDataProxy) {
+                if (relay !== false && isSynced(pupitreId) && pureDataProxy) {
                     const sireneIndex = (typeof sireneId === 'number' ? sireneId : parseInt(sireneId, 10)) - 1;
                     for (const k in ch) {
                         if (k === 'ambitusRestricted') {
@@ -744,18 +906,17 @@ function requestHandler(request, response) {
         request.on('data', chunk => body += chunk);
         request.on('end', async () => {
             try {
-                const { pupitreId, changes } = JSON.parse(body);
+                const { pupitreId, changes, relay } = JSON.parse(body);
                 if (!pupitreId) throw new Error('Missing pupitreId');
                 const preset = await getOrCreateCurrentPreset();
                 if (!preset) throw new Error('Impossible de créer un preset par défaut');
-                const data = await presetAPI.readPresets();
                 const p = getOrCreatePupitreEntry(preset, pupitreId);
                 const ch = changes || {};
                 ['vstEnabled','udpEnabled','rtpMidiEnabled'].forEach(k => { if (k in ch) p[k] = !!ch[k]; });
-                await presetAPI.writePresets(data);
+                await presetAPI.putPreset(preset);
                 
                 // Envoyer PARAM_UPDATE si synchronisé
-                if (isSynced(pupitreId) && pureDataProxy) {
+                if (relay !== false && isSynced(pupitreId) && pureDataProxy) {
                     if ('vstEnabled' in ch) {
                         pureDataProxy.sendToPupitre(pupitreId, {
                             type: "PARAM_UPDATE",
@@ -796,21 +957,20 @@ function requestHandler(request, response) {
         request.on('data', chunk => body += chunk);
         request.on('end', async () => {
             try {
-                const { pupitreId, controller, cc, curve } = JSON.parse(body);
+                const { pupitreId, controller, cc, curve, relay } = JSON.parse(body);
                 if (!pupitreId) throw new Error('Missing pupitreId');
                 if (!controller) throw new Error('Missing controller');
                 const preset = await getOrCreateCurrentPreset();
                 if (!preset) throw new Error('Impossible de créer un preset par défaut');
-                const data = await presetAPI.readPresets();
                 const p = getOrCreatePupitreEntry(preset, pupitreId);
                 if (!p.controllerMapping) p.controllerMapping = {};
                 if (!p.controllerMapping[controller]) p.controllerMapping[controller] = {};
                 if (cc !== undefined) p.controllerMapping[controller].cc = parseInt(cc, 10);
                 if (curve) p.controllerMapping[controller].curve = String(curve);
-                await presetAPI.writePresets(data);
+                await presetAPI.putPreset(preset);
                 
                 // Envoyer PARAM_UPDATE si synchronisé
-                if (isSynced(pupitreId) && pureDataProxy) {
+                if (relay !== false && isSynced(pupitreId) && pureDataProxy) {
                     if (cc !== undefined) {
                         pureDataProxy.sendToPupitre(pupitreId, {
                             type: "PARAM_UPDATE",
@@ -843,17 +1003,16 @@ function requestHandler(request, response) {
         request.on('data', chunk => body += chunk);
         request.on('end', async () => {
             try {
-                const { pupitreId, gameMode } = JSON.parse(body);
+                const { pupitreId, gameMode, relay } = JSON.parse(body);
                 if (!pupitreId) throw new Error('Missing pupitreId');
                 const preset = await getOrCreateCurrentPreset();
                 if (!preset) throw new Error('Impossible de créer un preset par défaut');
-                const data = await presetAPI.readPresets();
                 const p = getOrCreatePupitreEntry(preset, pupitreId);
                 p.gameMode = gameMode !== undefined ? !!gameMode : false;
-                await presetAPI.writePresets(data);
+                await presetAPI.putPreset(preset);
                 
                 // Envoyer PARAM_UPDATE si synchronisé
-                if (isSynced(pupitreId) && pureDataProxy) {
+                if (relay !== false && isSynced(pupitreId) && pureDataProxy) {
                     pureDataProxy.sendToPupitre(pupitreId, {
                         type: "PARAM_UPDATE",
                         path: ["gameMode", "enabled"],
@@ -883,8 +1042,18 @@ function requestHandler(request, response) {
     
     // Endpoint POST /api/presets/current/upload - Envoyer preset vers tous pupitres connectés
     if ((request.url === '/api/presets/current/upload' || request.url.startsWith('/api/presets/current/upload')) && request.method === 'POST') {
-        (async () => {
+        let body = '';
+        request.on('data', chunk => body += chunk);
+        request.on('end', async () => {
             try {
+                // { relay: false } : la console applique le preset par patchs MCFG (ConfigSyncManager),
+                // le serveur se contente de CONSOLE_CONNECT et renvoie le preset
+                let relay = true;
+                try {
+                    relay = body ? JSON.parse(body).relay !== false : true;
+                } catch (e) {
+                    relay = true;
+                }
                 const preset = await getOrCreateCurrentPreset();
                 if (!preset) {
                     response.writeHead(500, { 'Content-Type': 'application/json' });
@@ -911,7 +1080,7 @@ function requestHandler(request, response) {
                             });
                             
                             // Convertir preset en PARAM_UPDATE
-                            const updates = convertPresetToParamUpdates(preset, pupitreId);
+                            const updates = relay ? convertPresetToParamUpdates(preset, pupitreId) : [];
                             
                             // Envoyer tous les updates
                             let successCount = 0;
@@ -941,12 +1110,12 @@ function requestHandler(request, response) {
                 }
                 
                 response.writeHead(200, { 'Content-Type': 'application/json' });
-                response.end(JSON.stringify({ success: true, results }));
+                response.end(JSON.stringify({ success: true, results, preset: relay ? undefined : preset }));
             } catch (e) {
                 response.writeHead(500, { 'Content-Type': 'application/json' });
                 response.end(JSON.stringify({ success: false, error: e.message }));
             }
-        })();
+        });
         return;
     }
     
@@ -1036,7 +1205,7 @@ function requestHandler(request, response) {
     }
     
     // Routes API MIDI
-    if (request.url === '/api/midi/files') {
+    if (request.url === '/api/midi/files' || request.url.startsWith('/api/midi/files?')) {
         midiAPI.getMidiFiles(request, response);
         return;
     }
@@ -1089,145 +1258,7 @@ function requestHandler(request, response) {
             try {
                 const command = JSON.parse(body);
                 
-                // Traiter les commandes MIDI
-                let success = false;
-                let message = '';
-                
-                if (command.type === 'MIDI_FILE_LOAD' && command.path) {
-                    // console.log('📁 MIDI_FILE_LOAD:', command.path);
-                    
-                    // Construire le chemin complet
-                    const fullPath = path.resolve(MIDI_REPO_PATH, command.path);
-                    
-                    // Analyser le fichier MIDI
-                    const midiInfo = analyzeMidiFile(fullPath);
-                    
-                    // Charger dans le séquenceur
-                    success = midiSequencer.loadFile(fullPath);
-                    
-                    if (success) {
-                        // Mettre à jour le playbackState
-                        pureDataProxy.updatePlaybackFile(command.path);
-                        
-                        // Envoyer le message MIDI_FILE_LOAD à PureData
-                        pureDataProxy.sendCommand(command);
-                        // console.log('📤 MIDI_FILE_LOAD envoyé à PureData:', command.path);
-                        
-                        // Pas d'envoi binaire: PureData lit localement; la Console n'envoie que JSON
-                        
-                        // console.log('✅ Fichier MIDI chargé et métadonnées envoyées');
-                        message = 'Fichier chargé';
-                    } else {
-                        message = 'Erreur chargement fichier';
-                    }
-                    
-                } else if (command.type === 'MIDI_TRANSPORT') {
-                    // console.log('🎵 MIDI_TRANSPORT reçu:', command.action, 'de', command.source || 'unknown');
-                    
-                    switch (command.action) {
-                        case 'play':
-                            success = midiSequencer.play();
-                            message = success ? 'Lecture démarrée' : 'Impossible de démarrer';
-                            break;
-                        case 'pause':
-                            success = midiSequencer.pause();
-                            message = 'Pause';
-                            break;
-                        case 'stop':
-                            // console.log('⏹ Appel midiSequencer.stop()...');
-                            success = midiSequencer.stop();
-                            message = 'Stop';
-                            // console.log('⏹ Stop terminé, success:', success);
-                            break;
-                        default:
-                            message = 'Action inconnue: ' + command.action;
-                    }
-                    
-                    // Relayer aussi à PureData en JSON pour synchronisation
-                    if (success) {
-                        const state = midiSequencer.getState();
-                        command.position = Math.floor(state.beat * midiSequencer.ppq);
-                        pureDataProxy.sendCommand(command);
-                    }
-                    
-                } else if (command.type === 'GAME_MODE') {
-                    // console.log('🎮 GAME_MODE reçu:', command.enabled ? 'ACTIVÉ' : 'DÉSACTIVÉ', 'de', command.source || 'unknown');
-                    
-                    // Relayer à PureData pour qu'il adapte son comportement
-                    pureDataProxy.sendCommand(command);
-                    
-                    success = true;
-                    message = command.enabled ? 'Mode jeu activé' : 'Mode jeu désactivé';
-                    
-                } else if (command.type === 'MIDI_SEEK' && command.position !== undefined) {
-                    // console.log('⏩ MIDI_SEEK:', command.position, 'ms');
-                    success = midiSequencer.seek(command.position);
-                    
-                    // Envoyer aussi à PureData
-                    if (success) {
-                        pureDataProxy.sendCommand(command);
-                        // console.log('📤 Seek envoyé à PureData:', command.position, 'ms');
-                    }
-                    
-                    message = 'Position mise à jour';
-                    
-                } else if (command.type === 'TEMPO_CHANGE' && command.tempo) {
-                    // console.log('🎼 TEMPO_CHANGE:', command.tempo, 'BPM');
-                    success = midiSequencer.setTempo(command.tempo);
-                    
-                    // Envoyer aussi à PureData pour qu'il soit au courant
-                    pureDataProxy.sendCommand(command);
-                    // console.log('📤 Tempo envoyé à PureData:', command.tempo, 'BPM');
-                    
-                    message = 'Tempo changé';
-                    
-                } else if (command.type === 'UI_CONTROLS') {
-                    // Commande pour contrôler l'affichage UI d'un pupitre
-                    const pupitreId = command.pupitreId;
-                    const enabled = command.enabled !== undefined ? command.enabled : true;
-                    
-                    // Format PARAM_UPDATE - comme les autres paramètres
-                    const relayCommand = {
-                        type: "PARAM_UPDATE",
-                        path: ["uiControls", "enabled"],
-                        value: enabled ? 1 : 0,
-                        source: "console"
-                    };
-                    
-                    // Log dans un fichier séparé pour éviter le spam
-                    const fs = require('fs');
-                    const logMsg = `[${new Date().toISOString()}] UI_CONTROLS -> PARAM_UPDATE: ${JSON.stringify(relayCommand)}, pupitreId: ${pupitreId || 'all'}\n`;
-                    fs.appendFileSync('/tmp/ui-controls.log', logMsg);
-                    
-                    // Utiliser sendToPupitre() avec pupitreId comme les autres PARAM_UPDATE
-                    if (pupitreId) {
-                        const sendResult = pureDataProxy.sendToPupitre(pupitreId, relayCommand);
-                        fs.appendFileSync('/tmp/ui-controls.log', `[${new Date().toISOString()}] UI_CONTROLS sendToPupitre result: ${sendResult} pour ${pupitreId}\n`);
-                        success = sendResult;
-                    } else {
-                        // Si pas de pupitreId, envoyer à tous via sendCommand()
-                        const sendResult = pureDataProxy.sendCommand(relayCommand);
-                        fs.appendFileSync('/tmp/ui-controls.log', `[${new Date().toISOString()}] UI_CONTROLS sendCommand result: ${sendResult}\n`);
-                        success = sendResult;
-                    }
-                    message = 'Commande UI envoyée';
-                } else if (command.type === 'AUTONOMY_MODE') {
-                    const pupitreId = command.pupitreId;
-                    let sent = false;
-                    if (pupitreId) {
-                        sent = pureDataProxy.sendToPupitre(pupitreId, command);
-                    } else {
-                        sent = pureDataProxy.sendCommand(command);
-                    }
-                    // Toujours retourner success=true pour permettre la mise à jour de l'état local
-                    // même si le pupitre n'est pas connecté (la commande sera envoyée quand il se connectera)
-                    success = true;
-                    message = sent ? 'Commande autonomie envoyée' : 'État mis à jour (pupitre non connecté)';
-                } else {
-                    // Commande inconnue, envoyer à PureData
-                    success = pureDataProxy.sendCommand(command);
-                    message = success ? 'Commande envoyée à PureData' : 'PureData non connecté';
-                }
+                const { success, message } = executePureDataCommand(command);
                 
                 response.writeHead(success ? 200 : 400, { 'Content-Type': 'application/json' });
                 response.end(JSON.stringify({ success, message }));
@@ -1427,8 +1458,7 @@ async function handlePupitreConfigFromPupitre(pupitreId, configData, isRequested
     }
     
     try {
-        const data = await presetAPI.readPresets();
-        let preset = ensureCurrentPreset(data);
+        const preset = await getOrCreateCurrentPreset();
         if (!preset) return;
         
         if (!preset.config) preset.config = { pupitres: [] };
@@ -1487,14 +1517,8 @@ async function handlePupitreConfigFromPupitre(pupitreId, configData, isRequested
             }
         }
         
-        // Mettre à jour dans data.presets
-        const presetIndex = data.presets.findIndex(p => p.id === preset.id);
-        if (presetIndex !== -1) {
-            data.presets[presetIndex] = preset;
-        }
-        
         // Sauvegarder
-        await presetAPI.writePresets(data);
+        await presetAPI.putPreset(preset);
         
         // Forcer refresh UI via WebSocket
         broadcastToClients({
@@ -1514,21 +1538,14 @@ async function handleParamChangedFromPupitre(pupitreId, paramPath, value) {
     if (!isSynced(pupitreId)) return;
     
     try {
-        const data = await presetAPI.readPresets();
-        let preset = ensureCurrentPreset(data);
+        let preset = await getOrCreateCurrentPreset();
         if (!preset) return;
         
         // Convertir PARAM_UPDATE en structure preset
         preset = convertParamUpdateToPreset(paramPath, value, pupitreId, preset);
         
-        // Mettre à jour dans data.presets
-        const presetIndex = data.presets.findIndex(p => p.id === preset.id);
-        if (presetIndex !== -1) {
-            data.presets[presetIndex] = preset;
-        }
-        
         // Sauvegarder
-        await presetAPI.writePresets(data);
+        await presetAPI.putPreset(preset);
         
         // Forcer refresh UI via WebSocket
         broadcastToClients({
@@ -1563,26 +1580,9 @@ presetAPI.initializePresetAPI().then(() => {
     
     // Intégrer avec le proxy PureData pour diffuser les événements
     if (pureDataProxy) {
-        // Écouter les changements de statut des pupitres
-           setInterval(() => {
-               const status = pureDataProxy.getStatus();
-               // Ajouter les informations de synchronisation à chaque connexion
-               if (status.connections) {
-                   status.connections = status.connections.map(conn => {
-                       const syncInfo = syncState.get(conn.pupitreId);
-                       return {
-                           ...conn,
-                           isSynced: syncInfo?.isSynced || false,
-                           lastSync: syncInfo?.lastSync || null
-                       };
-                   });
-               }
-               broadcastToClients({
-                   type: 'PUPITRE_STATUS_UPDATE',
-                   data: status,
-                   timestamp: Date.now()
-               });
-           }, 1000); // Diffuser toutes les secondes
+        // Changements de statut des pupitres signalés par le proxy (connexion, horloge) :
+        // seuls les champs modifiés sont poussés, l'état complet est envoyé par INITIAL_STATUS
+        pureDataProxy.onStatusChanged = pushPupitreStatusDelta;
         
         // Le proxy PureData gère les connexions vers les pupitres
         // Désactiver tous les logs du proxy pour éviter le spam
@@ -0,0 +1,95 @@
+const { performance } = require('perf_hooks');
+
+/**
+ * Horloge de spectacle (trames "MCLK") : le serveur est la référence de temps
+ * des pupitres. Chaque pupitre envoie des pings horodatés avec son horloge locale,
+ * le serveur répond immédiatement avec ses heures de réception et d'émission ;
+ * le pupitre en déduit décalage, aller-retour et dérive (voir SirenePupitre/showclock.h).
+ *
+ * Trame : [0..3] "MCLK", [4] type, [5] pupitre (1..7, 0 = non précisé)
+ *   Ping   pupitre → serveur : t0 i64, offset i64, rtt u32, jitter u32, drift i32 (ppb), flags u8
+ *   Pong   serveur → pupitre : t0 i64 (écho), t1 i64 (réception), t2 i64 (émission)
+ *   Anchor serveur → pupitre : showTime i64, tick u32, tempo u32 (µs/noire), ppq u16, flags u8
+ * Entiers little-endian, temps en microsecondes depuis l'epoch.
+ */
+
+const MAGIC = 'MCLK';
+const HEADER_SIZE = 6;
+const Kind = {
+    PING: 1,
+    PONG: 2,
+    ANCHOR: 3
+};
+const PING_SIZE = HEADER_SIZE + 8 + 8 + 4 + 4 + 4 + 1;
+
+// Heure de spectacle en µs : horloge monotone ancrée sur l'epoch au démarrage du processus
+function nowUs() {
+    return Math.round((performance.timeOrigin + performance.now()) * 1000);
+}
+
+// Conversion d'un instant performance.now() (ms) en heure de spectacle (µs)
+function performanceToUs(perfMs) {
+    return Math.round((performance.timeOrigin + perfMs) * 1000);
+}
+
+function isClockFrame(buffer) {
+    return Buffer.isBuffer(buffer) && buffer.length >= HEADER_SIZE && buffer.toString('ascii', 0, 4) === MAGIC;
+}
+
+function writeHeader(buffer, kind, pupitre) {
+    buffer.write(MAGIC, 0, 'ascii');
+    buffer.writeUInt8(kind, 4);
+    buffer.writeUInt8(pupitre & 0xFF, 5);
+}
+
+/**
+ * Répondre à un ping. rxUs = heure de réception relevée le plus tôt possible.
+ * Retourne { reply, stats } ou null si la trame n'est pas un ping valide ;
+ * stats = estimation rapportée par le pupitre sur son propre décalage.
+ */
+function handlePing(buffer, rxUs) {
+    if (!isClockFrame(buffer) || buffer.readUInt8(4) !== Kind.PING || buffer.length < PING_SIZE) {
+        return null;
+    }
+    const pupitre = buffer.readUInt8(5);
+    const reply = Buffer.allocUnsafe(HEADER_SIZE + 24);
+    writeHeader(reply, Kind.PONG, pupitre);
+    // t0 renvoyé tel quel (horloge du pupitre, pas de conversion)
+    buffer.copy(reply, HEADER_SIZE, HEADER_SIZE, HEADER_SIZE + 8);
+    reply.writeBigInt64LE(BigInt(rxUs), HEADER_SIZE + 8);
+    reply.writeBigInt64LE(BigInt(nowUs()), HEADER_SIZE + 16);
+
+    const stats = {
+        offsetMs: Number(buffer.readBigInt64LE(HEADER_SIZE + 8)) / 1000,
+        rttMs: buffer.readUInt32LE(HEADER_SIZE + 16) / 1000,
+        jitterMs: buffer.readUInt32LE(HEADER_SIZE + 20) / 1000,
+        driftPpm: buffer.readInt32LE(HEADER_SIZE + 24) / 1000,
+        synced: (buffer.readUInt8(HEADER_SIZE + 28) & 0x01) !== 0
+    };
+    return { reply, stats };
+}
+
+/**
+ * Ancre du séquenceur : le tick `tick` est atteint à l'heure de spectacle showTimeUs,
+ * la position avance ensuite à `tempo` µs par noire (ppq ticks par noire).
+ */
+function encodeAnchor(pupitre, showTimeUs, tick, tempo, ppq, playing) {
+    const buffer = Buffer.allocUnsafe(HEADER_SIZE + 19);
+    writeHeader(buffer, Kind.ANCHOR, pupitre);
+    buffer.writeBigInt64LE(BigInt(Math.round(showTimeUs)), HEADER_SIZE);
+    // Tick arrondi : une position fractionnaire tronquée retarderait l'ancre jusqu'à un tick
+    buffer.writeUInt32LE(Math.max(0, Math.round(tick)) >>> 0, HEADER_SIZE + 8);
+    buffer.writeUInt32LE(Math.max(1, Math.round(tempo)) >>> 0, HEADER_SIZE + 12);
+    buffer.writeUInt16LE(Math.max(1, Math.min(0xFFFF, ppq)), HEADER_SIZE + 16);
+    buffer.writeUInt8(playing ? 0x01 : 0x00, HEADER_SIZE + 18);
+    return buffer;
+}
+
+module.exports = {
+    Kind,
+    nowUs,
+    performanceToUs,
+    isClockFrame,
+    handlePing,
+    encodeAnchor
+};
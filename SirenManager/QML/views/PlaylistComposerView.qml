@@ -1,15 +1,175 @@
 import QtQuick
 import QtQuick.Controls
+import QtQuick.Layouts
+import SirenManager
 
 Rectangle {
+    id: root
     color: "#1e1e1e"
-    
-    Text {
-        anchors.centerIn: parent
-        text: "PlaylistComposerView - Compositeur de playlists"
-        color: "white"
-        font.pixelSize: 24
+
+    property int selectedMachine: 0
+    property var midiFiles: []
+    property var playlistFiles: []
+    property var statuses: []
+    // Listages des 13 machines : cache affiché tout de suite, rafraîchi en parallèle.
+    // Singleton partagé avec les autres vues (sessions et cache communs)
+    readonly property var machineLabels: RemoteFileIndex.machineNames
+
+    Connections {
+        target: RemoteFileIndex
+        function onFilesChanged(machine) {
+            if (machine === root.selectedMachine)
+                root.updateFiles()
+        }
+        function onMachineStatusChanged(machine) {
+            root.updateStatus(machine)
+        }
     }
-}
 
+    function updateFiles() {
+        midiFiles = RemoteFileIndex.files(selectedMachine, RemoteFileIndex.Midi)
+        playlistFiles = RemoteFileIndex.files(selectedMachine, RemoteFileIndex.Playlist)
+    }
+
+    function updateStatus(machine) {
+        var list = statuses.slice()
+        list[machine] = RemoteFileIndex.machineStatus(machine)
+        statuses = list
+    }
+
+    function formatSize(bytes) {
+        if (bytes >= 1048576)
+            return (bytes / 1048576).toFixed(1) + " Mo"
+        if (bytes >= 1024)
+            return (bytes / 1024).toFixed(1) + " ko"
+        return bytes + " o"
+    }
+
+    onSelectedMachineChanged: updateFiles()
+
+    Component.onCompleted: {
+        var list = []
+        for (var i = 0; i < machineLabels.length; i++)
+            list.push(RemoteFileIndex.machineStatus(i))
+        statuses = list
+        updateFiles()
+        RemoteFileIndex.refreshAll()
+    }
+
+    RowLayout {
+        anchors.fill: parent
+        anchors.margins: 10
+        spacing: 10
+
+        // Machines
+        ColumnLayout {
+            Layout.preferredWidth: 220
+            Layout.fillHeight: true
+            spacing: 6
+
+            RowLayout {
+                Layout.fillWidth: true
+
+                Button {
+                    text: "Rafraîchir"
+                    enabled: !RemoteFileIndex.busy
+                    onClicked: RemoteFileIndex.refreshAll()
+                }
 
+                BusyIndicator {
+                    running: RemoteFileIndex.busy
+                    Layout.preferredWidth: 28
+                    Layout.preferredHeight: 28
+                }
+            }
+
+            ListView {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                clip: true
+                model: root.machineLabels.length
+                spacing: 2
+
+                delegate: Rectangle {
+                    required property int index
+                    readonly property var status: root.statuses[index] || ({})
+                    width: ListView.view.width
+                    height: 40
+                    radius: 4
+                    color: index === root.selectedMachine ? "#3a3a3a" : "#2a2a2a"
+
+                    Column {
+                        anchors.verticalCenter: parent.verticalCenter
+                        anchors.left: parent.left
+                        anchors.leftMargin: 8
+
+                        Text {
+                            text: root.machineLabels[index]
+                            color: status.lastError ? "#e06060" : "#FFFFFF"
+                            font.pixelSize: 14
+                        }
+
+                        Text {
+                            text: status.refreshing ? "Listage..."
+                                : status.lastError ? status.lastError
+                                : (status.midiCount || 0) + " MIDI, " + (status.playlistCount || 0) + " listes"
+                            color: "#888888"
+                            font.pixelSize: 11
+                        }
+                    }
+
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: root.selectedMachine = index
+                    }
+                }
+            }
+        }
+
+        // Fichiers MIDI et listes de lecture de la machine sélectionnée
+        Repeater {
+            model: [
+                { title: "Fichiers MIDI", files: root.midiFiles },
+                { title: "Listes de lecture", files: root.playlistFiles }
+            ]
+
+            ColumnLayout {
+                required property var modelData
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                spacing: 6
+
+                Text {
+                    text: modelData.title + " (" + modelData.files.length + ")"
+                    color: "#FFFFFF"
+                    font.pixelSize: 16
+                    font.bold: true
+                }
+
+                ListView {
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+                    clip: true
+                    model: modelData.files
+
+                    delegate: RowLayout {
+                        required property var modelData
+                        width: ListView.view.width
+
+                        Text {
+                            Layout.fillWidth: true
+                            text: modelData.name
+                            color: "#FFFFFF"
+                            elide: Text.ElideRight
+                        }
+
+                        Text {
+                            text: root.formatSize(modelData.size)
+                            color: "#888888"
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
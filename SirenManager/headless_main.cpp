@@ -0,0 +1,210 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QSocketNotifier>
+#include <cstdio>
+#include "src/UdpController.h"
+#include "src/CommandProcessor.h"
+#include "src/Show/CueEngine.h"
+#include "MecavivLog.h"
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+// Moteur SirenManager sans interface : mêmes classes que l'application QML
+// (UdpController, SirenConfig), pilotées par commandes texte sur stdin, un socket
+// local ou des fichiers de scène. Pensé pour tourner en service sur la machine
+// Linux maître et pour rejouer des scènes contre un simulateur UDP local.
+
+MECAVIV_LOG_CATEGORY(lcHeadless, "Headless", MecavivLog::Level::Info)
+
+namespace {
+void writeStdout(const QString &line)
+{
+    const QByteArray bytes = line.toUtf8() + '\n';
+    std::fwrite(bytes.constData(), 1, size_t(bytes.size()), stdout);
+    std::fflush(stdout);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("SirenManager");
+    app.setApplicationVersion("1.0.0");
+    app.setOrganizationName("Mecaviv");
+    app.setOrganizationDomain("mecaviv.com");
+
+    // Niveaux MecavivLog : MECAVIV_LOG="UDP=debug,*=warn", MECAVIV_LOG_FILE=...
+    MecavivLog::configureFromEnvironment();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("SirenManager sans interface (commandes texte, `help` pour la liste)"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption socketOption(QStringLiteral("socket"),
+        QStringLiteral("Écoute les commandes sur le socket local <nom> (reste actif après la fin de stdin)."),
+        QStringLiteral("nom"));
+    const QCommandLineOption sceneOption(QStringLiteral("scene"),
+        QStringLiteral("Exécute le fichier de scène <fichier> au démarrage (répétable)."),
+        QStringLiteral("fichier"));
+    const QCommandLineOption noStdinOption(QStringLiteral("no-stdin"),
+        QStringLiteral("Ignore l'entrée standard (service)."));
+    const QCommandLineOption addressOption(QStringLiteral("address"),
+        QStringLiteral("Envoie toutes les commandes à <ip> au lieu des IP des machines (simulateur local)."),
+        QStringLiteral("ip"));
+    const QCommandLineOption portOption(QStringLiteral("port"),
+        QStringLiteral("Port UDP des machines (défaut 4443)."),
+        QStringLiteral("port"));
+    const QCommandLineOption receivePortOption(QStringLiteral("receive-port"),
+        QStringLiteral("Port UDP local de réception (défaut 4444)."),
+        QStringLiteral("port"));
+    const QCommandLineOption targetOption(QStringLiteral("target"),
+        QStringLiteral("Machine par défaut des commandes (défaut maitre)."),
+        QStringLiteral("machine"));
+    const QCommandLineOption showOption(QStringLiteral("show"),
+        QStringLiteral("Charge et joue le spectacle <fichier> (timeline de cues JSON)."),
+        QStringLiteral("fichier"));
+    const QCommandLineOption dryRunOption(QStringLiteral("dry-run"),
+        QStringLiteral("Déroule le spectacle sans rien envoyer (répétition, CI)."));
+    parser.addOptions({ socketOption, sceneOption, noStdinOption, addressOption,
+                        portOption, receivePortOption, targetOption, showOption, dryRunOption });
+    parser.process(app);
+
+    UdpController udp;
+    if (parser.isSet(addressOption))
+        udp.setAddressOverride(parser.value(addressOption));
+    if (parser.isSet(portOption))
+        udp.setPort(parser.value(portOption).toInt());
+    if (parser.isSet(receivePortOption))
+        udp.setReceivePort(parser.value(receivePortOption).toInt());
+    udp.initialize();
+
+    CommandProcessor processor(&udp);
+    if (parser.isSet(targetOption)) {
+        MachineType machine;
+        if (!CommandProcessor::parseMachine(parser.value(targetOption), &machine)) {
+            std::fprintf(stderr, "Machine inconnue: %s\n", qPrintable(parser.value(targetOption)));
+            return 2;
+        }
+        processor.setDefaultMachine(machine);
+    }
+    CueEngine cueEngine;
+    cueEngine.setUdpController(&udp);
+    cueEngine.setDryRun(parser.isSet(dryRunOption));
+    processor.setCueEngine(&cueEngine);
+    QObject::connect(&cueEngine, &CueEngine::finished, [&cueEngine]() {
+        writeStdout(QStringLiteral("show terminé: %1 commandes, %2 en retard, latence moyenne %3 µs, p99 %4 µs, max %5 µs")
+                        .arg(cueEngine.dispatched())
+                        .arg(cueEngine.lateCount())
+                        .arg(cueEngine.latencyMeanUs(), 0, 'f', 1)
+                        .arg(cueEngine.latencyP99Us(), 0, 'f', 1)
+                        .arg(cueEngine.latencyMaxUs(), 0, 'f', 1));
+    });
+    QObject::connect(&processor, &CommandProcessor::quitRequested, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+    QObject::connect(&udp, &UdpController::errorOccurred, [](const QString &error) {
+        mlogWarn(lcHeadless) << error;
+    });
+
+    // Sans socket local, le processus s'arrête quand stdin et les scènes sont terminés
+    QLocalServer *server = nullptr;
+    if (parser.isSet(socketOption)) {
+        const QString name = parser.value(socketOption);
+        server = new QLocalServer(&app);
+        server->setSocketOptions(QLocalServer::UserAccessOption);
+        QLocalServer::removeServer(name);  // socket laissé par une instance précédente
+        if (!server->listen(name)) {
+            std::fprintf(stderr, "Socket local %s indisponible: %s\n",
+                         qPrintable(name), qPrintable(server->errorString()));
+            return 1;
+        }
+        QObject::connect(server, &QLocalServer::newConnection, [server, &processor]() {
+            while (QLocalSocket *client = server->nextPendingConnection()) {
+                QPointer<QLocalSocket> guard(client);
+                const int session = processor.openSession(QStringLiteral("socket"), [guard](const QString &line) {
+                    if (guard)
+                        guard->write(line.toUtf8() + '\n');
+                });
+                QObject::connect(client, &QLocalSocket::readyRead, client, [client, session, &processor]() {
+                    while (client->canReadLine())
+                        processor.feed(session, QString::fromUtf8(client->readLine()));
+                });
+                QObject::connect(client, &QLocalSocket::disconnected, client, [client, session, &processor]() {
+                    processor.closeSession(session);
+                    client->deleteLater();
+                });
+            }
+        });
+        mlogInfo(lcHeadless) << "Commandes sur le socket local" << server->fullServerName();
+    }
+    if (!server) {
+        // Fin quand plus aucune session n'est ouverte et que le spectacle est arrêté
+        auto quitWhenDone = [&processor, &cueEngine, &app]() {
+            if (processor.activeSessionCount() == 0 && cueEngine.state() == CueEngine::Stopped)
+                QMetaObject::invokeMethod(&app, &QCoreApplication::quit, Qt::QueuedConnection);
+        };
+        QObject::connect(&processor, &CommandProcessor::idle, quitWhenDone);
+        QObject::connect(&cueEngine, &CueEngine::stateChanged, quitWhenDone);
+    }
+
+    if (parser.isSet(showOption)) {
+        if (!cueEngine.load(parser.value(showOption))) {
+            std::fprintf(stderr, "Spectacle illisible: %s\n", qPrintable(cueEngine.lastError()));
+            return 1;
+        }
+        cueEngine.play();
+    }
+
+    for (const QString &path : parser.values(sceneOption)) {
+        QString error;
+        if (processor.runScene(path, writeStdout, &error) < 0) {
+            std::fprintf(stderr, "Scène illisible: %s\n", qPrintable(error));
+            return 1;
+        }
+    }
+
+    bool readStdin = !parser.isSet(noStdinOption);
+#ifdef Q_OS_UNIX
+    // Ligne de stdin incomplète, jusqu'au prochain '\n' (vit jusqu'à la fin de app.exec())
+    QByteArray pendingStdin;
+    if (readStdin) {
+        const int session = processor.openSession(QStringLiteral("stdin"), writeStdout);
+        auto *notifier = new QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read, &app);
+        QObject::connect(notifier, &QSocketNotifier::activated, [notifier, &pending = pendingStdin, session, &processor]() {
+            char buffer[4096];
+            const ssize_t size = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (size <= 0) {
+                // Fin de stdin : les commandes déjà reçues (et leurs wait) vont à leur terme
+                notifier->setEnabled(false);
+                if (!pending.isEmpty())
+                    processor.feed(session, QString::fromUtf8(pending));
+                pending.clear();
+                processor.closeSession(session);
+                return;
+            }
+            pending.append(buffer, int(size));
+            int newline;
+            while ((newline = pending.indexOf('\n')) >= 0) {
+                const QByteArray line = pending.left(newline);
+                pending.remove(0, newline + 1);
+                processor.feed(session, QString::fromUtf8(line));
+            }
+        });
+    }
+#else
+    if (readStdin) {
+        mlogWarn(lcHeadless) << "Lecture de stdin non prise en charge sur cette plateforme, utiliser --socket ou --scene";
+        readStdin = false;
+    }
+#endif
+
+    if (!server && processor.activeSessionCount() == 0 && !cueEngine.isPlaying()) {
+        // Ni stdin, ni socket, ni scène, ni spectacle : rien à faire
+        parser.showHelp(1);
+    }
+
+    return app.exec();
+}
@@ -7,6 +7,9 @@
 #include "src/UdpController.h"
 #include "src/PlaylistManager.h"
 #include "src/Models/PlaylistModel.h"
+#include "src/Show/CueEngine.h"
+#include "src/Remote/RemoteFileIndex.h"
+#include "LogQml.h"
 
 int main(int argc, char *argv[])
 {
@@ -18,10 +21,19 @@ int main(int argc, char *argv[])
     app.setOrganizationName("Mecaviv");
     app.setOrganizationDomain("mecaviv.com");
 
+    // Niveaux MecavivLog : MECAVIV_LOG="UDP=debug,*=warn", MECAVIV_LOG_FILE=...
+    MecavivLog::configureFromEnvironment();
+
     // Enregistrer les types QML
     qmlRegisterType<UdpController>("SirenManager", 1, 0, "UdpController");
     qmlRegisterType<PlaylistManager>("SirenManager", 1, 0, "PlaylistManager");
     qmlRegisterType<PlaylistModel>("SirenManager", 1, 0, "PlaylistModel");
+    qmlRegisterType<CueEngine>("SirenManager", 1, 0, "CueEngine");
+    // Index partagé par toutes les vues (sessions SSH et cache) ; créé avant le moteur
+    // QML pour lui survivre
+    RemoteFileIndex remoteFileIndex;
+    qmlRegisterSingletonInstance("SirenManager", 1, 0, "RemoteFileIndex", &remoteFileIndex);
+    LogQml::registerQmlType("SirenManager", 1, 0);
 
     // Créer le moteur QML
     QQmlApplicationEngine engine;
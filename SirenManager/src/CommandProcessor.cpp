@@ -0,0 +1,500 @@
+#include "CommandProcessor.h"
+#include "UdpController.h"
+#include "Config/SirenConfig.h"
+#include "Show/CueEngine.h"
+#include "MecavivLog.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QTimer>
+
+MECAVIV_LOG_CATEGORY(lcCommand, "Command", MecavivLog::Level::Info)
+
+namespace {
+// Garde-fou contre les inclusions récursives d'un même fichier
+constexpr int kMaxIncludes = 64;
+// Commande + 6 octets : un paquet UDP porte 7 octets utiles
+constexpr int kMaxRawData = 6;
+
+const char *const kHelp[] = {
+    "start|stop|reset|synchro [machine]",
+    "newlist <index> [machine]",
+    "boucle|reverse|mute on|off [machine]",
+    "speed|transpo <valeur> [machine]",
+    "volume <valeur> [machine]   (sans machine : volume général)",
+    "raw <cmd> [octets...] [@machine]",
+    "target <machine>",
+    "wait <ms> | include <fichier> | scene <fichier> | scene stop",
+    "monitor on|off | status | help | quit",
+    "show load <fichier> | play | pause | resume | stop | seek <ms> | cue <n|nom> | dryrun on|off | status",
+    "machines : maitre, clic, s1..s7, voiturea, voitureb, pavillon1, pavillon2 ou numéro",
+};
+
+bool parseNumber(const QString &text, int *value)
+{
+    bool ok = false;
+    *value = text.startsWith(QLatin1String("0x"), Qt::CaseInsensitive)
+            ? text.mid(2).toInt(&ok, 16)
+            : text.toInt(&ok, 10);
+    return ok;
+}
+
+bool parseByte(const QString &text, int *value)
+{
+    // Valeurs signées acceptées (transpo) : envoyées en complément à deux
+    return parseNumber(text, value) && *value >= -128 && *value <= 255;
+}
+
+bool parseSwitch(const QString &text, bool *value)
+{
+    const QString lower = text.toLower();
+    if (lower == QLatin1String("on") || lower == QLatin1String("1") || lower == QLatin1String("true")) {
+        *value = true;
+        return true;
+    }
+    if (lower == QLatin1String("off") || lower == QLatin1String("0") || lower == QLatin1String("false")) {
+        *value = false;
+        return true;
+    }
+    return false;
+}
+}
+
+CommandProcessor::CommandProcessor(UdpController *udp, QObject *parent)
+    : QObject(parent)
+    , m_udp(udp)
+    , m_cueEngine(nullptr)
+    , m_defaultMachine(MachineType::LinuxMaitre)
+    , m_nextSession(1)
+{
+    connect(m_udp, &UdpController::dataReceived, this, &CommandProcessor::onDataReceived);
+}
+
+CommandProcessor::~CommandProcessor()
+{
+    qDeleteAll(m_sessions);
+}
+
+bool CommandProcessor::parseMachine(const QString &text, MachineType *machine)
+{
+    return SirenConfig::machineTypeFromString(text, machine);
+}
+
+int CommandProcessor::openSession(const QString &name, ReplyHandler reply)
+{
+    const int id = m_nextSession++;
+    Session *session = new Session;
+    session->name = name;
+    session->baseDir = QDir::currentPath();
+    session->reply = std::move(reply);
+    session->waitTimer = new QTimer(this);
+    session->waitTimer->setSingleShot(true);
+    connect(session->waitTimer, &QTimer::timeout, this, [this, id]() { drain(id); });
+    m_sessions.insert(id, session);
+    mlogDebug(lcCommand) << "Session ouverte" << id << name;
+    return id;
+}
+
+void CommandProcessor::feed(int session, const QString &line)
+{
+    Session *s = m_sessions.value(session);
+    if (!s)
+        return;
+    s->queue.append(line);
+    drain(session);
+}
+
+void CommandProcessor::closeSession(int session)
+{
+    Session *s = m_sessions.value(session);
+    if (!s)
+        return;
+    s->closing = true;
+    drain(session);
+}
+
+int CommandProcessor::runScene(const QString &path, ReplyHandler reply, QString *error)
+{
+    QStringList lines;
+    if (!readScript(path, &lines, error))
+        return -1;
+
+    const QFileInfo info(path);
+    // Dans une scène seules les erreurs remontent au client ; il est prévenu à la fin
+    const QString name = info.fileName();
+    const int id = openSession(QStringLiteral("scene:") + name, [reply, name](const QString &message) {
+        if (message.startsWith(QLatin1String("error")))
+            reply(name + QLatin1String(": ") + message);
+    });
+    Session *session = m_sessions.value(id);
+    session->baseDir = info.absolutePath();
+    session->owner = std::move(reply);
+    session->scene = true;
+    session->closing = true;
+    session->queue = lines;
+    mlogInfo(lcCommand) << "Scène" << name << "lancée (" << lines.size() << "lignes)";
+    // Démarrage différé : la réponse à `scene` part avant les premières commandes
+    QTimer::singleShot(0, this, [this, id]() { drain(id); });
+    return id;
+}
+
+void CommandProcessor::onDataReceived(const QByteArray &data, const QString &fromAddress, int fromPort)
+{
+    const QString line = QStringLiteral("rx %1:%2 %3")
+            .arg(fromAddress)
+            .arg(fromPort)
+            .arg(QString::fromLatin1(data.toHex(' ')));
+    for (Session *session : std::as_const(m_sessions)) {
+        if (session->monitor)
+            session->reply(line);
+    }
+}
+
+void CommandProcessor::drain(int id)
+{
+    for (;;) {
+        Session *session = m_sessions.value(id);
+        if (!session || session->waitTimer->isActive())
+            return;
+        if (session->queue.isEmpty()) {
+            if (session->closing)
+                finish(id);
+            return;
+        }
+        const QString line = session->queue.takeFirst();
+        const int wait = execute(id, line);
+        if (wait > 0) {
+            // La commande a pu terminer sa propre session (scene stop)
+            session = m_sessions.value(id);
+            if (session)
+                session->waitTimer->start(wait);
+            return;
+        }
+    }
+}
+
+void CommandProcessor::finish(int id)
+{
+    Session *session = m_sessions.take(id);
+    if (!session)
+        return;
+    delete session->waitTimer;
+    if (session->scene && session->owner)
+        session->owner(QStringLiteral("ok scene %1 terminée").arg(session->name.mid(6)));
+    mlogDebug(lcCommand) << "Session fermée" << id << session->name;
+    delete session;
+    emit sessionFinished(id);
+    if (m_sessions.isEmpty())
+        emit idle();
+}
+
+bool CommandProcessor::readScript(const QString &path, QStringList *lines, QString *error) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error)
+            *error = QStringLiteral("%1: %2").arg(path, file.errorString());
+        return false;
+    }
+    QTextStream stream(&file);
+    while (!stream.atEnd())
+        lines->append(stream.readLine());
+    return true;
+}
+
+int CommandProcessor::execute(int id, const QString &line)
+{
+    Session *session = m_sessions.value(id);
+    const QString trimmed = line.trimmed();
+    if (!session || trimmed.isEmpty() || trimmed.startsWith(QLatin1Char('#')))
+        return 0;
+
+    static const QRegularExpression separator(QStringLiteral("\\s+"));
+    QStringList args = trimmed.split(separator, Qt::SkipEmptyParts);
+    const QString command = args.takeFirst().toLower();
+    // Copie : la session peut disparaître pendant la commande
+    const ReplyHandler reply = session->reply;
+    const QString baseDir = session->baseDir;
+
+    auto ok = [&reply](const QString &detail = QString()) {
+        reply(detail.isEmpty() ? QStringLiteral("ok") : QStringLiteral("ok ") + detail);
+    };
+    auto fail = [&reply, &trimmed](const QString &message) {
+        reply(QStringLiteral("error ") + message);
+        mlogDebug(lcCommand) << "Commande refusée:" << trimmed << "-" << message;
+    };
+    // Machine en argument optionnel à la position `index`, sinon la cible par défaut
+    auto machineAt = [this, &args](int index, MachineType *machine) {
+        if (index >= args.size()) {
+            *machine = m_defaultMachine;
+            return true;
+        }
+        return index == args.size() - 1 && parseMachine(args.at(index), machine);
+    };
+    auto resolve = [&baseDir](const QString &path) {
+        return QFileInfo(path).isAbsolute() ? path : QDir(baseDir).filePath(path);
+    };
+
+    MachineType machine = m_defaultMachine;
+    int value = 0;
+    bool enabled = false;
+
+    if (command == QLatin1String("start") || command == QLatin1String("stop")
+            || command == QLatin1String("reset") || command == QLatin1String("synchro")) {
+        if (!machineAt(0, &machine)) {
+            fail(QStringLiteral("machine inconnue"));
+            return 0;
+        }
+        if (command == QLatin1String("start"))
+            m_udp->sendStart(machine);
+        else if (command == QLatin1String("stop"))
+            m_udp->sendStop(machine);
+        else if (command == QLatin1String("reset"))
+            m_udp->sendReset(machine);
+        else
+            m_udp->sendAskSynchro(machine);
+        ok();
+    } else if (command == QLatin1String("newlist")) {
+        if (args.isEmpty() || !parseByte(args.at(0), &value) || value < 0) {
+            fail(QStringLiteral("usage: newlist <index> [machine]"));
+        } else if (!machineAt(1, &machine)) {
+            fail(QStringLiteral("machine inconnue"));
+        } else {
+            m_udp->sendNewList(machine, value);
+            ok();
+        }
+    } else if (command == QLatin1String("boucle") || command == QLatin1String("reverse")
+               || command == QLatin1String("mute")) {
+        if (args.isEmpty() || !parseSwitch(args.at(0), &enabled)) {
+            fail(QStringLiteral("usage: %1 on|off [machine]").arg(command));
+        } else if (!machineAt(1, &machine)) {
+            fail(QStringLiteral("machine inconnue"));
+        } else {
+            if (command == QLatin1String("boucle"))
+                m_udp->sendBoucle(machine, enabled);
+            else if (command == QLatin1String("reverse"))
+                m_udp->sendReverse(machine, enabled);
+            else
+                m_udp->setMute(machine, enabled);
+            ok();
+        }
+    } else if (command == QLatin1String("speed") || command == QLatin1String("transpo")) {
+        if (args.isEmpty() || !parseByte(args.at(0), &value)) {
+            fail(QStringLiteral("usage: %1 <valeur> [machine]").arg(command));
+        } else if (!machineAt(1, &machine)) {
+            fail(QStringLiteral("machine inconnue"));
+        } else {
+            if (command == QLatin1String("speed"))
+                m_udp->setSpeed(machine, value);
+            else
+                m_udp->setTranspo(machine, value);
+            ok();
+        }
+    } else if (command == QLatin1String("volume")) {
+        if (args.isEmpty() || !parseByte(args.at(0), &value) || value < 0) {
+            fail(QStringLiteral("usage: volume <valeur> [machine]"));
+        } else if (args.size() == 1) {
+            m_udp->setVolumeGeneral(value);
+            ok(QStringLiteral("général"));
+        } else if (!machineAt(1, &machine)) {
+            fail(QStringLiteral("machine inconnue"));
+        } else {
+            m_udp->setVolume(machine, value);
+            ok();
+        }
+    } else if (command == QLatin1String("raw")) {
+        if (!args.isEmpty() && args.last().startsWith(QLatin1Char('@'))) {
+            if (!parseMachine(args.takeLast().mid(1), &machine)) {
+                fail(QStringLiteral("machine inconnue"));
+                return 0;
+            }
+        }
+        int cmd = 0;
+        if (args.isEmpty() || !parseByte(args.at(0), &cmd) || cmd < 0 || args.size() - 1 > kMaxRawData) {
+            fail(QStringLiteral("usage: raw <cmd> [octets...] (%1 max) [@machine]").arg(kMaxRawData));
+            return 0;
+        }
+        QByteArray data;
+        for (int i = 1; i < args.size(); ++i) {
+            if (!parseByte(args.at(i), &value)) {
+                fail(QStringLiteral("octet invalide: %1").arg(args.at(i)));
+                return 0;
+            }
+            data.append(char(value));
+        }
+        m_udp->sendCommandToMachine(machine, static_cast<unsigned char>(cmd), data);
+        ok();
+    } else if (command == QLatin1String("target")) {
+        if (args.size() != 1 || !parseMachine(args.at(0), &machine)) {
+            fail(QStringLiteral("usage: target <machine>"));
+        } else {
+            m_defaultMachine = machine;
+            ok(SirenConfig::nameForMachineType(machine));
+        }
+    } else if (command == QLatin1String("wait")) {
+        if (args.size() != 1 || !parseNumber(args.at(0), &value) || value < 0) {
+            fail(QStringLiteral("usage: wait <ms>"));
+            return 0;
+        }
+        return value;
+    } else if (command == QLatin1String("include")) {
+        QStringList lines;
+        QString error;
+        if (args.size() != 1) {
+            fail(QStringLiteral("usage: include <fichier>"));
+        } else if (++session->includes > kMaxIncludes) {
+            fail(QStringLiteral("trop d'inclusions (%1 max)").arg(kMaxIncludes));
+        } else if (!readScript(resolve(args.at(0)), &lines, &error)) {
+            fail(error);
+        } else {
+            // Insérées en tête : exécutées avant la suite de la session
+            for (int i = lines.size() - 1; i >= 0; --i)
+                session->queue.prepend(lines.at(i));
+            ok();
+        }
+    } else if (command == QLatin1String("scene")) {
+        if (args.size() != 1) {
+            fail(QStringLiteral("usage: scene <fichier> | scene stop"));
+        } else if (args.at(0).toLower() == QLatin1String("stop")) {
+            int stopped = 0;
+            const QList<int> ids = m_sessions.keys();
+            for (int sceneId : ids) {
+                Session *scene = m_sessions.value(sceneId);
+                if (scene && scene->scene) {
+                    scene->waitTimer->stop();
+                    scene->queue.clear();
+                    finish(sceneId);
+                    ++stopped;
+                }
+            }
+            ok(QString::number(stopped));
+        } else {
+            QString error;
+            const int sceneId = runScene(resolve(args.at(0)), reply, &error);
+            if (sceneId < 0)
+                fail(error);
+            else
+                ok(QString::number(sceneId));
+        }
+    } else if (command == QLatin1String("show")) {
+        executeShow(args, reply, baseDir);
+    } else if (command == QLatin1String("monitor")) {
+        if (args.size() != 1 || !parseSwitch(args.at(0), &enabled)) {
+            fail(QStringLiteral("usage: monitor on|off"));
+        } else {
+            session->monitor = enabled;
+            ok();
+        }
+    } else if (command == QLatin1String("status")) {
+        int scenes = 0;
+        for (const Session *s : std::as_const(m_sessions))
+            scenes += s->scene ? 1 : 0;
+        ok(QStringLiteral("connected=%1 address=%2 port=%3 target=%4 sessions=%5 scenes=%6")
+                   .arg(m_udp->isConnected() ? 1 : 0)
+                   .arg(m_udp->addressOverride().isEmpty() ? m_udp->address() : m_udp->addressOverride())
+                   .arg(m_udp->port())
+                   .arg(int(m_defaultMachine))
+                   .arg(m_sessions.size())
+                   .arg(scenes));
+    } else if (command == QLatin1String("help")) {
+        for (const char *entry : kHelp)
+            reply(QLatin1String(entry));
+        ok();
+    } else if (command == QLatin1String("quit") || command == QLatin1String("exit")) {
+        ok();
+        emit quitRequested();
+    } else {
+        fail(QStringLiteral("commande inconnue: %1").arg(command));
+    }
+    return 0;
+}
+
+void CommandProcessor::executeShow(QStringList args, const ReplyHandler &reply, const QString &baseDir)
+{
+    if (!m_cueEngine) {
+        reply(QStringLiteral("error moteur de cues indisponible"));
+        return;
+    }
+    if (args.isEmpty()) {
+        reply(QStringLiteral("error usage: show load|play|pause|resume|stop|seek|cue|dryrun|status"));
+        return;
+    }
+    const QString action = args.takeFirst().toLower();
+    CueEngine *engine = m_cueEngine;
+    bool enabled = false;
+    int value = 0;
+
+    if (action == QLatin1String("load")) {
+        if (args.size() != 1) {
+            reply(QStringLiteral("error usage: show load <fichier>"));
+        } else {
+            const QString path = QFileInfo(args.at(0)).isAbsolute() ? args.at(0) : QDir(baseDir).filePath(args.at(0));
+            if (engine->load(path))
+                reply(QStringLiteral("ok %1 cues, %2 commandes, %3 ms")
+                          .arg(engine->cueNames().size())
+                          .arg(engine->commandCount())
+                          .arg(engine->durationMs(), 0, 'f', 0));
+            else
+                reply(QStringLiteral("error ") + engine->lastError());
+        }
+    } else if (action == QLatin1String("play") || action == QLatin1String("pause")
+               || action == QLatin1String("resume") || action == QLatin1String("stop")) {
+        if (!engine->isLoaded()) {
+            reply(QStringLiteral("error aucun spectacle chargé"));
+            return;
+        }
+        if (action == QLatin1String("play"))
+            engine->play();
+        else if (action == QLatin1String("pause"))
+            engine->pause();
+        else if (action == QLatin1String("resume"))
+            engine->resume();
+        else
+            engine->stop();
+        reply(QStringLiteral("ok"));
+    } else if (action == QLatin1String("seek")) {
+        if (args.size() != 1 || !parseNumber(args.at(0), &value) || value < 0)
+            reply(QStringLiteral("error usage: show seek <ms>"));
+        else {
+            engine->seek(value);
+            reply(QStringLiteral("ok"));
+        }
+    } else if (action == QLatin1String("cue")) {
+        const QStringList names = engine->cueNames();
+        const QString target = args.join(QLatin1Char(' '));
+        int index = names.indexOf(target);
+        if (index < 0 && parseNumber(target, &value))
+            index = value - 1;   // numérotation à partir de 1, comme à l'écran
+        if (index < 0 || index >= names.size()) {
+            reply(QStringLiteral("error cue inconnu: %1").arg(target));
+        } else {
+            engine->goToCue(index);
+            reply(QStringLiteral("ok %1").arg(names.at(index)));
+        }
+    } else if (action == QLatin1String("dryrun")) {
+        if (args.size() != 1 || !parseSwitch(args.at(0), &enabled))
+            reply(QStringLiteral("error usage: show dryrun on|off"));
+        else {
+            engine->setDryRun(enabled);
+            reply(QStringLiteral("ok"));
+        }
+    } else if (action == QLatin1String("status")) {
+        static const char *const states[] = { "stopped", "playing", "paused" };
+        const int cue = engine->currentCue();
+        reply(QStringLiteral("ok state=%1 position=%2 duration=%3 cue=%4 dryrun=%5 dispatched=%6 late=%7 meanUs=%8 p99Us=%9 maxUs=%10")
+                  .arg(QLatin1String(states[engine->state()]))
+                  .arg(engine->positionMs(), 0, 'f', 0)
+                  .arg(engine->durationMs(), 0, 'f', 0)
+                  .arg(cue >= 0 ? engine->cueNames().at(cue) : QStringLiteral("-"))
+                  .arg(engine->isDryRun() ? 1 : 0)
+                  .arg(engine->dispatched())
+                  .arg(engine->lateCount())
+                  .arg(engine->latencyMeanUs(), 0, 'f', 1)
+                  .arg(engine->latencyP99Us(), 0, 'f', 1)
+                  .arg(engine->latencyMaxUs(), 0, 'f', 1));
+    } else {
+        reply(QStringLiteral("error action inconnue: show %1").arg(action));
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef COMMANDPROCESSOR_H
+#define COMMANDPROCESSOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include "Config/MachineType.h"
+
+class QTimer;
+class UdpController;
+class CueEngine;
+
+// Interprète de commandes texte pour le moteur sans interface (appSirenManagerHeadless).
+// Une ligne = une commande ; chaque source (stdin, client du socket local, fichier de
+// scène) est une session dont les commandes s'exécutent dans l'ordre, `wait` ne
+// suspendant que sa propre session. Réponse : "ok [détail]" ou "error <message>".
+//
+//   start|stop|reset|synchro [machine]      newlist <index> [machine]
+//   boucle|reverse|mute on|off [machine]    speed|transpo <valeur> [machine]
+//   volume <valeur> [machine]               (sans machine : volume général)
+//   raw <cmd> [octets...] [@machine]        target <machine>
+//   wait <ms>    include <fichier>    scene <fichier> | scene stop
+//   monitor on|off    status    help    quit
+//   show load <fichier> | play | pause | resume | stop | seek <ms> | cue <n|nom>
+//        | dryrun on|off | status          (moteur de cues, voir Show/CueEngine.h)
+//
+// Machines : maitre, clic, s1..s7, voiturea, voitureb, pavillon1, pavillon2 ou leur numéro.
+class CommandProcessor : public QObject
+{
+    Q_OBJECT
+
+public:
+    using ReplyHandler = std::function<void(const QString &)>;
+
+    explicit CommandProcessor(UdpController *udp, QObject *parent = nullptr);
+    ~CommandProcessor();
+
+    CueEngine *cueEngine() const { return m_cueEngine; }
+    void setCueEngine(CueEngine *engine) { m_cueEngine = engine; }
+    MachineType defaultMachine() const { return m_defaultMachine; }
+    void setDefaultMachine(MachineType machine) { m_defaultMachine = machine; }
+
+    int openSession(const QString &name, ReplyHandler reply);
+    void feed(int session, const QString &line);
+    // La session se termine une fois sa file vidée
+    void closeSession(int session);
+    // Ouvre une session de scène avec le contenu du fichier ; -1 si illisible
+    int runScene(const QString &path, ReplyHandler reply, QString *error = nullptr);
+    int activeSessionCount() const { return m_sessions.size(); }
+
+    static bool parseMachine(const QString &text, MachineType *machine);
+
+signals:
+    void quitRequested();
+    void sessionFinished(int session);
+    void idle();
+
+private slots:
+    void onDataReceived(const QByteArray &data, const QString &fromAddress, int fromPort);
+
+private:
+    struct Session {
+        QString name;
+        QString baseDir;         // résolution des chemins relatifs (include, scene)
+        ReplyHandler reply;
+        ReplyHandler owner;      // scène : client qui l'a lancée, prévenu à la fin
+        QStringList queue;
+        QTimer *waitTimer = nullptr;
+        bool closing = false;
+        bool scene = false;
+        bool monitor = false;
+        int includes = 0;
+    };
+
+    void drain(int id);
+    // Retourne le délai demandé par `wait` (ms), 0 sinon
+    int execute(int id, const QString &line);
+    void executeShow(QStringList args, const ReplyHandler &reply, const QString &baseDir);
+    void finish(int id);
+    bool readScript(const QString &path, QStringList *lines, QString *error) const;
+
+    UdpController *m_udp;
+    CueEngine *m_cueEngine;
+    MachineType m_defaultMachine;
+    QHash<int, Session *> m_sessions;
+    int m_nextSession;
+};
+
+#endif // COMMANDPROCESSOR_H
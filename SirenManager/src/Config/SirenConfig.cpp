@@ -58,6 +58,64 @@ QString SirenConfig::nameForMachineType(MachineType machineType)
     }
 }
 
+bool SirenConfig::machineTypeFromString(const QString &text, MachineType *machineType)
+{
+    static const struct {
+        const char *key;
+        MachineType machine;
+    } aliases[] = {
+        { "maitre", MachineType::LinuxMaitre },
+        { "master", MachineType::LinuxMaitre },
+        { "linux", MachineType::LinuxMaitre },
+        { "clic", MachineType::RaspberryClic },
+        { "s1", MachineType::S1 },
+        { "s2", MachineType::S2 },
+        { "s3", MachineType::S3 },
+        { "s4", MachineType::S4 },
+        { "s5", MachineType::S5 },
+        { "s6", MachineType::S6 },
+        { "s7", MachineType::S7 },
+        { "voiturea", MachineType::VoitureA },
+        { "voitureb", MachineType::VoitureB },
+        { "pavillon1", MachineType::Pavillon1 },
+        { "pavillon2", MachineType::Pavillon2 },
+    };
+    const QString key = text.trimmed().toLower();
+    for (const auto &alias : aliases) {
+        if (key == QLatin1String(alias.key)) {
+            *machineType = alias.machine;
+            return true;
+        }
+    }
+    bool ok = false;
+    const int index = key.toInt(&ok);
+    if (ok && index >= int(MachineType::LinuxMaitre) && index <= int(MachineType::Pavillon2)) {
+        *machineType = MachineType(index);
+        return true;
+    }
+    return false;
+}
+
+QString SirenConfig::keyForMachineType(MachineType machineType)
+{
+    switch (machineType) {
+        case MachineType::LinuxMaitre: return QStringLiteral("maitre");
+        case MachineType::RaspberryClic: return QStringLiteral("clic");
+        case MachineType::S1: return QStringLiteral("s1");
+        case MachineType::S2: return QStringLiteral("s2");
+        case MachineType::S3: return QStringLiteral("s3");
+        case MachineType::S4: return QStringLiteral("s4");
+        case MachineType::S5: return QStringLiteral("s5");
+        case MachineType::S6: return QStringLiteral("s6");
+        case MachineType::S7: return QStringLiteral("s7");
+        case MachineType::VoitureA: return QStringLiteral("voiturea");
+        case MachineType::VoitureB: return QStringLiteral("voitureb");
+        case MachineType::Pavillon1: return QStringLiteral("pavillon1");
+        case MachineType::Pavillon2: return QStringLiteral("pavillon2");
+        default: return QStringLiteral("maitre");
+    }
+}
+
 QString SirenConfig::midiPathForMachineType(MachineType machineType)
 {
     switch (machineType) {
@@ -60,6 +60,9 @@ public:
     // Machine IP Addresses
     static QString ipAddressForMachineType(MachineType machineType);
     static QString nameForMachineType(MachineType machineType);
+    // Nom court (maitre, clic, s1..s7, voiturea, ...) ou numéro ; insensible à la casse
+    static bool machineTypeFromString(const QString &text, MachineType *machineType);
+    static QString keyForMachineType(MachineType machineType);
     
     // Paths
     static QString midiPathForMachineType(MachineType machineType);
@@ -1,5 +1,4 @@
 #include "PlaylistManager.h"
-#include <QRegularExpression>
 
 PlaylistManager::PlaylistManager(QObject *parent)
     : QObject(parent)
@@ -8,8 +7,59 @@ PlaylistManager::PlaylistManager(QObject *parent)
 
 QStringList PlaylistManager::parsePlaylistContent(const QString &content)
 {
+    const QList<PlaylistEntry> parsed = parseEntries(content);
     QStringList entries;
-    // TODO: Implement playlist parsing
+    entries.reserve(parsed.size());
+    for (const PlaylistEntry &entry : parsed)
+        entries.append(formatPlaylistEntry(entry.slot, entry.filename, entry.pseudo, entry.boucle, entry.enchain));
+    return entries;
+}
+
+QList<PlaylistEntry> PlaylistManager::parseEntries(const QString &content)
+{
+    QList<PlaylistEntry> entries;
+    const QStringView text(content);
+    qsizetype pos = 0;
+    while ((pos = text.indexOf(QLatin1Char('{'), pos)) >= 0) {
+        const qsizetype close = text.indexOf(QLatin1Char('}'), pos + 1);
+        if (close < 0)
+            break;
+
+        PlaylistEntry entry { int(entries.size()) + 1, QString(), QString(), false, false };
+        bool hasFile = false;
+        // Champs [clé=valeur] entre les accolades
+        qsizetype field = pos + 1;
+        while ((field = text.indexOf(QLatin1Char('['), field)) >= 0 && field < close) {
+            const qsizetype end = text.indexOf(QLatin1Char(']'), field + 1);
+            if (end < 0 || end > close)
+                break;
+            const QStringView item = text.mid(field + 1, end - field - 1);
+            const qsizetype equal = item.indexOf(QLatin1Char('='));
+            if (equal > 0) {
+                const QStringView key = item.left(equal).trimmed();
+                const QStringView value = item.mid(equal + 1).trimmed();
+                if (key == QLatin1String("n")) {
+                    bool ok = false;
+                    const int slot = value.toInt(&ok);
+                    if (ok)
+                        entry.slot = slot;
+                } else if (key == QLatin1String("s")) {
+                    entry.filename = value.toString();
+                    hasFile = !entry.filename.isEmpty();
+                } else if (key == QLatin1String("a")) {
+                    entry.pseudo = value.toString();
+                } else if (key == QLatin1String("B")) {
+                    entry.boucle = value == QLatin1String("1");
+                } else if (key == QLatin1String("E")) {
+                    entry.enchain = value == QLatin1String("1");
+                }
+            }
+            field = end + 1;
+        }
+        if (hasFile)
+            entries.append(entry);
+        pos = close + 1;
+    }
     return entries;
 }
 
@@ -5,6 +5,7 @@
 #include <QString>
 #include <QStringList>
 #include "Config/MachineType.h"
+#include "Models/PlaylistModel.h"
 
 class PlaylistManager : public QObject
 {
@@ -14,7 +15,11 @@ public:
     explicit PlaylistManager(QObject *parent = nullptr);
     
     // Parse playlist format: {[n=X][s=filename][a=pseudo][B=0/1][E=0/1]}
+    // Retourne une entrée normalisée (formatPlaylistEntry) par bloc lu
     Q_INVOKABLE QStringList parsePlaylistContent(const QString &content);
+    // Blocs { ... } lus en un seul passage ; champs absents = valeurs par défaut,
+    // champs inconnus ignorés, bloc sans [s=...] ignoré
+    static QList<PlaylistEntry> parseEntries(const QString &content);
     Q_INVOKABLE QString formatPlaylistEntry(int slot, const QString &filename, 
                                             const QString &pseudo, bool boucle, bool enchain);
 };
@@ -0,0 +1,654 @@
+#include "RemoteFileIndex.h"
+#include "../Config/SirenConfig.h"
+#include "MecavivLog.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+#if QT_CONFIG(process)
+#include <QProcess>
+#endif
+
+MECAVIV_LOG_CATEGORY(lcRemote, "REMOTE", MecavivLog::Level::Info)
+
+namespace {
+constexpr int kMachineCount = int(MachineType::Pavillon2) + 1;
+constexpr int kRequestTimeoutMs = 15000;
+constexpr int kSaveDelayMs = 2000;
+constexpr int kCacheVersion = 1;
+const QByteArray kBeginMarker = QByteArrayLiteral("@@MECAVIV BEGIN ");
+const QByteArray kEndMarker = QByteArrayLiteral("@@MECAVIV END ");
+
+bool isValidMachine(int machine)
+{
+    return machine >= 0 && machine < kMachineCount;
+}
+
+// Chemin entre apostrophes pour sh (' → '\'')
+QString shellQuote(const QString &text)
+{
+    QString quoted = text;
+    quoted.replace(QLatin1Char('\''), QStringLiteral("'\\''"));
+    return QLatin1Char('\'') + quoted + QLatin1Char('\'');
+}
+
+bool matchesKind(const QString &name, RemoteFileIndex::Kind kind)
+{
+    if (kind == RemoteFileIndex::Midi) {
+        return name.endsWith(SirenConfig::ExtensionMIDI, Qt::CaseInsensitive)
+            || name.endsWith(SirenConfig::ExtensionMIDIAlt, Qt::CaseInsensitive);
+    }
+    return name.endsWith(SirenConfig::ExtensionPlaylist, Qt::CaseInsensitive);
+}
+
+bool sameEntry(const RemoteFileEntry &a, const RemoteFileEntry &b)
+{
+    return a.mtimeMs == b.mtimeMs && a.size == b.size;
+}
+}
+
+RemoteFileIndex::RemoteFileIndex(QObject *parent)
+    : QObject(parent)
+    , m_pending(0)
+    , m_nextRequestId(1)
+    , m_autoRefreshMs(0)
+    , m_lastRefreshMs(0.0)
+{
+    m_shellOverride = qEnvironmentVariable("MECAVIV_REMOTE_SHELL");
+    m_rootOverride = qEnvironmentVariable("MECAVIV_REMOTE_ROOT");
+    m_cacheFile = qEnvironmentVariable("MECAVIV_REMOTE_INDEX_CACHE");
+    if (m_cacheFile.isEmpty()) {
+        const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (!dir.isEmpty())
+            m_cacheFile = QDir(dir).filePath(QStringLiteral("remote-file-index.json"));
+    }
+
+    // Taille fixe : les sessions ne sont jamais déplacées en mémoire
+    m_sessions.resize(kMachineCount);
+    for (int i = 0; i < kMachineCount; ++i) {
+        Session &s = m_sessions[i];
+        s.machine = MachineType(i);
+        QStringList paths;
+        paths << remotePath(s, SirenConfig::midiPathForMachineType(s.machine));
+        const QString playlistPath = remotePath(s, SirenConfig::playlistPathForMachineType(s.machine));
+        // Sur la machine clic, MIDI et listes partagent le même répertoire : un seul listage
+        if (!paths.contains(playlistPath))
+            paths << playlistPath;
+        for (const QString &path : std::as_const(paths)) {
+            Directory dir;
+            dir.path = path;
+            s.dirs.append(dir);
+        }
+
+        s.timeout = new QTimer(this);
+        s.timeout->setSingleShot(true);
+        s.timeout->setInterval(kRequestTimeoutMs);
+        connect(s.timeout, &QTimer::timeout, this, [this, i]() {
+            failSession(m_sessions[i], QStringLiteral("Délai dépassé"));
+        });
+    }
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(kSaveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &RemoteFileIndex::saveCache);
+    connect(&m_autoRefreshTimer, &QTimer::timeout, this, &RemoteFileIndex::refreshAll);
+
+    loadCache();
+}
+
+RemoteFileIndex::~RemoteFileIndex()
+{
+    if (m_saveTimer.isActive())
+        saveCache();
+    disconnectAll();
+}
+
+void RemoteFileIndex::setAutoRefreshMs(int intervalMs)
+{
+    intervalMs = qMax(0, intervalMs);
+    if (m_autoRefreshMs == intervalMs)
+        return;
+    m_autoRefreshMs = intervalMs;
+    if (intervalMs > 0)
+        m_autoRefreshTimer.start(intervalMs);
+    else
+        m_autoRefreshTimer.stop();
+    emit autoRefreshMsChanged();
+}
+
+QStringList RemoteFileIndex::machineNames() const
+{
+    QStringList names;
+    names.reserve(kMachineCount);
+    for (int i = 0; i < kMachineCount; ++i)
+        names << SirenConfig::nameForMachineType(MachineType(i));
+    return names;
+}
+
+void RemoteFileIndex::refreshAll()
+{
+    m_refreshClock.start();
+    for (int i = 0; i < kMachineCount; ++i)
+        refresh(i);
+}
+
+void RemoteFileIndex::refresh(int machine)
+{
+    Session *s = session(machine);
+    if (!s)
+        return;
+    if (!m_refreshClock.isValid())
+        m_refreshClock.start();
+
+    // Une requête est déjà en cours : un seul passage de plus à la fin
+    if (s->requestId != 0) {
+        s->queued = true;
+        return;
+    }
+
+    ++m_pending;
+    emit pendingCountChanged();
+    s->requestId = m_nextRequestId++;
+    emit machineStatusChanged(machine);
+
+    if (!ensureProcess(*s))
+        return;
+    sendListing(*s);
+}
+
+void RemoteFileIndex::invalidate(int machine)
+{
+    Session *s = session(machine);
+    if (!s)
+        return;
+    for (Directory &dir : s->dirs) {
+        dir.dirMtime = -1;
+        dir.scanTime = -1;
+    }
+}
+
+void RemoteFileIndex::disconnectAll()
+{
+#if QT_CONFIG(process)
+    for (Session &s : m_sessions) {
+        if (!s.process)
+            continue;
+        QProcess *process = s.process;
+        s.process = nullptr;
+        process->disconnect(this);
+        // Pas d'attente : 13 sessions fermées en série bloqueraient le thread GUI
+        // (fin de l'application, vue déchargée). La session ne garde aucun état distant.
+        if (process->state() != QProcess::NotRunning)
+            process->kill();
+        process->deleteLater();
+        s.timeout->stop();
+        s.queued = false;
+        s.inResponse = false;
+        if (s.requestId != 0)
+            finishRequest(s);
+    }
+#endif
+}
+
+QVariantList RemoteFileIndex::files(int machine, int kind) const
+{
+    QVariantList list;
+    if (!isValidMachine(machine))
+        return list;
+    const QString base = kind == Midi ? SirenConfig::midiPathForMachineType(MachineType(machine))
+                                      : SirenConfig::playlistPathForMachineType(MachineType(machine));
+    const QVector<RemoteFileEntry> found = entries(MachineType(machine), Kind(kind));
+    list.reserve(found.size());
+    for (const RemoteFileEntry &entry : found) {
+        QVariantMap item;
+        item.insert(QStringLiteral("name"), entry.name);
+        item.insert(QStringLiteral("path"), base + entry.name);
+        item.insert(QStringLiteral("mtime"), double(entry.mtimeMs));
+        item.insert(QStringLiteral("size"), double(entry.size));
+        list.append(item);
+    }
+    return list;
+}
+
+QStringList RemoteFileIndex::fileNames(int machine, int kind) const
+{
+    QStringList names;
+    if (!isValidMachine(machine))
+        return names;
+    const QVector<RemoteFileEntry> found = entries(MachineType(machine), Kind(kind));
+    names.reserve(found.size());
+    for (const RemoteFileEntry &entry : found)
+        names.append(entry.name);
+    return names;
+}
+
+QVariantMap RemoteFileIndex::machineStatus(int machine) const
+{
+    QVariantMap status;
+    const Session *s = session(machine);
+    if (!s)
+        return status;
+    status.insert(QStringLiteral("connected"), s->process != nullptr);
+    status.insert(QStringLiteral("refreshing"), s->requestId != 0);
+    status.insert(QStringLiteral("lastError"), s->lastError);
+    status.insert(QStringLiteral("lastRefresh"), double(s->lastRefresh));
+    status.insert(QStringLiteral("midiCount"), int(entries(s->machine, Midi).size()));
+    status.insert(QStringLiteral("playlistCount"), int(entries(s->machine, Playlist).size()));
+    return status;
+}
+
+QVector<RemoteFileEntry> RemoteFileIndex::entries(MachineType machine, Kind kind) const
+{
+    QVector<RemoteFileEntry> found;
+    const Session *s = session(int(machine));
+    if (!s)
+        return found;
+    const int index = directoryFor(*s, kind);
+    if (index < 0)
+        return found;
+    for (const RemoteFileEntry &entry : s->dirs.at(index).files) {
+        if (matchesKind(entry.name, kind))
+            found.append(entry);
+    }
+    std::sort(found.begin(), found.end(), [](const RemoteFileEntry &a, const RemoteFileEntry &b) {
+        return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+    });
+    return found;
+}
+
+RemoteFileIndex::Session *RemoteFileIndex::session(int machine)
+{
+    return isValidMachine(machine) ? &m_sessions[machine] : nullptr;
+}
+
+const RemoteFileIndex::Session *RemoteFileIndex::session(int machine) const
+{
+    return isValidMachine(machine) ? &m_sessions.at(machine) : nullptr;
+}
+
+bool RemoteFileIndex::ensureProcess(Session &s)
+{
+#if QT_CONFIG(process)
+    if (s.process)
+        return true;
+
+    const int index = int(s.machine);
+    QString program;
+    QStringList arguments;
+    if (!m_shellOverride.isEmpty()) {
+        arguments = QProcess::splitCommand(expand(m_shellOverride, s));
+        if (!arguments.isEmpty())
+            program = arguments.takeFirst();
+    } else {
+        // Shell distant sans terminal, lit ses commandes sur stdin ; clé uniquement
+        program = QStringLiteral("ssh");
+        arguments << QStringLiteral("-T")
+                  << QStringLiteral("-o") << QStringLiteral("BatchMode=yes")
+                  << QStringLiteral("-o") << QStringLiteral("ConnectTimeout=5")
+                  << QStringLiteral("-o") << QStringLiteral("ServerAliveInterval=15")
+                  << QStringLiteral("-o") << QStringLiteral("ServerAliveCountMax=3")
+                  << QStringLiteral("-p") << QString::number(SirenConfig::PortSSH)
+                  << QStringLiteral("-i") << SirenConfig::sshKeyPath()
+                  << SirenConfig::sshUsernameForMachineType(s.machine) + QLatin1Char('@')
+                         + SirenConfig::ipAddressForMachineType(s.machine)
+                  << QStringLiteral("sh");
+    }
+    if (program.isEmpty()) {
+        failSession(s, SirenConfig::StatusErrorSSHUnavailable);
+        return false;
+    }
+
+    QProcess *process = new QProcess(this);
+    s.process = process;
+    s.buffer.clear();
+    s.inResponse = false;
+    connect(process, &QProcess::readyReadStandardOutput, this, [this, index]() {
+        onReadyRead(m_sessions[index]);
+    });
+    connect(process, &QProcess::errorOccurred, this, [this, index, process](QProcess::ProcessError error) {
+        Session &s = m_sessions[index];
+        if (s.process != process)
+            return;
+        if (error == QProcess::FailedToStart || error == QProcess::Crashed)
+            failSession(s, process->errorString());
+    });
+    connect(process, &QProcess::finished, this, [this, index, process](int exitCode) {
+        Session &s = m_sessions[index];
+        if (s.process != process)
+            return;
+        const QString stderrText = QString::fromUtf8(process->readAllStandardError()).trimmed();
+        const QString error = stderrText.isEmpty()
+            ? QStringLiteral("Session fermée (code %1)").arg(exitCode)
+            : stderrText.section(QLatin1Char('\n'), -1);
+        failSession(s, error);
+    });
+
+    mlogInfo(lcRemote) << "Ouverture de session" << SirenConfig::keyForMachineType(s.machine) << program;
+    process->start(program, arguments);
+    return s.process != nullptr;
+#else
+    failSession(s, SirenConfig::StatusErrorSSHUnavailable);
+    return false;
+#endif
+}
+
+void RemoteFileIndex::sendListing(Session &s)
+{
+#if QT_CONFIG(process)
+    const QString tab = QStringLiteral("\\t");
+    QString script;
+    script += QStringLiteral("echo '") + QString::fromLatin1(kBeginMarker) + QString::number(s.requestId) + QStringLiteral("'\n");
+    for (int i = 0; i < s.dirs.size(); ++i) {
+        const Directory &dir = s.dirs.at(i);
+        const QString index = QString::number(i);
+        const QString printfFormat = QStringLiteral("'F") + tab + index + tab + QStringLiteral("%f") + tab
+            + QStringLiteral("%T@") + tab + QStringLiteral("%s\\n'");
+        const QString find = QStringLiteral("find \"$d\" -mindepth 1 -maxdepth 1 -type f");
+        script += QStringLiteral("d=") + shellQuote(dir.path) + QLatin1Char('\n');
+        script += QStringLiteral("if [ -d \"$d\" ]; then dm=$(stat -c %Y \"$d\"); now=$(date +%s); ");
+        // Répertoire inchangé depuis avant le dernier passage : seuls les fichiers
+        // modifiés depuis sont relus (ajouts, suppressions et renommages changent
+        // le mtime du répertoire)
+        if (dir.dirMtime >= 0 && dir.scanTime > 0) {
+            script += QStringLiteral("if [ \"$dm\" = \"") + QString::number(dir.dirMtime)
+                + QStringLiteral("\" ] && [ \"$dm\" -lt ") + QString::number(dir.scanTime) + QStringLiteral(" ]; then ")
+                + QStringLiteral("printf 'P") + tab + index + tab + QStringLiteral("%s") + tab + QStringLiteral("%s\\n' \"$dm\" \"$now\"; ")
+                + find + QStringLiteral(" -newermt \"@") + QString::number(dir.scanTime - 1) + QStringLiteral("\" -printf ")
+                + printfFormat + QStringLiteral("; else ");
+        }
+        script += QStringLiteral("printf 'L") + tab + index + tab + QStringLiteral("%s") + tab + QStringLiteral("%s\\n' \"$dm\" \"$now\"; ")
+            + find + QStringLiteral(" -printf ") + printfFormat + QStringLiteral("; ");
+        if (dir.dirMtime >= 0 && dir.scanTime > 0)
+            script += QStringLiteral("fi; ");
+        script += QStringLiteral("else printf 'X") + tab + index + QStringLiteral("\\n'; fi\n");
+    }
+    script += QStringLiteral("echo \"") + QString::fromLatin1(kEndMarker) + QString::number(s.requestId) + QStringLiteral(" $?\"\n");
+
+    s.fullListing = QVector<bool>(s.dirs.size(), false);
+    s.received = QVector<QHash<QString, RemoteFileEntry>>(s.dirs.size());
+    s.receivedDirMtime = QVector<qint64>(s.dirs.size(), -2);
+    s.receivedScanTime = QVector<qint64>(s.dirs.size(), -1);
+    s.timeout->start();
+    s.process->write(script.toUtf8());
+#else
+    Q_UNUSED(s)
+#endif
+}
+
+void RemoteFileIndex::onReadyRead(Session &s)
+{
+#if QT_CONFIG(process)
+    if (!s.process)
+        return;
+    s.buffer += s.process->readAllStandardOutput();
+    qsizetype start = 0;
+    for (;;) {
+        const qsizetype end = s.buffer.indexOf('\n', start);
+        if (end < 0)
+            break;
+        handleLine(s, s.buffer.mid(start, end - start));
+        start = end + 1;
+    }
+    s.buffer.remove(0, start);
+#else
+    Q_UNUSED(s)
+#endif
+}
+
+void RemoteFileIndex::handleLine(Session &s, const QByteArray &line)
+{
+    if (line.startsWith(kBeginMarker)) {
+        s.inResponse = line.mid(kBeginMarker.size()).toInt() == s.requestId && s.requestId != 0;
+        return;
+    }
+    if (!s.inResponse)
+        return;
+    if (line.startsWith(kEndMarker)) {
+        const QList<QByteArray> parts = line.mid(kEndMarker.size()).split(' ');
+        if (parts.size() >= 2 && parts.at(0).toInt() == s.requestId)
+            finishResponse(s, parts.at(1).toInt());
+        return;
+    }
+
+    const QList<QByteArray> fields = line.split('\t');
+    if (fields.size() < 2)
+        return;
+    bool ok = false;
+    const int index = fields.at(1).toInt(&ok);
+    if (!ok || index < 0 || index >= s.dirs.size())
+        return;
+
+    const QByteArray &tag = fields.at(0);
+    if ((tag == "L" || tag == "P") && fields.size() >= 4) {
+        s.fullListing[index] = tag == "L";
+        s.receivedDirMtime[index] = fields.at(2).toLongLong();
+        s.receivedScanTime[index] = fields.at(3).toLongLong();
+    } else if (tag == "X") {
+        // Répertoire absent : la machine n'a aucun fichier de ce type
+        s.fullListing[index] = true;
+        s.receivedDirMtime[index] = -1;
+        s.receivedScanTime[index] = -1;
+    } else if (tag == "F" && fields.size() >= 5) {
+        RemoteFileEntry entry;
+        entry.name = QString::fromUtf8(fields.at(2));
+        entry.mtimeMs = qint64(fields.at(3).toDouble() * 1000.0);
+        entry.size = fields.at(4).toLongLong();
+        if (!entry.name.isEmpty())
+            s.received[index].insert(entry.name, entry);
+    }
+}
+
+void RemoteFileIndex::finishResponse(Session &s, int exitCode)
+{
+    s.timeout->stop();
+    s.inResponse = false;
+
+    QStringList added;
+    QStringList changed;
+    QStringList removed;
+    bool complete = true;
+    for (int i = 0; i < s.dirs.size(); ++i) {
+        // Pas d'en-tête pour ce répertoire (stat/date en échec) : cache conservé
+        if (s.receivedDirMtime.at(i) == -2) {
+            complete = false;
+            continue;
+        }
+        Directory &dir = s.dirs[i];
+        const QHash<QString, RemoteFileEntry> &received = s.received.at(i);
+        for (auto it = received.constBegin(); it != received.constEnd(); ++it) {
+            auto cached = dir.files.find(it.key());
+            if (cached == dir.files.end()) {
+                added << it.key();
+                dir.files.insert(it.key(), it.value());
+            } else if (!sameEntry(*cached, it.value())) {
+                changed << it.key();
+                *cached = it.value();
+            }
+        }
+        if (s.fullListing.at(i)) {
+            for (auto it = dir.files.begin(); it != dir.files.end();) {
+                if (!received.contains(it.key())) {
+                    removed << it.key();
+                    it = dir.files.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        dir.dirMtime = s.receivedDirMtime.at(i);
+        dir.scanTime = s.receivedScanTime.at(i);
+    }
+
+    s.lastRefresh = QDateTime::currentMSecsSinceEpoch();
+    s.lastError = complete && exitCode == 0 ? QString() : QStringLiteral("Listage incomplet (code %1)").arg(exitCode);
+    s.received.clear();
+
+    const int machine = int(s.machine);
+    if (!added.isEmpty() || !changed.isEmpty() || !removed.isEmpty()) {
+        mlogInfo(lcRemote) << SirenConfig::keyForMachineType(s.machine) << "+" << added.size()
+                           << "~" << changed.size() << "-" << removed.size();
+        emit filesChanged(machine, added, changed, removed);
+        scheduleSave();
+    }
+    finishRequest(s);
+}
+
+void RemoteFileIndex::failSession(Session &s, const QString &error)
+{
+    s.timeout->stop();
+    s.lastError = error;
+    s.inResponse = false;
+    s.buffer.clear();
+#if QT_CONFIG(process)
+    if (s.process) {
+        QProcess *process = s.process;
+        s.process = nullptr;
+        process->disconnect(this);
+        if (process->state() != QProcess::NotRunning)
+            process->kill();
+        process->deleteLater();
+    }
+#endif
+    mlogWarn(lcRemote) << SirenConfig::keyForMachineType(s.machine) << error;
+    emit machineError(int(s.machine), error);
+    // Les demandes en attente ne relancent pas une machine injoignable
+    s.queued = false;
+    if (s.requestId != 0)
+        finishRequest(s);
+    else
+        emit machineStatusChanged(int(s.machine));
+}
+
+void RemoteFileIndex::finishRequest(Session &s)
+{
+    s.requestId = 0;
+    m_pending = qMax(0, m_pending - 1);
+    emit machineStatusChanged(int(s.machine));
+
+    if (s.queued) {
+        s.queued = false;
+        refresh(int(s.machine));
+    }
+    emit pendingCountChanged();
+    if (m_pending == 0) {
+        m_lastRefreshMs = m_refreshClock.isValid() ? double(m_refreshClock.elapsed()) : 0.0;
+        m_refreshClock.invalidate();
+        emit refreshFinished();
+    }
+}
+
+int RemoteFileIndex::directoryFor(const Session &s, Kind kind) const
+{
+    const QString path = remotePath(s, kind == Midi ? SirenConfig::midiPathForMachineType(s.machine)
+                                                    : SirenConfig::playlistPathForMachineType(s.machine));
+    for (int i = 0; i < s.dirs.size(); ++i) {
+        if (s.dirs.at(i).path == path)
+            return i;
+    }
+    return -1;
+}
+
+QString RemoteFileIndex::remotePath(const Session &s, const QString &path) const
+{
+    if (m_rootOverride.isEmpty())
+        return path;
+    return QDir::cleanPath(expand(m_rootOverride, s) + QLatin1Char('/') + path) + QLatin1Char('/');
+}
+
+QString RemoteFileIndex::expand(const QString &text, const Session &s) const
+{
+    QString expanded = text;
+    expanded.replace(QStringLiteral("{machine}"), SirenConfig::keyForMachineType(s.machine));
+    expanded.replace(QStringLiteral("{host}"), SirenConfig::ipAddressForMachineType(s.machine));
+    expanded.replace(QStringLiteral("{user}"), SirenConfig::sshUsernameForMachineType(s.machine));
+    return expanded;
+}
+
+// Cache sur disque : { version, machines: { s1: [ { path, dirMtime, scanTime,
+// files: [[nom, mtime ms, taille], ...] } ] } } ; un chemin qui ne correspond
+// plus à la configuration est ignoré
+void RemoteFileIndex::loadCache()
+{
+    if (m_cacheFile.isEmpty())
+        return;
+    QFile file(m_cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value(QStringLiteral("version")).toInt() != kCacheVersion)
+        return;
+    const QJsonObject machines = root.value(QStringLiteral("machines")).toObject();
+    for (Session &s : m_sessions) {
+        const QJsonArray dirs = machines.value(SirenConfig::keyForMachineType(s.machine)).toArray();
+        for (const QJsonValue &value : dirs) {
+            const QJsonObject object = value.toObject();
+            const QString path = object.value(QStringLiteral("path")).toString();
+            for (Directory &dir : s.dirs) {
+                if (dir.path != path)
+                    continue;
+                dir.dirMtime = qint64(object.value(QStringLiteral("dirMtime")).toDouble(-1));
+                dir.scanTime = qint64(object.value(QStringLiteral("scanTime")).toDouble(-1));
+                dir.files.clear();
+                const QJsonArray files = object.value(QStringLiteral("files")).toArray();
+                for (const QJsonValue &fileValue : files) {
+                    const QJsonArray fields = fileValue.toArray();
+                    if (fields.size() < 3)
+                        continue;
+                    RemoteFileEntry entry;
+                    entry.name = fields.at(0).toString();
+                    entry.mtimeMs = qint64(fields.at(1).toDouble());
+                    entry.size = qint64(fields.at(2).toDouble());
+                    if (!entry.name.isEmpty())
+                        dir.files.insert(entry.name, entry);
+                }
+            }
+        }
+    }
+}
+
+void RemoteFileIndex::saveCache() const
+{
+    if (m_cacheFile.isEmpty())
+        return;
+    QJsonObject machines;
+    for (const Session &s : m_sessions) {
+        QJsonArray dirs;
+        for (const Directory &dir : s.dirs) {
+            QJsonArray files;
+            for (const RemoteFileEntry &entry : dir.files)
+                files.append(QJsonArray { entry.name, double(entry.mtimeMs), double(entry.size) });
+            QJsonObject object;
+            object.insert(QStringLiteral("path"), dir.path);
+            object.insert(QStringLiteral("dirMtime"), double(dir.dirMtime));
+            object.insert(QStringLiteral("scanTime"), double(dir.scanTime));
+            object.insert(QStringLiteral("files"), files);
+            dirs.append(object);
+        }
+        machines.insert(SirenConfig::keyForMachineType(s.machine), dirs);
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("version"), kCacheVersion);
+    root.insert(QStringLiteral("machines"), machines);
+
+    QDir().mkpath(QFileInfo(m_cacheFile).absolutePath());
+    QSaveFile file(m_cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        mlogWarn(lcRemote) << "Cache illisible" << m_cacheFile << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+        mlogWarn(lcRemote) << "Écriture du cache échouée" << m_cacheFile << file.errorString();
+}
+
+void RemoteFileIndex::scheduleSave()
+{
+    m_saveTimer.start();
+}
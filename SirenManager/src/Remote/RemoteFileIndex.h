@@ -0,0 +1,145 @@
+#ifndef REMOTEFILEINDEX_H
+#define REMOTEFILEINDEX_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantList>
+#include <QVector>
+#include "../Config/MachineType.h"
+
+class QProcess;
+
+struct RemoteFileEntry {
+    QString name;
+    qint64 mtimeMs = 0;
+    qint64 size = 0;
+};
+
+// Index des fichiers MIDI et des listes de lecture des 13 machines.
+// Une session SSH persistante par machine (un shell distant qui lit ses commandes
+// sur stdin) : pas de reconnexion à chaque listage. Les répertoires sont gardés
+// en cache (nom, mtime, taille) et rafraîchis de façon incrémentale : si le
+// répertoire n'a pas changé depuis le dernier passage, seuls les fichiers modifiés
+// depuis sont relus. Toutes les machines sont interrogées en parallèle et le cache
+// est conservé sur disque, l'interface affiche donc l'état connu immédiatement.
+//
+// Remplaçant local pour les essais (aucune machine requise) :
+//   MECAVIV_REMOTE_SHELL="sh"                 commande lancée à la place de ssh
+//   MECAVIV_REMOTE_ROOT="/tmp/sirenes/{machine}"  préfixe des chemins distants
+// {machine}, {host} et {user} sont remplacés dans les deux variables.
+//
+// Instance unique enregistrée comme singleton QML (main.cpp) : les vues partagent
+// les sessions et le cache.
+class RemoteFileIndex : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int pendingCount READ pendingCount NOTIFY pendingCountChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY pendingCountChanged)
+    Q_PROPERTY(int autoRefreshMs READ autoRefreshMs WRITE setAutoRefreshMs NOTIFY autoRefreshMsChanged)
+    Q_PROPERTY(double lastRefreshMs READ lastRefreshMs NOTIFY refreshFinished)
+    // Noms des machines dans l'ordre de MachineType (SirenConfig::nameForMachineType)
+    Q_PROPERTY(QStringList machineNames READ machineNames CONSTANT)
+
+public:
+    enum Kind {
+        Midi = 0,
+        Playlist = 1
+    };
+    Q_ENUM(Kind)
+
+    explicit RemoteFileIndex(QObject *parent = nullptr);
+    ~RemoteFileIndex();
+
+    int pendingCount() const { return m_pending; }
+    bool isBusy() const { return m_pending > 0; }
+    int autoRefreshMs() const { return m_autoRefreshMs; }
+    void setAutoRefreshMs(int intervalMs);
+    double lastRefreshMs() const { return m_lastRefreshMs; }
+    QStringList machineNames() const;
+
+    // Rafraîchit toutes les machines en parallèle, sans bloquer
+    Q_INVOKABLE void refreshAll();
+    Q_INVOKABLE void refresh(int machine);
+    // Oublie le cache d'une machine (listage complet au prochain passage)
+    Q_INVOKABLE void invalidate(int machine);
+    Q_INVOKABLE void disconnectAll();
+
+    // [{ name, path, mtime (ms), size }] triés par nom, filtrés par extension
+    Q_INVOKABLE QVariantList files(int machine, int kind) const;
+    Q_INVOKABLE QStringList fileNames(int machine, int kind) const;
+    // { connected, refreshing, lastError, lastRefresh (ms epoch), midiCount, playlistCount }
+    Q_INVOKABLE QVariantMap machineStatus(int machine) const;
+
+    QVector<RemoteFileEntry> entries(MachineType machine, Kind kind) const;
+
+signals:
+    void pendingCountChanged();
+    void autoRefreshMsChanged();
+    // Noms ajoutés, modifiés et supprimés depuis le passage précédent
+    void filesChanged(int machine, const QStringList &added, const QStringList &changed,
+                      const QStringList &removed);
+    void machineError(int machine, const QString &error);
+    void machineStatusChanged(int machine);
+    // Toutes les machines lancées par refreshAll() ont répondu (ou échoué)
+    void refreshFinished();
+
+private:
+    struct Directory {
+        QString path;
+        qint64 dirMtime = -1;   // secondes, horloge distante
+        qint64 scanTime = -1;   // secondes, horloge distante
+        QHash<QString, RemoteFileEntry> files;
+    };
+
+    struct Session {
+        MachineType machine = MachineType::LinuxMaitre;
+        QProcess *process = nullptr;
+        QByteArray buffer;
+        QVector<Directory> dirs;
+        // Réponse en cours de lecture
+        int requestId = 0;
+        bool inResponse = false;
+        bool queued = false;
+        QVector<bool> fullListing;
+        QVector<QHash<QString, RemoteFileEntry>> received;
+        QVector<qint64> receivedDirMtime;
+        QVector<qint64> receivedScanTime;
+        QTimer *timeout = nullptr;
+        QString lastError;
+        qint64 lastRefresh = 0;
+    };
+
+    Session *session(int machine);
+    const Session *session(int machine) const;
+    bool ensureProcess(Session &s);
+    void sendListing(Session &s);
+    void onReadyRead(Session &s);
+    void handleLine(Session &s, const QByteArray &line);
+    void finishResponse(Session &s, int exitCode);
+    void failSession(Session &s, const QString &error);
+    void finishRequest(Session &s);
+    int directoryFor(const Session &s, Kind kind) const;
+    QString remotePath(const Session &s, const QString &path) const;
+    QString expand(const QString &text, const Session &s) const;
+
+    void loadCache();
+    void saveCache() const;
+    void scheduleSave();
+
+    QVector<Session> m_sessions;
+    int m_pending;
+    int m_nextRequestId;
+    int m_autoRefreshMs;
+    double m_lastRefreshMs;
+    QElapsedTimer m_refreshClock;
+    QTimer m_autoRefreshTimer;
+    QTimer m_saveTimer;
+    QString m_cacheFile;
+    QString m_shellOverride;
+    QString m_rootOverride;
+};
+
+#endif // REMOTEFILEINDEX_H
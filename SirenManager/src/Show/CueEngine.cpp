@@ -0,0 +1,460 @@
+#include "CueEngine.h"
+#include "../Config/SirenConfig.h"
+#include "MecavivLog.h"
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QMutex>
+#include <QUdpSocket>
+#include <QWaitCondition>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+#if QT_CONFIG(thread)
+#include <QThread>
+#endif
+
+MECAVIV_LOG_CATEGORY(lcCue, "Cue", MecavivLog::Level::Info)
+
+namespace {
+// Attente bloquante jusqu'à 1 ms de l'échéance, attente active ensuite
+constexpr qint64 kSpinNs = 1000000;
+// Départ en retard au-delà d'1 ms
+constexpr double kLateUs = 1000.0;
+// Histogramme des latences : pas de 50 µs jusqu'à 10 ms, puis une case de débordement
+constexpr int kBucketUs = 50;
+constexpr int kBuckets = 200;
+constexpr int kRefreshInterval = 100;
+constexpr int kMachineCount = int(MachineType::Pavillon2) + 1;
+
+struct LatencyStats {
+    quint64 count = 0;
+    quint64 late = 0;
+    double sumUs = 0.0;
+    double maxUs = 0.0;
+    std::array<quint32, kBuckets + 1> histogram {};
+
+    void add(double us)
+    {
+        ++count;
+        sumUs += us;
+        maxUs = qMax(maxUs, us);
+        if (us > kLateUs)
+            ++late;
+        ++histogram[qBound(0, int(us / kBucketUs), kBuckets)];
+    }
+
+    double percentile(double fraction) const
+    {
+        if (count == 0)
+            return 0.0;
+        const quint64 target = quint64(std::ceil(double(count) * fraction));
+        quint64 seen = 0;
+        for (int i = 0; i <= kBuckets; ++i) {
+            seen += histogram[i];
+            if (seen >= target)
+                return i == kBuckets ? maxUs : qMin(maxUs, double((i + 1) * kBucketUs));
+        }
+        return maxUs;
+    }
+};
+
+int firstCommandAt(const QVector<ShowCommand> &timeline, qint64 timeUs)
+{
+    return int(std::lower_bound(timeline.begin(), timeline.end(), timeUs,
+                                [](const ShowCommand &command, qint64 t) { return command.timeUs < t; })
+               - timeline.begin());
+}
+}
+
+// État partagé entre CueEngine (thread de l'interface) et la boucle d'envoi,
+// protégé par `mutex`. La timeline n'est remplacée qu'à l'arrêt.
+class CueDispatcher
+#if QT_CONFIG(thread)
+    : public QThread
+#endif
+{
+public:
+    using Sender = std::function<void(const ShowCommand &)>;
+
+    explicit CueDispatcher(CueEngine *engine)
+        : m_engine(engine)
+    {
+        clock.start();
+    }
+
+    ~CueDispatcher()
+    {
+#if QT_CONFIG(thread)
+        {
+            QMutexLocker locker(&mutex);
+            m_quitRequested = true;
+            wake.wakeAll();
+        }
+        wait();
+#endif
+    }
+
+    qint64 positionUs() const { return (clock.nsecsElapsed() - originNs) / 1000; }
+
+    // Verrou tenu. Envoie les commandes échues ; retourne l'échéance suivante (ns) ou -1
+    qint64 dispatchDue(const Sender &send)
+    {
+        qint64 now = clock.nsecsElapsed();
+        while (playing && next < timeline.size()) {
+            const ShowCommand &command = timeline.at(next);
+            const qint64 due = originNs + command.timeUs * 1000;
+            if (due > now)
+                return due;
+            if (!dryRun)
+                send(command);
+            now = clock.nsecsElapsed();
+            const double latencyUs = (now - due) / 1000.0;
+            stats.add(latencyUs);
+            const int index = next++;
+            const bool dry = dryRun;
+            CueEngine *engine = m_engine;
+            QMetaObject::invokeMethod(engine, [engine, index, latencyUs, dry]() {
+                engine->onDispatched(index, latencyUs, dry);
+            }, Qt::QueuedConnection);
+        }
+        if (playing) {
+            playing = false;
+            CueEngine *engine = m_engine;
+            QMetaObject::invokeMethod(engine, [engine]() { engine->onFinished(); }, Qt::QueuedConnection);
+        }
+        return -1;
+    }
+
+    QMutex mutex;
+    QWaitCondition wake;
+    QElapsedTimer clock;
+    QVector<ShowCommand> timeline;
+    std::array<QHostAddress, kMachineCount> targets;
+    quint16 port = SirenConfig::PortUDP;
+    bool dryRun = false;
+    bool playing = false;
+    qint64 originNs = 0;
+    int next = 0;
+    LatencyStats stats;
+
+#if QT_CONFIG(thread)
+protected:
+    void run() override
+    {
+        // Socket propre au thread : l'envoi ne passe jamais par la boucle d'événements de l'interface
+        QUdpSocket socket;
+        const Sender send = [this, &socket](const ShowCommand &command) {
+            socket.writeDatagram(command.packet, targets[int(command.machine)], port);
+        };
+
+        QMutexLocker locker(&mutex);
+        while (!m_quitRequested) {
+            const qint64 due = dispatchDue(send);
+            if (due < 0) {
+                wake.wait(&mutex);
+                continue;
+            }
+            const qint64 remaining = due - clock.nsecsElapsed();
+            if (remaining > kSpinNs) {
+                // Réveil anticipé possible (pause, seek) : on réévalue à chaque tour
+                wake.wait(&mutex, QDeadlineTimer(std::chrono::nanoseconds(remaining - kSpinNs), Qt::PreciseTimer));
+                continue;
+            }
+            locker.unlock();
+            while (clock.nsecsElapsed() < due)
+                QThread::yieldCurrentThread();
+            locker.relock();
+        }
+    }
+#endif
+
+private:
+    CueEngine *m_engine;
+    // Sous mutex ; ne pas nommer « quit » (masquerait QThread::quit())
+    bool m_quitRequested = false;
+};
+
+CueEngine::CueEngine(QObject *parent)
+    : QObject(parent)
+    , m_dispatcher(new CueDispatcher(this))
+    , m_state(Stopped)
+    , m_positionUs(0)
+    , m_currentCue(-1)
+    , m_dryRun(false)
+    , m_dispatched(0)
+    , m_lateCount(0)
+    , m_latencyMeanUs(0.0)
+    , m_latencyP99Us(0.0)
+    , m_latencyMaxUs(0.0)
+{
+    m_refreshTimer.setInterval(kRefreshInterval);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &CueEngine::refresh);
+    m_fallbackTimer.setSingleShot(true);
+    m_fallbackTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &CueEngine::runFallback);
+}
+
+CueEngine::~CueEngine() = default;
+
+void CueEngine::setUdpController(UdpController *udp)
+{
+    if (m_udp == udp)
+        return;
+    m_udp = udp;
+    emit udpControllerChanged();
+}
+
+QStringList CueEngine::cueNames() const
+{
+    QStringList names;
+    names.reserve(m_show.cues.size());
+    for (const ShowCue &cue : m_show.cues)
+        names.append(cue.name);
+    return names;
+}
+
+void CueEngine::setDryRun(bool dryRun)
+{
+    if (m_dryRun == dryRun)
+        return;
+    m_dryRun = dryRun;
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        m_dispatcher->dryRun = dryRun;
+    }
+    emit dryRunChanged();
+}
+
+bool CueEngine::load(const QString &path)
+{
+    stop();
+    CompiledShow show;
+    QString error;
+    if (!ShowCompiler::compileFile(path, &show, &error)) {
+        mlogWarn(lcCue) << "Spectacle non chargé:" << error;
+        setError(error);
+        return false;
+    }
+    m_show = show;
+    m_source = path;
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        m_dispatcher->timeline = m_show.commands;
+    }
+    m_positionUs = 0;
+    m_currentCue = -1;
+    setError(QString());
+    resetStats();
+    mlogInfo(lcCue) << "Spectacle" << m_show.name << ":" << m_show.cues.size() << "cues,"
+                    << m_show.commands.size() << "commandes," << durationMs() << "ms";
+    emit loadedChanged();
+    refresh();
+    return true;
+}
+
+void CueEngine::play()
+{
+    if (m_state == Paused) {
+        resume();
+        return;
+    }
+    if (m_state == Playing || !isLoaded())
+        return;
+    start(m_positionUs >= m_show.durationUs ? 0 : m_positionUs);
+}
+
+void CueEngine::pause()
+{
+    if (m_state != Playing)
+        return;
+    m_fallbackTimer.stop();
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        m_positionUs = qBound<qint64>(0, m_dispatcher->positionUs(), m_show.durationUs);
+        m_dispatcher->playing = false;
+        m_dispatcher->wake.wakeAll();
+    }
+    m_refreshTimer.stop();
+    setState(Paused);
+    refresh();
+}
+
+void CueEngine::resume()
+{
+    if (m_state != Paused)
+        return;
+    start(m_positionUs);
+}
+
+void CueEngine::stop()
+{
+    m_fallbackTimer.stop();
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        m_dispatcher->playing = false;
+        m_dispatcher->wake.wakeAll();
+    }
+    m_refreshTimer.stop();
+    m_positionUs = 0;
+    setState(Stopped);
+    refresh();
+}
+
+void CueEngine::seek(double positionMs)
+{
+    const qint64 positionUs = qBound<qint64>(0, qint64(std::llround(positionMs * 1000.0)), m_show.durationUs);
+    if (m_state == Playing) {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        m_dispatcher->originNs = m_dispatcher->clock.nsecsElapsed() - positionUs * 1000;
+        m_dispatcher->next = firstCommandAt(m_dispatcher->timeline, positionUs);
+        m_dispatcher->wake.wakeAll();
+#if !QT_CONFIG(thread)
+        m_fallbackTimer.start(0);
+#endif
+    }
+    m_positionUs = positionUs;
+    refresh();
+}
+
+void CueEngine::goToCue(int index)
+{
+    if (index < 0 || index >= m_show.cues.size())
+        return;
+    seek(m_show.cues.at(index).timeUs / 1000.0);
+}
+
+void CueEngine::resetStats()
+{
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        m_dispatcher->stats = LatencyStats();
+    }
+    m_dispatched = 0;
+    m_lateCount = 0;
+    m_latencyMeanUs = 0.0;
+    m_latencyP99Us = 0.0;
+    m_latencyMaxUs = 0.0;
+    emit statsChanged();
+}
+
+void CueEngine::setState(State state)
+{
+    if (m_state == state)
+        return;
+    m_state = state;
+    emit stateChanged();
+}
+
+void CueEngine::setError(const QString &error)
+{
+    if (m_lastError == error)
+        return;
+    m_lastError = error;
+    emit lastErrorChanged();
+}
+
+void CueEngine::start(qint64 positionUs)
+{
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        // Adresses figées pour toute la lecture (simulateur local si UdpController en impose une)
+        const QString override = m_udp ? m_udp->addressOverride() : QString();
+        for (int i = 0; i < kMachineCount; ++i)
+            m_dispatcher->targets[i] = QHostAddress(override.isEmpty() ? SirenConfig::ipAddressForMachineType(MachineType(i)) : override);
+        m_dispatcher->port = quint16(m_udp ? m_udp->port() : SirenConfig::PortUDP);
+        m_dispatcher->dryRun = m_dryRun;
+        m_dispatcher->originNs = m_dispatcher->clock.nsecsElapsed() - positionUs * 1000;
+        m_dispatcher->next = firstCommandAt(m_dispatcher->timeline, positionUs);
+        m_dispatcher->playing = true;
+        m_dispatcher->wake.wakeAll();
+    }
+#if QT_CONFIG(thread)
+    if (!m_dispatcher->isRunning())
+        m_dispatcher->start(QThread::TimeCriticalPriority);
+#else
+    m_fallbackTimer.start(0);
+#endif
+    m_positionUs = positionUs;
+    setState(Playing);
+    m_refreshTimer.start();
+    refresh();
+}
+
+void CueEngine::refresh()
+{
+    LatencyStats stats;
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        if (m_state == Playing && m_dispatcher->playing)
+            m_positionUs = qBound<qint64>(0, m_dispatcher->positionUs(), m_show.durationUs);
+        stats = m_dispatcher->stats;
+    }
+
+    int cue = -1;
+    for (int i = 0; i < m_show.cues.size() && m_show.cues.at(i).timeUs <= m_positionUs; ++i)
+        cue = i;
+    m_currentCue = cue;
+    emit positionChanged();
+
+    if (int(stats.count) != m_dispatched) {
+        m_dispatched = int(stats.count);
+        m_lateCount = int(stats.late);
+        m_latencyMeanUs = stats.count ? stats.sumUs / double(stats.count) : 0.0;
+        m_latencyP99Us = stats.percentile(0.99);
+        m_latencyMaxUs = stats.maxUs;
+        emit statsChanged();
+    }
+}
+
+void CueEngine::onDispatched(int index, double latencyUs, bool dryRun)
+{
+    if (index < 0 || index >= m_show.commands.size())
+        return;
+    const ShowCommand &command = m_show.commands.at(index);
+    emit commandDispatched(command.timeUs / 1000.0,
+                           SirenConfig::keyForMachineType(command.machine),
+                           ShowCompiler::commandName(command.command),
+                           QString::fromLatin1(command.data.toHex(' ')),
+                           latencyUs, dryRun);
+}
+
+void CueEngine::onFinished()
+{
+    {
+        // Relancé entre-temps : ce signal de fin est périmé
+        QMutexLocker locker(&m_dispatcher->mutex);
+        if (m_dispatcher->playing)
+            return;
+    }
+    if (m_state != Playing)
+        return;
+    m_refreshTimer.stop();
+    m_positionUs = m_show.durationUs;
+    setState(Stopped);
+    refresh();
+    mlogInfo(lcCue) << "Spectacle terminé :" << m_dispatched << "commandes, latence moyenne"
+                    << m_latencyMeanUs << "µs, p99" << m_latencyP99Us << "µs, max" << m_latencyMaxUs << "µs";
+    emit finished();
+}
+
+void CueEngine::runFallback()
+{
+    // Sans thread : même boucle, cadencée par un QTimer précis, envoi via UdpController
+    const CueDispatcher::Sender send = [this](const ShowCommand &command) {
+        if (m_udp)
+            m_udp->sendCommandToMachine(command.machine, command.command, command.data);
+    };
+    qint64 due = -1;
+    {
+        QMutexLocker locker(&m_dispatcher->mutex);
+        due = m_dispatcher->dispatchDue(send);
+        if (due >= 0)
+            due -= m_dispatcher->clock.nsecsElapsed();
+    }
+    if (due >= 0)
+        m_fallbackTimer.start(int(qMax<qint64>(0, due / 1000000)));
+}
@@ -0,0 +1,134 @@
+#ifndef CUEENGINE_H
+#define CUEENGINE_H
+
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+#include <memory>
+#include "ShowCompiler.h"
+#include "../UdpController.h"
+
+class CueDispatcher;
+
+// Lecture d'un spectacle précompilé (voir ShowCompiler) : la timeline plate est
+// envoyée par un thread dédié à haute priorité, aux heures exactes (attente jusqu'à
+// ~1 ms de l'échéance puis attente active), indépendamment du thread de l'interface.
+// Sans threads (WebAssembly) la même boucle tourne sur un QTimer précis et passe par
+// UdpController. Le mode répétition (dryRun) déroule la timeline sans rien envoyer.
+// Les latences de départ (heure réelle - heure prévue) sont mesurées dans les deux cas.
+class CueEngine : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(UdpController *udpController READ udpController WRITE setUdpController NOTIFY udpControllerChanged)
+    Q_PROPERTY(bool loaded READ isLoaded NOTIFY loadedChanged)
+    Q_PROPERTY(QString showName READ showName NOTIFY loadedChanged)
+    Q_PROPERTY(QString source READ source NOTIFY loadedChanged)
+    Q_PROPERTY(QStringList cueNames READ cueNames NOTIFY loadedChanged)
+    Q_PROPERTY(int commandCount READ commandCount NOTIFY loadedChanged)
+    Q_PROPERTY(double durationMs READ durationMs NOTIFY loadedChanged)
+    Q_PROPERTY(int state READ state NOTIFY stateChanged)
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY stateChanged)
+    Q_PROPERTY(bool paused READ isPaused NOTIFY stateChanged)
+    Q_PROPERTY(double positionMs READ positionMs NOTIFY positionChanged)
+    Q_PROPERTY(int currentCue READ currentCue NOTIFY positionChanged)
+    Q_PROPERTY(bool dryRun READ isDryRun WRITE setDryRun NOTIFY dryRunChanged)
+    Q_PROPERTY(QString lastError READ lastError NOTIFY lastErrorChanged)
+
+    Q_PROPERTY(int dispatched READ dispatched NOTIFY statsChanged)
+    Q_PROPERTY(int lateCount READ lateCount NOTIFY statsChanged)
+    Q_PROPERTY(double latencyMeanUs READ latencyMeanUs NOTIFY statsChanged)
+    Q_PROPERTY(double latencyP99Us READ latencyP99Us NOTIFY statsChanged)
+    Q_PROPERTY(double latencyMaxUs READ latencyMaxUs NOTIFY statsChanged)
+
+public:
+    enum State {
+        Stopped = 0,
+        Playing = 1,
+        Paused = 2
+    };
+    Q_ENUM(State)
+
+    explicit CueEngine(QObject *parent = nullptr);
+    ~CueEngine();
+
+    UdpController *udpController() const { return m_udp; }
+    void setUdpController(UdpController *udp);
+
+    bool isLoaded() const { return !m_show.cues.isEmpty(); }
+    QString showName() const { return m_show.name; }
+    QString source() const { return m_source; }
+    QStringList cueNames() const;
+    int commandCount() const { return m_show.commands.size(); }
+    double durationMs() const { return m_show.durationUs / 1000.0; }
+    int state() const { return m_state; }
+    bool isPlaying() const { return m_state == Playing; }
+    bool isPaused() const { return m_state == Paused; }
+    double positionMs() const { return m_positionUs / 1000.0; }
+    int currentCue() const { return m_currentCue; }
+    bool isDryRun() const { return m_dryRun; }
+    void setDryRun(bool dryRun);
+    QString lastError() const { return m_lastError; }
+
+    int dispatched() const { return m_dispatched; }
+    int lateCount() const { return m_lateCount; }
+    double latencyMeanUs() const { return m_latencyMeanUs; }
+    double latencyP99Us() const { return m_latencyP99Us; }
+    double latencyMaxUs() const { return m_latencyMaxUs; }
+
+    const CompiledShow &show() const { return m_show; }
+
+    Q_INVOKABLE bool load(const QString &path);
+    Q_INVOKABLE void play();
+    Q_INVOKABLE void pause();
+    Q_INVOKABLE void resume();
+    Q_INVOKABLE void stop();
+    // Les commandes situées exactement à la nouvelle position sont envoyées
+    Q_INVOKABLE void seek(double positionMs);
+    Q_INVOKABLE void goToCue(int index);
+    Q_INVOKABLE void resetStats();
+
+signals:
+    void udpControllerChanged();
+    void loadedChanged();
+    void stateChanged();
+    void positionChanged();
+    void dryRunChanged();
+    void lastErrorChanged();
+    void statsChanged();
+    void commandDispatched(double timeMs, const QString &machine, const QString &command,
+                           const QString &data, double latencyUs, bool dryRun);
+    void finished();
+
+private:
+    friend class CueDispatcher;
+
+    void setState(State state);
+    void setError(const QString &error);
+    void start(qint64 positionUs);
+    void refresh();
+    void onDispatched(int index, double latencyUs, bool dryRun);
+    void onFinished();
+    void runFallback();
+
+    QPointer<UdpController> m_udp;
+    CompiledShow m_show;
+    QString m_source;
+    std::unique_ptr<CueDispatcher> m_dispatcher;
+    QTimer m_refreshTimer;
+    QTimer m_fallbackTimer;
+
+    State m_state;
+    qint64 m_positionUs;
+    int m_currentCue;
+    bool m_dryRun;
+    QString m_lastError;
+
+    int m_dispatched;
+    int m_lateCount;
+    double m_latencyMeanUs;
+    double m_latencyP99Us;
+    double m_latencyMaxUs;
+};
+
+#endif // CUEENGINE_H
@@ -0,0 +1,281 @@
+#include "ShowCompiler.h"
+#include "../Config/SirenConfig.h"
+#include "../UdpController.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Garde-fou : une rampe mal écrite (pas de 0 ms sur une heure) ne doit pas saturer la mémoire
+constexpr int kMaxCommands = 200000;
+constexpr int kMaxData = 6;
+constexpr int kDefaultRampStep = 50;
+
+struct CommandName {
+    const char *name;
+    quint8 command;
+};
+
+const CommandName kCommandNames[] = {
+    { "ASKSYNCHRO", UdpCommands::ASKSYNCHRO },
+    { "NEWLIST", UdpCommands::NEWLIST },
+    { "BOUCLE", UdpCommands::BOUCLE },
+    { "ST", UdpCommands::ST },
+    { "START", UdpCommands::ST },
+    { "STOP", UdpCommands::STOP },
+    { "RESET", UdpCommands::RESET },
+    { "REVERSE", UdpCommands::REVERSE },
+    { "SETSPEED", UdpCommands::SETSPEED },
+    { "SPEED", UdpCommands::SETSPEED },
+    { "TRANSPO", UdpCommands::TRANSPO },
+    { "VOLUME", UdpCommands::VOLUME },
+    { "VOLETACTIF", UdpCommands::VOLETACTIF },
+    { "MUTE", UdpCommands::MUTE },
+    { "SYNCHRO", UdpCommands::SYNCHRO },
+    { "SETVOLET", UdpCommands::SETVOLET },
+    { "SOURDINE", UdpCommands::SOURDINE },
+    { "LED", UdpCommands::LED },
+    { "LEDTROMPE", UdpCommands::LEDTROMPE },
+    { "VOITURE", UdpCommands::VOITURE },
+    { "TROMPEVOL", UdpCommands::TROMPEVOL },
+    { "TROMPEONOFF", UdpCommands::TROMPEONOFF },
+    { "VOLUMEGENE", UdpCommands::VOLUMEGENE },
+    { "TOURELLE", UdpCommands::TOURELLE },
+    { "SET_PRESETLED1", UdpCommands::SET_PRESETLED1 },
+    { "SET_PRESETLED2", UdpCommands::SET_PRESETLED2 },
+    { "SET_PRESETLED3", UdpCommands::SET_PRESETLED3 },
+    { "SET_PRESETLED4", UdpCommands::SET_PRESETLED4 },
+};
+
+bool readMachines(const QJsonObject &entry, QVector<MachineType> *machines, QString *error)
+{
+    QJsonArray names;
+    if (entry.value(QStringLiteral("machines")).isArray())
+        names = entry.value(QStringLiteral("machines")).toArray();
+    else if (entry.contains(QStringLiteral("machine")))
+        names.append(entry.value(QStringLiteral("machine")));
+    else
+        names.append(QStringLiteral("maitre"));
+
+    for (const QJsonValue &value : names) {
+        const QString name = value.isDouble() ? QString::number(value.toInt()) : value.toString();
+        if (name.compare(QLatin1String("sirenes"), Qt::CaseInsensitive) == 0) {
+            for (int i = int(MachineType::S1); i <= int(MachineType::S7); ++i)
+                machines->append(MachineType(i));
+            continue;
+        }
+        MachineType machine;
+        if (!SirenConfig::machineTypeFromString(name, &machine)) {
+            *error = QStringLiteral("machine inconnue: %1").arg(name);
+            return false;
+        }
+        machines->append(machine);
+    }
+    return true;
+}
+
+bool readByte(const QJsonValue &value, char *byte)
+{
+    if (!value.isDouble())
+        return false;
+    const int number = value.toInt();
+    if (number < -128 || number > 255)
+        return false;
+    *byte = char(number);
+    return true;
+}
+}
+
+bool ShowCompiler::commandFromString(const QString &text, quint8 *command)
+{
+    const QString upper = text.trimmed().toUpper();
+    for (const CommandName &entry : kCommandNames) {
+        if (upper == QLatin1String(entry.name)) {
+            *command = entry.command;
+            return true;
+        }
+    }
+    bool ok = false;
+    const int number = upper.startsWith(QLatin1String("0X")) ? upper.mid(2).toInt(&ok, 16) : upper.toInt(&ok);
+    if (ok && number >= 0 && number <= 255) {
+        *command = quint8(number);
+        return true;
+    }
+    return false;
+}
+
+QString ShowCompiler::commandName(quint8 command)
+{
+    for (const CommandName &entry : kCommandNames) {
+        if (entry.command == command)
+            return QLatin1String(entry.name);
+    }
+    return QStringLiteral("0x%1").arg(command, 2, 16, QLatin1Char('0'));
+}
+
+bool ShowCompiler::compileFile(const QString &path, CompiledShow *show, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = QStringLiteral("%1: %2").arg(path, file.errorString());
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        *error = QStringLiteral("%1: JSON invalide (%2, position %3)")
+                .arg(path, parseError.errorString())
+                .arg(parseError.offset);
+        return false;
+    }
+    return compile(doc.object(), show, error);
+}
+
+bool ShowCompiler::compile(const QJsonObject &root, CompiledShow *show, QString *error)
+{
+    CompiledShow result;
+    result.name = root.value(QStringLiteral("name")).toString();
+    const QJsonArray cues = root.value(QStringLiteral("cues")).toArray();
+    if (cues.isEmpty()) {
+        *error = QStringLiteral("aucun cue");
+        return false;
+    }
+
+    qint64 previousCueUs = 0;
+    for (int cueIndex = 0; cueIndex < cues.size(); ++cueIndex) {
+        const QJsonObject cue = cues.at(cueIndex).toObject();
+        ShowCue compiledCue;
+        compiledCue.name = cue.value(QStringLiteral("name")).toString(QStringLiteral("Cue %1").arg(cueIndex + 1));
+        if (cue.contains(QStringLiteral("at")))
+            compiledCue.timeUs = qint64(std::llround(cue.value(QStringLiteral("at")).toDouble() * 1000.0));
+        else
+            compiledCue.timeUs = previousCueUs + qint64(std::llround(cue.value(QStringLiteral("after")).toDouble() * 1000.0));
+        if (compiledCue.timeUs < 0) {
+            *error = QStringLiteral("cue \"%1\" : heure négative").arg(compiledCue.name);
+            return false;
+        }
+        // CueEngine cherche le cue courant par dichotomie : les cues doivent être en ordre chronologique
+        if (cueIndex > 0 && compiledCue.timeUs < previousCueUs) {
+            *error = QStringLiteral("cue \"%1\" : avant le cue précédent (%2 ms < %3 ms)")
+                    .arg(compiledCue.name)
+                    .arg(compiledCue.timeUs / 1000)
+                    .arg(previousCueUs / 1000);
+            return false;
+        }
+        previousCueUs = compiledCue.timeUs;
+
+        const QJsonArray commands = cue.value(QStringLiteral("commands")).toArray();
+        for (int i = 0; i < commands.size(); ++i) {
+            const QJsonObject entry = commands.at(i).toObject();
+            const QString where = QStringLiteral("cue \"%1\", commande %2").arg(compiledCue.name).arg(i + 1);
+
+            quint8 command = 0;
+            const QJsonValue commandValue = entry.value(QStringLiteral("command"));
+            const QString commandText = commandValue.isDouble() ? QString::number(commandValue.toInt()) : commandValue.toString();
+            if (!commandFromString(commandText, &command)) {
+                *error = QStringLiteral("%1 : commande inconnue \"%2\"").arg(where, commandText);
+                return false;
+            }
+
+            QVector<MachineType> machines;
+            QString machineError;
+            if (!readMachines(entry, &machines, &machineError)) {
+                *error = QStringLiteral("%1 : %2").arg(where, machineError);
+                return false;
+            }
+
+            QByteArray data;
+            if (entry.value(QStringLiteral("data")).isArray()) {
+                const QJsonArray bytes = entry.value(QStringLiteral("data")).toArray();
+                for (const QJsonValue &value : bytes) {
+                    char byte = 0;
+                    if (!readByte(value, &byte) || data.size() >= kMaxData) {
+                        *error = QStringLiteral("%1 : données invalides (%2 octets de -128 à 255 max)").arg(where).arg(kMaxData);
+                        return false;
+                    }
+                    data.append(byte);
+                }
+            } else if (entry.contains(QStringLiteral("value"))) {
+                char byte = 0;
+                if (!readByte(entry.value(QStringLiteral("value")), &byte)) {
+                    *error = QStringLiteral("%1 : valeur hors de -128..255").arg(where);
+                    return false;
+                }
+                data.append(byte);
+            }
+
+            const qint64 startUs = compiledCue.timeUs + qint64(std::llround(entry.value(QStringLiteral("at")).toDouble() * 1000.0));
+            if (startUs < 0) {
+                *error = QStringLiteral("%1 : heure négative").arg(where);
+                return false;
+            }
+
+            // Pas de la rampe : (heure, premier octet de données)
+            QVector<QPair<qint64, QByteArray>> steps;
+            const QJsonObject ramp = entry.value(QStringLiteral("ramp")).toObject();
+            if (!ramp.isEmpty()) {
+                char to = 0;
+                if (data.size() != 1 || !readByte(ramp.value(QStringLiteral("to")), &to)) {
+                    *error = QStringLiteral("%1 : une rampe demande \"value\" et \"ramp.to\"").arg(where);
+                    return false;
+                }
+                const double durationMs = ramp.value(QStringLiteral("duration")).toDouble();
+                const double stepMs = ramp.value(QStringLiteral("step")).toDouble(kDefaultRampStep);
+                if (durationMs <= 0.0 || stepMs <= 0.0) {
+                    *error = QStringLiteral("%1 : rampe sans durée ou sans pas").arg(where);
+                    return false;
+                }
+                const int from = entry.value(QStringLiteral("value")).toInt();
+                const int target = ramp.value(QStringLiteral("to")).toInt();
+                const int count = int(std::ceil(durationMs / stepMs));
+                int last = from - 1;
+                for (int step = 0; step <= count; ++step) {
+                    const double progress = qMin(1.0, step * stepMs / durationMs);
+                    const int value = int(std::lround(from + (target - from) * progress));
+                    // Pas identiques consécutifs inutiles sur le réseau
+                    if (value == last && step != count)
+                        continue;
+                    last = value;
+                    steps.append({ startUs + qint64(std::llround(progress * durationMs * 1000.0)), QByteArray(1, char(value)) });
+                }
+            } else {
+                steps.append({ startUs, data });
+            }
+
+            for (MachineType machine : machines) {
+                for (const auto &step : steps) {
+                    if (result.commands.size() >= kMaxCommands) {
+                        *error = QStringLiteral("plus de %1 commandes").arg(kMaxCommands);
+                        return false;
+                    }
+                    ShowCommand compiled;
+                    compiled.timeUs = step.first;
+                    compiled.machine = machine;
+                    compiled.command = command;
+                    compiled.data = step.second;
+                    compiled.packet = UdpController::buildPacket(QByteArray(1, char(command)) + step.second);
+                    compiled.cue = cueIndex;
+                    result.commands.append(compiled);
+                }
+            }
+        }
+        result.cues.append(compiledCue);
+    }
+
+    // Tri stable : à heure égale, l'ordre du fichier est conservé (NEWLIST avant ST)
+    std::stable_sort(result.commands.begin(), result.commands.end(),
+                     [](const ShowCommand &a, const ShowCommand &b) { return a.timeUs < b.timeUs; });
+    for (ShowCue &cue : result.cues) {
+        cue.firstCommand = int(std::lower_bound(result.commands.begin(), result.commands.end(), cue.timeUs,
+                                                [](const ShowCommand &c, qint64 t) { return c.timeUs < t; })
+                               - result.commands.begin());
+    }
+    result.durationUs = result.commands.isEmpty() ? 0 : result.commands.last().timeUs;
+    for (const ShowCue &cue : std::as_const(result.cues))
+        result.durationUs = qMax(result.durationUs, cue.timeUs);
+
+    *show = result;
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef SHOWCOMPILER_H
+#define SHOWCOMPILER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "../Config/MachineType.h"
+
+// Commande précompilée : le paquet UDP complet est construit au chargement,
+// le répartiteur n'a plus qu'à l'envoyer à l'heure dite.
+struct ShowCommand {
+    qint64 timeUs = 0;          // depuis le début du spectacle
+    MachineType machine = MachineType::LinuxMaitre;
+    quint8 command = 0;
+    QByteArray data;            // octets après la commande (≤ 6)
+    QByteArray packet;          // [longueur][BCC][0][cmd][data...]
+    int cue = 0;
+};
+
+struct ShowCue {
+    QString name;
+    qint64 timeUs = 0;
+    int firstCommand = 0;       // premier index de la timeline à l'heure du cue ou après
+};
+
+struct CompiledShow {
+    QString name;
+    QVector<ShowCue> cues;
+    QVector<ShowCommand> commands;   // triées par heure, ordre du fichier à heure égale
+    qint64 durationUs = 0;
+};
+
+// Fichier de spectacle (JSON) → timeline plate.
+//
+// {
+//   "name": "Final",
+//   "cues": [
+//     { "name": "Ouverture", "at": 0, "commands": [
+//         { "at": 0,    "machines": ["s1", "s2"], "command": "NEWLIST", "value": 3 },
+//         { "at": 0,    "machine": "sirenes",     "command": "ST" },
+//         { "at": 500,  "machine": "maitre",      "command": "VOLUMEGENE", "value": 100 },
+//         { "at": 2000, "machine": "s3", "command": "VOLUME", "value": 100,
+//           "ramp": { "to": 20, "duration": 4000, "step": 50 } },
+//         { "at": 8000, "machine": "s1", "command": "LED", "data": [1, 255, 0, 0] } ] },
+//     { "name": "Coda", "after": 12000, "commands": [ ... ] }
+//   ]
+// }
+//
+// "at" du cue : ms depuis le début ; sinon "after" : ms après le début du cue précédent.
+// Les cues sont dans l'ordre chronologique (heures égales permises), sinon le fichier est refusé.
+// "at" d'une commande : ms depuis le début de son cue. "command" : nom de UdpCommands
+// (ST, START, STOP, NEWLIST, VOLUME, TRANSPO, LED, ...) ou code numérique.
+// "machine" accepte les noms courts de SirenConfig et "sirenes" (S1..S7).
+// Une rampe est déroulée en une commande par pas, valeur finale incluse.
+class ShowCompiler
+{
+public:
+    static bool compileFile(const QString &path, CompiledShow *show, QString *error);
+    static bool compile(const QJsonObject &root, CompiledShow *show, QString *error);
+
+    static bool commandFromString(const QString &text, quint8 *command);
+    static QString commandName(quint8 command);
+};
+
+#endif // SHOWCOMPILER_H
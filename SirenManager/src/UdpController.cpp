@@ -1,10 +1,19 @@
 #include "UdpController.h"
 #include "Config/SirenConfig.h"
-#include <QDebug>
+#include "MecavivLog.h"
+#include "MecavivMessages.h"
+#include "TrafficRecorder.h"
+#include "TrafficReplayer.h"
 #include <QNetworkInterface>
 #include <QJsonDocument>
 #include <QJsonObject>
 
+// Les échecs d'envoi peuvent se répéter à chaque paquet : le filtrage par
+// catégorie évite tout formatage tant que UDP n'est pas activé à ce niveau
+MECAVIV_LOG_CATEGORY(lcUdp, "UDP", MecavivLog::Level::Warn)
+
+using MecavivProtocol::CommandPacket;
+
 #ifdef EMSCRIPTEN
     #define USE_WEBSOCKET 1
 #else
@@ -21,6 +30,8 @@ UdpController::UdpController(QObject *parent)
     , m_connected(false)
     , m_useWebSocket(USE_WEBSOCKET)
     , m_targetMachine(MachineType::LinuxMaitre)
+    , m_recorder(new TrafficRecorder(this))
+    , m_replayer(new TrafficReplayer(this))
 {
     if (m_useWebSocket) {
         m_webSocket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
@@ -36,6 +47,13 @@ UdpController::UdpController(QObject *parent)
         m_udpSocket = new QUdpSocket(this);
         connect(m_udpSocket, &QUdpSocket::readyRead, this, &UdpController::onUdpReadyRead);
     }
+
+    // Rejeu : même chemin que la réception, sans machine ni PureData
+    connect(m_replayer, &TrafficReplayer::frameReplayed, this, [this](int, const QByteArray &datagram) {
+        emit dataReceived(datagram, QStringLiteral("replay"), 0);
+    });
+    m_recorder->startFromEnvironment(QStringLiteral("sirenmanager-udp"));
+    m_replayer->startFromEnvironment();
 }
 
 UdpController::~UdpController()
@@ -60,6 +78,22 @@ void UdpController::setPort(int port)
     }
 }
 
+void UdpController::setReceivePort(int port)
+{
+    if (m_receivePort != port) {
+        m_receivePort = port;
+        emit receivePortChanged(m_receivePort);
+    }
+}
+
+void UdpController::setAddressOverride(const QString &address)
+{
+    if (m_addressOverride != address) {
+        m_addressOverride = address;
+        emit addressOverrideChanged(m_addressOverride);
+    }
+}
+
 void UdpController::initialize()
 {
     if (m_useWebSocket) {
@@ -100,14 +134,14 @@ void UdpController::setupUdpSocket(int receivePort)
     }
     
     if (m_udpSocket->bind(QHostAddress::AnyIPv4, receivePort, QUdpSocket::ShareAddress)) {
-        qDebug() << "[UdpController] UDP socket bound to port" << receivePort;
+        mlogDebug(lcUdp) << "UDP socket bound to port" << receivePort;
         if (!m_connected) {
             m_connected = true;
             emit connectedChanged(m_connected);
         }
     } else {
-        qWarning() << "[UdpController] Failed to bind UDP socket to port" << receivePort
-                   << ":" << m_udpSocket->errorString();
+        mlogWarn(lcUdp) << "Failed to bind UDP socket to port" << receivePort
+                        << ":" << m_udpSocket->errorString();
         emit errorOccurred(QStringLiteral("Failed to bind UDP socket: %1").arg(m_udpSocket->errorString()));
     }
 }
@@ -118,49 +152,25 @@ void UdpController::setupWebSocket(const QString &wsUrl)
         return;
     }
     
-    qDebug() << "[UdpController] Connecting to WebSocket proxy:" << wsUrl;
+    mlogDebug(lcUdp) << "Connecting to WebSocket proxy:" << wsUrl;
     m_webSocket->open(QUrl(wsUrl));
 }
 
-unsigned char UdpController::calculateBCC(const QByteArray &data)
-{
-    if (data.size() < 3) {
-        return 0;
-    }
-    
-    unsigned char bcc = static_cast<unsigned char>(data[3]);
-    for (int i = 4; i < 10 && i < data.size(); ++i) {
-        bcc ^= static_cast<unsigned char>(data[i]);
-    }
-    return bcc;
-}
-
 QByteArray UdpController::buildPacket(const QByteArray &data)
 {
-    QByteArray packet(10, 0x00);
-    
-    // Copy data (max 7 bytes, starting at position 3)
-    int dataSize = qMin(data.size(), 7);
-    for (int i = 0; i < dataSize; ++i) {
-        packet[i + 3] = data[i];
-    }
-    
-    // Calculate BCC (XOR of bytes 3-9)
-    unsigned char bcc = packet[3];
-    for (int i = 4; i < 10; ++i) {
-        bcc ^= static_cast<unsigned char>(packet[i]);
-    }
-    
-    // Set packet header
-    packet[0] = 10;        // Length
-    packet[1] = bcc;       // BCC checksum
-    // Bytes 2-9 already set (data or zeros)
-    
+    // [10][BCC][0][cmd][data...] : format et BCC définis dans MecavivMessages.h
+    QByteArray packet(int(CommandPacket::Size), Qt::Uninitialized);
+    const auto *bytes = reinterpret_cast<const std::uint8_t *>(data.constData());
+    if (data.isEmpty())
+        CommandPacket::encode(reinterpret_cast<std::uint8_t *>(packet.data()), 0, nullptr, 0);
+    else
+        CommandPacket::encode(reinterpret_cast<std::uint8_t *>(packet.data()), bytes[0], bytes + 1, size_t(data.size() - 1));
     return packet;
 }
 
 void UdpController::sendPacket(const QByteArray &packet)
 {
+    m_recorder->record(TrafficRecorder::Outbound, TrafficRecorder::Udp, packet);
     if (m_useWebSocket) {
         // Send via WebSocket proxy
         if (m_webSocket && m_webSocket->state() == QAbstractSocket::ConnectedState) {
@@ -173,7 +183,7 @@ void UdpController::sendPacket(const QByteArray &packet)
             QJsonDocument doc(json);
             m_webSocket->sendTextMessage(QString::fromUtf8(doc.toJson()));
         } else {
-            qWarning() << "[UdpController] WebSocket not connected";
+            mlogWarn(lcUdp) << "WebSocket not connected";
             emit errorOccurred(QStringLiteral("WebSocket not connected"));
         }
     } else {
@@ -181,7 +191,7 @@ void UdpController::sendPacket(const QByteArray &packet)
         if (m_udpSocket && m_targetAddress.isNull() == false) {
             qint64 sent = m_udpSocket->writeDatagram(packet, m_targetAddress, m_port);
             if (sent != packet.size()) {
-                qWarning() << "[UdpController] Failed to send UDP packet:" << m_udpSocket->errorString();
+                mlogWarn(lcUdp) << "Failed to send UDP packet:" << m_udpSocket->errorString();
                 emit errorOccurred(QStringLiteral("Failed to send UDP packet: %1").arg(m_udpSocket->errorString()));
             }
         }
@@ -200,7 +210,7 @@ void UdpController::sendCommand(unsigned char cmd, const QByteArray &data)
 
 void UdpController::sendCommandToMachine(MachineType machine, unsigned char cmd, const QByteArray &data)
 {
-    QString ip = SirenConfig::ipAddressForMachineType(machine);
+    QString ip = m_addressOverride.isEmpty() ? SirenConfig::ipAddressForMachineType(machine) : m_addressOverride;
     setAddress(ip);
     m_targetMachine = machine;
     sendCommand(cmd, data);
@@ -296,6 +306,7 @@ void UdpController::onUdpReadyRead()
         
         qint64 read = m_udpSocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
         if (read > 0) {
+            m_recorder->record(TrafficRecorder::Inbound, TrafficRecorder::Udp, datagram);
             emit dataReceived(datagram, sender.toString(), senderPort);
         }
     }
@@ -303,14 +314,14 @@ void UdpController::onUdpReadyRead()
 
 void UdpController::onWebSocketConnected()
 {
-    qDebug() << "[UdpController] WebSocket connected";
+    mlogDebug(lcUdp) << "WebSocket connected";
     m_connected = true;
     emit connectedChanged(m_connected);
 }
 
 void UdpController::onWebSocketDisconnected()
 {
-    qDebug() << "[UdpController] WebSocket disconnected";
+    mlogDebug(lcUdp) << "WebSocket disconnected";
     m_connected = false;
     emit connectedChanged(m_connected);
 }
@@ -318,6 +329,7 @@ void UdpController::onWebSocketDisconnected()
 void UdpController::onWebSocketBinaryMessageReceived(const QByteArray &message)
 {
     // Parse WebSocket message format (assumes JSON with data field)
+    m_recorder->record(TrafficRecorder::Inbound, TrafficRecorder::Udp, message);
     emit dataReceived(message, m_address, m_port);
 }
 
@@ -328,7 +340,7 @@ void UdpController::onWebSocketTextMessageReceived(const QString &message)
     QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
     
     if (error.error != QJsonParseError::NoError) {
-        qWarning() << "[UdpController] Failed to parse WebSocket message:" << error.errorString();
+        mlogWarn(lcUdp) << "Failed to parse WebSocket message:" << error.errorString();
         return;
     }
     
@@ -339,6 +351,7 @@ void UdpController::onWebSocketTextMessageReceived(const QString &message)
         QString fromAddress = json[QStringLiteral("address")].toString();
         int fromPort = json[QStringLiteral("port")].toInt();
         
+        m_recorder->record(TrafficRecorder::Inbound, TrafficRecorder::Udp, data);
         emit dataReceived(data, fromAddress, fromPort);
     }
 }
@@ -346,7 +359,7 @@ void UdpController::onWebSocketTextMessageReceived(const QString &message)
 void UdpController::onWebSocketError(QAbstractSocket::SocketError error)
 {
     QString errorString = m_webSocket ? m_webSocket->errorString() : QStringLiteral("Unknown error");
-    qWarning() << "[UdpController] WebSocket error:" << error << errorString;
+    mlogWarn(lcUdp) << "WebSocket error:" << error << errorString;
     emit errorOccurred(QStringLiteral("WebSocket error: %1").arg(errorString));
 }
 
@@ -9,12 +9,18 @@
 #include <QHostAddress>
 #include "Config/MachineType.h"
 
+class TrafficRecorder;
+class TrafficReplayer;
+
 class UdpController : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(bool isConnected READ isConnected NOTIFY connectedChanged)
     Q_PROPERTY(QString address READ address WRITE setAddress NOTIFY addressChanged)
     Q_PROPERTY(int port READ port WRITE setPort NOTIFY portChanged)
+    Q_PROPERTY(int receivePort READ receivePort WRITE setReceivePort NOTIFY receivePortChanged)
+    // Adresse imposée à toutes les machines (banc de test, simulateur UDP local) ; vide = IP de SirenConfig
+    Q_PROPERTY(QString addressOverride READ addressOverride WRITE setAddressOverride NOTIFY addressOverrideChanged)
 
 public:
     explicit UdpController(QObject *parent = nullptr);
@@ -26,6 +32,10 @@ public:
     void setAddress(const QString &address);
     int port() const { return m_port; }
     void setPort(int port);
+    int receivePort() const { return m_receivePort; }
+    void setReceivePort(int port);
+    QString addressOverride() const { return m_addressOverride; }
+    void setAddressOverride(const QString &address);
 
     // UDP Command methods (Q_INVOKABLE for QML)
     Q_INVOKABLE void sendCommand(unsigned char cmd, const QByteArray &data = QByteArray());
@@ -45,6 +55,15 @@ public:
     Q_INVOKABLE void setMute(MachineType machine, bool muted);
     Q_INVOKABLE void setVolumeGeneral(int volume);
     
+    // Build UDP packet with format: [length(1)][BCC(2)][data(3-10)]
+    // (public : réutilisé par le moteur de cues pour précompiler ses paquets)
+    static QByteArray buildPacket(const QByteArray &data);
+
+    // Capture (MECAVIV_CAPTURE) et rejeu (MECAVIV_REPLAY) des paquets, activés par
+    // l'environnement à la construction ; les trames rejouées sortent par dataReceived
+    TrafficRecorder *trafficRecorder() const { return m_recorder; }
+    TrafficReplayer *trafficReplayer() const { return m_replayer; }
+
     // Initialize connection
     Q_INVOKABLE void initialize();
     Q_INVOKABLE void connectToHost(const QString &address, int port);
@@ -54,6 +73,8 @@ signals:
     void connectedChanged(bool connected);
     void addressChanged(const QString &address);
     void portChanged(int port);
+    void receivePortChanged(int port);
+    void addressOverrideChanged(const QString &address);
     void dataReceived(const QByteArray &data, const QString &fromAddress, int fromPort);
     void errorOccurred(const QString &errorString);
 
@@ -66,12 +87,6 @@ private slots:
     void onWebSocketError(QAbstractSocket::SocketError error);
 
 private:
-    // Calculate BCC checksum (XOR of bytes 3-9)
-    unsigned char calculateBCC(const QByteArray &data);
-    
-    // Build UDP packet with format: [length(1)][BCC(2)][data(3-10)]
-    QByteArray buildPacket(const QByteArray &data);
-    
     // Send packet
     void sendPacket(const QByteArray &packet);
     
@@ -85,12 +100,15 @@ private:
     QUdpSocket *m_udpSocket;
     QWebSocket *m_webSocket;
     QString m_address;
+    QString m_addressOverride;
     int m_port;
     int m_receivePort;
     bool m_connected;
     bool m_useWebSocket; // true for WebAssembly, false for desktop
     QHostAddress m_targetAddress;
     MachineType m_targetMachine;
+    TrafficRecorder *m_recorder;
+    TrafficReplayer *m_replayer;
 };
 
 #endif // UDPCONTROLLER_H
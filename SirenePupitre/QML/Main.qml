@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Window 2.15
 import QtQuick.Controls 2.15
+import PupitreEngine 1.0
 import "components"
 import "controllers"
 import "admin"
@@ -26,6 +27,7 @@ Window {
 
     // --- État application ---
     property bool isAdminMode: false
+    property bool adminPanelOpen: false
     property bool isGamePlaying: false
     property bool userRequestedStop: false  // Clic Stop : ne pas laisser 0x01(playing=true) réécraser isGamePlaying
     property bool gameMode: false
@@ -33,6 +35,12 @@ Window {
     // --- UI ---
     property bool uiControlsEnabled: true
 
+    // Arrêt de la lecture : les notes encore en attente de restitution sont abandonnées
+    onIsGamePlayingChanged: {
+        if (!isGamePlaying)
+            webSocketController.noteBuffer.clear()
+    }
+
     // Synchroniser isAdminMode avec le mode global
     onIsAdminModeChanged: {
         if (configController) {
@@ -117,7 +125,9 @@ Window {
                 return
             }
             if (data.isVolantNote) {
-                sirenController.midiNote = data.midiNote
+                // Avec la prédiction active, la note suit wheelPredictor.predictedNote (voir plus bas)
+                if (!webSocketController.wheelPredictor.enabled)
+                    sirenController.midiNote = data.midiNote
                 return
             }
             if (data.midiNote !== undefined) {
@@ -135,6 +145,14 @@ Window {
             }
         }
 
+        // CC issus des contrôleurs physiques (controllerMapping) : même chemin que les CC de séquence
+        onMappedControlChanges: function(changes) {
+            if (!mainWindow.gameMode || !testViewLoader.item || !testViewLoader.item.gameModeItem)
+                return
+            for (var i = 0; i < changes.length; i++)
+                testViewLoader.item.gameModeItem.handleControlChange(changes[i].cc, changes[i].value)
+        }
+
         // Valeur int16 calibration pad (affichée sous les boutons Calibrer PAD 1/2)
         onPadCalibrationValueReceived: function(pad, value) {
             if (testViewLoader.item && testViewLoader.item.setPadCalibrationDisplayValue)
@@ -146,13 +164,39 @@ Window {
         }
     }
 
+    // Note du volant extrapolée à chaque frame : curseur, ligne d'anticipation et afficheurs
+    Connections {
+        target: webSocketController.wheelPredictor
+        function onPredictedNoteChanged() {
+            var predictor = webSocketController.wheelPredictor
+            if (predictor.enabled && predictor.hasNote)
+                sirenController.midiNote = predictor.predictedNote
+        }
+    }
+
+    // Chronologie du démarrage : jouable une fois connecté à PureData et configuré
+    Connections {
+        target: webSocketController
+        function onConnectedChanged() {
+            if (webSocketController.connected)
+                StartupTimeline.mark("websocketConnected")
+        }
+    }
+    Connections {
+        target: configController
+        function onWaitingForConfigChanged() {
+            if (!configController.waitingForConfig)
+                StartupTimeline.mark("configReceived")
+        }
+    }
+
     // --- UI : panneaux et overlays (ordre par z-index : vue → boutons/bandeaux → overlays) ---
 
     // Vue principale 2D (z implicite 0)
     Loader {
         id: testViewLoader
         anchors.fill: parent
-        visible: !adminPanel.visible
+        visible: !mainWindow.adminPanelOpen
         source: "qrc:/QML/pages/Test2D.qml"
         onItemChanged: {
             if (item) {
@@ -164,8 +208,10 @@ Window {
                     mainWindow.gameMode = value
                 }
                 item.openAdminPanel = function() {
-                    if (configController.getValueAtPath(["admin", "enabled"], true))
-                        adminPanel.visible = true
+                    if (configController.getValueAtPath(["admin", "enabled"], true)) {
+                        adminPanelLoader.active = true
+                        mainWindow.adminPanelOpen = true
+                    }
                 }
             }
         }
@@ -221,17 +267,24 @@ Window {
     }
 
     // Overlays (z 9999 puis 10000)
-    AdminPanel {
-        id: adminPanel
+    // Panneau Admin : instancié à la première ouverture puis conservé (onglets chargés à la demande)
+    Loader {
+        id: adminPanelLoader
         anchors.fill: parent
-        visible: false
+        visible: mainWindow.adminPanelOpen
         enabled: visible
         z: 9999
-        configController: configController
-        webSocketController: webSocketController
+        active: false
+
+        sourceComponent: Component {
+            AdminPanel {
+                configController: configController
+                webSocketController: webSocketController
 
-        onClose: {
-            adminPanel.visible = false
+                onClose: {
+                    mainWindow.adminPanelOpen = false
+                }
+            }
         }
     }
 
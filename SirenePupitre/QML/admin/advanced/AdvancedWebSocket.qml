@@ -180,6 +180,23 @@ GroupBox {
                     font.pixelSize: 13
                 }
                 
+                Text {
+                    text: "Prédiction volant:"
+                    color: "#888"
+                    font.pixelSize: 13
+                }
+                Text {
+                    property var predictor: webSocketController ? webSocketController.wheelPredictor : null
+                    // Erreur RMS / max en demi-tons, comparée au maintien de la dernière trame
+                    text: !predictor ? "N/A"
+                          : !predictor.enabled ? "désactivée"
+                          : "±" + predictor.errorRms.toFixed(3) + " (max " + predictor.errorMax.toFixed(2)
+                            + ", sans prédiction ±" + predictor.holdErrorRms.toFixed(3) + ")"
+                            + (predictor.trusted ? "" : " — suspendue")
+                    color: predictor && predictor.enabled && !predictor.trusted ? "#ffaa00" : "#bbb"
+                    font.pixelSize: 13
+                }
+                
                 Text {
                     text: "Dernier message:"
                     color: "#888"
@@ -7,6 +7,8 @@ Rectangle {
     
     // Propriétés pour les données des contrôleurs
     property real wheelPosition: 0
+    // Prédiction du volant (WebSocketController.wheelPredictor) : l'angle suit chaque frame
+    property var wheelPredictor: webSocketController ? webSocketController.wheelPredictor : null
     property real wheelSpeed: 0
     property real joystickX: 0
     property real joystickY: 0
@@ -699,11 +701,21 @@ Rectangle {
         }
     }
     
+    Connections {
+        target: root.wheelPredictor
+        enabled: root.wheelPredictor !== null
+        function onPredictedWheelPositionChanged() {
+            if (root.wheelPredictor.enabled && root.wheelPredictor.hasWheelPosition)
+                root.wheelPosition = root.wheelPredictor.predictedWheelPosition
+        }
+    }
+    
     // Fonction pour mettre à jour toutes les données
     function updateControllers(controllersData) {
         
         if (controllersData.wheel) {
-            wheelPosition = controllersData.wheel.position || 0
+            if (!wheelPredictor || !wheelPredictor.enabled)
+                wheelPosition = controllersData.wheel.position || 0
             wheelSpeed = controllersData.wheel.velocity || 0
         }
         
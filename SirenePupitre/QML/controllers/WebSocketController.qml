@@ -1,5 +1,6 @@
 import QtQuick
 import QtWebSockets
+import PupitreEngine 1.0
 
 Item {
     id: controller
@@ -51,6 +52,7 @@ Item {
     signal dataReceived(var data)
     signal configReceived(var config)
     signal controlChangeReceived(int ccNumber, int ccValue)  // Signal pour les CC MIDI
+    signal mappedControlChanges(var changes)  // Sorties CC des contrôleurs mappés [{controller, cc, value}]
     signal playbackPositionReceived(bool playing, int bar, int beatInBar, real beat)  // Position lecture (format 9 octets, legacy)
     signal playbackTickReceived(bool playing, int tick)  // Position lecture = tick seul (6 octets), JS gère bar/beat
     signal filesListReceived(var categories)  // Liste fichiers MIDI
@@ -59,10 +61,134 @@ Item {
     property var configController: null
     property var rootWindow: null  // Référence vers la fenêtre racine (Main.qml)
     
-    // Propriétés pour la réception binaire
-    property var binaryBuffer: null      // Buffer pour stocker les bytes
-    property int expectedSize: 0         // Taille totale attendue
-    property int receivedBytes: 0        // Nombre de bytes déjà reçus
+    // Réception binaire découpée (CONFIG_FULL) : réassemblage + parsing en C++
+    property alias expectedSize: chunkReassembler.expectedSize
+    property alias receivedBytes: chunkReassembler.receivedBytes
+    property alias receivingBinary: chunkReassembler.receiving
+    
+    FrameDecoder {
+        id: frameDecoder
+    }
+    
+    ChunkReassembler {
+        id: chunkReassembler
+        onConfigFullReceived: function(config) {
+            configReplica.seed(config);
+            if (controller.configController) {
+                controller.configController.updateFullConfig(config);
+            }
+        }
+    }
+    
+    // Synchronisation incrémentale de la config (trames "MCFG" : snapshot / patch versionnés)
+    property alias configVersion: configReplica.version
+    
+    ConfigReplica {
+        id: configReplica
+        onConfigReplaced: function(config) {
+            if (controller.configController) {
+                controller.configController.updateFullConfig(config);
+            }
+        }
+        onValueChanged: function(path, value) {
+            if (!controller.configController) {
+                return;
+            }
+            if (value === undefined) {
+                // Suppression de clé : pas d'équivalent dans setValueAtPath, on recharge la réplique
+                controller.configController.updateFullConfig(configReplica.toVariantMap());
+                return;
+            }
+            // Les patchs adressent sirens par index ; setValueAtPath attend l'id de la sirène
+            if (path.length > 2 && path[0] === "sirenConfig" && path[1] === "sirens" && typeof path[2] === "number") {
+                var sirenId = configReplica.valueAt(["sirenConfig", "sirens", path[2], "id"]);
+                if (sirenId !== undefined) {
+                    path[2] = sirenId.toString();
+                }
+            }
+            controller.configController.setValueAtPath(path, value, "console");
+        }
+        onReplyReady: function(frame) {
+            controller.sendRawBinaryMessage(frame);
+        }
+    }
+    
+    // Horloge de spectacle partagée avec la console (trames "MCLK" : pings, ancres du séquenceur)
+    property alias showClock: showClock
+    
+    ShowClock {
+        id: showClock
+        running: controller.connected
+        pupitreIndex: configReplica.pupitreIndex
+        onFrameReady: function(frame) {
+            controller.sendRawBinaryMessage(frame);
+        }
+    }
+    
+    // Tampon de lecture des notes 0x03 / 0x04 : restitution à heure d'envoi + délai adaptatif
+    // (smoothness : 0 = latence minimale, 1 = régularité maximale)
+    property alias noteBuffer: noteBuffer
+    
+    NoteJitterBuffer {
+        id: noteBuffer
+        showClock: controller.showClock
+        smoothness: 0.5
+        maxDelayMs: 250
+        
+        // 0x04 : note de séquence avec durée
+        onSequenceNoteReleased: function(note, velocity, duration) {
+            controller.dataReceived({
+                midiNote: note,
+                note: note,
+                velocity: velocity,
+                duration: duration,  // Durée en ms (16 bits, max 65535ms = 65.5s)
+                timestamp: Date.now(),
+                controllers: {},
+                isSequence: true  // Flag pour différencier séquence/contrôleurs
+            });
+        }
+        
+        // 0x03 : note du volant, bend 14 bits centré à 8192 (±2 demi-tons)
+        onWheelNoteReleased: function(note, velocity, bend) {
+            var bendSemitones = ((bend - 8192) / 8192.0) * 2.0;
+            wheelPredictor.pushNote(note + bendSemitones);
+            controller.dataReceived({
+                midiNote: note + bendSemitones,  // Note finale avec micro-tonalité
+                note: note,
+                velocity: velocity,
+                isVolantNote: true,  // Flag pour distinguer du séquenceur
+                timestamp: Date.now()
+            });
+        }
+    }
+    
+    // Prédiction du volant entre deux trames (filtre alpha-beta) : la note et l'angle affichés
+    // sont extrapolés jusqu'à l'heure d'affichage puis recalés sur chaque mesure
+    property alias wheelPredictor: wheelPredictor
+    
+    WheelPredictor {
+        id: wheelPredictor
+        displayLeadMs: 16
+        maxLeadMs: 60  // ≈ une trame throttlée (50 ms) + marge
+    }
+    
+    // Mapping contrôleurs → CC (tables de courbes compilées en C++ à chaque changement de controllerMapping)
+    property alias controllerMapper: controllerMapper
+    
+    ControllerMapper {
+        id: controllerMapper
+        onControlChanges: function(changes) {
+            controller.mappedControlChanges(changes);
+        }
+    }
+    
+    Connections {
+        target: controller.configController
+        function onSettingsUpdated() {
+            var config = controller.configController.config;
+            controllerMapper.loadMappings(config && config.controllerMapping ? config.controllerMapping : {});
+        }
+    }
     
     // ⏱️ TIMER POUR THROTTLING DES CONTRÔLEURS (Solution 1)
     Timer {
@@ -171,479 +297,338 @@ Item {
         active: false
         
         onBinaryMessageReceived: function(message) {
-            try {
-                var bytes = new Uint8Array(message);
-                
-                // 📊 Incrémenter compteur total de messages
-                controller.messageCountThisSecond++
-                
-                // Format binaire pour CONTROLLERS (type 0x02, 18 bytes) - CONTRÔLEURS PHYSIQUES
-                if (bytes.length === 18 && bytes[0] === 0x02) {
-                    // 📊 Incrémenter compteur de messages contrôleurs
-                    controller.controllersMessageCountThisSecond++
-                    
-                    // Décoder les données
-                    // Volant position (uint16, déjà en degrés 0-360)
-                    var wheelPos = bytes[1] | (bytes[2] << 8);
-                    
-                    // Pads (2 pads distincts)
-                    var pad1After = bytes[3];
-                    var pad1Vel = bytes[4];
-                    var pad2After = bytes[5];
-                    var pad2Vel = bytes[6];
-                    
-                    // Joystick : 0-127 = +0 à +127, 128-255 = -0 à -127
-                    var joyX = bytes[7] <= 127 ? bytes[7] : bytes[7] - 255;
-                    var joyY = bytes[8] <= 127 ? bytes[8] : bytes[8] - 255;
-                    var joyZ = bytes[9] <= 127 ? bytes[9] : bytes[9] - 255;
-                    
-                    // Joystick bouton
-                    var joyBtn = bytes[10] > 0 ? 1 : 0;
-                    
-                    // Sélecteur 5 vitesses (0-4)
-                    var selector = bytes[11];
-                    
-                    // Fader et pédale
-                    var fader = bytes[12];
-                    var pedal = bytes[13];
-                    
-                    // Boutons supplémentaires
-                    var btn1 = bytes[14] > 0 ? 1 : 0;
-                    var btn2 = bytes[15] > 0 ? 1 : 0;
-                    
-                    // Encoder (nouveau, bytes 16-17)
-                    var encoderValue = bytes[16];
-                    var encoderPressed = bytes[17] > 0 ? true : false;
-                    
-                    // Mapper le mode GearShift (5 positions)
-                    var gearModeNames = ["SEMITONE", "THIRD", "MINOR_SIXTH", "OCTAVE", "DOUBLE_OCTAVE"];
-                    var gearModeName = gearModeNames[selector] || "SEMITONE";
-                    
-                    // Créer l'objet contrôleurs
-                    var controllers = {
-                        wheel: {
-                            position: wheelPos,  // 0-360 degrés (déjà converti par PureData)
-                            velocity: 0  // Non disponible dans ce format
-                        },
-                        joystick: {
-                            x: joyX,
-                            y: joyY,
-                            z: joyZ,
-                            button: joyBtn === 1
-                        },
-                        gearShift: {
-                            position: selector,      // 0-4 (5 vitesses)
-                            mode: gearModeName
-                        },
-                        fader: {
-                            value: fader
-                        },
-                        modPedal: {
-                            value: pedal,
-                            percent: (pedal / 127.0) * 100.0
-                        },
-                        pad1: {
-                            velocity: pad1Vel,
-                            aftertouch: pad1After,
-                            active: pad1Vel > 0
-                        },
-                        pad2: {
-                            velocity: pad2Vel,
-                            aftertouch: pad2After,
-                            active: pad2Vel > 0
-                        },
-                        buttons: {
-                            button1: btn1 === 1,
-                            button2: btn2 === 1
-                        },
-                        encoder: {
-                            value: encoderValue,
-                            pressed: encoderPressed
+            if (trafficRecorder.recording)
+                trafficRecorder.record(TrafficRecorder.Inbound, TrafficRecorder.WebSocketBinary, message);
+            controller.handleBinaryMessage(message);
+        }
+        
+        onTextMessageReceived: function(message) {
+            if (trafficRecorder.recording)
+                trafficRecorder.recordText(TrafficRecorder.Inbound, TrafficRecorder.WebSocketText, message);
+            controller.handleTextMessage(message);
+        }
+        
+        onStatusChanged: function(status) {
+            if (controller.debugMode || status === WebSocket.Error) { // Toujours logger les erreurs
+                switch(status) {
+                    case WebSocket.Error:
+                        break;
+                    case WebSocket.Open:
+                        // Marquer qu'on attend la config
+                        if (controller.configController) {
+                            controller.configController.waitingForConfig = true;
                         }
-                    };
-                    
-                    // 🔍 FILTRAGE: Vérifier si le changement est significatif (Solution 2)
-                    if (!controller.hasSignificantChange(controllers)) {
-                        // Changement insignifiant, ignorer ce message
-                        controller.droppedMessagesCount++
-                        return;
-                    }
-                    
-                    // ⏱️ THROTTLING: Accumuler et traiter avec délai (Solution 1)
-                    var data = {
-                        controllers: controllers,
-                        isControllersOnly: true,  // Flag pour identifier ce type de message
-                        timestamp: Date.now()
-                    };
-                    
-                    // Mise à jour du cache pour le prochain filtrage
-                    controller.updateControllerCache(controllers)
-                    
-                    // Accumuler le message (le dernier sera traité)
-                    controller.pendingControllersData = data
-                    
-                    // Démarrer le timer s'il n'est pas déjà en cours
-                    if (!controllersUpdateTimer.running) {
-                        controllersUpdateTimer.start()
-                    }
-                    
-                    return;
-                }
-                
-                // Format binaire 0x01 - POSITION : mesure seule (4 bytes) — Pd envoie mesure 0-based → passer 1-based au séquenceur
-                if (bytes.length === 4 && bytes[0] === 0x01) {
-                    var flags = bytes[1];
-                    var playing = (flags & 0x01) !== 0;
-                    var measure = bytes[2] | (bytes[3] << 8);
-                    controller.playbackPositionReceived(playing, measure + 1, 1, 1.0);
-                    return;
-                }
-                // Format binaire 0x01 - POSITION : tick seul (6 bytes) — JS dérive bar/beat depuis BPM/PPQ
-                if (bytes.length === 6 && bytes[0] === 0x01) {
-                    var flags = bytes[1];
-                    var playing = (flags & 0x01) !== 0;
-                    var tick = (bytes[2] | (bytes[3] << 8) | (bytes[4] << 16) | (bytes[5] << 24)) >>> 0;
-                    controller.playbackTickReceived(playing, tick);
-                    return;
-                }
-                // Format legacy 0x01 - POSITION (9 bytes) - bar, beatInBar, beat
-                if (bytes.length === 9 && bytes[0] === 0x01) {
-                    var flags = bytes[1];
-                    var playing = (flags & 0x01) !== 0;
-                    var bar = bytes[2] | (bytes[3] << 8);
-                    var beatInBar = bytes[4];
-                    var f0 = bytes[5], f1 = bytes[6], f2 = bytes[7], f3 = bytes[8];
-                    var beat = new DataView(Uint8Array.of(f0, f1, f2, f3).buffer).getFloat32(0, true);
-                    controller.playbackPositionReceived(playing, bar, beatInBar, beat);
-                    return;
-                }
-                
-                // Format binaire 0x03 - MIDI_NOTE_VOLANT (5 bytes)
-                if (bytes.length === 5 && bytes[0] === 0x03) {
-                    // Format: [0x03, note, velocity, bend_lsb, bend_msb]
-                    var note = bytes[1];
-                    var velocity = bytes[2];
-                    var bendLsb = bytes[3];
-                    var bendMsb = bytes[4];
-                    
-                    // Calculer le pitch bend (14 bits, centré à 8192)
-                    // bendLsb = 7 bits bas, bendMsb = 7 bits haut
-                    var pitchBend = bendLsb | (bendMsb << 7);
-                    var bendSemitones = ((pitchBend - 8192) / 8192.0) * 2.0;  // ±2 demi-tons
-                    
-                    // Note finale avec micro-tonalité
-                    var midiNote = note + bendSemitones;
-                    
-                    // Créer l'objet événement (va vers sirenController.midiNote)
-                    var event = {
-                        midiNote: midiNote,
-                        note: note,
-                        velocity: velocity,
-                        isVolantNote: true,  // Flag pour distinguer du séquenceur
-                        timestamp: Date.now()
-                    };
-                    
-                    // Transmettre l'événement
-                    controller.dataReceived(event);
-                    return;
+                        // Demander la configuration complète à PureData
+                        controller.sendBinaryMessage({
+                            type: "REQUEST_CONFIG"
+                        });
+                        break;
+                    case WebSocket.Closed:
+                        break;
                 }
+            }
+        }
+    }
+    
+    // Trames binaires du serveur, ou rejouées par trafficReplayer
+    function handleBinaryMessage(message) {
+        try {
+            var bytes = new Uint8Array(message);
+            
+            // 📊 Incrémenter compteur total de messages
+            controller.messageCountThisSecond++
+            
+            // Taille, type et plages validés par FrameDecoder (schémas de MecavivMessages.h) ;
+            // une trame refusée continue vers les formats suivants
+            var frameType = frameDecoder.frameType(message);
+            
+            // Format binaire pour CONTROLLERS (type 0x02, 18 bytes) - CONTRÔLEURS PHYSIQUES
+            var controllers = frameType === 0x02 ? frameDecoder.decodeControllers(message) : null;
+            if (controllers && controllers.wheel) {
+                // 📊 Incrémenter compteur de messages contrôleurs
+                controller.controllersMessageCountThisSecond++
                 
-                // Format binaire pour Control Change (3 bytes) - CC MIDI SÉQUENCE
-                if (bytes.length === 3 && bytes[0] === 0x05) {
-                    // Format: [0x05, CC_number, value]
-                    var ccNumber = bytes[1];
-                    var ccValue = bytes[2];  // 0-127
-                    
-                    // Émettre un signal pour les CC de séquence
-                    controller.controlChangeReceived(ccNumber, ccValue);
-                    return;
-                }
+                // Sorties CC mappées : toute la trame en une passe (avant filtrage/throttling)
+                controllerMapper.processFrame(message);
                 
-                // Format binaire optimisé pour les notes MIDI avec durée (5 bytes)
-                if (bytes.length === 5 && bytes[0] === 0x04) {
-                    // Format: [0x04, note, velocity, duration_lsb, duration_msb]
-                    var note = bytes[1];
-                    var velocity = bytes[2];
-                    var duration = bytes[3] + (bytes[4] << 8);  // Durée en ms (16 bits, max 65535ms = 65.5s)
-                    
-                    // Créer l'objet événement avec durée
-                    var event = {
-                        midiNote: note,
-                        note: note,
-                        velocity: velocity,
-                        duration: duration,
-                        timestamp: Date.now(),
-                        controllers: {},
-                        isSequence: true  // Flag pour différencier séquence/contrôleurs
-                    };
-                    
-                    // Transmettre l'événement
-                    controller.dataReceived(event);
-                    return;
-                }
+                // Alimente la prédiction à chaque trame, avant filtrage/throttling
+                wheelPredictor.pushWheelPosition(controllers.wheel.position);
                 
-                // Format binaire config (8+ bytes)
-                if (bytes.length < 8) {
+                // 🔍 FILTRAGE: Vérifier si le changement est significatif (Solution 2)
+                if (!controller.hasSignificantChange(controllers)) {
+                    // Changement insignifiant, ignorer ce message
+                    controller.droppedMessagesCount++
                     return;
                 }
                 
-                // Décoder les métadonnées (toujours présentes)
-                var totalSize = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
-                var position = bytes[4] | (bytes[5] << 8) | (bytes[6] << 16) | (bytes[7] << 24);
+                // ⏱️ THROTTLING: Accumuler et traiter avec délai (Solution 1)
+                var data = {
+                    controllers: controllers,
+                    isControllersOnly: true,  // Flag pour identifier ce type de message
+                    timestamp: Date.now()
+                };
                 
-                // Les données commencent à l'index 8
-                var dataLength = bytes.length - 8;
+                // Mise à jour du cache pour le prochain filtrage
+                controller.updateControllerCache(controllers)
                 
-                // Initialiser le buffer si nécessaire
-                if (!controller.binaryBuffer || controller.expectedSize !== totalSize) {
-                    controller.binaryBuffer = new Array(totalSize);
-                    controller.expectedSize = totalSize;
-                    controller.receivedBytes = 0;
-                }
+                // Accumuler le message (le dernier sera traité)
+                controller.pendingControllersData = data
                 
-                // Copier les données à la bonne position
-                for (var i = 0; i < dataLength; i++) {
-                    controller.binaryBuffer[position + i] = bytes[8 + i];
+                // Démarrer le timer s'il n'est pas déjà en cours
+                if (!controllersUpdateTimer.running) {
+                    controllersUpdateTimer.start()
                 }
-                controller.receivedBytes += dataLength;
                 
-                // Vérifier si on a tout reçu
-                if (controller.receivedBytes >= totalSize) {
-                    
-                    // Reconstruire le JSON
-                    var jsonString = "";
-                    for (var j = 0; j < totalSize; j++) {
-                        jsonString += String.fromCharCode(controller.binaryBuffer[j]);
-                    }
-                    
-                    var jsonData = JSON.parse(jsonString);
-                    if (jsonData.type === "CONFIG_FULL" && controller.configController) {
-                        controller.configController.updateFullConfig(jsonData.config);
-                    }
-                    
-                    // Réinitialiser
-                    controller.binaryBuffer = null;
-                    controller.expectedSize = 0;
-                    controller.receivedBytes = 0;
+                return;
+            }
+            
+            // Format binaire 0x01 - POSITION : mesure seule (4 bytes), tick seul (6 bytes) ou legacy (9 bytes)
+            var position = frameType === 0x01 ? frameDecoder.decodePosition(message) : null;
+            if (position && position.variant) {
+                if (position.variant === "measure") {
+                    // Pd envoie mesure 0-based → passer 1-based au séquenceur
+                    controller.playbackPositionReceived(position.playing, position.measure + 1, 1, 1.0);
+                } else if (position.variant === "tick") {
+                    // JS dérive bar/beat depuis BPM/PPQ
+                    controller.playbackTickReceived(position.playing, position.tick);
+                } else {
+                    controller.playbackPositionReceived(position.playing, position.measure, position.beatInBar, position.beat);
                 }
-            } catch (e) {
+                return;
+            }
+            
+            // Notes 0x03 (volant) et 0x04 (séquence), 5 octets ou 9 avec heure d'envoi :
+            // restituées par le tampon de lecture (voir noteBuffer)
+            if ((frameType === 0x03 || frameType === 0x04) && noteBuffer.pushFrame(message)) {
+                return;
+            }
+            
+            // Format binaire pour Control Change (3 bytes) - CC MIDI SÉQUENCE : [0x05, CC_number, value]
+            var cc = frameType === 0x05 ? frameDecoder.decodeControlChange(message) : null;
+            if (cc && cc.number !== undefined) {
+                // Émettre un signal pour les CC de séquence
+                controller.controlChangeReceived(cc.number, cc.value);
+                return;
+            }
+            
+            // Format binaire config (8+ bytes)
+            if (bytes.length < 8) {
+                return;
             }
+            
+            // Horloge de spectacle ("MCLK") : réponse à un ping ou ancre du séquenceur
+            if (showClock.handleFrame(message)) {
+                return;
+            }
+            
+            // Trames de sync de config ("MCFG") : snapshot ou patch versionné
+            if (configReplica.handleFrame(message)) {
+                return;
+            }
+            
+            // En-tête 8 octets (totalSize, position) : copie unique dans le buffer C++,
+            // le JSON complet est parsé hors du thread GUI (voir configFullReceived)
+            chunkReassembler.feedChunk(message);
+        } catch (e) {
         }
-        
-        // Alternative plus simple si PureData envoie en texte les métadonnées
-        onTextMessageReceived: function(message) {
-            try {
-                // Logs désactivés pour performance
+    }
+    
+    // Alternative plus simple si PureData envoie en texte les métadonnées
+    function handleTextMessage(message) {
+        try {
+            // Logs désactivés pour performance
+            
+            // Gérer les messages de contrôle binaire
+            if (message === "BINARY_END") {
+                // Forcer le traitement même si incomplet
+                chunkReassembler.flush();
+                return;
+            }
+            
+            // Gérer BINARY_START si envoyé en texte ("BINARY_START <taille> <taille de chunk>") ;
+            // la taille de chunk n'est plus utile, chaque chunk porte sa position
+            if (message.startsWith("BINARY_START")) {
+                var parts = message.split(" ");
+                if (parts.length >= 3) {
+                    chunkReassembler.begin(parseInt(parts[1]));
+                }
+                return;
+            }
+            
+            var data = JSON.parse(message);
+            
+            // Log spécifique pour PARAM_UPDATE avec uiControls (pour debug)
+            if (data.type === "PARAM_UPDATE" && data.path && Array.isArray(data.path) && 
+                data.path.length === 2 && data.path[0] === "uiControls" && data.path[1] === "enabled") {
+                console.log("🎨🎨🎨 UI_CONTROLS - Message reçu dans onTextMessageReceived - type:", data.type, "path:", JSON.stringify(data.path), "value:", data.value)
+            }
+            
+            // Logs désactivés pour performance
+            
+            // Mettre à jour les statistiques
+            controller.messageCount++
+            var now = new Date()
+            controller.lastMessageTime = now.toLocaleTimeString()
+            
+            // Logs désactivés pour performance
+            
+            // Gestion de la présence de la console
+            if (data.type === "CONSOLE_CONNECT") {
+                consoleConnected = true
+                if (controller.configController) controller.configController.consoleConnected = true
+                return
+            }
+            if (data.type === "CONSOLE_DISCONNECT") {
+                consoleConnected = false
+                if (controller.configController) controller.configController.consoleConnected = false
+                return
+            }
+
+            // AJOUTER : Traiter PARAM_UPDATE
+            if (data.type === "PARAM_UPDATE") {
+                // Log spécifique pour uiControls (préfixe unique pour filtrage)
+                if (data.path && Array.isArray(data.path) && data.path.length === 2 &&
+                    data.path[0] === "uiControls" && data.path[1] === "enabled") {
+                    console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE reçu - path:", JSON.stringify(data.path), "value:", data.value)
+                    var enabled = data.value !== undefined ? (data.value !== 0) : true
+                    console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - enabled calculé:", enabled, "rootWindow:", !!controller.rootWindow)
+                    if (controller.rootWindow && controller.rootWindow.uiControlsEnabled !== undefined) {
+                        console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - mise à jour uiControlsEnabled à:", enabled)
+                        controller.rootWindow.uiControlsEnabled = enabled
+                        console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - uiControlsEnabled mis à jour, nouvelle valeur:", controller.rootWindow.uiControlsEnabled)
+                    } else {
+                        console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - ERREUR: rootWindow ou uiControlsEnabled manquant")
+                    }
+                    return
+                }
                 
-                // Gérer les messages de contrôle binaire
-                if (message === "BINARY_END") {
-                    if (controller.receivingBinary && controller.binaryBuffer.length > 0) {
-                        // Forcer le traitement même si incomplet
-                        var jsonString = "";
-                        for (var i = 0; i < controller.binaryBuffer.length; i++) {
-                            jsonString += String.fromCharCode(controller.binaryBuffer[i]);
-                        }
-                        
-                        var jsonData = JSON.parse(jsonString);
-                        if (jsonData.type === "CONFIG_FULL") {
-                            if (controller.configController && jsonData.config) {
-                                controller.configController.updateFullConfig(jsonData.config);
-                            }
+                // Log début de chaîne pour frettedMode
+                if (data.path && Array.isArray(data.path) && data.path.length >= 4 && 
+                    data.path[0] === "sirenConfig" && data.path[1] === "sirens" && 
+                    data.path[3] === "frettedMode" && data.path[4] === "enabled") {
+                    var sirenIdentifier = data.path[2];
+                    // Vérifier si c'est un index ou un id
+                    var isIndex = typeof sirenIdentifier === "number";
+                    var sirenId = isIndex ? null : sirenIdentifier;
+                    var sirenIndex = isIndex ? sirenIdentifier : null;
+                    
+                    // Si c'est un index, essayer de trouver l'id correspondant
+                    if (controller.configController && isIndex) {
+                        var sirens = controller.configController.getValueAtPath(["sirenConfig", "sirens"], []);
+                        if (sirens[sirenIndex]) {
+                            sirenId = sirens[sirenIndex].id;
                         }
-                        
-                        controller.receivingBinary = false;
-                        controller.binaryBuffer = [];
                     }
-                    return;
+                    
+                    console.log("🎯 [WebSocket] Début chaîne - PARAM_UPDATE frettedMode reçu:", 
+                        "index:", sirenIndex, "id:", sirenId, "enabled:", data.value);
                 }
                 
-                // Gérer BINARY_START si envoyé en texte
-                if (message.startsWith("BINARY_START")) {
-                    var parts = message.split(" ");
-                    if (parts.length >= 3) {
-                        controller.expectedSize = parseInt(parts[1]);
-                        controller.chunkSize = parseInt(parts[2]);
-                        controller.binaryBuffer = [];
-                        controller.receivingBinary = true;
-                    }
+                if (!controller.configController) {
                     return;
                 }
                 
-                var data = JSON.parse(message);
-                
-                // Log spécifique pour PARAM_UPDATE avec uiControls (pour debug)
-                if (data.type === "PARAM_UPDATE" && data.path && Array.isArray(data.path) && 
-                    data.path.length === 2 && data.path[0] === "uiControls" && data.path[1] === "enabled") {
-                    console.log("🎨🎨🎨 UI_CONTROLS - Message reçu dans onTextMessageReceived - type:", data.type, "path:", JSON.stringify(data.path), "value:", data.value)
+                if (!data.path || !Array.isArray(data.path)) {
+                    return;
                 }
                 
-                // Logs désactivés pour performance
-                
-                // Mettre à jour les statistiques
-                controller.messageCount++
-                var now = new Date()
-                controller.lastMessageTime = now.toLocaleTimeString()
+                if (data.value === undefined) {
+                    return;
+                }
                 
-                // Logs désactivés pour performance
+                // Afficher le chemin complet pour debug
                 
-                // Gestion de la présence de la console
-                if (data.type === "CONSOLE_CONNECT") {
-                    consoleConnected = true
-                    if (controller.configController) controller.configController.consoleConnected = true
-                    return
-                }
-                if (data.type === "CONSOLE_DISCONNECT") {
-                    consoleConnected = false
-                    if (controller.configController) controller.configController.consoleConnected = false
-                    return
-                }
-
-                // AJOUTER : Traiter PARAM_UPDATE
-                if (data.type === "PARAM_UPDATE") {
-                    // Log spécifique pour uiControls (préfixe unique pour filtrage)
-                    if (data.path && Array.isArray(data.path) && data.path.length === 2 &&
-                        data.path[0] === "uiControls" && data.path[1] === "enabled") {
-                        console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE reçu - path:", JSON.stringify(data.path), "value:", data.value)
-                        var enabled = data.value !== undefined ? (data.value !== 0) : true
-                        console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - enabled calculé:", enabled, "rootWindow:", !!controller.rootWindow)
-                        if (controller.rootWindow && controller.rootWindow.uiControlsEnabled !== undefined) {
-                            console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - mise à jour uiControlsEnabled à:", enabled)
-                            controller.rootWindow.uiControlsEnabled = enabled
-                            console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - uiControlsEnabled mis à jour, nouvelle valeur:", controller.rootWindow.uiControlsEnabled)
-                        } else {
-                            console.log("🎨🎨🎨 UI_CONTROLS_PARAM_UPDATE - ERREUR: rootWindow ou uiControlsEnabled manquant")
-                        }
-                        return
-                    }
-                    
-                    // Log début de chaîne pour frettedMode
-                    if (data.path && Array.isArray(data.path) && data.path.length >= 4 && 
-                        data.path[0] === "sirenConfig" && data.path[1] === "sirens" && 
-                        data.path[3] === "frettedMode" && data.path[4] === "enabled") {
-                        var sirenIdentifier = data.path[2];
-                        // Vérifier si c'est un index ou un id
-                        var isIndex = typeof sirenIdentifier === "number";
-                        var sirenId = isIndex ? null : sirenIdentifier;
-                        var sirenIndex = isIndex ? sirenIdentifier : null;
-                        
-                        // Si c'est un index, essayer de trouver l'id correspondant
-                        if (controller.configController && isIndex) {
-                            var sirens = controller.configController.getValueAtPath(["sirenConfig", "sirens"], []);
-                            if (sirens[sirenIndex]) {
-                                sirenId = sirens[sirenIndex].id;
-                            }
-                        }
-                        
-                        console.log("🎯 [WebSocket] Début chaîne - PARAM_UPDATE frettedMode reçu:", 
-                            "index:", sirenIndex, "id:", sirenId, "enabled:", data.value);
-                    }
-                    
-                    if (!controller.configController) {
-                        return;
-                    }
-                    
-                    if (!data.path || !Array.isArray(data.path)) {
-                        return;
-                    }
-                    
-                    if (data.value === undefined) {
-                        return;
-                    }
+                // Appeler setValueAtPath et logger le résultat
+                try {
+                    // Transmettre la source pour éviter les renvois inutiles
+                    var result = controller.configController.setValueAtPath(data.path, data.value, data.source || "console");
                     
-                    // Afficher le chemin complet pour debug
+                    // Vérifier la valeur après modification
+                    var newValue = controller.configController.getValueAtPath(data.path);
                     
-                    // Appeler setValueAtPath et logger le résultat
-                    try {
-                        // Transmettre la source pour éviter les renvois inutiles
-                        var result = controller.configController.setValueAtPath(data.path, data.value, data.source || "console");
-                        
-                        // Vérifier la valeur après modification
-                        var newValue = controller.configController.getValueAtPath(data.path);
-                        
-                        if (newValue !== data.value && typeof newValue !== typeof data.value) {
-                        }
-                    } catch (e) {
+                    if (newValue !== data.value && typeof newValue !== typeof data.value) {
                     }
-                    
-                    return;
+                } catch (e) {
                 }
                 
-                // Après le bloc PARAM_UPDATE
-                if (data.type === "CONFIG_FULL") {
-                    if (controller.configController && data.config) {
-                        controller.configController.updateFullConfig(data.config);
-                    }
-                    return;
+                return;
+            }
+            
+            // Après le bloc PARAM_UPDATE
+            if (data.type === "CONFIG_FULL") {
+                if (data.config) {
+                    configReplica.seed(data.config);
                 }
-                
-                // MIDI_FILES_LIST - Liste des fichiers MIDI disponibles
-                if (data.type === "MIDI_FILES_LIST") {
-                    controller.filesListReceived(data.categories || []);
-                    return;
-                }
-                
-                // GAME_MODE - Changement de mode jeu/normal depuis le serveur (PureData)
-                if (data.type === "GAME_MODE") {
-                    var enabled = data.enabled || false;
-                    console.log("🎮 [WebSocket] Début chaîne - GAME_MODE reçu:", "enabled:", enabled);
-                    controller.gameModeReceived(enabled);
-                    return;
+                if (controller.configController && data.config) {
+                    controller.configController.updateFullConfig(data.config);
                 }
+                return;
+            }
+            
+            // MIDI_FILES_LIST - Liste des fichiers MIDI disponibles
+            if (data.type === "MIDI_FILES_LIST") {
+                controller.filesListReceived(data.categories || []);
+                return;
+            }
+            
+            // GAME_MODE - Changement de mode jeu/normal depuis le serveur (PureData)
+            if (data.type === "GAME_MODE") {
+                var enabled = data.enabled || false;
+                console.log("🎮 [WebSocket] Début chaîne - GAME_MODE reçu:", "enabled:", enabled);
+                controller.gameModeReceived(enabled);
+                return;
+            }
 
-                // PAD_CALIBRATION_VALUE - Valeur int16 à afficher sous le bouton (Pd envoie { type: "PAD_CALIBRATION_VALUE", pad: 0|1, value: int16 })
-                if (data.type === "PAD_CALIBRATION_VALUE") {
-                    var pad = (data.pad === 1) ? 1 : 0;
-                    var val = (typeof data.value === "number" && isFinite(data.value)) ? data.value : 0;
-                    if (val < -32768) val = -32768;
-                    if (val > 32767) val = 32767;
-                    controller.padCalibrationValueReceived(pad, val);
-                    return;
-                }
-                
-                // Code existant pour MUSIC_VISUALIZER
-                if (data.device === "MUSIC_VISUALIZER") {
-                    // Logs désactivés pour performance
-                    if (data.config) {
-                        controller.configReceived(data.config);
-                    } else {
-                        controller.dataReceived(data);
-                    }
+            // PAD_CALIBRATION_VALUE - Valeur int16 à afficher sous le bouton (Pd envoie { type: "PAD_CALIBRATION_VALUE", pad: 0|1, value: int16 })
+            if (data.type === "PAD_CALIBRATION_VALUE") {
+                var pad = (data.pad === 1) ? 1 : 0;
+                var val = (typeof data.value === "number" && isFinite(data.value)) ? data.value : 0;
+                if (val < -32768) val = -32768;
+                if (val > 32767) val = 32767;
+                controller.padCalibrationValueReceived(pad, val);
+                return;
+            }
+            
+            // Code existant pour MUSIC_VISUALIZER
+            if (data.device === "MUSIC_VISUALIZER") {
+                // Logs désactivés pour performance
+                if (data.config) {
+                    controller.configReceived(data.config);
                 } else {
-                    // Logs désactivés pour performance
-                    // Essayer de traiter comme données musicales par défaut
-                    if (data.midiNote !== undefined || data.controllers) {
-                        controller.dataReceived(data);
-                    }
+                    controller.dataReceived(data);
                 }
-            } catch (e) {
-            }
-        }
-        
-        onStatusChanged: function(status) {
-            if (controller.debugMode || status === WebSocket.Error) { // Toujours logger les erreurs
-                switch(status) {
-                    case WebSocket.Error:
-                        break;
-                    case WebSocket.Open:
-                        // Marquer qu'on attend la config
-                        if (controller.configController) {
-                            controller.configController.waitingForConfig = true;
-                        }
-                        // Demander la configuration complète à PureData
-                        controller.sendBinaryMessage({
-                            type: "REQUEST_CONFIG"
-                        });
-                        break;
-                    case WebSocket.Closed:
-                        break;
+            } else {
+                // Logs désactivés pour performance
+                // Essayer de traiter comme données musicales par défaut
+                if (data.midiNote !== undefined || data.controllers) {
+                    controller.dataReceived(data);
                 }
             }
+        } catch (e) {
+        }
+    }
+    
+    // Capture du trafic (MECAVIV_CAPTURE) et rejeu d'une capture (MECAVIV_REPLAY,
+    // MECAVIV_REPLAY_SPEED) : les trames rejouées suivent le chemin du réseau
+    TrafficRecorder {
+        id: trafficRecorder
+    }
+    
+    TrafficReplayer {
+        id: trafficReplayer
+        onFrameReplayed: function(channel, payload) {
+            controller.handleBinaryMessage(payload);
+        }
+        onTextFrameReplayed: function(channel, text) {
+            controller.handleTextMessage(text);
         }
     }
     
-    // Auto-connexion au démarrage
+    // Auto-connexion au démarrage (sauf rejeu : pas de serveur)
     Component.onCompleted: {
-        connect();
+        trafficRecorder.startFromEnvironment("pupitre");
+        if (!trafficReplayer.startFromEnvironment())
+            connect();
     }
     
     // Fonctions de contrôle
@@ -666,6 +651,8 @@ Item {
             }
             // Convertir le JSON en string puis en binaire
             var jsonString = JSON.stringify(message);
+            if (trafficRecorder.recording)
+                trafficRecorder.recordText(TrafficRecorder.Outbound, TrafficRecorder.WebSocketBinary, jsonString);
             socket.sendBinaryMessage(jsonString);
         }
     }
@@ -673,6 +660,8 @@ Item {
     // Fonction pour envoyer un vrai message binaire (ArrayBuffer)
     function sendRawBinaryMessage(buffer) {
         if (socket.status === WebSocket.Open) {
+            if (trafficRecorder.recording)
+                trafficRecorder.record(TrafficRecorder.Outbound, TrafficRecorder.WebSocketBinary, buffer);
             socket.sendBinaryMessage(buffer);
             return true;
         }
@@ -1,4 +1,5 @@
 import QtQuick
+import PupitreEngine 1.0
 import "../components/ambitus"
 import "."
 
@@ -12,6 +13,8 @@ Item {
     property bool isPlaying: false
 
     property var midiEvents: []
+    /** Horloge de spectacle partagée (ShowClock) : tous les pupitres comptent le temps sur la même base. */
+    property var showClock: null
     property real gameStartTime: 0
     property bool gameActive: false
     property bool isGameModeActive: true
@@ -221,8 +224,13 @@ Item {
         return segments
     }
     
+    // Heure de spectacle si disponible, sinon horloge locale
+    function nowMs() {
+        return root.showClock ? root.showClock.now() : Date.now()
+    }
+    
     function addMidiEvent(event) {
-        var elapsed = (root.gameStartTime > 0) ? (Date.now() - root.gameStartTime) : 0
+        var elapsed = (root.gameStartTime > 0) ? (root.nowMs() - root.gameStartTime) : 0
         var newEvents = midiEvents.slice()
         newEvents.push({
             timestamp: elapsed,
@@ -235,12 +243,55 @@ Item {
         midiEvents = newEvents
     }
     
+    // Retire les événements sortis de la fenêtre affichée (plus vieux qu'une chute complète) ;
+    // sans cela midiEvents grossit pendant tout le morceau
+    function trimPastEvents() {
+        var cutoff = root._currentTimeMs - root.fixedFallTime
+        var first = 0
+        while (first < midiEvents.length && midiEvents[first].timestamp < cutoff)
+            first++
+        if (first > 0)
+            midiEvents = midiEvents.slice(first)
+    }
+
+    Connections {
+        target: MemoryMonitor
+        function onCollecting() {
+            // Estimation : ~160 octets par événement (objet JS + contrôleurs)
+            MemoryMonitor.report("game", "midiEvents", root.midiEvents.length, root.midiEvents.length * 160)
+        }
+        function onEvictRequested(pressure) {
+            root.trimPastEvents()
+        }
+    }
+    
     // Fonction pour démarrer le jeu
     function startGame() {
-        gameStartTime = Date.now()
+        // Séquenceur de la console en lecture : origine commune à tous les pupitres (tick 0).
+        // playbackOriginMs ne connaît que le tempo courant : si le morceau a changé de tempo
+        // avant la position actuelle, l'origine est décalée d'autant (exacte quand la lecture
+        // part du début : l'ancre de départ est alors au tick 0, voir onAnchorChanged)
+        if (root.showClock && root.showClock.playing && root.showClock.playbackOriginMs > 0)
+            gameStartTime = root.showClock.playbackOriginMs
+        else
+            gameStartTime = root.nowMs()
         gameActive = true
     }
     
+    // Départ du séquenceur après startGame() : on se recale sur son origine.
+    // Les ancres suivantes (tempo, seek) ne déplacent pas les notes déjà reçues ; l'origine
+    // n'est donc jamais relue après un changement de tempo (playbackOriginMs = tempo unique).
+    property bool _sequencerWasPlaying: false
+    Connections {
+        target: root.showClock
+        function onAnchorChanged() {
+            var playing = root.showClock.playing
+            if (playing && !root._sequencerWasPlaying && root.gameActive && root.showClock.playbackOriginMs > 0)
+                root.gameStartTime = root.showClock.playbackOriginMs
+            root._sequencerWasPlaying = playing
+        }
+    }
+    
     // Fonction pour réinitialiser le mode jeu (appelée lors d'un stop)
     function resetGame() {
         // Vider les événements MIDI
@@ -306,7 +357,7 @@ Item {
         running: root.isPlaying && root.gameStartTime > 0
         repeat: true
         onTriggered: {
-            root._currentTimeMs = Date.now() - root.gameStartTime
+            root._currentTimeMs = root.nowMs() - root.gameStartTime
         }
     }
 }
@@ -1,4 +1,5 @@
 import QtQuick
+import PupitreEngine 1.0
 import "../components/ambitus"
 import "."
 import "GameSequencer.js" as GameSequencer
@@ -143,6 +144,25 @@ Item {
         }
     }
 
+    // Oublie les notes détruites en fin de chute (sinon la clé reste tant que le segment ne revient pas)
+    function pruneSegmentNotes() {
+        for (var k in _segmentNotes) {
+            var note = _segmentNotes[k]
+            if (!note || !note.parent)
+                delete _segmentNotes[k]
+        }
+    }
+
+    Connections {
+        target: MemoryMonitor
+        function onCollecting() {
+            MemoryMonitor.report("game", "segmentNotes", Object.keys(root._segmentNotes).length, 0)
+        }
+        function onEvictRequested(pressure) {
+            root.pruneSegmentNotes()
+        }
+    }
+
     function clearAllNotes() {
         for (var i = root.children.length - 1; i >= 0; i--) {
             var child = root.children[i]
@@ -48,6 +48,7 @@ Page {
     // Référence au GameMode (overlay) pour que Main puisse envoyer les événements MIDI séquence
     property var _gameModeItem: null
     property var gameModeItem: _gameModeItem
+    property bool _gameOverlayLoaded: false  // overlay de jeu créé (premier passage en mode jeu)
 
     // Options mode jeu (liées à GameMode)
     property bool showAnticipationLine: false
@@ -63,8 +64,10 @@ Page {
                 root.rootWindow.userRequestedStop = false
                 root.rootWindow.isGamePlaying = false
             }
-            if (sequencerController)
-                sequencerController.reset()
+            // Première entrée : l'overlay est créé avec un séquenceur neuf
+            var sequencer = gameOverlayLoader.item ? gameOverlayLoader.item.sequencer : null
+            if (sequencer)
+                sequencer.reset()
             root.transportDisplayActive = false
         } else {
             root._gameModeItem = null
@@ -73,8 +76,9 @@ Page {
     }
 
     function updateControllers(controllersData) {
-        if (controllersPanel && controllersPanel.updateControllers) {
-            controllersPanel.updateControllers(controllersData)
+        var panel = controllersPanelLoader.item
+        if (panel && panel.updateControllers) {
+            panel.updateControllers(controllersData)
         }
         if (configController && controllersData && controllersData.gearShift !== undefined) {
             var pos = controllersData.gearShift.position || 0
@@ -83,8 +87,9 @@ Page {
     }
 
     function setPadCalibrationDisplayValue(pad, value) {
-        if (controllersPanel && controllersPanel.setPadCalibrationValue)
-            controllersPanel.setPadCalibrationValue(pad, value)
+        var panel = controllersPanelLoader.item
+        if (panel && panel.setPadCalibrationValue)
+            panel.setPadCalibrationValue(pad, value)
     }
 
     Rectangle {
@@ -171,20 +176,30 @@ Page {
                 configController: root.configController
             }
 
-            ControllersPanel {
-                id: controllersPanel
+            // Panneau contrôleurs (test matériel, calibration) : instancié au premier affichage puis conservé
+            Loader {
+                id: controllersPanelLoader
                 anchors.bottom: parent.bottom
                 anchors.left: parent.left
                 anchors.right: parent.right
                 height: Math.max(280, parent.height * 0.42)
                 z: 200  // Au-dessus de la portée (z:1) et du gameModeOverlay (z:100)
-                configController: root.configController
-                webSocketController: root.webSocketController
-                visible: configController ? configController.getValueAtPath(["controllersPanel", "visible"], false) : false
+                property bool shown: root.configController ? root.configController.getValueAtPath(["controllersPanel", "visible"], false) : false
+                property bool used: false
+                visible: shown
+                active: shown || used
+                onLoaded: used = true
+
+                sourceComponent: Component {
+                    ControllersPanel {
+                        configController: root.configController
+                        webSocketController: root.webSocketController
+                    }
+                }
             }
 
             Test2DButtons {
-                controllersPanelVisible: controllersPanel.visible
+                controllersPanelVisible: controllersPanelLoader.shown
                 configController: root.configController
                 uiControlsEnabled: root.uiControlsEnabled
                 gameMode: root.gameMode
@@ -196,11 +211,11 @@ Page {
                         var v = configController.getValueAtPath(["controllersPanel", "visible"], false)
                         var newValue = !v
                         configController.setValueAtPath(["controllersPanel", "visible"], newValue)
-                        controllersPanel.visible = newValue  // Mise à jour immédiate
+                        controllersPanelLoader.shown = newValue  // Mise à jour immédiate
                         console.log("🎮 [Test2D] Contrôleurs:", newValue ? "affichés" : "masqués")
                     } else {
-                        controllersPanel.visible = !controllersPanel.visible
-                        console.log("🎮 [Test2D] Contrôleurs (sans config):", controllersPanel.visible ? "affichés" : "masqués")
+                        controllersPanelLoader.shown = !controllersPanelLoader.shown
+                        console.log("🎮 [Test2D] Contrôleurs (sans config):", controllersPanelLoader.shown ? "affichés" : "masqués")
                     }
                 }
                 onToggleGameMode: {
@@ -230,318 +245,332 @@ Page {
             }
         }
 
-        // Overlay mode jeu : séquenceur partagé + portée 2D + transport (visible quand gameMode)
-        Item {
-            id: gameModeOverlay
+        // Overlay mode jeu : séquenceur partagé + portée 2D + transport (visible quand gameMode).
+        // Instancié à la première entrée en mode jeu puis conservé : la vue de jeu ne pèse pas sur le démarrage.
+        Loader {
+            id: gameOverlayLoader
             z: 100
             anchors.fill: parent
             visible: root.gameMode
+            active: root.gameMode || root._gameOverlayLoaded
+            sourceComponent: gameOverlayComponent
+            onLoaded: root._gameOverlayLoaded = true
+        }
 
-            Rectangle {
-                anchors.fill: parent
-                color: root.backgroundColor
-            }
+        Component {
+            id: gameOverlayComponent
 
-            // Séquenceur indépendant du jeu (mesure, temps, tempo, MIDI) — consommé par transport et jeux
-            SequencerController {
-                id: sequencerController
-                configController: root.configController
-                rootWindow: root.rootWindow
-            }
+            Item {
+                id: gameModeOverlay
+                property alias sequencer: sequencerController
 
-            // Options affichage (ligne d'anticipation, barres de mesure) — bindings vers GameMode
-            Column {
-                anchors.right: parent.right
-                anchors.bottom: parent.bottom
-                anchors.margins: 20
-                z: 10
-                spacing: 8
-                CheckBox {
-                    text: "Ligne d'anticipation"
-                    checked: root.showAnticipationLine
-                    onCheckedChanged: root.showAnticipationLine = checked
-                    palette.buttonText: "#fff"
-                }
-                CheckBox {
-                    text: "Barres de mesure"
-                    checked: root.showMeasureBars
-                    onCheckedChanged: root.showMeasureBars = checked
-                    palette.buttonText: "#fff"
+                Rectangle {
+                    anchors.fill: parent
+                    color: root.backgroundColor
                 }
-            }
 
-            // Transport : mesure, temps, tempo (à gauche du Play) — encadré large pour mesure complète et durée totale
-            Rectangle {
-                id: positionInSongFrame
-                anchors.bottom: parent.bottom
-                anchors.bottomMargin: 20
-                x: parent.width * 0.25 - 140 / 2 - 12 - width
-                width: 220
-                height: 88
-                z: 10
-                color: "#2a2a2a"
-                border.color: "#6bb6ff"
-                border.width: 2
-                radius: 5
+                // Séquenceur indépendant du jeu (mesure, temps, tempo, MIDI) — consommé par transport et jeux
+                SequencerController {
+                    id: sequencerController
+                    configController: root.configController
+                    rootWindow: root.rootWindow
+                }
 
+                // Options affichage (ligne d'anticipation, barres de mesure) — bindings vers GameMode
                 Column {
-                    anchors.centerIn: parent
-                    spacing: 6
-                    Row {
-                        spacing: 8
-                        Text { text: "Mesure"; color: "#888"; font.pixelSize: 9; width: 44 }
-                        Text {
-                            text: root.transportDisplayActive && sequencerController
-                                ? (sequencerController.positionDisplayText + " / " + (sequencerController.totalBars > 0 ? sequencerController.totalBars : "—"))
-                                : "— / —"
-                            color: "#fff"
-                            font.pixelSize: 12
-                            font.bold: true
-                        }
+                    anchors.right: parent.right
+                    anchors.bottom: parent.bottom
+                    anchors.margins: 20
+                    z: 10
+                    spacing: 8
+                    CheckBox {
+                        text: "Ligne d'anticipation"
+                        checked: root.showAnticipationLine
+                        onCheckedChanged: root.showAnticipationLine = checked
+                        palette.buttonText: "#fff"
                     }
-                    Row {
-                        spacing: 8
-                        Text { text: "Temps"; color: "#888"; font.pixelSize: 9; width: 44 }
-                        Text {
-                            text: root.transportDisplayActive && sequencerController
-                                ? (sequencerController.currentTimeDisplay + " / " + sequencerController.totalTimeDisplay)
-                                : "— / —"
-                            color: "#fff"
-                            font.pixelSize: 12
-                        }
+                    CheckBox {
+                        text: "Barres de mesure"
+                        checked: root.showMeasureBars
+                        onCheckedChanged: root.showMeasureBars = checked
+                        palette.buttonText: "#fff"
                     }
-                    Row {
-                        spacing: 8
-                        Text { text: "Tempo"; color: "#888"; font.pixelSize: 9; width: 44 }
-                        Text {
-                            text: root.transportDisplayActive && sequencerController
-                                ? (Math.round(sequencerController.currentTempoBpm) + " BPM")
-                                : "—"
-                            color: "#fff"
-                            font.pixelSize: 12
+                }
+
+                // Transport : mesure, temps, tempo (à gauche du Play) — encadré large pour mesure complète et durée totale
+                Rectangle {
+                    id: positionInSongFrame
+                    anchors.bottom: parent.bottom
+                    anchors.bottomMargin: 20
+                    x: parent.width * 0.25 - 140 / 2 - 12 - width
+                    width: 220
+                    height: 88
+                    z: 10
+                    color: "#2a2a2a"
+                    border.color: "#6bb6ff"
+                    border.width: 2
+                    radius: 5
+
+                    Column {
+                        anchors.centerIn: parent
+                        spacing: 6
+                        Row {
+                            spacing: 8
+                            Text { text: "Mesure"; color: "#888"; font.pixelSize: 9; width: 44 }
+                            Text {
+                                text: root.transportDisplayActive && sequencerController
+                                    ? (sequencerController.positionDisplayText + " / " + (sequencerController.totalBars > 0 ? sequencerController.totalBars : "—"))
+                                    : "— / —"
+                                color: "#fff"
+                                font.pixelSize: 12
+                                font.bold: true
+                            }
+                        }
+                        Row {
+                            spacing: 8
+                            Text { text: "Temps"; color: "#888"; font.pixelSize: 9; width: 44 }
+                            Text {
+                                text: root.transportDisplayActive && sequencerController
+                                    ? (sequencerController.currentTimeDisplay + " / " + sequencerController.totalTimeDisplay)
+                                    : "— / —"
+                                color: "#fff"
+                                font.pixelSize: 12
+                            }
+                        }
+                        Row {
+                            spacing: 8
+                            Text { text: "Tempo"; color: "#888"; font.pixelSize: 9; width: 44 }
+                            Text {
+                                text: root.transportDisplayActive && sequencerController
+                                    ? (Math.round(sequencerController.currentTempoBpm) + " BPM")
+                                    : "—"
+                                color: "#fff"
+                                font.pixelSize: 12
+                            }
                         }
                     }
                 }
-            }
 
-            // Play/Stop (en bas à gauche, 1/4)
-            Rectangle {
-                id: playStopButton
-                anchors.bottom: parent.bottom
-                anchors.bottomMargin: 20
-                x: parent.width * 0.25 - width / 2
-                width: 140
-                height: 60
-                z: 10
-                color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#1a5a3a" : "#2a2a2a"
-                border.color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#4ade80" : "#6bb6ff"
-                border.width: 2
-                radius: 5
-
-                SequentialAnimation on opacity {
-                    running: root.rootWindow && root.rootWindow.isGamePlaying
-                    loops: Animation.Infinite
-                    NumberAnimation { from: 1.0; to: 0.7; duration: 800 }
-                    NumberAnimation { from: 0.7; to: 1.0; duration: 800 }
-                }
+                // Play/Stop (en bas à gauche, 1/4)
+                Rectangle {
+                    id: playStopButton
+                    anchors.bottom: parent.bottom
+                    anchors.bottomMargin: 20
+                    x: parent.width * 0.25 - width / 2
+                    width: 140
+                    height: 60
+                    z: 10
+                    color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#1a5a3a" : "#2a2a2a"
+                    border.color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#4ade80" : "#6bb6ff"
+                    border.width: 2
+                    radius: 5
+
+                    SequentialAnimation on opacity {
+                        running: root.rootWindow && root.rootWindow.isGamePlaying
+                        loops: Animation.Infinite
+                        NumberAnimation { from: 1.0; to: 0.7; duration: 800 }
+                        NumberAnimation { from: 0.7; to: 1.0; duration: 800 }
+                    }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (root.webSocketController) {
-                            var playing = root.rootWindow && root.rootWindow.isGamePlaying
-                            var newPlaying = !playing
-                            if (newPlaying) {
-                                if (root.rootWindow) {
-                                    root.rootWindow.userRequestedStop = false
-                                    root.rootWindow.isGamePlaying = true
-                                }
-                                if (sequencerController)
-                                    sequencerController.startFromZero()
-                                if (root._gameModeItem && typeof root._gameModeItem.startGame === "function")
-                                    root._gameModeItem.startGame()
-                                root.transportDisplayActive = true
-                                root.webSocketController.sendBinaryMessage({
-                                    type: "MIDI_TRANSPORT",
-                                    action: "play",
-                                    midiDelayMs: 5000,
-                                    source: "pupitre"
-                                })
-                            } else {
-                                root.transportDisplayActive = false
-                                root.webSocketController.sendBinaryMessage({
-                                    type: "MIDI_TRANSPORT",
-                                    action: "stop",
-                                    source: "pupitre"
-                                })
-                                if (root.rootWindow) {
-                                    root.rootWindow.userRequestedStop = true
-                                    root.rootWindow.isGamePlaying = false
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            if (root.webSocketController) {
+                                var playing = root.rootWindow && root.rootWindow.isGamePlaying
+                                var newPlaying = !playing
+                                if (newPlaying) {
+                                    if (root.rootWindow) {
+                                        root.rootWindow.userRequestedStop = false
+                                        root.rootWindow.isGamePlaying = true
+                                    }
+                                    if (sequencerController)
+                                        sequencerController.startFromZero()
+                                    if (root._gameModeItem && typeof root._gameModeItem.startGame === "function")
+                                        root._gameModeItem.startGame()
+                                    root.transportDisplayActive = true
+                                    root.webSocketController.sendBinaryMessage({
+                                        type: "MIDI_TRANSPORT",
+                                        action: "play",
+                                        midiDelayMs: 5000,
+                                        source: "pupitre"
+                                    })
+                                } else {
+                                    root.transportDisplayActive = false
+                                    root.webSocketController.sendBinaryMessage({
+                                        type: "MIDI_TRANSPORT",
+                                        action: "stop",
+                                        source: "pupitre"
+                                    })
+                                    if (root.rootWindow) {
+                                        root.rootWindow.userRequestedStop = true
+                                        root.rootWindow.isGamePlaying = false
+                                    }
                                 }
                             }
                         }
                     }
+                    Column {
+                        anchors.centerIn: parent
+                        spacing: 5
+                        Text {
+                            text: (root.rootWindow && root.rootWindow.isGamePlaying) ? "⏹ Stop" : "▶︎ Play"
+                            color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#4ade80" : "#fff"
+                            font.pixelSize: 14
+                            font.bold: true
+                            anchors.horizontalCenter: parent.horizontalCenter
+                        }
+                        Text {
+                            text: "↓ Bouton physique"
+                            color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#4ade80" : "#888"
+                            font.pixelSize: 10
+                            anchors.horizontalCenter: parent.horizontalCenter
+                        }
+                    }
                 }
-                Column {
-                    anchors.centerIn: parent
-                    spacing: 5
+
+                // Mode Normal (en bas à droite, 3/4 — même position que Mode Jeu en vue normale)
+                Rectangle {
+                    anchors.bottom: parent.bottom
+                    anchors.bottomMargin: 20
+                    x: parent.width * 0.75 - width / 2
+                    width: 140
+                    height: 60
+                    z: 10
+                    color: "#00CED1"
+                    border.color: "#00CED1"
+                    border.width: 2
+                    radius: 5
+
                     Text {
-                        text: (root.rootWindow && root.rootWindow.isGamePlaying) ? "⏹ Stop" : "▶︎ Play"
-                        color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#4ade80" : "#fff"
+                        anchors.centerIn: parent
+                        text: "Mode Normal"
+                        color: "#000"
                         font.pixelSize: 14
                         font.bold: true
-                        anchors.horizontalCenter: parent.horizontalCenter
                     }
-                    Text {
-                        text: "↓ Bouton physique"
-                        color: (root.rootWindow && root.rootWindow.isGamePlaying) ? "#4ade80" : "#888"
-                        font.pixelSize: 10
-                        anchors.horizontalCenter: parent.horizontalCenter
+
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            if (root.setGameMode2D) {
+                                root.setGameMode2D(false)
+                                if (root.webSocketController) {
+                                    root.webSocketController.sendBinaryMessage({
+                                        type: "GAME_MODE",
+                                        enabled: false,
+                                        source: "pupitre"
+                                    })
+                                }
+                            } else if (root.rootWindow) {
+                                root.rootWindow.gameMode = false
+                                if (root.webSocketController) {
+                                    root.webSocketController.sendBinaryMessage({
+                                        type: "GAME_MODE",
+                                        enabled: false,
+                                        source: "pupitre"
+                                    })
+                                }
+                            }
+                        }
                     }
                 }
-            }
 
-            // Mode Normal (en bas à droite, 3/4 — même position que Mode Jeu en vue normale)
-            Rectangle {
-                anchors.bottom: parent.bottom
-                anchors.bottomMargin: 20
-                x: parent.width * 0.75 - width / 2
-                width: 140
-                height: 60
-                z: 10
-                color: "#00CED1"
-                border.color: "#00CED1"
-                border.width: 2
-                radius: 5
-
-                Text {
-                    anchors.centerIn: parent
-                    text: "Mode Normal"
-                    color: "#000"
-                    font.pixelSize: 14
-                    font.bold: true
-                }
+                Item {
+                    id: gameOverlayStaffZone
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    anchors.leftMargin: 24
+                    anchors.rightMargin: 24
+                    anchors.verticalCenter: parent.verticalCenter
+                    anchors.verticalCenterOffset: 110
+                    height: 145
+
+                    StaffZone2D {
+                        anchors.fill: parent
+                        accentColor: root.accentColor
+                        currentNoteMidi: root.displayNoteForStaff
+                        sirenInfo: root.sirenInfo
+                        configController: root.configController
+                        rpm: root.rpm
+                        frequency: root.frequency
+                        lineSpacing: 16
+                        lineThickness: 1.5
+                    }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (root.setGameMode2D) {
-                            root.setGameMode2D(false)
-                            if (root.webSocketController) {
-                                root.webSocketController.sendBinaryMessage({
-                                    type: "GAME_MODE",
-                                    enabled: false,
-                                    source: "pupitre"
-                                })
-                            }
-                        } else if (root.rootWindow) {
-                            root.rootWindow.gameMode = false
-                            if (root.webSocketController) {
-                                root.webSocketController.sendBinaryMessage({
-                                    type: "GAME_MODE",
-                                    enabled: false,
-                                    source: "pupitre"
-                                })
+                    Loader {
+                        id: gameModeLoader
+                        anchors.fill: parent
+                        z: 1
+                        active: root.gameMode
+                        source: "../game/GameMode.qml"
+                        onLoaded: {
+                            if (item) {
+                                item.configController = root.configController
+                                item.showClock = root.webSocketController ? root.webSocketController.showClock : null
+                                item.sirenInfo = root.sirenInfo
+                                item.lineSpacing = 16
+                                item.staffWidth = gameOverlayStaffZone.width
+                                item.staffPosX = 0
+                                item.currentNoteMidi = Qt.binding(function() { return root.clampedNote })
+                                item.showAnticipationLine = Qt.binding(function() { return root.showAnticipationLine })
+                                item.showMeasureBars = Qt.binding(function() { return root.showMeasureBars })
+                                item.isPlaying = Qt.binding(function() { return !!(root.rootWindow && root.rootWindow.isGamePlaying) })
+                                root._gameModeItem = item
                             }
                         }
+                        onStatusChanged: {
+                            if (status === Loader.Null || status === Loader.Error)
+                                root._gameModeItem = null
+                        }
                     }
                 }
-            }
 
-            Item {
-                id: gameOverlayStaffZone
-                anchors.left: parent.left
-                anchors.right: parent.right
-                anchors.leftMargin: 24
-                anchors.rightMargin: 24
-                anchors.verticalCenter: parent.verticalCenter
-                anchors.verticalCenterOffset: 110
-                height: 145
+                Row {
+                    anchors.horizontalCenter: parent.horizontalCenter
+                    anchors.bottom: parent.bottom
+                    anchors.bottomMargin: 70
+                    spacing: 80
+
+                    NumberDisplay2D {
+                        width: 180
+                        height: 72
+                        value: root.rpm
+                        label: "RPM"
+                        digitColor: root.accentColor
+                        inactiveColor: "#003333"
+                        frameColor: root.accentColor
+                        scaleX: 1.6 * root.uiScale
+                        scaleY: 0.75 * root.uiScale
+                    }
 
-                StaffZone2D {
-                    anchors.fill: parent
-                    accentColor: root.accentColor
-                    currentNoteMidi: root.displayNoteForStaff
-                    sirenInfo: root.sirenInfo
-                    configController: root.configController
-                    rpm: root.rpm
-                    frequency: root.frequency
-                    lineSpacing: 16
-                    lineThickness: 1.5
+                    NumberDisplay2D {
+                        width: 180
+                        height: 72
+                        value: root.frequency
+                        label: "Hz"
+                        digitColor: root.accentColor
+                        inactiveColor: "#003333"
+                        frameColor: root.accentColor
+                        scaleX: 1.4 * root.uiScale
+                        scaleY: 0.65 * root.uiScale
+                    }
                 }
 
                 Loader {
-                    id: gameModeLoader
+                    id: gameAutonomyLoader
                     anchors.fill: parent
-                    z: 1
                     active: root.gameMode
-                    source: "../game/GameMode.qml"
+                    source: "../game/GameAutonomyPanel.qml"
                     onLoaded: {
                         if (item) {
                             item.configController = root.configController
-                            item.sirenInfo = root.sirenInfo
-                            item.lineSpacing = 16
-                            item.staffWidth = gameOverlayStaffZone.width
-                            item.staffPosX = 0
-                            item.currentNoteMidi = Qt.binding(function() { return root.clampedNote })
-                            item.showAnticipationLine = Qt.binding(function() { return root.showAnticipationLine })
-                            item.showMeasureBars = Qt.binding(function() { return root.showMeasureBars })
-                            item.isPlaying = Qt.binding(function() { return !!(root.rootWindow && root.rootWindow.isGamePlaying) })
-                            root._gameModeItem = item
+                            item.rootWindow = root.rootWindow
+                            item.sequencer = sequencerController
+                            item.gameMode = Qt.binding(function() { return root.gameModeItem })
                         }
                     }
-                    onStatusChanged: {
-                        if (status === Loader.Null || status === Loader.Error)
-                            root._gameModeItem = null
-                    }
-                }
-            }
-
-            Row {
-                anchors.horizontalCenter: parent.horizontalCenter
-                anchors.bottom: parent.bottom
-                anchors.bottomMargin: 70
-                spacing: 80
-
-                NumberDisplay2D {
-                    width: 180
-                    height: 72
-                    value: root.rpm
-                    label: "RPM"
-                    digitColor: root.accentColor
-                    inactiveColor: "#003333"
-                    frameColor: root.accentColor
-                    scaleX: 1.6 * root.uiScale
-                    scaleY: 0.75 * root.uiScale
-                }
-
-                NumberDisplay2D {
-                    width: 180
-                    height: 72
-                    value: root.frequency
-                    label: "Hz"
-                    digitColor: root.accentColor
-                    inactiveColor: "#003333"
-                    frameColor: root.accentColor
-                    scaleX: 1.4 * root.uiScale
-                    scaleY: 0.65 * root.uiScale
-                }
-            }
-
-            Loader {
-                id: gameAutonomyLoader
-                anchors.fill: parent
-                active: root.gameMode
-                source: "../game/GameAutonomyPanel.qml"
-                onLoaded: {
-                    if (item) {
-                        item.configController = root.configController
-                        item.rootWindow = root.rootWindow
-                        item.sequencer = sequencerController
-                        item.gameMode = Qt.binding(function() { return root.gameModeItem })
-                    }
                 }
             }
         }
@@ -1,5 +1,4 @@
 import QtQuick
-import "./LEDText2D.qml"
 
 Item {
     id: root
@@ -0,0 +1,238 @@
+#include "chunkreassembler.h"
+#include "MecavivMessages.h"
+#include <QCborMap>
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#if QT_CONFIG(thread)
+#include <QThreadPool>
+#endif
+#include <cstring>
+
+namespace {
+
+static_assert(ChunkReassembler::HeaderSize == int(MecavivProtocol::ChunkHeader::Size), "en-tête de chunk : 8 octets");
+
+int popcount64(quint64 v)
+{
+    int count = 0;
+    while (v) {
+        v &= v - 1;
+        ++count;
+    }
+    return count;
+}
+
+}
+
+ChunkReassembler::ChunkReassembler(QObject *parent)
+    : QObject(parent)
+    , m_expectedSize(0)
+    , m_receivedBytes(0)
+    , m_duplicateBytes(0)
+    , m_completedMessages(0)
+    , m_maxMessageSize(64 * 1024 * 1024)
+    , m_nextSequence(1)
+    , m_deliveredSequence(0)
+    , m_memory("network", "ChunkReassembler", [this] {
+          return MecavivMemory::Usage { 1, qint64(m_buffer.capacity())
+                                               + qint64(m_coverage.capacity() * sizeof(quint64)) };
+      })
+{
+}
+
+qreal ChunkReassembler::progress() const
+{
+    return m_expectedSize > 0 ? qreal(m_receivedBytes) / m_expectedSize : 0.0;
+}
+
+void ChunkReassembler::setMaxMessageSize(int size)
+{
+    if (m_maxMessageSize == size)
+        return;
+    m_maxMessageSize = qMax(HeaderSize, size);
+    emit maxMessageSizeChanged();
+}
+
+bool ChunkReassembler::feedChunk(const QByteArray &chunk)
+{
+    // En-tête [taille totale u32 LE][position u32 LE] et bornes validés par MecavivMessages.h
+    MecavivProtocol::ChunkHeader header;
+    if (MecavivProtocol::ChunkHeader::decode(reinterpret_cast<const std::uint8_t *>(chunk.constData()),
+                                             size_t(chunk.size()), header, quint32(m_maxMessageSize))
+        != MecavivProtocol::Status::Ok) {
+        return false;
+    }
+    const quint32 totalSize = header.totalSize;
+    const quint32 position = header.position;
+    const int dataLength = chunk.size() - HeaderSize;
+
+    const int begin = int(position);
+
+    // Nouveau message (ou taille différente = transfert précédent abandonné)
+    if (m_expectedSize != int(totalSize)
+        || startsNewTransfer(begin, chunk.constData() + HeaderSize, dataLength)) {
+        startTransfer(int(totalSize));
+    }
+    m_lastChunk.start();
+
+    const int end = begin + dataLength;
+    const int fresh = markCovered(begin, end);
+
+    // Copie unique dans le buffer préalloué (un doublon réécrit les mêmes octets)
+    std::memcpy(m_buffer.data() + begin, chunk.constData() + HeaderSize, size_t(dataLength));
+    m_receivedBytes += fresh;
+    if (fresh < dataLength) {
+        m_duplicateBytes += dataLength - fresh;
+        emit statsChanged();
+    }
+
+    if (m_receivedBytes == m_expectedSize) {
+        QByteArray payload = std::move(m_buffer);
+        m_buffer = QByteArray();
+        m_coverage.clear();
+        m_expectedSize = 0;
+        m_receivedBytes = 0;
+        dispatchParse(std::move(payload));
+    }
+
+    emit progressChanged();
+    return true;
+}
+
+void ChunkReassembler::begin(int totalSize)
+{
+    if (totalSize <= 0 || totalSize > m_maxMessageSize)
+        return;
+    startTransfer(totalSize);
+    emit progressChanged();
+}
+
+void ChunkReassembler::flush()
+{
+    if (m_expectedSize == 0 || m_receivedBytes == 0)
+        return;
+
+    // Comme l'ancien BINARY_END : on tente le parsing même si incomplet
+    QByteArray payload = std::move(m_buffer);
+    m_buffer = QByteArray();
+    m_coverage.clear();
+    m_expectedSize = 0;
+    m_receivedBytes = 0;
+    dispatchParse(std::move(payload));
+    emit progressChanged();
+}
+
+void ChunkReassembler::reset()
+{
+    m_buffer = QByteArray();
+    m_coverage.clear();
+    m_expectedSize = 0;
+    m_receivedBytes = 0;
+    emit progressChanged();
+}
+
+int ChunkReassembler::markCovered(int begin, int end)
+{
+    int fresh = 0;
+    int bit = begin;
+    while (bit < end) {
+        const int word = bit >> 6;
+        const int offset = bit & 63;
+        const int span = qMin(64 - offset, end - bit);
+        const quint64 mask = (span == 64 ? ~quint64(0) : ((quint64(1) << span) - 1)) << offset;
+        fresh += popcount64(mask & ~m_coverage[size_t(word)]);
+        m_coverage[size_t(word)] |= mask;
+        bit += span;
+    }
+    return fresh;
+}
+
+bool ChunkReassembler::startsNewTransfer(int begin, const char *data, int length) const
+{
+    if (m_receivedBytes == 0)
+        return false;
+    // Transfert resté incomplet trop longtemps : l'émetteur est passé à autre chose
+    if (!m_lastChunk.isValid() || m_lastChunk.hasExpired(StaleTransferMs))
+        return true;
+    // Chunk 0 déjà reçu : doublon s'il est identique, sinon un autre message a commencé.
+    // Comparaison limitée au début déjà couvert (le reste du buffer n'est pas initialisé)
+    if (begin != 0 || length <= 0)
+        return false;
+    int covered = 0;
+    while (covered < length && (m_coverage[size_t(covered >> 6)] >> (covered & 63)) & 1)
+        ++covered;
+    return covered > 0 && std::memcmp(m_buffer.constData(), data, size_t(covered)) != 0;
+}
+
+void ChunkReassembler::startTransfer(int totalSize)
+{
+    m_buffer = QByteArray(totalSize, Qt::Uninitialized);
+    m_coverage.assign(size_t((totalSize + 63) / 64), 0);
+    m_expectedSize = totalSize;
+    m_receivedBytes = 0;
+}
+
+void ChunkReassembler::dispatchParse(QByteArray payload)
+{
+    QPointer<ChunkReassembler> self(this);
+    const quint64 sequence = m_nextSequence++;
+    auto parseAndDeliver = [self, sequence, payload = std::move(payload)]() {
+        QVariantMap message;
+        QString errorString;
+
+        // JSON texte (cas actuel) ou CBOR binaire (map en tête : 0xA0..0xBF)
+        const uchar first = payload.isEmpty() ? 0 : uchar(payload.at(0));
+        if (first >= 0xA0 && first <= 0xBF) {
+            QCborParserError error;
+            const QCborValue value = QCborValue::fromCbor(payload, &error);
+            if (error.error != QCborError::NoError)
+                errorString = error.errorString();
+            else
+                message = value.toMap().toVariantMap();
+        } else {
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(payload, &error);
+            if (error.error != QJsonParseError::NoError)
+                errorString = error.errorString();
+            else
+                message = doc.object().toVariantMap();
+        }
+
+        // Retour sur le thread principal ; self n'est testé que là-bas
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self, sequence, message, errorString]() {
+            if (self)
+                self->deliver(sequence, message, errorString);
+        }, Qt::QueuedConnection);
+    };
+
+#if QT_CONFIG(thread)
+    QThreadPool::globalInstance()->start(parseAndDeliver);
+#else
+    // WebAssembly single-thread : parsing sur place, livraison toujours différée
+    parseAndDeliver();
+#endif
+}
+
+void ChunkReassembler::deliver(quint64 sequence, const QVariantMap &message, const QString &errorString)
+{
+    // Les parsings du pool peuvent finir dans le désordre : un message plus récent
+    // a déjà été appliqué, celui-ci est périmé
+    if (sequence <= m_deliveredSequence)
+        return;
+    m_deliveredSequence = sequence;
+
+    if (!errorString.isEmpty()) {
+        emit parseError(errorString);
+        return;
+    }
+
+    ++m_completedMessages;
+    emit statsChanged();
+    emit messageReady(message);
+
+    if (message.value(QStringLiteral("type")).toString() == QStringLiteral("CONFIG_FULL"))
+        emit configFullReceived(message.value(QStringLiteral("config")).toMap());
+}
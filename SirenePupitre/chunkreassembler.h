@@ -0,0 +1,92 @@
+#ifndef CHUNKREASSEMBLER_H
+#define CHUNKREASSEMBLER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <vector>
+#include "MemoryAccounting.h"
+
+// Réassemblage des messages binaires découpés par PureData / la console
+// (en-tête 8 octets : totalSize uint32 LE, position uint32 LE, puis les données).
+// Le buffer cible est alloué une seule fois d'après l'en-tête et chaque chunk y est
+// copié exactement une fois. Un bitmap de couverture évite de compter deux fois un
+// chunk dupliqué et accepte les chunks dans le désordre. Le parsing JSON/CBOR du
+// message complet se fait sur un thread du pool, pas sur le thread GUI ; chaque
+// parsing porte un numéro de séquence et un résultat plus ancien que le dernier
+// livré est ignoré (deux CONFIG_FULL rapprochés ne s'appliquent pas à l'envers).
+// L'en-tête ne porte pas d'identifiant de transfert : un nouveau transfert de même
+// taille est reconnu à un chunk 0 dont le contenu diffère de celui déjà reçu, ou à un
+// chunk arrivant après un silence (transfert précédent abandonné). La couverture est
+// alors remise à zéro, un reste de l'ancien transfert ne complète jamais le nouveau.
+class ChunkReassembler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool receiving READ isReceiving NOTIFY progressChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(int expectedSize READ expectedSize NOTIFY progressChanged)
+    Q_PROPERTY(int receivedBytes READ receivedBytes NOTIFY progressChanged)
+    Q_PROPERTY(int duplicateBytes READ duplicateBytes NOTIFY statsChanged)
+    Q_PROPERTY(int completedMessages READ completedMessages NOTIFY statsChanged)
+    Q_PROPERTY(int maxMessageSize READ maxMessageSize WRITE setMaxMessageSize NOTIFY maxMessageSizeChanged)
+
+public:
+    static constexpr int HeaderSize = 8;
+    // Silence au-delà duquel un transfert incomplet est tenu pour abandonné
+    static constexpr int StaleTransferMs = 2000;
+
+    explicit ChunkReassembler(QObject *parent = nullptr);
+
+    bool isReceiving() const { return m_expectedSize > 0; }
+    qreal progress() const;
+    int expectedSize() const { return m_expectedSize; }
+    int receivedBytes() const { return m_receivedBytes; }
+    int duplicateBytes() const { return m_duplicateBytes; }
+    int completedMessages() const { return m_completedMessages; }
+    int maxMessageSize() const { return m_maxMessageSize; }
+    void setMaxMessageSize(int size);
+
+    // Retourne false si le message n'est pas un chunk valide (en-tête incohérent)
+    Q_INVOKABLE bool feedChunk(const QByteArray &chunk);
+
+    // Compatibilité BINARY_START / BINARY_END (protocole texte)
+    Q_INVOKABLE void begin(int totalSize);
+    Q_INVOKABLE void flush();
+    Q_INVOKABLE void reset();
+
+signals:
+    void progressChanged();
+    void statsChanged();
+    void maxMessageSizeChanged();
+    // Message complet décodé (objet JSON ou map CBOR)
+    void messageReady(const QVariantMap &message);
+    // Raccourci pour { type: "CONFIG_FULL", config: {...} }
+    void configFullReceived(const QVariantMap &config);
+    void parseError(const QString &errorString);
+
+private:
+    // Marque [begin, end) comme couvert, retourne le nombre d'octets nouveaux
+    int markCovered(int begin, int end);
+    // Le chunk [begin, begin + length) ouvre-t-il un nouveau transfert de même taille ?
+    bool startsNewTransfer(int begin, const char *data, int length) const;
+    void startTransfer(int totalSize);
+    void dispatchParse(QByteArray payload);
+    void deliver(quint64 sequence, const QVariantMap &message, const QString &errorString);
+
+    QByteArray m_buffer;
+    std::vector<quint64> m_coverage;
+    int m_expectedSize;
+    int m_receivedBytes;
+    int m_duplicateBytes;
+    int m_completedMessages;
+    int m_maxMessageSize;
+    quint64 m_nextSequence;         // numéro du prochain parsing lancé
+    quint64 m_deliveredSequence;    // numéro du dernier résultat livré (0 : aucun)
+    QElapsedTimer m_lastChunk;      // réception du dernier chunk du transfert en cours
+
+    // Comptabilité mémoire : buffer du message en cours et bitmap de couverture
+    MecavivMemory::Source m_memory;
+};
+
+#endif // CHUNKREASSEMBLER_H
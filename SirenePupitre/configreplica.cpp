@@ -0,0 +1,107 @@
+#include "configreplica.h"
+#include "ConfigDelta.h"
+#include <QCborArray>
+
+ConfigReplica::ConfigReplica(QObject *parent)
+    : QObject(parent)
+    , m_version(0)
+    , m_pupitreIndex(0)
+    , m_appliedPatches(0)
+    , m_resyncRequests(0)
+    , m_resyncPending(false)
+{
+}
+
+void ConfigReplica::setPupitreIndex(int index)
+{
+    index = qBound(0, index, 255);
+    if (m_pupitreIndex == index)
+        return;
+    m_pupitreIndex = index;
+    emit pupitreIndexChanged();
+}
+
+bool ConfigReplica::handleFrame(const QByteArray &data)
+{
+    if (!ConfigSync::isConfigFrame(data))
+        return false;
+
+    ConfigSync::Frame frame;
+    if (!ConfigSync::decode(data, &frame)) {
+        // Trame corrompue : on repart d'un snapshot
+        requestResyncOnMismatch();
+        return true;
+    }
+
+    // Le pupitre apprend son numéro de la première trame adressée
+    if (m_pupitreIndex == 0 && frame.pupitre != 0)
+        setPupitreIndex(frame.pupitre);
+    else if (frame.pupitre != 0 && frame.pupitre != m_pupitreIndex)
+        return true;
+
+    switch (frame.kind) {
+    case ConfigSync::FrameKind::Snapshot:
+        m_config = frame.config;
+        m_resyncPending = false;
+        setVersion(frame.version);
+        emit configReplaced(m_config.toVariantMap());
+        emit replyReady(ConfigSync::encodeAck(quint8(m_pupitreIndex), m_version));
+        break;
+
+    case ConfigSync::FrameKind::Patch:
+        if (frame.baseVersion != m_version || !ConfigSync::applyPatch(m_config, frame.ops)) {
+            requestResyncOnMismatch();
+            break;
+        }
+        m_resyncPending = false;
+        setVersion(frame.version);
+        ++m_appliedPatches;
+        emit statsChanged();
+        for (const ConfigSync::PatchOp &op : frame.ops)
+            emit valueChanged(op.path.toVariantList(), op.remove ? QVariant() : op.value.toVariant());
+        emit replyReady(ConfigSync::encodeAck(quint8(m_pupitreIndex), m_version));
+        break;
+
+    case ConfigSync::FrameKind::Ack:
+    case ConfigSync::FrameKind::ResyncRequest:
+        // Trames console ← pupitre : rien à faire côté réplique
+        break;
+    }
+    return true;
+}
+
+void ConfigReplica::requestResync()
+{
+    m_resyncPending = true;
+    m_resyncClock.start();
+    ++m_resyncRequests;
+    emit statsChanged();
+    emit replyReady(ConfigSync::encodeResyncRequest(quint8(m_pupitreIndex), m_version));
+}
+
+void ConfigReplica::requestResyncOnMismatch()
+{
+    // Les patchs déjà en route derrière le premier décalage échouent tous :
+    // on attend la réponse à la demande en cours, sauf si elle s'est perdue
+    if (m_resyncPending && m_resyncClock.elapsed() < ResyncRetryMs)
+        return;
+    requestResync();
+}
+
+void ConfigReplica::seed(const QVariantMap &config)
+{
+    m_config = QCborMap::fromVariantMap(config);
+}
+
+QVariant ConfigReplica::valueAt(const QVariantList &path) const
+{
+    return ConfigSync::valueAt(QCborValue(m_config), ConfigSync::pathFromVariantList(path)).toVariant();
+}
+
+void ConfigReplica::setVersion(quint32 version)
+{
+    if (m_version == version)
+        return;
+    m_version = version;
+    emit versionChanged();
+}
@@ -0,0 +1,72 @@
+#ifndef CONFIGREPLICA_H
+#define CONFIGREPLICA_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QCborMap>
+#include <QElapsedTimer>
+#include <QVariantList>
+#include <QVariantMap>
+
+// Réplique locale de la configuration poussée par la console (trames "MCFG").
+// Un snapshot remplace toute la config, un patch est appliqué seulement s'il part
+// de la version locale ; sinon on demande un resync complet. Chaque trame appliquée
+// est acquittée avec la nouvelle version. Les patchs sont appliqués sans compléter
+// les tableaux : la réplique est amorcée avec la config complète du pupitre (seed)
+// pour que les index de sirènes désignent de vrais éléments. Les décalages détectés
+// pendant qu'un resync est déjà demandé ne produisent pas de nouvelle demande.
+class ConfigReplica : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int version READ version NOTIFY versionChanged)
+    Q_PROPERTY(int pupitreIndex READ pupitreIndex WRITE setPupitreIndex NOTIFY pupitreIndexChanged)
+    Q_PROPERTY(int appliedPatches READ appliedPatches NOTIFY statsChanged)
+    Q_PROPERTY(int resyncRequests READ resyncRequests NOTIFY statsChanged)
+
+public:
+    explicit ConfigReplica(QObject *parent = nullptr);
+
+    int version() const { return int(m_version); }
+    int pupitreIndex() const { return m_pupitreIndex; }
+    void setPupitreIndex(int index);
+    int appliedPatches() const { return m_appliedPatches; }
+    int resyncRequests() const { return m_resyncRequests; }
+
+    // Retourne true si le message est une trame de sync (consommée), false sinon
+    Q_INVOKABLE bool handleFrame(const QByteArray &data);
+    // Demande explicite d'un snapshot complet (ex. après reconnexion)
+    Q_INVOKABLE void requestResync();
+    // Config complète reçue hors synchronisation (CONFIG_FULL) : base des patchs suivants,
+    // sans changer de version ni réémettre configReplaced
+    Q_INVOKABLE void seed(const QVariantMap &config);
+    Q_INVOKABLE QVariant valueAt(const QVariantList &path) const;
+    Q_INVOKABLE QVariantMap toVariantMap() const { return m_config.toVariantMap(); }
+
+signals:
+    void versionChanged();
+    void pupitreIndexChanged();
+    void statsChanged();
+    // Snapshot complet reçu
+    void configReplaced(const QVariantMap &config);
+    // Une entrée par opération de patch ; value est invalide pour une suppression
+    void valueChanged(const QVariantList &path, const QVariant &value);
+    // Trame binaire à renvoyer vers la console (ack / demande de resync)
+    void replyReady(const QByteArray &frame);
+
+private:
+    void setVersion(quint32 version);
+    // Demande de resync sur décalage : une seule demande par fenêtre de ResyncRetryMs
+    void requestResyncOnMismatch();
+
+    static constexpr qint64 ResyncRetryMs = 1000;
+
+    QCborMap m_config;
+    quint32 m_version;
+    int m_pupitreIndex;
+    int m_appliedPatches;
+    int m_resyncRequests;
+    bool m_resyncPending;
+    QElapsedTimer m_resyncClock;
+};
+
+#endif // CONFIGREPLICA_H
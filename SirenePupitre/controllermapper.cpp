@@ -0,0 +1,243 @@
+#include "controllermapper.h"
+#include "MecavivMessages.h"
+#include <QtMath>
+
+namespace {
+
+// Courbes de réponse sur [0, 1] → [0, 1] (noms utilisés par les presets console)
+double applyCurve(const QString &curve, double x)
+{
+    if (curve == QLatin1String("parabolic"))
+        return x * x;
+    if (curve == QLatin1String("hyperbolic"))
+        return 2.0 * x / (1.0 + x);
+    if (curve == QLatin1String("s curve"))
+        return x * x * (3.0 - 2.0 * x);
+    return x;  // "linear" et valeurs inconnues
+}
+
+using MecavivProtocol::ControllersFrame;
+
+// Octet de la trame 0x02 lu pour chaque contrôleur (le volant utilise aussi l'octet suivant)
+constexpr std::size_t kFrameOffset[ControllerMapper::ControllerCount] = {
+    ControllersFrame::WheelPosition::offset,   // uint16 LE, 0-360
+    ControllersFrame::JoystickX::offset,
+    ControllersFrame::JoystickY::offset,
+    ControllersFrame::JoystickZ::offset,
+    ControllersFrame::Fader::offset,
+    ControllersFrame::Pedal::offset,
+    ControllersFrame::Selector::offset,
+    ControllersFrame::EncoderValue::offset
+};
+
+static_assert(ControllerMapper::FrameSize == int(ControllersFrame::Size), "trame 0x02 : 18 octets");
+
+}
+
+ControllerMapper::ControllerMapper(QObject *parent)
+    : QObject(parent)
+    , m_smoothing(0.0)
+    , m_hysteresis(0)
+    , m_framesProcessed(0)
+{
+    m_slots[Wheel].tableSize = MaxTableSize;
+    m_slots[JoystickX].tableSize = 256;
+    m_slots[JoystickY].tableSize = 256;
+    m_slots[JoystickZ].tableSize = 256;
+    for (int i = 0; i < ControllerCount; ++i)
+        compile(i);
+}
+
+void ControllerMapper::setSmoothing(qreal smoothing)
+{
+    smoothing = qBound(0.0, smoothing, 0.99);
+    if (qFuzzyCompare(m_smoothing, smoothing))
+        return;
+    m_smoothing = smoothing;
+    emit smoothingChanged();
+}
+
+void ControllerMapper::setHysteresis(int hysteresis)
+{
+    hysteresis = qBound(0, hysteresis, 64);
+    if (m_hysteresis == hysteresis)
+        return;
+    m_hysteresis = hysteresis;
+    emit hysteresisChanged();
+}
+
+QVariantList ControllerMapper::outputs() const
+{
+    QVariantList list;
+    list.reserve(ControllerCount);
+    for (const Slot &slot : m_slots)
+        list.append(slot.output);
+    return list;
+}
+
+void ControllerMapper::loadMappings(const QVariantMap &controllerMapping)
+{
+    // Appelé à chaque settingsUpdated : ne recompiler que si la section a changé
+    if (controllerMapping == m_mappings)
+        return;
+
+    for (int i = 0; i < ControllerCount; ++i) {
+        m_slots[i].cc = -1;
+        m_slots[i].curve.clear();
+    }
+    for (auto it = controllerMapping.constBegin(); it != controllerMapping.constEnd(); ++it) {
+        const int controller = controllerFromName(it.key());
+        if (controller < 0)
+            continue;
+        const QVariantMap entry = it.value().toMap();
+        m_slots[controller].cc = entry.contains(QStringLiteral("cc")) ? qBound(0, entry.value(QStringLiteral("cc")).toInt(), 127) : -1;
+        m_slots[controller].curve = entry.value(QStringLiteral("curve")).toString();
+    }
+    for (int i = 0; i < ControllerCount; ++i)
+        compile(i);
+
+    m_mappings = controllerMapping;
+    emit mappingsChanged();
+}
+
+void ControllerMapper::setMapping(const QString &controller, int cc, const QString &curve)
+{
+    const int index = controllerFromName(controller);
+    if (index < 0)
+        return;
+    QVariantMap mapping = m_mappings;
+    QVariantMap entry;
+    entry.insert(QStringLiteral("cc"), cc);
+    entry.insert(QStringLiteral("curve"), curve);
+    mapping.insert(controller, entry);
+    loadMappings(mapping);
+}
+
+void ControllerMapper::clearMapping(const QString &controller)
+{
+    QVariantMap mapping = m_mappings;
+    if (mapping.remove(controller) > 0)
+        loadMappings(mapping);
+}
+
+bool ControllerMapper::processFrame(const QByteArray &frame)
+{
+    const auto *bytes = reinterpret_cast<const std::uint8_t *>(frame.constData());
+    if (frame.size() != FrameSize || ControllersFrame::Type::read(bytes) != MecavivProtocol::FrameType::Controllers)
+        return false;
+
+    const float keep = float(m_smoothing);
+    const float take = 1.0f - keep;
+
+    QVariantList changes;
+    for (int i = 0; i < ControllerCount; ++i) {
+        Slot &slot = m_slots[i];
+        if (slot.cc < 0)
+            continue;
+
+        // Index de table : l'octet brut, sauf le volant (uint16 borné à 360)
+        int index = bytes[kFrameOffset[i]];
+        if (i == Wheel)
+            index = qMin(int(ControllersFrame::WheelPosition::read(bytes)), MaxTableSize - 1);
+        index = qMin(index, slot.tableSize - 1);
+
+        const float target = slot.table[size_t(index)];
+        slot.smoothed = slot.output < 0 ? target : keep * slot.smoothed + take * target;
+        const int value = qRound(slot.smoothed);
+
+        // Hystérésis : ignorer les petites variations, sauf pour atteindre les butées
+        if (slot.output >= 0 && qAbs(value - slot.output) <= m_hysteresis
+            && !((value == 0 || value == 127) && value != slot.output)) {
+            continue;
+        }
+        if (value == slot.output)
+            continue;
+
+        slot.output = value;
+        QVariantMap change;
+        change.insert(QStringLiteral("controller"), controllerName(i));
+        change.insert(QStringLiteral("cc"), slot.cc);
+        change.insert(QStringLiteral("value"), value);
+        changes.append(change);
+    }
+
+    ++m_framesProcessed;
+    if (changes.isEmpty())
+        return false;
+
+    emit outputsChanged();
+    emit controlChanges(changes);
+    return true;
+}
+
+int ControllerMapper::mapValue(const QString &controller, int raw) const
+{
+    const int index = controllerFromName(controller);
+    if (index < 0)
+        return -1;
+    const Slot &slot = m_slots[index];
+    if (index >= JoystickX && index <= JoystickZ && raw < 0)
+        raw = 128 - raw;  // valeur signée → octet replié (-64 → 192)
+    return slot.table[size_t(qBound(0, raw, slot.tableSize - 1))];
+}
+
+int ControllerMapper::controllerFromName(const QString &name)
+{
+    if (name == QLatin1String("wheel"))
+        return Wheel;
+    if (name == QLatin1String("joystickX"))
+        return JoystickX;
+    if (name == QLatin1String("joystickY"))
+        return JoystickY;
+    if (name == QLatin1String("joystickZ"))
+        return JoystickZ;
+    if (name == QLatin1String("fader"))
+        return Fader;
+    if (name == QLatin1String("pedal") || name == QLatin1String("pedalId") || name == QLatin1String("modPedal"))
+        return Pedal;
+    if (name == QLatin1String("selector") || name == QLatin1String("gearShift"))
+        return Selector;
+    if (name == QLatin1String("encoder"))
+        return Encoder;
+    return -1;
+}
+
+QString ControllerMapper::controllerName(int controller)
+{
+    switch (controller) {
+    case Wheel: return QStringLiteral("wheel");
+    case JoystickX: return QStringLiteral("joystickX");
+    case JoystickY: return QStringLiteral("joystickY");
+    case JoystickZ: return QStringLiteral("joystickZ");
+    case Fader: return QStringLiteral("fader");
+    case Pedal: return QStringLiteral("pedal");
+    case Selector: return QStringLiteral("selector");
+    case Encoder: return QStringLiteral("encoder");
+    }
+    return QString();
+}
+
+void ControllerMapper::compile(int controller)
+{
+    Slot &slot = m_slots[controller];
+    slot.output = -1;
+
+    for (int raw = 0; raw < slot.tableSize; ++raw) {
+        double out;
+        if (controller == Wheel) {
+            out = applyCurve(slot.curve, raw / 360.0) * 127.0;
+        } else if (controller >= JoystickX && controller <= JoystickZ) {
+            // Repli du signe (STRUCTURE_BINAIRE_0x02.md) : 0-127 → +0..+127, 128-255 → -0..-127,
+            // puis courbe sur l'amplitude et sortie bipolaire centrée sur 64
+            const int value = ControllersFrame::JoystickX::decode(quint8(raw));
+            const double shaped = applyCurve(slot.curve, qAbs(value) / 127.0) * 63.5;
+            out = 63.5 + (value < 0 ? -shaped : shaped);
+        } else if (controller == Selector) {
+            // 5 positions (0-4) réparties sur toute la plage CC
+            out = applyCurve(slot.curve, qMin(raw, 4) / 4.0) * 127.0;
+        } else {
+            out = applyCurve(slot.curve, raw / 127.0) * 127.0;
+        }
+        slot.table[size_t(raw)] = quint8(qBound(0, qRound(out), 127));
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef CONTROLLERMAPPER_H
+#define CONTROLLERMAPPER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+#include <array>
+
+// Mapping contrôleurs physiques (trame 0x02) → valeurs CC 0-127.
+// Chaque couple (contrôleur, courbe) est compilé en table au changement de config :
+// 361 entrées pour le volant (degrés), 256 pour les axes joystick (repli du signe
+// de STRUCTURE_BINAIRE_0x02.md inclus dans la table), 128 pour les autres.
+// Une trame complète est ensuite traitée en une seule boucle de lookups, avec
+// lissage et hystérésis optionnels.
+class ControllerMapper : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal smoothing READ smoothing WRITE setSmoothing NOTIFY smoothingChanged)
+    Q_PROPERTY(int hysteresis READ hysteresis WRITE setHysteresis NOTIFY hysteresisChanged)
+    Q_PROPERTY(QVariantMap mappings READ mappings NOTIFY mappingsChanged)
+    Q_PROPERTY(QVariantList outputs READ outputs NOTIFY outputsChanged)
+    Q_PROPERTY(int framesProcessed READ framesProcessed NOTIFY outputsChanged)
+
+public:
+    enum Controller {
+        Wheel,
+        JoystickX,
+        JoystickY,
+        JoystickZ,
+        Fader,
+        Pedal,
+        Selector,
+        Encoder,
+        ControllerCount
+    };
+    Q_ENUM(Controller)
+
+    static constexpr int FrameSize = 18;
+    static constexpr int MaxTableSize = 361;
+
+    explicit ControllerMapper(QObject *parent = nullptr);
+
+    qreal smoothing() const { return m_smoothing; }
+    void setSmoothing(qreal smoothing);
+    int hysteresis() const { return m_hysteresis; }
+    void setHysteresis(int hysteresis);
+    QVariantMap mappings() const { return m_mappings; }
+    QVariantList outputs() const;
+    int framesProcessed() const { return m_framesProcessed; }
+
+    // Section controllerMapping de la config : { joystickX: { cc, curve }, fader: {...}, ... }
+    Q_INVOKABLE void loadMappings(const QVariantMap &controllerMapping);
+    Q_INVOKABLE void setMapping(const QString &controller, int cc, const QString &curve);
+    Q_INVOKABLE void clearMapping(const QString &controller);
+
+    // Trame 0x02 complète (18 octets) ; retourne true si au moins une sortie a changé
+    Q_INVOKABLE bool processFrame(const QByteArray &frame);
+    // Valeur brute isolée (aperçu de courbe dans l'admin)
+    Q_INVOKABLE int mapValue(const QString &controller, int raw) const;
+
+signals:
+    void smoothingChanged();
+    void hysteresisChanged();
+    void mappingsChanged();
+    void outputsChanged();
+    // Une entrée { controller, cc, value } par sortie modifiée dans la trame
+    void controlChanges(const QVariantList &changes);
+
+private:
+    struct Slot {
+        std::array<quint8, MaxTableSize> table {};
+        int tableSize = 128;
+        int cc = -1;
+        QString curve;
+        float smoothed = 0.0f;
+        int output = -1;
+    };
+
+    static int controllerFromName(const QString &name);
+    static QString controllerName(int controller);
+    void compile(int controller);
+
+    std::array<Slot, ControllerCount> m_slots;
+    QVariantMap m_mappings;
+    qreal m_smoothing;
+    int m_hysteresis;
+    int m_framesProcessed;
+};
+
+#endif // CONTROLLERMAPPER_H
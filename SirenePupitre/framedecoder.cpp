@@ -0,0 +1,109 @@
+#include "framedecoder.h"
+#include "MecavivMessages.h"
+#include <iterator>
+
+using namespace MecavivProtocol;
+
+namespace {
+
+const std::uint8_t *rawBytes(const QByteArray &frame)
+{
+    return reinterpret_cast<const std::uint8_t *>(frame.constData());
+}
+
+// Sélecteur 5 vitesses → mode GearShift
+const char *const kGearModeNames[] = { "SEMITONE", "THIRD", "MINOR_SIXTH", "OCTAVE", "DOUBLE_OCTAVE" };
+
+}
+
+FrameDecoder::FrameDecoder(QObject *parent)
+    : QObject(parent)
+{
+}
+
+int FrameDecoder::frameType(const QByteArray &frame) const
+{
+    return frame.isEmpty() ? -1 : int(quint8(frame.at(0)));
+}
+
+QVariantMap FrameDecoder::decodePosition(const QByteArray &frame) const
+{
+    PositionFrame position;
+    if (PositionFrame::decode(rawBytes(frame), size_t(frame.size()), position) != Status::Ok)
+        return {};
+
+    QVariantMap result;
+    result.insert(QStringLiteral("playing"), position.playing);
+    switch (position.variant) {
+    case PositionFrame::Variant::Measure:
+        result.insert(QStringLiteral("variant"), QStringLiteral("measure"));
+        result.insert(QStringLiteral("measure"), int(position.measure));
+        break;
+    case PositionFrame::Variant::Tick:
+        result.insert(QStringLiteral("variant"), QStringLiteral("tick"));
+        // uint32 : double pour ne pas repasser en négatif au-delà de 2^31 côté JS
+        result.insert(QStringLiteral("tick"), double(position.tick));
+        break;
+    case PositionFrame::Variant::Legacy:
+        result.insert(QStringLiteral("variant"), QStringLiteral("legacy"));
+        result.insert(QStringLiteral("measure"), int(position.measure));
+        result.insert(QStringLiteral("beatInBar"), int(position.beatInBar));
+        result.insert(QStringLiteral("beat"), double(position.beat()));
+        break;
+    }
+    return result;
+}
+
+QVariantMap FrameDecoder::decodeControllers(const QByteArray &frame) const
+{
+    ControllersFrame c;
+    if (ControllersFrame::decode(rawBytes(frame), size_t(frame.size()), c) != Status::Ok)
+        return {};
+
+    const QString gearMode = c.selector < std::size(kGearModeNames)
+        ? QLatin1String(kGearModeNames[c.selector]) : QStringLiteral("SEMITONE");
+
+    return QVariantMap {
+        { QStringLiteral("wheel"), QVariantMap {
+              { QStringLiteral("position"), int(c.wheelPosition) },   // 0-360 degrés (converti par PureData)
+              { QStringLiteral("velocity"), 0 } } },                 // non disponible dans ce format
+        { QStringLiteral("joystick"), QVariantMap {
+              { QStringLiteral("x"), c.joystickX },
+              { QStringLiteral("y"), c.joystickY },
+              { QStringLiteral("z"), c.joystickZ },
+              { QStringLiteral("button"), c.joystickButton } } },
+        { QStringLiteral("gearShift"), QVariantMap {
+              { QStringLiteral("position"), int(c.selector) },
+              { QStringLiteral("mode"), gearMode } } },
+        { QStringLiteral("fader"), QVariantMap {
+              { QStringLiteral("value"), int(c.fader) } } },
+        { QStringLiteral("modPedal"), QVariantMap {
+              { QStringLiteral("value"), int(c.pedal) },
+              { QStringLiteral("percent"), c.pedal / 127.0 * 100.0 } } },
+        { QStringLiteral("pad1"), QVariantMap {
+              { QStringLiteral("velocity"), int(c.pad1Velocity) },
+              { QStringLiteral("aftertouch"), int(c.pad1Aftertouch) },
+              { QStringLiteral("active"), c.pad1Velocity > 0 } } },
+        { QStringLiteral("pad2"), QVariantMap {
+              { QStringLiteral("velocity"), int(c.pad2Velocity) },
+              { QStringLiteral("aftertouch"), int(c.pad2Aftertouch) },
+              { QStringLiteral("active"), c.pad2Velocity > 0 } } },
+        { QStringLiteral("buttons"), QVariantMap {
+              { QStringLiteral("button1"), c.button1 },
+              { QStringLiteral("button2"), c.button2 } } },
+        { QStringLiteral("encoder"), QVariantMap {
+              { QStringLiteral("value"), int(c.encoderValue) },
+              { QStringLiteral("pressed"), c.encoderPressed } } },
+    };
+}
+
+QVariantMap FrameDecoder::decodeControlChange(const QByteArray &frame) const
+{
+    ControlChangeFrame cc;
+    if (ControlChangeFrame::decode(rawBytes(frame), size_t(frame.size()), cc) != Status::Ok)
+        return {};
+    return QVariantMap {
+        { QStringLiteral("number"), int(cc.number) },
+        { QStringLiteral("value"), int(cc.value) },
+    };
+}
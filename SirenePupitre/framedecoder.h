@@ -0,0 +1,32 @@
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QVariantMap>
+
+// Décodage des trames binaires PureData → pupitre pour le QML, d'après les schémas
+// de MecavivMessages.h (taille, type et plages validés au même endroit que côté C++).
+// Chaque méthode retourne une map vide si la trame n'est pas du format attendu.
+//
+//   0x01 POSITION      { variant: "measure" | "tick" | "legacy", playing, measure, tick, beatInBar, beat }
+//   0x02 CONTROLLERS   { wheel, joystick, gearShift, fader, modPedal, pad1, pad2, buttons, encoder }
+//   0x05 CONTROL CHANGE { number, value }
+//
+// Les notes 0x03 / 0x04 passent par NoteJitterBuffer.
+class FrameDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameDecoder(QObject *parent = nullptr);
+
+    // Type de la trame (premier octet), -1 si vide
+    Q_INVOKABLE int frameType(const QByteArray &frame) const;
+    Q_INVOKABLE QVariantMap decodePosition(const QByteArray &frame) const;
+    // Même forme d'objet que l'ancien décodage QML de WebSocketController
+    Q_INVOKABLE QVariantMap decodeControllers(const QByteArray &frame) const;
+    Q_INVOKABLE QVariantMap decodeControlChange(const QByteArray &frame) const;
+};
+
+#endif // FRAMEDECODER_H
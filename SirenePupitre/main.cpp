@@ -1,18 +1,40 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
-#include "taperedboxgeometry.h"
-#include "simpletestgeometry.h"
+#include <QQuickWindow>
+#include "pupitretypes.h"
+#include "startuptimeline.h"
+#include "LogQml.h"
+#include "MemoryMonitor.h"
 #include <QLoggingCategory>
 
 int main(int argc, char *argv[])
 {
+    // Chronologie du démarrage (catégorie STARTUP, MECAVIV_STARTUP_TIMELINE=fichier.jsonl)
+    StartupTimeline *startup = StartupTimeline::instance();
+    startup->begin();
+
     QGuiApplication app(argc, argv);
     QLoggingCategory::setFilterRules(QStringLiteral("qt.qml.binding.removal.info=true"));
+    // Niveaux MecavivLog : MECAVIV_LOG="GEOMETRY=trace,*=warn", MECAVIV_LOG_FILE=...
+    MecavivLog::configureFromEnvironment();
     // Enregistrer les types custom pour QML
-    qmlRegisterType<TaperedBoxGeometry>("GameGeometry", 1, 0, "TaperedBoxGeometry");
-    qmlRegisterType<SimpleTestGeometry>("GameGeometry", 1, 0, "SimpleTestGeometry");
+    registerPupitreTypes();
 
     QQmlApplicationEngine engine;
+    startup->mark(QStringLiteral("engineCreated"));
+    // Comptabilité mémoire (MECAVIV_MEMORY_BUDGET_MB, MECAVIV_MEMORY_SNAPSHOT=fichier.jsonl)
+    MemoryMonitor::instance()->attach(&engine);
+    MemoryMonitor::instance()->configureFromEnvironment();
+    QObject::connect(
+        &engine,
+        &QQmlApplicationEngine::objectCreated,
+        &app,
+        [startup](QObject *object, const QUrl &) {
+            if (!object)
+                return;
+            startup->mark(QStringLiteral("qmlCreated"));
+            startup->watchWindow(qobject_cast<QQuickWindow *>(object));
+        });
     QObject::connect(
         &engine,
         &QQmlApplicationEngine::objectCreationFailed,
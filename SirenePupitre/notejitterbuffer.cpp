@@ -0,0 +1,291 @@
+#include "notejitterbuffer.h"
+#include "showclock.h"
+#include "MecavivMessages.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+using MecavivProtocol::NoteFrame;
+constexpr quint8 kWheelNote = MecavivProtocol::FrameType::WheelNote;
+// Estimateur de gigue RFC 3550 : J += (|D| - J) / 16
+constexpr double kJitterGain = 1.0 / 16.0;
+// Descente du délai : 1/64 de l'écart par événement
+constexpr double kDelayDecay = 1.0 / 64.0;
+constexpr int kStatsInterval = 250;
+}
+
+NoteJitterBuffer::NoteJitterBuffer(QObject *parent)
+    : QObject(parent)
+    , m_enabled(true)
+    , m_localBase(QDateTime::currentMSecsSinceEpoch())
+    , m_statsDirty(false)
+    , m_smoothness(0.5)
+    , m_minDelayMs(0)
+    , m_maxDelayMs(250)
+    , m_lateDropMs(100)
+    , m_transitCount(0)
+    , m_transitHead(0)
+    , m_lastTransit(0.0)
+    , m_jitter(0.0)
+    , m_delay(0.0)
+    , m_released(0)
+    , m_underruns(0)
+    , m_lateDrops(0)
+    , m_unstamped(0)
+    , m_memory("network", "NoteJitterBuffer",
+               [this] {
+                   return MecavivMemory::Usage { 1, qint64(m_queue.capacity() * sizeof(Event) + sizeof(m_transits)) };
+               },
+               [this](int) { m_queue.squeeze(); })
+{
+    m_elapsed.start();
+    m_releaseTimer.setSingleShot(true);
+    m_releaseTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_releaseTimer, &QTimer::timeout, this, &NoteJitterBuffer::releaseDue);
+    m_statsTimer.setInterval(kStatsInterval);
+    connect(&m_statsTimer, &QTimer::timeout, this, &NoteJitterBuffer::publishStats);
+}
+
+void NoteJitterBuffer::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    m_enabled = enabled;
+    if (!m_enabled)
+        flush();
+    emit enabledChanged();
+}
+
+QObject *NoteJitterBuffer::showClock() const
+{
+    return m_showClock.data();
+}
+
+void NoteJitterBuffer::setShowClock(QObject *clock)
+{
+    ShowClock *showClock = qobject_cast<ShowClock *>(clock);
+    if (m_showClock == showClock)
+        return;
+    if (m_showClock)
+        disconnect(m_showClock, nullptr, this, nullptr);
+    m_showClock = showClock;
+    // Changement de base de temps : les transits mesurés ne sont plus comparables
+    m_transitCount = 0;
+    m_transitHead = 0;
+    if (m_showClock) {
+        connect(m_showClock, &ShowClock::syncedChanged, this, [this]() {
+            flush();
+            m_transitCount = 0;
+            m_transitHead = 0;
+        });
+    }
+    emit showClockChanged();
+}
+
+void NoteJitterBuffer::setSmoothness(qreal smoothness)
+{
+    smoothness = qBound<qreal>(0.0, smoothness, 1.0);
+    if (qFuzzyCompare(m_smoothness, smoothness))
+        return;
+    m_smoothness = smoothness;
+    emit smoothnessChanged();
+}
+
+void NoteJitterBuffer::setMinDelayMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_minDelayMs == ms)
+        return;
+    m_minDelayMs = ms;
+    m_maxDelayMs = qMax(m_maxDelayMs, m_minDelayMs);
+    emit delayBoundsChanged();
+}
+
+void NoteJitterBuffer::setMaxDelayMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_maxDelayMs == ms)
+        return;
+    m_maxDelayMs = ms;
+    m_minDelayMs = qMin(m_minDelayMs, m_maxDelayMs);
+    emit delayBoundsChanged();
+}
+
+void NoteJitterBuffer::setLateDropMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_lateDropMs == ms)
+        return;
+    m_lateDropMs = ms;
+    emit delayBoundsChanged();
+}
+
+bool NoteJitterBuffer::pushFrame(const QByteArray &frame)
+{
+    // Arrivée relevée avant tout traitement
+    const double now = nowMs();
+    NoteFrame decoded;
+    if (NoteFrame::decode(reinterpret_cast<const std::uint8_t *>(frame.constData()), size_t(frame.size()), decoded)
+        != MecavivProtocol::Status::Ok) {
+        return false;
+    }
+
+    Event event;
+    event.type = decoded.type;
+    event.note = decoded.note;
+    event.velocity = decoded.velocity;
+    event.value = decoded.value;   // bend 14 bits (0x03) ou durée en ms (0x04)
+
+    if (!m_enabled || !decoded.stamped) {
+        if (!decoded.stamped)
+            ++m_unstamped;
+        event.releaseTime = now;
+        release(event);
+        return true;
+    }
+
+    const double sent = unwrapSenderTime(decoded.sentTime, now);
+    const double transit = now - sent;
+    updateEstimate(transit);
+
+    double minTransit = transit;
+    for (int i = 0; i < m_transitCount; ++i)
+        minTransit = qMin(minTransit, m_transits[i]);
+    event.releaseTime = sent + minTransit + m_delay;
+
+    const double lateness = now - event.releaseTime;
+    if (lateness <= 0.0) {
+        schedule(event);
+        armTimer(now);
+    } else if (event.type == kWheelNote && lateness > m_lateDropMs) {
+        ++m_lateDrops;
+        markDirty();
+    } else {
+        // Arrivée après son heure de restitution : le tampon était vide
+        ++m_underruns;
+        release(event);
+    }
+    return true;
+}
+
+void NoteJitterBuffer::flush()
+{
+    m_releaseTimer.stop();
+    const QVector<Event> queue = m_queue;
+    m_queue.clear();
+    for (const Event &event : queue)
+        release(event);
+    markDirty();
+}
+
+void NoteJitterBuffer::clear()
+{
+    m_releaseTimer.stop();
+    m_queue.clear();
+    markDirty();
+}
+
+void NoteJitterBuffer::resetStats()
+{
+    m_released = 0;
+    m_underruns = 0;
+    m_lateDrops = 0;
+    m_unstamped = 0;
+    markDirty();
+}
+
+void NoteJitterBuffer::releaseDue()
+{
+    const double now = nowMs();
+    // Tolérance de 1 ms sur la résolution du timer
+    int due = 0;
+    while (due < m_queue.size() && m_queue[due].releaseTime <= now + 1.0)
+        ++due;
+    const QVector<Event> ready = m_queue.mid(0, due);
+    m_queue.remove(0, due);
+    for (const Event &event : ready)
+        release(event);
+    armTimer(now);
+}
+
+void NoteJitterBuffer::publishStats()
+{
+    if (!m_statsDirty) {
+        m_statsTimer.stop();
+        return;
+    }
+    m_statsDirty = false;
+    emit statsChanged();
+}
+
+double NoteJitterBuffer::nowMs() const
+{
+    if (m_showClock)
+        return m_showClock->now();
+    return double(m_localBase) + m_elapsed.nsecsElapsed() / 1e6;
+}
+
+double NoteJitterBuffer::unwrapSenderTime(quint32 stamp, double now) const
+{
+    // Heure de spectacle tronquée à 32 bits : écart signé par rapport à maintenant
+    const quint32 nowLow = quint32(qint64(std::floor(now)) & 0xFFFFFFFF);
+    const qint32 age = qint32(nowLow - stamp);
+    return std::floor(now) - double(age);
+}
+
+void NoteJitterBuffer::updateEstimate(double transit)
+{
+    if (m_transitCount > 0)
+        m_jitter += (std::abs(transit - m_lastTransit) - m_jitter) * kJitterGain;
+    m_lastTransit = transit;
+
+    m_transits[m_transitHead] = transit;
+    m_transitHead = (m_transitHead + 1) % TransitWindow;
+    m_transitCount = qMin(m_transitCount + 1, TransitWindow);
+
+    // k = 1 (latence) .. 8 (régularité)
+    const double k = 1.0 + 7.0 * m_smoothness;
+    const double target = qBound(double(m_minDelayMs), k * m_jitter, double(m_maxDelayMs));
+    if (target > m_delay)
+        m_delay = target;
+    else
+        m_delay += (target - m_delay) * kDelayDecay;
+    markDirty();
+}
+
+void NoteJitterBuffer::schedule(const Event &event)
+{
+    // Insertion stable : à heure égale, l'ordre d'arrivée est conservé
+    auto it = std::upper_bound(m_queue.begin(), m_queue.end(), event,
+                               [](const Event &a, const Event &b) { return a.releaseTime < b.releaseTime; });
+    m_queue.insert(it, event);
+    markDirty();
+}
+
+void NoteJitterBuffer::release(const Event &event)
+{
+    ++m_released;
+    markDirty();
+    if (event.type == kWheelNote)
+        emit wheelNoteReleased(event.note, event.velocity, event.value);
+    else
+        emit sequenceNoteReleased(event.note, event.velocity, event.value);
+}
+
+void NoteJitterBuffer::armTimer(double now)
+{
+    if (m_queue.isEmpty()) {
+        m_releaseTimer.stop();
+        return;
+    }
+    const double wait = m_queue.first().releaseTime - now;
+    m_releaseTimer.start(qMax(0, int(std::ceil(wait))));
+}
+
+void NoteJitterBuffer::markDirty()
+{
+    m_statsDirty = true;
+    if (!m_statsTimer.isActive())
+        m_statsTimer.start();
+}
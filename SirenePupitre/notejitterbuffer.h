@@ -0,0 +1,141 @@
+#ifndef NOTEJITTERBUFFER_H
+#define NOTEJITTERBUFFER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+#include <array>
+#include "MemoryAccounting.h"
+
+class ShowClock;
+
+// Tampon de lecture pour les notes temporisées (0x04 séquence, 0x03 volant).
+// Chaque trame est horodatée à la réception ; si l'émetteur l'a aussi horodatée
+// (variante 9 octets, heure de spectacle en ms sur 32 bits), elle est restituée à
+// heure d'envoi + délai. Le délai suit le temps de transit minimal observé plus
+// k × gigue (estimateur RFC 3550), avec k réglé par `smoothness` : 0 = latence
+// minimale, 1 = régularité maximale. Il monte immédiatement et redescend lentement
+// pour ne pas resserrer les notes déjà planifiées.
+//
+//   0x04 : [0x04, note, velocity, duration_lsb, duration_msb] (+ [t0..t3] u32 LE)
+//   0x03 : [0x03, note, velocity, bend_lsb, bend_msb]         (+ [t0..t3] u32 LE)
+//
+// Les trames sans horodatage n'ont pas d'heure d'envoi exploitable : elles sont
+// restituées immédiatement (comptées dans `unstamped`).
+class NoteJitterBuffer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QObject *showClock READ showClock WRITE setShowClock NOTIFY showClockChanged)
+    Q_PROPERTY(qreal smoothness READ smoothness WRITE setSmoothness NOTIFY smoothnessChanged)
+    Q_PROPERTY(int minDelayMs READ minDelayMs WRITE setMinDelayMs NOTIFY delayBoundsChanged)
+    Q_PROPERTY(int maxDelayMs READ maxDelayMs WRITE setMaxDelayMs NOTIFY delayBoundsChanged)
+    // Retard au-delà duquel une position de volant est abandonnée (une plus récente suit)
+    Q_PROPERTY(int lateDropMs READ lateDropMs WRITE setLateDropMs NOTIFY delayBoundsChanged)
+    Q_PROPERTY(double delayMs READ delayMs NOTIFY statsChanged)
+    Q_PROPERTY(double jitterMs READ jitterMs NOTIFY statsChanged)
+    Q_PROPERTY(int pending READ pending NOTIFY statsChanged)
+    Q_PROPERTY(int released READ released NOTIFY statsChanged)
+    Q_PROPERTY(int underruns READ underruns NOTIFY statsChanged)
+    Q_PROPERTY(int lateDrops READ lateDrops NOTIFY statsChanged)
+    Q_PROPERTY(int unstamped READ unstamped NOTIFY statsChanged)
+
+public:
+    explicit NoteJitterBuffer(QObject *parent = nullptr);
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    QObject *showClock() const;
+    void setShowClock(QObject *clock);
+    qreal smoothness() const { return m_smoothness; }
+    void setSmoothness(qreal smoothness);
+    int minDelayMs() const { return m_minDelayMs; }
+    void setMinDelayMs(int ms);
+    int maxDelayMs() const { return m_maxDelayMs; }
+    void setMaxDelayMs(int ms);
+    int lateDropMs() const { return m_lateDropMs; }
+    void setLateDropMs(int ms);
+
+    double delayMs() const { return m_delay; }
+    double jitterMs() const { return m_jitter; }
+    int pending() const { return m_queue.size(); }
+    int released() const { return m_released; }
+    int underruns() const { return m_underruns; }
+    int lateDrops() const { return m_lateDrops; }
+    int unstamped() const { return m_unstamped; }
+
+    // Trame 0x03 / 0x04 (5 ou 9 octets) ; false si ce n'est pas une note
+    Q_INVOKABLE bool pushFrame(const QByteArray &frame);
+    // Restitue tout de suite ce qui est en attente (stop, changement de mode)
+    Q_INVOKABLE void flush();
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE void resetStats();
+
+signals:
+    void enabledChanged();
+    void showClockChanged();
+    void smoothnessChanged();
+    void delayBoundsChanged();
+    void statsChanged();
+    void sequenceNoteReleased(int note, int velocity, int duration);
+    void wheelNoteReleased(int note, int velocity, int bend);
+
+private slots:
+    void releaseDue();
+    void publishStats();
+
+private:
+    struct Event {
+        double releaseTime = 0.0;
+        quint8 type = 0;
+        quint8 note = 0;
+        quint8 velocity = 0;
+        quint16 value = 0;   // durée (0x04) ou bend 14 bits (0x03)
+    };
+
+    double nowMs() const;
+    double unwrapSenderTime(quint32 stamp, double now) const;
+    void updateEstimate(double transit);
+    void schedule(const Event &event);
+    void release(const Event &event);
+    void armTimer(double now);
+    void markDirty();
+
+    bool m_enabled;
+    QPointer<ShowClock> m_showClock;
+    QElapsedTimer m_elapsed;
+    qint64 m_localBase;
+    QTimer m_releaseTimer;
+    QTimer m_statsTimer;
+    bool m_statsDirty;
+
+    qreal m_smoothness;
+    int m_minDelayMs;
+    int m_maxDelayMs;
+    int m_lateDropMs;
+
+    // Transits récents (arrivée - envoi) pour le minimum glissant
+    static constexpr int TransitWindow = 64;
+    std::array<double, TransitWindow> m_transits;
+    int m_transitCount;
+    int m_transitHead;
+    double m_lastTransit;
+    double m_jitter;
+    double m_delay;
+
+    // File triée par heure de restitution
+    QVector<Event> m_queue;
+
+    int m_released;
+    int m_underruns;
+    int m_lateDrops;
+    int m_unstamped;
+
+    // Comptabilité mémoire : file de restitution ; éviction = capacité inutilisée rendue
+    MecavivMemory::Source m_memory;
+};
+
+#endif // NOTEJITTERBUFFER_H
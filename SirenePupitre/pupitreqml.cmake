@@ -0,0 +1,124 @@
+# ============================================================================
+# QML du pupitre compilé à l'avance (qmlcachegen) : module QML partagé par
+# l'application et le banc de rendu (benchmarks/). Les fichiers gardent leurs
+# chemins qrc:/QML/... (RESOURCE_PREFIX / et NO_RESOURCE_TARGET_PATH).
+# ============================================================================
+set(PUPITRE_SOURCE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+set(PUPITRE_QML_FILES
+    QML/Main.qml
+    QML/pages/Test2D.qml
+
+    QML/controllers/ConfigController.qml
+    QML/controllers/SirenController.qml
+    QML/controllers/WebSocketController.qml
+
+    QML/components/ControllersPanel.qml
+    QML/components/NumberDisplay2D.qml
+    QML/components/SirenSelector.qml
+    QML/components/StaffZone2D.qml
+    QML/components/Test2DButtons.qml
+    QML/components/TopDisplays2D.qml
+    QML/components/ambitus/AmbitusDisplay2D.qml
+    QML/components/ambitus/AmbitusPiano2D.qml
+    QML/components/ambitus/GearShiftPositionIndicator.qml
+    QML/components/ambitus/LedgerLines2D.qml
+    QML/components/ambitus/MeasureBar2D.qml
+    QML/components/ambitus/MusicalStaff2D.qml
+    QML/components/ambitus/NoteCursor2D.qml
+    QML/components/ambitus/NotePositionCalculator.qml
+    QML/components/ambitus/NotePositionCalculator2D.qml
+    QML/components/ambitus/NoteProgressBar2D.qml
+    QML/components/indicators/EncoderIndicator.qml
+    QML/components/indicators/FaderIndicator.qml
+    QML/components/indicators/GearShiftIndicator.qml
+    QML/components/indicators/JoystickIndicator.qml
+    QML/components/indicators/PadIndicator.qml
+    QML/components/indicators/PedalIndicator.qml
+    QML/components/indicators/WheelIndicator.qml
+
+    QML/utils/Clef2D.qml
+    QML/utils/Clef2DPath.qml
+    QML/utils/ColorPicker.qml
+    QML/utils/DigitLED2D.qml
+    QML/utils/DigitLED3D.qml
+    QML/utils/Knob.qml
+    QML/utils/LEDSegment.qml
+    QML/utils/LEDSegment2D.qml
+    QML/utils/LEDText2D.qml
+    QML/utils/LEDText3D.qml
+    QML/utils/MusicUtils.qml
+    QML/utils/Ring3D.qml
+
+    # Chargés à la première ouverture du panneau Admin
+    QML/admin/AdminPanel.qml
+    QML/admin/AdvancedSection.qml
+    QML/admin/OutputSection.qml
+    QML/admin/SirenSelectionSection.qml
+    QML/admin/VisibilitySection.qml
+    QML/admin/advanced/AdvancedAbout.qml
+    QML/admin/advanced/AdvancedAnimations.qml
+    QML/admin/advanced/AdvancedColors.qml
+    QML/admin/advanced/AdvancedConfig.qml
+    QML/admin/advanced/AdvancedSizes.qml
+    QML/admin/advanced/AdvancedWebSocket.qml
+    QML/admin/visibility/VisibilityControllers.qml
+    QML/admin/visibility/VisibilityMainDisplays.qml
+    QML/admin/visibility/VisibilityMusicalStaff.qml
+
+    # Chargés à la première entrée en mode jeu
+    QML/game/AnticipationLine2D.qml
+    QML/game/FallingMeasureBar2D.qml
+    QML/game/FallingNote2D.qml
+    QML/game/GameAutonomyPanel.qml
+    QML/game/GameMode.qml
+    QML/game/GameOptionsDialog.qml
+    QML/game/GameSequencer.js
+    QML/game/MelodicLine2D.qml
+    QML/game/PlaybackState.qml
+    QML/game/ScoringEngine.qml
+    QML/game/SequencerController.qml
+    QML/game/SongSelectorDialog.qml
+)
+
+set(PUPITRE_RESOURCES
+    config.js
+    QML/fonts/MusiSync.ttf
+    QML/fonts/NotoMusic-Regular.ttf
+    QML/game/README.md
+)
+
+# Polices partagées entre les applications (qrc:/fonts/...)
+set(PUPITRE_SHARED_FONTS
+    EmojiFont.qml
+    NotoEmoji-VariableFont_wght.ttf
+)
+
+# pupitre_add_qml_module(<cible> <uri>) : chemins absolus + alias, utilisable
+# depuis n'importe quel répertoire CMake
+function(pupitre_add_qml_module target uri)
+    set(qml_files)
+    foreach(file IN LISTS PUPITRE_QML_FILES)
+        set_source_files_properties(${PUPITRE_SOURCE_DIR}/${file} PROPERTIES QT_RESOURCE_ALIAS ${file})
+        list(APPEND qml_files ${PUPITRE_SOURCE_DIR}/${file})
+    endforeach()
+
+    set(resources)
+    foreach(file IN LISTS PUPITRE_RESOURCES)
+        set_source_files_properties(${PUPITRE_SOURCE_DIR}/${file} PROPERTIES QT_RESOURCE_ALIAS ${file})
+        list(APPEND resources ${PUPITRE_SOURCE_DIR}/${file})
+    endforeach()
+    foreach(file IN LISTS PUPITRE_SHARED_FONTS)
+        set_source_files_properties(${PUPITRE_SOURCE_DIR}/../fonts/${file} PROPERTIES QT_RESOURCE_ALIAS fonts/${file})
+        list(APPEND resources ${PUPITRE_SOURCE_DIR}/../fonts/${file})
+    endforeach()
+
+    qt_add_qml_module(${target}
+        URI ${uri}
+        VERSION 1.0
+        RESOURCE_PREFIX /
+        NO_RESOURCE_TARGET_PATH
+        QML_FILES ${qml_files}
+        RESOURCES ${resources}
+    )
+endfunction()
@@ -0,0 +1,34 @@
+#include "pupitretypes.h"
+#include "taperedboxgeometry.h"
+#include "simpletestgeometry.h"
+#include "chunkreassembler.h"
+#include "configreplica.h"
+#include "controllermapper.h"
+#include "framedecoder.h"
+#include "showclock.h"
+#include "notejitterbuffer.h"
+#include "wheelpredictor.h"
+#include "startuptimeline.h"
+#include "LogQml.h"
+#include "MemoryMonitor.h"
+#include "TrafficRecorder.h"
+#include "TrafficReplayer.h"
+#include <QtQml/qqml.h>
+
+void registerPupitreTypes()
+{
+    qmlRegisterType<TaperedBoxGeometry>("GameGeometry", 1, 0, "TaperedBoxGeometry");
+    qmlRegisterType<SimpleTestGeometry>("GameGeometry", 1, 0, "SimpleTestGeometry");
+    qmlRegisterType<ChunkReassembler>("PupitreEngine", 1, 0, "ChunkReassembler");
+    qmlRegisterType<ConfigReplica>("PupitreEngine", 1, 0, "ConfigReplica");
+    qmlRegisterType<ControllerMapper>("PupitreEngine", 1, 0, "ControllerMapper");
+    qmlRegisterType<FrameDecoder>("PupitreEngine", 1, 0, "FrameDecoder");
+    qmlRegisterType<ShowClock>("PupitreEngine", 1, 0, "ShowClock");
+    qmlRegisterType<NoteJitterBuffer>("PupitreEngine", 1, 0, "NoteJitterBuffer");
+    qmlRegisterType<WheelPredictor>("PupitreEngine", 1, 0, "WheelPredictor");
+    qmlRegisterType<TrafficRecorder>("PupitreEngine", 1, 0, "TrafficRecorder");
+    qmlRegisterType<TrafficReplayer>("PupitreEngine", 1, 0, "TrafficReplayer");
+    qmlRegisterSingletonInstance("PupitreEngine", 1, 0, "StartupTimeline", StartupTimeline::instance());
+    qmlRegisterSingletonInstance("PupitreEngine", 1, 0, "MemoryMonitor", MemoryMonitor::instance());
+    LogQml::registerQmlType("PupitreEngine", 1, 0);
+}
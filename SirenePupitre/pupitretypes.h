@@ -0,0 +1,8 @@
+#ifndef PUPITRETYPES_H
+#define PUPITRETYPES_H
+
+// Types C++ exposés au QML du pupitre (GameGeometry, PupitreEngine).
+// Partagé par l'application et le banc de rendu hors écran (benchmarks/).
+void registerPupitreTypes();
+
+#endif // PUPITRETYPES_H
@@ -0,0 +1,338 @@
+#include "showclock.h"
+#include <QDateTime>
+#include <QtEndian>
+#include <cmath>
+
+namespace {
+constexpr char kMagic[4] = { 'M', 'C', 'L', 'K' };
+constexpr int kHeaderSize = 6;
+constexpr int kPingSize = kHeaderSize + 8 + 8 + 4 + 4 + 4 + 1;
+constexpr int kPongSize = kHeaderSize + 8 + 8 + 8;
+constexpr int kAnchorSize = kHeaderSize + 8 + 4 + 4 + 2 + 1;
+
+// Filtre : meilleur aller-retour parmi les 8 derniers échanges
+constexpr int kFilterWindow = 8;
+// Points retenus pour la régression décalage / dérive
+constexpr int kHistorySize = 32;
+// Rafale au démarrage pour converger vite
+constexpr int kBurstSamples = 8;
+constexpr int kBurstInterval = 100;
+constexpr int kMinSamplesForSync = 4;
+// La dérive n'est estimée qu'au-delà de 10 s d'observation, bornée à ±500 ppm
+constexpr qint64 kMinDriftSpanUs = 10 * 1000 * 1000;
+constexpr double kMaxDrift = 500e-6;
+// Au-delà de 20 ms on saute, en dessous on étale sur 1 s
+constexpr double kStepThresholdUs = 20000.0;
+constexpr double kSlewDurationUs = 1000000.0;
+// Échange trop long pour être exploitable
+constexpr qint64 kMaxRttUs = 2 * 1000 * 1000;
+
+void writeHeader(QByteArray &frame, ShowClock::Kind kind, int pupitre)
+{
+    frame.append(kMagic, 4);
+    frame.append(char(kind));
+    frame.append(char(quint8(pupitre)));
+}
+
+template<typename T>
+void append(QByteArray &frame, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    frame.append(bytes, sizeof(T));
+}
+
+template<typename T>
+T read(const QByteArray &frame, int offset)
+{
+    return qFromLittleEndian<T>(frame.constData() + offset);
+}
+}
+
+ShowClock::ShowClock(QObject *parent)
+    : QObject(parent)
+    , m_localBase(QDateTime::currentMSecsSinceEpoch() * 1000)
+    , m_running(false)
+    , m_pupitreIndex(0)
+    , m_interval(2000)
+    , m_sampleCount(0)
+    , m_synced(false)
+    , m_refLocal(0)
+    , m_refOffset(0.0)
+    , m_drift(0.0)
+    , m_jitter(0.0)
+    , m_bestRtt(0)
+    , m_reportedOffset(0.0)
+    , m_slewStart(0)
+    , m_slewAmount(0.0)
+    , m_anchorShowTime(0)
+    , m_anchorTick(0)
+    , m_anchorTempo(500000)
+    , m_anchorPpq(480)
+    , m_anchorPlaying(false)
+{
+    m_elapsed.start();
+    m_pingTimer.setSingleShot(true);
+    m_pingTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_pingTimer, &QTimer::timeout, this, &ShowClock::sendPing);
+}
+
+void ShowClock::setRunning(bool running)
+{
+    if (m_running == running)
+        return;
+    m_running = running;
+    if (m_running)
+        reset();
+    else
+        m_pingTimer.stop();
+    emit runningChanged();
+}
+
+void ShowClock::setPupitreIndex(int index)
+{
+    index = qBound(0, index, 255);
+    if (m_pupitreIndex == index)
+        return;
+    m_pupitreIndex = index;
+    emit pupitreIndexChanged();
+}
+
+void ShowClock::setInterval(int interval)
+{
+    interval = qMax(kBurstInterval, interval);
+    if (m_interval == interval)
+        return;
+    m_interval = interval;
+    emit intervalChanged();
+}
+
+double ShowClock::playbackOriginMs() const
+{
+    if (m_anchorShowTime == 0 || m_anchorPpq <= 0)
+        return 0.0;
+    const double tickUs = double(m_anchorTempo) / m_anchorPpq;
+    return (double(m_anchorShowTime) - double(m_anchorTick) * tickUs) / 1000.0;
+}
+
+double ShowClock::now() const
+{
+    const qint64 local = localMicros();
+    return (double(local) + displayedOffset(local)) / 1000.0;
+}
+
+double ShowClock::tickAt(double showMs) const
+{
+    if (!m_anchorPlaying || m_anchorTempo == 0)
+        return double(m_anchorTick);
+    const double elapsedUs = showMs * 1000.0 - double(m_anchorShowTime);
+    return qMax(0.0, double(m_anchorTick) + elapsedUs * m_anchorPpq / double(m_anchorTempo));
+}
+
+double ShowClock::timeOfTick(double tick) const
+{
+    if (m_anchorPpq <= 0)
+        return 0.0;
+    const double tickUs = double(m_anchorTempo) / m_anchorPpq;
+    return (double(m_anchorShowTime) + (tick - double(m_anchorTick)) * tickUs) / 1000.0;
+}
+
+bool ShowClock::isClockFrame(const QByteArray &data)
+{
+    return data.size() >= kHeaderSize && data.startsWith(QByteArray::fromRawData(kMagic, 4));
+}
+
+bool ShowClock::handleFrame(const QByteArray &data)
+{
+    // Heure d'arrivée relevée avant tout traitement
+    const qint64 t3 = localMicros();
+    if (!isClockFrame(data))
+        return false;
+
+    const quint8 pupitre = quint8(data.at(5));
+    if (pupitre != 0 && m_pupitreIndex != 0 && pupitre != m_pupitreIndex)
+        return true;
+
+    switch (Kind(quint8(data.at(4)))) {
+    case Kind::Pong: {
+        if (data.size() < kPongSize)
+            return true;
+        const qint64 t0 = read<qint64>(data, kHeaderSize);
+        const qint64 t1 = read<qint64>(data, kHeaderSize + 8);
+        const qint64 t2 = read<qint64>(data, kHeaderSize + 16);
+        if (t0 > t3 || t3 - t0 > kMaxRttUs || t2 < t1)
+            return true;
+
+        Sample sample;
+        sample.offset = ((t1 - t0) + (t2 - t3)) / 2;
+        sample.rtt = qMax<qint64>(0, (t3 - t0) - (t2 - t1));
+        sample.local = t0 + (t3 - t0) / 2;
+        addSample(sample);
+        break;
+    }
+    case Kind::Anchor: {
+        if (data.size() < kAnchorSize)
+            return true;
+        m_anchorShowTime = read<qint64>(data, kHeaderSize);
+        m_anchorTick = read<quint32>(data, kHeaderSize + 8);
+        m_anchorTempo = read<quint32>(data, kHeaderSize + 12);
+        m_anchorPpq = qMax(1, int(read<quint16>(data, kHeaderSize + 16)));
+        m_anchorPlaying = (quint8(data.at(kHeaderSize + 18)) & 0x01) != 0;
+        emit anchorChanged();
+        break;
+    }
+    case Kind::Ping:
+        // Trame pupitre → serveur : rien à faire côté pupitre
+        break;
+    }
+    return true;
+}
+
+void ShowClock::reset()
+{
+    m_window.clear();
+    m_accepted.clear();
+    m_sampleCount = 0;
+    m_refLocal = 0;
+    m_refOffset = 0.0;
+    m_drift = 0.0;
+    m_jitter = 0.0;
+    m_bestRtt = 0;
+    m_reportedOffset = 0.0;
+    m_slewAmount = 0.0;
+    if (m_synced) {
+        m_synced = false;
+        emit syncedChanged();
+    }
+    emit statsChanged();
+
+    if (m_running)
+        m_pingTimer.start(0);
+}
+
+void ShowClock::sendPing()
+{
+    QByteArray frame;
+    frame.reserve(kPingSize);
+    writeHeader(frame, Kind::Ping, m_pupitreIndex);
+    const qint64 t0 = localMicros();
+    append<qint64>(frame, t0);
+    append<qint64>(frame, qint64(std::llround(m_reportedOffset)));
+    append<quint32>(frame, quint32(qMin<qint64>(m_bestRtt, 0xFFFFFFFF)));
+    append<quint32>(frame, quint32(qMin(m_jitter, 4.0e9)));
+    append<qint32>(frame, qint32(std::lround(m_drift * 1e9)));
+    append<quint8>(frame, m_synced ? 0x01 : 0x00);
+    emit frameReady(frame);
+
+    scheduleNextPing();
+}
+
+void ShowClock::scheduleNextPing()
+{
+    if (!m_running)
+        return;
+    m_pingTimer.start(m_sampleCount < kBurstSamples ? kBurstInterval : m_interval);
+}
+
+qint64 ShowClock::localMicros() const
+{
+    return m_localBase + m_elapsed.nsecsElapsed() / 1000;
+}
+
+double ShowClock::modelOffset(qint64 local) const
+{
+    return m_refOffset + m_drift * double(local - m_refLocal);
+}
+
+double ShowClock::displayedOffset(qint64 local) const
+{
+    if (m_sampleCount == 0)
+        return 0.0;
+    double offset = modelOffset(local);
+    if (m_slewAmount != 0.0) {
+        const double progress = double(local - m_slewStart) / kSlewDurationUs;
+        if (progress < 1.0)
+            offset -= m_slewAmount * (1.0 - qMax(0.0, progress));
+    }
+    return offset;
+}
+
+void ShowClock::addSample(const Sample &sample)
+{
+    m_window.append(sample);
+    if (m_window.size() > kFilterWindow)
+        m_window.removeFirst();
+    ++m_sampleCount;
+
+    // Le meilleur échange de la fenêtre ; on ne le retient qu'une fois
+    const Sample *best = &m_window.first();
+    for (const Sample &s : m_window) {
+        if (s.rtt < best->rtt)
+            best = &s;
+    }
+    m_bestRtt = best->rtt;
+    if (m_accepted.isEmpty() || m_accepted.last().local < best->local) {
+        m_accepted.append(*best);
+        if (m_accepted.size() > kHistorySize)
+            m_accepted.removeFirst();
+
+        const qint64 local = localMicros();
+        const bool hadModel = m_sampleCount > 1;
+        const double before = displayedOffset(local);
+        refit();
+        const double jump = modelOffset(local) - before;
+        if (!hadModel || !m_synced || std::abs(jump) > kStepThresholdUs) {
+            m_slewAmount = 0.0;
+        } else {
+            m_slewStart = local;
+            m_slewAmount = jump;
+        }
+        m_reportedOffset = modelOffset(local);
+    }
+
+    if (!m_synced && m_sampleCount >= kMinSamplesForSync) {
+        m_synced = true;
+        emit syncedChanged();
+    }
+    emit statsChanged();
+}
+
+void ShowClock::refit()
+{
+    const Sample &latest = m_accepted.last();
+    const int n = m_accepted.size();
+    const qint64 span = latest.local - m_accepted.first().local;
+
+    if (n >= 3 && span >= kMinDriftSpanUs) {
+        // Moindres carrés offset = a + b·local, centrés pour la précision
+        double meanLocal = 0.0;
+        double meanOffset = 0.0;
+        for (const Sample &s : m_accepted) {
+            meanLocal += double(s.local - latest.local);
+            meanOffset += double(s.offset);
+        }
+        meanLocal /= n;
+        meanOffset /= n;
+        double sxy = 0.0;
+        double sxx = 0.0;
+        for (const Sample &s : m_accepted) {
+            const double dx = double(s.local - latest.local) - meanLocal;
+            sxy += dx * (double(s.offset) - meanOffset);
+            sxx += dx * dx;
+        }
+        m_drift = sxx > 0.0 ? qBound(-kMaxDrift, sxy / sxx, kMaxDrift) : 0.0;
+        m_refLocal = latest.local + qint64(meanLocal);
+        m_refOffset = meanOffset;
+    } else {
+        m_refLocal = latest.local;
+        m_refOffset = double(latest.offset);
+    }
+
+    // Dispersion des points retenus autour du modèle
+    double sum = 0.0;
+    for (const Sample &s : m_accepted) {
+        const double residual = double(s.offset) - modelOffset(s.local);
+        sum += residual * residual;
+    }
+    m_jitter = std::sqrt(sum / n);
+}
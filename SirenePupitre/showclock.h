@@ -0,0 +1,150 @@
+#ifndef SHOWCLOCK_H
+#define SHOWCLOCK_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+// Horloge de spectacle partagée Console ↔ Pupitres (trames "MCLK").
+// Le serveur de la console est la référence : le pupitre envoie des pings
+// horodatés, le serveur répond avec ses heures de réception et d'émission
+// (échange de type NTP). Parmi les derniers échantillons on retient celui de
+// plus petit aller-retour, le moins perturbé par la file réseau ; une régression
+// sur ces points donne le décalage et la dérive de l'horloge locale. Les petites
+// corrections sont étalées (slew) pour que now() reste continu et croissant.
+//
+// Trame :
+//   [0..3] magic "MCLK"
+//   [4]    type (Kind)
+//   [5]    pupitre (1..7, 0 = non précisé)
+//   Ping   pupitre → serveur : t0 i64, offset i64, rtt u32, jitter u32, drift i32 (ppb), flags u8
+//   Pong   serveur → pupitre : t0 i64 (écho), t1 i64 (réception), t2 i64 (émission)
+//   Anchor serveur → pupitre : showTime i64, tick u32, tempo u32 (µs/noire), ppq u16, flags u8
+// Entiers little-endian, temps en microsecondes depuis l'epoch (horloge du serveur
+// pour t1, t2 et showTime, horloge locale pour t0).
+class ShowClock : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning WRITE setRunning NOTIFY runningChanged)
+    Q_PROPERTY(int pupitreIndex READ pupitreIndex WRITE setPupitreIndex NOTIFY pupitreIndexChanged)
+    Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged)
+    Q_PROPERTY(bool synced READ isSynced NOTIFY syncedChanged)
+    Q_PROPERTY(double offsetMs READ offsetMs NOTIFY statsChanged)
+    Q_PROPERTY(double rttMs READ rttMs NOTIFY statsChanged)
+    Q_PROPERTY(double jitterMs READ jitterMs NOTIFY statsChanged)
+    Q_PROPERTY(double driftPpm READ driftPpm NOTIFY statsChanged)
+    Q_PROPERTY(int sampleCount READ sampleCount NOTIFY statsChanged)
+    // Dernière ancre du séquenceur (position en ticks à une heure de spectacle)
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY anchorChanged)
+    Q_PROPERTY(double tempoBpm READ tempoBpm NOTIFY anchorChanged)
+    Q_PROPERTY(int ppq READ ppq NOTIFY anchorChanged)
+    Q_PROPERTY(double playbackOriginMs READ playbackOriginMs NOTIFY anchorChanged)
+
+public:
+    enum class Kind : quint8 {
+        Ping = 1,
+        Pong = 2,
+        Anchor = 3
+    };
+
+    explicit ShowClock(QObject *parent = nullptr);
+
+    bool isRunning() const { return m_running; }
+    void setRunning(bool running);
+    int pupitreIndex() const { return m_pupitreIndex; }
+    void setPupitreIndex(int index);
+    int interval() const { return m_interval; }
+    void setInterval(int interval);
+
+    bool isSynced() const { return m_synced; }
+    double offsetMs() const { return m_reportedOffset / 1000.0; }
+    double rttMs() const { return m_bestRtt / 1000.0; }
+    double jitterMs() const { return m_jitter / 1000.0; }
+    double driftPpm() const { return m_drift * 1e6; }
+    int sampleCount() const { return m_sampleCount; }
+
+    bool isPlaying() const { return m_anchorPlaying; }
+    double tempoBpm() const { return m_anchorTempo > 0 ? 60000000.0 / m_anchorTempo : 0.0; }
+    int ppq() const { return m_anchorPpq; }
+    // Heure de spectacle du tick 0 pour l'ancre courante (0 sans ancre). Calculée au seul
+    // tempo de l'ancre : le pupitre n'a pas la carte des tempos, le résultat n'est exact
+    // que si le tempo n'a pas changé entre le tick 0 et le tick de l'ancre
+    double playbackOriginMs() const;
+
+    // Heure de spectacle en ms depuis l'epoch (heure locale tant que non synchronisé)
+    Q_INVOKABLE double now() const;
+    // Position du séquenceur (ticks, fractionnaire) à une heure de spectacle
+    Q_INVOKABLE double tickAt(double showMs) const;
+    // Heure de spectacle d'un tick selon l'ancre courante
+    Q_INVOKABLE double timeOfTick(double tick) const;
+
+    // Retourne true si le message est une trame d'horloge (consommée), false sinon
+    Q_INVOKABLE bool handleFrame(const QByteArray &data);
+    // Oublie l'estimation (ex. reconnexion) et relance une rafale de pings
+    Q_INVOKABLE void reset();
+
+    static bool isClockFrame(const QByteArray &data);
+
+signals:
+    void runningChanged();
+    void pupitreIndexChanged();
+    void intervalChanged();
+    void syncedChanged();
+    void statsChanged();
+    void anchorChanged();
+    // Trame binaire à envoyer au serveur (ping)
+    void frameReady(const QByteArray &frame);
+
+private slots:
+    void sendPing();
+
+private:
+    struct Sample {
+        qint64 local = 0;   // heure locale (µs) du milieu de l'échange
+        qint64 offset = 0;  // serveur - local (µs)
+        qint64 rtt = 0;     // aller-retour hors temps de traitement serveur (µs)
+    };
+
+    qint64 localMicros() const;
+    double modelOffset(qint64 local) const;
+    double displayedOffset(qint64 local) const;
+    void addSample(const Sample &sample);
+    void refit();
+    void scheduleNextPing();
+
+    QElapsedTimer m_elapsed;
+    qint64 m_localBase;
+    QTimer m_pingTimer;
+    bool m_running;
+    int m_pupitreIndex;
+    int m_interval;
+
+    // Fenêtre brute (filtre du plus petit aller-retour) puis points retenus
+    QVector<Sample> m_window;
+    QVector<Sample> m_accepted;
+    int m_sampleCount;
+    bool m_synced;
+
+    // Modèle : offset(local) = m_refOffset + m_drift * (local - m_refLocal)
+    qint64 m_refLocal;
+    double m_refOffset;
+    double m_drift;
+    double m_jitter;
+    qint64 m_bestRtt;
+    double m_reportedOffset;
+
+    // Correction en cours d'étalement
+    qint64 m_slewStart;
+    double m_slewAmount;
+
+    // Ancre du séquenceur
+    qint64 m_anchorShowTime;
+    quint32 m_anchorTick;
+    quint32 m_anchorTempo;
+    int m_anchorPpq;
+    bool m_anchorPlaying;
+};
+
+#endif // SHOWCLOCK_H
@@ -0,0 +1,161 @@
+#include "startuptimeline.h"
+#include "MecavivLog.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QQuickWindow>
+#include <QSysInfo>
+#include <QTimer>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+MECAVIV_LOG_CATEGORY(lcStartup, "STARTUP", MecavivLog::Level::Info)
+
+namespace {
+
+// Jalons qui rendent le pupitre jouable
+const char *const kRequiredMarks[] = { "firstFrame", "websocketConnected", "configReceived" };
+
+// Temps écoulé depuis le lancement du processus (chargement des bibliothèques compris).
+// Linux : /proc/self/stat (starttime, en tops d'horloge depuis l'amorçage) et /proc/uptime,
+// résolution de 10 ms. Ailleurs : 0, la chronologie part de main().
+double processAgeMs()
+{
+#ifdef Q_OS_LINUX
+    QFile stat(QStringLiteral("/proc/self/stat"));
+    QFile uptime(QStringLiteral("/proc/uptime"));
+    if (!stat.open(QIODevice::ReadOnly) || !uptime.open(QIODevice::ReadOnly))
+        return 0.0;
+    // Le nom du processus (2e champ) peut contenir des espaces : on repart de la dernière ')'
+    const QByteArray line = stat.readAll();
+    const QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+    const qsizetype startTimeField = 22 - 3;
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (fields.size() <= startTimeField || ticksPerSecond <= 0)
+        return 0.0;
+    const double startedMs = fields.at(startTimeField).toDouble() * 1000.0 / double(ticksPerSecond);
+    const double uptimeMs = uptime.readAll().split(' ').value(0).toDouble() * 1000.0;
+    return qMax(0.0, uptimeMs - startedMs);
+#else
+    return 0.0;
+#endif
+}
+
+}
+
+StartupTimeline *StartupTimeline::instance()
+{
+    static StartupTimeline timeline;
+    return &timeline;
+}
+
+StartupTimeline::StartupTimeline(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void StartupTimeline::begin()
+{
+    m_processOffsetMs = processAgeMs();
+    m_clock.start();
+    markAt(QStringLiteral("main"), m_processOffsetMs);
+}
+
+void StartupTimeline::watchWindow(QQuickWindow *window)
+{
+    if (!window || m_frameSeen.load())
+        return;
+    // frameSwapped est émis par le thread de rendu (boucle threaded) : on y lit l'heure,
+    // le jalon est enregistré sur le thread principal
+    m_frameConnection = connect(window, &QQuickWindow::frameSwapped, this, [this]() {
+        if (m_frameSeen.exchange(true))
+            return;
+        const double atMs = elapsedMs();
+        QMetaObject::invokeMethod(this, [this, atMs]() {
+            disconnect(m_frameConnection);
+            markAt(QStringLiteral("firstFrame"), atMs);
+        }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+}
+
+void StartupTimeline::mark(const QString &name)
+{
+    markAt(name, elapsedMs());
+}
+
+double StartupTimeline::elapsedMs() const
+{
+    // Sans begin() (banc de rendu), l'origine est le premier jalon
+    if (!m_clock.isValid())
+        return 0.0;
+    return m_processOffsetMs + double(m_clock.nsecsElapsed()) / 1e6;
+}
+
+void StartupTimeline::markAt(const QString &name, double atMs)
+{
+    if (!m_clock.isValid())
+        m_clock.start();
+    for (const auto &mark : std::as_const(m_marks)) {
+        if (mark.first == name)
+            return;
+    }
+    m_marks.append({ name, atMs });
+    mlogInfo(lcStartup) << "Démarrage:" << name << QString::number(atMs, 'f', 1) << "ms";
+
+    if (m_complete)
+        return;
+    // Jouable au dernier des jalons requis (la première image arrive avec un léger différé)
+    double playableMs = 0.0;
+    for (const char *required : kRequiredMarks) {
+        bool found = false;
+        for (const auto &mark : std::as_const(m_marks)) {
+            if (mark.first == QLatin1String(required)) {
+                found = true;
+                playableMs = qMax(playableMs, mark.second);
+            }
+        }
+        if (!found)
+            return;
+    }
+    m_playableMs = playableMs;
+    finish();
+}
+
+void StartupTimeline::finish()
+{
+    m_complete = true;
+    emit completeChanged();
+
+    QStringList steps;
+    for (const auto &mark : std::as_const(m_marks))
+        steps.append(QStringLiteral("%1 %2").arg(mark.first, QString::number(mark.second, 'f', 0)));
+    mlogInfo(lcStartup) << "Pupitre jouable en" << QString::number(m_playableMs, 'f', 0) << "ms :"
+                        << steps.join(QStringLiteral(", "));
+
+    const QString path = qEnvironmentVariable("MECAVIV_STARTUP_TIMELINE");
+    if (!path.isEmpty()) {
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Append))
+            file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Compact) + '\n');
+        else
+            mlogWarn(lcStartup) << "Chronologie non écrite:" << path << file.errorString();
+    }
+    if (qEnvironmentVariableIntValue("MECAVIV_STARTUP_QUIT") != 0)
+        QTimer::singleShot(0, QCoreApplication::instance(), &QCoreApplication::quit);
+}
+
+QJsonObject StartupTimeline::toJson() const
+{
+    QJsonObject marks;
+    for (const auto &mark : m_marks)
+        marks.insert(mark.first, mark.second);
+    QJsonObject root;
+    root.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert(QStringLiteral("host"), QSysInfo::machineHostName());
+    root.insert(QStringLiteral("processOffsetMs"), m_processOffsetMs);
+    root.insert(QStringLiteral("playableMs"), m_complete ? m_playableMs : -1.0);
+    root.insert(QStringLiteral("marks"), marks);
+    return root;
+}
@@ -0,0 +1,60 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+class QQuickWindow;
+
+// Chronologie du démarrage du pupitre, en ms depuis le lancement du processus :
+//   main → engineCreated → qmlCreated → firstFrame → websocketConnected → configReceived
+// Le pupitre est jouable quand la première image est affichée, la connexion à
+// PureData ouverte et la configuration reçue (fin de l'overlay d'attente).
+// Chaque jalon n'est retenu qu'une fois (les reconnexions ne le déplacent pas).
+//
+// Journalisée en catégorie STARTUP. MECAVIV_STARTUP_TIMELINE=<fichier> ajoute une
+// ligne JSON par démarrage ; MECAVIV_STARTUP_QUIT=1 quitte dès que le pupitre est
+// jouable (mesures répétées sur le matériel du pupitre).
+class StartupTimeline : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool complete READ isComplete NOTIFY completeChanged)
+
+public:
+    static StartupTimeline *instance();
+
+    // Premier appel de main() : origine de l'horloge monotone
+    void begin();
+    // Première image rendue de la fenêtre principale (thread de rendu compris)
+    void watchWindow(QQuickWindow *window);
+
+    Q_INVOKABLE void mark(const QString &name);
+    Q_INVOKABLE double elapsedMs() const;
+
+    bool isComplete() const { return m_complete; }
+    QJsonObject toJson() const;
+
+signals:
+    void completeChanged();
+
+private:
+    explicit StartupTimeline(QObject *parent = nullptr);
+
+    void markAt(const QString &name, double atMs);
+    void finish();
+
+    QElapsedTimer m_clock;
+    double m_processOffsetMs = 0.0;     // lancement du processus → begin()
+    QVector<QPair<QString, double>> m_marks;
+    QMetaObject::Connection m_frameConnection;
+    std::atomic<bool> m_frameSeen { false };
+    double m_playableMs = 0.0;
+    bool m_complete = false;
+};
+
+#endif // STARTUPTIMELINE_H
@@ -1,12 +1,18 @@
 #include "taperedboxgeometry.h"
 #include <QVector>
 #include <QVector3D>
-#include <QDebug>
+#include "MecavivLog.h"
+
+// TRACE désactivé par défaut : un appel coûte un branchement (MECAVIV_LOG="GEOMETRY=trace")
+MECAVIV_LOG_CATEGORY(lcGeometry, "GEOMETRY", MecavivLog::Level::Warn)
 
 TaperedBoxGeometry::TaperedBoxGeometry(QQuick3DObject *parent)
     : QQuick3DGeometry(parent)
+    , m_memory("geometry", "TaperedBoxGeometry", [this] {
+          return MecavivMemory::Usage { 1, qint64(m_vertexBuffer.size() + m_indexBuffer.size()) };
+      })
 {
-    // qDebug() << "TaperedBoxGeometry constructor";
+    mlogTrace(lcGeometry) << "TaperedBoxGeometry constructor";
     
     // Attack (pyramide inversée) + Cube (sustain) + Release (pyramide)
     struct Vertex {
@@ -50,9 +56,9 @@ TaperedBoxGeometry::TaperedBoxGeometry(QQuick3DObject *parent)
     const float yTop = halfTotal;                              // Haut sustain
     const float yPeak = halfTotal + hReleasePyramid;           // Sommet release
     
-    // qDebug() << "Constructor - attackTime:" << m_attackTime << "duration:" << m_duration 
-    //          << "attackRatio:" << attackRatio << "effectiveVelocity:" << effectiveVelocity
-    //          << "attackHeightVisual:" << attackHeightVisual << "sustainHeight:" << sustainHeight;
+    mlogTrace(lcGeometry) << "Constructor - attackTime:" << m_attackTime << "duration:" << m_duration
+                          << "attackRatio:" << attackRatio << "effectiveVelocity:" << effectiveVelocity
+                          << "attackHeightVisual:" << attackHeightVisual << "sustainHeight:" << sustainHeight;
     
     // 18 vertices : 5 (attack) + 8 (cube) + 5 (release)
     Vertex vertices[] = {
@@ -112,8 +118,8 @@ TaperedBoxGeometry::TaperedBoxGeometry(QQuick3DObject *parent)
     QByteArray vertexBuffer(reinterpret_cast<char*>(vertices), sizeof(vertices));
     QByteArray indexBuffer(reinterpret_cast<char*>(indices), sizeof(indices));
     
-    // qDebug() << "Setting up geometry - vertexBuffer:" << vertexBuffer.size() 
-    //          << "indexBuffer:" << indexBuffer.size();
+    mlogTrace(lcGeometry) << "Setting up geometry - vertexBuffer:" << vertexBuffer.size()
+                          << "indexBuffer:" << indexBuffer.size();
     
     setStride(sizeof(Vertex));
     setVertexData(vertexBuffer);
@@ -129,9 +135,9 @@ TaperedBoxGeometry::TaperedBoxGeometry(QQuick3DObject *parent)
     addAttribute(QQuick3DGeometry::Attribute::IndexSemantic, 0,
                  QQuick3DGeometry::Attribute::U32Type);
     
-    // qDebug() << "Geometry configured, calling update()";
+    mlogTrace(lcGeometry) << "Geometry configured, calling update()";
     update();
-    // qDebug() << "Geometry ready";
+    mlogTrace(lcGeometry) << "Geometry ready";
 }
 
 void TaperedBoxGeometry::setAttackTime(float time)
@@ -241,11 +247,11 @@ void TaperedBoxGeometry::updateGeometry()
     const float yTop = halfTotal;                              // Haut sustain
     const float yPeak = halfTotal + hReleasePyramid;           // Sommet release
     
-    // qDebug() << "updateGeometry() - attackTime:" << m_attackTime << "duration:" << m_duration 
-    //          << "attackRatio:" << attackRatio << "effectiveVelocity:" << effectiveVelocity
-    //          << "attackHeightVisual:" << attackHeightVisual << "sustainHeight:" << sustainHeight
-    //          << "releaseHeight:" << m_releaseHeight << "width:" << (w*2) << "depth:" << (d*2)
-    //          << "bounds: yAttackBottom=" << yAttackBottom << "yPeak=" << yPeak;
+    mlogTrace(lcGeometry) << "updateGeometry() - attackTime:" << m_attackTime << "duration:" << m_duration
+                          << "attackRatio:" << attackRatio << "effectiveVelocity:" << effectiveVelocity
+                          << "attackHeightVisual:" << attackHeightVisual << "sustainHeight:" << sustainHeight
+                          << "releaseHeight:" << m_releaseHeight << "width:" << (w*2) << "depth:" << (d*2)
+                          << "bounds: yAttackBottom=" << yAttackBottom << "yPeak=" << yPeak;
     
     // 18 vertices
     Vertex vertices[] = {
@@ -3,6 +3,7 @@
 
 #include <QQuick3DGeometry>
 #include <QVector3D>
+#include "MemoryAccounting.h"
 
 // Géométrie custom : cube (sustain) + pyramide effilée (release)
 class TaperedBoxGeometry : public QQuick3DGeometry
@@ -65,6 +66,9 @@ private:
     // Garder les buffers en membres pour qu'ils persistent
     QByteArray m_vertexBuffer;
     QByteArray m_indexBuffer;
+
+    // Comptabilité mémoire : buffers partagés (implicitement) avec QQuick3DGeometry
+    MecavivMemory::Source m_memory;
 };
 
 #endif // TAPEREDBOXGEOMETRY_H
@@ -0,0 +1,282 @@
+#include "wheelpredictor.h"
+#include <cmath>
+
+namespace {
+// Au-delà de ce silence le mouvement précédent n'a plus de sens : on repart de la mesure
+constexpr double kResetGapMs = 250.0;
+// Moyennes d'erreur sur ~32 trames, max qui s'efface en ~50 trames
+constexpr double kErrorGain = 1.0 / 32.0;
+constexpr double kErrorMaxDecay = 0.98;
+constexpr int kMinErrorSamples = 8;
+// Hystérésis de la confiance (erreur prédite / erreur de maintien)
+constexpr double kDistrustRatio = 1.1;
+constexpr double kTrustRatio = 0.9;
+// Pas extrapolé maximal du volant : maxStep demi-tons ≈ maxStep × 10°
+constexpr double kDegreesPerStep = 10.0;
+constexpr double kPublishEpsilon = 1e-4;
+
+double wrapDegrees(double degrees)
+{
+    degrees = std::fmod(degrees, 360.0);
+    return degrees < 0.0 ? degrees + 360.0 : degrees;
+}
+
+// Écart signé le plus court sur le cercle
+double circularDelta(double delta)
+{
+    delta = std::fmod(delta + 180.0, 360.0);
+    return (delta < 0.0 ? delta + 360.0 : delta) - 180.0;
+}
+}
+
+WheelPredictor::WheelPredictor(QObject *parent)
+    : QObject(parent)
+    , m_enabled(true)
+    , m_alpha(0.85)
+    , m_beta(0.3)
+    , m_displayLeadMs(16)
+    , m_maxLeadMs(60)
+    , m_maxStep(1.0)
+    , m_errorSq(0.0)
+    , m_holdErrorSq(0.0)
+    , m_errorMax(0.0)
+    , m_errorSamples(0)
+    , m_trusted(true)
+{
+    m_wheel.circular = true;
+    m_elapsed.start();
+    m_frameTimer.setInterval(16);
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this, &WheelPredictor::advance);
+}
+
+void WheelPredictor::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    m_enabled = enabled;
+    if (!m_enabled) {
+        // Retour immédiat aux mesures
+        m_frameTimer.stop();
+        if (publish(m_note, m_note.measured))
+            emit predictedNoteChanged();
+        if (publish(m_wheel, m_wheel.measured))
+            emit predictedWheelPositionChanged();
+    }
+    emit enabledChanged();
+}
+
+void WheelPredictor::setAlpha(qreal alpha)
+{
+    alpha = qBound<qreal>(0.0, alpha, 1.0);
+    if (qFuzzyCompare(m_alpha, alpha))
+        return;
+    m_alpha = alpha;
+    emit tuningChanged();
+}
+
+void WheelPredictor::setBeta(qreal beta)
+{
+    beta = qBound<qreal>(0.0, beta, 1.0);
+    if (qFuzzyCompare(m_beta, beta))
+        return;
+    m_beta = beta;
+    emit tuningChanged();
+}
+
+void WheelPredictor::setDisplayLeadMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_displayLeadMs == ms)
+        return;
+    m_displayLeadMs = ms;
+    emit tuningChanged();
+}
+
+void WheelPredictor::setMaxLeadMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_maxLeadMs == ms)
+        return;
+    m_maxLeadMs = ms;
+    emit tuningChanged();
+}
+
+void WheelPredictor::setMaxStep(qreal step)
+{
+    step = qMax<qreal>(0.0, step);
+    if (qFuzzyCompare(m_maxStep, step))
+        return;
+    m_maxStep = step;
+    emit tuningChanged();
+}
+
+void WheelPredictor::setFrameIntervalMs(int ms)
+{
+    ms = qMax(1, ms);
+    if (m_frameTimer.interval() == ms)
+        return;
+    m_frameTimer.setInterval(ms);
+    emit tuningChanged();
+}
+
+double WheelPredictor::errorRms() const
+{
+    return std::sqrt(m_errorSq);
+}
+
+double WheelPredictor::holdErrorRms() const
+{
+    return std::sqrt(m_holdErrorSq);
+}
+
+void WheelPredictor::pushNote(double note)
+{
+    const double now = nowMs();
+    if (!m_enabled) {
+        m_note.valid = true;
+        m_note.measured = note;
+        if (publish(m_note, note))
+            emit predictedNoteChanged();
+        return;
+    }
+
+    const bool continuing = m_note.valid && now - m_note.arrival <= kResetGapMs;
+    // Erreur évaluée même quand la prédiction est coupée, pour pouvoir la rétablir
+    const double predicted = extrapolate(m_note, now, m_maxStep);
+    const double held = m_note.measured;
+    update(m_note, note, now);
+    if (continuing)
+        recordError(predicted, held, note);
+
+    publish(m_note, m_trusted ? extrapolate(m_note, now + m_displayLeadMs, m_maxStep) : note);
+    emit predictedNoteChanged();
+    ensureRunning();
+}
+
+void WheelPredictor::pushWheelPosition(double degrees)
+{
+    const double now = nowMs();
+    degrees = wrapDegrees(degrees);
+    if (!m_enabled) {
+        m_wheel.valid = true;
+        m_wheel.measured = degrees;
+        if (publish(m_wheel, degrees))
+            emit predictedWheelPositionChanged();
+        return;
+    }
+
+    update(m_wheel, degrees, now);
+    if (publish(m_wheel, extrapolate(m_wheel, now + m_displayLeadMs, m_maxStep * kDegreesPerStep)))
+        emit predictedWheelPositionChanged();
+    ensureRunning();
+}
+
+void WheelPredictor::reset()
+{
+    m_frameTimer.stop();
+    m_note = Channel();
+    m_wheel = Channel();
+    m_wheel.circular = true;
+    emit predictedNoteChanged();
+    emit predictedWheelPositionChanged();
+}
+
+void WheelPredictor::resetStats()
+{
+    m_errorSq = 0.0;
+    m_holdErrorSq = 0.0;
+    m_errorMax = 0.0;
+    m_errorSamples = 0;
+    m_trusted = true;
+    emit statsChanged();
+}
+
+void WheelPredictor::advance()
+{
+    const double now = nowMs();
+    const double display = now + m_displayLeadMs;
+    if (m_trusted && publish(m_note, extrapolate(m_note, display, m_maxStep)))
+        emit predictedNoteChanged();
+    if (publish(m_wheel, extrapolate(m_wheel, display, m_maxStep * kDegreesPerStep)))
+        emit predictedWheelPositionChanged();
+
+    // Plus rien ne bouge une fois les deux canaux revenus sur leur mesure
+    const double settle = 2.0 * m_maxLeadMs;
+    if ((!m_note.valid || display - m_note.arrival > settle)
+            && (!m_wheel.valid || display - m_wheel.arrival > settle))
+        m_frameTimer.stop();
+}
+
+double WheelPredictor::nowMs() const
+{
+    return m_elapsed.nsecsElapsed() / 1e6;
+}
+
+void WheelPredictor::update(Channel &channel, double value, double now)
+{
+    if (!channel.valid || now - channel.arrival > kResetGapMs) {
+        channel.valid = true;
+        channel.state = value;
+        channel.velocity = 0.0;
+    } else {
+        const double dt = qMax(1.0, now - channel.arrival);
+        const double expected = channel.state + channel.velocity * dt;
+        const double residual = channel.circular ? circularDelta(value - expected) : value - expected;
+        channel.state = expected + m_alpha * residual;
+        if (channel.circular)
+            channel.state = wrapDegrees(channel.state);
+        channel.velocity += m_beta * residual / dt;
+    }
+    channel.measured = value;
+    channel.arrival = now;
+}
+
+double WheelPredictor::extrapolate(const Channel &channel, double at, double stepLimit) const
+{
+    if (!channel.valid || m_maxLeadMs <= 0)
+        return channel.measured;
+    // Avance sur la mesure jusqu'à maxLeadMs, puis retour progressif vers la mesure
+    // si aucune trame ne vient confirmer le mouvement (volant arrêté entre-temps)
+    const double elapsed = qMax(0.0, at - channel.arrival);
+    const double lead = elapsed <= m_maxLeadMs
+            ? elapsed
+            : qMax(0.0, 2.0 * m_maxLeadMs - elapsed);
+    const double step = qBound(-stepLimit, channel.velocity * lead, stepLimit);
+    const double value = channel.measured + step;
+    return channel.circular ? wrapDegrees(value) : value;
+}
+
+bool WheelPredictor::publish(Channel &channel, double value)
+{
+    const double delta = channel.circular ? circularDelta(value - channel.display) : value - channel.display;
+    if (std::abs(delta) < kPublishEpsilon)
+        return false;
+    channel.display = value;
+    return true;
+}
+
+void WheelPredictor::recordError(double predicted, double held, double measured)
+{
+    const double error = std::abs(predicted - measured);
+    const double holdError = std::abs(held - measured);
+    m_errorSq += (error * error - m_errorSq) * kErrorGain;
+    m_holdErrorSq += (holdError * holdError - m_holdErrorSq) * kErrorGain;
+    m_errorMax = qMax(error, m_errorMax * kErrorMaxDecay);
+    ++m_errorSamples;
+
+    // La prédiction n'est gardée que si elle fait mieux que le maintien de la dernière mesure
+    if (m_errorSamples >= kMinErrorSamples) {
+        if (m_trusted && m_errorSq > m_holdErrorSq * kDistrustRatio * kDistrustRatio)
+            m_trusted = false;
+        else if (!m_trusted && m_errorSq < m_holdErrorSq * kTrustRatio * kTrustRatio)
+            m_trusted = true;
+    }
+    emit statsChanged();
+}
+
+void WheelPredictor::ensureRunning()
+{
+    if (m_maxLeadMs > 0 && !m_frameTimer.isActive())
+        m_frameTimer.start();
+}
@@ -0,0 +1,128 @@
+#ifndef WHEELPREDICTOR_H
+#define WHEELPREDICTOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+
+// Prédiction du volant entre deux trames pour masquer la latence d'affichage.
+// Deux canaux suivis par un filtre alpha-beta (position + vitesse) :
+//   - note : note du volant avec bend (0x03), en demi-tons
+//   - wheelPosition : angle brut du volant (0x02), en degrés 0-360, repliement géré
+// À chaque trame le filtre est recalé sur la mesure et la valeur affichée est déjà
+// extrapolée jusqu'à l'heure d'affichage (arrivée + displayLeadMs), puis entre deux
+// trames jusqu'à arrivée + écoulé + displayLeadMs. La mesure brute n'est publiée que
+// tant que la prédiction n'est pas jugée fiable (isTrusted).
+// L'extrapolation est bornée en durée (maxLeadMs) et en amplitude (maxStep), et coupée
+// tant que l'erreur de prédiction mesurée dépasse celle d'un simple maintien.
+class WheelPredictor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    // α : confiance dans la mesure pour l'état filtré, β : gain sur la vitesse
+    Q_PROPERTY(qreal alpha READ alpha WRITE setAlpha NOTIFY tuningChanged)
+    Q_PROPERTY(qreal beta READ beta WRITE setBeta NOTIFY tuningChanged)
+    // Avance supplémentaire pour viser l'instant où l'image sera affichée (≈ 1 frame)
+    Q_PROPERTY(int displayLeadMs READ displayLeadMs WRITE setDisplayLeadMs NOTIFY tuningChanged)
+    // Extrapolation maximale après la dernière trame
+    Q_PROPERTY(int maxLeadMs READ maxLeadMs WRITE setMaxLeadMs NOTIFY tuningChanged)
+    // Écart maximal extrapolé, en demi-tons (la position volant suit avec maxStep × 10°)
+    Q_PROPERTY(qreal maxStep READ maxStep WRITE setMaxStep NOTIFY tuningChanged)
+    Q_PROPERTY(int frameIntervalMs READ frameIntervalMs WRITE setFrameIntervalMs NOTIFY tuningChanged)
+
+    Q_PROPERTY(double predictedNote READ predictedNote NOTIFY predictedNoteChanged)
+    Q_PROPERTY(double measuredNote READ measuredNote NOTIFY predictedNoteChanged)
+    Q_PROPERTY(double predictedWheelPosition READ predictedWheelPosition NOTIFY predictedWheelPositionChanged)
+    Q_PROPERTY(bool hasNote READ hasNote NOTIFY predictedNoteChanged)
+    Q_PROPERTY(bool hasWheelPosition READ hasWheelPosition NOTIFY predictedWheelPositionChanged)
+
+    // Erreur de prédiction sur la note (demi-tons), comparée au maintien de la dernière mesure
+    Q_PROPERTY(double errorRms READ errorRms NOTIFY statsChanged)
+    Q_PROPERTY(double errorMax READ errorMax NOTIFY statsChanged)
+    Q_PROPERTY(double holdErrorRms READ holdErrorRms NOTIFY statsChanged)
+    Q_PROPERTY(bool trusted READ isTrusted NOTIFY statsChanged)
+
+public:
+    explicit WheelPredictor(QObject *parent = nullptr);
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    qreal alpha() const { return m_alpha; }
+    void setAlpha(qreal alpha);
+    qreal beta() const { return m_beta; }
+    void setBeta(qreal beta);
+    int displayLeadMs() const { return m_displayLeadMs; }
+    void setDisplayLeadMs(int ms);
+    int maxLeadMs() const { return m_maxLeadMs; }
+    void setMaxLeadMs(int ms);
+    qreal maxStep() const { return m_maxStep; }
+    void setMaxStep(qreal step);
+    int frameIntervalMs() const { return m_frameTimer.interval(); }
+    void setFrameIntervalMs(int ms);
+
+    double predictedNote() const { return m_note.display; }
+    double measuredNote() const { return m_note.measured; }
+    double predictedWheelPosition() const { return m_wheel.display; }
+    bool hasNote() const { return m_note.valid; }
+    bool hasWheelPosition() const { return m_wheel.valid; }
+
+    double errorRms() const;
+    double errorMax() const { return m_errorMax; }
+    double holdErrorRms() const;
+    bool isTrusted() const { return m_trusted; }
+
+    // Mesures, à appeler dès réception (avant tout throttling)
+    Q_INVOKABLE void pushNote(double note);
+    Q_INVOKABLE void pushWheelPosition(double degrees);
+    Q_INVOKABLE void reset();
+    Q_INVOKABLE void resetStats();
+
+signals:
+    void enabledChanged();
+    void tuningChanged();
+    void predictedNoteChanged();
+    void predictedWheelPositionChanged();
+    void statsChanged();
+
+private slots:
+    void advance();
+
+private:
+    struct Channel {
+        bool valid = false;
+        bool circular = false;
+        double measured = 0.0;     // dernière mesure
+        double state = 0.0;        // position filtrée
+        double velocity = 0.0;     // unités / ms
+        double arrival = 0.0;      // heure de la dernière mesure (ms)
+        double display = 0.0;      // valeur publiée
+    };
+
+    double nowMs() const;
+    void update(Channel &channel, double value, double now);
+    double extrapolate(const Channel &channel, double at, double stepLimit) const;
+    bool publish(Channel &channel, double value);
+    void recordError(double predicted, double held, double measured);
+    void ensureRunning();
+
+    bool m_enabled;
+    qreal m_alpha;
+    qreal m_beta;
+    int m_displayLeadMs;
+    int m_maxLeadMs;
+    qreal m_maxStep;
+
+    QElapsedTimer m_elapsed;
+    QTimer m_frameTimer;
+    Channel m_note;
+    Channel m_wheel;
+
+    // Moyennes exponentielles des carrés d'erreur, max décroissant
+    double m_errorSq;
+    double m_holdErrorSq;
+    double m_errorMax;
+    int m_errorSamples;
+    bool m_trusted;
+};
+
+#endif // WHEELPREDICTOR_H
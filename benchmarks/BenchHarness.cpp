@@ -0,0 +1,164 @@
+#include "BenchHarness.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<quint64> g_allocations { 0 };
+std::atomic<quint64> g_allocatedBytes { 0 };
+
+inline void countAllocation(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+}
+
+#if defined(__GLIBC__)
+// glibc : l'exécutable fournit malloc & co, les bibliothèques Qt passent par eux
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *pointer, std::size_t size);
+void __libc_free(void *pointer);
+
+void *malloc(std::size_t size)
+{
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, std::size_t size)
+{
+    countAllocation(size);
+    return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer)
+{
+    __libc_free(pointer);
+}
+}
+
+const char *Bench::allocationTracking()
+{
+    return "malloc";
+}
+#else
+// Ailleurs : allocations C++ uniquement (les buffers QArrayData passent par malloc)
+void *operator new(std::size_t size)
+{
+    countAllocation(size);
+    if (void *pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+const char *Bench::allocationTracking()
+{
+    return "operator new";
+}
+#endif
+
+#if !defined(__GNUC__) && !defined(__clang__)
+void Bench::escape(const void *pointer)
+{
+    static const void *volatile sink;
+    sink = pointer;
+}
+#endif
+
+quint64 Bench::allocationCount()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+quint64 Bench::allocatedBytes()
+{
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+Bench::Result Bench::run(const Benchmark &benchmark, const Options &options)
+{
+    Result result;
+    result.name = benchmark.name;
+
+    // Échauffement (caches, allocations paresseuses, premier appel)
+    if (!benchmark.body(1))
+        return result;
+
+    // Calibrage : N tel qu'une répétition dure ~minTimeMs
+    const qint64 targetNs = qint64(options.minTimeMs) * 1000000;
+    qint64 iterations = 1;
+    QElapsedTimer timer;
+    for (;;) {
+        timer.start();
+        if (!benchmark.body(iterations))
+            return result;
+        const qint64 elapsed = qMax<qint64>(1, timer.nsecsElapsed());
+        if (elapsed >= targetNs || iterations >= (qint64(1) << 40))
+            break;
+        const double scale = qBound(2.0, 1.2 * double(targetNs) / double(elapsed), 100.0);
+        iterations = qint64(double(iterations) * scale);
+    }
+
+    QVector<double> samples;
+    quint64 allocations = 0;
+    quint64 bytes = 0;
+    for (int repetition = 0; repetition < qMax(1, options.repetitions); ++repetition) {
+        const quint64 allocationsBefore = allocationCount();
+        const quint64 bytesBefore = allocatedBytes();
+        timer.start();
+        if (!benchmark.body(iterations))
+            return result;
+        const qint64 elapsed = timer.nsecsElapsed();
+        allocations += allocationCount() - allocationsBefore;
+        bytes += allocatedBytes() - bytesBefore;
+        samples.append(double(elapsed) / double(iterations));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const int count = samples.size();
+    result.ok = true;
+    result.iterations = iterations;
+    result.nsPerOp = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    result.nsPerOpMin = samples.first();
+    result.allocsPerOp = double(allocations) / double(iterations * count);
+    result.allocBytesPerOp = double(bytes) / double(iterations * count);
+    result.opsPerSecond = result.nsPerOp > 0.0 ? 1e9 / result.nsPerOp : 0.0;
+    result.bytesPerSecond = result.opsPerSecond * double(benchmark.bytesPerOp);
+    return result;
+}
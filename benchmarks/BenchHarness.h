@@ -0,0 +1,102 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+// Micro-benchmarks des chemins critiques (option CMake BUILD_BENCHMARKS).
+//
+// Chaque benchmark exécute N opérations ; N est calibré pour qu'une répétition dure
+// environ --min-time ms, puis la mesure est répétée et la médiane retenue. Pour
+// chaque benchmark : ns/op (médiane et minimum), allocations/op et octets alloués/op,
+// débit en op/s et, si la taille traitée par opération est connue, en octets/s.
+// La sortie --json se compare à un fichier précédent avec --baseline (même machine).
+namespace Bench {
+
+struct Options {
+    QRegularExpression filter;
+    int minTimeMs = 200;
+    int repetitions = 5;
+};
+
+// Corps d'un benchmark : exécute `iterations` opérations, false si la mesure a échoué
+using Body = std::function<bool(qint64 iterations)>;
+
+struct Benchmark {
+    QString name;
+    qint64 bytesPerOp = 0;
+    Body body;
+};
+
+struct Result {
+    QString name;
+    bool ok = false;
+    qint64 iterations = 0;
+    double nsPerOp = 0.0;
+    double nsPerOpMin = 0.0;
+    double allocsPerOp = 0.0;
+    double allocBytesPerOp = 0.0;
+    double opsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+};
+
+class Registry
+{
+public:
+    void add(const QString &name, qint64 bytesPerOp, Body body)
+    {
+        m_benchmarks.append({ name, bytesPerOp, std::move(body) });
+    }
+
+    // fn(i) pour i = 0..N-1
+    template <typename Fn>
+    void addLoop(const QString &name, qint64 bytesPerOp, Fn fn)
+    {
+        add(name, bytesPerOp, [fn](qint64 iterations) mutable {
+            for (qint64 i = 0; i < iterations; ++i)
+                fn(i);
+            return true;
+        });
+    }
+
+    const QVector<Benchmark> &benchmarks() const { return m_benchmarks; }
+
+private:
+    QVector<Benchmark> m_benchmarks;
+};
+
+Result run(const Benchmark &benchmark, const Options &options);
+
+// Compteurs globaux d'allocation : malloc/calloc/realloc interposés sous glibc
+// (allocations Qt comprises), operator new seul ailleurs
+quint64 allocationCount();
+quint64 allocatedBytes();
+const char *allocationTracking();
+
+// Empêche le compilateur d'éliminer un calcul dont le résultat n'est pas utilisé
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+#else
+void escape(const void *pointer);
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+    escape(&value);
+}
+#endif
+
+void registerProtocolBenchmarks(Registry &registry);
+void registerDispatchBenchmarks(Registry &registry);
+void registerGeometryBenchmarks(Registry &registry);
+void registerPlaylistBenchmarks(Registry &registry);
+void registerConfigBenchmarks(Registry &registry);
+
+} // namespace Bench
+
+#endif // BENCHHARNESS_H
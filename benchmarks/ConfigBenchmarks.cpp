@@ -0,0 +1,60 @@
+#include "BenchHarness.h"
+#include "ConfigDelta.h"
+#include <QCborArray>
+#include <QFile>
+#include <QJsonDocument>
+#include <memory>
+
+namespace {
+
+// config.template.json du dépôt, ou à défaut une configuration de taille comparable
+QCborMap sampleConfig()
+{
+    QFile file(QStringLiteral(MECAVIV_SOURCE_DIR "/config.template.json"));
+    if (file.open(QIODevice::ReadOnly)) {
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+        if (doc.isObject())
+            return QCborMap::fromJsonObject(doc.object());
+    }
+    QCborArray sirens;
+    for (int i = 1; i <= 7; ++i) {
+        QCborMap siren;
+        siren.insert(QStringLiteral("id"), i);
+        siren.insert(QStringLiteral("name"), QStringLiteral("S%1").arg(i));
+        siren.insert(QStringLiteral("ambitus"), QCborMap { { QStringLiteral("min"), 43 }, { QStringLiteral("max"), 86 } });
+        siren.insert(QStringLiteral("transposition"), 0);
+        siren.insert(QStringLiteral("outputs"), 8);
+        sirens.append(siren);
+    }
+    QCborMap config;
+    config.insert(QStringLiteral("sirenConfig"), QCborMap { { QStringLiteral("sirens"), sirens } });
+    return config;
+}
+
+}
+
+// Synchronisation console → pupitres : diff de deux snapshots et application du patch
+void Bench::registerConfigBenchmarks(Registry &registry)
+{
+    auto from = std::make_shared<QCborMap>(sampleConfig());
+    auto to = std::make_shared<QCborMap>(*from);
+    // Une feuille modifiée (cas d'un réglage changé dans l'interface)
+    (*to)[QStringLiteral("benchmarkRevision")] = 1;
+    const qint64 configBytes = from->toCborValue().toCbor().size();
+
+    registry.addLoop(QStringLiteral("config/ConfigSync::diff (1 feuille)"), configBytes, [from, to](qint64) {
+        doNotOptimize(ConfigSync::diff(*from, *to));
+    });
+    registry.addLoop(QStringLiteral("config/ConfigSync::diff (identiques)"), configBytes, [from](qint64) {
+        doNotOptimize(ConfigSync::diff(*from, *from));
+    });
+
+    auto ops = std::make_shared<QVector<ConfigSync::PatchOp>>(ConfigSync::diff(*from, *to));
+    registry.addLoop(QStringLiteral("config/ConfigSync::encodePatch"), 0, [ops](qint64 i) {
+        doNotOptimize(ConfigSync::encodePatch(1, quint32(i), quint32(i + 1), *ops));
+    });
+    registry.addLoop(QStringLiteral("config/ConfigSync::applyPatch"), 0, [from, ops](qint64) {
+        QCborMap copy = *from;
+        doNotOptimize(ConfigSync::applyPatch(copy, *ops));
+    });
+}
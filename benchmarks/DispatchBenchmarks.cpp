@@ -0,0 +1,100 @@
+#include "BenchHarness.h"
+#include "MecavivMessages.h"
+#include "controllermapper.h"
+#include "notejitterbuffer.h"
+#include "src/UdpController.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QUdpSocket>
+#include <cstdio>
+#include <memory>
+
+using namespace MecavivProtocol;
+
+namespace {
+// Au-delà, le datagramme est considéré perdu et la mesure abandonnée
+constexpr qint64 kLoopbackTimeoutNs = 1000000000;
+}
+
+// Réception : datagramme UDP jusqu'au signal dataReceived (SirenManager), trames
+// 0x02 jusqu'aux CC (ControllerMapper), notes 0x03/0x04 jusqu'à leur restitution
+void Bench::registerDispatchBenchmarks(Registry &registry)
+{
+    // Un objet par benchmark, partagé par toutes ses répétitions
+    auto mapper = std::make_shared<ControllerMapper>();
+    QVariantMap mapping;
+    const char *controllers[] = { "wheel", "joystickX", "joystickY", "joystickZ", "fader", "pedal", "selector", "encoder" };
+    const char *curves[] = { "linear", "parabolic", "hyperbolic", "s curve" };
+    for (int i = 0; i < 8; ++i)
+        mapping.insert(QLatin1String(controllers[i]), QVariantMap { { QStringLiteral("cc"), 20 + i }, { QStringLiteral("curve"), QLatin1String(curves[i % 4]) } });
+    mapper->loadMappings(mapping);
+    mapper->setHysteresis(1);
+
+    auto frames = std::make_shared<QVector<QByteArray>>();
+    QRandomGenerator random(7);
+    for (int i = 0; i < 64; ++i) {
+        ControllersFrame frame;
+        frame.wheelPosition = std::uint16_t(random.bounded(361));
+        frame.joystickX = random.bounded(-127, 128);
+        frame.joystickY = random.bounded(-127, 128);
+        frame.joystickZ = random.bounded(-127, 128);
+        frame.selector = std::uint8_t(random.bounded(5));
+        frame.fader = std::uint8_t(random.bounded(128));
+        frame.pedal = std::uint8_t(random.bounded(128));
+        frame.encoderValue = std::uint8_t(random.bounded(128));
+        QByteArray bytes(int(ControllersFrame::Size), Qt::Uninitialized);
+        frame.encode(reinterpret_cast<std::uint8_t *>(bytes.data()));
+        frames->append(bytes);
+    }
+    registry.addLoop(QStringLiteral("dispatch/ControllerMapper::processFrame"), ControllersFrame::Size,
+                     [mapper, frames](qint64 i) {
+        doNotOptimize(mapper->processFrame(frames->at(int(i & 63))));
+    });
+
+    // Notes sans horodatage : décodage + restitution immédiate (signal émis)
+    auto buffer = std::make_shared<NoteJitterBuffer>();
+    registry.addLoop(QStringLiteral("dispatch/NoteJitterBuffer::pushFrame"), NoteFrame::ShortSize, [buffer](qint64 i) {
+        NoteFrame note;
+        note.note = std::uint8_t(40 + (i & 31));
+        note.velocity = 100;
+        note.value = std::uint16_t(8192 + (i & 255));
+        char bytes[NoteFrame::ShortSize];
+        note.encode(reinterpret_cast<std::uint8_t *>(bytes));
+        doNotOptimize(buffer->pushFrame(QByteArray::fromRawData(bytes, sizeof(bytes))));
+    });
+
+    // Aller-retour local : writeDatagram → boucle d'événements → dataReceived
+    QUdpSocket probe;
+    if (!probe.bind(QHostAddress::LocalHost, 0)) {
+        std::fprintf(stderr, "dispatch/udp-loopback ignoré : aucun port UDP local disponible\n");
+        return;
+    }
+    const quint16 port = probe.localPort();
+    probe.close();
+
+    auto controller = std::make_shared<UdpController>();
+    controller->setReceivePort(port);
+    controller->initialize();
+    auto sender = std::make_shared<QUdpSocket>();
+    auto received = std::make_shared<qint64>(0);
+    QObject::connect(controller.get(), &UdpController::dataReceived, controller.get(),
+                     [received](const QByteArray &data) { *received += data.size() > 0 ? 1 : 0; });
+
+    registry.add(QStringLiteral("dispatch/UdpController::udp-loopback"), CommandPacket::Size,
+                 [controller, sender, received, port](qint64 iterations) {
+        const QByteArray packet = UdpController::buildPacket(QByteArray(1, char(0x01)));
+        QElapsedTimer timer;
+        for (qint64 i = 0; i < iterations; ++i) {
+            const qint64 expected = *received + 1;
+            sender->writeDatagram(packet, QHostAddress::LocalHost, port);
+            timer.start();
+            while (*received < expected) {
+                QCoreApplication::processEvents(QEventLoop::AllEvents);
+                if (timer.nsecsElapsed() > kLoopbackTimeoutNs)
+                    return false;
+            }
+        }
+        return true;
+    });
+}
@@ -0,0 +1,25 @@
+#include "BenchHarness.h"
+#include "taperedboxgeometry.h"
+#include <memory>
+
+namespace {
+// 18 sommets (position + normale) + 48 indices
+constexpr qint64 kTaperedBoxBytes = 18 * 6 * sizeof(float) + 48 * sizeof(quint32);
+}
+
+// Régénération de la géométrie d'une note (chaque setter recalcule les buffers)
+void Bench::registerGeometryBenchmarks(Registry &registry)
+{
+    auto geometry = std::make_shared<TaperedBoxGeometry>();
+    geometry->setAttackTime(120.0f);
+    geometry->setDuration(800.0f);
+
+    registry.addLoop(QStringLiteral("geometry/TaperedBoxGeometry::updateGeometry"), kTaperedBoxBytes, [geometry](qint64 i) {
+        geometry->setVelocity((i & 1) ? 100.0f : 101.0f);
+    });
+
+    // Animation de la durée (note tenue qui s'allonge) : une régénération par image
+    registry.addLoop(QStringLiteral("geometry/TaperedBoxGeometry::setDuration"), kTaperedBoxBytes, [geometry](qint64 i) {
+        geometry->setDuration(100.0f + float(i & 1023));
+    });
+}
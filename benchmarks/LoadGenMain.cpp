@@ -0,0 +1,325 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTimer>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "LoadGenerator.h"
+#include "MecavivLog.h"
+
+// mecavivLoadGen : tient le rôle de PureData pour N pupitres (un serveur WebSocket
+// par pupitre, ports consécutifs) et celui des machines pour SirenManager (UDP).
+// Chaque client connecté reçoit le flux de son pupitre ; le rapport donne le débit
+// que chacun a tenu avant que sa file d'envoi ne dépasse le seuil de décrochage.
+
+using namespace LoadGen;
+
+namespace {
+
+// "a:b[:c]" → valeurs numériques, vide si le format ne correspond pas
+QList<double> parseTuple(const QString &text, int minCount, int maxCount)
+{
+    QList<double> values;
+    const QStringList parts = text.split(QLatin1Char(':'));
+    if (parts.size() < minCount || parts.size() > maxCount)
+        return {};
+    for (const QString &part : parts) {
+        bool ok = false;
+        values.append(part.toDouble(&ok));
+        if (!ok)
+            return {};
+    }
+    return values;
+}
+
+QByteArray configMessage(const QString &path)
+{
+    QJsonObject config;
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly))
+        config = QJsonDocument::fromJson(file.readAll()).object();
+    else
+        std::fprintf(stderr, "Configuration illisible (%s) : configuration vide envoyée\n", qPrintable(path));
+    const QJsonObject message { { QStringLiteral("type"), QStringLiteral("CONFIG_FULL") },
+                                { QStringLiteral("config"), config } };
+    return QJsonDocument(message).toJson(QJsonDocument::Compact);
+}
+
+// Débit du client : tenu jusqu'au décrochage, sinon sur toute sa connexion
+void clientRates(const ClientStats &client, qint64 nowMs, double *messagesPerSecond, double *bytesPerSecond)
+{
+    if (client.behindAtMs >= 0) {
+        *messagesPerSecond = client.sustainedMessagesPerSecond;
+        *bytesPerSecond = client.sustainedBytesPerSecond;
+        return;
+    }
+    const qint64 endMs = client.disconnectedMs >= 0 ? client.disconnectedMs : nowMs;
+    const double seconds = double(qMax<qint64>(1, endMs - client.connectedMs)) / 1000.0;
+    *messagesPerSecond = double(client.messages) / seconds;
+    *bytesPerSecond = double(client.bytesWritten) / seconds;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("mecavivLoadGen"));
+    MecavivLog::configureFromEnvironment();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Générateur de charge : PureData et sirènes simulés en local"));
+    parser.addHelpOption();
+    const QCommandLineOption desksOption(QStringLiteral("desks"),
+        QStringLiteral("Nombre de pupitres simulés (défaut 7)."), QStringLiteral("n"), QStringLiteral("7"));
+    const QCommandLineOption basePortOption(QStringLiteral("base-port"),
+        QStringLiteral("Port WebSocket du premier pupitre, suivants consécutifs (défaut 10002)."), QStringLiteral("port"), QStringLiteral("10002"));
+    const QCommandLineOption listenOption(QStringLiteral("listen"),
+        QStringLiteral("Adresse d'écoute WebSocket et UDP (défaut 127.0.0.1)."), QStringLiteral("ip"), QStringLiteral("127.0.0.1"));
+    const QCommandLineOption configOption(QStringLiteral("config"),
+        QStringLiteral("Configuration envoyée sur REQUEST_CONFIG (défaut config.template.json)."), QStringLiteral("fichier"),
+        QStringLiteral(MECAVIV_SOURCE_DIR "/config.template.json"));
+    const QCommandLineOption ticksOption(QStringLiteral("ticks"),
+        QStringLiteral("Trames 0x01 par seconde et par pupitre (défaut 60)."), QStringLiteral("n"), QStringLiteral("60"));
+    const QCommandLineOption controllersOption(QStringLiteral("controllers"),
+        QStringLiteral("Trames 0x02 par seconde et par pupitre (défaut 50)."), QStringLiteral("n"), QStringLiteral("50"));
+    const QCommandLineOption wheelNotesOption(QStringLiteral("wheel-notes"),
+        QStringLiteral("Notes 0x03 par seconde et par pupitre (défaut 20)."), QStringLiteral("n"), QStringLiteral("20"));
+    const QCommandLineOption sequenceNotesOption(QStringLiteral("sequence-notes"),
+        QStringLiteral("Notes 0x04 par seconde et par pupitre (défaut 8)."), QStringLiteral("n"), QStringLiteral("8"));
+    const QCommandLineOption ccOption(QStringLiteral("cc"),
+        QStringLiteral("CC 0x05 par seconde et par pupitre (défaut 10)."), QStringLiteral("n"), QStringLiteral("10"));
+    const QCommandLineOption burstOption(QStringLiteral("burst"),
+        QStringLiteral("Rafales période:durée:facteur, en ms (ex. 2000:200:5)."), QStringLiteral("motif"));
+    const QCommandLineOption rampOption(QStringLiteral("ramp"),
+        QStringLiteral("Rampe pas:facteur : débits × facteur toutes les <pas> s (ex. 10:1.5)."), QStringLiteral("rampe"));
+    const QCommandLineOption durationOption(QStringLiteral("duration"),
+        QStringLiteral("Durée en s (défaut 60, 0 = sans fin)."), QStringLiteral("s"), QStringLiteral("60"));
+    const QCommandLineOption backlogOption(QStringLiteral("backlog-limit"),
+        QStringLiteral("Seuil de décrochage d'un client, en Kio en attente (défaut 512)."), QStringLiteral("kio"), QStringLiteral("512"));
+    const QCommandLineOption noDropOption(QStringLiteral("no-drop"),
+        QStringLiteral("Continuer d'envoyer à un client décroché (sa file grossit sans limite)."));
+    const QCommandLineOption udpPortOption(QStringLiteral("udp-port"),
+        QStringLiteral("Port UDP des machines simulées (défaut 4443)."), QStringLiteral("port"), QStringLiteral("4443"));
+    const QCommandLineOption udpDelayOption(QStringLiteral("udp-reply-delay"),
+        QStringLiteral("Délai de réponse des machines en ms (défaut 2)."), QStringLiteral("ms"), QStringLiteral("2"));
+    const QCommandLineOption noUdpOption(QStringLiteral("no-udp"), QStringLiteral("Ne pas simuler les machines UDP."));
+    const QCommandLineOption reportOption(QStringLiteral("report-interval"),
+        QStringLiteral("Ligne d'état toutes les <s> secondes (défaut 5, 0 = aucune)."), QStringLiteral("s"), QStringLiteral("5"));
+    const QCommandLineOption jsonOption(QStringLiteral("json"),
+        QStringLiteral("Écrit le rapport final dans <fichier> (JSON)."), QStringLiteral("fichier"));
+    parser.addOptions({ desksOption, basePortOption, listenOption, configOption, ticksOption, controllersOption,
+                        wheelNotesOption, sequenceNotesOption, ccOption, burstOption, rampOption, durationOption,
+                        backlogOption, noDropOption, udpPortOption, udpDelayOption, noUdpOption, reportOption, jsonOption });
+    parser.process(app);
+
+    StreamRates rates;
+    rates.ticks = qMax(0.0, parser.value(ticksOption).toDouble());
+    rates.controllers = qMax(0.0, parser.value(controllersOption).toDouble());
+    rates.wheelNotes = qMax(0.0, parser.value(wheelNotesOption).toDouble());
+    rates.sequenceNotes = qMax(0.0, parser.value(sequenceNotesOption).toDouble());
+    rates.controlChanges = qMax(0.0, parser.value(ccOption).toDouble());
+
+    BurstPattern burst;
+    if (parser.isSet(burstOption)) {
+        const QList<double> values = parseTuple(parser.value(burstOption), 3, 3);
+        if (values.isEmpty() || values[0] <= 0.0 || values[1] < 0.0 || values[2] <= 0.0) {
+            std::fprintf(stderr, "Rafales invalides: %s (période:durée:facteur)\n", qPrintable(parser.value(burstOption)));
+            return 2;
+        }
+        burst.periodMs = int(values[0]);
+        burst.lengthMs = int(values[1]);
+        burst.factor = values[2];
+    }
+    double rampStepSeconds = 0.0;
+    double rampFactor = 1.0;
+    if (parser.isSet(rampOption)) {
+        const QList<double> values = parseTuple(parser.value(rampOption), 2, 2);
+        if (values.isEmpty() || values[0] <= 0.0 || values[1] <= 0.0) {
+            std::fprintf(stderr, "Rampe invalide: %s (pas:facteur)\n", qPrintable(parser.value(rampOption)));
+            return 2;
+        }
+        rampStepSeconds = values[0];
+        rampFactor = values[1];
+    }
+
+    const QHostAddress address(parser.value(listenOption));
+    const int deskCount = qBound(1, parser.value(desksOption).toInt(), 64);
+    const int basePort = parser.value(basePortOption).toInt();
+    const QByteArray config = configMessage(parser.value(configOption));
+
+    std::vector<std::unique_ptr<DeskSimulator>> desks;
+    for (int i = 0; i < deskCount; ++i) {
+        auto desk = std::make_unique<DeskSimulator>(i, config);
+        desk->setBacklogLimit(qMax(1, parser.value(backlogOption).toInt()) * qint64(1024), !parser.isSet(noDropOption));
+        if (!desk->listen(address, quint16(basePort + i))) {
+            std::fprintf(stderr, "Pupitre %d : écoute impossible sur le port %d (%s)\n", i + 1, basePort + i,
+                         qPrintable(desk->errorString()));
+            return 2;
+        }
+        desks.push_back(std::move(desk));
+    }
+    std::unique_ptr<SirenEndpoint> sirens;
+    if (!parser.isSet(noUdpOption)) {
+        sirens = std::make_unique<SirenEndpoint>(parser.value(udpDelayOption).toInt());
+        const int udpPort = parser.value(udpPortOption).toInt();
+        if (!sirens->bind(address, quint16(udpPort))) {
+            std::fprintf(stderr, "Machines : port UDP %d indisponible (%s)\n", udpPort, qPrintable(sirens->errorString()));
+            return 2;
+        }
+    }
+    std::printf("%d pupitres sur ws://%s:%d-%d%s\n", deskCount, qPrintable(address.toString()), basePort,
+                basePort + deskCount - 1,
+                sirens ? qPrintable(QStringLiteral(", machines sur udp://%1:%2").arg(address.toString(), parser.value(udpPortOption)))
+                       : "");
+    std::fflush(stdout);
+
+    QElapsedTimer clock;
+    clock.start();
+    const auto scaleAt = [rampStepSeconds, rampFactor](qint64 elapsedMs) {
+        if (rampStepSeconds <= 0.0)
+            return 1.0;
+        return std::pow(rampFactor, std::floor(double(elapsedMs) / 1000.0 / rampStepSeconds));
+    };
+
+    // Émission : crédits par flux, rattrapés à chaque tick
+    QTimer pumpTimer;
+    pumpTimer.setTimerType(Qt::PreciseTimer);
+    pumpTimer.setInterval(2);
+    QObject::connect(&pumpTimer, &QTimer::timeout, &app, [&]() {
+        const qint64 elapsedMs = clock.elapsed();
+        const double scale = scaleAt(elapsedMs);
+        for (const auto &desk : desks)
+            desk->pump(rates, scale, burst, elapsedMs);
+    });
+    pumpTimer.start();
+
+    // Ligne d'état : débit total sur l'intervalle, clients décrochés
+    QTimer reportTimer;
+    qint64 lastMessages = 0;
+    qint64 lastBytes = 0;
+    qint64 lastReportMs = 0;
+    QObject::connect(&reportTimer, &QTimer::timeout, &app, [&]() {
+        const qint64 nowMs = clock.elapsed();
+        qint64 messages = 0;
+        qint64 bytes = 0;
+        int clients = 0;
+        int behind = 0;
+        for (const auto &desk : desks) {
+            clients += desk->connectedClients();
+            for (const ClientStats &client : desk->clients()) {
+                messages += client.messages;
+                bytes += client.bytesWritten;
+                behind += client.behindAtMs >= 0 ? 1 : 0;
+            }
+        }
+        const double seconds = double(qMax<qint64>(1, nowMs - lastReportMs)) / 1000.0;
+        std::printf("t=%5.1fs ×%.2f : %d clients, %.0f msg/s, %.1f Kio/s, %d décrochés", double(nowMs) / 1000.0,
+                    scaleAt(nowMs), clients, double(messages - lastMessages) / seconds,
+                    double(bytes - lastBytes) / 1024.0 / seconds, behind);
+        if (sirens)
+            std::printf(", UDP %lld cmd / %lld rép.", sirens->received(), sirens->replies());
+        std::printf("\n");
+        std::fflush(stdout);
+        lastMessages = messages;
+        lastBytes = bytes;
+        lastReportMs = nowMs;
+    });
+    const double reportSeconds = parser.value(reportOption).toDouble();
+    if (reportSeconds > 0.0)
+        reportTimer.start(int(reportSeconds * 1000.0));
+
+    const double durationSeconds = parser.value(durationOption).toDouble();
+    if (durationSeconds > 0.0)
+        QTimer::singleShot(int(durationSeconds * 1000.0), &app, &QCoreApplication::quit);
+    app.exec();
+
+    // Rapport final
+    const qint64 endMs = clock.elapsed();
+    std::printf("\n%-8s %-22s %10s %10s %12s %12s %8s %10s\n", "pupitre", "client", "msg/s", "Kio/s",
+                "file max Kio", "décroché à", "échelle", "perdues");
+    QJsonArray desksJson;
+    for (const auto &desk : desks) {
+        QJsonArray clientsJson;
+        for (const ClientStats &client : desk->clients()) {
+            double messagesPerSecond = 0.0;
+            double bytesPerSecond = 0.0;
+            clientRates(client, endMs, &messagesPerSecond, &bytesPerSecond);
+            const QString behindAt = client.behindAtMs >= 0
+                ? QStringLiteral("%1 s").arg(double(client.behindAtMs) / 1000.0, 0, 'f', 1) : QStringLiteral("-");
+            const QString scale = client.behindAtMs >= 0
+                ? QStringLiteral("×%1").arg(client.behindAtScale, 0, 'f', 2) : QStringLiteral("-");
+            std::printf("%-8d %-22s %10.0f %10.1f %12.1f %12s %8s %10lld\n", desk->index() + 1, qPrintable(client.peer),
+                        messagesPerSecond, bytesPerSecond / 1024.0, double(client.maxBacklog) / 1024.0,
+                        qPrintable(behindAt), qPrintable(scale), client.dropped);
+
+            QJsonObject clientJson;
+            clientJson.insert(QStringLiteral("peer"), client.peer);
+            clientJson.insert(QStringLiteral("connectedMs"), double(client.connectedMs));
+            clientJson.insert(QStringLiteral("disconnectedMs"), double(client.disconnectedMs));
+            clientJson.insert(QStringLiteral("messages"), double(client.messages));
+            clientJson.insert(QStringLiteral("messagesPerSecond"), messagesPerSecond);
+            clientJson.insert(QStringLiteral("bytesPerSecond"), bytesPerSecond);
+            clientJson.insert(QStringLiteral("maxBacklogBytes"), double(client.maxBacklog));
+            clientJson.insert(QStringLiteral("behindAtMs"), double(client.behindAtMs));
+            clientJson.insert(QStringLiteral("behindAtScale"), client.behindAtScale);
+            clientJson.insert(QStringLiteral("dropped"), double(client.dropped));
+            clientsJson.append(clientJson);
+        }
+        if (desk->clients().isEmpty())
+            std::printf("%-8d %-22s\n", desk->index() + 1, "(aucun client)");
+        desksJson.append(QJsonObject { { QStringLiteral("desk"), desk->index() + 1 },
+                                       { QStringLiteral("port"), int(desk->port()) },
+                                       { QStringLiteral("clients"), clientsJson } });
+    }
+
+    QJsonObject udpJson;
+    if (sirens) {
+        std::printf("\nUDP : %lld paquets, %lld réponses, %lld invalides\n", sirens->received(), sirens->replies(),
+                    sirens->badPackets());
+        QJsonObject commands;
+        for (auto it = sirens->commandCounts().cbegin(); it != sirens->commandCounts().cend(); ++it) {
+            const QString command = QStringLiteral("0x%1").arg(it.key(), 2, 16, QLatin1Char('0'));
+            std::printf("  commande %s : %lld\n", qPrintable(command), it.value());
+            commands.insert(command, double(it.value()));
+        }
+        udpJson.insert(QStringLiteral("received"), double(sirens->received()));
+        udpJson.insert(QStringLiteral("replies"), double(sirens->replies()));
+        udpJson.insert(QStringLiteral("badPackets"), double(sirens->badPackets()));
+        udpJson.insert(QStringLiteral("commands"), commands);
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject root;
+        root.insert(QStringLiteral("schema"), 1);
+        root.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert(QStringLiteral("host"), QSysInfo::machineHostName());
+        root.insert(QStringLiteral("durationMs"), double(endMs));
+        root.insert(QStringLiteral("rates"), QJsonObject {
+            { QStringLiteral("ticks"), rates.ticks },
+            { QStringLiteral("controllers"), rates.controllers },
+            { QStringLiteral("wheelNotes"), rates.wheelNotes },
+            { QStringLiteral("sequenceNotes"), rates.sequenceNotes },
+            { QStringLiteral("controlChanges"), rates.controlChanges } });
+        root.insert(QStringLiteral("burst"), parser.value(burstOption));
+        root.insert(QStringLiteral("ramp"), parser.value(rampOption));
+        root.insert(QStringLiteral("desks"), desksJson);
+        if (sirens)
+            root.insert(QStringLiteral("udp"), udpJson);
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "Écriture impossible: %s\n", qPrintable(file.errorString()));
+            return 2;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+    return 0;
+}
@@ -0,0 +1,346 @@
+#include "LoadGenerator.h"
+#include "MecavivMessages.h"
+#include "src/Config/SirenConfig.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QWebSocket>
+#include <cmath>
+#include <iterator>
+
+using namespace MecavivProtocol;
+
+namespace LoadGen {
+
+namespace {
+// Morceaux du message de configuration (en-tête ChunkHeader + données)
+constexpr int kConfigChunkBytes = 1024;
+// 480 ticks par noire à 120 bpm
+constexpr double kTicksPerSecond = 960.0;
+// CC suivis par le mode jeu (vibrato, tremolo, enveloppe)
+constexpr std::uint8_t kControlChanges[] = { 1, 9, 15, 72, 73, 92 };
+
+// Taille sur le fil d'une trame serveur → client (jamais masquée)
+qint64 wireSize(qint64 payload)
+{
+    if (payload < 126)
+        return payload + 2;
+    if (payload <= 0xFFFF)
+        return payload + 4;
+    return payload + 10;
+}
+
+QByteArray frameBytes(const std::uint8_t *bytes, std::size_t size)
+{
+    return QByteArray(reinterpret_cast<const char *>(bytes), qsizetype(size));
+}
+}
+
+// ============================================================================
+// DeskSimulator
+// ============================================================================
+
+DeskSimulator::DeskSimulator(int index, const QByteArray &configMessage, QObject *parent)
+    : QObject(parent)
+    , m_index(index)
+    , m_configMessage(configMessage)
+    , m_server(QStringLiteral("mecavivLoadGen-%1").arg(index + 1), QWebSocketServer::NonSecureMode)
+    , m_random(quint32(1000 + index))
+{
+    connect(&m_server, &QWebSocketServer::newConnection, this, &DeskSimulator::onNewConnection);
+    m_clock.start();
+}
+
+bool DeskSimulator::listen(const QHostAddress &address, quint16 port)
+{
+    return m_server.listen(address, port);
+}
+
+void DeskSimulator::setBacklogLimit(qint64 bytes, bool dropWhenBehind)
+{
+    m_backlogLimit = bytes;
+    m_dropWhenBehind = dropWhenBehind;
+}
+
+int DeskSimulator::connectedClients() const
+{
+    int count = 0;
+    for (QWebSocket *socket : m_sockets)
+        count += socket ? 1 : 0;
+    return count;
+}
+
+void DeskSimulator::onNewConnection()
+{
+    while (QWebSocket *socket = m_server.nextPendingConnection()) {
+        const int client = int(m_clients.size());
+        ClientStats stats;
+        stats.peer = QStringLiteral("%1:%2").arg(socket->peerAddress().toString()).arg(socket->peerPort());
+        stats.connectedMs = m_clock.elapsed();
+        m_clients.append(stats);
+        m_sockets.append(socket);
+
+        connect(socket, &QWebSocket::bytesWritten, this, [this, client](qint64 bytes) {
+            m_clients[client].bytesWritten += bytes;
+        });
+        connect(socket, &QWebSocket::binaryMessageReceived, this, [this, socket](const QByteArray &message) {
+            onClientMessage(socket, message);
+        });
+        connect(socket, &QWebSocket::textMessageReceived, this, [this, socket](const QString &message) {
+            onClientMessage(socket, message.toUtf8());
+        });
+        connect(socket, &QWebSocket::disconnected, this, [this, client, socket]() {
+            m_clients[client].disconnectedMs = m_clock.elapsed();
+            m_sockets[client] = nullptr;
+            socket->deleteLater();
+        });
+    }
+}
+
+void DeskSimulator::onClientMessage(QWebSocket *socket, const QByteArray &message)
+{
+    // Le pupitre demande sa configuration à l'ouverture (JSON envoyé en binaire)
+    const QJsonObject request = QJsonDocument::fromJson(message).object();
+    if (request.value(QStringLiteral("type")).toString() == QLatin1String("REQUEST_CONFIG"))
+        sendConfig(socket);
+}
+
+void DeskSimulator::sendConfig(QWebSocket *socket)
+{
+    const int client = int(m_sockets.indexOf(socket));
+    if (client < 0)
+        return;
+    // Même découpage que PureData : [taille totale u32][position u32] + morceau
+    const auto total = std::uint32_t(m_configMessage.size());
+    for (qsizetype position = 0; position < m_configMessage.size(); position += kConfigChunkBytes) {
+        const qsizetype length = qMin<qsizetype>(kConfigChunkBytes, m_configMessage.size() - position);
+        QByteArray chunk(qsizetype(ChunkHeader::Size), Qt::Uninitialized);
+        ChunkHeader header;
+        header.totalSize = total;
+        header.position = std::uint32_t(position);
+        header.encode(reinterpret_cast<std::uint8_t *>(chunk.data()));
+        chunk.append(m_configMessage.constData() + position, length);
+        send(client, chunk);
+    }
+}
+
+void DeskSimulator::pump(const StreamRates &rates, double scale, const BurstPattern &burst, qint64 elapsedMs)
+{
+    m_scale = scale;
+    if (m_lastPumpMs < 0) {
+        m_lastPumpMs = elapsedMs;
+        return;
+    }
+    const double seconds = double(elapsedMs - m_lastPumpMs) / 1000.0;
+    m_lastPumpMs = elapsedMs;
+    const double factor = scale * burst.factorAt(elapsedMs) * seconds;
+
+    const double perSecond[5] = { rates.ticks, rates.controllers, rates.wheelNotes,
+                                  rates.sequenceNotes, rates.controlChanges };
+    for (int stream = 0; stream < 5; ++stream) {
+        m_credit[stream] += perSecond[stream] * factor;
+        while (m_credit[stream] >= 1.0) {
+            m_credit[stream] -= 1.0;
+            QByteArray frame;
+            switch (stream) {
+            case 0: frame = tickFrame(elapsedMs); break;
+            case 1: frame = controllersFrame(elapsedMs); break;
+            case 2: frame = wheelNoteFrame(elapsedMs); break;
+            case 3: frame = sequenceNoteFrame(); break;
+            default: frame = controlChangeFrame(); break;
+            }
+            broadcast(frame);
+        }
+    }
+}
+
+void DeskSimulator::broadcast(const QByteArray &message)
+{
+    for (int client = 0; client < m_sockets.size(); ++client) {
+        if (m_sockets[client])
+            send(client, message);
+    }
+}
+
+void DeskSimulator::send(int client, const QByteArray &message)
+{
+    ClientStats &stats = m_clients[client];
+    const qint64 backlog = stats.backlog();
+    stats.maxBacklog = qMax(stats.maxBacklog, backlog);
+    if (backlog > m_backlogLimit) {
+        if (stats.behindAtMs < 0) {
+            // Débit tenu depuis la connexion jusqu'au décrochage
+            stats.behindAtMs = m_clock.elapsed();
+            stats.behindAtScale = m_scale;
+            const double seconds = qMax<qint64>(1, stats.behindAtMs - stats.connectedMs) / 1000.0;
+            stats.sustainedMessagesPerSecond = double(stats.messages) / seconds;
+            stats.sustainedBytesPerSecond = double(stats.bytesWritten) / seconds;
+        }
+        if (m_dropWhenBehind) {
+            ++stats.dropped;
+            return;
+        }
+    }
+    m_sockets[client]->sendBinaryMessage(message);
+    ++stats.messages;
+    stats.bytesQueued += wireSize(message.size());
+}
+
+QByteArray DeskSimulator::tickFrame(qint64 elapsedMs)
+{
+    PositionFrame position;
+    position.variant = PositionFrame::Variant::Tick;
+    position.playing = true;
+    position.tick = std::uint32_t(double(elapsedMs) * kTicksPerSecond / 1000.0);
+    std::uint8_t bytes[PositionFrame::LegacySize];
+    return frameBytes(bytes, position.encode(bytes));
+}
+
+QByteArray DeskSimulator::controllersFrame(qint64 elapsedMs)
+{
+    const double seconds = double(elapsedMs) / 1000.0 + m_index;
+    ControllersFrame controllers;
+    controllers.wheelPosition = std::uint16_t(std::fmod(seconds * 90.0, 360.0));
+    controllers.joystickX = int(127.0 * std::sin(seconds * 2.0));
+    controllers.joystickY = int(127.0 * std::cos(seconds * 1.3));
+    controllers.fader = std::uint8_t(63.5 + 63.5 * std::sin(seconds * 0.5));
+    controllers.pedal = std::uint8_t(63.5 + 63.5 * std::cos(seconds * 0.7));
+    controllers.selector = std::uint8_t(int(seconds / 4.0) % 5);
+    std::uint8_t bytes[ControllersFrame::Size];
+    return frameBytes(bytes, controllers.encode(bytes));
+}
+
+QByteArray DeskSimulator::wheelNoteFrame(qint64 elapsedMs)
+{
+    // Glissando lent autour de la mélodie, bend ±1 demi-ton
+    const double seconds = double(elapsedMs) / 1000.0;
+    NoteFrame note;
+    note.type = FrameType::WheelNote;
+    note.note = std::uint8_t(m_melody);
+    note.velocity = 100;
+    note.value = std::uint16_t(8192.0 + 4095.0 * std::sin(seconds * 3.0));
+    std::uint8_t bytes[NoteFrame::StampedSize];
+    return frameBytes(bytes, note.encode(bytes));
+}
+
+QByteArray DeskSimulator::sequenceNoteFrame()
+{
+    m_melody = qBound(50, m_melody + m_random.bounded(-4, 5), 82);
+    NoteFrame note;
+    note.type = FrameType::SequenceNote;
+    note.note = std::uint8_t(m_melody);
+    note.velocity = std::uint8_t(m_random.bounded(60, 128));
+    note.value = std::uint16_t(m_random.bounded(120, 1200));
+    std::uint8_t bytes[NoteFrame::StampedSize];
+    return frameBytes(bytes, note.encode(bytes));
+}
+
+QByteArray DeskSimulator::controlChangeFrame()
+{
+    ControlChangeFrame cc;
+    cc.number = kControlChanges[m_ccIndex];
+    cc.value = std::uint8_t(m_random.bounded(128));
+    m_ccIndex = (m_ccIndex + 1) % int(std::size(kControlChanges));
+    std::uint8_t bytes[ControlChangeFrame::Size];
+    return frameBytes(bytes, cc.encode(bytes));
+}
+
+// ============================================================================
+// SirenEndpoint
+// ============================================================================
+
+SirenEndpoint::SirenEndpoint(int replyDelayMs, QObject *parent)
+    : QObject(parent)
+    , m_replyDelayMs(replyDelayMs)
+{
+    connect(&m_socket, &QUdpSocket::readyRead, this, &SirenEndpoint::onReadyRead);
+}
+
+bool SirenEndpoint::bind(const QHostAddress &address, quint16 port)
+{
+    return m_socket.bind(address, port);
+}
+
+void SirenEndpoint::onReadyRead()
+{
+    while (m_socket.hasPendingDatagrams()) {
+        QByteArray datagram(qsizetype(m_socket.pendingDatagramSize()), Qt::Uninitialized);
+        QHostAddress sender;
+        quint16 senderPort = 0;
+        const qint64 read = m_socket.readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
+        if (read <= 0)
+            continue;
+        ++m_received;
+        CommandPacket packet;
+        if (CommandPacket::decode(reinterpret_cast<const std::uint8_t *>(datagram.constData()),
+                                  std::size_t(read), packet) != Status::Ok) {
+            ++m_badPackets;
+            continue;
+        }
+        ++m_commandCounts[packet.command];
+        handle(packet.command, packet.data, sender, senderPort);
+    }
+}
+
+void SirenEndpoint::handle(std::uint8_t command, const std::uint8_t *data, const QHostAddress &sender, quint16 senderPort)
+{
+    switch (command) {
+    case UdpCommands::ASKSYNCHRO:
+        reply(UdpCommands::ISSYNCHRO, synchroState(), sender, senderPort);
+        return;
+    case UdpCommands::NEWLIST:
+        m_list = data[0];
+        m_playing = false;
+        reply(UdpCommands::SEQSELECTED, QByteArray(1, char(m_list)), sender, senderPort);
+        return;
+    case UdpCommands::ST: m_playing = true; break;
+    case UdpCommands::STOP: m_playing = false; break;
+    case UdpCommands::BOUCLE: m_boucle = data[0] != 0; break;
+    case UdpCommands::REVERSE: m_reverse = data[0] != 0; break;
+    case UdpCommands::SETSPEED: m_speed = data[0]; break;
+    case UdpCommands::TRANSPO: m_transpo = data[0]; break;
+    case UdpCommands::VOLUME:
+    case UdpCommands::VOLUMEGENE: m_volume = data[0]; break;
+    case UdpCommands::MUTE: m_muted = data[0] != 0; break;
+    case UdpCommands::RESET:
+        m_playing = m_boucle = m_reverse = m_muted = false;
+        m_speed = 100;
+        m_transpo = 0;
+        break;
+    default:
+        // Commande sans effet sur l'état simulé : pas de réponse
+        return;
+    }
+    // Changement d'état : la machine renvoie son état, comme pour ASKSYNCHRO
+    reply(UdpCommands::ISSYNCHRO, synchroState(), sender, senderPort);
+}
+
+QByteArray SirenEndpoint::synchroState() const
+{
+    // [lecture][liste][boucle 0x01 | inversé 0x02][vitesse][transposition][volume | muet 0x80]
+    QByteArray state(6, Qt::Uninitialized);
+    state[0] = char(m_playing ? 1 : 0);
+    state[1] = char(m_list);
+    state[2] = char(m_boucle ? 1 : 0) | char(m_reverse ? 2 : 0);
+    state[3] = char(m_speed);
+    state[4] = char(m_transpo);
+    state[5] = char((m_volume & 0x7F) | (m_muted ? 0x80 : 0));
+    return state;
+}
+
+void SirenEndpoint::reply(std::uint8_t command, const QByteArray &data, const QHostAddress &sender, quint16 senderPort)
+{
+    QByteArray packet(qsizetype(CommandPacket::Size), Qt::Uninitialized);
+    CommandPacket::encode(reinterpret_cast<std::uint8_t *>(packet.data()), command,
+                          reinterpret_cast<const std::uint8_t *>(data.constData()), std::size_t(data.size()));
+    ++m_replies;
+    if (m_replyDelayMs <= 0) {
+        m_socket.writeDatagram(packet, sender, senderPort);
+        return;
+    }
+    QTimer::singleShot(m_replyDelayMs, this, [this, packet, sender, senderPort]() {
+        m_socket.writeDatagram(packet, sender, senderPort);
+    });
+}
+
+}
@@ -0,0 +1,157 @@
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QVector>
+#include <QWebSocketServer>
+#include <QUdpSocket>
+#include <cstdint>
+
+class QWebSocket;
+
+// Générateur de charge mecavivLoadGen : remplace PureData (un serveur WebSocket par
+// pupitre) et les sirènes (paquets UDP de SirenManager) sur la machine locale.
+namespace LoadGen {
+
+// Trames émises par seconde et par pupitre, avant rampe et rafales
+struct StreamRates {
+    double ticks = 60.0;            // 0x01 position (tick)
+    double controllers = 50.0;      // 0x02 contrôleurs physiques
+    double wheelNotes = 20.0;       // 0x03 note du volant + bend
+    double sequenceNotes = 8.0;     // 0x04 note de séquence
+    double controlChanges = 10.0;   // 0x05 CC
+};
+
+// Rafales : pendant les lengthMs premières ms de chaque période, débits × factor
+struct BurstPattern {
+    int periodMs = 0;
+    int lengthMs = 0;
+    double factor = 1.0;
+
+    double factorAt(qint64 elapsedMs) const
+    {
+        if (periodMs <= 0 || lengthMs <= 0)
+            return 1.0;
+        return elapsedMs % periodMs < lengthMs ? factor : 1.0;
+    }
+};
+
+// Un client WebSocket (interface pupitre, console) vu par le serveur
+struct ClientStats {
+    QString peer;
+    qint64 connectedMs = 0;
+    qint64 disconnectedMs = -1;
+    qint64 messages = 0;
+    qint64 bytesQueued = 0;     // octets sur le fil (en-têtes WebSocket compris)
+    qint64 bytesWritten = 0;
+    qint64 maxBacklog = 0;
+    qint64 dropped = 0;
+    // Décrochage : file d'envoi au-delà du seuil. Débit soutenu jusque-là.
+    qint64 behindAtMs = -1;
+    double behindAtScale = 0.0;
+    double sustainedMessagesPerSecond = 0.0;
+    double sustainedBytesPerSecond = 0.0;
+
+    qint64 backlog() const { return bytesQueued - bytesWritten; }
+};
+
+class DeskSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    DeskSimulator(int index, const QByteArray &configMessage, QObject *parent = nullptr);
+
+    bool listen(const QHostAddress &address, quint16 port);
+    QString errorString() const { return m_server.errorString(); }
+    int index() const { return m_index; }
+    quint16 port() const { return m_server.serverPort(); }
+
+    // Seuil de décrochage (octets en attente) et abandon des trames au-delà
+    void setBacklogLimit(qint64 bytes, bool dropWhenBehind);
+
+    // Émet les trames dues depuis le dernier appel (débits × scale × rafale)
+    void pump(const StreamRates &rates, double scale, const BurstPattern &burst, qint64 elapsedMs);
+
+    const QVector<ClientStats> &clients() const { return m_clients; }
+    int connectedClients() const;
+
+private:
+    void onNewConnection();
+    void onClientMessage(QWebSocket *socket, const QByteArray &message);
+    void sendConfig(QWebSocket *socket);
+    void broadcast(const QByteArray &message);
+    void send(int client, const QByteArray &message);
+
+    QByteArray tickFrame(qint64 elapsedMs);
+    QByteArray controllersFrame(qint64 elapsedMs);
+    QByteArray wheelNoteFrame(qint64 elapsedMs);
+    QByteArray sequenceNoteFrame();
+    QByteArray controlChangeFrame();
+
+    int m_index;
+    QByteArray m_configMessage;
+    QWebSocketServer m_server;
+    QVector<ClientStats> m_clients;
+    QVector<QWebSocket *> m_sockets;    // même indice que m_clients, nul après déconnexion
+    QElapsedTimer m_clock;
+    QRandomGenerator m_random;
+    qint64 m_backlogLimit = 512 * 1024;
+    bool m_dropWhenBehind = true;
+    double m_scale = 1.0;
+
+    qint64 m_lastPumpMs = -1;
+    double m_credit[5] = {};
+    int m_melody = 67;
+    int m_ccIndex = 0;
+};
+
+// Extrémité UDP des machines : décode les paquets de commande, tient l'état d'une
+// machine et répond comme elle (ISSYNCHRO, SEQSELECTED) après replyDelayMs
+class SirenEndpoint : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SirenEndpoint(int replyDelayMs, QObject *parent = nullptr);
+
+    bool bind(const QHostAddress &address, quint16 port);
+    QString errorString() const { return m_socket.errorString(); }
+
+    qint64 received() const { return m_received; }
+    qint64 replies() const { return m_replies; }
+    qint64 badPackets() const { return m_badPackets; }
+    const QMap<int, qint64> &commandCounts() const { return m_commandCounts; }
+
+private:
+    void onReadyRead();
+    void handle(std::uint8_t command, const std::uint8_t *data, const QHostAddress &sender, quint16 senderPort);
+    void reply(std::uint8_t command, const QByteArray &data, const QHostAddress &sender, quint16 senderPort);
+    QByteArray synchroState() const;
+
+    QUdpSocket m_socket;
+    int m_replyDelayMs;
+    qint64 m_received = 0;
+    qint64 m_replies = 0;
+    qint64 m_badPackets = 0;
+    QMap<int, qint64> m_commandCounts;
+
+    // État simulé d'une machine (lecteur de séquences)
+    bool m_playing = false;
+    bool m_boucle = false;
+    bool m_reverse = false;
+    bool m_muted = false;
+    std::uint8_t m_list = 0;
+    std::uint8_t m_speed = 100;
+    std::uint8_t m_transpo = 0;
+    std::uint8_t m_volume = 100;
+};
+
+}
+
+#endif // LOADGENERATOR_H
@@ -0,0 +1,59 @@
+#include "BenchHarness.h"
+#include "src/Models/PlaylistModel.h"
+#include "src/PlaylistManager.h"
+#include <memory>
+
+namespace {
+constexpr int kPlaylistSize = 128;
+
+QString samplePlaylist()
+{
+    QString content;
+    for (int i = 1; i <= kPlaylistSize; ++i) {
+        content += PlaylistManager().formatPlaylistEntry(i, QStringLiteral("sequences/morceau_%1.mid").arg(i),
+                                                         QStringLiteral("Morceau %1").arg(i), i % 3 == 0, i % 5 == 0);
+        content += QLatin1Char('\n');
+    }
+    return content;
+}
+}
+
+// Format des playlists machines ({ [n=..] [s=..] [a=..] [B=..] [E=..] }) et modèle QML
+void Bench::registerPlaylistBenchmarks(Registry &registry)
+{
+    auto manager = std::make_shared<PlaylistManager>();
+    auto names = std::make_shared<QStringList>();
+    for (int i = 0; i < kPlaylistSize; ++i)
+        names->append(QStringLiteral("sequences/morceau_%1.mid").arg(i + 1));
+
+    registry.addLoop(QStringLiteral("playlist/formatPlaylistEntry"), 0, [manager, names](qint64 i) {
+        const int index = int(i % kPlaylistSize);
+        doNotOptimize(manager->formatPlaylistEntry(index + 1, names->at(index), QStringLiteral("Morceau"), i & 1, i & 2));
+    });
+
+    const QString content = samplePlaylist();
+    const qint64 contentBytes = content.size() * qint64(sizeof(QChar));
+    registry.addLoop(QStringLiteral("playlist/parseEntries (128)"), contentBytes, [content](qint64) {
+        doNotOptimize(PlaylistManager::parseEntries(content));
+    });
+    registry.addLoop(QStringLiteral("playlist/parsePlaylistContent (128)"), contentBytes, [manager, content](qint64) {
+        doNotOptimize(manager->parsePlaylistContent(content));
+    });
+
+    // Rechargement complet du modèle (nouvelle playlist reçue d'une machine)
+    auto model = std::make_shared<PlaylistModel>();
+    auto entries = std::make_shared<QList<PlaylistEntry>>(PlaylistManager::parseEntries(content));
+    for (const PlaylistEntry &entry : *entries)
+        model->addEntry(entry);
+    registry.addLoop(QStringLiteral("playlist/PlaylistModel reload (128)"), 0, [model, entries](qint64) {
+        model->clear();
+        for (const PlaylistEntry &entry : *entries)
+            model->addEntry(entry);
+    });
+
+    // Modification d'une ligne (case boucle cochée dans l'interface)
+    registry.addLoop(QStringLiteral("playlist/PlaylistModel::setData"), 0, [model](qint64 i) {
+        const QModelIndex index = model->index(int(i % qMax(1, model->rowCount())));
+        doNotOptimize(model->setData(index, bool(i & 1), PlaylistModel::BoucleRole));
+    });
+}
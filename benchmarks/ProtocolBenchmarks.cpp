@@ -0,0 +1,180 @@
+#include "BenchHarness.h"
+#include "MecavivMessages.h"
+#include "src/UdpController.h"
+#include "framedecoder.h"
+#include <QRandomGenerator>
+#include <array>
+
+using namespace MecavivProtocol;
+
+// Construction / validation des trames : paquet de commande UDP (SirenManager),
+// trames PureData → pupitre (0x01, 0x02, 0x05, notes) et décodage QML du pupitre
+void Bench::registerProtocolBenchmarks(Registry &registry)
+{
+    // Chemin actuel de SirenManager : un QByteArray alloué par paquet
+    registry.addLoop(QStringLiteral("protocol/UdpController::buildPacket"), CommandPacket::Size, [](qint64 i) {
+        const char command[2] = { char(0x0F), char(i & 0x7F) };
+        doNotOptimize(UdpController::buildPacket(QByteArray::fromRawData(command, 2)));
+    });
+
+    // Même paquet dans un buffer de pile (moteur de cues, simulateurs)
+    registry.addLoop(QStringLiteral("protocol/CommandPacket::encode"), CommandPacket::Size, [](qint64 i) {
+        std::uint8_t packet[CommandPacket::Size];
+        const std::uint8_t data[1] = { std::uint8_t(i & 0x7F) };
+        CommandPacket::encode(packet, 0x0F, data, 1);
+        doNotOptimize(packet);
+    });
+
+    // Validation longueur + BCC d'un paquet reçu
+    registry.add(QStringLiteral("protocol/CommandPacket::decode"), CommandPacket::Size, [](qint64 iterations) {
+        std::uint8_t packet[CommandPacket::Size];
+        const std::uint8_t data[3] = { 1, 255, 0 };
+        CommandPacket::encode(packet, 0x15, data, 3);
+        CommandPacket decoded;
+        for (qint64 i = 0; i < iterations; ++i) {
+            doNotOptimize(packet);
+            doNotOptimize(CommandPacket::decode(packet, sizeof(packet), decoded));
+        }
+        return true;
+    });
+
+    // Trames 0x02 variées (le décodeur ne doit pas être spécialisé sur une seule)
+    registry.add(QStringLiteral("protocol/ControllersFrame::decode"), ControllersFrame::Size, [](qint64 iterations) {
+        std::array<std::array<std::uint8_t, ControllersFrame::Size>, 64> frames {};
+        QRandomGenerator random(42);
+        for (auto &frame : frames) {
+            for (auto &byte : frame)
+                byte = std::uint8_t(random.bounded(256));
+            frame[0] = FrameType::Controllers;
+        }
+        ControllersFrame decoded;
+        for (qint64 i = 0; i < iterations; ++i) {
+            const auto &frame = frames[size_t(i & 63)];
+            doNotOptimize(ControllersFrame::decode(frame.data(), frame.size(), decoded));
+            doNotOptimize(decoded);
+        }
+        return true;
+    });
+
+    // Flux mixte PureData → pupitre (0x01 tick, 0x02, 0x05, notes) : aiguillage sur le type + décodage
+    registry.add(QStringLiteral("protocol/mixedStream::decode"), 10, [](qint64 iterations) {
+        std::array<std::array<std::uint8_t, ControllersFrame::Size>, 64> frames {};
+        std::array<std::size_t, 64> sizes {};
+        QRandomGenerator random(7);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            auto &frame = frames[i];
+            switch (i % 4) {
+            case 0: {
+                PositionFrame position;
+                position.playing = true;
+                position.tick = random.generate();
+                sizes[i] = position.encode(frame.data());
+                break;
+            }
+            case 1: {
+                ControllersFrame controllers;
+                controllers.wheelPosition = std::uint16_t(random.bounded(361));
+                controllers.joystickX = random.bounded(-127, 128);
+                sizes[i] = controllers.encode(frame.data());
+                break;
+            }
+            case 2: {
+                ControlChangeFrame cc;
+                cc.number = std::uint8_t(random.bounded(128));
+                cc.value = std::uint8_t(random.bounded(128));
+                sizes[i] = cc.encode(frame.data());
+                break;
+            }
+            default: {
+                NoteFrame note;
+                note.note = std::uint8_t(random.bounded(128));
+                note.velocity = 100;
+                note.stamped = true;
+                sizes[i] = note.encode(frame.data());
+                break;
+            }
+            }
+        }
+        PositionFrame position;
+        ControllersFrame controllers;
+        ControlChangeFrame cc;
+        NoteFrame note;
+        for (qint64 i = 0; i < iterations; ++i) {
+            const auto &frame = frames[size_t(i & 63)];
+            const std::size_t size = sizes[size_t(i & 63)];
+            switch (frame[0]) {
+            case FrameType::Position:
+                doNotOptimize(PositionFrame::decode(frame.data(), size, position));
+                break;
+            case FrameType::Controllers:
+                doNotOptimize(ControllersFrame::decode(frame.data(), size, controllers));
+                break;
+            case FrameType::ControlChange:
+                doNotOptimize(ControlChangeFrame::decode(frame.data(), size, cc));
+                break;
+            default:
+                doNotOptimize(NoteFrame::decode(frame.data(), size, note));
+                break;
+            }
+        }
+        return true;
+    });
+
+    // Octets aléatoires (taille 0-23) : coût du rejet, chemin du fuzz
+    registry.add(QStringLiteral("protocol/randomBytes::reject"), 12, [](qint64 iterations) {
+        std::array<std::array<std::uint8_t, 24>, 64> frames {};
+        std::array<std::size_t, 64> sizes {};
+        QRandomGenerator random(99);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            for (auto &byte : frames[i])
+                byte = std::uint8_t(random.bounded(256));
+            sizes[i] = size_t(random.bounded(24));
+        }
+        PositionFrame position;
+        ControllersFrame controllers;
+        ControlChangeFrame cc;
+        NoteFrame note;
+        ChunkHeader header;
+        for (qint64 i = 0; i < iterations; ++i) {
+            const auto &frame = frames[size_t(i & 63)];
+            const std::size_t size = sizes[size_t(i & 63)];
+            doNotOptimize(PositionFrame::decode(frame.data(), size, position));
+            doNotOptimize(ControllersFrame::decode(frame.data(), size, controllers));
+            doNotOptimize(ControlChangeFrame::decode(frame.data(), size, cc));
+            doNotOptimize(NoteFrame::decode(frame.data(), size, note));
+            doNotOptimize(ChunkHeader::decode(frame.data(), size, header));
+        }
+        return true;
+    });
+
+    // Chemin QML du pupitre : trame 0x02 → QVariantMap imbriquée (WebSocketController)
+    registry.add(QStringLiteral("protocol/FrameDecoder::decodeControllers"), ControllersFrame::Size, [](qint64 iterations) {
+        ControllersFrame controllers;
+        controllers.wheelPosition = 180;
+        controllers.joystickX = -40;
+        controllers.selector = 2;
+        QByteArray frame(int(ControllersFrame::Size), Qt::Uninitialized);
+        controllers.encode(reinterpret_cast<std::uint8_t *>(frame.data()));
+        FrameDecoder decoder;
+        for (qint64 i = 0; i < iterations; ++i)
+            doNotOptimize(decoder.decodeControllers(frame));
+        return true;
+    });
+
+    registry.add(QStringLiteral("protocol/NoteFrame::roundTrip"), NoteFrame::StampedSize, [](qint64 iterations) {
+        NoteFrame note;
+        note.note = 69;
+        note.velocity = 100;
+        note.stamped = true;
+        std::uint8_t frame[NoteFrame::StampedSize];
+        NoteFrame decoded;
+        for (qint64 i = 0; i < iterations; ++i) {
+            note.value = std::uint16_t(i & 0x3FFF);
+            note.sentTime = std::uint32_t(i);
+            note.encode(frame);
+            doNotOptimize(NoteFrame::decode(frame, sizeof(frame), decoded));
+            doNotOptimize(decoded);
+        }
+        return true;
+    });
+}
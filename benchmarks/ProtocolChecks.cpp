@@ -0,0 +1,314 @@
+#include "MecavivMessages.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Vérifications à l'exécution des trames de MecavivMessages.h, en complément des
+// static_assert de l'en-tête :
+//   - aller-retour encodage → décodage sur des valeurs tirées au hasard ;
+//   - trames valides tronquées à chaque longueur : refusées, jamais lues au-delà ;
+//   - octets aléatoires de toutes tailles envoyés à chaque décodeur : une trame
+//     acceptée doit se réencoder à l'identique (formats à taille fixe).
+// Sans Qt. Compiler avec -fsanitize=address,undefined pour détecter les lectures
+// hors buffer. Code de sortie 1 au premier écart.
+//
+//   mecavivProtocolCheck [itérations] [graine]
+
+using namespace MecavivProtocol;
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(condition, ...)                                                   \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::fprintf(stderr, "ÉCHEC %s:%d : %s — ", __FILE__, __LINE__, #condition); \
+            std::fprintf(stderr, __VA_ARGS__);                                  \
+            std::fprintf(stderr, "\n");                                         \
+            ++g_failures;                                                       \
+            return false;                                                       \
+        }                                                                       \
+    } while (0)
+
+using Random = std::mt19937;
+
+std::uint8_t randomByte(Random &random)
+{
+    return std::uint8_t(random() & 0xFF);
+}
+
+// Copie dans un buffer de la taille exacte : ASan signale toute lecture au-delà
+std::vector<std::uint8_t> exact(const std::uint8_t *bytes, std::size_t size)
+{
+    return std::vector<std::uint8_t>(bytes, bytes + size);
+}
+
+// Chaque préfixe strict d'une trame valide doit être refusé
+template <typename Frame>
+bool truncationsRejected(const std::uint8_t *bytes, std::size_t size, const char *name)
+{
+    for (std::size_t length = 0; length < size; ++length) {
+        std::vector<std::uint8_t> prefix = exact(bytes, length);
+        Frame decoded;
+        const Status status = Frame::decode(prefix.data(), prefix.size(), decoded);
+        CHECK(status != Status::Ok, "%s tronquée à %zu octets acceptée", name, length);
+    }
+    return true;
+}
+
+bool checkCommandPacket(Random &random)
+{
+    const std::uint8_t command = randomByte(random);
+    std::uint8_t data[CommandPacket::MaxData];
+    for (auto &byte : data)
+        byte = randomByte(random);
+
+    std::uint8_t bytes[CommandPacket::Size];
+    CHECK(CommandPacket::encode(bytes, command, data, sizeof(data)) == CommandPacket::Size, "taille encodée");
+    CommandPacket decoded;
+    CHECK(CommandPacket::decode(bytes, sizeof(bytes), decoded) == Status::Ok, "paquet valide refusé");
+    CHECK(decoded.command == command && std::memcmp(decoded.data, data, sizeof(data)) == 0, "paquet altéré");
+
+    // Un bit modifié dans le BCC, la commande ou les données est détecté
+    // (l'octet réservé 2 n'est pas couvert par le BCC)
+    std::size_t index = CommandPacket::Command::offset + random() % (CommandPacket::Size - CommandPacket::Command::offset + 1);
+    if (index == CommandPacket::Size)
+        index = CommandPacket::Bcc::offset;
+    std::uint8_t corrupted[CommandPacket::Size];
+    std::memcpy(corrupted, bytes, sizeof(bytes));
+    corrupted[index] ^= std::uint8_t(1u << (random() % 8));
+    CHECK(CommandPacket::decode(corrupted, sizeof(corrupted), decoded) != Status::Ok,
+          "bit %zu modifié non détecté", index);
+    return truncationsRejected<CommandPacket>(bytes, sizeof(bytes), "paquet de commande");
+}
+
+bool checkControllers(Random &random)
+{
+    ControllersFrame frame;
+    frame.wheelPosition = std::uint16_t(random() % 361);
+    frame.pad1Aftertouch = randomByte(random);
+    frame.pad1Velocity = randomByte(random);
+    frame.pad2Aftertouch = randomByte(random);
+    frame.pad2Velocity = randomByte(random);
+    frame.joystickX = int(random() % 255) - 127;
+    frame.joystickY = int(random() % 255) - 127;
+    frame.joystickZ = int(random() % 255) - 127;
+    frame.joystickButton = random() & 1;
+    frame.selector = std::uint8_t(random() % 5);
+    frame.fader = randomByte(random);
+    frame.pedal = randomByte(random);
+    frame.button1 = random() & 1;
+    frame.button2 = random() & 1;
+    frame.encoderValue = randomByte(random);
+    frame.encoderPressed = random() & 1;
+
+    std::uint8_t bytes[ControllersFrame::Size];
+    CHECK(frame.encode(bytes) == ControllersFrame::Size, "taille encodée");
+    ControllersFrame decoded;
+    CHECK(ControllersFrame::decode(bytes, sizeof(bytes), decoded) == Status::Ok, "0x02 valide refusée");
+    CHECK(decoded.wheelPosition == frame.wheelPosition && decoded.pad1Aftertouch == frame.pad1Aftertouch
+              && decoded.pad1Velocity == frame.pad1Velocity && decoded.pad2Aftertouch == frame.pad2Aftertouch
+              && decoded.pad2Velocity == frame.pad2Velocity && decoded.joystickX == frame.joystickX
+              && decoded.joystickY == frame.joystickY && decoded.joystickZ == frame.joystickZ
+              && decoded.joystickButton == frame.joystickButton && decoded.selector == frame.selector
+              && decoded.fader == frame.fader && decoded.pedal == frame.pedal
+              && decoded.button1 == frame.button1 && decoded.button2 == frame.button2
+              && decoded.encoderValue == frame.encoderValue && decoded.encoderPressed == frame.encoderPressed,
+          "0x02 : joystick %d/%d/%d", frame.joystickX, frame.joystickY, frame.joystickZ);
+    return truncationsRejected<ControllersFrame>(bytes, sizeof(bytes), "0x02");
+}
+
+bool checkNote(Random &random)
+{
+    NoteFrame note;
+    note.type = (random() & 1) ? FrameType::WheelNote : FrameType::SequenceNote;
+    note.note = std::uint8_t(random() & 0x7F);
+    note.velocity = std::uint8_t(random() & 0x7F);
+    note.value = std::uint16_t(note.isWheel() ? random() & 0x3FFF : random() & 0xFFFF);
+    note.stamped = random() & 1;
+    note.sentTime = note.stamped ? std::uint32_t(random()) : 0;
+
+    std::uint8_t bytes[NoteFrame::StampedSize];
+    const std::size_t size = note.encode(bytes);
+    CHECK(size == (note.stamped ? NoteFrame::StampedSize : NoteFrame::ShortSize), "taille encodée");
+    NoteFrame decoded;
+    CHECK(NoteFrame::decode(bytes, size, decoded) == Status::Ok, "note valide refusée");
+    CHECK(decoded.type == note.type && decoded.note == note.note && decoded.velocity == note.velocity
+              && decoded.value == note.value && decoded.stamped == note.stamped
+              && decoded.sentTime == note.sentTime,
+          "note %u valeur %u", unsigned(note.note), unsigned(note.value));
+    return truncationsRejected<NoteFrame>(bytes, NoteFrame::ShortSize, "note");
+}
+
+bool checkPosition(Random &random)
+{
+    PositionFrame position;
+    position.variant = PositionFrame::Variant(random() % 3);
+    position.playing = random() & 1;
+    position.measure = std::uint16_t(random());
+    position.tick = std::uint32_t(random());
+    position.beatInBar = randomByte(random);
+    position.beatBits = std::uint32_t(random());
+
+    std::uint8_t bytes[PositionFrame::LegacySize];
+    const std::size_t size = position.encode(bytes);
+    PositionFrame decoded;
+    CHECK(PositionFrame::decode(bytes, size, decoded) == Status::Ok, "position valide refusée");
+    CHECK(decoded.variant == position.variant && decoded.playing == position.playing, "variante");
+    switch (position.variant) {
+    case PositionFrame::Variant::Measure:
+        CHECK(decoded.measure == position.measure, "mesure");
+        break;
+    case PositionFrame::Variant::Tick:
+        CHECK(decoded.tick == position.tick, "tick %u", unsigned(position.tick));
+        break;
+    case PositionFrame::Variant::Legacy:
+        CHECK(decoded.measure == position.measure && decoded.beatInBar == position.beatInBar
+                  && decoded.beatBits == position.beatBits, "position legacy");
+        break;
+    }
+    return truncationsRejected<PositionFrame>(bytes, PositionFrame::MeasureSize, "position");
+}
+
+bool checkControlChange(Random &random)
+{
+    ControlChangeFrame cc;
+    cc.number = std::uint8_t(random() & 0x7F);
+    cc.value = std::uint8_t(random() & 0x7F);
+    std::uint8_t bytes[ControlChangeFrame::Size];
+    CHECK(cc.encode(bytes) == ControlChangeFrame::Size, "taille encodée");
+    ControlChangeFrame decoded;
+    CHECK(ControlChangeFrame::decode(bytes, sizeof(bytes), decoded) == Status::Ok, "CC valide refusé");
+    CHECK(decoded.number == cc.number && decoded.value == cc.value, "CC %u", unsigned(cc.number));
+    return truncationsRejected<ControlChangeFrame>(bytes, sizeof(bytes), "0x05");
+}
+
+bool checkVolantState(Random &random)
+{
+    VolantStateFrame state;
+    state.type = randomByte(random);
+    state.note = randomByte(random);
+    state.velocity = randomByte(random);
+    state.pitchbend = std::uint16_t(random());
+    std::uint8_t bytes[VolantStateFrame::Size];
+    CHECK(state.encode(bytes) == VolantStateFrame::Size, "taille encodée");
+    VolantStateFrame decoded;
+    CHECK(VolantStateFrame::decode(bytes, sizeof(bytes), decoded) == Status::Ok, "VOLANT_STATE refusé");
+    CHECK(decoded.type == state.type && decoded.note == state.note && decoded.velocity == state.velocity
+              && decoded.pitchbend == state.pitchbend, "VOLANT_STATE altéré");
+    return truncationsRejected<VolantStateFrame>(bytes, sizeof(bytes), "VOLANT_STATE");
+}
+
+bool checkChunkHeader(Random &random)
+{
+    ChunkHeader header;
+    header.totalSize = 1 + std::uint32_t(random() % (64u * 1024 * 1024));
+    header.position = std::uint32_t(random() % header.totalSize);
+    const std::size_t dataLength = random() % (header.totalSize - header.position + 1);
+    std::uint8_t bytes[ChunkHeader::Size];
+    header.encode(bytes);
+    ChunkHeader decoded;
+    // Seul l'en-tête est lu : la taille du chunk complet peut dépasser le buffer
+    CHECK(ChunkHeader::decode(bytes, ChunkHeader::Size + dataLength, decoded) == Status::Ok,
+          "chunk %u/%u + %zu refusé", unsigned(header.position), unsigned(header.totalSize), dataLength);
+    CHECK(decoded.totalSize == header.totalSize && decoded.position == header.position, "en-tête altéré");
+    CHECK(ChunkHeader::decode(bytes, ChunkHeader::Size + (header.totalSize - header.position) + 1, decoded)
+              == Status::OutOfRange, "chunk dépassant la taille totale accepté");
+    return truncationsRejected<ChunkHeader>(bytes, sizeof(bytes), "en-tête de chunk");
+}
+
+// Octets aléatoires : aucun décodeur ne doit lire hors du buffer, et une trame
+// acceptée doit se réencoder à l'identique
+template <typename Frame>
+bool reencodesIdentically(const std::vector<std::uint8_t> &input, const char *name)
+{
+    Frame decoded;
+    if (Frame::decode(input.data(), input.size(), decoded) != Status::Ok)
+        return true;
+    std::uint8_t bytes[32] = {};
+    const std::size_t size = decoded.encode(bytes);
+    CHECK(size == input.size() && std::memcmp(bytes, input.data(), size) == 0,
+          "%s de %zu octets acceptée mais réencodée différemment", name, input.size());
+    return true;
+}
+
+bool fuzzDecoders(Random &random)
+{
+    const std::size_t size = random() % 24;
+    std::vector<std::uint8_t> input(size);
+    for (auto &byte : input)
+        byte = randomByte(random);
+    // Type de trame plausible une fois sur deux, sinon les décodeurs s'arrêtent au premier octet
+    if (size > 0 && (random() & 1))
+        input[0] = std::uint8_t(1 + random() % 5);
+
+    // Les booléens sont normalisés (>0 → 1) : on ne compare que la validation
+    ControllersFrame controllers;
+    ControllersFrame::decode(input.data(), input.size(), controllers);
+    ChunkHeader header;
+    ChunkHeader::decode(input.data(), input.size(), header);
+
+    CommandPacket packet;
+    if (CommandPacket::decode(input.data(), input.size(), packet) == Status::Ok) {
+        std::uint8_t bytes[CommandPacket::Size];
+        packet.encode(bytes);
+        // Octet réservé réécrit à 0
+        bytes[CommandPacket::Reserved::offset] = input[CommandPacket::Reserved::offset];
+        CHECK(std::memcmp(bytes, input.data(), CommandPacket::Size) == 0, "paquet réencodé différemment");
+    }
+    // Notes : le bend n'a que 14 bits, les octets hauts sont ignorés à la lecture
+    NoteFrame note;
+    if (NoteFrame::decode(input.data(), input.size(), note) == Status::Ok)
+        CHECK(note.note <= 0x7F || !note.stamped, "note horodatée hors plage acceptée");
+
+    // Position : seul le bit 0 des flags est défini, les autres sont réécrits à 0
+    std::vector<std::uint8_t> flagsMasked = input;
+    if (flagsMasked.size() > PositionFrame::Flags::offset)
+        flagsMasked[PositionFrame::Flags::offset] &= 0x01;
+
+    return reencodesIdentically<PositionFrame>(flagsMasked, "position")
+        && reencodesIdentically<ControlChangeFrame>(input, "0x05")
+        && reencodesIdentically<VolantStateFrame>(input, "VOLANT_STATE");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    const long iterations = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 100000;
+    const unsigned long seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20240501ul;
+    Random random(std::uint32_t(seed & 0xFFFFFFFFul));
+
+    struct Check {
+        const char *name;
+        bool (*run)(Random &);
+    };
+    const Check checks[] = {
+        { "paquet de commande UDP", checkCommandPacket },
+        { "0x02 CONTROLLERS", checkControllers },
+        { "0x03/0x04 notes", checkNote },
+        { "0x01 POSITION", checkPosition },
+        { "0x05 CONTROL CHANGE", checkControlChange },
+        { "VOLANT_STATE", checkVolantState },
+        { "en-tête de chunk", checkChunkHeader },
+        { "fuzz décodeurs", fuzzDecoders },
+    };
+
+    for (const Check &check : checks) {
+        long i = 0;
+        while (i < iterations && check.run(random))
+            ++i;
+        std::printf("%-24s %s (%ld)\n", check.name, i == iterations ? "ok" : "ÉCHEC", i);
+        if (g_failures)
+            break;
+    }
+
+    if (g_failures) {
+        std::fprintf(stderr, "graine %lu : %d échec(s)\n", seed, g_failures);
+        return 1;
+    }
+    return 0;
+}
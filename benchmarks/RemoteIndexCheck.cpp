@@ -0,0 +1,249 @@
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <cstdio>
+#include <sys/time.h>
+#include "src/Config/SirenConfig.h"
+#include "src/Remote/RemoteFileIndex.h"
+
+// Essai de bout en bout de RemoteFileIndex sans machine : chaque « session SSH »
+// est un sh local (MECAVIV_REMOTE_SHELL=sh) et les 13 arborescences distantes
+// sont créées dans un répertoire temporaire (MECAVIV_REMOTE_ROOT).
+//   1. listage complet des 13 machines en parallèle ;
+//   2. rafraîchissement incrémental : répertoire inchangé, seul le fichier
+//      modifié est relu (un fichier ancien glissé sans toucher au répertoire
+//      reste invisible, preuve que le listage complet n'a pas été relancé) ;
+//   3. ajout et suppression : le mtime du répertoire change, listage complet ;
+//   4. fermeture des 13 sessions sans attente.
+// Nécessite sh, find (GNU, -printf / -newermt), stat et date. Code de sortie 1
+// au premier écart.
+
+namespace {
+
+constexpr int kMachineCount = int(MachineType::Pavillon2) + 1;
+constexpr int kRefreshTimeoutMs = 20000;
+constexpr qint64 kPastSeconds = 3600;
+
+int g_failures = 0;
+// Même date pour chaque recul : le mtime d'un répertoire restauré est identique à la seconde près
+qint64 g_pastSeconds = 0;
+
+#define CHECK(condition, ...)                                                   \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::fprintf(stderr, "ÉCHEC %s:%d : %s — ", __FILE__, __LINE__, #condition); \
+            std::fprintf(stderr, __VA_ARGS__);                                  \
+            std::fprintf(stderr, "\n");                                         \
+            ++g_failures;                                                       \
+            return false;                                                       \
+        }                                                                       \
+    } while (0)
+
+struct Changes {
+    QStringList added;
+    QStringList changed;
+    QStringList removed;
+};
+
+QString machineRoot(const QTemporaryDir &root, int machine)
+{
+    return root.filePath(SirenConfig::keyForMachineType(MachineType(machine)));
+}
+
+QString localPath(const QTemporaryDir &root, int machine, const QString &remotePath)
+{
+    return QDir::cleanPath(machineRoot(root, machine) + QLatin1Char('/') + remotePath);
+}
+
+bool writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(content) == content.size();
+}
+
+// mtime reculé : les répertoires (et fichiers) semblent antérieurs au passage
+bool setPast(const QString &path)
+{
+    struct timeval times[2] = {};
+    times[0].tv_sec = time_t(g_pastSeconds);
+    times[1] = times[0];
+    return ::utimes(QFile::encodeName(path).constData(), times) == 0;
+}
+
+// refreshAll() puis attente de refreshFinished ; les changements sont cumulés par machine
+bool refreshAndWait(RemoteFileIndex &index, QVector<Changes> &changes)
+{
+    changes = QVector<Changes>(kMachineCount);
+    const QMetaObject::Connection connection = QObject::connect(
+        &index, &RemoteFileIndex::filesChanged,
+        [&changes](int machine, const QStringList &added, const QStringList &changed, const QStringList &removed) {
+            changes[machine].added += added;
+            changes[machine].changed += changed;
+            changes[machine].removed += removed;
+        });
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    QObject::connect(&index, &RemoteFileIndex::refreshFinished, &loop, &QEventLoop::quit);
+    timeout.start(kRefreshTimeoutMs);
+    index.refreshAll();
+    if (index.isBusy())
+        loop.exec();
+    QObject::disconnect(connection);
+
+    CHECK(!index.isBusy(), "%d machines sans réponse après %d ms", index.pendingCount(), kRefreshTimeoutMs);
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const QVariantMap status = index.machineStatus(machine);
+        CHECK(status.value(QStringLiteral("lastError")).toString().isEmpty(), "%s : %s",
+              qPrintable(SirenConfig::keyForMachineType(MachineType(machine))),
+              qPrintable(status.value(QStringLiteral("lastError")).toString()));
+    }
+    return true;
+}
+
+bool sameNames(QStringList actual, QStringList expected)
+{
+    actual.sort();
+    expected.sort();
+    return actual == expected;
+}
+
+bool populate(const QTemporaryDir &root)
+{
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const MachineType type = MachineType(machine);
+        const QString midiDir = localPath(root, machine, SirenConfig::midiPathForMachineType(type));
+        const QString playlistDir = localPath(root, machine, SirenConfig::playlistPathForMachineType(type));
+        CHECK(QDir().mkpath(midiDir) && QDir().mkpath(playlistDir), "création de %s", qPrintable(midiDir));
+        CHECK(writeFile(midiDir + QStringLiteral("/a.mid"), "MThd a")
+              && writeFile(midiDir + QStringLiteral("/b.midi"), "MThd bb")
+              && writeFile(midiDir + QStringLiteral("/notes.txt"), "hors filtre")
+              && writeFile(playlistDir + QStringLiteral("/concert.listlecture"), "a.mid\n"),
+              "écriture des fichiers de %s", qPrintable(SirenConfig::keyForMachineType(type)));
+        CHECK(setPast(midiDir) && setPast(playlistDir), "mtime de %s", qPrintable(midiDir));
+    }
+    return true;
+}
+
+bool checkFullListing(RemoteFileIndex &index)
+{
+    QVector<Changes> changes;
+    if (!refreshAndWait(index, changes))
+        return false;
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const QByteArray keyText = SirenConfig::keyForMachineType(MachineType(machine)).toUtf8();
+        const char *key = keyText.constData();
+        CHECK(sameNames(index.fileNames(machine, RemoteFileIndex::Midi), { "a.mid", "b.midi" }),
+              "%s : MIDI %s", key, qPrintable(index.fileNames(machine, RemoteFileIndex::Midi).join(QLatin1Char(','))));
+        CHECK(sameNames(index.fileNames(machine, RemoteFileIndex::Playlist), { "concert.listlecture" }),
+              "%s : listes %s", key, qPrintable(index.fileNames(machine, RemoteFileIndex::Playlist).join(QLatin1Char(','))));
+        CHECK(changes[machine].changed.isEmpty() && changes[machine].removed.isEmpty(), "%s : premier passage", key);
+        const QVector<RemoteFileEntry> midi = index.entries(MachineType(machine), RemoteFileIndex::Midi);
+        CHECK(midi.size() == 2 && midi.at(0).size == 6 && midi.at(1).size == 7, "%s : tailles", key);
+    }
+    return true;
+}
+
+bool checkIncrementalRefresh(RemoteFileIndex &index, const QTemporaryDir &root)
+{
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const QString midiDir = localPath(root, machine, SirenConfig::midiPathForMachineType(MachineType(machine)));
+        // Contenu modifié : mtime du fichier changé, pas celui du répertoire
+        CHECK(writeFile(midiDir + QStringLiteral("/a.mid"), "MThd a modifié"), "réécriture");
+        // Fichier ancien ajouté, mtime du répertoire restauré : seul un listage complet le verrait
+        CHECK(writeFile(midiDir + QStringLiteral("/cache.mid"), "MThd") && setPast(midiDir + QStringLiteral("/cache.mid"))
+              && setPast(midiDir), "fichier ancien");
+    }
+
+    QVector<Changes> changes;
+    if (!refreshAndWait(index, changes))
+        return false;
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const QByteArray keyText = SirenConfig::keyForMachineType(MachineType(machine)).toUtf8();
+        const char *key = keyText.constData();
+        CHECK(sameNames(changes[machine].changed, { "a.mid" }), "%s : modifiés %s", key,
+              qPrintable(changes[machine].changed.join(QLatin1Char(','))));
+        CHECK(changes[machine].added.isEmpty() && changes[machine].removed.isEmpty(),
+              "%s : listage complet au lieu d'incrémental (+%s -%s)", key,
+              qPrintable(changes[machine].added.join(QLatin1Char(','))),
+              qPrintable(changes[machine].removed.join(QLatin1Char(','))));
+        CHECK(sameNames(index.fileNames(machine, RemoteFileIndex::Midi), { "a.mid", "b.midi" }), "%s : cache", key);
+    }
+    return true;
+}
+
+bool checkDirectoryChange(RemoteFileIndex &index, const QTemporaryDir &root)
+{
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const QString midiDir = localPath(root, machine, SirenConfig::midiPathForMachineType(MachineType(machine)));
+        CHECK(writeFile(midiDir + QStringLiteral("/c.mid"), "MThd c") && QFile::remove(midiDir + QStringLiteral("/b.midi")),
+              "ajout / suppression");
+    }
+
+    QVector<Changes> changes;
+    if (!refreshAndWait(index, changes))
+        return false;
+    for (int machine = 0; machine < kMachineCount; ++machine) {
+        const QByteArray keyText = SirenConfig::keyForMachineType(MachineType(machine)).toUtf8();
+        const char *key = keyText.constData();
+        CHECK(sameNames(changes[machine].added, { "c.mid", "cache.mid" }), "%s : ajoutés %s", key,
+              qPrintable(changes[machine].added.join(QLatin1Char(','))));
+        CHECK(sameNames(changes[machine].removed, { "b.midi" }), "%s : supprimés %s", key,
+              qPrintable(changes[machine].removed.join(QLatin1Char(','))));
+        CHECK(sameNames(index.fileNames(machine, RemoteFileIndex::Midi), { "a.mid", "c.mid", "cache.mid" }),
+              "%s : cache", key);
+    }
+    return true;
+}
+
+bool checkDisconnect(RemoteFileIndex &index)
+{
+    for (int machine = 0; machine < kMachineCount; ++machine)
+        CHECK(index.machineStatus(machine).value(QStringLiteral("connected")).toBool(), "session %d fermée", machine);
+    QElapsedTimer clock;
+    clock.start();
+    index.disconnectAll();
+    CHECK(clock.elapsed() < 200, "fermeture des sessions en %lld ms", qint64(clock.elapsed()));
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir root;
+    if (!root.isValid()) {
+        std::fprintf(stderr, "Répertoire temporaire indisponible\n");
+        return 1;
+    }
+    qputenv("MECAVIV_REMOTE_SHELL", "sh");
+    qputenv("MECAVIV_REMOTE_ROOT", QFile::encodeName(root.path() + QStringLiteral("/{machine}")));
+    qputenv("MECAVIV_REMOTE_INDEX_CACHE", QFile::encodeName(root.filePath(QStringLiteral("remote-file-index.json"))));
+
+    g_pastSeconds = QDateTime::currentSecsSinceEpoch() - kPastSeconds;
+    if (!populate(root))
+        return 1;
+
+    RemoteFileIndex index;
+    QElapsedTimer clock;
+    clock.start();
+    const bool ok = checkFullListing(index)
+        && checkIncrementalRefresh(index, root)
+        && checkDirectoryChange(index, root)
+        && checkDisconnect(index);
+
+    std::printf("%s : %d machines, %lld ms\n", ok && g_failures == 0 ? "OK" : "ÉCHEC", kMachineCount,
+                qint64(clock.elapsed()));
+    return ok && g_failures == 0 ? 0 : 1;
+}
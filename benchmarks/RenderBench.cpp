@@ -0,0 +1,408 @@
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJSValue>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlApplicationEngine>
+#include <QQuickWindow>
+#include <QRandomGenerator>
+#include <QSysInfo>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "MecavivLog.h"
+#include "MecavivMessages.h"
+#include "RenderProbes.h"
+#include "pupitretypes.h"
+
+// Banc de rendu hors écran du mode jeu SirenePupitre. Main.qml est chargé tel quel
+// (plateforme offscreen, rendu logiciel par défaut, boucle de rendu sur le thread GUI),
+// passé en mode jeu, puis alimenté par le gestionnaire binaire du WebSocket : chanson
+// synthétique en trames 0x04 (N notes/s) et flux de contrôleurs 0x02 (M trames/s).
+// Pour chaque image : intervalle, durée du travail d'image, CPU du processus, signaux
+// émis, QObject créés / détruits et tas JS, restitués en p50 / p99 / max pour budgéter
+// les cibles sans GPU (Raspberry Pi).
+
+using namespace MecavivProtocol;
+
+namespace {
+
+struct Settings {
+    double notesPerSecond = 8.0;
+    int noteLengthMs = 400;
+    double lookaheadMs = 8000.0;
+    double controllerRate = 50.0;
+    double warmupSeconds = 2.0;
+    double durationSeconds = 20.0;
+    int fps = 60;
+};
+
+struct FrameSample {
+    double intervalMs = 0.0;
+    double workMs = 0.0;
+    double cpuMs = 0.0;
+    double signalsEmitted = 0.0;
+    double objectsCreated = 0.0;
+    double objectsDestroyed = 0.0;
+    double jsHeapMiB = 0.0;
+};
+
+struct Summary {
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Rang le plus proche : p99 = plus petite valeur couvrant 99 % des images
+Summary summarize(std::vector<double> values)
+{
+    Summary summary;
+    if (values.empty())
+        return summary;
+    std::sort(values.begin(), values.end());
+    const auto rank = [&values](double percentile) {
+        const auto index = std::size_t(std::ceil(percentile / 100.0 * double(values.size())));
+        return values[std::clamp<std::size_t>(index, 1, values.size()) - 1];
+    };
+    summary.p50 = rank(50.0);
+    summary.p99 = rank(99.0);
+    summary.max = values.back();
+    return summary;
+}
+
+// Premier objet de l'arbre QML dont le métaobjet déclare la méthode ou le signal
+QObject *findWithMethod(QObject *root, const char *signature)
+{
+    const QList<QObject *> objects = root->findChildren<QObject *>();
+    for (QObject *object : objects) {
+        if (object->metaObject()->indexOfMethod(signature) >= 0)
+            return object;
+    }
+    return nullptr;
+}
+
+// GameMode.qml, chargé par Test2D quand mainWindow.gameMode passe à true
+QObject *findGameMode(QObject *root)
+{
+    const QList<QObject *> objects = root->findChildren<QObject *>();
+    for (QObject *object : objects) {
+        if (object->metaObject()->indexOfProperty("gameModeItem") < 0)
+            continue;
+        if (QObject *gameMode = object->property("gameModeItem").value<QObject *>())
+            return gameMode;
+    }
+    return nullptr;
+}
+
+int eventCount(const QVariant &events)
+{
+    if (events.metaType() == QMetaType::fromType<QJSValue>())
+        return events.value<QJSValue>().property(QStringLiteral("length")).toInt();
+    return int(events.toList().size());
+}
+
+QJsonValue toJson(const Summary &summary, bool available)
+{
+    if (!available)
+        return QJsonValue::Null;
+    return QJsonObject { { QStringLiteral("p50"), summary.p50 },
+                         { QStringLiteral("p99"), summary.p99 },
+                         { QStringLiteral("max"), summary.max } };
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    // Synchronisation et rendu sur le thread GUI : une image se mesure d'un bout à l'autre
+    if (qEnvironmentVariableIsEmpty("QSG_RENDER_LOOP"))
+        qputenv("QSG_RENDER_LOOP", "basic");
+    QGuiApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("pupitreRenderBench"));
+    MecavivLog::configureFromEnvironment();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Banc de rendu hors écran du mode jeu SirenePupitre"));
+    parser.addHelpOption();
+    const QCommandLineOption notesOption(QStringLiteral("notes-per-second"),
+        QStringLiteral("Notes 0x04 injectées par seconde (défaut 8)."), QStringLiteral("n"), QStringLiteral("8"));
+    const QCommandLineOption noteLengthOption(QStringLiteral("note-length"),
+        QStringLiteral("Durée des notes en ms (défaut 400)."), QStringLiteral("ms"), QStringLiteral("400"));
+    const QCommandLineOption lookaheadOption(QStringLiteral("lookahead"),
+        QStringLiteral("Fenêtre d'anticipation du mode jeu en ms (défaut 8000)."), QStringLiteral("ms"), QStringLiteral("8000"));
+    const QCommandLineOption controllerRateOption(QStringLiteral("controller-rate"),
+        QStringLiteral("Trames contrôleurs 0x02 par seconde (défaut 50, 0 = aucune)."), QStringLiteral("hz"), QStringLiteral("50"));
+    const QCommandLineOption warmupOption(QStringLiteral("warmup"),
+        QStringLiteral("Durée de chauffe non mesurée en s (défaut 2)."), QStringLiteral("s"), QStringLiteral("2"));
+    const QCommandLineOption durationOption(QStringLiteral("duration"),
+        QStringLiteral("Durée mesurée en s (défaut 20)."), QStringLiteral("s"), QStringLiteral("20"));
+    const QCommandLineOption fpsOption(QStringLiteral("fps"),
+        QStringLiteral("Cadence des images demandées (défaut 60)."), QStringLiteral("n"), QStringLiteral("60"));
+    const QCommandLineOption sizeOption(QStringLiteral("size"),
+        QStringLiteral("Taille de la fenêtre (défaut 1280x800)."), QStringLiteral("LxH"), QStringLiteral("1280x800"));
+    const QCommandLineOption rendererOption(QStringLiteral("renderer"),
+        QStringLiteral("software (défaut, sans GPU) ou rhi (backend par défaut de Qt)."), QStringLiteral("nom"), QStringLiteral("software"));
+    const QCommandLineOption jsonOption(QStringLiteral("json"),
+        QStringLiteral("Écrit les résultats dans <fichier> (JSON)."), QStringLiteral("fichier"));
+    const QCommandLineOption labelOption(QStringLiteral("label"),
+        QStringLiteral("Étiquette enregistrée dans le JSON (commit, machine...)."), QStringLiteral("texte"));
+    const QCommandLineOption budgetOption(QStringLiteral("budget-ms"),
+        QStringLiteral("Échec (code 1) si le p99 du CPU par image dépasse <ms>."), QStringLiteral("ms"));
+    parser.addOptions({ notesOption, noteLengthOption, lookaheadOption, controllerRateOption, warmupOption,
+                        durationOption, fpsOption, sizeOption, rendererOption, jsonOption, labelOption, budgetOption });
+    parser.process(app);
+
+    Settings settings;
+    settings.notesPerSecond = qMax(0.0, parser.value(notesOption).toDouble());
+    settings.noteLengthMs = qBound(1, parser.value(noteLengthOption).toInt(), 65535);
+    settings.lookaheadMs = qMax(1.0, parser.value(lookaheadOption).toDouble());
+    settings.controllerRate = qMax(0.0, parser.value(controllerRateOption).toDouble());
+    settings.warmupSeconds = qMax(0.0, parser.value(warmupOption).toDouble());
+    settings.durationSeconds = qMax(1.0, parser.value(durationOption).toDouble());
+    settings.fps = qBound(1, parser.value(fpsOption).toInt(), 1000);
+    const QStringList size = parser.value(sizeOption).split(QLatin1Char('x'));
+    const QSize windowSize = size.size() == 2 ? QSize(size[0].toInt(), size[1].toInt()) : QSize();
+    if (windowSize.isEmpty()) {
+        std::fprintf(stderr, "Taille invalide: %s\n", qPrintable(parser.value(sizeOption)));
+        return 2;
+    }
+    const QString renderer = parser.value(rendererOption);
+    if (renderer == QLatin1String("software")) {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    } else if (renderer != QLatin1String("rhi")) {
+        std::fprintf(stderr, "Rendu inconnu: %s (software ou rhi)\n", qPrintable(renderer));
+        return 2;
+    }
+
+    RenderProbes::install();
+    registerPupitreTypes();
+
+    QQmlApplicationEngine engine;
+    engine.load(QUrl(QStringLiteral("qrc:/QML/Main.qml")));
+    auto *window = engine.rootObjects().isEmpty() ? nullptr : qobject_cast<QQuickWindow *>(engine.rootObjects().constFirst());
+    if (!window) {
+        std::fprintf(stderr, "Main.qml n'a pas pu être chargé\n");
+        return 2;
+    }
+    window->resize(windowSize);
+
+    // WebSocket de WebSocketController : pas de serveur, les trames injectées sont les seules reçues
+    QObject *socket = findWithMethod(window, "binaryMessageReceived(QByteArray)");
+    if (!socket) {
+        std::fprintf(stderr, "WebSocket de WebSocketController introuvable\n");
+        return 2;
+    }
+    socket->setProperty("active", false);
+
+    // Test2D remet isGamePlaying à false à l'entrée en mode jeu : lecture lancée ensuite
+    window->setProperty("gameMode", true);
+    QObject *gameMode = findGameMode(window);
+    if (!gameMode) {
+        std::fprintf(stderr, "GameMode.qml n'a pas été chargé par Test2D\n");
+        return 2;
+    }
+    gameMode->setProperty("lookaheadMs", settings.lookaheadMs);
+    window->setProperty("isGamePlaying", true);
+    QMetaObject::invokeMethod(gameMode, "startGame");
+
+    // Même chemin que le réseau : onBinaryMessageReceived de WebSocketController.qml
+    const auto inject = [socket](const std::uint8_t *bytes, std::size_t length) {
+        const QByteArray frame(reinterpret_cast<const char *>(bytes), qsizetype(length));
+        QMetaObject::invokeMethod(socket, "binaryMessageReceived", Qt::DirectConnection, Q_ARG(QByteArray, frame));
+    };
+
+    QElapsedTimer clock;
+    clock.start();
+    QRandomGenerator random(42);
+    int melody = 67;
+    qint64 notesSent = 0;
+    qint64 controllerFramesSent = 0;
+
+    // Envois rattrapés à chaque tick : la cadence moyenne reste exacte même si un tick glisse
+    QTimer feeder;
+    feeder.setTimerType(Qt::PreciseTimer);
+    feeder.setInterval(2);
+    QObject::connect(&feeder, &QTimer::timeout, &app, [&]() {
+        const double seconds = double(clock.nsecsElapsed()) / 1.0e9;
+        while (notesSent < qint64(seconds * settings.notesPerSecond)) {
+            // Marche aléatoire dans l'ambitus par défaut du pupitre (48-84)
+            melody = qBound(50, melody + random.bounded(-4, 5), 82);
+            NoteFrame note;
+            note.type = FrameType::SequenceNote;
+            note.note = std::uint8_t(melody);
+            note.velocity = std::uint8_t(random.bounded(60, 128));
+            note.value = std::uint16_t(settings.noteLengthMs);
+            std::uint8_t bytes[NoteFrame::StampedSize];
+            inject(bytes, note.encode(bytes));
+            ++notesSent;
+        }
+        while (controllerFramesSent < qint64(seconds * settings.controllerRate)) {
+            ControllersFrame controllers;
+            controllers.wheelPosition = std::uint16_t(std::fmod(seconds * 90.0, 360.0));
+            controllers.joystickX = int(127.0 * std::sin(seconds * 2.0));
+            controllers.joystickY = int(127.0 * std::cos(seconds * 1.3));
+            controllers.fader = std::uint8_t(63.5 + 63.5 * std::sin(seconds * 0.5));
+            controllers.pedal = std::uint8_t(63.5 + 63.5 * std::cos(seconds * 0.7));
+            std::uint8_t bytes[ControllersFrame::Size];
+            controllers.encode(bytes);
+            inject(bytes, sizeof(bytes));
+            ++controllerFramesSent;
+        }
+    });
+
+    // Une image demandée par période, comme la synchronisation verticale d'un écran
+    QTimer vsync;
+    vsync.setTimerType(Qt::PreciseTimer);
+    vsync.setInterval(qMax(1, 1000 / settings.fps));
+    QObject::connect(&vsync, &QTimer::timeout, window, &QQuickWindow::update);
+
+    std::vector<FrameSample> samples;
+    samples.reserve(std::size_t(settings.durationSeconds * settings.fps * 1.5));
+    bool measuring = false;
+    qint64 frameStartNs = -1;
+    qint64 lastSwapNs = -1;
+    double lastCpuMs = RenderProbes::processCpuMs();
+    RenderProbes::Counters lastCounters = RenderProbes::counters();
+    qint64 notesAtStart = 0;
+    qint64 controllersAtStart = 0;
+
+    // Début d'image : animations avancées (ou synchronisation si le rendu ne l'émet pas)
+    const auto frameBegins = [&]() {
+        if (frameStartNs < 0)
+            frameStartNs = clock.nsecsElapsed();
+    };
+    QObject::connect(window, &QQuickWindow::afterAnimating, window, frameBegins, Qt::DirectConnection);
+    QObject::connect(window, &QQuickWindow::beforeSynchronizing, window, frameBegins, Qt::DirectConnection);
+    QObject::connect(window, &QQuickWindow::frameSwapped, window, [&]() {
+        const qint64 now = clock.nsecsElapsed();
+        const double cpuMs = RenderProbes::processCpuMs();
+        const RenderProbes::Counters current = RenderProbes::counters();
+        if (measuring && lastSwapNs >= 0 && frameStartNs >= 0) {
+            FrameSample sample;
+            sample.intervalMs = double(now - lastSwapNs) / 1.0e6;
+            sample.workMs = double(now - frameStartNs) / 1.0e6;
+            sample.cpuMs = cpuMs - lastCpuMs;
+            sample.signalsEmitted = double(current.signalsEmitted - lastCounters.signalsEmitted);
+            sample.objectsCreated = double(current.objectsCreated - lastCounters.objectsCreated);
+            sample.objectsDestroyed = double(current.objectsDestroyed - lastCounters.objectsDestroyed);
+            sample.jsHeapMiB = double(RenderProbes::jsHeapBytes(&engine)) / (1024.0 * 1024.0);
+            samples.push_back(sample);
+        }
+        // Relevés repris après l'échantillonnage : le coût des sondes n'est pas imputé à l'image suivante
+        frameStartNs = -1;
+        lastSwapNs = clock.nsecsElapsed();
+        lastCounters = RenderProbes::counters();
+        lastCpuMs = RenderProbes::processCpuMs();
+    }, Qt::DirectConnection);
+
+    QTimer::singleShot(int(settings.warmupSeconds * 1000.0), &app, [&]() {
+        measuring = true;
+        notesAtStart = notesSent;
+        controllersAtStart = controllerFramesSent;
+    });
+    QTimer::singleShot(int((settings.warmupSeconds + settings.durationSeconds) * 1000.0), &app, &QCoreApplication::quit);
+    feeder.start();
+    vsync.start();
+    app.exec();
+    feeder.stop();
+    vsync.stop();
+
+    if (samples.empty()) {
+        std::fprintf(stderr, "Aucune image rendue pendant la mesure\n");
+        return 2;
+    }
+
+    const auto column = [&samples](double FrameSample::*field) {
+        std::vector<double> values;
+        values.reserve(samples.size());
+        for (const FrameSample &sample : samples)
+            values.push_back(sample.*field);
+        return summarize(std::move(values));
+    };
+    const bool probes = RenderProbes::available();
+    struct Metric {
+        const char *key;
+        const char *label;
+        Summary summary;
+        bool available;
+    };
+    const Metric metrics[] = {
+        { "frameIntervalMs", "intervalle entre images (ms)", column(&FrameSample::intervalMs), true },
+        { "frameWorkMs", "travail d'image (ms)", column(&FrameSample::workMs), true },
+        { "cpuMsPerFrame", "CPU processus par image (ms)", column(&FrameSample::cpuMs), true },
+        { "signalsPerFrame", "signaux émis par image", column(&FrameSample::signalsEmitted), probes },
+        { "objectsCreatedPerFrame", "QObject créés par image", column(&FrameSample::objectsCreated), probes },
+        { "objectsDestroyedPerFrame", "QObject détruits par image", column(&FrameSample::objectsDestroyed), probes },
+        { "jsHeapMiB", "tas JS (Mio)", column(&FrameSample::jsHeapMiB), probes },
+    };
+
+    const double fpsMeasured = double(samples.size()) / settings.durationSeconds;
+    const int eventsInMemory = eventCount(gameMode->property("midiEvents"));
+    std::printf("rendu %s, %zu images (%.1f img/s), %lld notes, %lld trames 0x02, %d événements MIDI en mémoire\n",
+                qPrintable(renderer), samples.size(), fpsMeasured, notesSent - notesAtStart,
+                controllerFramesSent - controllersAtStart, eventsInMemory);
+    if (!probes)
+        std::printf("en-têtes privés Qt absents : signaux, QObject et tas JS non mesurés\n");
+    std::printf("%-34s %10s %10s %10s\n", "métrique", "p50", "p99", "max");
+    for (const Metric &metric : metrics) {
+        if (!metric.available)
+            std::printf("%-34s %10s %10s %10s\n", metric.label, "n/d", "n/d", "n/d");
+        else
+            std::printf("%-34s %10.2f %10.2f %10.2f\n", metric.label, metric.summary.p50, metric.summary.p99, metric.summary.max);
+    }
+
+    bool overBudget = false;
+    if (parser.isSet(budgetOption)) {
+        const double budgetMs = parser.value(budgetOption).toDouble();
+        const double cpuP99 = metrics[2].summary.p99;
+        overBudget = cpuP99 > budgetMs;
+        std::printf("budget CPU par image %.2f ms : p99 %.2f ms%s\n", budgetMs, cpuP99, overBudget ? "  DÉPASSÉ" : "");
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject results;
+        for (const Metric &metric : metrics)
+            results.insert(QLatin1String(metric.key), toJson(metric.summary, metric.available));
+        QJsonObject root;
+        root.insert(QStringLiteral("schema"), 1);
+        root.insert(QStringLiteral("label"), parser.value(labelOption));
+        root.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert(QStringLiteral("host"), QSysInfo::machineHostName());
+        root.insert(QStringLiteral("cpu"), QSysInfo::currentCpuArchitecture());
+        root.insert(QStringLiteral("os"), QSysInfo::prettyProductName());
+        root.insert(QStringLiteral("qt"), QLatin1String(qVersion()));
+        root.insert(QStringLiteral("buildType"), QStringLiteral(MECAVIV_BENCH_BUILD_TYPE));
+        root.insert(QStringLiteral("renderer"), renderer);
+        root.insert(QStringLiteral("qtPrivateProbes"), probes);
+        root.insert(QStringLiteral("settings"), QJsonObject {
+            { QStringLiteral("notesPerSecond"), settings.notesPerSecond },
+            { QStringLiteral("noteLengthMs"), settings.noteLengthMs },
+            { QStringLiteral("lookaheadMs"), settings.lookaheadMs },
+            { QStringLiteral("controllerRate"), settings.controllerRate },
+            { QStringLiteral("warmupSeconds"), settings.warmupSeconds },
+            { QStringLiteral("durationSeconds"), settings.durationSeconds },
+            { QStringLiteral("fps"), settings.fps },
+            { QStringLiteral("width"), windowSize.width() },
+            { QStringLiteral("height"), windowSize.height() } });
+        root.insert(QStringLiteral("frames"), double(samples.size()));
+        root.insert(QStringLiteral("notesSent"), double(notesSent - notesAtStart));
+        root.insert(QStringLiteral("controllerFramesSent"), double(controllerFramesSent - controllersAtStart));
+        root.insert(QStringLiteral("midiEventsInMemory"), eventsInMemory);
+        root.insert(QStringLiteral("results"), results);
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "Écriture impossible: %s\n", qPrintable(file.errorString()));
+            return 2;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    return overBudget ? 1 : 0;
+}
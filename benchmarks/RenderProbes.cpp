@@ -0,0 +1,104 @@
+#include "RenderProbes.h"
+#include <QJSEngine>
+#include <atomic>
+#include <ctime>
+
+#ifdef MECAVIV_RENDERBENCH_QT_PRIVATE
+#include <private/qhooks_p.h>
+#include <private/qobject_p.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+#endif
+
+namespace {
+
+#ifdef MECAVIV_RENDERBENCH_QT_PRIVATE
+std::atomic<qint64> signalsEmitted { 0 };
+std::atomic<qint64> objectsCreated { 0 };
+std::atomic<qint64> objectsDestroyed { 0 };
+
+// Hooks déjà installés (outil d'inspection type GammaRay) : on les chaîne
+QHooks::AddQObjectCallback previousAddObject = nullptr;
+QHooks::RemoveQObjectCallback previousRemoveObject = nullptr;
+
+void onAddObject(QObject *object)
+{
+    objectsCreated.fetch_add(1, std::memory_order_relaxed);
+    if (previousAddObject)
+        previousAddObject(object);
+}
+
+void onRemoveObject(QObject *object)
+{
+    objectsDestroyed.fetch_add(1, std::memory_order_relaxed);
+    if (previousRemoveObject)
+        previousRemoveObject(object);
+}
+
+// Chaque émission notifie les bindings qui dépendent de la propriété : c'est le
+// déclencheur des réévaluations, le nombre exact n'étant visible qu'au profileur QML
+void onSignalBegin(QObject *, int, void **)
+{
+    signalsEmitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+// QtCore garde le pointeur : l'ensemble doit vivre jusqu'à la fin du processus
+QSignalSpyCallbackSet signalSpy = { onSignalBegin, nullptr, nullptr, nullptr };
+#endif
+
+}
+
+bool RenderProbes::available()
+{
+#ifdef MECAVIV_RENDERBENCH_QT_PRIVATE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RenderProbes::install()
+{
+#ifdef MECAVIV_RENDERBENCH_QT_PRIVATE
+    previousAddObject = reinterpret_cast<QHooks::AddQObjectCallback>(qtHookData[QHooks::AddQObject]);
+    previousRemoveObject = reinterpret_cast<QHooks::RemoveQObjectCallback>(qtHookData[QHooks::RemoveQObject]);
+    qtHookData[QHooks::AddQObject] = reinterpret_cast<quintptr>(&onAddObject);
+    qtHookData[QHooks::RemoveQObject] = reinterpret_cast<quintptr>(&onRemoveObject);
+    qt_register_signal_spy_callbacks(&signalSpy);
+#endif
+}
+
+RenderProbes::Counters RenderProbes::counters()
+{
+    Counters result;
+#ifdef MECAVIV_RENDERBENCH_QT_PRIVATE
+    result.signalsEmitted = signalsEmitted.load(std::memory_order_relaxed);
+    result.objectsCreated = objectsCreated.load(std::memory_order_relaxed);
+    result.objectsDestroyed = objectsDestroyed.load(std::memory_order_relaxed);
+#endif
+    return result;
+}
+
+qint64 RenderProbes::jsHeapBytes(QJSEngine *engine)
+{
+#ifdef MECAVIV_RENDERBENCH_QT_PRIVATE
+    if (engine && engine->handle() && engine->handle()->memoryManager) {
+        QV4::MemoryManager *memory = engine->handle()->memoryManager;
+        return qint64(memory->getUsedMem() + memory->getLargeItemsMem());
+    }
+#else
+    Q_UNUSED(engine);
+#endif
+    return -1;
+}
+
+double RenderProbes::processCpuMs()
+{
+#if defined(Q_OS_UNIX) && defined(CLOCK_PROCESS_CPUTIME_ID)
+    timespec now {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return double(now.tv_sec) * 1000.0 + double(now.tv_nsec) / 1.0e6;
+#else
+    return double(std::clock()) * 1000.0 / double(CLOCKS_PER_SEC);
+#endif
+}
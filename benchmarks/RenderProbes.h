@@ -0,0 +1,32 @@
+#ifndef RENDERPROBES_H
+#define RENDERPROBES_H
+
+#include <QtGlobal>
+
+class QJSEngine;
+
+// Compteurs du banc de rendu (pupitreRenderBench).
+// Émissions de signaux et QObject créés / détruits passent par les hooks de QtCore
+// (qtHookData, callbacks d'espionnage des signaux), le tas JS par le gestionnaire
+// mémoire V4 : tous demandent les en-têtes privés Qt (MECAVIV_RENDERBENCH_QT_PRIVATE).
+// Sans eux, available() vaut false et les compteurs restent à -1.
+namespace RenderProbes {
+
+struct Counters {
+    qint64 signalsEmitted = -1;
+    qint64 objectsCreated = -1;
+    qint64 objectsDestroyed = -1;
+};
+
+bool available();
+// À appeler une fois, avant le chargement du QML
+void install();
+Counters counters();
+// Octets utilisés par le tas JS (petits objets + gros objets), -1 si indisponible
+qint64 jsHeapBytes(QJSEngine *engine);
+// Temps CPU consommé par le processus (tous threads), en ms
+double processCpuMs();
+
+}
+
+#endif // RENDERPROBES_H
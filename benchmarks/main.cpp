@@ -0,0 +1,172 @@
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QGuiApplication>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <cstdio>
+#include "BenchHarness.h"
+#include "MecavivLog.h"
+
+// Exécutable des micro-benchmarks : table lisible sur stdout, JSON avec --json,
+// comparaison à un JSON précédent avec --baseline (écarts en %, code de sortie 1
+// si une régression dépasse --max-regression).
+
+namespace {
+
+QString humanRate(double value, const char *unit)
+{
+    static const char *prefixes[] = { "", "k", "M", "G" };
+    int prefix = 0;
+    while (value >= 1000.0 && prefix < 3) {
+        value /= 1000.0;
+        ++prefix;
+    }
+    return QStringLiteral("%1 %2%3").arg(value, 0, 'f', 1).arg(QLatin1String(prefixes[prefix]), QLatin1String(unit));
+}
+
+QJsonObject toJson(const Bench::Result &result)
+{
+    QJsonObject object;
+    object.insert(QStringLiteral("name"), result.name);
+    object.insert(QStringLiteral("iterations"), double(result.iterations));
+    object.insert(QStringLiteral("nsPerOp"), result.nsPerOp);
+    object.insert(QStringLiteral("nsPerOpMin"), result.nsPerOpMin);
+    object.insert(QStringLiteral("allocsPerOp"), result.allocsPerOp);
+    object.insert(QStringLiteral("allocBytesPerOp"), result.allocBytesPerOp);
+    object.insert(QStringLiteral("opsPerSecond"), result.opsPerSecond);
+    object.insert(QStringLiteral("bytesPerSecond"), result.bytesPerSecond);
+    return object;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // La géométrie Quick3D demande une application graphique, pas d'affichage
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("mecavivBenchmarks"));
+    MecavivLog::configureFromEnvironment();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Micro-benchmarks des chemins critiques Mecaviv"));
+    parser.addHelpOption();
+    const QCommandLineOption listOption(QStringLiteral("list"), QStringLiteral("Liste les benchmarks sans les exécuter."));
+    const QCommandLineOption filterOption(QStringLiteral("filter"),
+        QStringLiteral("N'exécute que les benchmarks dont le nom correspond à <regex>."), QStringLiteral("regex"));
+    const QCommandLineOption minTimeOption(QStringLiteral("min-time"),
+        QStringLiteral("Durée visée d'une répétition en ms (défaut 200)."), QStringLiteral("ms"), QStringLiteral("200"));
+    const QCommandLineOption repetitionsOption(QStringLiteral("repetitions"),
+        QStringLiteral("Nombre de répétitions mesurées, médiane retenue (défaut 5)."), QStringLiteral("n"), QStringLiteral("5"));
+    const QCommandLineOption jsonOption(QStringLiteral("json"),
+        QStringLiteral("Écrit les résultats dans <fichier> (JSON)."), QStringLiteral("fichier"));
+    const QCommandLineOption labelOption(QStringLiteral("label"),
+        QStringLiteral("Étiquette enregistrée dans le JSON (commit, branche...)."), QStringLiteral("texte"));
+    const QCommandLineOption baselineOption(QStringLiteral("baseline"),
+        QStringLiteral("Compare aux résultats JSON de <fichier>."), QStringLiteral("fichier"));
+    const QCommandLineOption maxRegressionOption(QStringLiteral("max-regression"),
+        QStringLiteral("Échec si un ns/op dépasse la référence de plus de <pct> %."), QStringLiteral("pct"));
+    parser.addOptions({ listOption, filterOption, minTimeOption, repetitionsOption, jsonOption,
+                        labelOption, baselineOption, maxRegressionOption });
+    parser.process(app);
+
+    Bench::Registry registry;
+    Bench::registerProtocolBenchmarks(registry);
+    Bench::registerDispatchBenchmarks(registry);
+    Bench::registerGeometryBenchmarks(registry);
+    Bench::registerPlaylistBenchmarks(registry);
+    Bench::registerConfigBenchmarks(registry);
+
+    Bench::Options options;
+    options.filter = QRegularExpression(parser.value(filterOption));
+    options.minTimeMs = qMax(1, parser.value(minTimeOption).toInt());
+    options.repetitions = qMax(1, parser.value(repetitionsOption).toInt());
+    if (!options.filter.isValid()) {
+        std::fprintf(stderr, "Filtre invalide: %s\n", qPrintable(options.filter.errorString()));
+        return 2;
+    }
+
+    if (parser.isSet(listOption)) {
+        for (const Bench::Benchmark &benchmark : registry.benchmarks())
+            std::printf("%s\n", qPrintable(benchmark.name));
+        return 0;
+    }
+
+    // Référence : nom → ns/op, allocations/op
+    QHash<QString, QJsonObject> baseline;
+    if (parser.isSet(baselineOption)) {
+        QFile file(parser.value(baselineOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "Référence illisible: %s\n", qPrintable(file.errorString()));
+            return 2;
+        }
+        const QJsonArray results = QJsonDocument::fromJson(file.readAll()).object().value(QStringLiteral("results")).toArray();
+        for (const QJsonValue &value : results)
+            baseline.insert(value.toObject().value(QStringLiteral("name")).toString(), value.toObject());
+    }
+    const double maxRegression = parser.isSet(maxRegressionOption) ? parser.value(maxRegressionOption).toDouble() : -1.0;
+
+    std::printf("%-44s %12s %12s %10s %12s %14s%s\n", "benchmark", "ns/op", "min ns/op", "allocs/op",
+                "octets/op", "débit", baseline.isEmpty() ? "" : "   vs réf.");
+    QJsonArray results;
+    bool regression = false;
+    for (const Bench::Benchmark &benchmark : registry.benchmarks()) {
+        if (!options.filter.pattern().isEmpty() && !options.filter.match(benchmark.name).hasMatch())
+            continue;
+        const Bench::Result result = Bench::run(benchmark, options);
+        if (!result.ok) {
+            std::printf("%-44s %12s\n", qPrintable(benchmark.name), "échec");
+            continue;
+        }
+        results.append(toJson(result));
+
+        const QString rate = benchmark.bytesPerOp > 0 ? humanRate(result.bytesPerSecond, "o/s")
+                                                      : humanRate(result.opsPerSecond, "op/s");
+        QString comparison;
+        const auto reference = baseline.constFind(benchmark.name);
+        if (reference != baseline.constEnd()) {
+            const double before = reference->value(QStringLiteral("nsPerOp")).toDouble();
+            const double delta = before > 0.0 ? (result.nsPerOp - before) / before * 100.0 : 0.0;
+            const double allocDelta = result.allocsPerOp - reference->value(QStringLiteral("allocsPerOp")).toDouble();
+            comparison = QStringLiteral("   %1%2 %").arg(delta >= 0.0 ? QStringLiteral("+") : QString()).arg(delta, 0, 'f', 1);
+            if (qAbs(allocDelta) >= 0.01)
+                comparison += QStringLiteral(", %1%2 allocs").arg(allocDelta > 0.0 ? QStringLiteral("+") : QString()).arg(allocDelta, 0, 'f', 2);
+            if (maxRegression >= 0.0 && delta > maxRegression) {
+                comparison += QStringLiteral("  RÉGRESSION");
+                regression = true;
+            }
+        }
+        std::printf("%-44s %12.1f %12.1f %10.2f %12.1f %14s%s\n", qPrintable(benchmark.name), result.nsPerOp,
+                    result.nsPerOpMin, result.allocsPerOp, result.allocBytesPerOp, qPrintable(rate), qPrintable(comparison));
+        std::fflush(stdout);
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject root;
+        root.insert(QStringLiteral("schema"), 1);
+        root.insert(QStringLiteral("label"), parser.value(labelOption));
+        root.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert(QStringLiteral("host"), QSysInfo::machineHostName());
+        root.insert(QStringLiteral("cpu"), QSysInfo::currentCpuArchitecture());
+        root.insert(QStringLiteral("os"), QSysInfo::prettyProductName());
+        root.insert(QStringLiteral("qt"), QLatin1String(qVersion()));
+        root.insert(QStringLiteral("buildType"), QStringLiteral(MECAVIV_BENCH_BUILD_TYPE));
+        root.insert(QStringLiteral("allocationTracking"), QLatin1String(Bench::allocationTracking()));
+        root.insert(QStringLiteral("minTimeMs"), options.minTimeMs);
+        root.insert(QStringLiteral("repetitions"), options.repetitions);
+        root.insert(QStringLiteral("results"), results);
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "Écriture impossible: %s\n", qPrintable(file.errorString()));
+            return 2;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    return regression ? 1 : 0;
+}
@@ -0,0 +1,52 @@
+#ifndef CAPTUREFORMAT_H
+#define CAPTUREFORMAT_H
+
+#include "MecavivSchema.h"
+
+// Format des fichiers de capture réseau (.mcap), écrits par TrafficRecorder et relus
+// par TrafficReplayer. Fichier en ajout seul : un en-tête puis des enregistrements
+// contigus, sans index ni alignement. Entiers little-endian.
+//
+//   en-tête (16)       : "MCAP" | version u16 | taille d'en-tête d'enregistrement u16 | début (ms epoch) u64
+//   enregistrement (16): horodatage ns u64 | longueur u32 | sens u8 | canal u8 | marqueur u16
+//                        puis <longueur> octets de charge utile
+//
+// L'horodatage est monotone, relatif au début de la capture. Le marqueur est écrit en
+// dernier : un enregistrement interrompu (arrêt brutal, fin du fichier pré-alloué)
+// reste à zéro et marque la fin de la capture.
+namespace MecavivCapture {
+
+using MecavivProtocol::Field;
+
+struct FileHeader {
+    static constexpr std::size_t Size = 16;
+    static constexpr std::uint32_t MagicValue = 0x5041434D;  // "MCAP"
+    static constexpr std::uint16_t CurrentVersion = 1;
+
+    using Magic = Field<std::uint32_t, 0>;
+    using Version = Field<std::uint16_t, 4>;
+    using RecordHeaderSize = Field<std::uint16_t, 6>;
+    using StartEpochMs = Field<std::uint64_t, 8>;
+};
+
+struct RecordHeader {
+    static constexpr std::size_t Size = 16;
+    static constexpr std::uint16_t MarkerValue = 0x4352;  // "RC"
+
+    using TimestampNs = Field<std::uint64_t, 0>;
+    using Length = Field<std::uint32_t, 8>;
+    using Direction = Field<std::uint8_t, 12>;
+    using Channel = Field<std::uint8_t, 13>;
+    using Marker = Field<std::uint16_t, 14>;
+};
+
+static_assert(MecavivProtocol::schemaContiguous<FileHeader::Magic, FileHeader::Version,
+              FileHeader::RecordHeaderSize, FileHeader::StartEpochMs>(), "en-tête de fichier contigu");
+static_assert(MecavivProtocol::schemaEnd<FileHeader::StartEpochMs>() == FileHeader::Size, "en-tête de fichier : 16 octets");
+static_assert(MecavivProtocol::schemaContiguous<RecordHeader::TimestampNs, RecordHeader::Length,
+              RecordHeader::Direction, RecordHeader::Channel, RecordHeader::Marker>(), "en-tête d'enregistrement contigu");
+static_assert(MecavivProtocol::schemaEnd<RecordHeader::Marker>() == RecordHeader::Size, "en-tête d'enregistrement : 16 octets");
+
+}
+
+#endif // CAPTUREFORMAT_H
@@ -0,0 +1,155 @@
+#include "TrafficRecorder.h"
+#include "CaptureFormat.h"
+#include "MecavivLog.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <cstring>
+
+MECAVIV_LOG_CATEGORY(lcCapture, "CAPTURE", MecavivLog::Level::Info)
+
+using namespace MecavivCapture;
+
+namespace {
+// Croissance de la projection par blocs fixes : une répétition (~100 trames/s) tient
+// dans le premier bloc, et après un arrêt brutal (pas de troncature) le fichier ne
+// dépasse ses données que d'un bloc au plus
+constexpr qint64 kGrowthBytes = 4 * 1024 * 1024;
+}
+
+TrafficRecorder::TrafficRecorder(QObject *parent)
+    : QObject(parent)
+    , m_memory("capture", "TrafficRecorder", [this] {
+          return MecavivMemory::Usage { isRecording() ? 1 : 0, m_capacity };
+      })
+{
+}
+
+TrafficRecorder::~TrafficRecorder()
+{
+    stop();
+}
+
+bool TrafficRecorder::start(const QString &path)
+{
+    stop();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        fail(QStringLiteral("Capture impossible (%1): %2").arg(path, m_file.errorString()));
+        return false;
+    }
+    m_used = 0;
+    m_capacity = 0;
+    if (!reserve(qint64(FileHeader::Size))) {
+        m_file.close();
+        return false;
+    }
+
+    FileHeader::Magic::write(m_map, FileHeader::MagicValue);
+    FileHeader::Version::write(m_map, FileHeader::CurrentVersion);
+    FileHeader::RecordHeaderSize::write(m_map, std::uint16_t(RecordHeader::Size));
+    FileHeader::StartEpochMs::write(m_map, std::uint64_t(QDateTime::currentMSecsSinceEpoch()));
+    m_used = qint64(FileHeader::Size);
+    m_clock.start();
+
+    mlogInfo(lcCapture) << "Capture du trafic dans" << path;
+    emit recordingChanged();
+    return true;
+}
+
+bool TrafficRecorder::startFromEnvironment(const QString &name)
+{
+    const QString target = qEnvironmentVariable("MECAVIV_CAPTURE");
+    if (target.isEmpty())
+        return false;
+    if (!QFileInfo(target).isDir())
+        return start(target);
+    const QString stamp = QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"));
+    return start(QDir(target).filePath(QStringLiteral("%1-%2.mcap").arg(name, stamp)));
+}
+
+void TrafficRecorder::stop()
+{
+    if (!m_map)
+        return;
+    m_file.unmap(m_map);
+    m_map = nullptr;
+    // Taille utile : la fin pré-allouée (zéros) disparaît
+    m_file.resize(m_used);
+    m_file.close();
+    mlogInfo(lcCapture) << "Capture terminée:" << m_file.fileName() << m_used << "octets";
+    emit recordingChanged();
+}
+
+void TrafficRecorder::record(int direction, int channel, const QByteArray &payload)
+{
+    append(Direction(direction), Channel(channel), payload.constData(), payload.size());
+}
+
+void TrafficRecorder::recordText(int direction, int channel, const QString &text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    append(Direction(direction), Channel(channel), utf8.constData(), utf8.size());
+}
+
+void TrafficRecorder::append(Direction direction, Channel channel, const char *data, qsizetype size)
+{
+    if (!m_map)
+        return;
+    const qint64 timestampNs = m_clock.nsecsElapsed();
+    if (!reserve(qint64(RecordHeader::Size) + size))
+        return;
+
+    uchar *out = m_map + m_used;
+    RecordHeader::TimestampNs::write(out, std::uint64_t(timestampNs));
+    RecordHeader::Length::write(out, std::uint32_t(size));
+    RecordHeader::Direction::write(out, std::uint8_t(direction));
+    RecordHeader::Channel::write(out, std::uint8_t(channel));
+    if (size > 0)
+        std::memcpy(out + RecordHeader::Size, data, size_t(size));
+    // En dernier : l'enregistrement n'existe pour le lecteur qu'une fois complet
+    RecordHeader::Marker::write(out, RecordHeader::MarkerValue);
+    m_used += qint64(RecordHeader::Size) + size;
+}
+
+bool TrafficRecorder::reserve(qint64 bytes)
+{
+    if (m_used + bytes <= m_capacity)
+        return true;
+
+    // Multiple de bloc suivant (une trame plus grande qu'un bloc en prend plusieurs)
+    const qint64 capacity = (m_used + bytes + kGrowthBytes - 1) / kGrowthBytes * kGrowthBytes;
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (!m_file.resize(capacity)) {
+        fail(QStringLiteral("Capture interrompue (%1): %2").arg(m_file.fileName(), m_file.errorString()));
+        return false;
+    }
+    m_map = m_file.map(0, capacity);
+    if (!m_map) {
+        fail(QStringLiteral("Projection impossible (%1): %2").arg(m_file.fileName(), m_file.errorString()));
+        return false;
+    }
+    m_capacity = capacity;
+    return true;
+}
+
+void TrafficRecorder::fail(const QString &message)
+{
+    mlogWarn(lcCapture) << message;
+    // Ce qui a été écrit reste exploitable : on tronque à la dernière trame complète
+    if (m_file.isOpen()) {
+        if (m_map) {
+            m_file.unmap(m_map);
+            m_map = nullptr;
+        }
+        m_file.resize(m_used);
+        m_file.close();
+        // En-tête écrit : la capture était en cours
+        if (m_used > 0)
+            emit recordingChanged();
+    }
+    emit errorOccurred(message);
+}
@@ -0,0 +1,72 @@
+#ifndef TRAFFICRECORDER_H
+#define TRAFFICRECORDER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include "MemoryAccounting.h"
+
+// Capture du trafic réseau d'une application (format : CaptureFormat.h).
+// Chaque trame entrante ou sortante est ajoutée avec un horodatage monotone dans un
+// fichier projeté en mémoire (QFile::map) et agrandi par blocs : un ajout est une copie
+// dans la projection, sans appel système. À l'arrêt le fichier est ramené à sa taille
+// utile ; après un arrêt brutal, les pages déjà écrites restent lisibles par le rejeu.
+//
+// Activation : MECAVIV_CAPTURE=<fichier.mcap | dossier> puis startFromEnvironment(nom).
+// Non thread-safe : à utiliser depuis le thread de l'objet.
+class TrafficRecorder : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool recording READ isRecording NOTIFY recordingChanged)
+    Q_PROPERTY(QString path READ path NOTIFY recordingChanged)
+
+public:
+    enum Direction {
+        Inbound = 0,
+        Outbound = 1
+    };
+    Q_ENUM(Direction)
+
+    enum Channel {
+        WebSocketBinary = 0,
+        WebSocketText = 1,
+        Udp = 2
+    };
+    Q_ENUM(Channel)
+
+    explicit TrafficRecorder(QObject *parent = nullptr);
+    ~TrafficRecorder() override;
+
+    bool isRecording() const { return m_map != nullptr; }
+    QString path() const { return m_file.fileName(); }
+
+    Q_INVOKABLE bool start(const QString &path);
+    // MECAVIV_CAPTURE : fichier, ou dossier recevant <name>-<date>.mcap
+    Q_INVOKABLE bool startFromEnvironment(const QString &name);
+    Q_INVOKABLE void stop();
+
+    Q_INVOKABLE void record(int direction, int channel, const QByteArray &payload);
+    Q_INVOKABLE void recordText(int direction, int channel, const QString &text);
+    void append(Direction direction, Channel channel, const char *data, qsizetype size);
+
+signals:
+    void recordingChanged();
+    void errorOccurred(const QString &message);
+
+private:
+    bool reserve(qint64 bytes);
+    void fail(const QString &message);
+
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_capacity = 0;
+    qint64 m_used = 0;
+    QElapsedTimer m_clock;
+
+    // Comptabilité mémoire : projection du fichier (pages résidentes au fil de l'écriture)
+    MecavivMemory::Source m_memory;
+};
+
+#endif // TRAFFICRECORDER_H
@@ -0,0 +1,175 @@
+#include "TrafficReplayer.h"
+#include "CaptureFormat.h"
+#include "TrafficRecorder.h"
+#include "MecavivLog.h"
+#include <cmath>
+
+MECAVIV_LOG_CATEGORY(lcReplay, "REPLAY", MecavivLog::Level::Info)
+
+using namespace MecavivCapture;
+
+namespace {
+// Au plus vite : trames réémises par passage dans la boucle d'événements
+constexpr int kFastBatch = 64;
+}
+
+TrafficReplayer::TrafficReplayer(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &TrafficReplayer::replayDue);
+}
+
+TrafficReplayer::~TrafficReplayer()
+{
+    stop();
+}
+
+void TrafficReplayer::setSource(const QString &source)
+{
+    if (m_source != source) {
+        m_source = source;
+        emit sourceChanged();
+    }
+}
+
+void TrafficReplayer::setSpeed(double speed)
+{
+    speed = qMax(0.0, speed);
+    if (!qFuzzyCompare(m_speed + 1.0, speed + 1.0)) {
+        m_speed = speed;
+        emit speedChanged();
+    }
+}
+
+void TrafficReplayer::setLoop(bool loop)
+{
+    if (m_loop != loop) {
+        m_loop = loop;
+        emit loopChanged();
+    }
+}
+
+bool TrafficReplayer::start()
+{
+    stop();
+    m_file.setFileName(m_source);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        fail(QStringLiteral("Capture illisible (%1): %2").arg(m_source, m_file.errorString()));
+        return false;
+    }
+    m_size = m_file.size();
+    const uchar *data = m_size > 0 ? m_file.map(0, m_size) : nullptr;
+    if (!data) {
+        m_buffer = m_file.readAll();
+        data = reinterpret_cast<const uchar *>(m_buffer.constData());
+        m_size = m_buffer.size();
+    }
+    if (m_size < qint64(FileHeader::Size) || FileHeader::Magic::read(data) != FileHeader::MagicValue
+        || FileHeader::Version::read(data) != FileHeader::CurrentVersion
+        || FileHeader::RecordHeaderSize::read(data) != RecordHeader::Size) {
+        m_file.close();
+        m_buffer.clear();
+        fail(QStringLiteral("Pas une capture MCAP v%1: %2").arg(FileHeader::CurrentVersion).arg(m_source));
+        return false;
+    }
+
+    m_data = data;
+    m_frames = 0;
+    mlogInfo(lcReplay) << "Rejeu de" << m_source << "vitesse" << m_speed;
+    rewind();
+    emit runningChanged();
+    m_timer.start(0);
+    return true;
+}
+
+bool TrafficReplayer::startFromEnvironment()
+{
+    const QString source = qEnvironmentVariable("MECAVIV_REPLAY");
+    if (source.isEmpty())
+        return false;
+    bool ok = false;
+    const double speed = qEnvironmentVariable("MECAVIV_REPLAY_SPEED").toDouble(&ok);
+    if (ok)
+        setSpeed(speed);
+    setSource(source);
+    return start();
+}
+
+void TrafficReplayer::stop()
+{
+    m_timer.stop();
+    if (!m_data)
+        return;
+    m_data = nullptr;
+    m_file.close();  // libère aussi la projection
+    m_buffer.clear();
+    emit runningChanged();
+}
+
+void TrafficReplayer::rewind()
+{
+    m_offset = qint64(FileHeader::Size);
+    m_firstTimestampNs = -1;
+    m_clock.start();
+}
+
+void TrafficReplayer::replayDue()
+{
+    int emitted = 0;
+    while (m_data && m_offset + qint64(RecordHeader::Size) <= m_size) {
+        const uchar *record = m_data + m_offset;
+        const qint64 length = qint64(RecordHeader::Length::read(record));
+        // Enregistrement inachevé (capture interrompue) : fin de la capture
+        if (RecordHeader::Marker::read(record) != RecordHeader::MarkerValue
+            || m_offset + qint64(RecordHeader::Size) + length > m_size)
+            break;
+
+        const qint64 timestampNs = qint64(RecordHeader::TimestampNs::read(record));
+        if (m_firstTimestampNs < 0)
+            m_firstTimestampNs = timestampNs;
+        if (m_speed > 0.0) {
+            const qint64 dueNs = qint64(double(timestampNs - m_firstTimestampNs) / m_speed);
+            const qint64 waitNs = dueNs - m_clock.nsecsElapsed();
+            if (waitNs > 0) {
+                m_timer.start(int(std::ceil(double(waitNs) / 1.0e6)));
+                return;
+            }
+        } else if (emitted >= kFastBatch) {
+            m_timer.start(0);
+            return;
+        }
+
+        m_offset += qint64(RecordHeader::Size) + length;
+        if (RecordHeader::Direction::read(record) != TrafficRecorder::Inbound)
+            continue;
+        const int channel = RecordHeader::Channel::read(record);
+        const char *payload = reinterpret_cast<const char *>(record + RecordHeader::Size);
+        ++m_frames;
+        ++emitted;
+        // Copie : la projection disparaît si un récepteur arrête le rejeu
+        if (channel == TrafficRecorder::WebSocketText)
+            emit textFrameReplayed(channel, QString::fromUtf8(payload, qsizetype(length)));
+        else
+            emit frameReplayed(channel, QByteArray(payload, qsizetype(length)));
+    }
+    if (!m_data)
+        return;
+
+    if (m_loop && m_frames > 0) {
+        rewind();
+        m_timer.start(0);
+        return;
+    }
+    const qint64 frames = m_frames;
+    mlogInfo(lcReplay) << "Rejeu terminé:" << frames << "trames";
+    stop();
+    emit finished(frames);
+}
+
+void TrafficReplayer::fail(const QString &message)
+{
+    mlogWarn(lcReplay) << message;
+    emit errorOccurred(message);
+}
@@ -0,0 +1,74 @@
+#ifndef TRAFFICREPLAYER_H
+#define TRAFFICREPLAYER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QTimer>
+
+// Rejeu d'une capture TrafficRecorder : les trames entrantes sont réémises avec leur
+// espacement d'origine divisé par speed (1 = temps réel, 4 = quatre fois plus vite,
+// 0 = au plus vite, par lots, en rendant la main à la boucle d'événements entre deux
+// lots). Les trames sortantes de la capture sont celles que l'application produit
+// elle-même : elles sont ignorées.
+//
+// Activation : MECAVIV_REPLAY=<fichier.mcap>, MECAVIV_REPLAY_SPEED=<facteur> puis
+// startFromEnvironment().
+class TrafficReplayer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(bool loop READ loop WRITE setLoop NOTIFY loopChanged)
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+
+public:
+    explicit TrafficReplayer(QObject *parent = nullptr);
+    ~TrafficReplayer() override;
+
+    QString source() const { return m_source; }
+    void setSource(const QString &source);
+    double speed() const { return m_speed; }
+    void setSpeed(double speed);
+    bool loop() const { return m_loop; }
+    void setLoop(bool loop);
+    bool isRunning() const { return m_data != nullptr; }
+
+    Q_INVOKABLE bool start();
+    Q_INVOKABLE bool startFromEnvironment();
+    Q_INVOKABLE void stop();
+
+signals:
+    void sourceChanged();
+    void speedChanged();
+    void loopChanged();
+    void runningChanged();
+    // Canal TrafficRecorder::Channel ; les canaux texte passent par textFrameReplayed
+    void frameReplayed(int channel, const QByteArray &payload);
+    void textFrameReplayed(int channel, const QString &text);
+    void finished(qint64 frames);
+    void errorOccurred(const QString &message);
+
+private:
+    void replayDue();
+    void rewind();
+    void fail(const QString &message);
+
+    QString m_source;
+    double m_speed = 1.0;
+    bool m_loop = false;
+
+    QFile m_file;
+    QByteArray m_buffer;            // repli si la projection est impossible
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_offset = 0;
+    qint64 m_frames = 0;
+    qint64 m_firstTimestampNs = -1;
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+};
+
+#endif // TRAFFICREPLAYER_H
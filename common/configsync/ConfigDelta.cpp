@@ -0,0 +1,348 @@
+#include "ConfigDelta.h"
+#include <cstring>
+
+namespace ConfigSync {
+
+namespace {
+
+// Complément maximal d'un tableau par une écriture isolée (index aberrant = écriture refusée)
+constexpr qsizetype MaxPadding = 256;
+
+QByteArray frameHeader(FrameKind kind, quint8 pupitre)
+{
+    QByteArray header(Magic, 4);
+    header.append(char(kind));
+    header.append(char(pupitre));
+    return header;
+}
+
+QByteArray encodeFrame(FrameKind kind, quint8 pupitre, const QCborMap &payload)
+{
+    return frameHeader(kind, pupitre) + payload.toCborValue().toCbor();
+}
+
+void diffInto(const QCborValue &from, const QCborValue &to, QCborArray &path, QVector<PatchOp> &ops)
+{
+    if (from == to)
+        return;
+
+    if (from.isMap() && to.isMap()) {
+        const QCborMap a = from.toMap();
+        const QCborMap b = to.toMap();
+        for (auto it = a.constBegin(); it != a.constEnd(); ++it) {
+            if (!b.contains(it.key())) {
+                QCborArray removed = path;
+                removed.append(it.key());
+                ops.append({ removed, QCborValue(), true });
+            }
+        }
+        for (auto it = b.constBegin(); it != b.constEnd(); ++it) {
+            path.append(it.key());
+            diffInto(a.value(it.key()), it.value(), path, ops);
+            path.removeLast();
+        }
+        return;
+    }
+
+    if (from.isArray() && to.isArray()) {
+        const QCborArray a = from.toArray();
+        const QCborArray b = to.toArray();
+        if (a.size() == b.size()) {
+            for (qsizetype i = 0; i < a.size(); ++i) {
+                path.append(i);
+                diffInto(a.at(i), b.at(i), path, ops);
+                path.removeLast();
+            }
+            return;
+        }
+    }
+
+    // Types différents, scalaire modifié ou tableau redimensionné : on remplace
+    ops.append({ path, to, false });
+}
+
+// Une écriture par feuille. Un tableau de scalaires est une seule valeur ; un tableau
+// de maps (éventuellement complété par padArrays) est parcouru élément par élément,
+// sans ses null de complément : l'état partiel ne remplace jamais un élément entier.
+bool isLeafArray(const QCborArray &array)
+{
+    for (const QCborValue &item : array) {
+        if (item.isMap() || item.isArray() || item.isNull())
+            return false;
+    }
+    return true;
+}
+
+void leavesInto(const QCborValue &value, QCborArray &path, QVector<PatchOp> &ops)
+{
+    if (value.isMap()) {
+        const QCborMap map = value.toMap();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            path.append(it.key());
+            leavesInto(it.value(), path, ops);
+            path.removeLast();
+        }
+    } else if (value.isArray() && !isLeafArray(value.toArray())) {
+        const QCborArray array = value.toArray();
+        for (qsizetype i = 0; i < array.size(); ++i) {
+            path.append(i);
+            leavesInto(array.at(i), path, ops);
+            path.removeLast();
+        }
+    } else if (!value.isNull() && !value.isUndefined() && !path.isEmpty()) {
+        ops.append({ path, value, false });
+    }
+}
+
+// Écrit value au chemin path[index..] dans container, en créant les maps manquantes.
+// Sans padArrays (pupitre), un index de tableau doit exister (ou suivre le dernier
+// élément pour un ajout) : sinon le patch échoue et le pupitre demande un resync.
+// Avec padArrays (état partiel de la console), un tableau absent ou trop court est
+// complété par des null pour noter une valeur isolée.
+bool setIn(QCborValue &container, const QCborArray &path, qsizetype index, const PatchOp &op, bool padArrays)
+{
+    const QCborValue key = path.at(index);
+    const bool last = index == path.size() - 1;
+
+    if (key.isInteger()) {
+        if (!container.isArray()) {
+            if (!padArrays || op.remove || !(container.isUndefined() || container.isNull()))
+                return false;
+            container = QCborArray();
+        }
+        QCborArray array = container.toArray();
+        const qsizetype i = key.toInteger();
+        if (!padArrays) {
+            if (i < 0 || i > array.size() || (i == array.size() && (op.remove || !last)))
+                return false;
+        } else {
+            if (i < 0 || (op.remove && i >= array.size()) || i > array.size() + MaxPadding)
+                return false;
+            if (!op.remove) {
+                while (array.size() < (last ? i : i + 1))
+                    array.append(QCborValue(nullptr));
+            }
+        }
+        if (last) {
+            if (op.remove)
+                array.removeAt(i);
+            else if (i == array.size())
+                array.append(op.value);
+            else
+                array[i] = op.value;
+        } else {
+            QCborValue child = array.at(i);
+            if (!setIn(child, path, index + 1, op, padArrays))
+                return false;
+            array[i] = child;
+        }
+        container = array;
+        return true;
+    }
+
+    if (!container.isMap()) {
+        if (op.remove)
+            return false;
+        container = QCborMap();
+    }
+    QCborMap map = container.toMap();
+    if (last) {
+        if (op.remove)
+            map.remove(key);
+        else
+            map[key] = op.value;
+    } else {
+        QCborValue child = map.value(key);
+        if (!setIn(child, path, index + 1, op, padArrays))
+            return false;
+        map[key] = child;
+    }
+    container = map;
+    return true;
+}
+
+} // namespace
+
+bool isConfigFrame(const QByteArray &data)
+{
+    return data.size() >= HeaderSize && std::memcmp(data.constData(), Magic, 4) == 0;
+}
+
+QByteArray encodeSnapshot(quint8 pupitre, quint32 version, const QCborMap &config)
+{
+    QCborMap payload;
+    payload[QStringLiteral("v")] = qint64(version);
+    payload[QStringLiteral("c")] = config;
+    return encodeFrame(FrameKind::Snapshot, pupitre, payload);
+}
+
+QByteArray encodePatch(quint8 pupitre, quint32 baseVersion, quint32 version, const QVector<PatchOp> &ops)
+{
+    QCborArray encodedOps;
+    for (const PatchOp &op : ops) {
+        QCborArray entry;
+        entry.append(op.path);
+        if (!op.remove)
+            entry.append(op.value);
+        encodedOps.append(entry);
+    }
+
+    QCborMap payload;
+    payload[QStringLiteral("b")] = qint64(baseVersion);
+    payload[QStringLiteral("v")] = qint64(version);
+    payload[QStringLiteral("ops")] = encodedOps;
+    return encodeFrame(FrameKind::Patch, pupitre, payload);
+}
+
+QByteArray encodeAck(quint8 pupitre, quint32 version)
+{
+    QCborMap payload;
+    payload[QStringLiteral("v")] = qint64(version);
+    return encodeFrame(FrameKind::Ack, pupitre, payload);
+}
+
+QByteArray encodeResyncRequest(quint8 pupitre, quint32 haveVersion)
+{
+    QCborMap payload;
+    payload[QStringLiteral("have")] = qint64(haveVersion);
+    return encodeFrame(FrameKind::ResyncRequest, pupitre, payload);
+}
+
+bool decode(const QByteArray &data, Frame *frame)
+{
+    if (!frame || !isConfigFrame(data))
+        return false;
+
+    const quint8 kind = quint8(data.at(4));
+    if (kind < quint8(FrameKind::Snapshot) || kind > quint8(FrameKind::ResyncRequest))
+        return false;
+
+    QCborParserError error;
+    const QCborValue payload = QCborValue::fromCbor(data.mid(HeaderSize), &error);
+    if (error.error != QCborError::NoError || !payload.isMap())
+        return false;
+
+    const QCborMap map = payload.toMap();
+    *frame = Frame();
+    frame->kind = FrameKind(kind);
+    frame->pupitre = quint8(data.at(5));
+
+    switch (frame->kind) {
+    case FrameKind::Snapshot:
+        frame->version = quint32(map.value(QStringLiteral("v")).toInteger());
+        frame->config = map.value(QStringLiteral("c")).toMap();
+        break;
+    case FrameKind::Patch: {
+        frame->baseVersion = quint32(map.value(QStringLiteral("b")).toInteger());
+        frame->version = quint32(map.value(QStringLiteral("v")).toInteger());
+        const QCborArray ops = map.value(QStringLiteral("ops")).toArray();
+        frame->ops.reserve(ops.size());
+        for (const QCborValue &entry : ops) {
+            const QCborArray op = entry.toArray();
+            if (op.isEmpty() || !op.at(0).isArray())
+                return false;
+            frame->ops.append({ op.at(0).toArray(), op.size() > 1 ? op.at(1) : QCborValue(), op.size() == 1 });
+        }
+        break;
+    }
+    case FrameKind::Ack:
+        frame->version = quint32(map.value(QStringLiteral("v")).toInteger());
+        break;
+    case FrameKind::ResyncRequest:
+        frame->version = quint32(map.value(QStringLiteral("have")).toInteger());
+        break;
+    }
+    return true;
+}
+
+QVector<PatchOp> diff(const QCborValue &from, const QCborValue &to)
+{
+    QVector<PatchOp> ops;
+    QCborArray path;
+    diffInto(from, to, path, ops);
+    return ops;
+}
+
+QCborValue valueAt(const QCborValue &root, const QCborArray &path)
+{
+    QCborValue current = root;
+    for (const QCborValue &key : path) {
+        if (key.isInteger() && current.isArray())
+            current = current.toArray().at(key.toInteger());
+        else if (current.isMap())
+            current = current.toMap().value(key);
+        else
+            return QCborValue(QCborValue::Undefined);
+    }
+    return current;
+}
+
+bool applyOp(QCborMap &root, const PatchOp &op, bool padArrays)
+{
+    if (op.path.isEmpty()) {
+        // Remplacement de la racine
+        if (op.remove || !op.value.isMap())
+            return false;
+        root = op.value.toMap();
+        return true;
+    }
+
+    QCborValue container(root);
+    if (!setIn(container, op.path, 0, op, padArrays))
+        return false;
+    root = container.toMap();
+    return true;
+}
+
+bool applyPatch(QCborMap &root, const QVector<PatchOp> &ops)
+{
+    // Tout ou rien : un patch partiellement appliqué désynchroniserait les versions
+    QCborMap result = root;
+    for (const PatchOp &op : ops) {
+        if (!applyOp(result, op))
+            return false;
+    }
+    root = result;
+    return true;
+}
+
+QVector<PatchOp> leafOps(const QCborValue &root)
+{
+    QVector<PatchOp> ops;
+    QCborArray path;
+    leavesInto(root, path, ops);
+    return ops;
+}
+
+QCborArray pathFromVariantList(const QVariantList &path)
+{
+    QCborArray result;
+    for (const QVariant &key : path) {
+        // Les nombres JS arrivent en double : un index entier doit rester entier
+        if (key.typeId() == QMetaType::Double) {
+            const double d = key.toDouble();
+            if (d == double(qint64(d))) {
+                result.append(qint64(d));
+                continue;
+            }
+        }
+        result.append(QCborValue::fromVariant(key));
+    }
+    return result;
+}
+
+quint8 pupitreIndex(const QString &pupitreId)
+{
+    if (pupitreId.size() < 2 || pupitreId.at(0).toUpper() != QLatin1Char('P'))
+        return 0;
+    bool ok = false;
+    const int index = pupitreId.mid(1).toInt(&ok);
+    return ok && index > 0 && index < 256 ? quint8(index) : 0;
+}
+
+QString pupitreName(quint8 index)
+{
+    return index > 0 ? QStringLiteral("P%1").arg(index) : QString();
+}
+
+}
@@ -0,0 +1,80 @@
+#ifndef CONFIGDELTA_H
+#define CONFIGDELTA_H
+
+#include <QByteArray>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QVariantList>
+#include <QVector>
+
+// Codec de synchronisation de configuration Console ↔ Pupitres.
+//
+// Trame binaire :
+//   [0..3] magic "MCFG"
+//   [4]    type (FrameKind)
+//   [5]    pupitre (1..7, 0 = non précisé)
+//   [6..]  charge utile CBOR
+//
+// La configuration est un document CBOR versionné. Une modification est un
+// patch adressé par chemin (["sirenConfig", "sirens", 0, "ambitus", "max"])
+// appliqué sur une version de base ; si la base ne correspond pas à la version
+// du pupitre, celui-ci demande un snapshot complet (resync).
+namespace ConfigSync {
+
+constexpr char Magic[4] = { 'M', 'C', 'F', 'G' };
+constexpr int HeaderSize = 6;
+
+enum class FrameKind : quint8 {
+    Snapshot = 1,       // { v, c }          console → pupitre
+    Patch = 2,          // { b, v, ops }     console → pupitre
+    Ack = 3,            // { v }             pupitre → console
+    ResyncRequest = 4   // { have }          pupitre → console
+};
+
+struct PatchOp {
+    QCborArray path;
+    QCborValue value;
+    bool remove = false;
+};
+
+struct Frame {
+    FrameKind kind = FrameKind::Ack;
+    quint8 pupitre = 0;
+    quint32 version = 0;
+    quint32 baseVersion = 0;
+    QCborMap config;
+    QVector<PatchOp> ops;
+};
+
+bool isConfigFrame(const QByteArray &data);
+
+QByteArray encodeSnapshot(quint8 pupitre, quint32 version, const QCborMap &config);
+QByteArray encodePatch(quint8 pupitre, quint32 baseVersion, quint32 version, const QVector<PatchOp> &ops);
+QByteArray encodeAck(quint8 pupitre, quint32 version);
+QByteArray encodeResyncRequest(quint8 pupitre, quint32 haveVersion);
+
+bool decode(const QByteArray &data, Frame *frame);
+
+// Diff structurel : maps clé par clé, tableaux élément par élément à taille égale,
+// sinon remplacement du sous-arbre. Les chemins sont relatifs à la racine.
+QVector<PatchOp> diff(const QCborValue &from, const QCborValue &to);
+
+QCborValue valueAt(const QCborValue &root, const QCborArray &path);
+// padArrays : complète par des null un tableau absent ou trop court (état partiel
+// tenu par la console) ; les pupitres appliquent les patchs sans complément
+bool applyOp(QCborMap &root, const PatchOp &op, bool padArrays = false);
+bool applyPatch(QCborMap &root, const QVector<PatchOp> &ops);
+// Écritures feuille par feuille reconstituant root (null de complément ignorés)
+QVector<PatchOp> leafOps(const QCborValue &root);
+
+// Chemin venant de QML (index de tableau en double → entier CBOR)
+QCborArray pathFromVariantList(const QVariantList &path);
+
+// "P3" ↔ 3
+quint8 pupitreIndex(const QString &pupitreId);
+QString pupitreName(quint8 index);
+
+}
+
+#endif // CONFIGDELTA_H
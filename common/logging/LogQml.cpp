@@ -0,0 +1,67 @@
+#include "LogQml.h"
+#include <QtQml>
+
+LogQml::LogQml(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void LogQml::registerQmlType(const char *uri, int versionMajor, int versionMinor)
+{
+    qmlRegisterSingletonType<LogQml>(uri, versionMajor, versionMinor, "Log",
+                                     [](QQmlEngine *, QJSEngine *) -> QObject * {
+        return new LogQml;
+    });
+}
+
+bool LogQml::enabled(const QString &category, int level)
+{
+    return level <= MECAVIV_LOG_MAX_LEVEL && categoryFor(category).isEnabled(MecavivLog::Level(level));
+}
+
+int LogQml::level(const QString &category)
+{
+    return int(categoryFor(category).level());
+}
+
+void LogQml::setLevel(const QString &category, int level)
+{
+    MecavivLog::setLevel(category, MecavivLog::Level(qBound(int(Off), level, int(Trace))));
+}
+
+void LogQml::log(const QString &category, int level, const QJSValue &message)
+{
+    if (level > MECAVIV_LOG_MAX_LEVEL)
+        return;
+    MecavivLog::Category &target = categoryFor(category);
+    if (!target.isEnabled(MecavivLog::Level(level)))
+        return;
+
+    // Évaluation paresseuse : la fonction n'est appelée qu'ici
+    const QJSValue value = message.isCallable() ? message.call() : message;
+    MecavivLog::write(target, MecavivLog::Level(level), messageText(value));
+}
+
+MecavivLog::Category &LogQml::categoryFor(const QString &name)
+{
+    auto it = m_categories.constFind(name);
+    if (it != m_categories.constEnd())
+        return *it.value();
+    MecavivLog::Category &category = MecavivLog::category(name);
+    m_categories.insert(name, &category);
+    return category;
+}
+
+QString LogQml::messageText(const QJSValue &message)
+{
+    // Tableau : éléments joints par un espace, comme console.log(a, b, c)
+    if (message.isArray()) {
+        QStringList parts;
+        const int length = message.property(QStringLiteral("length")).toInt();
+        parts.reserve(length);
+        for (int i = 0; i < length; ++i)
+            parts.append(message.property(quint32(i)).toString());
+        return parts.join(QLatin1Char(' '));
+    }
+    return message.toString();
+}
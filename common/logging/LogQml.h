@@ -0,0 +1,60 @@
+#ifndef LOGQML_H
+#define LOGQML_H
+
+#include <QObject>
+#include <QHash>
+#include <QJSValue>
+#include <QStringList>
+#include "MecavivLog.h"
+
+// Accès QML à MecavivLog (singleton "Log").
+// Les méthodes de journalisation acceptent une fonction à la place du message :
+// elle n'est appelée que si la catégorie est active, ce qui permet de laisser les
+// traces coûteuses (JSON.stringify, concaténations) dans le code de production.
+//
+//   Log.trace("ROUTER", () => ["Route:", JSON.stringify(path), value])
+//   if (Log.enabled("ROUTER", Log.Debug)) { ... }
+class LogQml : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Level {
+        Off = int(MecavivLog::Level::Off),
+        Error = int(MecavivLog::Level::Error),
+        Warn = int(MecavivLog::Level::Warn),
+        Info = int(MecavivLog::Level::Info),
+        Debug = int(MecavivLog::Level::Debug),
+        Trace = int(MecavivLog::Level::Trace)
+    };
+    Q_ENUM(Level)
+
+    explicit LogQml(QObject *parent = nullptr);
+
+    // Enregistre le singleton "Log" dans le module QML de l'application
+    static void registerQmlType(const char *uri, int versionMajor, int versionMinor);
+
+    Q_INVOKABLE bool enabled(const QString &category, int level);
+    Q_INVOKABLE int level(const QString &category);
+    Q_INVOKABLE void setLevel(const QString &category, int level);
+    Q_INVOKABLE bool configured(const QString &category) { return MecavivLog::isConfigured(category); }
+
+    Q_INVOKABLE void log(const QString &category, int level, const QJSValue &message);
+    Q_INVOKABLE void error(const QString &category, const QJSValue &message) { log(category, Error, message); }
+    Q_INVOKABLE void warn(const QString &category, const QJSValue &message) { log(category, Warn, message); }
+    Q_INVOKABLE void info(const QString &category, const QJSValue &message) { log(category, Info, message); }
+    Q_INVOKABLE void debug(const QString &category, const QJSValue &message) { log(category, Debug, message); }
+    Q_INVOKABLE void trace(const QString &category, const QJSValue &message) { log(category, Trace, message); }
+
+    Q_INVOKABLE QStringList recentLines(int count = 100) const { return MecavivLog::recentLines(count); }
+    Q_INVOKABLE void flush() { MecavivLog::flush(); }
+
+private:
+    MecavivLog::Category &categoryFor(const QString &name);
+    static QString messageText(const QJSValue &message);
+
+    // Cache nom → catégorie (le singleton vit dans le thread GUI)
+    QHash<QString, MecavivLog::Category *> m_categories;
+};
+
+#endif // LOGQML_H
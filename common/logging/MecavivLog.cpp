@@ -0,0 +1,447 @@
+#include "MecavivLog.h"
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRecursiveMutex>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if QT_CONFIG(thread)
+#include <QThread>
+#include <QWaitCondition>
+#endif
+
+namespace MecavivLog {
+
+namespace {
+
+constexpr int kBufferCapacity = 1024;     // messages en attente par thread
+constexpr int kDrainInterval = 50;        // ms
+constexpr int kDefaultHistory = 500;
+
+struct Entry {
+    qint64 timestamp = 0;
+    const Category *category = nullptr;
+    Level level = Level::Info;
+    QString text;
+};
+
+// File mono-producteur (le thread qui journalise) / mono-consommateur (le thread de vidage)
+class ThreadBuffer
+{
+public:
+    bool push(Entry &&entry)
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail >= quint32(kBufferCapacity)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_slots[head % kBufferCapacity] = std::move(entry);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(Entry &entry)
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return false;
+        entry = std::move(m_slots[tail % kBufferCapacity]);
+        m_slots[tail % kBufferCapacity].text = QString();
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+    quint64 takeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::array<Entry, kBufferCapacity> m_slots;
+    std::atomic<quint32> m_head { 0 };
+    std::atomic<quint32> m_tail { 0 };
+    std::atomic<quint64> m_dropped { 0 };
+};
+
+class Backend
+#if QT_CONFIG(thread)
+    : public QThread
+#endif
+{
+public:
+    Backend()
+    {
+#if QT_CONFIG(thread)
+        setObjectName(QStringLiteral("MecavivLog"));
+        start(QThread::LowPriority);
+#endif
+    }
+
+    ~Backend()
+    {
+#if QT_CONFIG(thread)
+        {
+            QMutexLocker locker(&m_wakeMutex);
+            m_stopping = true;
+            m_wake.wakeAll();
+        }
+        wait();
+#endif
+        drain();
+    }
+
+    static Backend &instance()
+    {
+        static Backend backend;
+        return backend;
+    }
+
+    void submit(Entry &&entry)
+    {
+#if QT_CONFIG(thread)
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            QMutexLocker locker(&m_buffersMutex);
+            m_buffers.push_back(buffer);
+        }
+        buffer->push(std::move(entry));
+#else
+        // Sans threads (WebAssembly) : écriture directe
+        QMutexLocker locker(&m_outputMutex);
+        output(entry);
+#endif
+    }
+
+    void drain()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            QMutexLocker locker(&m_buffersMutex);
+            buffers = m_buffers;
+        }
+
+        QMutexLocker locker(&m_outputMutex);
+        Entry entry;
+        for (const auto &buffer : buffers) {
+            while (buffer->pop(entry))
+                output(entry);
+            m_dropped += buffer->takeDropped();
+        }
+        if (m_file.isOpen())
+            m_file.flush();
+        if (m_stderr)
+            std::fflush(stderr);
+
+        // Tampons des threads terminés : plus référencés que par la liste et la copie locale.
+        // Seuls ceux de la copie sont candidats : un tampon enregistré depuis n'a que deux
+        // références (thread_local + liste) et serait retiré à tort.
+        QMutexLocker buffersLocker(&m_buffersMutex);
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                       [&buffers](const std::shared_ptr<ThreadBuffer> &buffer) {
+                                           return buffer.use_count() <= 2 && buffer->isEmpty()
+                                               && std::find(buffers.begin(), buffers.end(), buffer) != buffers.end();
+                                       }),
+                        m_buffers.end());
+    }
+
+    void setStderr(bool enabled)
+    {
+        QMutexLocker locker(&m_outputMutex);
+        m_stderr = enabled;
+    }
+
+    bool setFile(const QString &path)
+    {
+        QMutexLocker locker(&m_outputMutex);
+        if (m_file.isOpen())
+            m_file.close();
+        if (path.isEmpty())
+            return true;
+        m_file.setFileName(path);
+        return m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+    }
+
+    void setHistoryCapacity(int lines)
+    {
+        QMutexLocker locker(&m_outputMutex);
+        m_historyCapacity = qMax(0, lines);
+        while (m_history.size() > m_historyCapacity)
+            m_history.removeFirst();
+    }
+
+    QStringList recent(int count)
+    {
+        QMutexLocker locker(&m_outputMutex);
+        return count >= m_history.size() ? m_history : m_history.mid(m_history.size() - count);
+    }
+
+    quint64 dropped()
+    {
+        QMutexLocker locker(&m_outputMutex);
+        return m_dropped;
+    }
+
+#if QT_CONFIG(thread)
+protected:
+    void run() override
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        while (!m_stopping) {
+            m_wake.wait(&m_wakeMutex, kDrainInterval);
+            locker.unlock();
+            drain();
+            locker.relock();
+        }
+    }
+#endif
+
+private:
+    // Appelé sous m_outputMutex
+    void output(const Entry &entry)
+    {
+        const QString line = QStringLiteral("%1 [%2] %3: %4")
+                                 .arg(QDateTime::fromMSecsSinceEpoch(entry.timestamp).toString(Qt::ISODateWithMs),
+                                      QLatin1String(entry.category->name()),
+                                      QLatin1String(levelName(entry.level)),
+                                      entry.text);
+        if (m_stderr) {
+            const QByteArray utf8 = line.toUtf8();
+            std::fprintf(stderr, "%s\n", utf8.constData());
+        }
+        if (m_file.isOpen()) {
+            m_file.write(line.toUtf8());
+            m_file.write("\n", 1);
+        }
+        if (m_historyCapacity > 0) {
+            m_history.append(line);
+            if (m_history.size() > m_historyCapacity)
+                m_history.removeFirst();
+        }
+    }
+
+    QMutex m_buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+    QMutex m_outputMutex;
+    bool m_stderr = true;
+    QFile m_file;
+    QStringList m_history;
+    int m_historyCapacity = kDefaultHistory;
+    quint64 m_dropped = 0;
+
+#if QT_CONFIG(thread)
+    QMutex m_wakeMutex;
+    QWaitCondition m_wake;
+    bool m_stopping = false;
+#endif
+};
+
+// Registre des catégories (recherche par nom, niveaux configurés avant leur création).
+// Récursif : category() construit la catégorie sous le verrou, et le constructeur s'y inscrit
+struct Registry {
+    QRecursiveMutex mutex;
+    QHash<QString, Category *> categories;
+    QHash<QString, Level> configured;
+    bool hasDefault = false;
+    Level defaultLevel = Level::Warn;
+
+    static Registry &instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+};
+
+void flushAtExit()
+{
+    Backend::instance().drain();
+}
+
+} // namespace
+
+Category::Category(const char *name, Level defaultLevel)
+    : m_name(name)
+    , m_level(int(defaultLevel))
+{
+    Registry &registry = Registry::instance();
+    QMutexLocker locker(&registry.mutex);
+    const QString key = QString::fromLatin1(name).toUpper();
+    registry.categories.insert(key, this);
+    if (registry.configured.contains(key))
+        m_level.store(int(registry.configured.value(key)), std::memory_order_relaxed);
+    else if (registry.hasDefault)
+        m_level.store(int(registry.defaultLevel), std::memory_order_relaxed);
+}
+
+Record::Record(const Category &category, Level level)
+    : m_category(category)
+    , m_level(level)
+{
+}
+
+Record::~Record()
+{
+    // QDebug ajoute un espace après chaque élément
+    if (m_text.endsWith(QLatin1Char(' ')))
+        m_text.chop(1);
+    write(m_category, m_level, m_text);
+}
+
+Category &category(const QString &name)
+{
+    Registry &registry = Registry::instance();
+    const QString key = name.toUpper();
+    // Recherche et création sous le même verrou : deux threads ne créent pas deux fois la même catégorie
+    QMutexLocker locker(&registry.mutex);
+    if (Category *existing = registry.categories.value(key))
+        return *existing;
+    // Le nom doit survivre à la catégorie : copie volontairement jamais libérée
+    const QByteArray latin1 = key.toLatin1();
+    char *persistent = new char[latin1.size() + 1];
+    std::memcpy(persistent, latin1.constData(), size_t(latin1.size()) + 1);
+    return *new Category(persistent, Level::Info);
+}
+
+void setLevel(const QString &categoryName, Level level)
+{
+    Registry &registry = Registry::instance();
+    QMutexLocker locker(&registry.mutex);
+    if (categoryName == QLatin1String("*")) {
+        registry.hasDefault = true;
+        registry.defaultLevel = level;
+        // Une règle nommée l'emporte sur "*", quel que soit l'ordre des règles
+        for (auto it = registry.categories.cbegin(); it != registry.categories.cend(); ++it) {
+            if (!registry.configured.contains(it.key()))
+                it.value()->setLevel(level);
+        }
+        return;
+    }
+    const QString key = categoryName.toUpper();
+    registry.configured.insert(key, level);
+    if (Category *category = registry.categories.value(key))
+        category->setLevel(level);
+}
+
+bool isConfigured(const QString &categoryName)
+{
+    Registry &registry = Registry::instance();
+    QMutexLocker locker(&registry.mutex);
+    return registry.hasDefault || registry.configured.contains(categoryName.toUpper());
+}
+
+Level levelFromString(const QString &name, Level fallback)
+{
+    const QString value = name.trimmed().toLower();
+    bool isNumber = false;
+    const int number = value.toInt(&isNumber);
+    if (isNumber)
+        return Level(qBound(0, number, int(Level::Trace)));
+    if (value == QLatin1String("off") || value == QLatin1String("none"))
+        return Level::Off;
+    if (value == QLatin1String("error"))
+        return Level::Error;
+    if (value == QLatin1String("warn") || value == QLatin1String("warning"))
+        return Level::Warn;
+    if (value == QLatin1String("info"))
+        return Level::Info;
+    if (value == QLatin1String("debug"))
+        return Level::Debug;
+    if (value == QLatin1String("trace"))
+        return Level::Trace;
+    return fallback;
+}
+
+const char *levelName(Level level)
+{
+    switch (level) {
+    case Level::Off: return "OFF";
+    case Level::Error: return "ERROR";
+    case Level::Warn: return "WARN";
+    case Level::Info: return "INFO";
+    case Level::Debug: return "DEBUG";
+    case Level::Trace: return "TRACE";
+    }
+    return "?";
+}
+
+void configure(const QString &spec)
+{
+    const QStringList rules = spec.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &rule : rules) {
+        const int equal = rule.indexOf(QLatin1Char('='));
+        if (equal <= 0)
+            continue;
+        setLevel(rule.left(equal).trimmed(), levelFromString(rule.mid(equal + 1)));
+    }
+}
+
+void configureFromEnvironment()
+{
+    if (qEnvironmentVariableIsSet("MECAVIV_LOG"))
+        configure(qEnvironmentVariable("MECAVIV_LOG"));
+    if (qEnvironmentVariableIsSet("MECAVIV_LOG_FILE"))
+        setFileSink(qEnvironmentVariable("MECAVIV_LOG_FILE"));
+}
+
+void setStderrEnabled(bool enabled)
+{
+    Backend::instance().setStderr(enabled);
+}
+
+bool setFileSink(const QString &path)
+{
+    return Backend::instance().setFile(path);
+}
+
+void setHistoryCapacity(int lines)
+{
+    Backend::instance().setHistoryCapacity(lines);
+}
+
+QStringList recentLines(int count)
+{
+    Backend::instance().drain();
+    return Backend::instance().recent(count);
+}
+
+void write(const Category &category, Level level, const QString &text)
+{
+    static const bool flushRegistered = [] {
+        qAddPostRoutine(flushAtExit);
+        return true;
+    }();
+    Q_UNUSED(flushRegistered)
+
+    Entry entry;
+    entry.timestamp = QDateTime::currentMSecsSinceEpoch();
+    entry.category = &category;
+    entry.level = level;
+    entry.text = text;
+    Backend::instance().submit(std::move(entry));
+}
+
+void flush()
+{
+    Backend::instance().drain();
+}
+
+quint64 droppedCount()
+{
+    return Backend::instance().dropped();
+}
+
+}
@@ -0,0 +1,121 @@
+#ifndef MECAVIVLOG_H
+#define MECAVIVLOG_H
+
+#include <QDebug>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+
+// Journalisation structurée à faible coût, partagée par les applications Qt.
+//
+// - Filtrage à la compilation : MECAVIV_LOG_MAX_LEVEL (option CMake du même nom),
+//   les appels au-dessus de ce niveau disparaissent du binaire.
+// - Filtrage à l'exécution par catégorie : un appel désactivé coûte une lecture
+//   atomique et un branchement ; les arguments de << ne sont pas évalués.
+// - Un appel actif formate le message puis le dépose dans un tampon circulaire
+//   sans verrou propre au thread appelant ; un thread de fond vide ces tampons vers
+//   stderr, un fichier et/ou un historique mémoire. Tampon plein : le message est
+//   compté comme perdu, l'appelant n'attend jamais.
+//
+//   MECAVIV_LOG_CATEGORY(lcUdp, "UDP", MecavivLog::Level::Warn)
+//   mlogWarn(lcUdp) << "Envoi UDP échoué:" << socket->errorString();
+//
+// Configuration : variable d'environnement MECAVIV_LOG="UDP=debug,*=warn"
+// et MECAVIV_LOG_FILE=/chemin/fichier.log (voir configureFromEnvironment()).
+namespace MecavivLog {
+
+// Mêmes valeurs que Logger.qml (level_off .. level_trace)
+enum class Level : int {
+    Off = 0,
+    Error = 1,
+    Warn = 2,
+    Info = 3,
+    Debug = 4,
+    Trace = 5
+};
+
+class Category
+{
+public:
+    explicit Category(const char *name, Level defaultLevel = Level::Warn);
+    Category(const Category &) = delete;
+    Category &operator=(const Category &) = delete;
+
+    const char *name() const { return m_name; }
+    bool isEnabled(Level level) const { return int(level) <= m_level.load(std::memory_order_relaxed); }
+    Level level() const { return Level(m_level.load(std::memory_order_relaxed)); }
+    void setLevel(Level level) { m_level.store(int(level), std::memory_order_relaxed); }
+
+private:
+    const char *m_name;
+    std::atomic<int> m_level;
+};
+
+// Message en cours de construction ; déposé dans le tampon du thread à la destruction
+class Record
+{
+public:
+    Record(const Category &category, Level level);
+    ~Record();
+    Record(const Record &) = delete;
+    Record &operator=(const Record &) = delete;
+
+    // Le QDebug temporaire est détruit (et le texte complet) avant le Record
+    QDebug stream() { return QDebug(&m_text).noquote(); }
+
+private:
+    const Category &m_category;
+    Level m_level;
+    QString m_text;
+};
+
+// Catégorie créée à la demande par son nom (QML, configuration) ; jamais détruite
+Category &category(const QString &name);
+
+void setLevel(const QString &category, Level level);   // "*" : toutes sauf celles réglées par leur nom, et niveau par défaut des suivantes
+// Vrai si le niveau de la catégorie a été réglé (par son nom ou par "*"), par exemple via MECAVIV_LOG
+bool isConfigured(const QString &category);
+Level levelFromString(const QString &name, Level fallback = Level::Info);
+const char *levelName(Level level);
+
+// "UDP=debug,ROUTER=trace,*=warn"
+void configure(const QString &spec);
+// MECAVIV_LOG et MECAVIV_LOG_FILE
+void configureFromEnvironment();
+
+void setStderrEnabled(bool enabled);
+bool setFileSink(const QString &path);      // chemin vide : fermeture du fichier
+void setHistoryCapacity(int lines);
+QStringList recentLines(int count = 100);
+
+// Écrit un message déjà formaté (utilisé par l'API QML)
+void write(const Category &category, Level level, const QString &text);
+// Vide immédiatement tous les tampons (appelé aussi à la sortie de l'application)
+void flush();
+quint64 droppedCount();
+
+}
+
+#ifndef MECAVIV_LOG_MAX_LEVEL
+#define MECAVIV_LOG_MAX_LEVEL 5
+#endif
+
+#define MECAVIV_DECLARE_LOG_CATEGORY(name) MecavivLog::Category &name();
+#define MECAVIV_LOG_CATEGORY(name, categoryName, defaultLevel) \
+    MecavivLog::Category &name() \
+    { \
+        static MecavivLog::Category category(categoryName, defaultLevel); \
+        return category; \
+    }
+
+#define MECAVIV_LOG(category, level) \
+    if (!(int(level) <= MECAVIV_LOG_MAX_LEVEL && category().isEnabled(level))) {} \
+    else MecavivLog::Record(category(), level).stream()
+
+#define mlogError(category) MECAVIV_LOG(category, MecavivLog::Level::Error)
+#define mlogWarn(category) MECAVIV_LOG(category, MecavivLog::Level::Warn)
+#define mlogInfo(category) MECAVIV_LOG(category, MecavivLog::Level::Info)
+#define mlogDebug(category) MECAVIV_LOG(category, MecavivLog::Level::Debug)
+#define mlogTrace(category) MECAVIV_LOG(category, MecavivLog::Level::Trace)
+
+#endif // MECAVIVLOG_H
@@ -0,0 +1,100 @@
+#include "MemoryAccounting.h"
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <algorithm>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
+
+namespace MecavivMemory {
+
+namespace {
+
+// Inscription depuis n'importe quel thread ; les sondes sont appelées verrou tenu,
+// elles ne doivent ni créer ni détruire de Source
+QMutex &registryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+QVector<const Source *> &registry()
+{
+    static QVector<const Source *> sources;
+    return sources;
+}
+
+}
+
+Source::Source(const char *subsystem, const char *name, Probe probe, Evict evict)
+    : m_subsystem(subsystem)
+    , m_name(name)
+    , m_probe(std::move(probe))
+    , m_evict(std::move(evict))
+{
+    QMutexLocker lock(&registryMutex());
+    registry().append(this);
+}
+
+Source::~Source()
+{
+    QMutexLocker lock(&registryMutex());
+    registry().removeOne(this);
+}
+
+QVector<Entry> collect()
+{
+    QVector<Entry> entries;
+    QHash<QString, int> index;
+    QMutexLocker lock(&registryMutex());
+    for (const Source *source : std::as_const(registry())) {
+        const QString key = QLatin1String(source->subsystem()) + QLatin1Char('/') + QLatin1String(source->name());
+        auto it = index.find(key);
+        if (it == index.end()) {
+            it = index.insert(key, int(entries.size()));
+            entries.append({ QString::fromLatin1(source->subsystem()), QString::fromLatin1(source->name()), {} });
+        }
+        const Usage usage = source->probe();
+        entries[*it].usage.count += usage.count;
+        entries[*it].usage.bytes += usage.bytes;
+    }
+    lock.unlock();
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.subsystem != b.subsystem ? a.subsystem < b.subsystem : a.name < b.name;
+    });
+    return entries;
+}
+
+void evict(int pressure)
+{
+    QMutexLocker lock(&registryMutex());
+    for (const Source *source : std::as_const(registry()))
+        source->evict(pressure);
+}
+
+qint64 residentBytes()
+{
+#ifdef Q_OS_LINUX
+    // /proc/self/statm : taille totale puis pages résidentes
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * qint64(sysconf(_SC_PAGESIZE));
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, task_info_t(&info), &count) != KERN_SUCCESS)
+        return -1;
+    return qint64(info.resident_size);
+#else
+    return -1;
+#endif
+}
+
+}
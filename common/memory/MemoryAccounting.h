@@ -0,0 +1,74 @@
+#ifndef MEMORYACCOUNTING_H
+#define MEMORYACCOUNTING_H
+
+#include <QString>
+#include <QVector>
+#include <functional>
+
+// Comptabilité mémoire par sous-système, partagée par les applications des pupitres.
+//
+// Un objet C++ qui possède des tampons (réseau, anneaux, géométrie...) déclare une
+// Source en dernier membre : inscrite à la construction, retirée à la destruction.
+// La sonde n'est appelée qu'au moment d'un relevé (MemoryMonitor), sur le thread
+// principal ; entre deux relevés une Source ne coûte rien.
+//
+//   MecavivMemory::Source m_memory { "network", "NoteJitterBuffer",
+//       [this] { return MecavivMemory::Usage { 1, m_queue.capacity() * qint64(sizeof(Event)) }; },
+//       [this](int) { m_queue.squeeze(); } };
+namespace MecavivMemory {
+
+struct Usage {
+    qint64 count = 0;
+    qint64 bytes = 0;
+};
+
+// Pression mémoire transmise aux évictions : Soft au dépassement du budget (caches
+// reconstructibles, capacités inutilisées), Hard s'il persiste (historiques compris)
+enum Pressure : int {
+    Soft = 1,
+    Hard = 2
+};
+
+class Source
+{
+public:
+    using Probe = std::function<Usage()>;
+    using Evict = std::function<void(int pressure)>;
+
+    Source(const char *subsystem, const char *name, Probe probe, Evict evict = {});
+    ~Source();
+    Source(const Source &) = delete;
+    Source &operator=(const Source &) = delete;
+
+    const char *subsystem() const { return m_subsystem; }
+    const char *name() const { return m_name; }
+    Usage probe() const { return m_probe ? m_probe() : Usage {}; }
+    void evict(int pressure) const
+    {
+        if (m_evict)
+            m_evict(pressure);
+    }
+
+private:
+    const char *m_subsystem;
+    const char *m_name;
+    Probe m_probe;
+    Evict m_evict;
+};
+
+// Sources agrégées par (sous-système, nom) : count et bytes additionnés
+struct Entry {
+    QString subsystem;
+    QString name;
+    Usage usage;
+};
+
+QVector<Entry> collect();
+void evict(int pressure);
+
+// Mémoire résidente du processus (RSS), -1 si indisponible
+qint64 residentBytes();
+
+}
+
+#endif // MEMORYACCOUNTING_H
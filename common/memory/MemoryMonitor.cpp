@@ -0,0 +1,278 @@
+#include "MemoryMonitor.h"
+#include "MecavivLog.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlApplicationEngine>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifdef MECAVIV_MEMORY_QT_PRIVATE
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+#endif
+
+MECAVIV_LOG_CATEGORY(lcMemory, "MEMORY", MecavivLog::Level::Info)
+
+namespace {
+constexpr int kBudgetCheckMs = 5000;
+constexpr qint64 kEvictionCooldownMs = 30000;
+constexpr double kMiB = 1024.0 * 1024.0;
+
+QString mebibytes(qint64 bytes)
+{
+    return bytes < 0 ? QStringLiteral("n/d") : QString::number(double(bytes) / kMiB, 'f', 1);
+}
+
+// "FallingNote2D_QMLTYPE_12" → "FallingNote2D"
+QString typeName(const QObject *object)
+{
+    QString name = QString::fromLatin1(object->metaObject()->className());
+    const qsizetype suffix = name.indexOf(QLatin1String("_QML"));
+    if (suffix > 0)
+        name.truncate(suffix);
+    return name;
+}
+}
+
+MemoryMonitor *MemoryMonitor::instance()
+{
+    static MemoryMonitor monitor;
+    return &monitor;
+}
+
+MemoryMonitor::MemoryMonitor(QObject *parent)
+    : QObject(parent)
+{
+    m_uptime.start();
+    m_budgetTimer.setInterval(kBudgetCheckMs);
+    connect(&m_budgetTimer, &QTimer::timeout, this, &MemoryMonitor::checkBudget);
+    m_snapshotTimer.setInterval(m_interval);
+    connect(&m_snapshotTimer, &QTimer::timeout, this, &MemoryMonitor::periodicSnapshot);
+}
+
+void MemoryMonitor::attach(QQmlApplicationEngine *engine)
+{
+    m_engine = engine;
+    // Instance statique : les minuteries s'arrêtent avec la boucle d'événements
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        m_budgetTimer.stop();
+        m_snapshotTimer.stop();
+    }, Qt::UniqueConnection);
+}
+
+void MemoryMonitor::configureFromEnvironment()
+{
+    bool ok = false;
+    const double budget = qEnvironmentVariable("MECAVIV_MEMORY_BUDGET_MB").toDouble(&ok);
+    if (ok && budget > 0.0)
+        setBudgetMb(budget);
+    const double seconds = qEnvironmentVariable("MECAVIV_MEMORY_INTERVAL").toDouble(&ok);
+    if (ok && seconds > 0.0)
+        setInterval(int(seconds * 1000.0));
+    const QString path = qEnvironmentVariable("MECAVIV_MEMORY_SNAPSHOT");
+    if (!path.isEmpty())
+        setSnapshotPath(path);
+}
+
+void MemoryMonitor::setBudgetMb(double megabytes)
+{
+    megabytes = qMax(0.0, megabytes);
+    if (qFuzzyCompare(m_budgetMb + 1.0, megabytes + 1.0))
+        return;
+    m_budgetMb = megabytes;
+    m_pressure = 0;
+    if (m_budgetMb > 0.0) {
+        m_budgetTimer.start();
+    } else {
+        m_budgetTimer.stop();
+        if (m_overBudget) {
+            m_overBudget = false;
+            emit overBudgetChanged();
+        }
+    }
+    emit budgetMbChanged();
+}
+
+void MemoryMonitor::setInterval(int milliseconds)
+{
+    milliseconds = qMax(1000, milliseconds);
+    if (m_interval == milliseconds)
+        return;
+    m_interval = milliseconds;
+    m_snapshotTimer.setInterval(m_interval);
+    emit intervalChanged();
+}
+
+void MemoryMonitor::setSnapshotPath(const QString &path)
+{
+    if (m_snapshotPath == path)
+        return;
+    m_snapshotPath = path;
+    if (m_snapshotPath.isEmpty()) {
+        m_snapshotTimer.stop();
+    } else {
+        m_snapshotTimer.start();
+        // Relevé de référence dès que la boucle d'événements tourne
+        QTimer::singleShot(0, this, &MemoryMonitor::periodicSnapshot);
+    }
+    emit snapshotPathChanged();
+}
+
+QVariantMap MemoryMonitor::snapshot()
+{
+    m_reported.clear();
+    m_collecting = true;
+    emit collecting();
+    m_collecting = false;
+
+    QVector<MecavivMemory::Entry> entries = MecavivMemory::collect();
+    entries += m_reported;
+    m_reported.clear();
+
+    QVariantMap subsystems;
+    qint64 accounted = 0;
+    for (const MecavivMemory::Entry &entry : std::as_const(entries)) {
+        QVariantMap group = subsystems.value(entry.subsystem).toMap();
+        QVariantMap items = group.value(QStringLiteral("items")).toMap();
+        items.insert(entry.name, QVariantMap { { QStringLiteral("count"), entry.usage.count },
+                                               { QStringLiteral("bytes"), entry.usage.bytes } });
+        group.insert(QStringLiteral("items"), items);
+        group.insert(QStringLiteral("count"), group.value(QStringLiteral("count")).toLongLong() + entry.usage.count);
+        group.insert(QStringLiteral("bytes"), group.value(QStringLiteral("bytes")).toLongLong() + entry.usage.bytes);
+        subsystems.insert(entry.subsystem, group);
+        accounted += entry.usage.bytes;
+    }
+
+    QHash<QString, int> types;
+    if (m_engine) {
+        const QList<QObject *> roots = m_engine->rootObjects();
+        for (QObject *root : roots)
+            countQmlObjects(root, types);
+    }
+    QVariantMap typeCounts;
+    int objectCount = 0;
+    for (auto it = types.cbegin(); it != types.cend(); ++it) {
+        typeCounts.insert(it.key(), it.value());
+        objectCount += it.value();
+    }
+
+    m_residentBytes = MecavivMemory::residentBytes();
+    m_accountedBytes = accounted;
+    m_jsHeapBytes = measureJsHeap();
+    m_qmlObjectCount = objectCount;
+
+    QVariantMap snapshot;
+    snapshot.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
+    snapshot.insert(QStringLiteral("uptimeMs"), m_uptime.elapsed());
+    snapshot.insert(QStringLiteral("residentBytes"), m_residentBytes);
+    snapshot.insert(QStringLiteral("accountedBytes"), m_accountedBytes);
+    snapshot.insert(QStringLiteral("jsHeapBytes"), m_jsHeapBytes);
+    snapshot.insert(QStringLiteral("budgetBytes"), qint64(m_budgetMb * kMiB));
+    snapshot.insert(QStringLiteral("pressure"), m_pressure);
+    snapshot.insert(QStringLiteral("subsystems"), subsystems);
+    snapshot.insert(QStringLiteral("qmlObjects"), QVariantMap { { QStringLiteral("count"), objectCount },
+                                                                { QStringLiteral("types"), typeCounts } });
+    m_lastSnapshot = snapshot;
+    emit snapshotTaken();
+    return snapshot;
+}
+
+bool MemoryMonitor::dump(const QString &path)
+{
+    const QString target = path.isEmpty() ? m_snapshotPath : path;
+    if (target.isEmpty())
+        return false;
+    const QVariantMap current = snapshot();
+    QFile file(target);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        mlogWarn(lcMemory) << "Relevé mémoire non écrit:" << target << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject::fromVariantMap(current)).toJson(QJsonDocument::Compact) + '\n');
+    return true;
+}
+
+void MemoryMonitor::report(const QString &subsystem, const QString &name, double count, double bytes)
+{
+    if (!m_collecting) {
+        mlogDebug(lcMemory) << "report() hors relevé ignoré:" << subsystem << name;
+        return;
+    }
+    m_reported.append({ subsystem, name, { qint64(count), qint64(bytes) } });
+}
+
+void MemoryMonitor::evict(int pressure)
+{
+    const qint64 before = MecavivMemory::residentBytes();
+    m_pressure = pressure;
+    MecavivMemory::evict(pressure);
+    emit evictRequested(pressure);
+    if (m_engine)
+        m_engine->collectGarbage();
+#if defined(__GLIBC__)
+    // Rendre au système les pages libérées, sinon la mémoire résidente ne baisse pas
+    malloc_trim(0);
+#endif
+    m_sinceEviction.start();
+    mlogInfo(lcMemory) << "Éviction" << (pressure >= MecavivMemory::Hard ? "forte" : "douce") << ": résident"
+                       << mebibytes(before) << "→" << mebibytes(MecavivMemory::residentBytes()) << "Mio";
+}
+
+void MemoryMonitor::checkBudget()
+{
+    const qint64 resident = MecavivMemory::residentBytes();
+    const qint64 measured = resident >= 0 ? resident : m_accountedBytes;
+    const bool over = measured > qint64(m_budgetMb * kMiB);
+    if (over != m_overBudget) {
+        m_overBudget = over;
+        emit overBudgetChanged();
+    }
+    if (!over) {
+        m_pressure = 0;
+        return;
+    }
+    if (m_sinceEviction.isValid() && m_sinceEviction.elapsed() < kEvictionCooldownMs)
+        return;
+    // Dépassement persistant après une éviction douce : éviction forte
+    const int pressure = m_pressure >= MecavivMemory::Soft ? MecavivMemory::Hard : MecavivMemory::Soft;
+    mlogWarn(lcMemory) << "Budget mémoire dépassé:" << mebibytes(measured) << "Mio pour" << m_budgetMb << "Mio";
+    emit budgetExceeded(double(measured) / kMiB);
+    evict(pressure);
+}
+
+void MemoryMonitor::periodicSnapshot()
+{
+    if (!dump())
+        return;
+    QStringList groups;
+    const QVariantMap subsystems = m_lastSnapshot.value(QStringLiteral("subsystems")).toMap();
+    for (auto it = subsystems.cbegin(); it != subsystems.cend(); ++it) {
+        const qint64 bytes = it.value().toMap().value(QStringLiteral("bytes")).toLongLong();
+        groups.append(QStringLiteral("%1 %2 Kio").arg(it.key(), QString::number(double(bytes) / 1024.0, 'f', 0)));
+    }
+    mlogInfo(lcMemory) << "Mémoire: résident" << mebibytes(m_residentBytes) << "Mio, JS" << mebibytes(m_jsHeapBytes)
+                       << "Mio," << m_qmlObjectCount << "objets QML," << groups.join(QStringLiteral(", "));
+}
+
+qint64 MemoryMonitor::measureJsHeap() const
+{
+#ifdef MECAVIV_MEMORY_QT_PRIVATE
+    if (m_engine && m_engine->handle() && m_engine->handle()->memoryManager) {
+        QV4::MemoryManager *memory = m_engine->handle()->memoryManager;
+        return qint64(memory->getUsedMem() + memory->getLargeItemsMem());
+    }
+#endif
+    return -1;
+}
+
+void MemoryMonitor::countQmlObjects(QObject *object, QHash<QString, int> &types) const
+{
+    ++types[typeName(object)];
+    const QObjectList &children = object->children();
+    for (QObject *child : children)
+        countQmlObjects(child, types);
+}
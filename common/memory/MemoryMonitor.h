@@ -0,0 +1,113 @@
+#ifndef MEMORYMONITOR_H
+#define MEMORYMONITOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QVariantMap>
+#include <QVector>
+#include "MemoryAccounting.h"
+
+class QQmlApplicationEngine;
+
+// Relevés mémoire d'une application QML (singleton, exposé au QML) :
+// - sources C++ inscrites (MemoryAccounting.h) : réseau, anneaux, géométrie, capture ;
+// - objets QML vivants par type (arbre des objets racine du moteur) ;
+// - tas JS (en-têtes privés QtQml, sinon -1) et mémoire résidente du processus ;
+// - sources QML : à chaque relevé, collecting() est émis et les composants répondent
+//   par report() (tableaux JS, caches).
+//
+// Budget : au-delà de budgetMb (mémoire résidente), les caches sont évincés —
+// sources C++ et signal evictRequested(pressure) pour le QML — puis le ramasse-miettes
+// JS est lancé. Pression Soft au premier dépassement, Hard s'il persiste au contrôle
+// suivant ; au plus une éviction toutes les 30 s.
+//
+// Environnement : MECAVIV_MEMORY_BUDGET_MB, MECAVIV_MEMORY_SNAPSHOT=<fichier.jsonl>
+// (un relevé JSON par ligne) et MECAVIV_MEMORY_INTERVAL (secondes entre relevés, 60).
+class MemoryMonitor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double budgetMb READ budgetMb WRITE setBudgetMb NOTIFY budgetMbChanged)
+    Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged)
+    Q_PROPERTY(QString snapshotPath READ snapshotPath WRITE setSnapshotPath NOTIFY snapshotPathChanged)
+    Q_PROPERTY(double residentBytes READ residentBytes NOTIFY snapshotTaken)
+    Q_PROPERTY(double accountedBytes READ accountedBytes NOTIFY snapshotTaken)
+    Q_PROPERTY(double jsHeapBytes READ jsHeapBytes NOTIFY snapshotTaken)
+    Q_PROPERTY(int qmlObjectCount READ qmlObjectCount NOTIFY snapshotTaken)
+    Q_PROPERTY(bool overBudget READ isOverBudget NOTIFY overBudgetChanged)
+    Q_PROPERTY(QVariantMap lastSnapshot READ lastSnapshot NOTIFY snapshotTaken)
+
+public:
+    static MemoryMonitor *instance();
+
+    // Moteur dont les objets QML et le tas JS sont relevés
+    void attach(QQmlApplicationEngine *engine);
+    void configureFromEnvironment();
+
+    double budgetMb() const { return m_budgetMb; }
+    void setBudgetMb(double megabytes);
+    int interval() const { return m_interval; }
+    void setInterval(int milliseconds);
+    QString snapshotPath() const { return m_snapshotPath; }
+    void setSnapshotPath(const QString &path);
+
+    double residentBytes() const { return double(m_residentBytes); }
+    double accountedBytes() const { return double(m_accountedBytes); }
+    double jsHeapBytes() const { return double(m_jsHeapBytes); }
+    int qmlObjectCount() const { return m_qmlObjectCount; }
+    bool isOverBudget() const { return m_overBudget; }
+    QVariantMap lastSnapshot() const { return m_lastSnapshot; }
+
+    // Relevé complet (émet collecting() puis snapshotTaken())
+    Q_INVOKABLE QVariantMap snapshot();
+    // Ajoute le relevé courant au fichier (snapshotPath si vide) ; false en cas d'échec
+    Q_INVOKABLE bool dump(const QString &path = QString());
+    // Pendant collecting() : contribution d'un composant QML
+    Q_INVOKABLE void report(const QString &subsystem, const QString &name, double count, double bytes);
+    Q_INVOKABLE void evict(int pressure);
+
+signals:
+    void budgetMbChanged();
+    void intervalChanged();
+    void snapshotPathChanged();
+    void overBudgetChanged();
+    void collecting();
+    void snapshotTaken();
+    void evictRequested(int pressure);
+    void budgetExceeded(double residentMb);
+
+private:
+    explicit MemoryMonitor(QObject *parent = nullptr);
+
+    void checkBudget();
+    void periodicSnapshot();
+    qint64 measureJsHeap() const;
+    void countQmlObjects(QObject *object, QHash<QString, int> &types) const;
+
+    QPointer<QQmlApplicationEngine> m_engine;
+    QTimer m_budgetTimer;
+    QTimer m_snapshotTimer;
+    QElapsedTimer m_uptime;
+    QElapsedTimer m_sinceEviction;
+
+    double m_budgetMb = 0.0;
+    int m_interval = 60000;
+    QString m_snapshotPath;
+
+    qint64 m_residentBytes = -1;
+    qint64 m_accountedBytes = 0;
+    qint64 m_jsHeapBytes = -1;
+    int m_qmlObjectCount = 0;
+    bool m_overBudget = false;
+    int m_pressure = 0;
+    QVariantMap m_lastSnapshot;
+
+    // Contributions QML du relevé en cours
+    QVector<MecavivMemory::Entry> m_reported;
+    bool m_collecting = false;
+};
+
+#endif // MEMORYMONITOR_H
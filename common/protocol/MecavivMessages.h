@@ -0,0 +1,596 @@
+#ifndef MECAVIVMESSAGES_H
+#define MECAVIVMESSAGES_H
+
+#include "MecavivSchema.h"
+#include <cstring>
+
+// Définition unique des trames binaires échangées entre PureData, les pupitres,
+// la console et les machines UDP. Chaque trame a ses champs (types de
+// MecavivSchema.h), un décodeur qui valide taille / type / checksum et un
+// encodeur qui écrit dans un buffer fourni par l'appelant.
+//
+// Références : SirenePupitre/STRUCTURE_BINAIRE_0x02.md, docs/COMMUNICATION.md,
+// SirenConsole/webfiles/puredata-proxy.js (VOLANT_STATE, en-tête de chunk).
+namespace MecavivProtocol {
+
+namespace FrameType {
+constexpr std::uint8_t Position = 0x01;
+constexpr std::uint8_t Controllers = 0x02;
+constexpr std::uint8_t WheelNote = 0x03;
+constexpr std::uint8_t SequenceNote = 0x04;
+constexpr std::uint8_t ControlChange = 0x05;
+}
+
+// ============================================================================
+// Paquet de commande UDP des machines (SirenManager → sirènes / maître)
+// [10][BCC][0][cmd][data0..data5], BCC = XOR des octets 3 à 9
+// ============================================================================
+struct CommandPacket {
+    static constexpr std::size_t Size = 10;
+    static constexpr std::size_t MaxData = 6;
+
+    using Length = Field<std::uint8_t, 0>;
+    using Bcc = Field<std::uint8_t, 1>;
+    using Reserved = Field<std::uint8_t, 2>;
+    using Command = Field<std::uint8_t, 3>;
+    static constexpr std::size_t DataOffset = Command::end;
+
+    std::uint8_t command = 0;
+    std::uint8_t data[MaxData] = {};
+
+    static constexpr std::uint8_t checksum(const std::uint8_t *bytes)
+    {
+        std::uint8_t bcc = 0;
+        for (std::size_t i = Command::offset; i < Size; ++i)
+            bcc ^= bytes[i];
+        return bcc;
+    }
+
+    // Commande + données (au plus MaxData octets, le surplus est ignoré) ; retourne Size
+    static constexpr std::size_t encode(std::uint8_t *out, std::uint8_t command,
+                                        const std::uint8_t *data, std::size_t dataSize)
+    {
+        for (std::size_t i = 0; i < Size; ++i)
+            out[i] = 0;
+        Command::write(out, command);
+        for (std::size_t i = 0; i < dataSize && i < MaxData; ++i)
+            out[DataOffset + i] = data[i];
+        Length::write(out, std::uint8_t(Size));
+        Bcc::write(out, checksum(out));
+        return Size;
+    }
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        return encode(out, command, data, MaxData);
+    }
+
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, CommandPacket &out)
+    {
+        if (size < Size)
+            return Status::TooShort;
+        if (size != Size || Length::read(bytes) != Size)
+            return Status::BadLength;
+        if (Bcc::read(bytes) != checksum(bytes))
+            return Status::BadChecksum;
+        out.command = Command::read(bytes);
+        for (std::size_t i = 0; i < MaxData; ++i)
+            out.data[i] = bytes[DataOffset + i];
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// 0x02 CONTROLLERS (18 octets) : contrôleurs physiques du pupitre
+// ============================================================================
+struct ControllersFrame {
+    static constexpr std::size_t Size = 18;
+
+    using Type = Field<std::uint8_t, 0>;
+    using WheelPosition = Field<std::uint16_t, 1>;   // degrés 0-360
+    using Pad1Aftertouch = Field<std::uint8_t, 3>;
+    using Pad1Velocity = Field<std::uint8_t, 4>;
+    using Pad2Aftertouch = Field<std::uint8_t, 5>;
+    using Pad2Velocity = Field<std::uint8_t, 6>;
+    using JoystickX = FoldedSignedField<7>;
+    using JoystickY = FoldedSignedField<8>;
+    using JoystickZ = FoldedSignedField<9>;
+    using JoystickButton = FlagField<10>;
+    using Selector = Field<std::uint8_t, 11>;         // 0-4
+    using Fader = Field<std::uint8_t, 12>;
+    using Pedal = Field<std::uint8_t, 13>;
+    using Button1 = FlagField<14>;
+    using Button2 = FlagField<15>;
+    using EncoderValue = Field<std::uint8_t, 16>;
+    using EncoderPressed = FlagField<17>;
+
+    std::uint16_t wheelPosition = 0;
+    std::uint8_t pad1Aftertouch = 0;
+    std::uint8_t pad1Velocity = 0;
+    std::uint8_t pad2Aftertouch = 0;
+    std::uint8_t pad2Velocity = 0;
+    int joystickX = 0;
+    int joystickY = 0;
+    int joystickZ = 0;
+    bool joystickButton = false;
+    std::uint8_t selector = 0;
+    std::uint8_t fader = 0;
+    std::uint8_t pedal = 0;
+    bool button1 = false;
+    bool button2 = false;
+    std::uint8_t encoderValue = 0;
+    bool encoderPressed = false;
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        Type::write(out, FrameType::Controllers);
+        WheelPosition::write(out, wheelPosition);
+        Pad1Aftertouch::write(out, pad1Aftertouch);
+        Pad1Velocity::write(out, pad1Velocity);
+        Pad2Aftertouch::write(out, pad2Aftertouch);
+        Pad2Velocity::write(out, pad2Velocity);
+        JoystickX::write(out, joystickX);
+        JoystickY::write(out, joystickY);
+        JoystickZ::write(out, joystickZ);
+        JoystickButton::write(out, joystickButton);
+        Selector::write(out, selector);
+        Fader::write(out, fader);
+        Pedal::write(out, pedal);
+        Button1::write(out, button1);
+        Button2::write(out, button2);
+        EncoderValue::write(out, encoderValue);
+        EncoderPressed::write(out, encoderPressed);
+        return Size;
+    }
+
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, ControllersFrame &out)
+    {
+        if (size < Size)
+            return Status::TooShort;
+        if (size != Size)
+            return Status::BadLength;
+        if (Type::read(bytes) != FrameType::Controllers)
+            return Status::BadType;
+        out.wheelPosition = WheelPosition::read(bytes);
+        out.pad1Aftertouch = Pad1Aftertouch::read(bytes);
+        out.pad1Velocity = Pad1Velocity::read(bytes);
+        out.pad2Aftertouch = Pad2Aftertouch::read(bytes);
+        out.pad2Velocity = Pad2Velocity::read(bytes);
+        out.joystickX = JoystickX::read(bytes);
+        out.joystickY = JoystickY::read(bytes);
+        out.joystickZ = JoystickZ::read(bytes);
+        out.joystickButton = JoystickButton::read(bytes);
+        out.selector = Selector::read(bytes);
+        out.fader = Fader::read(bytes);
+        out.pedal = Pedal::read(bytes);
+        out.button1 = Button1::read(bytes);
+        out.button2 = Button2::read(bytes);
+        out.encoderValue = EncoderValue::read(bytes);
+        out.encoderPressed = EncoderPressed::read(bytes);
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// 0x03 note du volant / 0x04 note de séquence : 5 octets, ou 9 avec l'heure
+// d'envoi (uint32 LE, ms sur l'horloge de l'émetteur)
+// [type][note][vélocité][valeur LSB][valeur MSB]([t0][t1][t2][t3])
+// valeur = bend 14 bits (0x03, centré 8192) ou durée en ms uint16 LE (0x04)
+// ============================================================================
+struct NoteFrame {
+    static constexpr std::size_t ShortSize = 5;
+    static constexpr std::size_t StampedSize = 9;
+
+    using Type = Field<std::uint8_t, 0>;
+    using Note = Field<std::uint8_t, 1>;
+    using Velocity = Field<std::uint8_t, 2>;
+    using Bend = Midi14Field<3>;
+    using Duration = Field<std::uint16_t, 3>;
+    using SentTime = Field<std::uint32_t, 5>;
+
+    std::uint8_t type = FrameType::WheelNote;
+    std::uint8_t note = 0;
+    std::uint8_t velocity = 0;
+    std::uint16_t value = 0;
+    bool stamped = false;
+    std::uint32_t sentTime = 0;
+
+    constexpr bool isWheel() const { return type == FrameType::WheelNote; }
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        Type::write(out, type);
+        Note::write(out, note);
+        Velocity::write(out, velocity);
+        if (isWheel())
+            Bend::write(out, value);
+        else
+            Duration::write(out, value);
+        if (!stamped)
+            return ShortSize;
+        SentTime::write(out, sentTime);
+        return StampedSize;
+    }
+
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, NoteFrame &out)
+    {
+        if (size < ShortSize)
+            return Status::TooShort;
+        if (size != ShortSize && size != StampedSize)
+            return Status::BadLength;
+        const std::uint8_t type = Type::read(bytes);
+        if (type != FrameType::WheelNote && type != FrameType::SequenceNote)
+            return Status::BadType;
+        // Variante horodatée : données MIDI sur 7 bits, écarte les trames d'autres formats de même taille
+        if (size == StampedSize && ((bytes[Note::offset] | bytes[Velocity::offset]) & 0x80))
+            return Status::OutOfRange;
+        out.type = type;
+        out.note = Note::read(bytes);
+        out.velocity = Velocity::read(bytes);
+        out.value = type == FrameType::WheelNote ? Bend::read(bytes) : Duration::read(bytes);
+        out.stamped = size == StampedSize;
+        out.sentTime = out.stamped ? SentTime::read(bytes) : 0;
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// 0x01 POSITION (PureData → pupitre), trois variantes selon la taille :
+//  4 octets : [0x01][flags][mesure u16 LE]                 (mesure 0-based)
+//  6 octets : [0x01][flags][tick u32 LE]
+//  9 octets : [0x01][flags][mesure u16 LE][temps][beat float32 LE]   (ancien format)
+// flags bit 0 = lecture en cours
+// ============================================================================
+struct PositionFrame {
+    enum class Variant : std::uint8_t {
+        Measure,
+        Tick,
+        Legacy
+    };
+    static constexpr std::size_t MeasureSize = 4;
+    static constexpr std::size_t TickSize = 6;
+    static constexpr std::size_t LegacySize = 9;
+
+    using Type = Field<std::uint8_t, 0>;
+    using Flags = Field<std::uint8_t, 1>;
+    using Measure = Field<std::uint16_t, 2>;
+    using Tick = Field<std::uint32_t, 2>;
+    using BeatInBar = Field<std::uint8_t, 4>;
+    using BeatBits = Field<std::uint32_t, 5>;
+
+    Variant variant = Variant::Tick;
+    bool playing = false;
+    std::uint16_t measure = 0;
+    std::uint32_t tick = 0;
+    std::uint8_t beatInBar = 0;
+    std::uint32_t beatBits = 0;    // float32 brut, voir beat()
+
+    float beat() const
+    {
+        float value;
+        static_assert(sizeof(value) == sizeof(beatBits), "float32 IEEE 754");
+        std::memcpy(&value, &beatBits, sizeof(value));
+        return value;
+    }
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        Type::write(out, FrameType::Position);
+        Flags::write(out, playing ? 0x01 : 0x00);
+        switch (variant) {
+        case Variant::Measure:
+            Measure::write(out, measure);
+            return MeasureSize;
+        case Variant::Tick:
+            Tick::write(out, tick);
+            return TickSize;
+        case Variant::Legacy:
+            Measure::write(out, measure);
+            BeatInBar::write(out, beatInBar);
+            BeatBits::write(out, beatBits);
+            return LegacySize;
+        }
+        return 0;
+    }
+
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, PositionFrame &out)
+    {
+        if (size < MeasureSize)
+            return Status::TooShort;
+        if (size != MeasureSize && size != TickSize && size != LegacySize)
+            return Status::BadLength;
+        if (Type::read(bytes) != FrameType::Position)
+            return Status::BadType;
+        out.playing = (Flags::read(bytes) & 0x01) != 0;
+        if (size == TickSize) {
+            out.variant = Variant::Tick;
+            out.tick = Tick::read(bytes);
+            return Status::Ok;
+        }
+        out.measure = Measure::read(bytes);
+        if (size == MeasureSize) {
+            out.variant = Variant::Measure;
+            return Status::Ok;
+        }
+        out.variant = Variant::Legacy;
+        out.beatInBar = BeatInBar::read(bytes);
+        out.beatBits = BeatBits::read(bytes);
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// 0x05 CONTROL CHANGE (3 octets) : [0x05][numéro CC][valeur 0-127]
+// ============================================================================
+struct ControlChangeFrame {
+    static constexpr std::size_t Size = 3;
+
+    using Type = Field<std::uint8_t, 0>;
+    using Number = Field<std::uint8_t, 1>;
+    using Value = Field<std::uint8_t, 2>;
+
+    std::uint8_t number = 0;
+    std::uint8_t value = 0;
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        Type::write(out, FrameType::ControlChange);
+        Number::write(out, number);
+        Value::write(out, value);
+        return Size;
+    }
+
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, ControlChangeFrame &out)
+    {
+        if (size < Size)
+            return Status::TooShort;
+        if (size != Size)
+            return Status::BadLength;
+        if (Type::read(bytes) != FrameType::ControlChange)
+            return Status::BadType;
+        if ((bytes[Number::offset] | bytes[Value::offset]) & 0x80)
+            return Status::OutOfRange;
+        out.number = Number::read(bytes);
+        out.value = Value::read(bytes);
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// VOLANT_STATE (PureData → console, 7 octets) :
+// ['S']['S'][0x01][note][vélocité][pitchbend u16 BE]
+// ============================================================================
+struct VolantStateFrame {
+    static constexpr std::size_t Size = 7;
+    static constexpr std::uint8_t Magic = 0x53;   // 'S'
+    static constexpr std::uint8_t StateType = 0x01;
+
+    using Magic1 = Field<std::uint8_t, 0>;
+    using Magic2 = Field<std::uint8_t, 1>;
+    using Type = Field<std::uint8_t, 2>;
+    using Note = Field<std::uint8_t, 3>;
+    using Velocity = Field<std::uint8_t, 4>;
+    using Pitchbend = Field<std::uint16_t, 5, Endian::Big>;
+
+    std::uint8_t type = StateType;
+    std::uint8_t note = 0;
+    std::uint8_t velocity = 0;
+    std::uint16_t pitchbend = 8192;
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        Magic1::write(out, Magic);
+        Magic2::write(out, Magic);
+        Type::write(out, type);
+        Note::write(out, note);
+        Velocity::write(out, velocity);
+        Pitchbend::write(out, pitchbend);
+        return Size;
+    }
+
+    static constexpr bool matches(const std::uint8_t *bytes, std::size_t size)
+    {
+        return size == Size && Magic1::read(bytes) == Magic && Magic2::read(bytes) == Magic;
+    }
+
+    // Seul le type 0x01 est défini ; les autres types restent décodés, à l'appelant de les ignorer
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, VolantStateFrame &out)
+    {
+        if (size < Size)
+            return Status::TooShort;
+        if (size != Size)
+            return Status::BadLength;
+        if (!matches(bytes, size))
+            return Status::BadMagic;
+        out.type = Type::read(bytes);
+        out.note = Note::read(bytes);
+        out.velocity = Velocity::read(bytes);
+        out.pitchbend = Pitchbend::read(bytes);
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// En-tête des chunks de message long (config JSON/CBOR) : 8 octets LE
+// [taille totale u32][position u32] puis les octets du morceau
+// ============================================================================
+struct ChunkHeader {
+    static constexpr std::size_t Size = 8;
+
+    using TotalSize = Field<std::uint32_t, 0>;
+    using Position = Field<std::uint32_t, 4>;
+
+    std::uint32_t totalSize = 0;
+    std::uint32_t position = 0;
+
+    constexpr std::size_t encode(std::uint8_t *out) const
+    {
+        TotalSize::write(out, totalSize);
+        Position::write(out, position);
+        return Size;
+    }
+
+    // size = taille du chunk complet (en-tête + données) ; maxTotalSize borne l'allocation du receveur
+    static constexpr Status decode(const std::uint8_t *bytes, std::size_t size, ChunkHeader &out,
+                                   std::uint32_t maxTotalSize = 0xFFFFFFFFu)
+    {
+        if (size < Size)
+            return Status::TooShort;
+        const std::uint32_t total = TotalSize::read(bytes);
+        const std::uint32_t position = Position::read(bytes);
+        const std::uint64_t dataLength = size - Size;
+        if (total == 0 || total > maxTotalSize || position >= total
+            || std::uint64_t(position) + dataLength > total) {
+            return Status::OutOfRange;
+        }
+        out.totalSize = total;
+        out.position = position;
+        return Status::Ok;
+    }
+};
+
+// ============================================================================
+// Vérifications à la compilation : les schémas couvrent exactement leur taille
+// et chaque trame survit à un aller-retour encodage → décodage.
+// ============================================================================
+namespace Checks {
+
+static_assert(schemaEnd<CommandPacket::Length, CommandPacket::Bcc, CommandPacket::Reserved,
+                        CommandPacket::Command>() + CommandPacket::MaxData == CommandPacket::Size,
+              "paquet de commande : 10 octets");
+static_assert(schemaContiguous<ControllersFrame::Type, ControllersFrame::WheelPosition,
+                               ControllersFrame::Pad1Aftertouch, ControllersFrame::Pad1Velocity,
+                               ControllersFrame::Pad2Aftertouch, ControllersFrame::Pad2Velocity,
+                               ControllersFrame::JoystickX, ControllersFrame::JoystickY,
+                               ControllersFrame::JoystickZ, ControllersFrame::JoystickButton,
+                               ControllersFrame::Selector, ControllersFrame::Fader,
+                               ControllersFrame::Pedal, ControllersFrame::Button1,
+                               ControllersFrame::Button2, ControllersFrame::EncoderValue,
+                               ControllersFrame::EncoderPressed>()
+              && ControllersFrame::EncoderPressed::end == ControllersFrame::Size,
+              "0x02 : 18 octets contigus");
+static_assert(NoteFrame::SentTime::end == NoteFrame::StampedSize, "note horodatée : 9 octets");
+static_assert(PositionFrame::BeatBits::end == PositionFrame::LegacySize, "position : 9 octets");
+static_assert(VolantStateFrame::Pitchbend::end == VolantStateFrame::Size, "VOLANT_STATE : 7 octets");
+static_assert(ChunkHeader::Position::end == ChunkHeader::Size, "en-tête de chunk : 8 octets");
+
+// Repli du signe du joystick : -(octet - 128), et non octet - 255
+static_assert(FoldedSignedField<0>::decode(0) == 0 && FoldedSignedField<0>::decode(127) == 127
+              && FoldedSignedField<0>::decode(128) == 0 && FoldedSignedField<0>::decode(129) == -1
+              && FoldedSignedField<0>::decode(255) == -127, "joystick : 128-255 = -0..-127");
+
+constexpr bool foldedRoundTrip()
+{
+    for (int value = -127; value <= 127; ++value) {
+        if (FoldedSignedField<0>::decode(FoldedSignedField<0>::encode(value)) != value)
+            return false;
+    }
+    return true;
+}
+static_assert(foldedRoundTrip(), "joystick : aller-retour -127..127");
+
+constexpr bool commandRoundTrip()
+{
+    // VOLUME (0x0F) 100 : BCC = 0x0F ^ 0x64
+    const std::uint8_t data[1] = { 100 };
+    std::uint8_t bytes[CommandPacket::Size] = {};
+    CommandPacket::encode(bytes, 0x0F, data, 1);
+    CommandPacket decoded;
+    if (CommandPacket::decode(bytes, CommandPacket::Size, decoded) != Status::Ok)
+        return false;
+    if (bytes[0] != 10 || bytes[1] != (0x0F ^ 100) || bytes[2] != 0)
+        return false;
+    // Un octet altéré doit être refusé par le BCC
+    bytes[5] ^= 0x10;
+    return decoded.command == 0x0F && decoded.data[0] == 100
+        && CommandPacket::decode(bytes, CommandPacket::Size, decoded) == Status::BadChecksum;
+}
+static_assert(commandRoundTrip(), "paquet de commande : aller-retour et BCC");
+
+constexpr bool controllersRoundTrip()
+{
+    ControllersFrame frame;
+    frame.wheelPosition = 300;
+    frame.pad1Velocity = 100;
+    frame.joystickX = -64;
+    frame.joystickY = 127;
+    frame.joystickZ = -127;
+    frame.joystickButton = true;
+    frame.selector = 4;
+    frame.fader = 64;
+    frame.encoderPressed = true;
+    std::uint8_t bytes[ControllersFrame::Size] = {};
+    ControllersFrame decoded;
+    return frame.encode(bytes) == ControllersFrame::Size
+        && bytes[1] == 0x2C && bytes[2] == 0x01 && bytes[7] == 192
+        && ControllersFrame::decode(bytes, sizeof(bytes), decoded) == Status::Ok
+        && decoded.wheelPosition == 300 && decoded.pad1Velocity == 100
+        && decoded.joystickX == -64 && decoded.joystickY == 127 && decoded.joystickZ == -127
+        && decoded.joystickButton && decoded.selector == 4 && decoded.fader == 64
+        && !decoded.button1 && decoded.encoderPressed
+        && ControllersFrame::decode(bytes, ControllersFrame::Size - 1, decoded) == Status::TooShort;
+}
+static_assert(controllersRoundTrip(), "0x02 : aller-retour");
+
+constexpr bool noteRoundTrip()
+{
+    NoteFrame wheel;
+    wheel.note = 69;
+    wheel.velocity = 100;
+    wheel.value = 12000;
+    wheel.stamped = true;
+    wheel.sentTime = 0xDEADBEEF;
+    NoteFrame sequence;
+    sequence.type = FrameType::SequenceNote;
+    sequence.note = 60;
+    sequence.velocity = 90;
+    sequence.value = 1500;
+    std::uint8_t bytes[NoteFrame::StampedSize] = {};
+    NoteFrame decoded;
+    if (wheel.encode(bytes) != NoteFrame::StampedSize
+        || NoteFrame::decode(bytes, NoteFrame::StampedSize, decoded) != Status::Ok
+        || !decoded.isWheel() || decoded.value != 12000 || decoded.sentTime != 0xDEADBEEF) {
+        return false;
+    }
+    return sequence.encode(bytes) == NoteFrame::ShortSize
+        && NoteFrame::decode(bytes, NoteFrame::ShortSize, decoded) == Status::Ok
+        && !decoded.isWheel() && !decoded.stamped && decoded.value == 1500
+        && NoteFrame::decode(bytes, 7, decoded) == Status::BadLength;
+}
+static_assert(noteRoundTrip(), "0x03/0x04 : aller-retour");
+
+constexpr bool volantRoundTrip()
+{
+    VolantStateFrame state;
+    state.note = 72;
+    state.velocity = 127;
+    state.pitchbend = 0x1234;
+    std::uint8_t bytes[VolantStateFrame::Size] = {};
+    VolantStateFrame decoded;
+    return state.encode(bytes) == VolantStateFrame::Size
+        && bytes[0] == 'S' && bytes[5] == 0x12 && bytes[6] == 0x34
+        && VolantStateFrame::decode(bytes, sizeof(bytes), decoded) == Status::Ok
+        && decoded.note == 72 && decoded.pitchbend == 0x1234;
+}
+static_assert(volantRoundTrip(), "VOLANT_STATE : aller-retour (pitchbend big-endian)");
+
+constexpr bool chunkRoundTrip()
+{
+    ChunkHeader header;
+    header.totalSize = 1000;
+    header.position = 900;
+    std::uint8_t bytes[ChunkHeader::Size] = {};
+    ChunkHeader decoded;
+    header.encode(bytes);
+    return ChunkHeader::decode(bytes, ChunkHeader::Size + 100, decoded) == Status::Ok
+        && decoded.totalSize == 1000 && decoded.position == 900
+        && ChunkHeader::decode(bytes, ChunkHeader::Size + 101, decoded) == Status::OutOfRange
+        && ChunkHeader::decode(bytes, ChunkHeader::Size + 100, decoded, 999) == Status::OutOfRange;
+}
+static_assert(chunkRoundTrip(), "en-tête de chunk : aller-retour et bornes");
+
+} // namespace Checks
+
+} // namespace MecavivProtocol
+
+#endif // MECAVIVMESSAGES_H
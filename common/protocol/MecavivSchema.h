@@ -0,0 +1,166 @@
+#ifndef MECAVIVSCHEMA_H
+#define MECAVIVSCHEMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Schéma binaire à la compilation : chaque champ d'une trame est un type qui porte
+// son décalage, sa largeur et son codage. Lecture et écriture se font directement
+// dans le buffer de l'appelant (aucune allocation), et tout est constexpr pour que
+// les tailles et les allers-retours soient vérifiés par le compilateur.
+//
+//   using Wheel = MecavivProtocol::Field<std::uint16_t, 1>;   // uint16 LE aux octets 1-2
+//   const std::uint16_t degrees = Wheel::read(bytes);
+//
+// Aucune dépendance Qt : le même en-tête sert aux quatre applications.
+namespace MecavivProtocol {
+
+enum class Endian {
+    Little,
+    Big
+};
+
+// Résultat de décodage, commun à toutes les trames
+enum class Status {
+    Ok,
+    TooShort,       // moins d'octets que le format minimal
+    BadLength,      // taille ne correspondant à aucune variante du format
+    BadType,        // octet de type inattendu
+    BadMagic,       // signature absente (VOLANT_STATE)
+    BadChecksum,    // BCC incorrect
+    OutOfRange      // champ hors de sa plage (données MIDI > 127, position > taille, ...)
+};
+
+constexpr const char *statusName(Status status)
+{
+    switch (status) {
+    case Status::Ok: return "ok";
+    case Status::TooShort: return "trop court";
+    case Status::BadLength: return "taille invalide";
+    case Status::BadType: return "type invalide";
+    case Status::BadMagic: return "signature invalide";
+    case Status::BadChecksum: return "BCC invalide";
+    case Status::OutOfRange: return "valeur hors plage";
+    }
+    return "?";
+}
+
+// Entier non signé de 1, 2, 4 ou 8 octets à un décalage fixe
+template <typename T, std::size_t Offset, Endian E = Endian::Little>
+struct Field {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value, "champ entier non signé");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "largeur 8, 16, 32 ou 64 bits");
+
+    using Type = T;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = sizeof(T);
+    static constexpr std::size_t end = Offset + sizeof(T);
+
+    static constexpr T read(const std::uint8_t *bytes)
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::size_t shift = E == Endian::Little ? i : size - 1 - i;
+            value |= std::uint64_t(bytes[Offset + i]) << (8 * shift);
+        }
+        return T(value);
+    }
+
+    static constexpr void write(std::uint8_t *bytes, T value)
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::size_t shift = E == Endian::Little ? i : size - 1 - i;
+            bytes[Offset + i] = std::uint8_t(std::uint64_t(value) >> (8 * shift));
+        }
+    }
+};
+
+// Valeur 14 bits MIDI sur deux octets de 7 bits (LSB puis MSB) : pitch bend des notes 0x03
+template <std::size_t Offset>
+struct Midi14Field {
+    using Type = std::uint16_t;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = 2;
+    static constexpr std::size_t end = Offset + 2;
+
+    static constexpr std::uint16_t read(const std::uint8_t *bytes)
+    {
+        return std::uint16_t((bytes[Offset] & 0x7F) | ((bytes[Offset + 1] & 0x7F) << 7));
+    }
+
+    static constexpr void write(std::uint8_t *bytes, std::uint16_t value)
+    {
+        bytes[Offset] = std::uint8_t(value & 0x7F);
+        bytes[Offset + 1] = std::uint8_t((value >> 7) & 0x7F);
+    }
+
+    static constexpr bool valid(const std::uint8_t *bytes)
+    {
+        return ((bytes[Offset] | bytes[Offset + 1]) & 0x80) == 0;
+    }
+};
+
+// Octet signé « replié » des axes joystick (STRUCTURE_BINAIRE_0x02.md) :
+// 0-127 → +0..+127, 128-255 → -0..-127. Le -0 (128) se relit 0.
+template <std::size_t Offset>
+struct FoldedSignedField {
+    using Type = int;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = 1;
+    static constexpr std::size_t end = Offset + 1;
+
+    static constexpr int decode(std::uint8_t raw)
+    {
+        return raw <= 127 ? int(raw) : -(int(raw) - 128);
+    }
+
+    static constexpr std::uint8_t encode(int value)
+    {
+        return value >= 0 ? std::uint8_t(value > 127 ? 127 : value)
+                          : std::uint8_t(128 + (value < -127 ? 127 : -value));
+    }
+
+    static constexpr int read(const std::uint8_t *bytes) { return decode(bytes[Offset]); }
+    static constexpr void write(std::uint8_t *bytes, int value) { bytes[Offset] = encode(value); }
+};
+
+// Booléen sur un octet (>0 = vrai), écrit 0/1
+template <std::size_t Offset>
+struct FlagField {
+    using Type = bool;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = 1;
+    static constexpr std::size_t end = Offset + 1;
+
+    static constexpr bool read(const std::uint8_t *bytes) { return bytes[Offset] != 0; }
+    static constexpr void write(std::uint8_t *bytes, bool value) { bytes[Offset] = value ? 1 : 0; }
+};
+
+// Fin du dernier champ d'une liste : sert à vérifier qu'un format couvre exactement sa taille
+template <typename... Fields>
+constexpr std::size_t schemaEnd()
+{
+    std::size_t end = 0;
+    const std::size_t ends[] = { 0, Fields::end... };
+    for (std::size_t value : ends)
+        end = value > end ? value : end;
+    return end;
+}
+
+// Vrai si les champs se suivent sans recouvrement (dans l'ordre de déclaration)
+template <typename... Fields>
+constexpr bool schemaContiguous()
+{
+    const std::size_t offsets[] = { Fields::offset... };
+    const std::size_t ends[] = { Fields::end... };
+    for (std::size_t i = 1; i < sizeof...(Fields); ++i) {
+        if (offsets[i] != ends[i - 1])
+            return false;
+    }
+    return true;
+}
+
+} // namespace MecavivProtocol
+
+#endif // MECAVIVSCHEMA_H
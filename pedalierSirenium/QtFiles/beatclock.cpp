@@ -0,0 +1,219 @@
+#include "beatclock.h"
+#include <QtMath>
+
+namespace {
+// Au-delà de ce nombre de mesures sans message clock, l'horloge se fige
+constexpr double kWatchdogBars = 2.0;
+}
+
+BeatClock::BeatClock(QObject *parent)
+    : QObject(parent)
+    , m_bpm(120.0)
+    , m_beatsPerBar(4)
+    , m_running(false)
+    , m_anchorBeats(0.0)
+    , m_anchorMs(0)
+    , m_lastBeat(0)
+    , m_loops(MaxSirens + 1)
+{
+    m_elapsed.start();
+    for (int i = 0; i < MaxSirens; ++i)
+        m_loopPhases.append(0.0);
+
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    m_frameTimer.setInterval(16);  // ~60 FPS, un seul timer pour toutes les sirènes
+    connect(&m_frameTimer, &QTimer::timeout, this, &BeatClock::onFrame);
+}
+
+void BeatClock::setBpm(double bpm)
+{
+    if (bpm <= 0.0 || qFuzzyCompare(m_bpm, bpm))
+        return;
+    // Changement de tempo en O(1) : on fige la position actuelle puis on repart
+    // du même point avec la nouvelle pente. Les boucles, ancrées en beats, suivent.
+    reanchor(currentBeats());
+    m_bpm = bpm;
+    emit bpmChanged();
+}
+
+void BeatClock::setBeatsPerBar(int beats)
+{
+    beats = qMax(1, beats);
+    if (m_beatsPerBar == beats)
+        return;
+    m_beatsPerBar = beats;
+    emit beatsPerBarChanged();
+}
+
+void BeatClock::setFrameInterval(int ms)
+{
+    ms = qMax(1, ms);
+    if (m_frameTimer.interval() == ms)
+        return;
+    m_frameTimer.setInterval(ms);
+    emit frameIntervalChanged();
+}
+
+double BeatClock::currentBeats() const
+{
+    if (!m_running)
+        return m_anchorBeats;
+
+    const double elapsedBeats = (m_elapsed.elapsed() - m_anchorMs) * m_bpm / 60000.0;
+    // Ne pas extrapoler plus d'une mesure au-delà du dernier ancrage
+    return m_anchorBeats + qBound(0.0, elapsedBeats, double(m_beatsPerBar));
+}
+
+int BeatClock::beat() const
+{
+    const qint64 beats = qFloor(currentBeats());
+    return int(beats % m_beatsPerBar) + 1;
+}
+
+int BeatClock::bar() const
+{
+    const qint64 beats = qFloor(currentBeats());
+    return int(beats / m_beatsPerBar) + 1;
+}
+
+double BeatClock::beatPhase() const
+{
+    const double beats = currentBeats();
+    return beats - qFloor(beats);
+}
+
+double BeatClock::barPhase() const
+{
+    const double bars = currentBeats() / m_beatsPerBar;
+    return bars - qFloor(bars);
+}
+
+void BeatClock::processClock(const QVariantMap &clock)
+{
+    if (clock.contains(QStringLiteral("bpm")))
+        setBpm(clock.value(QStringLiteral("bpm")).toDouble());
+
+    const bool hasBeat = clock.contains(QStringLiteral("beat"));
+    const bool hasBar = clock.contains(QStringLiteral("bar"));
+    if (!hasBeat && !hasBar)
+        return;
+
+    const double now = currentBeats();
+    const qint64 currentBarStart = qFloor(now / m_beatsPerBar) * m_beatsPerBar;
+    const int beatIndex = hasBeat
+        ? qBound(0, clock.value(QStringLiteral("beat")).toInt() - 1, m_beatsPerBar - 1)
+        : int(qFloor(now) - currentBarStart);
+
+    double beats;
+    if (hasBar) {
+        beats = double(qMax(0, clock.value(QStringLiteral("bar")).toInt() - 1)) * m_beatsPerBar + beatIndex;
+    } else {
+        beats = double(currentBarStart + beatIndex);
+        // Beat 1 reçu alors qu'on extrapole la fin de la mesure : nouvelle mesure
+        if (beats < now - m_beatsPerBar / 2.0)
+            beats += m_beatsPerBar;
+    }
+
+    reanchor(beats);
+    setRunning(true);
+
+    if (hasBeat) {
+        m_lastBeat = beatIndex + 1;
+        const int pulseDuration = qRound(60000.0 / m_bpm / 2.0);
+        emit beatTriggered(m_lastBeat, m_lastBeat == 1, pulseDuration);
+    }
+    onFrame();
+}
+
+void BeatClock::setLoopSize(int sirenId, int loopSize)
+{
+    if (LoopState *loop = loopFor(sirenId))
+        loop->loopSize = qMax(1, loopSize);
+}
+
+void BeatClock::setLoopBar(int sirenId, int currentBar)
+{
+    if (LoopState *loop = loopFor(sirenId)) {
+        loop->barAtAnchor = qMax(1, currentBar);
+        loop->anchorBeats = currentBeats();
+    }
+}
+
+void BeatClock::setLoopPlaying(int sirenId, bool playing)
+{
+    LoopState *loop = loopFor(sirenId);
+    if (!loop || loop->playing == playing)
+        return;
+    loop->playing = playing;
+    if (playing)
+        loop->anchorBeats = currentBeats();
+    updateLoopPhases();
+    emit positionChanged();
+}
+
+void BeatClock::clearLoop(int sirenId)
+{
+    if (LoopState *loop = loopFor(sirenId)) {
+        *loop = LoopState();
+        updateLoopPhases();
+        emit positionChanged();
+    }
+}
+
+double BeatClock::loopPhase(int sirenId) const
+{
+    if (sirenId < 1 || sirenId > MaxSirens)
+        return 0.0;
+
+    const LoopState &loop = m_loops[sirenId];
+    if (!loop.playing)
+        return 0.0;
+
+    // Progression dans la mesure courante, bornée à une mesure comme dans PieChartAnimation
+    const double barProgress = qBound(0.0, (currentBeats() - loop.anchorBeats) / m_beatsPerBar, 1.0);
+    const double bars = ((loop.barAtAnchor - 1) % loop.loopSize) + barProgress;
+    const double phase = bars / loop.loopSize;
+    return phase - qFloor(phase);
+}
+
+void BeatClock::onFrame()
+{
+    if (m_running && m_elapsed.elapsed() - m_anchorMs > kWatchdogBars * m_beatsPerBar * 60000.0 / m_bpm) {
+        // Plus de clock : figer la position extrapolée
+        reanchor(currentBeats());
+        setRunning(false);
+    }
+    updateLoopPhases();
+    emit positionChanged();
+}
+
+void BeatClock::reanchor(double beats)
+{
+    m_anchorBeats = beats;
+    m_anchorMs = m_elapsed.elapsed();
+}
+
+void BeatClock::setRunning(bool running)
+{
+    if (m_running == running)
+        return;
+    m_running = running;
+    if (m_running)
+        m_frameTimer.start();
+    else
+        m_frameTimer.stop();
+    emit runningChanged();
+}
+
+void BeatClock::updateLoopPhases()
+{
+    for (int id = 1; id <= MaxSirens; ++id)
+        m_loopPhases[id - 1] = loopPhase(id);
+}
+
+BeatClock::LoopState *BeatClock::loopFor(int sirenId)
+{
+    if (sirenId < 1 || sirenId > MaxSirens)
+        return nullptr;
+    return &m_loops[sirenId];
+}
@@ -0,0 +1,100 @@
+#ifndef BEATCLOCK_H
+#define BEATCLOCK_H
+
+#include <QObject>
+#include <QVariantMap>
+#include <QList>
+#include <QVector>
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Horloge de tempo unique pour le pédalier.
+// Les messages "clock" (bpm/beat/bar) servent de points d'ancrage ; entre deux
+// messages la position est extrapolée à partir du BPM. Chaque sirène expose une
+// phase de boucle continue (0..1) sur laquelle les animations se lient, au lieu
+// d'être redémarrées à chaque changement de tempo ou de mesure.
+class BeatClock : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double bpm READ bpm WRITE setBpm NOTIFY bpmChanged)
+    Q_PROPERTY(int beatsPerBar READ beatsPerBar WRITE setBeatsPerBar NOTIFY beatsPerBarChanged)
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(int beat READ beat NOTIFY positionChanged)
+    Q_PROPERTY(int bar READ bar NOTIFY positionChanged)
+    Q_PROPERTY(double beatPhase READ beatPhase NOTIFY positionChanged)
+    Q_PROPERTY(double barPhase READ barPhase NOTIFY positionChanged)
+    Q_PROPERTY(QList<qreal> loopPhases READ loopPhases NOTIFY positionChanged)
+    Q_PROPERTY(int frameInterval READ frameInterval WRITE setFrameInterval NOTIFY frameIntervalChanged)
+
+public:
+    static constexpr int MaxSirens = 7;
+
+    explicit BeatClock(QObject *parent = nullptr);
+
+    double bpm() const { return m_bpm; }
+    void setBpm(double bpm);
+    int beatsPerBar() const { return m_beatsPerBar; }
+    void setBeatsPerBar(int beats);
+    bool isRunning() const { return m_running; }
+    int frameInterval() const { return m_frameTimer.interval(); }
+    void setFrameInterval(int ms);
+
+    // Position extrapolée (beat et bar sont 1-based comme dans les messages PureData)
+    int beat() const;
+    int bar() const;
+    double beatPhase() const;
+    double barPhase() const;
+    QList<qreal> loopPhases() const { return m_loopPhases; }
+
+    // Ancrage depuis un batch "clock" : { bpm, beat, bar }
+    Q_INVOKABLE void processClock(const QVariantMap &clock);
+
+    // État des boucles par sirène (ids 1..MaxSirens)
+    Q_INVOKABLE void setLoopSize(int sirenId, int loopSize);
+    Q_INVOKABLE void setLoopBar(int sirenId, int currentBar);
+    Q_INVOKABLE void setLoopPlaying(int sirenId, bool playing);
+    Q_INVOKABLE void clearLoop(int sirenId);
+    Q_INVOKABLE double loopPhase(int sirenId) const;
+
+signals:
+    void bpmChanged();
+    void beatsPerBarChanged();
+    void runningChanged();
+    void frameIntervalChanged();
+    void positionChanged();
+    // Émis une seule fois par beat reçu ; pulseDuration = demi-beat en ms
+    void beatTriggered(int beat, bool downbeat, int pulseDuration);
+
+private slots:
+    void onFrame();
+
+private:
+    struct LoopState {
+        int loopSize = 16;
+        int barAtAnchor = 1;
+        double anchorBeats = 0.0;
+        bool playing = false;
+    };
+
+    // Position courante en beats depuis le début (0 = beat 1 de la mesure 1)
+    double currentBeats() const;
+    void reanchor(double beats);
+    void setRunning(bool running);
+    void updateLoopPhases();
+    LoopState *loopFor(int sirenId);
+
+    double m_bpm;
+    int m_beatsPerBar;
+    bool m_running;
+
+    double m_anchorBeats;
+    qint64 m_anchorMs;
+    int m_lastBeat;
+    QElapsedTimer m_elapsed;
+    QTimer m_frameTimer;
+
+    QVector<LoopState> m_loops;
+    QList<qreal> m_loopPhases;
+};
+
+#endif // BEATCLOCK_H
@@ -6,10 +6,16 @@
 
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QDir>
 #include <QSurfaceFormat>
 #include <QDebug>
 #include <QtQuick3D/qquick3d.h>
+#include "beatclock.h"
+#include "midimonitormodel.h"
+#include "telemetryhistory.h"
+#include "LogQml.h"
+#include "MemoryMonitor.h"
 
 int main(int argc, char *argv[])
 {
@@ -30,7 +36,26 @@ int main(int argc, char *argv[])
 */
  //   QSurfaceFormat::setDefaultFormat(QQuick3D::idealSurfaceFormat());
 
+    // Niveaux MecavivLog : MECAVIV_LOG="ROUTER=trace,*=warn", MECAVIV_LOG_FILE=...
+    // (les catégories absentes de MECAVIV_LOG reçoivent ensuite les niveaux de Logger.qml)
+    MecavivLog::configureFromEnvironment();
+    LogQml::registerQmlType("Pedalier", 1, 0);
+
+    // Horloge de tempo partagée (une seule source de phase pour toutes les sirènes)
+    qmlRegisterSingletonType<BeatClock>("Pedalier", 1, 0, "BeatClock",
+                                        [](QQmlEngine *, QJSEngine *) -> QObject * {
+        return new BeatClock;
+    });
+    // Moniteur MIDI (tampon circulaire, texte formaté seulement pour les lignes visibles)
+    qmlRegisterType<MidiMonitorModel>("Pedalier", 1, 0, "MidiMonitorModel");
+    // Historique multi-résolution des mesures par sirène (graphes)
+    qmlRegisterType<TelemetryHistory>("Pedalier", 1, 0, "TelemetryHistory");
+    // Comptabilité mémoire (MECAVIV_MEMORY_BUDGET_MB, MECAVIV_MEMORY_SNAPSHOT=fichier.jsonl)
+    qmlRegisterSingletonInstance("Pedalier", 1, 0, "MemoryMonitor", MemoryMonitor::instance());
+
     QQmlApplicationEngine engine;
+    MemoryMonitor::instance()->attach(&engine);
+    MemoryMonitor::instance()->configureFromEnvironment();
 
     const QUrl url(u"qrc:/qml/qmlwebsocketserver/main.qml"_qs);
     QObject::connect(&engine, &QQmlApplicationEngine::objectCreated,
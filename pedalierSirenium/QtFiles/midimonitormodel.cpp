@@ -0,0 +1,399 @@
+#include "midimonitormodel.h"
+#include "telemetryhistory.h"
+
+namespace {
+constexpr int kDefaultCapacity = 512;
+constexpr int kPublishInterval = 50;    // les vues sont mises à jour au plus à 20 Hz
+constexpr int kRateInterval = 1000;
+
+int messageLength(quint8 status)
+{
+    const quint8 type = status & 0xF0;
+    return (type == 0xC0 || type == 0xD0) ? 2 : 3;
+}
+}
+
+MidiMonitorModel::MidiMonitorModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_ring(kDefaultCapacity)
+    , m_head(0)
+    , m_size(0)
+    , m_modelCount(0)
+    , m_pendingNew(0)
+    , m_active(false)
+    , m_note(0)
+    , m_velocity(0)
+    , m_bend(8192)
+    , m_channel(0)
+    , m_eventCount(0)
+    , m_clockCount(0)
+    , m_channelCounts(ChannelCount, 0)
+    , m_ccCounts(ChannelCount * ControllerCount, 0)
+    , m_eventRate(0)
+    , m_clockRate(0)
+    , m_ccRates(ChannelCount * ControllerCount, 0)
+    , m_totalEvents(0)
+    , m_memory("rings", "MidiMonitorModel", [this] {
+          return MecavivMemory::Usage { 1, qint64(m_ring.capacity() * sizeof(Event)
+                                                  + (m_ccCounts.capacity() + m_ccRates.capacity()) * sizeof(int)) };
+      })
+{
+    m_clock.start();
+    for (int i = 0; i < ChannelCount; ++i)
+        m_channelRates.append(0);
+
+    m_publishTimer.setSingleShot(true);
+    m_publishTimer.setInterval(kPublishInterval);
+    connect(&m_publishTimer, &QTimer::timeout, this, &MidiMonitorModel::publish);
+
+    m_rateTimer.setInterval(kRateInterval);
+    connect(&m_rateTimer, &QTimer::timeout, this, &MidiMonitorModel::rollRates);
+    m_rateTimer.start();
+}
+
+int MidiMonitorModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_modelCount;
+}
+
+QVariant MidiMonitorModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_modelCount)
+        return QVariant();
+
+    // Ligne 0 = événement publié le plus récent
+    const Event *event = eventAt(m_pendingNew + index.row());
+    if (!event)
+        return QVariant();
+
+    switch (role) {
+        case TimestampRole:
+            return event->timestamp;
+        case StatusRole:
+            return event->status;
+        case ChannelRole:
+            return event->status < 0xF0 ? (event->status & 0x0F) + 1 : 0;
+        case Data1Role:
+            return event->data1;
+        case Data2Role:
+            return event->data2;
+        case TypeRole:
+            return typeName(event->status);
+        case HexRole:
+            return hexOf(*event);
+        case TextRole: {
+            // Formaté à la demande : seules les lignes visibles paient ce coût
+            const QString prefix = QStringLiteral("%1 ch%2 ").arg(typeName(event->status)).arg((event->status & 0x0F) + 1);
+            if ((event->status & 0xF0) == 0xE0)
+                return prefix + QString::number((event->data2 << 7) | event->data1);
+            if (event->length == 3)
+                return prefix + QStringLiteral("%1 %2").arg(event->data1).arg(event->data2);
+            return prefix + QString::number(event->data1);
+        }
+        default:
+            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> MidiMonitorModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[TimestampRole] = "timestamp";
+    roles[StatusRole] = "status";
+    roles[ChannelRole] = "channel";
+    roles[Data1Role] = "data1";
+    roles[Data2Role] = "data2";
+    roles[TypeRole] = "eventType";
+    roles[HexRole] = "hex";
+    roles[TextRole] = "text";
+    return roles;
+}
+
+void MidiMonitorModel::setCapacity(int capacity)
+{
+    capacity = qBound(16, capacity, 65536);
+    if (capacity == m_ring.size())
+        return;
+
+    // Conserver les événements les plus récents dans le nouveau tampon
+    QVector<Event> ring(capacity);
+    const int kept = qMin(m_size, capacity);
+    for (int i = 0; i < kept; ++i)
+        ring[kept - 1 - i] = *eventAt(i);
+
+    beginResetModel();
+    m_ring = ring;
+    m_size = kept;
+    m_head = kept % capacity;
+    m_pendingNew = 0;
+    m_modelCount = m_active ? m_size : 0;
+    endResetModel();
+    emit capacityChanged();
+    emit countChanged();
+}
+
+void MidiMonitorModel::setActive(bool active)
+{
+    if (m_active == active)
+        return;
+    m_active = active;
+
+    // Une vue qui apparaît reçoit l'état complet d'un coup ; en retrait, plus aucune notification
+    beginResetModel();
+    m_pendingNew = 0;
+    m_modelCount = m_active ? m_size : 0;
+    endResetModel();
+    emit activeChanged();
+    emit countChanged();
+}
+
+void MidiMonitorModel::setHistory(TelemetryHistory *history)
+{
+    if (m_history == history)
+        return;
+    m_history = history;
+    emit historyChanged();
+}
+
+void MidiMonitorModel::appendMessage(const QByteArray &bytes)
+{
+    const int length = bytes.size();
+    quint8 runningStatus = 0;
+    int i = 0;
+    while (i < length) {
+        const quint8 byte = quint8(bytes.at(i));
+        if (byte >= 0xF8) {
+            // Temps réel (clock, start, stop...) : compté, pas stocké (géré par le BeatController)
+            if (byte == 0xF8)
+                ++m_clockCount;
+            ++i;
+            continue;
+        }
+        if (byte >= 0xF0) {
+            // Messages système communs : ignorés, on resynchronise sur le prochain statut
+            runningStatus = 0;
+            ++i;
+            continue;
+        }
+
+        quint8 status = runningStatus;
+        if (byte & 0x80) {
+            status = byte;
+            ++i;
+        }
+        if (!status) {
+            ++i;    // octet de données orphelin
+            continue;
+        }
+        runningStatus = status;
+
+        const int needed = messageLength(status) - 1;
+        if (i + needed > length)
+            break;
+        const quint8 data1 = quint8(bytes.at(i)) & 0x7F;
+        const quint8 data2 = needed > 1 ? quint8(bytes.at(i + 1)) & 0x7F : 0;
+        i += needed;
+
+        store(status, data1, data2, quint8(needed + 1));
+        track(status, data1, data2);
+    }
+}
+
+void MidiMonitorModel::appendEvent(int status, int data1, int data2)
+{
+    const quint8 s = quint8(status);
+    if (s < 0x80 || s >= 0xF0)
+        return;
+    const quint8 d1 = quint8(data1) & 0x7F;
+    const quint8 d2 = quint8(data2) & 0x7F;
+    store(s, d1, d2, quint8(messageLength(s)));
+    track(s, d1, d2);
+}
+
+void MidiMonitorModel::store(quint8 status, quint8 data1, quint8 data2, quint8 length)
+{
+    Event &event = m_ring[m_head];
+    event.timestamp = m_clock.elapsed();
+    event.status = status;
+    event.data1 = data1;
+    event.data2 = data2;
+    event.length = length;
+
+    m_head = (m_head + 1) % m_ring.size();
+    if (m_size < m_ring.size())
+        ++m_size;
+
+    ++m_eventCount;
+    ++m_totalEvents;
+    const int channel = status & 0x0F;
+    ++m_channelCounts[channel];
+    if ((status & 0xF0) == 0xB0)
+        ++m_ccCounts[channel * ControllerCount + data1];
+
+    if (m_active) {
+        m_pendingNew = qMin(m_pendingNew + 1, m_ring.size());
+        schedulePublish();
+    }
+}
+
+void MidiMonitorModel::track(quint8 status, quint8 data1, quint8 data2)
+{
+    const quint8 type = status & 0xF0;
+    const int channel = status & 0x0F;
+
+    // Canal MIDI n = sirène n + 1 (sirenSpec : siren1 sur le canal 0) ; les autres canaux ne sont pas des sirènes
+    if (m_history && channel < TelemetryHistory::MaxSirens && (type == 0x80 || type == 0x90 || type == 0xE0)) {
+        const int sirenId = channel + 1;
+        if (type == 0xE0) {
+            m_history->record(sirenId, QStringLiteral("bend"), (data2 << 7) | data1);
+        } else {
+            const bool on = type == 0x90 && data2 > 0;
+            if (on)
+                m_history->record(sirenId, QStringLiteral("note"), data1);
+            m_history->record(sirenId, QStringLiteral("velocity"), on ? data2 : 0);
+        }
+    }
+
+    if (type == 0x90 && data2 > 0) {
+        m_note = data1;
+        m_velocity = data2;
+        m_channel = channel;
+        emit midiDataChanged(m_note, m_velocity, m_bend, m_channel);
+    } else if (type == 0x90 || type == 0x80) {
+        m_velocity = 0;
+        emit midiDataChanged(data1, 0, m_bend, channel);
+    } else if (type == 0xE0) {
+        m_bend = (data2 << 7) | data1;
+        m_channel = channel;
+        emit midiDataChanged(m_note, m_velocity, m_bend, m_channel);
+    }
+}
+
+const MidiMonitorModel::Event *MidiMonitorModel::eventAt(int offsetFromNewest) const
+{
+    if (offsetFromNewest < 0 || offsetFromNewest >= m_size)
+        return nullptr;
+    const int capacity = m_ring.size();
+    return &m_ring[(m_head - 1 - offsetFromNewest + 2 * capacity) % capacity];
+}
+
+void MidiMonitorModel::schedulePublish()
+{
+    if (!m_publishTimer.isActive())
+        m_publishTimer.start();
+}
+
+void MidiMonitorModel::publish()
+{
+    if (!m_active || m_pendingNew == 0)
+        return;
+
+    const int added = m_pendingNew;
+    if (added >= m_size) {
+        // Tout le tampon a tourné depuis la dernière publication
+        beginResetModel();
+        m_pendingNew = 0;
+        m_modelCount = m_size;
+        endResetModel();
+        emit countChanged();
+        return;
+    }
+
+    // Les plus anciennes lignes écrasées disparaissent en bas, les nouvelles arrivent en haut
+    const int overflow = m_modelCount + added - m_size;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), m_modelCount - overflow, m_modelCount - 1);
+        m_modelCount -= overflow;
+        endRemoveRows();
+    }
+    beginInsertRows(QModelIndex(), 0, added - 1);
+    m_pendingNew = 0;
+    m_modelCount += added;
+    endInsertRows();
+    emit countChanged();
+}
+
+void MidiMonitorModel::rollRates()
+{
+    const bool changed = m_eventCount != 0 || m_eventRate != 0 || m_clockCount != 0 || m_clockRate != 0;
+
+    m_eventRate = m_eventCount;
+    m_clockRate = m_clockCount;
+    m_eventCount = 0;
+    m_clockCount = 0;
+    if (!changed)
+        return;
+
+    for (int i = 0; i < ChannelCount; ++i) {
+        m_channelRates[i] = m_channelCounts[i];
+        m_channelCounts[i] = 0;
+    }
+    m_ccRates = m_ccCounts;
+    m_ccCounts.fill(0);
+    emit ratesChanged();
+}
+
+int MidiMonitorModel::ccRate(int controller) const
+{
+    if (controller < 0 || controller >= ControllerCount)
+        return 0;
+    int total = 0;
+    for (int channel = 0; channel < ChannelCount; ++channel)
+        total += m_ccRates[channel * ControllerCount + controller];
+    return total;
+}
+
+int MidiMonitorModel::ccRateOnChannel(int channel, int controller) const
+{
+    if (channel < 0 || channel >= ChannelCount || controller < 0 || controller >= ControllerCount)
+        return 0;
+    return m_ccRates[channel * ControllerCount + controller];
+}
+
+QString MidiMonitorModel::lastEventHex() const
+{
+    const Event *event = eventAt(0);
+    return event ? hexOf(*event) : QString();
+}
+
+void MidiMonitorModel::clear()
+{
+    beginResetModel();
+    m_head = 0;
+    m_size = 0;
+    m_pendingNew = 0;
+    m_modelCount = 0;
+    endResetModel();
+    emit countChanged();
+}
+
+void MidiMonitorModel::resetData()
+{
+    m_note = 0;
+    m_velocity = 0;
+    m_bend = 8192;
+    m_channel = 0;
+    emit midiDataChanged(m_note, m_velocity, m_bend, m_channel);
+}
+
+QString MidiMonitorModel::typeName(quint8 status)
+{
+    switch (status & 0xF0) {
+        case 0x80: return QStringLiteral("NoteOff");
+        case 0x90: return QStringLiteral("NoteOn");
+        case 0xA0: return QStringLiteral("AfterTouch");
+        case 0xB0: return QStringLiteral("CC");
+        case 0xC0: return QStringLiteral("Program");
+        case 0xD0: return QStringLiteral("Pressure");
+        case 0xE0: return QStringLiteral("PitchBend");
+        default: return QStringLiteral("System");
+    }
+}
+
+QString MidiMonitorModel::hexOf(const Event &event)
+{
+    const quint8 bytes[3] = { event.status, event.data1, event.data2 };
+    return QString::fromLatin1(QByteArray(reinterpret_cast<const char *>(bytes), event.length).toHex(' '));
+}
@@ -0,0 +1,149 @@
+#ifndef MIDIMONITORMODEL_H
+#define MIDIMONITORMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+#include "MemoryAccounting.h"
+
+class TelemetryHistory;
+
+// Moniteur du flux MIDI binaire reçu de PureData.
+// Les événements bruts (3 octets + horodatage) sont rangés dans un tampon
+// circulaire de capacité fixe : coût O(1) par événement et mémoire bornée.
+// Les débits par canal et par CC sont des compteurs incrémentés à la volée et
+// figés une fois par seconde. Le texte (hex, description) n'est produit que dans
+// data(), donc seulement pour les lignes qu'une vue affiche ; tant que active est
+// faux, le modèle n'émet aucun signal de lignes.
+class MidiMonitorModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    // Dernier état (compatibilité MidiMonitorController)
+    Q_PROPERTY(int note READ note NOTIFY midiDataChanged)
+    Q_PROPERTY(int velocity READ velocity NOTIFY midiDataChanged)
+    Q_PROPERTY(int bend READ bend NOTIFY midiDataChanged)
+    Q_PROPERTY(int channel READ channel NOTIFY midiDataChanged)
+    // Débits sur la dernière seconde écoulée
+    Q_PROPERTY(int eventRate READ eventRate NOTIFY ratesChanged)
+    Q_PROPERTY(int clockRate READ clockRate NOTIFY ratesChanged)
+    Q_PROPERTY(QList<int> channelRates READ channelRates NOTIFY ratesChanged)
+    Q_PROPERTY(double totalEvents READ totalEvents NOTIFY ratesChanged)
+    // Historique alimenté directement (note, vélocité, bend : canal n → sirène n + 1 pour les canaux 0..6, autres canaux ignorés)
+    Q_PROPERTY(TelemetryHistory *history READ history WRITE setHistory NOTIFY historyChanged)
+
+public:
+    enum Roles {
+        TimestampRole = Qt::UserRole + 1,
+        StatusRole,
+        ChannelRole,
+        Data1Role,
+        Data2Role,
+        TypeRole,
+        HexRole,
+        TextRole
+    };
+
+    static constexpr int ChannelCount = 16;
+    static constexpr int ControllerCount = 128;
+
+    explicit MidiMonitorModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int capacity() const { return m_ring.size(); }
+    void setCapacity(int capacity);
+    bool isActive() const { return m_active; }
+    void setActive(bool active);
+
+    int note() const { return m_note; }
+    int velocity() const { return m_velocity; }
+    int bend() const { return m_bend; }
+    int channel() const { return m_channel; }
+
+    int eventRate() const { return m_eventRate; }
+    int clockRate() const { return m_clockRate; }
+    QList<int> channelRates() const { return m_channelRates; }
+    double totalEvents() const { return double(m_totalEvents); }
+    TelemetryHistory *history() const { return m_history; }
+    void setHistory(TelemetryHistory *history);
+
+    // Message binaire WebSocket (1 à n octets, plusieurs messages MIDI possibles)
+    Q_INVOKABLE void appendMessage(const QByteArray &bytes);
+    Q_INVOKABLE void appendEvent(int status, int data1, int data2);
+    Q_INVOKABLE int ccRate(int controller) const;
+    Q_INVOKABLE int ccRateOnChannel(int channel, int controller) const;
+    Q_INVOKABLE QString lastEventHex() const;
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE void resetData();
+
+signals:
+    void capacityChanged();
+    void activeChanged();
+    void countChanged();
+    void midiDataChanged(int note, int velocity, int bend, int channel);
+    void ratesChanged();
+    void historyChanged();
+
+private slots:
+    void publish();
+    void rollRates();
+
+private:
+    struct Event {
+        qint64 timestamp = 0;
+        quint8 status = 0;
+        quint8 data1 = 0;
+        quint8 data2 = 0;
+        quint8 length = 0;
+    };
+
+    void store(quint8 status, quint8 data1, quint8 data2, quint8 length);
+    void track(quint8 status, quint8 data1, quint8 data2);
+    const Event *eventAt(int offsetFromNewest) const;
+    void schedulePublish();
+
+    static QString typeName(quint8 status);
+    static QString hexOf(const Event &event);
+
+    QVector<Event> m_ring;
+    int m_head;            // prochaine case écrite
+    int m_size;            // événements valides dans le tampon
+    int m_modelCount;      // lignes annoncées aux vues
+    int m_pendingNew;      // événements écrits depuis la dernière publication
+    bool m_active;
+    QElapsedTimer m_clock;
+    QTimer m_publishTimer;
+    QTimer m_rateTimer;
+
+    int m_note;
+    int m_velocity;
+    int m_bend;
+    int m_channel;
+
+    // Compteurs de la seconde en cours et valeurs figées de la précédente
+    int m_eventCount;
+    int m_clockCount;
+    QVector<int> m_channelCounts;
+    QVector<int> m_ccCounts;        // ChannelCount × ControllerCount
+    int m_eventRate;
+    int m_clockRate;
+    QList<int> m_channelRates;
+    QVector<int> m_ccRates;
+    qint64 m_totalEvents;
+
+    QPointer<TelemetryHistory> m_history;
+
+    // Comptabilité mémoire : tampon circulaire et compteurs CC, taille fixe
+    MecavivMemory::Source m_memory;
+};
+
+#endif // MIDIMONITORMODEL_H
@@ -1,5 +1,6 @@
 import QtQuick
 import QtQuick3D
+import Pedalier 1.0
 import "../../utils" as Utils
 import "../controls"
 import "../monitoring"
@@ -200,6 +201,16 @@ Node {
         )
     }
 
+    // Pulsation de la sphère sur chaque beat de l'horloge partagée
+    Connections {
+        target: BeatClock
+        function onBeatTriggered(beat, downbeat, pulseDuration) {
+            if (columnContainer.isCurrent) {
+                columnContainer.pulseSphere(downbeat, pulseDuration);
+            }
+        }
+    }
+
     // Fonction pour que BeatController puisse contrôler cette animation
     function getPieChartAnimation() {
         return pieChartDisplay;
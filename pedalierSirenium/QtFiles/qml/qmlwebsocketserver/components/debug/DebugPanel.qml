@@ -445,6 +445,46 @@ Rectangle {
                     visualStyle: panelBg.visualStyle
                     sirenStates: currentMonitoringData.sirenStates || ({})
                     sirenPings: currentMonitoringData.sirenPings || ({})
+                    history: midiMonitorController ? midiMonitorController.history : null
+                }
+                
+                // Flux MIDI brut (tampon circulaire C++, texte formaté pour les lignes visibles uniquement)
+                Rectangle {
+                    width: parent.width
+                    height: 200
+                    radius: 8
+                    color: "#1a1a1a"
+                    border.color: "#333"
+                    border.width: 1
+                    
+                    Text {
+                        id: midiFlowTitle
+                        anchors.top: parent.top
+                        anchors.left: parent.left
+                        anchors.margins: 10
+                        text: "🎛️ Flux MIDI — " + (midiMonitorController ? midiMonitorController.model.eventRate : 0) + " évt/s"
+                        font.family: window.globalEmojiFont
+                        color: "#00aaff"
+                        font.pixelSize: 12
+                        font.bold: true
+                    }
+                    
+                    ListView {
+                        anchors.top: midiFlowTitle.bottom
+                        anchors.left: parent.left
+                        anchors.right: parent.right
+                        anchors.bottom: parent.bottom
+                        anchors.margins: 10
+                        clip: true
+                        model: midiMonitorController ? midiMonitorController.model : null
+                        delegate: Text {
+                            width: ListView.view.width
+                            text: (timestamp / 1000).toFixed(3) + "  " + hex + "  " + model.text
+                            color: "#ccc"
+                            font.family: "monospace"
+                            font.pixelSize: 11
+                        }
+                    }
                 }
                 
                 // (Connexion MIDI déplacée au niveau racine pour être toujours active)
@@ -583,9 +623,24 @@ SystemInfoReader {
         }
     }
 
-    // Connexion MIDI -> SirenStateMonitor (toujours active)
+    // Le flux MIDI n'est publié vers les vues que lorsque l'onglet Monitoring est affiché
+    Binding {
+        target: panelBg.midiMonitorController
+        property: "active"
+        value: panelBg.visible && stackLayout.currentIndex === 1
+        when: panelBg.midiMonitorController !== null && panelBg.midiMonitorController !== undefined
+    }
+
+    // Connexion MIDI -> SirenStateMonitor (active tant que le panneau est visible)
+    onVisibleChanged: {
+        if (visible && midiMonitorController && sirenMonitor) {
+            sirenMonitor.applyMidi(midiMonitorController.note, midiMonitorController.velocity,
+                                   midiMonitorController.bend, midiMonitorController.channel)
+        }
+    }
     Connections {
         target: panelBg.midiMonitorController
+        enabled: panelBg.visible
         function onMidiDataChanged(note, velocity, bend, channel) {
             if (panelBg.logger) panelBg.logger.trace("MIDI", "onMidiDataChanged", note, velocity, bend, channel)
             if (sirenMonitor && typeof sirenMonitor.applyMidi === 'function') {
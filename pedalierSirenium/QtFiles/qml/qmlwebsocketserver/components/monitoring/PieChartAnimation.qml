@@ -1,5 +1,6 @@
 import QtQuick
 import QtQuick3D
+import Pedalier 1.0
 
 Model {
     id: pieChart
@@ -16,51 +17,10 @@ Model {
     // Propriétés de compatibilité avec SegmentAnimation
     property int loopDuration: 2000  // Pour compatibilité avec BeatController
     
-    // Propriétés pour la logique interne
-    property real internalProgress: 0
-    property real currentProgress: 0
-    property real lastCurrentBarTime: 0
-    property int estimatedBPM: 120
-    
-    // Progress final (lecture seule)
-    property real progress: internalProgress
-    
-    // Timer simple pour progression fluide
-    Timer {
-        id: animationTimer
-        interval: 16  // 60 FPS
-        running: pieChart.running
-        repeat: true
-        onTriggered: updateProgress()
-    }
-    
-    // Fonction simple et fiable
-    function updateProgress() {
-        if (!siren || !running || !siren.loopSize) {
-            return;
-        }
-        
-        // Fallback si lastCurrentBarTime n'est pas initialisé
-        if (lastCurrentBarTime === 0) {
-            lastCurrentBarTime = Date.now();
-            return;
-        }
-        
-        let currentTime = Date.now();
-        let msPerBar = (60000 / estimatedBPM) * 4;
-        
-        let timeSinceLastBar = currentTime - lastCurrentBarTime;
-        let progressInCurrentBar = Math.min(timeSinceLastBar / msPerBar, 1.0);
-        
-        // CORRECTION : currentBar 1-based → 0-based
-        let zeroBasedCurrentBar = (siren.currentBar - 1) % siren.loopSize;
-        
-        // Progression totale
-        let totalProgress = (zeroBasedCurrentBar + progressInCurrentBar) / siren.loopSize;
-        
-        // Mettre à jour la propriété interne (pas progress directement)
-        internalProgress = totalProgress % 1.0;
-    }
+    // Progression lue depuis l'horloge C++ partagée (aucun timer par sirène)
+    readonly property int sirenIndex: siren ? siren.sphereId - 1 : -1
+    property real progress: (running && sirenIndex >= 0 && sirenIndex < BeatClock.loopPhases.length)
+                            ? BeatClock.loopPhases[sirenIndex] : 0
     
     // Position EXACTE du test qui fonctionnait
     source: "#Rectangle"
@@ -80,71 +40,18 @@ Model {
         property bool uIsRecording: pieChart.isRecording
     }
     
-    // ========== LOGIQUE BASÉE SUR current_bar ==========
-    
-    // Watcher pour current_bar de la sirène
-    Connections {
-        target: siren
-        function onCurrentBarChanged() {
-            if (running && siren) {
-                // updateProgressFromCurrentBar(); // Supprimé
-            }
-        }
-    }
-    
-    // Simplifier - supprimer la logique complexe
-    // Supprimer : lastProgress, revolutionOffset, timer continu
-    
-    // Fonction pour mettre à jour la progression en continu
-    // function updateContinuousProgress() { // Supprimé
-    //     if (!siren || !running) return;
-    //     
-    //     let currentTime = Date.now();
-    //     let msPerBar = (60000 / estimatedBPM) * 4;
-    //     
-    //     // Debug timing
-    //     let timeSinceLastBar = currentTime - lastCurrentBarTime;
-    //     if (timeSinceLastBar > msPerBar * 2) {
-    //         // Supprimé: console.log debug
-    //     }
-    //     
-    //     let progressInCurrentBar = (currentTime - lastCurrentBarTime) / msPerBar;
-    //     let totalProgress = totalElapsedBars + progressInCurrentBar;
-    //     progress = (totalProgress % siren.loopSize) / siren.loopSize;
-    // }
-    
-    // Écouter les changements de currentBar
-    Connections {
-        target: siren
-        function onCurrentBarChanged() {
-            if (siren && running) {
-                lastCurrentBarTime = Date.now();
-                // Pas de reset, juste mise à jour du timestamp
-            }
-        }
-    }
-    
     // Gestionnaire pour mettre à jour isAnimating dans la sirène
     onRunningChanged: {
         // Supprimé: console.log debug
         if (siren) {
             siren.isAnimating = running;
-        }
-        
-        // Initialiser le timestamp quand l'animation démarre
-        if (running && lastCurrentBarTime === 0) {
-            lastCurrentBarTime = Date.now();
+            BeatClock.setLoopPlaying(siren.sphereId, running);
         }
     }
 
     // ========== FONCTIONS DE CONTRÔLE ==========
 
     function start() {
-        if (!running) {
-            internalProgress = 0;  // ← Changer ici aussi
-            lastCurrentBarTime = Date.now();
-        }
-        
         running = true;
         isRecording = false;
         
@@ -156,7 +63,6 @@ Model {
 
     function stop() {
         running = false;
-        internalProgress = 0;  // ← Et ici
         isRecording = false;
         
         // S'assurer que isAnimating est mis à jour
@@ -166,14 +72,9 @@ Model {
     }
     
     function resetAnimation() {
-        // Reset
-        running = false;
-        // progress = 0; // Supprimé
+        // La phase vient de BeatClock : rien à recréer, on s'assure juste que ça tourne
         isRecording = false;
-        
-        // Restart
         running = true;
-        // updateProgressFromCurrentBar(); // Supprimé
         
         // S'assurer que isAnimating est mis à jour
         if (siren) {
@@ -191,7 +92,7 @@ Model {
     }
     
     function updateDuration(newDuration) {
-        // Plus nécessaire avec current_bar // Supprimé
+        // Plus nécessaire : la durée découle de BeatClock.bpm
     }
     
     // ========== FONCTIONS DE COMPATIBILITÉ AVEC SEGMENTRING ==========
@@ -218,13 +119,6 @@ Model {
         recordingTimer.restart();
     }
     
-    Component.onCompleted: {
-        // Supprimé: console.log debug
-        if (siren) {
-            estimatedBPM = 120; // valeur par défaut
-        }
-    }
-    
     // Debug du scaling
     onScaleChanged: {
         // Supprimé: console.log debug
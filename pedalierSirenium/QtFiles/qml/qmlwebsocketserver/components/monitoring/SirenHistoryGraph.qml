@@ -0,0 +1,52 @@
+import QtQuick
+
+// Trace min/max d'une mesure de sirène sur une fenêtre glissante.
+// Un seul appel à history.query() par rafraîchissement, un point par pixel :
+// le coût ne dépend que de la largeur, pas de la durée affichée.
+Canvas {
+    id: graph
+
+    property var history: null
+    property int sirenId: 1
+    property string metric: "note"
+    property int windowMs: 60000
+    property int refreshInterval: 100
+    property color lineColor: "#00aaff"
+    property color emptyColor: "#333"
+
+    Timer {
+        interval: graph.refreshInterval
+        running: graph.visible && graph.history !== null
+        repeat: true
+        onTriggered: graph.requestPaint()
+    }
+
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.clearRect(0, 0, width, height)
+        if (!history || width < 2 || height < 2) return
+
+        var points = Math.floor(width)
+        var to = history.now()
+        var r = history.query(sirenId, metric, to - windowMs, to, points)
+        if (!r.min) {
+            ctx.fillStyle = emptyColor
+            ctx.fillRect(0, height / 2, width, 1)
+            return
+        }
+
+        var low = r.low
+        var high = r.high
+        if (high - low < 1e-6) { low -= 1; high += 1 }
+        var scale = (height - 2) / (high - low)
+
+        ctx.fillStyle = lineColor
+        for (var x = 0; x < points; x++) {
+            var mn = r.min[x]
+            if (isNaN(mn)) continue
+            var yTop = height - 1 - (r.max[x] - low) * scale
+            var yBottom = height - 1 - (mn - low) * scale
+            ctx.fillRect(x, yTop, 1, Math.max(1, yBottom - yTop))
+        }
+    }
+}
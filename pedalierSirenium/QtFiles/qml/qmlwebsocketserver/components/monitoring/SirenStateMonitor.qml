@@ -18,6 +18,10 @@ Rectangle {
     // Ping JSON des sirènes (clé: "siren1".."siren7", value: { pingOk: bool })
     property var sirenPings: ({})
     property string visualStyle: "minimal" // "minimal" ou "detailed"
+    // Historique C++ (TelemetryHistory) : une trace par sirène en bout de ligne
+    property var history: null
+    property string historyMetric: "note"
+    property int historyWindowMs: 60000
     
     Column {
         anchors.fill: parent
@@ -148,6 +152,19 @@ Rectangle {
                             
                             // (Indicateur activité par vélocité retiré)
                         }
+                        
+                        SirenHistoryGraph {
+                            anchors.right: parent.right
+                            anchors.top: parent.top
+                            anchors.bottom: parent.bottom
+                            anchors.margins: 3
+                            width: parent.width * 0.4
+                            history: root.history
+                            sirenId: index + 1
+                            metric: root.historyMetric
+                            windowMs: root.historyWindowMs
+                            visible: root.monitoringActive && root.history !== null && visualStyle !== "detailed"
+                        }
                     }
                 }
             }
@@ -1,4 +1,5 @@
 import QtQuick
+import Pedalier 1.0
 
 Item {
     id: root
@@ -15,9 +16,8 @@ Item {
     property var segmentAnimations: ({})
     property int currentBar: 1
     
-    onBpmChanged: {
-        updateAllAnimationSpeeds();
-    }
+    // Le tempo est porté par BeatClock : un changement de BPM ne touche aucune animation
+    onBpmChanged: BeatClock.bpm = bpm
     
     // Nouvelle fonction pour traiter directement les données des loops et du clock
     function processLoopAndClock(loops, clock) {
@@ -37,18 +37,11 @@ Item {
                 currentBar = clock.bar;
             }
             
-            // Traiter les pulsations de beat pour les sirènes actives
-            if (clock.hasOwnProperty("beat")) {
-                if (logger) logger.debug("CLOCK", "Beat reçu:", clock.beat);
-                for (let i = 0; i < sirenController.sirenNodes.length; i++) {
-                    let siren = sirenController.sirenNodes[i];
-                    if (siren.isCurrent) {
-                        let isFirstBeat = clock.beat === 1;
-                        let beatColor = isFirstBeat ? "red" : "lime";
-                        siren.pulseSphere(isFirstBeat, 60000 / bpm / 2);
-                    }
-                }
+            // Ré-ancrer l'horloge ; les pulsations partent de BeatClock.beatTriggered
+            if (clock.hasOwnProperty("beat") && logger) {
+                logger.debug("CLOCK", "Beat reçu:", clock.beat);
             }
+            BeatClock.processClock(clock);
         }
         
         // Traiter les loops si elles sont présentes
@@ -75,6 +68,7 @@ Item {
                                  "mode:", state.transport, "valeur:", state.current_bar);
             }
                     siren.currentBar = state.current_bar;
+                    BeatClock.setLoopBar(state.siren_id, state.current_bar);
                 }
                         
                         let animationId = "segmentAnimation_" + state.siren_id;
@@ -85,6 +79,7 @@ Item {
                         // Mettre à jour le loopSize si présent
                         if (state.hasOwnProperty("loopSize")) {
                             siren.loopSize = state.loopSize;
+                            BeatClock.setLoopSize(state.siren_id, state.loopSize);
                         }
                         
                         // Traitement de l'état de transport
@@ -148,13 +143,13 @@ Item {
                                     if (logger) {
                                         logger.info("ANIMATION", "🗑️ Boucle effacée pour sirène", state.siren_id);
                                     }
-                                    // Supprimer complètement l'animation
+                                    // Arrêter l'animation (elle appartient à SirenColumn) et remettre la phase à zéro
                                     if (segmentAnimations[animationId]) {
                                         segmentAnimations[animationId].stop();
-                                        segmentAnimations[animationId].destroy();
                                         delete segmentAnimations[animationId];
-                                        if (logger) logger.debug("ANIMATION", "Animation supprimée (cleared) pour sirène", state.siren_id);
+                                        if (logger) logger.debug("ANIMATION", "Animation arrêtée (cleared) pour sirène", state.siren_id);
                                     }
+                                    BeatClock.clearLoop(state.siren_id);
                                     // Remise à zéro de l'anneau: rien à colorer, l'animation est arrêtée
     // 🔧 RÉINITIALISER LE COMPTEUR DE RÉVOLUTIONS
                                     siren.setRevolutionCount(0);
@@ -188,12 +183,6 @@ Item {
                                 siren.setRevolutionCount(state.revolutions);
                             }
                         }
-                        
-                        // Mettre à jour la durée d'animation si elle a changé
-                        if (state.hasOwnProperty("loopSize") && segmentAnimations[animationId]) {
-                            let newDuration = siren.loopSize * (60000 / bpm) * 4;
-                            segmentAnimations[animationId].updateDuration(newDuration);
-                        }
                     }
                 });
             }
@@ -203,53 +192,8 @@ Item {
     // Fonction utilitaire inchangée
     function animationInit(animationId) {
         if (segmentAnimations[animationId]) {
-            let siren = segmentAnimations[animationId].siren;
             segmentAnimations[animationId].stop();
-            segmentAnimations[animationId].destroy();
             delete segmentAnimations[animationId];
-            if (siren) {
-                siren.isAnimating = false;
-            }
-        }
-    }
-    
-    // Fonction pour mettre à jour la vitesse de toutes les animations
-    function updateAllAnimationSpeeds() {
-        for (let animId in segmentAnimations) {
-            if (segmentAnimations.hasOwnProperty(animId)) {
-                let animation = segmentAnimations[animId];
-                
-                let sirenId = parseInt(animId.split("_")[1]);
-                let siren = sirenController.getSirenById(sirenId);
-                
-                if (siren && animation) {
-                    let newDuration = siren.loopSize * (60000 / bpm) * 4;
-                    animation.updateDuration(newDuration);
-                    
-                    if (logger) logger.debug("ANIMATION", "Animation mise à jour pour sirène", sirenId,
-                                "durée:", newDuration, "active:", siren.isAnimating);
-                }
-            }
-        }
-    }
-    
-    // Fonction pour mettre à jour la durée d'animation
-    function updateAnimationDuration(sirenId) {
-        let siren = sirenController.getSirenById(sirenId);
-        if (!siren) return;
-        
-        let animationId = "segmentAnimation_" + sirenId;
-        let animation = segmentAnimations[animationId];
-        
-        if (animation) {
-            let beatsPerMeasure = 4;
-            let newDuration = siren.loopSize * beatsPerMeasure * (60000 / bpm);
-            
-            if (logger) logger.debug("ANIMATION", "Mise à jour durée animation pour sirène", sirenId,
-                       "loopSize:", siren.loopSize, 
-                       "nouvelle durée:", newDuration, "ms");
-            
-            animation.updateDuration(newDuration);
         }
     }
     
@@ -261,71 +205,33 @@ Item {
                segmentAnimations[animationId] !== undefined;
     }
     
-    function resetSegmentAnimation(sirenId) {
+    // Récupère (sans jamais la recréer) l'animation portée par la SirenColumn
+    function segmentAnimationFor(sirenId) {
         let animationId = "segmentAnimation_" + sirenId;
-        if (logger) logger.debug("ANIMATION", "Tentative de réinitialisation de l'animation", animationId);
-        
-        let animation = segmentAnimations[animationId];
-        let siren = sirenController.getSirenById(sirenId);
-        
-        if (animation && siren) {
-            if (logger) logger.debug("ANIMATION", "Animation trouvée, réinitialisation");
-            animation.stop();
-            
-            Qt.callLater(function() {
-                animation.animationProgress = 0;
-                animation.start();
-                siren.isAnimating = true;
-                if (logger) logger.debug("ANIMATION", "Animation redémarrée");
-            });
-        } else {
-            if (logger) logger.debug("ANIMATION", "Création d'une nouvelle animation pour la sirène", sirenId);
-            let animationComponent = Qt.createComponent("../components/monitoring/PieChartAnimation.qml");
-            if (animationComponent.status === Component.Ready) {
-                let loopDuration = siren.loopSize * (60000 / bpm) * 4;
-                let animation = animationComponent.createObject(siren, {  // <- Créer sur la sirène, pas sur root
-                    "siren": siren,
-                    "segmentCount": siren.segmentCount,
-                    "loopDuration": loopDuration,
-                    "activeColor": "lime",
-                    "inactiveColor": siren.inactiveColor
-                });
+        if (!segmentAnimations[animationId]) {
+            let siren = sirenController.getSirenById(sirenId);
+            let animation = siren ? siren.getPieChartAnimation() : null;
+            if (animation) {
                 segmentAnimations[animationId] = animation;
-                animation.start();
-                siren.isAnimating = true;
             }
         }
+        return segmentAnimations[animationId] || null;
+    }
+    
+    function resetSegmentAnimation(sirenId) {
+        // La phase est continue (BeatClock) : pas de stop/callLater/restart
+        let animation = segmentAnimationFor(sirenId);
+        if (animation) {
+            animation.resetAnimation();
+            if (logger) logger.debug("ANIMATION", "Animation reprise pour sirène", sirenId);
+        }
     }
     
     function ensureSegmentAnimationContinues(sirenId) {
-        let animationId = "segmentAnimation_" + sirenId;
-        let animation = segmentAnimations[animationId];
-        let siren = sirenController.getSirenById(sirenId);
-        
-        if (siren) {
-            if (animation) {
-                if (!animation.running) {
-                    animation.start();
-                    siren.isAnimating = true;
-                    if (logger) logger.debug("ANIMATION", "Animation redémarrée pour sirène", sirenId);
-                }
-            } else {
-                if (logger) logger.debug("ANIMATION", "Animation non trouvée pour sirène", sirenId, "- création d'une nouvelle");
-                let animationComponent = Qt.createComponent("../components/monitoring/PieChartAnimation.qml");
-                if (animationComponent.status === Component.Ready) {
-                    let loopDuration = siren.loopSize * (60000 / bpm) * 4;
-                    let animation = animationComponent.createObject(siren, {  // <- Créer sur la sirène, pas sur root
-                        "siren": siren,
-                        "segmentCount": siren.segmentCount,
-                        "loopDuration": loopDuration,
-                        "activeColor": "lime",
-                        "inactiveColor": siren.inactiveColor
-                    });
-                    segmentAnimations[animationId] = animation;
-                    animation.start();
-                    siren.isAnimating = true;
-                }
-            }
+        let animation = segmentAnimationFor(sirenId);
+        if (animation && !animation.running) {
+            animation.start();
+            if (logger) logger.debug("ANIMATION", "Animation redémarrée pour sirène", sirenId);
         }
     }
     
@@ -340,21 +246,4 @@ Item {
             if (logger) logger.debug("ANIMATION", "Animation arrêtée pour sirène", sirenId);
         }
     }
-    
-    // Fonction de synchronisation des animations
-    function updateAllSegmentAnimationsPosition() {
-        for (let i = 0; i < sirenController.sirenNodes.length; i++) {
-            let siren = sirenController.sirenNodes[i];
-            if (siren.isCurrent) {
-                let relativePosition = (globalLoopPosition % siren.loopSize) / siren.loopSize;
-                
-                // Cette fonction n'existe plus dans le SirenController - à mettre à jour
-                let animationId = "segmentAnimation_" + (i + 1);
-                let animation = segmentAnimations[animationId];
-                if (animation) {
-                    animation.setPosition(relativePosition);
-                }
-            }
-        }
-    }
 }
@@ -17,7 +17,7 @@ QtObject {
             if (batchType !== "voices" && batchType !== "clock" && batchType !== "loops" && batchType !== "presets") {
                 logger.info("BATCH", "Batch reçu:", batchType, "avec", Object.keys(data).length, "éléments");
             }
-            logger.debug("BATCH", "Traitement du batch:", batchType);
+            logger.debugLazy("BATCH", () => ["Traitement du batch:", batchType]);
         }
         
         switch(batchType) {
@@ -33,7 +33,7 @@ QtObject {
                                 _voiceStates[voice.channel] = voice.enable;
                             }
                             if (logger) {
-                                logger.trace("VOICE", "Channel", voice.channel, "enable:", voice.enable);
+                                logger.traceLazy("VOICE", () => ["Channel", voice.channel, "enable:", voice.enable]);
                             }
                             sirenController.setCurrentSiren(voice.channel, voice.enable === 1);
                             
@@ -50,7 +50,7 @@ QtObject {
                 
             case "clock":
                 if (logger) {
-                    logger.debug("CLOCK", "Update - BPM:", data.bpm, "Beat:", data.beat, "Bar:", data.bar);
+                    logger.debugLazy("CLOCK", () => ["Update - BPM:", data.bpm, "Beat:", data.beat, "Bar:", data.bar]);
                 }
                 // Appeler processLoopAndClock pour transmettre clock
                 beatController.processLoopAndClock(null, data);
@@ -60,17 +60,8 @@ QtObject {
                     tempoControl.tempo = data.bpm;
                 }
                 
-                // Traiter le beat
-                if (data.hasOwnProperty('beat')) {
-                    // Faire pulser les sirènes actives
-                    for (let i = 1; i <= 7; i++) {
-                        let siren = sirenController.getSirenById(i);
-                        if (siren && siren.isCurrent) {
-                            let isFirstBeat = data.beat === 1;
-                            siren.pulseSphere(isFirstBeat, 60000 / beatController.bpm / 2);
-                        }
-                    }
-                }
+                // Les pulsations de beat sont émises par BeatClock.beatTriggered
+                // (chaque SirenColumn écoute l'horloge, plus de boucle ici)
                 
                 // Mettre à jour la barre
                 if (data.hasOwnProperty('bar')) {
@@ -92,13 +83,13 @@ QtObject {
                 break;
             case "presetList":
                 if (logger) {
-                    logger.info("PRESET", "📋 Liste des presets reçue:", JSON.stringify(data));
+                    logger.infoLazy("PRESET", () => ["📋 Liste des presets reçue:", JSON.stringify(data)]);
                 }
                 pedalConfigController.availablePresets = data;
                 break;
             case "currentPreset":
                 if (logger) {
-                    logger.info("PRESET", "🎯 Preset courant reçu:", JSON.stringify(data));
+                    logger.infoLazy("PRESET", () => ["🎯 Preset courant reçu:", JSON.stringify(data)]);
                 }
                 if (pedalConfigController.loadPreset(data)) {
                     if (logger) logger.info("PRESET", "✅ Preset courant chargé et interface mise à jour");
@@ -108,38 +99,38 @@ QtObject {
                 break;
             case "knob":
                 if (logger) {
-                    logger.info("KNOB", "Batch knob reçu:", JSON.stringify(data));
+                    logger.infoLazy("KNOB", () => ["Batch knob reçu:", JSON.stringify(data)]);
                 }
                 break;
             case "router":
                 if (logger) {
-                    logger.info("ROUTER", "Batch router reçu:", JSON.stringify(data));
+                    logger.infoLazy("ROUTER", () => ["Batch router reçu:", JSON.stringify(data)]);
                 }
                 break;
             case "parser":
                 if (logger) {
-                    logger.info("PARSER", "Batch parser reçu:", JSON.stringify(data));
+                    logger.infoLazy("PARSER", () => ["Batch parser reçu:", JSON.stringify(data)]);
                 }
                 break;
             case "init":
                 if (logger) {
-                    logger.info("INIT", "Batch init reçu:", JSON.stringify(data));
+                    logger.infoLazy("INIT", () => ["Batch init reçu:", JSON.stringify(data)]);
                 }
                 break;
             case "monitoringData":
                 if (logger) {
-                    logger.info("MONITORING", "Batch monitoringData reçu:", JSON.stringify(data));
+                    logger.infoLazy("MONITORING", () => ["Batch monitoringData reçu:", JSON.stringify(data)]);
                 }
                 break;
 
             case "monitoringStatus":
                 if (logger) {
-                    logger.info("MONITORING", "Batch monitoringStatus reçu:", JSON.stringify(data));
+                    logger.infoLazy("MONITORING", () => ["Batch monitoringStatus reçu:", JSON.stringify(data)]);
                 }
                 break;
             case "scenesList":
                 if (logger) {
-                    logger.info("SCENES", "📋 Liste des scènes reçue:", JSON.stringify(data));
+                    logger.infoLazy("SCENES", () => ["📋 Liste des scènes reçue:", JSON.stringify(data)]);
                 }
                 // Mettre à jour le SceneManager
                 if (sceneManager) {
@@ -148,7 +139,7 @@ QtObject {
                 break;
             case "sceneLoaded":
                 if (logger) {
-                    logger.info("SCENES", "🎵 Scène chargée:", JSON.stringify(data));
+                    logger.infoLazy("SCENES", () => ["🎵 Scène chargée:", JSON.stringify(data)]);
                     logger.info("SCENES", "🔍 Structure data:", Object.keys(data));
                 }
                 // Mettre à jour la scène active
@@ -168,7 +159,7 @@ QtObject {
                 break;
             case "sceneSaved":
                 if (logger) {
-                    logger.info("SCENES", "💾 Scène sauvegardée:", JSON.stringify(data));
+                    logger.infoLazy("SCENES", () => ["💾 Scène sauvegardée:", JSON.stringify(data)]);
                     logger.info("SCENES", "🔍 Structure data:", Object.keys(data));
                 }
                 
@@ -206,7 +197,7 @@ QtObject {
     // Router les messages de scènes
     function routeSceneMessage(data) {
         if (logger) {
-            logger.info("SCENES", "🎭 Message de scène reçu:", JSON.stringify(data));
+            logger.infoLazy("SCENES", () => ["🎭 Message de scène reçu:", JSON.stringify(data)]);
         }
         
         switch(data.action) {
@@ -247,7 +238,7 @@ QtObject {
     
     // Pour compatibilité avec l'ancien système
     function routePathMessage(path, value) {
-        if (logger) logger.debug("ROUTER", "📍 Route path:", JSON.stringify(path), "value:", value);
+        if (logger) logger.debugLazy("ROUTER", () => ["📍 Route path:", JSON.stringify(path), "value:", value]);
     }
     
     // Nouvelle fonction pour gérer les erreurs
@@ -153,7 +153,7 @@ Item {
                     root.logger.trace("WEBSOCKET", "binaire (len=" + bytes.length + "):", hex);
                 }
                 if (root.midiMonitorController && bytes.length > 0) {
-                    root.midiMonitorController.applyExternalMidiBytes(bytes);
+                    root.midiMonitorController.applyExternalMidiBytes(message);
                 }
             } catch (e) {
                 if (root.logger) root.logger.error("WEBSOCKET", "Erreur binaire:", e.message);
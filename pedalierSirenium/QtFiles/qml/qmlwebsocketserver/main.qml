@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick.Window
 import QtQuick3D
+import Pedalier 1.0
 import QtQuick.Controls
 
 import "./components/core"
@@ -74,6 +75,20 @@ Window {
     MidiMonitorController {
         id: midiMonitorController
         logger: logger
+        history: telemetryHistory
+    }
+    
+    // Historique des mesures par sirène (MIDI + monitoringData), mémoire constante
+    TelemetryHistory {
+        id: telemetryHistory
+    }
+    
+    Connections {
+        target: wsController
+        function onMonitoringDataReceived(data) {
+            if (data && data.sirenStates) telemetryHistory.recordStates(data.sirenStates)
+            if (data && data.sirenPings) telemetryHistory.recordPings(data.sirenPings)
+        }
     }
     
     // Router de messages
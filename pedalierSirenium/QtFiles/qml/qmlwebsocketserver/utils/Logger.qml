@@ -1,4 +1,5 @@
 import QtQuick
+import Pedalier 1.0
 
 QtObject {
     id: root
@@ -68,6 +69,37 @@ QtObject {
     
     signal historyChanged()
 
+    // Les niveaux sont recopiés dans MecavivLog (C++) : sortie asynchrone (stderr,
+    // MECAVIV_LOG_FILE) et filtrage identique pour les traces émises côté C++.
+    // Une catégorie déjà réglée par MECAVIV_LOG garde ce niveau (repris ici pour le
+    // filtrage QML) ; seules les autres reçoivent le niveau par défaut de ce fichier
+    Component.onCompleted: {
+        for (let cat in categoryMap) {
+            if (Log.configured(cat))
+                root[categoryMap[cat]] = Log.level(cat);
+            else
+                Log.setLevel(cat, root[categoryMap[cat]]);
+        }
+    }
+    onLevelWebSocketChanged: Log.setLevel("WEBSOCKET", levelWebSocket)
+    onLevelClockChanged: Log.setLevel("CLOCK", levelClock)
+    onLevelVoiceChanged: Log.setLevel("VOICE", levelVoice)
+    onLevelAnimationChanged: Log.setLevel("ANIMATION", levelAnimation)
+    onLevelBatchChanged: Log.setLevel("BATCH", levelBatch)
+    onLevelRecordingChanged: Log.setLevel("RECORDING", levelRecording)
+    onLevelPresetChanged: Log.setLevel("PRESET", levelPreset)
+    onLevelKnobChanged: Log.setLevel("KNOB", levelKnob)
+    onLevelRouterChanged: Log.setLevel("ROUTER", levelRouter)
+    onLevelParserChanged: Log.setLevel("PARSER", levelParser)
+    onLevelInitChanged: Log.setLevel("INIT", levelInit)
+    onLevelScenesChanged: Log.setLevel("SCENES", levelScenes)
+    onLevelMidiChanged: Log.setLevel("MIDI", levelMidi)
+
+    // Vrai si un message de ce niveau serait émis (pour protéger un bloc coûteux)
+    function enabled(category, level) {
+        return getCategoryLevel(category) >= level;
+    }
+
     function setAllCategories(level) {
         console.log("🎯 Logger.setAllCategories appelé avec level:", level);
         for (let cat in categoryMap) {
@@ -100,23 +132,9 @@ QtObject {
         
         if (level > categoryLevel) return;
         
-        // Construire le message
         let emoji = emojis[category] || "📝";
-        let levelStr = ["OFF", "ERROR", "WARN", "INFO", "DEBUG", "TRACE"][level];
-        let prefix = emoji + " " + category;
-        
-        // Afficher selon le niveau
-        switch(level) {
-            case level_error:
-                console.error(prefix + ":", ...args);
-                break;
-            case level_warn:
-                console.warn(prefix + ":", ...args);
-                break;
-            default:
-                console.log(prefix + ":", ...args);
-                break;
-        }
+        // Sortie asynchrone via MecavivLog
+        Log.log(category, level, [emoji].concat(args));
     }
     
     // Méthodes de commodité
@@ -141,32 +159,44 @@ QtObject {
 
     function info(category, ...args) {
         if (getCategoryLevel(category) >= level_info) {
-            console.log("LOGGER.INFO", category, ...args);
+            Log.log(category, level_info, args);
             addToHistory("INFO", category, args);
         }
     }
     function debug(category, ...args) {
         if (getCategoryLevel(category) >= level_debug) {
-            console.log("DEBUG", category, ...args);
+            Log.log(category, level_debug, args);
             addToHistory("DEBUG", category, args);
         }
     }
     function warn(category, ...args) {
         if (getCategoryLevel(category) >= level_warn) {
-            console.warn("WARN", category, ...args);
+            Log.log(category, level_warn, args);
             addToHistory("WARN", category, args);
         }
     }
     function error(category, ...args) {
         if (getCategoryLevel(category) >= level_error) {
-            console.error("ERROR", category, ...args);
+            Log.log(category, level_error, args);
             addToHistory("ERROR", category, args);
         }
     }
     function trace(category, ...args) {
         if (getCategoryLevel(category) >= level_trace) {
-            console.log("TRACE", category, ...args);
+            Log.log(category, level_trace, args);
             addToHistory("TRACE", category, args);
         }
     }
+
+    // Variantes paresseuses : producer() n'est appelé que si la catégorie est active.
+    // logger.traceLazy("ROUTER", () => ["Route:", JSON.stringify(path)])
+    function infoLazy(category, producer) {
+        if (getCategoryLevel(category) >= level_info) info(category, ...producer());
+    }
+    function debugLazy(category, producer) {
+        if (getCategoryLevel(category) >= level_debug) debug(category, ...producer());
+    }
+    function traceLazy(category, producer) {
+        if (getCategoryLevel(category) >= level_trace) trace(category, ...producer());
+    }
 }
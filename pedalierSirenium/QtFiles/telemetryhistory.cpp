@@ -0,0 +1,460 @@
+#include "telemetryhistory.h"
+#include <QtMath>
+#include <limits>
+
+namespace {
+struct LevelSpec {
+    qint64 resolution;   // ms par case
+    int capacity;        // cases conservées
+};
+
+// 1 ms : ~2 s de détail brut ; 100 ms : 5 min ; 1 s : 1 h ; 1 min : 24 h
+constexpr LevelSpec kLevels[TelemetryHistory::LevelCount] = {
+    { 1, 2048 },
+    { 100, 3000 },
+    { 1000, 3600 },
+    { 60000, 1440 }
+};
+
+constexpr int kMaxPoints = 4096;
+
+// Changements d'état conservés par mesure booléenne
+constexpr int kHoldCapacity = 1024;
+
+// Liste blanche : mesures graphées, les autres champs de sirenStates sont ignorés
+const char *const kContinuousMetrics[] = { "note", "velocity", "bend", "pitch", "frequency", "rpm", "volume" };
+const char *const kBooleanMetrics[] = { "ping" };
+
+// Tableau sirenStates.controllers éclaté en séries controller0..controller7 (Config.controllers.order)
+constexpr int kMaxControllers = 8;
+const QLatin1String kControllerPrefix("controller");
+
+bool isControllerMetric(const QString &metric)
+{
+    if (!metric.startsWith(kControllerPrefix))
+        return false;
+    bool ok = false;
+    const int index = QStringView(metric).mid(kControllerPrefix.size()).toInt(&ok);
+    return ok && index >= 0 && index < kMaxControllers;
+}
+
+// 1 / 0, true / false ou { pingOk: bool } (voir README, structure sirenPings)
+bool pingValue(const QVariant &value)
+{
+    if (value.typeId() == QMetaType::Bool)
+        return value.toBool();
+    if (value.typeId() == QMetaType::QVariantMap)
+        return value.toMap().value(QStringLiteral("pingOk")).toBool();
+    return value.toDouble() > 0.0;
+}
+}
+
+void TelemetryHistory::HoldSeries::add(qint64 timestamp, float value)
+{
+    if (size > 0) {
+        const Transition &last = at(size - 1);
+        // Valeur maintenue : rien à stocker ; un échantillon en retard ne réécrit pas l'histoire
+        if (last.value == value || timestamp < last.timestamp)
+            return;
+    }
+    Transition &transition = ring[head];
+    transition.timestamp = timestamp;
+    transition.value = value;
+    head = (head + 1) % ring.size();
+    if (size < ring.size())
+        ++size;
+}
+
+const TelemetryHistory::Transition &TelemetryHistory::HoldSeries::at(int i) const
+{
+    return ring[(head - size + i + ring.size()) % ring.size()];
+}
+
+void TelemetryHistory::Level::add(qint64 timestamp, float value)
+{
+    const qint64 start = timestamp - timestamp % resolution;
+    if (size > 0) {
+        Bucket &last = ring[(head - 1 + ring.size()) % ring.size()];
+        // Même case, ou échantillon en retard : on élargit la dernière case
+        if (start <= last.start) {
+            last.min = qMin(last.min, value);
+            last.max = qMax(last.max, value);
+            return;
+        }
+    }
+
+    Bucket &bucket = ring[head];
+    bucket.start = start;
+    bucket.min = value;
+    bucket.max = value;
+    head = (head + 1) % ring.size();
+    if (size < ring.size())
+        ++size;
+}
+
+const TelemetryHistory::Bucket &TelemetryHistory::Level::at(int i) const
+{
+    return ring[(head - size + i + ring.size()) % ring.size()];
+}
+
+int TelemetryHistory::Level::lowerBound(qint64 timestamp) const
+{
+    // Premier index dont la case se termine après timestamp (cases triées par début)
+    int lo = 0;
+    int hi = size;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (at(mid).start + resolution <= timestamp)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+TelemetryHistory::TelemetryHistory(QObject *parent)
+    : QObject(parent)
+    , m_series(MaxSirens)
+    , m_holdSeries(MaxSirens)
+    , m_memory("rings", "TelemetryHistory", [this] {
+          return MecavivMemory::Usage { seriesCount(), qint64(memoryBytes()) };
+      })
+{
+    m_clock.start();
+}
+
+int TelemetryHistory::seriesCount() const
+{
+    int count = 0;
+    for (const auto &perSiren : m_series)
+        count += perSiren.size();
+    for (const auto &perSiren : m_holdSeries)
+        count += perSiren.size();
+    return count;
+}
+
+double TelemetryHistory::memoryBytes() const
+{
+    qint64 bucketsPerSeries = 0;
+    for (const LevelSpec &spec : kLevels)
+        bucketsPerSeries += spec.capacity;
+    qint64 continuous = 0;
+    for (const auto &perSiren : m_series)
+        continuous += perSiren.size();
+    qint64 hold = 0;
+    for (const auto &perSiren : m_holdSeries)
+        hold += perSiren.size();
+    return double(continuous) * bucketsPerSeries * sizeof(Bucket)
+        + double(hold) * kHoldCapacity * sizeof(Transition);
+}
+
+TelemetryHistory::MetricKind TelemetryHistory::metricKind(const QString &metric)
+{
+    for (const char *name : kContinuousMetrics) {
+        if (metric == QLatin1String(name))
+            return MetricKind::Continuous;
+    }
+    for (const char *name : kBooleanMetrics) {
+        if (metric == QLatin1String(name))
+            return MetricKind::Boolean;
+    }
+    return isControllerMetric(metric) ? MetricKind::Continuous : MetricKind::None;
+}
+
+void TelemetryHistory::record(int sirenId, const QString &metric, double value)
+{
+    recordAt(sirenId, metric, m_clock.elapsed(), value);
+}
+
+void TelemetryHistory::recordAt(int sirenId, const QString &metric, qint64 timestamp, double value)
+{
+    if (!qIsFinite(value))
+        return;
+    switch (metricKind(metric)) {
+    case MetricKind::None:
+        return;
+    case MetricKind::Boolean:
+        recordBoolean(sirenId, metric, timestamp, value > 0.0);
+        return;
+    case MetricKind::Continuous:
+        break;
+    }
+    Series *series = seriesFor(sirenId, metric);
+    if (!series)
+        return;
+    for (Level &level : series->levels)
+        level.add(timestamp, float(value));
+}
+
+void TelemetryHistory::recordState(int sirenId, const QVariantMap &state)
+{
+    const qint64 timestamp = m_clock.elapsed();
+    for (auto it = state.constBegin(); it != state.constEnd(); ++it) {
+        if (it.key() == QLatin1String("controllers")) {
+            const QVariantList controllers = it.value().toList();
+            for (int i = 0; i < qMin(int(controllers.size()), kMaxControllers); ++i) {
+                bool ok = false;
+                const double value = controllers.at(i).toDouble(&ok);
+                if (ok)
+                    recordAt(sirenId, kControllerPrefix + QString::number(i), timestamp, value);
+            }
+            continue;
+        }
+        const MetricKind kind = metricKind(it.key());
+        if (kind == MetricKind::None)
+            continue;
+        if (kind == MetricKind::Boolean && it.value().typeId() == QMetaType::Bool) {
+            recordBoolean(sirenId, it.key(), timestamp, it.value().toBool());
+            continue;
+        }
+        // Les valeurs arrivent parfois en chaîne ("440.0") : on ne garde que ce qui est numérique
+        bool ok = false;
+        const double value = it.value().toDouble(&ok);
+        if (ok)
+            recordAt(sirenId, it.key(), timestamp, value);
+    }
+}
+
+void TelemetryHistory::recordPings(const QVariantMap &sirenPings)
+{
+    const qint64 timestamp = m_clock.elapsed();
+    for (auto it = sirenPings.constBegin(); it != sirenPings.constEnd(); ++it) {
+        if (!it.key().startsWith(QLatin1String("siren")))
+            continue;
+        bool ok = false;
+        const int sirenId = it.key().mid(5).toInt(&ok);
+        if (!ok)
+            continue;
+        recordBoolean(sirenId, QStringLiteral("ping"), timestamp, pingValue(it.value()));
+    }
+}
+
+void TelemetryHistory::recordBoolean(int sirenId, const QString &metric, qint64 timestamp, bool value)
+{
+    HoldSeries *series = holdSeriesFor(sirenId, metric);
+    if (series)
+        series->add(timestamp, value ? 1.0f : 0.0f);
+}
+
+void TelemetryHistory::recordStates(const QVariantMap &sirenStates)
+{
+    for (auto it = sirenStates.constBegin(); it != sirenStates.constEnd(); ++it) {
+        if (!it.key().startsWith(QLatin1String("siren")))
+            continue;
+        bool ok = false;
+        const int sirenId = it.key().mid(5).toInt(&ok);
+        if (ok)
+            recordState(sirenId, it.value().toMap());
+    }
+}
+
+QVariantMap TelemetryHistory::query(int sirenId, const QString &metric, double from, double to, int points) const
+{
+    QVariantMap result;
+    points = qMin(points, kMaxPoints);
+    if (points <= 0 || to <= from)
+        return result;
+
+    if (sirenId >= 1 && sirenId <= MaxSirens) {
+        const QHash<QString, HoldSeries> &holds = m_holdSeries[sirenId - 1];
+        const auto hold = holds.constFind(metric);
+        if (hold != holds.constEnd())
+            return queryHold(hold.value(), from, to, points);
+    }
+
+    const Series *series = findSeries(sirenId, metric);
+    if (!series)
+        return result;
+
+    const double pixelSpan = (to - from) / points;
+
+    // Niveau le plus grossier dont la case tient dans un pixel
+    int chosen = 0;
+    for (int i = 0; i < LevelCount; ++i) {
+        if (double(series->levels[i].resolution) <= pixelSpan)
+            chosen = i;
+    }
+
+    QVector<float> mins(points, std::numeric_limits<float>::infinity());
+    QVector<float> maxs(points, -std::numeric_limits<float>::infinity());
+
+    // Le niveau choisi remplit ce qu'il couvre ; le début de la fenêtre, plus ancien
+    // que sa capacité, est complété par les niveaux plus grossiers
+    int pixelEnd = points;
+    for (int i = chosen; i < LevelCount && pixelEnd > 0; ++i) {
+        const Level &level = series->levels[i];
+        if (level.size == 0)
+            continue;
+        const bool coarsest = i == LevelCount - 1;
+        const int pixelBegin = coarsest ? 0
+            : qBound(0, int(qCeil((level.oldestStart() - from) / pixelSpan)), pixelEnd);
+        fillPixels(level, from, pixelSpan, pixelBegin, pixelEnd, mins, maxs);
+        pixelEnd = pixelBegin;
+    }
+
+    QList<qreal> minList;
+    QList<qreal> maxList;
+    minList.reserve(points);
+    maxList.reserve(points);
+    float low = std::numeric_limits<float>::infinity();
+    float high = -std::numeric_limits<float>::infinity();
+    for (int p = 0; p < points; ++p) {
+        if (mins[p] > maxs[p]) {
+            minList.append(qQNaN());
+            maxList.append(qQNaN());
+            continue;
+        }
+        minList.append(mins[p]);
+        maxList.append(maxs[p]);
+        low = qMin(low, mins[p]);
+        high = qMax(high, maxs[p]);
+    }
+
+    result.insert(QStringLiteral("min"), QVariant::fromValue(minList));
+    result.insert(QStringLiteral("max"), QVariant::fromValue(maxList));
+    result.insert(QStringLiteral("low"), low <= high ? qreal(low) : qQNaN());
+    result.insert(QStringLiteral("high"), low <= high ? qreal(high) : qQNaN());
+    result.insert(QStringLiteral("resolution"), double(series->levels[chosen].resolution));
+    return result;
+}
+
+void TelemetryHistory::fillPixels(const Level &level, double from, double pixelSpan,
+                                  int pixelBegin, int pixelEnd, QVector<float> &mins, QVector<float> &maxs)
+{
+    if (pixelBegin >= pixelEnd)
+        return;
+    const double windowStart = from + pixelBegin * pixelSpan;
+    const double windowEnd = from + pixelEnd * pixelSpan;
+
+    for (int i = level.lowerBound(qint64(qFloor(windowStart))); i < level.size; ++i) {
+        const Bucket &bucket = level.at(i);
+        if (bucket.start >= windowEnd)
+            break;
+        // Une case plus large qu'un pixel (niveau de repli) couvre plusieurs pixels
+        const int first = qMax(pixelBegin, int(qFloor((bucket.start - from) / pixelSpan)));
+        const int last = qMin(pixelEnd - 1, int(qFloor((bucket.start + level.resolution - 1 - from) / pixelSpan)));
+        for (int p = first; p <= last; ++p) {
+            mins[p] = qMin(mins[p], bucket.min);
+            maxs[p] = qMax(maxs[p], bucket.max);
+        }
+    }
+}
+
+QVariantMap TelemetryHistory::queryHold(const HoldSeries &series, double from, double to, int points) const
+{
+    QVariantMap result;
+    if (series.size == 0)
+        return result;
+
+    // La dernière valeur tient jusqu'à maintenant, pas au-delà
+    const double end = qMin(to, double(m_clock.elapsed()));
+    const double pixelSpan = (to - from) / points;
+
+    // Valeur en vigueur au début de la fenêtre : dernier changement antérieur
+    int next = 0;
+    while (next < series.size && series.at(next).timestamp <= from)
+        ++next;
+    bool known = next > 0;
+    float held = known ? series.at(next - 1).value : 0.0f;
+
+    QList<qreal> minList;
+    QList<qreal> maxList;
+    minList.reserve(points);
+    maxList.reserve(points);
+    float low = std::numeric_limits<float>::infinity();
+    float high = -std::numeric_limits<float>::infinity();
+    for (int p = 0; p < points; ++p) {
+        const double pixelStart = from + p * pixelSpan;
+        const double pixelEnd = pixelStart + pixelSpan;
+        float mn = known ? held : std::numeric_limits<float>::infinity();
+        float mx = known ? held : -std::numeric_limits<float>::infinity();
+        while (next < series.size && series.at(next).timestamp < pixelEnd) {
+            held = series.at(next).value;
+            known = true;
+            mn = qMin(mn, held);
+            mx = qMax(mx, held);
+            ++next;
+        }
+        if (!known || pixelStart >= end) {
+            minList.append(qQNaN());
+            maxList.append(qQNaN());
+            continue;
+        }
+        minList.append(mn);
+        maxList.append(mx);
+        low = qMin(low, mn);
+        high = qMax(high, mx);
+    }
+
+    result.insert(QStringLiteral("min"), QVariant::fromValue(minList));
+    result.insert(QStringLiteral("max"), QVariant::fromValue(maxList));
+    result.insert(QStringLiteral("low"), low <= high ? qreal(low) : qQNaN());
+    result.insert(QStringLiteral("high"), low <= high ? qreal(high) : qQNaN());
+    result.insert(QStringLiteral("resolution"), 0.0);
+    return result;
+}
+
+QStringList TelemetryHistory::metrics(int sirenId) const
+{
+    if (sirenId < 1 || sirenId > MaxSirens)
+        return QStringList();
+    QStringList names = m_series[sirenId - 1].keys() + m_holdSeries[sirenId - 1].keys();
+    names.sort();
+    return names;
+}
+
+void TelemetryHistory::clear()
+{
+    for (auto &perSiren : m_series)
+        perSiren.clear();
+    for (auto &perSiren : m_holdSeries)
+        perSiren.clear();
+    emit seriesCountChanged();
+}
+
+TelemetryHistory::Series *TelemetryHistory::seriesFor(int sirenId, const QString &metric)
+{
+    if (sirenId < 1 || sirenId > MaxSirens || metric.isEmpty())
+        return nullptr;
+
+    QHash<QString, Series> &perSiren = m_series[sirenId - 1];
+    auto it = perSiren.find(metric);
+    if (it != perSiren.end())
+        return &it.value();
+
+    // Allocation unique à la création de la série, plus rien ensuite
+    Series series;
+    for (int i = 0; i < LevelCount; ++i) {
+        series.levels[i].resolution = kLevels[i].resolution;
+        series.levels[i].ring.resize(kLevels[i].capacity);
+    }
+    it = perSiren.insert(metric, series);
+    emit seriesCountChanged();
+    return &it.value();
+}
+
+TelemetryHistory::HoldSeries *TelemetryHistory::holdSeriesFor(int sirenId, const QString &metric)
+{
+    if (sirenId < 1 || sirenId > MaxSirens || metric.isEmpty())
+        return nullptr;
+
+    QHash<QString, HoldSeries> &perSiren = m_holdSeries[sirenId - 1];
+    auto it = perSiren.find(metric);
+    if (it != perSiren.end())
+        return &it.value();
+
+    HoldSeries series;
+    series.ring.resize(kHoldCapacity);
+    it = perSiren.insert(metric, series);
+    emit seriesCountChanged();
+    return &it.value();
+}
+
+const TelemetryHistory::Series *TelemetryHistory::findSeries(int sirenId, const QString &metric) const
+{
+    if (sirenId < 1 || sirenId > MaxSirens)
+        return nullptr;
+    const QHash<QString, Series> &perSiren = m_series[sirenId - 1];
+    const auto it = perSiren.constFind(metric);
+    return it == perSiren.constEnd() ? nullptr : &it.value();
+}
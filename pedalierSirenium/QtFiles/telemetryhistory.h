@@ -0,0 +1,123 @@
+#ifndef TELEMETRYHISTORY_H
+#define TELEMETRYHISTORY_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+#include <array>
+#include "MemoryAccounting.h"
+
+// Historique des mesures par sirène. Seules les mesures de la liste blanche sont
+// enregistrées (note, vélocité, bend, pitch, fréquence, RPM, volume, ping, et les
+// contrôleurs du tableau controllers en controller0..controller7), les autres
+// champs reçus sont ignorés.
+// Chaque série continue garde quatre niveaux de décimation min/max (1 ms, 100 ms,
+// 1 s, 1 min) dans des tampons circulaires de taille fixe : ajout en O(1), mémoire
+// constante quelle que soit la durée de la session (~160 Ko par série). Un graphe
+// demande un point (min/max) par pixel horizontal ; le niveau le plus grossier qui
+// reste plus fin que le pixel est utilisé, donc une trace d'une heure coûte autant
+// qu'une trace d'une minute.
+// Les mesures booléennes (ping) ne stockent que leurs changements d'état, la valeur
+// étant maintenue jusqu'au changement suivant (~16 Ko par série).
+class TelemetryHistory : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int seriesCount READ seriesCount NOTIFY seriesCountChanged)
+    Q_PROPERTY(double memoryBytes READ memoryBytes NOTIFY seriesCountChanged)
+
+public:
+    static constexpr int MaxSirens = 7;
+    static constexpr int LevelCount = 4;
+
+    explicit TelemetryHistory(QObject *parent = nullptr);
+
+    int seriesCount() const;
+    double memoryBytes() const;
+
+    // Horloge de l'historique (ms depuis la création) : base commune aux graphes
+    Q_INVOKABLE double now() const { return double(m_clock.elapsed()); }
+
+    // Mesure hors liste blanche : ignorée
+    Q_INVOKABLE void record(int sirenId, const QString &metric, double value);
+    void recordAt(int sirenId, const QString &metric, qint64 timestamp, double value);
+    // { frequency, rpm, volume, pitch, velocity, controllers: [...], ... } : seuls les champs de la liste blanche
+    Q_INVOKABLE void recordState(int sirenId, const QVariantMap &state);
+    // { siren1: {...}, ..., siren7: {...} } (format monitoringData.sirenStates)
+    Q_INVOKABLE void recordStates(const QVariantMap &sirenStates);
+    // { siren1: 1, ..., siren7: 0 } ou { siren1: { pingOk: true }, ... } (format monitoringData.sirenPings) → mesure "ping"
+    Q_INVOKABLE void recordPings(const QVariantMap &sirenPings);
+
+    // { min: [...], max: [...], low, high, resolution } ; NaN pour un pixel sans donnée
+    // Pour une mesure booléenne, min/max valent 0 ou 1 (les deux si le pixel contient un changement)
+    Q_INVOKABLE QVariantMap query(int sirenId, const QString &metric, double from, double to, int points) const;
+    Q_INVOKABLE QStringList metrics(int sirenId) const;
+    Q_INVOKABLE void clear();
+
+signals:
+    void seriesCountChanged();
+
+private:
+    struct Bucket {
+        qint64 start = 0;
+        float min = 0.0f;
+        float max = 0.0f;
+    };
+
+    struct Level {
+        qint64 resolution = 1;
+        QVector<Bucket> ring;
+        int head = 0;      // prochaine case écrite
+        int size = 0;
+
+        void add(qint64 timestamp, float value);
+        const Bucket &at(int i) const;     // i = 0 : plus ancien
+        int lowerBound(qint64 timestamp) const;
+        qint64 oldestStart() const { return size ? at(0).start : 0; }
+    };
+
+    struct Series {
+        std::array<Level, LevelCount> levels;
+    };
+
+    // Échantillonnage-blocage : un point par changement d'état
+    struct Transition {
+        qint64 timestamp = 0;
+        float value = 0.0f;
+    };
+
+    struct HoldSeries {
+        QVector<Transition> ring;
+        int head = 0;
+        int size = 0;
+
+        void add(qint64 timestamp, float value);
+        const Transition &at(int i) const;     // i = 0 : plus ancien
+    };
+
+    enum class MetricKind {
+        None,
+        Continuous,
+        Boolean
+    };
+    static MetricKind metricKind(const QString &metric);
+
+    Series *seriesFor(int sirenId, const QString &metric);
+    const Series *findSeries(int sirenId, const QString &metric) const;
+    HoldSeries *holdSeriesFor(int sirenId, const QString &metric);
+    void recordBoolean(int sirenId, const QString &metric, qint64 timestamp, bool value);
+    QVariantMap queryHold(const HoldSeries &series, double from, double to, int points) const;
+    static void fillPixels(const Level &level, double from, double pixelSpan,
+                           int pixelBegin, int pixelEnd, QVector<float> &mins, QVector<float> &maxs);
+
+    QElapsedTimer m_clock;
+    QVector<QHash<QString, Series>> m_series;   // index = sirenId - 1
+    QVector<QHash<QString, HoldSeries>> m_holdSeries;
+
+    // Comptabilité mémoire : anneaux de taille fixe, pas d'éviction
+    MecavivMemory::Source m_memory;
+};
+
+#endif // TELEMETRYHISTORY_H